@@ -0,0 +1,196 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/*
+*
+*   Benchmark:  Setup and precondition phase of the algebraic multigrid preconditioner for a 3D Laplace operator
+*
+*/
+
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+
+#define VIENNACL_WITH_UBLAS 1
+
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/amg.hpp"
+
+#include <iostream>
+#include <vector>
+#include "benchmark-utils.hpp"
+
+
+/** @brief Generates the seven-point finite difference discretization of the Laplace operator on a m x m x m grid. */
+template<typename ScalarType>
+void generate_laplace_3d_matrix(std::size_t m, boost::numeric::ublas::compressed_matrix<ScalarType> & ublas_matrix)
+{
+  std::size_t n = m * m * m;
+  ublas_matrix.resize(n, n, false);
+  ublas_matrix.reserve(7 * n);
+  for (std::size_t i=0; i<m; ++i)
+    for (std::size_t j=0; j<m; ++j)
+      for (std::size_t k=0; k<m; ++k)
+      {
+        std::size_t row = (i * m + j) * m + k;
+        if (i > 0)     ublas_matrix.push_back(row, row - m * m, ScalarType(-1));
+        if (j > 0)     ublas_matrix.push_back(row, row - m,     ScalarType(-1));
+        if (k > 0)     ublas_matrix.push_back(row, row - 1,     ScalarType(-1));
+
+        ublas_matrix.push_back(row, row, ScalarType(6));  // diagonal
+
+        if (k < m - 1) ublas_matrix.push_back(row, row + 1,     ScalarType(-1));
+        if (j < m - 1) ublas_matrix.push_back(row, row + m,     ScalarType(-1));
+        if (i < m - 1) ublas_matrix.push_back(row, row + m * m, ScalarType(-1));
+      }
+}
+
+
+template <typename ScalarType>
+void run_amg(viennacl::compressed_matrix<ScalarType> const & vcl_matrix,
+             viennacl::vector<ScalarType> const & vcl_rhs,
+             viennacl::linalg::amg_tag const & amg_config,
+             std::string const & name)
+{
+  Timer timer;
+
+  std::cout << "------- AMG: " << name << " ----------" << std::endl;
+
+  viennacl::backend::finish();
+  timer.start();
+  viennacl::linalg::amg_precond< viennacl::compressed_matrix<ScalarType> > vcl_amg(vcl_matrix, amg_config);
+  vcl_amg.setup();
+  viennacl::backend::finish();
+  double setup_time = timer.get();
+
+  boost::numeric::ublas::vector<ScalarType> avgstencil;
+  std::cout << "Levels: " << vcl_amg.tag().get_coarselevels() + 1 << ", operator complexity: " << vcl_amg.calc_complexity(avgstencil) << std::endl;
+  std::cout << "Setup time: " << setup_time << std::endl;
+
+  viennacl::linalg::cg_tag cg_solver(1e-8, 200);
+  vcl_amg.tag().set_timing(true);
+  timer.start();
+  viennacl::vector<ScalarType> vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs, cg_solver, vcl_amg);
+  viennacl::backend::finish();
+  double solve_time = timer.get();
+
+  viennacl::vector<ScalarType> vcl_residual = vcl_rhs;
+  vcl_residual -= viennacl::linalg::prod(vcl_matrix, vcl_result);
+  std::cout << "CG iterations: " << cg_solver.iters() << ", relative residual: "
+            << viennacl::linalg::norm_2(vcl_residual) / viennacl::linalg::norm_2(vcl_rhs) << std::endl;
+  std::cout << "Solve time: " << solve_time << ", setup + solve time: " << setup_time + solve_time << std::endl;
+  std::cout << "Time per level:";
+  for (unsigned int level = 0; level <= vcl_amg.tag().get_coarselevels(); ++level)
+    std::cout << " " << vcl_amg.tag().get_level_time(level);
+  std::cout << std::endl;
+}
+
+
+template<typename ScalarType>
+int run_benchmark()
+{
+  std::size_t m = 60;
+
+  boost::numeric::ublas::compressed_matrix<ScalarType> ublas_matrix;
+  generate_laplace_3d_matrix(m, ublas_matrix);
+
+  viennacl::compressed_matrix<ScalarType> vcl_matrix(ublas_matrix.size1(), ublas_matrix.size2());
+  viennacl::copy(ublas_matrix, vcl_matrix);
+
+  viennacl::vector<ScalarType> vcl_rhs = viennacl::scalar_vector<ScalarType>(ublas_matrix.size1(), ScalarType(1));
+
+  std::cout << std::endl << "   ### 3D Laplace matrix (" << ublas_matrix.size1() << " rows, " << ublas_matrix.nnz() << " nonzeros) ###" << std::endl;
+
+  viennacl::linalg::amg_tag amg_rs_direct(VIENNACL_AMG_COARSE_RS, VIENNACL_AMG_INTERPOL_DIRECT);
+  run_amg(vcl_matrix, vcl_rhs, amg_rs_direct, "classical RS coarsening, direct interpolation");
+
+  viennacl::linalg::amg_tag amg_onepass_classic(VIENNACL_AMG_COARSE_ONEPASS, VIENNACL_AMG_INTERPOL_CLASSIC);
+  run_amg(vcl_matrix, vcl_rhs, amg_onepass_classic, "one-pass coarsening, classical interpolation");
+
+  viennacl::linalg::amg_tag amg_rs0_direct(VIENNACL_AMG_COARSE_RS0, VIENNACL_AMG_INTERPOL_DIRECT);
+  run_amg(vcl_matrix, vcl_rhs, amg_rs0_direct, "RS0 coarsening, direct interpolation");
+
+  viennacl::linalg::amg_tag amg_rs3_direct(VIENNACL_AMG_COARSE_RS3, VIENNACL_AMG_INTERPOL_DIRECT);
+  run_amg(vcl_matrix, vcl_rhs, amg_rs3_direct, "RS3 coarsening, direct interpolation");
+
+  viennacl::linalg::amg_tag amg_rs_l1_jacobi(VIENNACL_AMG_COARSE_RS, VIENNACL_AMG_INTERPOL_DIRECT);
+  amg_rs_l1_jacobi.set_smoother(VIENNACL_AMG_SMOOTHER_L1_JACOBI);
+  run_amg(vcl_matrix, vcl_rhs, amg_rs_l1_jacobi, "classical RS coarsening, direct interpolation, l1-Jacobi smoother");
+
+  viennacl::linalg::amg_tag amg_rs_gauss_seidel(VIENNACL_AMG_COARSE_RS, VIENNACL_AMG_INTERPOL_DIRECT);
+  amg_rs_gauss_seidel.set_smoother(VIENNACL_AMG_SMOOTHER_GAUSS_SEIDEL);
+  run_amg(vcl_matrix, vcl_rhs, amg_rs_gauss_seidel, "classical RS coarsening, direct interpolation, multicolor Gauss-Seidel smoother");
+
+  viennacl::linalg::amg_tag amg_rs_chebyshev(VIENNACL_AMG_COARSE_RS, VIENNACL_AMG_INTERPOL_DIRECT);
+  amg_rs_chebyshev.set_smoother(VIENNACL_AMG_SMOOTHER_CHEBYSHEV);
+  amg_rs_chebyshev.set_presmooth(2);
+  amg_rs_chebyshev.set_postsmooth(2);
+  run_amg(vcl_matrix, vcl_rhs, amg_rs_chebyshev, "classical RS coarsening, direct interpolation, Chebyshev smoother of degree 2");
+
+  viennacl::linalg::amg_tag amg_rs_w_cycle(VIENNACL_AMG_COARSE_RS, VIENNACL_AMG_INTERPOL_DIRECT);
+  amg_rs_w_cycle.set_smoother(VIENNACL_AMG_SMOOTHER_L1_JACOBI);
+  amg_rs_w_cycle.set_cycle(VIENNACL_AMG_CYCLE_W);
+  run_amg(vcl_matrix, vcl_rhs, amg_rs_w_cycle, "classical RS coarsening, direct interpolation, l1-Jacobi smoother, W-cycle");
+
+  viennacl::linalg::amg_tag amg_ag(VIENNACL_AMG_COARSE_AG, VIENNACL_AMG_INTERPOL_AG, 0.08, 0, 1);
+  run_amg(vcl_matrix, vcl_rhs, amg_ag, "aggregation, plain interpolation");
+
+  viennacl::linalg::amg_tag amg_sa(VIENNACL_AMG_COARSE_AG, VIENNACL_AMG_INTERPOL_SA, 0.08, 0.67, 1);
+  run_amg(vcl_matrix, vcl_rhs, amg_sa, "aggregation, smoothed interpolation");
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "               Device Info" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  std::cout << viennacl::ocl::current_device().info() << std::endl;
+#endif
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Benchmark :: AMG" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  std::cout << "   # benchmarking single-precision" << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  run_benchmark<float>();
+#ifdef VIENNACL_WITH_OPENCL
+  if( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    std::cout << "   # benchmarking double-precision" << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    run_benchmark<double>();
+  }
+  return 0;
+}
@@ -98,6 +98,28 @@ int run_benchmark()
   // Now iterate over all OpenCL devices in the context and compute the matrix-matrix product
   //
 
+  std::cout << " ------ Benchmark 0: Reference triple loop on host (former host_based implementation) ------ " << std::endl;
+
+  {
+    // stl_A is stored row-major, stl_B column-major. Same i/j/k loop order as the former host_based::detail::prod:
+    timer.start();
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long i=0; i<static_cast<long>(BLAS3_MATRIX_SIZE); ++i)
+      for (std::size_t j=0; j<BLAS3_MATRIX_SIZE; ++j)
+      {
+        ScalarType temp = 0;
+        for (std::size_t k=0; k<BLAS3_MATRIX_SIZE; ++k)
+          temp += stl_A[i*BLAS3_MATRIX_SIZE + k] * stl_B[k + j*BLAS3_MATRIX_SIZE];
+        stl_C[i*BLAS3_MATRIX_SIZE + j] = temp;
+      }
+    exec_time = timer.get();
+    std::cout << " - Execution time on host: " << exec_time << std::endl;
+    std::cout << " - GFLOPs (counting multiply&add as separate operations): " << 2.0 * (BLAS3_MATRIX_SIZE / 1000.0) * (BLAS3_MATRIX_SIZE / 1000.0) * (BLAS3_MATRIX_SIZE / 1000.0) / exec_time << std::endl;
+    std::cout << std::endl;
+  }
+
   std::cout << " ------ Benchmark 1: Matrix-Matrix product ------ " << std::endl;
 
 
@@ -130,6 +152,33 @@ int run_benchmark()
     std::cout << std::endl;
   }
 
+  std::cout << " ------ Benchmark 1b: Matrix-Matrix product with transposed operands ------ " << std::endl;
+
+  for (std::size_t i=0; i<devices.size(); ++i)
+  {
+#ifdef VIENNACL_WITH_OPENCL
+    viennacl::ocl::current_context().switch_device(devices[i]);
+    std::cout << " - Device Name: " << viennacl::ocl::current_device().name() << std::endl;
+#endif
+
+    vcl_C = viennacl::linalg::prod(trans(vcl_A), vcl_B);
+    viennacl::backend::finish();
+    timer.start();
+    vcl_C = viennacl::linalg::prod(trans(vcl_A), vcl_B);
+    viennacl::backend::finish();
+    exec_time = timer.get();
+    std::cout << " - C = prod(trans(A), B) execution time: " << exec_time << ", GFLOPs: " << 2.0 * (vcl_A.size1() / 1000.0) * (vcl_A.size2() / 1000.0) * (vcl_B.size2() / 1000.0) / exec_time << std::endl;
+
+    vcl_C = viennacl::linalg::prod(vcl_A, trans(vcl_B));
+    viennacl::backend::finish();
+    timer.start();
+    vcl_C = viennacl::linalg::prod(vcl_A, trans(vcl_B));
+    viennacl::backend::finish();
+    exec_time = timer.get();
+    std::cout << " - C = prod(A, trans(B)) execution time: " << exec_time << ", GFLOPs: " << 2.0 * (vcl_A.size1() / 1000.0) * (vcl_A.size2() / 1000.0) * (vcl_B.size2() / 1000.0) / exec_time << std::endl;
+    std::cout << std::endl;
+  }
+
   std::cout << " ------ Benchmark 2: Matrix-Matrix product using ranges ------ " << std::endl;
 
   viennacl::range r(BLAS3_MATRIX_SIZE/4, 3 * BLAS3_MATRIX_SIZE/4);
@@ -206,6 +255,20 @@ int run_benchmark()
     std::cout << " - Execution time on device (no setup time included): " << exec_time << std::endl;
     std::cout << " - GFLOPs (counting multiply&add as separate operations): " << 2.0 * (vcl_A.size1() / 1000.0) * (vcl_A.size2() / 1000.0) * (vcl_A.size2() / 1000.0) / exec_time << std::endl;
     std::cout << std::endl;
+
+    std::cout << " - with partial pivoting:" << std::endl;
+    std::vector<viennacl::vcl_size_t> permutation;
+    viennacl::fast_copy(&(stl_A[0]),
+                        &(stl_A[0]) + stl_A.size(),
+                        vcl_A);
+    viennacl::backend::finish();
+    timer.start();
+    viennacl::linalg::lu_factorize(vcl_A, permutation);
+    viennacl::backend::finish();
+    exec_time = timer.get();
+    std::cout << " - Execution time on device (no setup time included): " << exec_time << std::endl;
+    std::cout << " - GFLOPs (counting multiply&add as separate operations): " << 2.0 * (vcl_A.size1() / 1000.0) * (vcl_A.size2() / 1000.0) * (vcl_A.size2() / 1000.0) / exec_time << std::endl;
+    std::cout << std::endl;
   }
 
   return EXIT_SUCCESS;
@@ -0,0 +1,127 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/*
+*
+*   Benchmark:   Nonnegative matrix factorization
+*
+*/
+
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/nmf.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+#include "benchmark-utils.hpp"
+
+
+#define BENCHMARK_ITERATIONS  10
+
+
+template <typename ScalarType>
+void fill_random(std::vector< std::vector<ScalarType> > & v)
+{
+  for (std::size_t i = 0; i < v.size(); ++i)
+    for (std::size_t j = 0; j < v[i].size(); ++j)
+      v[i][j] = static_cast<ScalarType>(rand()) / static_cast<ScalarType>(RAND_MAX);
+}
+
+template <typename ScalarType>
+void run_nmf(std::size_t m, std::size_t n, std::size_t k)
+{
+  std::vector< std::vector<ScalarType> > stl_v(m, std::vector<ScalarType>(n));
+  std::vector< std::vector<ScalarType> > stl_w(m, std::vector<ScalarType>(k));
+  std::vector< std::vector<ScalarType> > stl_h(k, std::vector<ScalarType>(n));
+
+  fill_random(stl_v);
+  fill_random(stl_w);
+  fill_random(stl_h);
+
+  viennacl::matrix<ScalarType> vcl_V(m, n);
+  viennacl::matrix<ScalarType> vcl_W(m, k);
+  viennacl::matrix<ScalarType> vcl_H(k, n);
+
+  viennacl::copy(stl_v, vcl_V);
+  viennacl::copy(stl_w, vcl_W);
+  viennacl::copy(stl_h, vcl_H);
+
+  // fixed number of iterations, residual evaluated in each iteration:
+  viennacl::linalg::nmf_config conf(0.0, 0.0, BENCHMARK_ITERATIONS, 1);
+
+  viennacl::backend::finish();
+  Timer timer;
+  timer.start();
+  viennacl::linalg::nmf(vcl_V, vcl_W, vcl_H, conf);
+  viennacl::backend::finish();
+  double exec_time = timer.get();
+
+  // two products with V and two Gram matrices with their use in the update per iteration, plus the residual:
+  double flops_per_iteration = 2.0 * (2.0 * double(m) * double(n) * double(k) + 2.0 * double(m + n) * double(k) * double(k))
+                             + 2.0 * double(m) * double(n) * double(k);
+  double time_per_iteration = exec_time / static_cast<double>(conf.iters());
+
+  std::cout << std::setw(8) << m << std::setw(8) << n << std::setw(6) << k
+            << std::setw(14) << time_per_iteration
+            << std::setw(10) << 1e-9 * flops_per_iteration / time_per_iteration
+            << "   residuals:";
+  for (std::size_t i = 0; i < conf.residuals().size(); ++i)
+    std::cout << " " << conf.residuals()[i];
+  std::cout << std::endl;
+}
+
+template <typename ScalarType>
+int run_benchmark()
+{
+  std::cout << std::setw(8) << "m" << std::setw(8) << "n" << std::setw(6) << "k"
+            << std::setw(14) << "sec/iter" << std::setw(10) << "GFLOPs" << std::endl;
+
+  run_nmf<ScalarType>(  2000,  1000,  20);
+  run_nmf<ScalarType>( 10000,  2000,  50);
+  run_nmf<ScalarType>( 20000,  5000, 100);
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Benchmark :: Nonnegative Matrix Factorization" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  std::cout << "   # benchmarking single-precision" << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  run_benchmark<float>();
+  {
+    std::cout << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    std::cout << "   # benchmarking double-precision" << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    run_benchmark<double>();
+  }
+  return 0;
+}
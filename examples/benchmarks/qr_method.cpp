@@ -0,0 +1,219 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/*
+*
+*   Benchmark:   Eigenvalues and eigenvectors by the QR method
+*
+*/
+
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/qr-method.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "benchmark-utils.hpp"
+
+
+/** @brief Reads a test matrix and the real parts of its eigenvalues from one of the files in examples/testdata/eigen/ */
+template <typename ScalarType>
+bool read_eigen_example(std::string const & filename,
+                        boost::numeric::ublas::matrix<ScalarType> & A,
+                        std::vector<ScalarType> & eigen_re)
+{
+  std::ifstream f(filename.c_str());
+  if (!f.is_open())
+    return false;
+
+  std::size_t sz;
+  f >> sz;
+
+  A.resize(sz, sz, false);
+  for (std::size_t i = 0; i < sz; ++i)
+    for (std::size_t j = 0; j < sz; ++j)
+      f >> A(i, j);
+
+  eigen_re.resize(sz);
+  for (std::size_t i = 0; i < sz; ++i)
+    f >> eigen_re[i];
+
+  // for nonsymmetric matrices the imaginary parts follow, which are not needed here
+  return true;
+}
+
+
+/** @brief Runs the QR method on A and prints the execution time, the relative error of the eigenvalues (if available), and the relative residual of A * Q - Q * Lambda */
+template <typename ScalarType, typename F>
+void run_qr_method(std::string const & name, bool is_symmetric,
+                   boost::numeric::ublas::matrix<ScalarType> const & ublas_A, std::vector<ScalarType> eigen_ref)
+{
+  std::size_t sz = ublas_A.size1();
+
+  viennacl::matrix<ScalarType, F> A(sz, sz), Q(sz, sz);
+  viennacl::copy(ublas_A, A);
+
+  boost::numeric::ublas::vector<ScalarType> D(sz), E(sz);
+
+  viennacl::backend::finish();
+  Timer timer;
+  timer.start();
+  if (is_symmetric)
+    viennacl::linalg::qr_method_sym(A, Q, D);
+  else
+    viennacl::linalg::qr_method_nsm(A, Q, D, E);
+  viennacl::backend::finish();
+  double exec_time = timer.get();
+
+  // relative error of the (real parts of the) eigenvalues:
+  double eigen_diff = 0;
+  if (eigen_ref.size() > 0)
+  {
+    std::vector<ScalarType> eigen(D.begin(), D.end());
+
+    std::sort(eigen.begin(), eigen.end());
+    std::sort(eigen_ref.begin(), eigen_ref.end());
+
+    double eigen_max = 0;
+    for (std::size_t i = 0; i < eigen.size(); ++i)
+    {
+      eigen_diff = std::max(eigen_diff, static_cast<double>(std::fabs(eigen[i] - eigen_ref[i])));
+      eigen_max  = std::max(eigen_max,  static_cast<double>(std::fabs(eigen_ref[i])));
+    }
+    eigen_diff /= eigen_max;
+  }
+
+  // relative residual A * Q - Q * Lambda:
+  viennacl::matrix<ScalarType, F> A_ref(sz, sz), AQ(sz, sz), QL(sz, sz);
+  viennacl::copy(ublas_A, A_ref);
+  AQ = viennacl::linalg::prod(A_ref, Q);
+  QL = viennacl::linalg::prod(Q, A);
+
+  boost::numeric::ublas::matrix<ScalarType> ublas_AQ(sz, sz), ublas_QL(sz, sz);
+  viennacl::copy(AQ, ublas_AQ);
+  viennacl::copy(QL, ublas_QL);
+
+  double prod_diff = 0;
+  double prod_max = 0;
+  for (std::size_t i = 0; i < sz; ++i)
+    for (std::size_t j = 0; j < sz; ++j)
+    {
+      prod_diff = std::max(prod_diff, static_cast<double>(std::fabs(ublas_AQ(i, j) - ublas_QL(i, j))));
+      prod_max  = std::max(prod_max,  static_cast<double>(std::fabs(ublas_AQ(i, j))));
+    }
+  prod_diff /= prod_max;
+
+  std::cout << std::setw(20) << name
+            << std::setw(7) << sz
+            << std::setw(14) << exec_time;
+  if (eigen_ref.size() > 0)
+    std::cout << std::setw(14) << eigen_diff;
+  else
+    std::cout << std::setw(14) << "-";
+  std::cout << std::setw(14) << prod_diff << std::endl;
+}
+
+
+template <typename ScalarType, typename F>
+int run_benchmark()
+{
+  std::cout << std::setw(20) << "matrix" << std::setw(7) << "size"
+            << std::setw(14) << "time (sec)" << std::setw(14) << "eigen error" << std::setw(14) << "prod error" << std::endl;
+
+  // matrices with known eigenvalues:
+  char const * examples[] = { "symm1", "symm2", "symm3", "nsm1", "nsm2", "nsm3" };
+  for (std::size_t i = 0; i < sizeof(examples) / sizeof(examples[0]); ++i)
+  {
+    bool is_symmetric = (examples[i][0] == 's');
+    boost::numeric::ublas::matrix<ScalarType> A;
+    std::vector<ScalarType> eigen_re;
+    if (!read_eigen_example(std::string("../examples/testdata/eigen/") + examples[i] + ".example", A, eigen_re))
+    {
+      std::cout << "Error reading file ../examples/testdata/eigen/" << examples[i] << ".example" << std::endl;
+      return EXIT_FAILURE;
+    }
+    run_qr_method<ScalarType, F>(examples[i], is_symmetric, A, eigen_re);
+  }
+
+  // random symmetric matrices:
+  std::size_t sizes_symm[] = { 500, 1000, 2000, 4000 };
+  for (std::size_t i = 0; i < sizeof(sizes_symm) / sizeof(sizes_symm[0]); ++i)
+  {
+    boost::numeric::ublas::matrix<ScalarType> A(sizes_symm[i], sizes_symm[i]);
+    for (std::size_t r = 0; r < A.size1(); ++r)
+      for (std::size_t c = 0; c <= r; ++c)
+      {
+        A(r, c) = static_cast<ScalarType>(rand()) / static_cast<ScalarType>(RAND_MAX);
+        A(c, r) = A(r, c);
+      }
+    run_qr_method<ScalarType, F>("random symmetric", true, A, std::vector<ScalarType>());
+  }
+
+  // random nonsymmetric matrices:
+  std::size_t sizes_nsm[] = { 500, 1000 };
+  for (std::size_t i = 0; i < sizeof(sizes_nsm) / sizeof(sizes_nsm[0]); ++i)
+  {
+    boost::numeric::ublas::matrix<ScalarType> A(sizes_nsm[i], sizes_nsm[i]);
+    for (std::size_t r = 0; r < A.size1(); ++r)
+      for (std::size_t c = 0; c < A.size2(); ++c)
+        A(r, c) = static_cast<ScalarType>(rand()) / static_cast<ScalarType>(RAND_MAX);
+    run_qr_method<ScalarType, F>("random", false, A, std::vector<ScalarType>());
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Benchmark :: QR Method for Eigenvalues" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  std::cout << "   # benchmarking single-precision" << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  if (run_benchmark<float, viennacl::row_major>() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+#ifdef VIENNACL_WITH_OPENCL
+  if( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    std::cout << "   # benchmarking double-precision" << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    if (run_benchmark<double, viennacl::row_major>() != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -33,6 +33,7 @@
 #include "viennacl/linalg/inner_prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/scheduler/execute.hpp"
+#include "viennacl/scheduler/statement_list.hpp"
 
 #include <iostream>
 #include <vector>
@@ -46,6 +47,11 @@ using std::endl;
 #define BENCHMARK_VECTOR_SIZE   2
 #define BENCHMARK_RUNS          1000
 
+#define BENCHMARK_NESTED_VECTOR_SIZE   1000000
+#define BENCHMARK_NESTED_RUNS          100
+
+#define BENCHMARK_BATCH_RUNS           1000
+
 
 template<typename ScalarType>
 int run_benchmark()
@@ -116,6 +122,136 @@ int run_benchmark()
   return 0;
 }
 
+
+template<typename ScalarType>
+int run_nested_benchmark()
+{
+  Timer timer;
+  double exec_time;
+  double pass_time;
+
+  std::vector<ScalarType> std_vec(BENCHMARK_NESTED_VECTOR_SIZE);
+  for (std::size_t i=0; i<std_vec.size(); ++i)
+    std_vec[i] = ScalarType(1) + ScalarType(i) / ScalarType(BENCHMARK_NESTED_VECTOR_SIZE);
+
+  viennacl::vector<ScalarType> vcl_x(BENCHMARK_NESTED_VECTOR_SIZE);
+  viennacl::vector<ScalarType> vcl_y(BENCHMARK_NESTED_VECTOR_SIZE);
+  viennacl::vector<ScalarType> vcl_z(BENCHMARK_NESTED_VECTOR_SIZE);
+  viennacl::vector<ScalarType> vcl_w(BENCHMARK_NESTED_VECTOR_SIZE);
+  viennacl::fast_copy(std_vec, vcl_y);
+  viennacl::fast_copy(std_vec, vcl_z);
+  vcl_z *= ScalarType(2);
+  viennacl::fast_copy(std_vec, vcl_w);
+  ScalarType alpha = ScalarType(1.1415);
+  ScalarType beta  = ScalarType(0.97172);
+  ScalarType gamma = ScalarType(3.1);
+
+  // reference: a single pass over three vectors
+  vcl_x = vcl_y + vcl_z;
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_NESTED_RUNS; ++runs)
+    vcl_x = vcl_y + vcl_z;
+  viennacl::backend::finish();
+  pass_time = timer.get() / BENCHMARK_NESTED_RUNS;
+  std::cout << "Execution time per operation, x = y + z (one pass): " << pass_time << " sec" << std::endl;
+
+  // x = a*y + b*(z - w)/c using the expression template API:
+  vcl_x = alpha * vcl_y + beta * (vcl_z - vcl_w) / gamma;
+  viennacl::backend::finish();
+  viennacl::backend::cpu_ram::reset_statistics();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_NESTED_RUNS; ++runs)
+    vcl_x = alpha * vcl_y + beta * (vcl_z - vcl_w) / gamma;
+  viennacl::backend::finish();
+  exec_time = timer.get() / BENCHMARK_NESTED_RUNS;
+  std::cout << "Execution time per operation, x = a*y + b*(z - w)/c, no scheduler: " << exec_time << " sec (" << exec_time / pass_time << " passes";
+  if (viennacl::backend::default_memory_type() == viennacl::MAIN_MEMORY)
+    std::cout << ", " << double(viennacl::backend::cpu_ram::statistics().allocations) / BENCHMARK_NESTED_RUNS << " allocations";
+  std::cout << ")" << std::endl;
+  std::cout << "Result: " << vcl_x[0] << std::endl;
+
+  // the same statement executed by the scheduler (fused in main memory):
+  viennacl::scheduler::statement   my_statement(vcl_x, viennacl::op_assign(), alpha * vcl_y + beta * (vcl_z - vcl_w) / gamma);
+  viennacl::scheduler::execute(my_statement);
+  viennacl::backend::finish();
+  viennacl::backend::cpu_ram::reset_statistics();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_NESTED_RUNS; ++runs)
+    viennacl::scheduler::execute(my_statement);
+  viennacl::backend::finish();
+  exec_time = timer.get() / BENCHMARK_NESTED_RUNS;
+  std::cout << "Execution time per operation, x = a*y + b*(z - w)/c, with scheduler: " << exec_time << " sec (" << exec_time / pass_time << " passes";
+  if (viennacl::backend::default_memory_type() == viennacl::MAIN_MEMORY)
+    std::cout << ", " << double(viennacl::backend::cpu_ram::statistics().allocations) / BENCHMARK_NESTED_RUNS << " allocations";
+  std::cout << ")" << std::endl;
+  std::cout << "Result: " << vcl_x[0] << std::endl;
+
+  return 0;
+}
+
+// statements of one iteration of a conjugate gradient solver with the inner products computed after the vector updates:
+template<typename ScalarType>
+int run_batch_benchmark(std::size_t size)
+{
+  Timer timer;
+  double exec_time;
+
+  std::vector<ScalarType> std_vec(size);
+  for (std::size_t i=0; i<std_vec.size(); ++i)
+    std_vec[i] = ScalarType(1) + ScalarType(i) / ScalarType(size);
+
+  viennacl::vector<ScalarType> vcl_x(size);
+  viennacl::vector<ScalarType> vcl_r(size);
+  viennacl::vector<ScalarType> vcl_p(size);
+  viennacl::vector<ScalarType> vcl_Ap(size);
+  viennacl::fast_copy(std_vec, vcl_Ap);
+  ScalarType alpha = ScalarType(1e-6);
+  ScalarType beta  = ScalarType(0.5);
+  viennacl::scalar<ScalarType> rr(0);
+  viennacl::scalar<ScalarType> rAp(0);
+  viennacl::scalar<ScalarType> rp(0);
+
+  viennacl::scheduler::statement_list iteration;
+  iteration.add(viennacl::scheduler::statement(vcl_x, viennacl::op_assign(), vcl_x + alpha * vcl_p));
+  iteration.add(viennacl::scheduler::statement(vcl_r, viennacl::op_assign(), vcl_r - alpha * vcl_Ap));
+  iteration.add(viennacl::scheduler::statement(rr,    viennacl::op_assign(), viennacl::linalg::inner_prod(vcl_r, vcl_r)));
+  iteration.add(viennacl::scheduler::statement(rAp,   viennacl::op_assign(), viennacl::linalg::inner_prod(vcl_r, vcl_Ap)));
+  iteration.add(viennacl::scheduler::statement(rp,    viennacl::op_assign(), viennacl::linalg::inner_prod(vcl_r, vcl_p)));
+  iteration.add(viennacl::scheduler::statement(vcl_p, viennacl::op_assign(), vcl_r + beta * vcl_p));
+
+  std::cout << "Vector size: " << size << std::endl;
+
+  viennacl::fast_copy(std_vec, vcl_x);
+  viennacl::fast_copy(std_vec, vcl_r);
+  viennacl::fast_copy(std_vec, vcl_p);
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_BATCH_RUNS; ++runs)
+  {
+    for (std::size_t i=0; i<iteration.size(); ++i)
+      viennacl::scheduler::execute(iteration[i]);
+  }
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "Execution time per iteration, statements executed individually: " << exec_time / BENCHMARK_BATCH_RUNS << " sec" << std::endl;
+  std::cout << "Result: " << rr << std::endl;
+
+  viennacl::fast_copy(std_vec, vcl_x);
+  viennacl::fast_copy(std_vec, vcl_r);
+  viennacl::fast_copy(std_vec, vcl_p);
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_BATCH_RUNS; ++runs)
+    viennacl::scheduler::execute(iteration);
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "Execution time per iteration, statement list: " << exec_time / BENCHMARK_BATCH_RUNS << " sec" << std::endl;
+  std::cout << "Result: " << rr << std::endl;
+
+  return 0;
+}
+
 int main()
 {
   std::cout << std::endl;
@@ -137,6 +273,9 @@ int main()
   std::cout << "   # benchmarking single-precision" << std::endl;
   std::cout << "   -------------------------------" << std::endl;
   run_benchmark<float>();
+  run_nested_benchmark<float>();
+  run_batch_benchmark<float>(1000);
+  run_batch_benchmark<float>(100000);
 #ifdef VIENNACL_WITH_OPENCL
   if( viennacl::ocl::current_device().double_support() )
 #endif
@@ -146,6 +285,9 @@ int main()
     std::cout << "   # benchmarking double-precision" << std::endl;
     std::cout << "   -------------------------------" << std::endl;
     run_benchmark<double>();
+    run_nested_benchmark<double>();
+    run_batch_benchmark<double>(1000);
+    run_batch_benchmark<double>(100000);
   }
   return 0;
 }
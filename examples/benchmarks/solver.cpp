@@ -49,7 +49,7 @@
 #include "viennacl/linalg/jacobi_precond.hpp"
 #include "viennacl/linalg/row_scaling.hpp"
 
-#ifdef VIENNACL_WITH_OPENCL
+#ifndef VIENNACL_WITH_CUDA
   #include "viennacl/linalg/mixed_precision_cg.hpp"
 #endif
 
@@ -95,7 +95,7 @@ ScalarType diff_2(ublas::vector<ScalarType> & v1, viennacl::vector<ScalarType> &
 
 
 template <typename MatrixType, typename VectorType, typename SolverTag, typename PrecondTag>
-void run_solver(MatrixType const & matrix, VectorType const & rhs, VectorType const & ref_result, SolverTag const & solver, PrecondTag const & precond, long ops)
+double run_solver(MatrixType const & matrix, VectorType const & rhs, VectorType const & ref_result, SolverTag const & solver, PrecondTag const & precond, long ops)
 {
   Timer timer;
   VectorType result(rhs);
@@ -117,6 +117,7 @@ void run_solver(MatrixType const & matrix, VectorType const & rhs, VectorType co
   std::cout << "Iterations: " << solver.iters() << std::endl;
   result -= ref_result;
   std::cout << "Relative deviation from result: " << viennacl::linalg::norm_2(result) / viennacl::linalg::norm_2(ref_result) << std::endl;
+  return exec_time;
 }
 
 
@@ -228,10 +229,12 @@ int run_benchmark(viennacl::context ctx)
   ///////////////////////////////////////////////////////////////////////////////
   std::cout << "------- ILU0 on with ublas ----------" << std::endl;
 
+  viennacl::linalg::ilu0_tag ilu0_config;  // preconditioners keep a reference to their tag
+
   timer.start();
-  viennacl::linalg::ilu0_precond< ublas::compressed_matrix<ScalarType> >    ublas_ilu0(ublas_matrix, viennacl::linalg::ilu0_tag());
-  exec_time = timer.get();
-  std::cout << "Setup time (no level scheduling): " << exec_time << std::endl;
+  viennacl::linalg::ilu0_precond< ublas::compressed_matrix<ScalarType> >    ublas_ilu0(ublas_matrix, ilu0_config);
+  double ublas_ilu0_setup_time = timer.get();
+  std::cout << "Setup time (no level scheduling): " << ublas_ilu0_setup_time << std::endl;
   timer.start();
   for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
     ublas_ilu0.apply(ublas_vec1);
@@ -242,9 +245,9 @@ int run_benchmark(viennacl::context ctx)
   std::cout << "------- ILU0 with ViennaCL ----------" << std::endl;
 
   timer.start();
-  viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<ScalarType> > vcl_ilu0(vcl_compressed_matrix, viennacl::linalg::ilu0_tag());
-  exec_time = timer.get();
-  std::cout << "Setup time (no level scheduling): " << exec_time << std::endl;
+  viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<ScalarType> > vcl_ilu0(vcl_compressed_matrix, ilu0_config);
+  double vcl_ilu0_setup_time = timer.get();
+  std::cout << "Setup time (no level scheduling): " << vcl_ilu0_setup_time << std::endl;
 
   viennacl::backend::finish();
   timer.start();
@@ -313,10 +316,12 @@ int run_benchmark(viennacl::context ctx)
   ublas_vec1 = ublas_vec2;
   viennacl::copy(ublas_vec1, vcl_vec1);
 
+  viennacl::linalg::ilut_tag ilut_config;
+
   timer.start();
-  viennacl::linalg::ilut_precond< ublas::compressed_matrix<ScalarType> >    ublas_ilut(ublas_matrix, viennacl::linalg::ilut_tag());
-  exec_time = timer.get();
-  std::cout << "Setup time (no level scheduling): " << exec_time << std::endl;
+  viennacl::linalg::ilut_precond< ublas::compressed_matrix<ScalarType> >    ublas_ilut(ublas_matrix, ilut_config);
+  double ublas_ilut_setup_time = timer.get();
+  std::cout << "Setup time (no level scheduling): " << ublas_ilut_setup_time << std::endl;
   timer.start();
   for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
     ublas_ilut.apply(ublas_vec1);
@@ -327,9 +332,9 @@ int run_benchmark(viennacl::context ctx)
   std::cout << "------- ILUT with ViennaCL ----------" << std::endl;
 
   timer.start();
-  viennacl::linalg::ilut_precond< viennacl::compressed_matrix<ScalarType> > vcl_ilut(vcl_compressed_matrix, viennacl::linalg::ilut_tag());
-  exec_time = timer.get();
-  std::cout << "Setup time (no level scheduling): " << exec_time << std::endl;
+  viennacl::linalg::ilut_precond< viennacl::compressed_matrix<ScalarType> > vcl_ilut(vcl_compressed_matrix, ilut_config);
+  double vcl_ilut_setup_time = timer.get();
+  std::cout << "Setup time (no level scheduling): " << vcl_ilut_setup_time << std::endl;
 
   viennacl::backend::finish();
   timer.start();
@@ -403,16 +408,72 @@ int run_benchmark(viennacl::context ctx)
   run_solver(ublas_matrix, ublas_vec2, ublas_result, cg_solver, viennacl::linalg::no_precond(), cg_ops);
 
   std::cout << "------- CG solver (no preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
-  run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, cg_solver, viennacl::linalg::no_precond(), cg_ops);
+  double cg_time = run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, cg_solver, viennacl::linalg::no_precond(), cg_ops);
+  unsigned int cg_iters = cg_solver.iters();
 
-#ifdef VIENNACL_WITH_OPENCL
+#ifndef VIENNACL_WITH_CUDA
+  // per iteration: 13 vector passes for CG (incl. two separate reductions), 8 for pipelined CG (one fused update, inner products within the SpMV)
+  viennacl::linalg::pipelined_cg_tag pipelined_cg_solver(solver_tolerance, solver_iters);
+
+  std::cout << "------- Pipelined CG solver (no preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
+  double pipelined_cg_time = run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, pipelined_cg_solver, viennacl::linalg::no_precond(), cg_ops);
+  std::cout << "Speedup per iteration over CG: "
+            << (cg_time / cg_iters) / (pipelined_cg_time / pipelined_cg_solver.iters()) << std::endl;
+
+  std::cout << "------- Pipelined CG solver (no preconditioner) via ViennaCL, ell_matrix ----------" << std::endl;
+  run_solver(vcl_ell_matrix, vcl_vec2, vcl_result, pipelined_cg_solver, viennacl::linalg::no_precond(), cg_ops);
+
+  // several right hand sides: one sparse matrix-dense matrix product per iteration for block CG instead of one SpMV per right hand side
+  {
+    std::size_t num_rhs = 8;
+    std::vector<std::vector<ScalarType> > std_rhs(ublas_vec2.size(), std::vector<ScalarType>(num_rhs));
+    for (std::size_t i=0; i<ublas_vec2.size(); ++i)
+      for (std::size_t j=0; j<num_rhs; ++j)
+        std_rhs[i][j] = ublas_vec2[i] * ScalarType(j+1);
+
+    viennacl::matrix<ScalarType> vcl_rhs(ublas_vec2.size(), num_rhs, ctx);
+    viennacl::copy(std_rhs, vcl_rhs);
+
+    std::cout << "------- CG solver (no preconditioner) via ViennaCL, compressed_matrix, " << num_rhs << " right hand sides ----------" << std::endl;
+    viennacl::backend::finish();
+    timer.start();
+    for (std::size_t j=0; j<num_rhs; ++j)
+    {
+      viennacl::vector<ScalarType> vcl_column = viennacl::column(vcl_rhs, static_cast<unsigned int>(j));
+      vcl_result = viennacl::linalg::solve(vcl_compressed_matrix, vcl_column, cg_solver);
+    }
+    viennacl::backend::finish();
+    double repeated_cg_time = timer.get();
+    std::cout << "Exec. time: " << repeated_cg_time << std::endl;
+
+    viennacl::linalg::block_cg_tag block_cg_solver(solver_tolerance, solver_iters);
+
+    std::cout << "------- Block CG solver (no preconditioner) via ViennaCL, compressed_matrix, " << num_rhs << " right hand sides ----------" << std::endl;
+    viennacl::backend::finish();
+    timer.start();
+    viennacl::matrix<ScalarType> vcl_block_result = viennacl::linalg::solve(vcl_compressed_matrix, vcl_rhs, block_cg_solver);
+    viennacl::backend::finish();
+    double block_cg_time = timer.get();
+    std::cout << "Exec. time: " << block_cg_time << std::endl;
+    std::cout << "Estimated rel. residual: " << block_cg_solver.error() << std::endl;
+    std::cout << "Iterations: " << block_cg_solver.iters() << std::endl;
+    std::cout << "Speedup over repeated CG: " << repeated_cg_time / block_cg_time << std::endl;
+  }
+#endif
+
+#ifndef VIENNACL_WITH_CUDA
   if (sizeof(ScalarType) == sizeof(double))
   {
     std::cout << "------- CG solver, mixed precision (no preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
     viennacl::linalg::mixed_precision_cg_tag mixed_precision_cg_solver(solver_tolerance, solver_iters);
 
     run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, mixed_precision_cg_solver, viennacl::linalg::no_precond(), cg_ops);
-    run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, mixed_precision_cg_solver, viennacl::linalg::no_precond(), cg_ops);
+    double mixed_precision_cg_time = run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, mixed_precision_cg_solver, viennacl::linalg::no_precond(), cg_ops);
+    std::cout << "Inner iterations: " << mixed_precision_cg_solver.inner_iters() << std::endl;
+    std::cout << "Outer iterations: " << mixed_precision_cg_solver.outer_iters() << std::endl;
+    std::cout << "Speedup over double precision CG: " << cg_time / mixed_precision_cg_time << std::endl;
+    std::cout << "Speedup per iteration over double precision CG: "
+              << (cg_time / cg_iters) / (mixed_precision_cg_time / mixed_precision_cg_solver.inner_iters()) << std::endl;
   }
 #endif
 
@@ -433,10 +494,12 @@ int run_benchmark(viennacl::context ctx)
 
 
   std::cout << "------- CG solver (ILU0 preconditioner) using ublas ----------" << std::endl;
-  run_solver(ublas_matrix, ublas_vec2, ublas_result, cg_solver, ublas_ilu0, cg_ops);
+  exec_time = run_solver(ublas_matrix, ublas_vec2, ublas_result, cg_solver, ublas_ilu0, cg_ops);
+  std::cout << "Preconditioner setup time: " << ublas_ilu0_setup_time << ", setup + solve time: " << ublas_ilu0_setup_time + exec_time / BENCHMARK_RUNS << std::endl;
 
   std::cout << "------- CG solver (ILU0 preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
-  run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, cg_solver, vcl_ilu0, cg_ops);
+  exec_time = run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, cg_solver, vcl_ilu0, cg_ops);
+  std::cout << "Preconditioner setup time: " << vcl_ilu0_setup_time << ", setup + solve time: " << vcl_ilu0_setup_time + exec_time / BENCHMARK_RUNS << std::endl;
 
 
   std::cout << "------- CG solver (Block-ILU0 preconditioner) using ublas ----------" << std::endl;
@@ -446,10 +509,12 @@ int run_benchmark(viennacl::context ctx)
   run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, cg_solver, vcl_block_ilu0, cg_ops);
 
   std::cout << "------- CG solver (ILUT preconditioner) using ublas ----------" << std::endl;
-  run_solver(ublas_matrix, ublas_vec2, ublas_result, cg_solver, ublas_ilut, cg_ops);
+  exec_time = run_solver(ublas_matrix, ublas_vec2, ublas_result, cg_solver, ublas_ilut, cg_ops);
+  std::cout << "Preconditioner setup time: " << ublas_ilut_setup_time << ", setup + solve time: " << ublas_ilut_setup_time + exec_time / BENCHMARK_RUNS << std::endl;
 
   std::cout << "------- CG solver (ILUT preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
-  run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, cg_solver, vcl_ilut, cg_ops);
+  exec_time = run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, cg_solver, vcl_ilut, cg_ops);
+  std::cout << "Preconditioner setup time: " << vcl_ilut_setup_time << ", setup + solve time: " << vcl_ilut_setup_time + exec_time / BENCHMARK_RUNS << std::endl;
 
   std::cout << "------- CG solver (ILUT preconditioner) via ViennaCL, coordinate_matrix ----------" << std::endl;
   run_solver(vcl_coordinate_matrix, vcl_vec2, vcl_result, cg_solver, vcl_ilut, cg_ops);
@@ -492,17 +557,33 @@ int run_benchmark(viennacl::context ctx)
   run_solver(ublas_matrix, ublas_vec2, ublas_result, bicgstab_solver, viennacl::linalg::no_precond(), bicgstab_ops);
 
   std::cout << "------- BiCGStab solver (no preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
-  run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, bicgstab_solver, viennacl::linalg::no_precond(), bicgstab_ops);
+  double bicgstab_time = run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, bicgstab_solver, viennacl::linalg::no_precond(), bicgstab_ops);
+  std::size_t bicgstab_iters = bicgstab_solver.iters();
+
+#ifndef VIENNACL_WITH_CUDA
+  // per iteration: five reductions with a host synchronization each for BiCGStab, two for pipelined BiCGStab (inner products within the SpMVs and the fused update)
+  viennacl::linalg::pipelined_bicgstab_tag pipelined_bicgstab_solver(solver_tolerance, solver_iters);
+
+  std::cout << "------- Pipelined BiCGStab solver (no preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
+  double pipelined_bicgstab_time = run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, pipelined_bicgstab_solver, viennacl::linalg::no_precond(), bicgstab_ops);
+  std::cout << "Speedup per iteration over BiCGStab: "
+            << (bicgstab_time / bicgstab_iters) / (pipelined_bicgstab_time / pipelined_bicgstab_solver.iters()) << std::endl;
+
+  std::cout << "------- Pipelined BiCGStab solver (no preconditioner) via ViennaCL, ell_matrix ----------" << std::endl;
+  run_solver(vcl_ell_matrix, vcl_vec2, vcl_result, pipelined_bicgstab_solver, viennacl::linalg::no_precond(), bicgstab_ops);
+#endif
 
   std::cout << "------- BiCGStab solver (no preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
   run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, bicgstab_solver, viennacl::linalg::no_precond(), bicgstab_ops);
 
 
   std::cout << "------- BiCGStab solver (ILUT preconditioner) using ublas ----------" << std::endl;
-  run_solver(ublas_matrix, ublas_vec2, ublas_result, bicgstab_solver, ublas_ilut, bicgstab_ops);
+  exec_time = run_solver(ublas_matrix, ublas_vec2, ublas_result, bicgstab_solver, ublas_ilut, bicgstab_ops);
+  std::cout << "Preconditioner setup time: " << ublas_ilut_setup_time << ", setup + solve time: " << ublas_ilut_setup_time + exec_time / BENCHMARK_RUNS << std::endl;
 
   std::cout << "------- BiCGStab solver (ILUT preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
-  run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, bicgstab_solver, vcl_ilut, bicgstab_ops);
+  exec_time = run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, bicgstab_solver, vcl_ilut, bicgstab_ops);
+  std::cout << "Preconditioner setup time: " << vcl_ilut_setup_time << ", setup + solve time: " << vcl_ilut_setup_time + exec_time / BENCHMARK_RUNS << std::endl;
 
   std::cout << "------- BiCGStab solver (Block-ILUT preconditioner) using ublas ----------" << std::endl;
   run_solver(ublas_matrix, ublas_vec2, ublas_result, bicgstab_solver, ublas_block_ilut, bicgstab_ops);
@@ -547,7 +628,18 @@ int run_benchmark(viennacl::context ctx)
   run_solver(ublas_matrix, ublas_vec2, ublas_result, gmres_solver, viennacl::linalg::no_precond(), gmres_ops);
 
   std::cout << "------- GMRES solver (no preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
-  run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, gmres_solver, viennacl::linalg::no_precond(), gmres_ops);
+  double gmres_time = run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, gmres_solver, viennacl::linalg::no_precond(), gmres_ops);
+  unsigned int gmres_iters = gmres_solver.iters();
+
+#ifndef VIENNACL_WITH_CUDA
+  // per iteration: one multi-inner product and one norm for pipelined GMRES instead of a pair of reductions for each Householder reflection
+  viennacl::linalg::pipelined_gmres_tag pipelined_gmres_solver(solver_tolerance, solver_iters, solver_krylov_dim);
+
+  std::cout << "------- Pipelined GMRES solver (no preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
+  double pipelined_gmres_time = run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, pipelined_gmres_solver, viennacl::linalg::no_precond(), gmres_ops);
+  std::cout << "Speedup per iteration over GMRES: "
+            << (gmres_time / gmres_iters) / (pipelined_gmres_time / pipelined_gmres_solver.iters()) << std::endl;
+#endif
 
   std::cout << "------- GMRES solver (no preconditioner) on GPU, coordinate_matrix ----------" << std::endl;
   run_solver(vcl_coordinate_matrix, vcl_vec2, vcl_result, gmres_solver, viennacl::linalg::no_precond(), gmres_ops);
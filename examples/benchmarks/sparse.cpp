@@ -39,6 +39,7 @@
 #include "viennacl/compressed_matrix.hpp"
 #include "viennacl/ell_matrix.hpp"
 #include "viennacl/hyb_matrix.hpp"
+#include "viennacl/sliced_ell_matrix.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/io/matrix_market.hpp"
@@ -47,6 +48,10 @@
 
 #include <iostream>
 #include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
 #include "benchmark-utils.hpp"
 #include "io.hpp"
 
@@ -54,8 +59,71 @@
 #define BENCHMARK_RUNS          10
 
 
+/** @brief Prints the floating point performance and the effective memory bandwidth of a sparse matrix-vector product.
+*
+* @param nnz        Number of nonzeros of the matrix, each resulting in two floating point operations
+* @param num_bytes  Number of bytes which need to be transferred at least (matrix data, source and result vector)
+* @param exec_time  Execution time of a single matrix-vector product
+*/
+void printSpMVStats(double nnz, double num_bytes, double exec_time)
+{
+  std::cout << "GFLOPs: " << 2.0 * nnz / exec_time * 1e-9 << ", effective bandwidth: " << num_bytes / exec_time * 1e-9 << " GB/s" << std::endl;
+}
+
+/** @brief Generates the five-point finite difference discretization of the Laplace operator on a m x m grid. All rows have about the same number of nonzeros. */
 template<typename ScalarType>
-int run_benchmark()
+void generate_laplace_2d_matrix(std::size_t m, boost::numeric::ublas::compressed_matrix<ScalarType> & ublas_matrix)
+{
+  std::size_t n = m * m;
+  ublas_matrix.resize(n, n, false);
+  ublas_matrix.reserve(5 * n);
+  for (std::size_t i=0; i<m; ++i)
+    for (std::size_t j=0; j<m; ++j)
+    {
+      std::size_t row = i * m + j;
+      if (i > 0)     ublas_matrix.push_back(row, row - m, ScalarType(-1));
+      if (j > 0)     ublas_matrix.push_back(row, row - 1, ScalarType(-1));
+
+      ublas_matrix.push_back(row, row, ScalarType(4));  // diagonal
+
+      if (j < m - 1) ublas_matrix.push_back(row, row + 1, ScalarType(-1));
+      if (i < m - 1) ublas_matrix.push_back(row, row + m, ScalarType(-1));
+    }
+}
+
+/** @brief Generates a square matrix with a power-law distribution of nonzeros per row, similar to the adjacency matrix of a scale-free graph.
+*
+* The number of nonzeros in a row is 1 + 3 * u^(-1/1.2) for u uniformly distributed in (0,1], hence a few rows have several thousand nonzeros while most rows have less than ten.
+*/
+template<typename ScalarType>
+void generate_power_law_matrix(std::size_t n, boost::numeric::ublas::compressed_matrix<ScalarType> & ublas_matrix)
+{
+  std::vector<std::map<unsigned int, ScalarType> > rows(n);
+  std::size_t nnz = 0;
+  srand(42);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    double u = (static_cast<double>(rand()) + 1.0) / (static_cast<double>(RAND_MAX) + 1.0);
+    std::size_t row_nnz = std::min<std::size_t>(1 + static_cast<std::size_t>(3.0 * std::pow(u, -1.0 / 1.2)), n / 20);
+
+    rows[i][static_cast<unsigned int>(i)] = ScalarType(1.0);
+    for (std::size_t k=1; k<row_nnz; ++k)
+      rows[i][static_cast<unsigned int>(rand() % n)] = ScalarType(1.0) / ScalarType(row_nnz);
+    nnz += rows[i].size();
+  }
+
+  ublas_matrix.resize(n, n, false);
+  ublas_matrix.reserve(nnz);
+  for (std::size_t i=0; i<n; ++i)
+    for (typename std::map<unsigned int, ScalarType>::const_iterator it = rows[i].begin(); it != rows[i].end(); ++it)
+      ublas_matrix.push_back(i, it->first, it->second);
+}
+
+
+template<typename ScalarType>
+int run_spmv_benchmark(boost::numeric::ublas::compressed_matrix<ScalarType> const & ublas_matrix,
+                       boost::numeric::ublas::vector<ScalarType> ublas_vec1,
+                       bool with_triangular_solves)
 {
    Timer timer;
    double exec_time;
@@ -67,16 +135,10 @@ int run_benchmark()
   viennacl::scalar<ScalarType> vcl_factor1(std_factor1);
   viennacl::scalar<ScalarType> vcl_factor2(std_factor2);
 
-  boost::numeric::ublas::vector<ScalarType> ublas_vec1;
-  boost::numeric::ublas::vector<ScalarType> ublas_vec2;
+  boost::numeric::ublas::vector<ScalarType> ublas_vec2 = ublas_vec1;
 
-  if (!readVectorFromFile<ScalarType>("../examples/testdata/result65025.txt", ublas_vec1))
-  {
-    std::cout << "Error reading RHS file" << std::endl;
-    return 0;
-  }
-  std::cout << "done reading rhs" << std::endl;
-  ublas_vec2 = ublas_vec1;
+  // minimum amount of data transferred: matrix entries, source and result vector
+  double vector_bytes = static_cast<double>(sizeof(ScalarType) * (ublas_matrix.size1() + ublas_matrix.size2()));
 
   viennacl::compressed_matrix<ScalarType, 1> vcl_compressed_matrix_1;
   viennacl::compressed_matrix<ScalarType, 4> vcl_compressed_matrix_4;
@@ -86,15 +148,7 @@ int run_benchmark()
 
   viennacl::ell_matrix<ScalarType, 1> vcl_ell_matrix_1;
   viennacl::hyb_matrix<ScalarType, 1> vcl_hyb_matrix_1;
-
-  boost::numeric::ublas::compressed_matrix<ScalarType> ublas_matrix;
-  if (!viennacl::io::read_matrix_market_file(ublas_matrix, "../examples/testdata/mat65k.mtx"))
-  {
-    std::cout << "Error reading Matrix file" << std::endl;
-    return 0;
-  }
-  //unsigned int cg_mat_size = cg_mat.size();
-  std::cout << "done reading matrix" << std::endl;
+  viennacl::sliced_ell_matrix<ScalarType> vcl_sliced_ell_matrix;
 
   viennacl::vector<ScalarType> vcl_vec1(ublas_vec1.size());
   viennacl::vector<ScalarType> vcl_vec2(ublas_vec1.size());
@@ -107,11 +161,28 @@ int run_benchmark()
   viennacl::copy(ublas_matrix, vcl_compressed_matrix_8);
   #endif
   viennacl::copy(ublas_matrix, vcl_coordinate_matrix_128);
-  viennacl::copy(ublas_matrix, vcl_ell_matrix_1);
   viennacl::copy(ublas_matrix, vcl_hyb_matrix_1);
+  viennacl::copy(ublas_matrix, vcl_sliced_ell_matrix);
   viennacl::copy(ublas_vec1, vcl_vec1);
   viennacl::copy(ublas_vec2, vcl_vec2);
 
+  // ELL format is only reasonable if the number of nonzeros per row does not vary too much (not the case for power-law matrices):
+  std::size_t max_row_nnz = 0;
+  for (std::size_t i=0; i<ublas_matrix.size1(); ++i)
+    max_row_nnz = std::max<std::size_t>(max_row_nnz, ublas_matrix.index1_data()[i+1] - ublas_matrix.index1_data()[i]);
+  bool use_ell = (max_row_nnz * ublas_matrix.size1() < 4 * ublas_matrix.nnz());
+  if (use_ell)
+    viennacl::copy(ublas_matrix, vcl_ell_matrix_1);
+
+  double index_size = static_cast<double>(sizeof(unsigned int));
+  double csr_bytes = static_cast<double>(ublas_matrix.nnz()) * (sizeof(ScalarType) + index_size) + static_cast<double>(ublas_matrix.size1() + 1) * index_size + vector_bytes;
+  double coo_bytes = static_cast<double>(ublas_matrix.nnz()) * (sizeof(ScalarType) + 2.0 * index_size) + vector_bytes;
+  double ell_bytes = static_cast<double>(vcl_ell_matrix_1.internal_nnz()) * (sizeof(ScalarType) + index_size) + vector_bytes;
+  double hyb_bytes = static_cast<double>(vcl_hyb_matrix_1.internal_size1() * vcl_hyb_matrix_1.internal_ellnnz() + vcl_hyb_matrix_1.csr_nnz()) * (sizeof(ScalarType) + index_size)
+                   + static_cast<double>(ublas_matrix.size1() + 1) * index_size + vector_bytes;
+  double sliced_ell_bytes = static_cast<double>(vcl_sliced_ell_matrix.internal_nnz()) * (sizeof(ScalarType) + index_size)
+                          + static_cast<double>(vcl_sliced_ell_matrix.num_chunks() + 1 + ublas_matrix.size1()) * index_size + vector_bytes;
+
 
   ///////////// Matrix operations /////////////////
 
@@ -124,7 +195,7 @@ int run_benchmark()
   }
   exec_time = timer.get();
   std::cout << "CPU time: " << exec_time << std::endl;
-  std::cout << "CPU "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz()), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+  std::cout << "CPU "; printSpMVStats(static_cast<double>(ublas_matrix.nnz()), csr_bytes, static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
   std::cout << ublas_vec1[0] << std::endl;
 
 
@@ -145,24 +216,27 @@ int run_benchmark()
   viennacl::backend::finish();
   exec_time = timer.get();
   std::cout << "GPU time align1: " << exec_time << std::endl;
-  std::cout << "GPU align1 "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz()), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+  std::cout << "GPU align1 "; printSpMVStats(static_cast<double>(ublas_matrix.nnz()), csr_bytes, static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
   std::cout << vcl_vec1[0] << std::endl;
 
-  std::cout << "Testing triangular solves: compressed_matrix" << std::endl;
-
-  viennacl::copy(ublas_vec1, vcl_vec1);
-  viennacl::linalg::inplace_solve(trans(vcl_compressed_matrix_1), vcl_vec1, viennacl::linalg::unit_lower_tag());
-  viennacl::copy(ublas_vec1, vcl_vec1);
-  std::cout << "ublas..." << std::endl;
-  timer.start();
-  boost::numeric::ublas::inplace_solve(trans(ublas_matrix), ublas_vec1, boost::numeric::ublas::unit_lower_tag());
-  std::cout << "Time elapsed: " << timer.get() << std::endl;
-  std::cout << "ViennaCL..." << std::endl;
-  viennacl::backend::finish();
-  timer.start();
-  viennacl::linalg::inplace_solve(trans(vcl_compressed_matrix_1), vcl_vec1, viennacl::linalg::unit_lower_tag());
-  viennacl::backend::finish();
-  std::cout << "Time elapsed: " << timer.get() << std::endl;
+  if (with_triangular_solves)
+  {
+    std::cout << "Testing triangular solves: compressed_matrix" << std::endl;
+
+    viennacl::copy(ublas_vec1, vcl_vec1);
+    viennacl::linalg::inplace_solve(trans(vcl_compressed_matrix_1), vcl_vec1, viennacl::linalg::unit_lower_tag());
+    viennacl::copy(ublas_vec1, vcl_vec1);
+    std::cout << "ublas..." << std::endl;
+    timer.start();
+    boost::numeric::ublas::inplace_solve(trans(ublas_matrix), ublas_vec1, boost::numeric::ublas::unit_lower_tag());
+    std::cout << "Time elapsed: " << timer.get() << std::endl;
+    std::cout << "ViennaCL..." << std::endl;
+    viennacl::backend::finish();
+    timer.start();
+    viennacl::linalg::inplace_solve(trans(vcl_compressed_matrix_1), vcl_vec1, viennacl::linalg::unit_lower_tag());
+    viennacl::backend::finish();
+    std::cout << "Time elapsed: " << timer.get() << std::endl;
+  }
 
   ublas_vec1 = boost::numeric::ublas::prod(ublas_matrix, ublas_vec2);
 
@@ -175,7 +249,7 @@ int run_benchmark()
   viennacl::backend::finish();
   exec_time = timer.get();
   std::cout << "GPU time align4: " << exec_time << std::endl;
-  std::cout << "GPU align4 "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz()), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+  std::cout << "GPU align4 "; printSpMVStats(static_cast<double>(ublas_matrix.nnz()), csr_bytes, static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
   std::cout << vcl_vec1[0] << std::endl;
 
   viennacl::backend::finish();
@@ -187,7 +261,7 @@ int run_benchmark()
   viennacl::backend::finish();
   exec_time = timer.get();
   std::cout << "GPU time align8: " << exec_time << std::endl;
-  std::cout << "GPU align8 "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz()), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+  std::cout << "GPU align8 "; printSpMVStats(static_cast<double>(ublas_matrix.nnz()), csr_bytes, static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
   std::cout << vcl_vec1[0] << std::endl;
 
 
@@ -217,12 +291,45 @@ int run_benchmark()
   viennacl::backend::finish();
   exec_time = timer.get();
   std::cout << "GPU time: " << exec_time << std::endl;
-  std::cout << "GPU "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz()), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+  std::cout << "GPU "; printSpMVStats(static_cast<double>(ublas_matrix.nnz()), coo_bytes, static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
   std::cout << vcl_vec1[0] << std::endl;
 
 
-  std::cout << "------- Matrix-Vector product with ell_matrix ----------" << std::endl;
-  vcl_vec1 = viennacl::linalg::prod(vcl_ell_matrix_1, vcl_vec2); //startup calculation
+  if (use_ell)
+  {
+    std::cout << "------- Matrix-Vector product with ell_matrix ----------" << std::endl;
+    vcl_vec1 = viennacl::linalg::prod(vcl_ell_matrix_1, vcl_vec2); //startup calculation
+    viennacl::backend::finish();
+
+    viennacl::copy(vcl_vec1, ublas_vec2);
+    err_cnt = 0;
+    for (std::size_t i=0; i<ublas_vec1.size(); ++i)
+    {
+      if ( fabs(ublas_vec1[i] - ublas_vec2[i]) / std::max(fabs(ublas_vec1[i]), fabs(ublas_vec2[i])) > 1e-2)
+      {
+        std::cout << "Error at index " << i << ": Should: " << ublas_vec1[i] << ", Is: " << ublas_vec2[i] << std::endl;
+        ++err_cnt;
+        if (err_cnt > 5)
+          break;
+      }
+    }
+
+    viennacl::backend::finish();
+    timer.start();
+    for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+    {
+      vcl_vec1 = viennacl::linalg::prod(vcl_ell_matrix_1, vcl_vec2);
+    }
+    viennacl::backend::finish();
+    exec_time = timer.get();
+    std::cout << "GPU time: " << exec_time << std::endl;
+    std::cout << "GPU "; printSpMVStats(static_cast<double>(ublas_matrix.nnz()), ell_bytes, static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+    std::cout << vcl_vec1[0] << std::endl;
+  }
+
+
+  std::cout << "------- Matrix-Vector product with hyb_matrix ----------" << std::endl;
+  vcl_vec1 = viennacl::linalg::prod(vcl_hyb_matrix_1, vcl_vec2); //startup calculation
   viennacl::backend::finish();
 
   viennacl::copy(vcl_vec1, ublas_vec2);
@@ -242,17 +349,17 @@ int run_benchmark()
   timer.start();
   for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
   {
-    vcl_vec1 = viennacl::linalg::prod(vcl_ell_matrix_1, vcl_vec2);
+    vcl_vec1 = viennacl::linalg::prod(vcl_hyb_matrix_1, vcl_vec2);
   }
   viennacl::backend::finish();
   exec_time = timer.get();
   std::cout << "GPU time: " << exec_time << std::endl;
-  std::cout << "GPU "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz()), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+  std::cout << "GPU "; printSpMVStats(static_cast<double>(ublas_matrix.nnz()), hyb_bytes, static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
   std::cout << vcl_vec1[0] << std::endl;
 
 
-  std::cout << "------- Matrix-Vector product with hyb_matrix ----------" << std::endl;
-  vcl_vec1 = viennacl::linalg::prod(vcl_hyb_matrix_1, vcl_vec2); //startup calculation
+  std::cout << "------- Matrix-Vector product with sliced_ell_matrix ----------" << std::endl;
+  vcl_vec1 = viennacl::linalg::prod(vcl_sliced_ell_matrix, vcl_vec2); //startup calculation
   viennacl::backend::finish();
 
   viennacl::copy(vcl_vec1, ublas_vec2);
@@ -272,12 +379,12 @@ int run_benchmark()
   timer.start();
   for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
   {
-    vcl_vec1 = viennacl::linalg::prod(vcl_hyb_matrix_1, vcl_vec2);
+    vcl_vec1 = viennacl::linalg::prod(vcl_sliced_ell_matrix, vcl_vec2);
   }
   viennacl::backend::finish();
   exec_time = timer.get();
   std::cout << "GPU time: " << exec_time << std::endl;
-  std::cout << "GPU "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz()), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+  std::cout << "GPU "; printSpMVStats(static_cast<double>(ublas_matrix.nnz()), sliced_ell_bytes, static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
   std::cout << vcl_vec1[0] << std::endl;
 
 
@@ -285,6 +392,47 @@ int run_benchmark()
 }
 
 
+template<typename ScalarType>
+int run_benchmark()
+{
+  boost::numeric::ublas::vector<ScalarType> ublas_vec1;
+  boost::numeric::ublas::compressed_matrix<ScalarType> ublas_matrix;
+
+  if (!readVectorFromFile<ScalarType>("../examples/testdata/result65025.txt", ublas_vec1))
+    std::cout << "Error reading RHS file" << std::endl;
+  else if (!viennacl::io::read_matrix_market_file(ublas_matrix, "../examples/testdata/mat65k.mtx") || ublas_matrix.nnz() == 0)
+    std::cout << "Error reading Matrix file" << std::endl;
+  else
+  {
+    std::cout << "done reading rhs and matrix" << std::endl;
+    std::cout << std::endl << "   ### Matrix mat65k.mtx (" << ublas_matrix.size1() << " rows, " << ublas_matrix.nnz() << " nonzeros) ###" << std::endl;
+    run_spmv_benchmark(ublas_matrix, ublas_vec1, true);
+  }
+
+  std::size_t m = 1000;
+  boost::numeric::ublas::compressed_matrix<ScalarType> ublas_laplace_matrix;
+  generate_laplace_2d_matrix(m, ublas_laplace_matrix);
+  boost::numeric::ublas::vector<ScalarType> ublas_laplace_vec(m * m);
+  for (std::size_t i=0; i<m * m; ++i)
+    ublas_laplace_vec[i] = ScalarType(1.0) + ScalarType(i % 7);
+
+  std::cout << std::endl << "   ### 2D Laplace matrix (" << m * m << " rows, " << ublas_laplace_matrix.nnz() << " nonzeros) ###" << std::endl;
+  run_spmv_benchmark(ublas_laplace_matrix, ublas_laplace_vec, false);
+
+  std::size_t n = 500000;
+  boost::numeric::ublas::compressed_matrix<ScalarType> ublas_power_law_matrix;
+  generate_power_law_matrix(n, ublas_power_law_matrix);
+  boost::numeric::ublas::vector<ScalarType> ublas_power_law_vec(n);
+  for (std::size_t i=0; i<n; ++i)
+    ublas_power_law_vec[i] = ScalarType(1.0) + ScalarType(i % 7);
+
+  std::cout << std::endl << "   ### Power-law matrix (" << n << " rows, " << ublas_power_law_matrix.nnz() << " nonzeros) ###" << std::endl;
+  run_spmv_benchmark(ublas_power_law_matrix, ublas_power_law_vec, false);
+
+  return EXIT_SUCCESS;
+}
+
+
 int main()
 {
   std::cout << std::endl;
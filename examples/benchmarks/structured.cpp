@@ -0,0 +1,224 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/*
+*
+*   Benchmark:   Products of structured matrices (circulant, Toeplitz, Hankel, Vandermonde) with vectors and dense matrices
+*
+*/
+
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/circulant_matrix.hpp"
+#include "viennacl/toeplitz_matrix.hpp"
+#include "viennacl/hankel_matrix.hpp"
+#include "viennacl/vandermonde_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "benchmark-utils.hpp"
+
+
+#define BENCHMARK_MIN_TIME          0.5      //repeat each product for at least this number of seconds
+#define BENCHMARK_QUADRATIC_MAX_SIZE  10000  //dense and Vandermonde products are O(n^2) in time (and dense matrices in memory)
+#define BENCHMARK_BATCH_SIZE          8
+
+
+// Returns the average execution time of result = prod(A, x)
+template <typename MatrixType, typename VectorType>
+double time_prod(MatrixType const & A, VectorType const & x, VectorType & result)
+{
+  Timer timer;
+  double exec_time = 0;
+  std::size_t runs = 0;
+
+  result = viennacl::linalg::prod(A, x); //startup calculation
+  viennacl::backend::finish();
+
+  timer.start();
+  do
+  {
+    result = viennacl::linalg::prod(A, x);
+    viennacl::backend::finish();
+    exec_time = timer.get();
+    ++runs;
+  } while (exec_time < BENCHMARK_MIN_TIME);
+
+  return exec_time / static_cast<double>(runs);
+}
+
+// Returns the average execution time of BENCHMARK_BATCH_SIZE products result = prod(A, x)
+template <typename MatrixType, typename VectorType>
+double time_prod_single(MatrixType const & A, VectorType const & x, VectorType & result)
+{
+  Timer timer;
+  double exec_time = 0;
+  std::size_t runs = 0;
+
+  timer.start();
+  do
+  {
+    for (std::size_t i=0; i<BENCHMARK_BATCH_SIZE; ++i)
+      result = viennacl::linalg::prod(A, x);
+    viennacl::backend::finish();
+    exec_time = timer.get();
+    ++runs;
+  } while (exec_time < BENCHMARK_MIN_TIME);
+
+  return exec_time / static_cast<double>(runs);
+}
+
+// Fills a dense matrix with the entries t[j - i + n - 1] of a Toeplitz matrix
+template <typename ScalarType>
+void fill_dense_toeplitz(std::vector<ScalarType> const & t, viennacl::matrix<ScalarType> & A)
+{
+  std::size_t n = A.size1();
+  std::vector<ScalarType> buffer(A.internal_size());
+  for (std::size_t i=0; i<n; ++i)
+    for (std::size_t j=0; j<n; ++j)
+      buffer[i * A.internal_size2() + j] = t[j + n - 1 - i];
+  viennacl::fast_copy(&(buffer[0]), &(buffer[0]) + buffer.size(), A);
+}
+
+template<typename ScalarType>
+int run_benchmark()
+{
+  std::size_t sizes[] = { 1000, 10000, 100000, 1000000 };
+
+  std::cout << "------- Matrix-vector products (time in seconds) ----------" << std::endl;
+  std::cout << std::setw(10) << "n"
+            << std::setw(14) << "circulant"
+            << std::setw(14) << "toeplitz"
+            << std::setw(14) << "hankel"
+            << std::setw(14) << "vandermonde"
+            << std::setw(14) << "dense" << std::endl;
+
+  for (std::size_t k=0; k<sizeof(sizes) / sizeof(std::size_t); ++k)
+  {
+    std::size_t n = sizes[k];
+
+    std::vector<ScalarType> std_circ(n);
+    std::vector<ScalarType> std_toep(2 * n - 1);
+    std::vector<ScalarType> std_nodes(n);
+    std::vector<ScalarType> std_x(n);
+    for (std::size_t i=0; i<n; ++i)
+    {
+      std_circ[i]  = ScalarType(1) / ScalarType(i + 1);
+      std_nodes[i] = ScalarType(1) - ScalarType(i) / ScalarType(2 * n);
+      std_x[i]     = ScalarType(i % 7) - ScalarType(3);
+    }
+    for (std::size_t i=0; i<std_toep.size(); ++i)
+      std_toep[i] = ScalarType(1) / ScalarType(1 + (i > n - 1 ? i - n + 1 : n - 1 - i));
+
+    viennacl::circulant_matrix<ScalarType>   vcl_circ(n, n);
+    viennacl::toeplitz_matrix<ScalarType>    vcl_toep(n, n);
+    viennacl::hankel_matrix<ScalarType>      vcl_hank(n, n);
+    viennacl::vandermonde_matrix<ScalarType> vcl_vand(n, n);
+    viennacl::vector<ScalarType> vcl_x(n);
+    viennacl::vector<ScalarType> vcl_result(n);
+
+    viennacl::copy(std_circ, vcl_circ);
+    viennacl::copy(std_toep, vcl_toep);
+    viennacl::copy(std_toep, vcl_hank);
+    viennacl::copy(std_nodes, vcl_vand);
+    viennacl::copy(std_x, vcl_x);
+
+    std::cout << std::setw(10) << n;
+    std::cout << std::setw(14) << time_prod(vcl_circ, vcl_x, vcl_result) << std::flush;
+    std::cout << std::setw(14) << time_prod(vcl_toep, vcl_x, vcl_result) << std::flush;
+    std::cout << std::setw(14) << time_prod(vcl_hank, vcl_x, vcl_result) << std::flush;
+    if (n <= BENCHMARK_QUADRATIC_MAX_SIZE)
+    {
+      std::cout << std::setw(14) << time_prod(vcl_vand, vcl_x, vcl_result) << std::flush;
+
+      viennacl::matrix<ScalarType> vcl_dense(n, n);
+      fill_dense_toeplitz(std_toep, vcl_dense);
+      std::cout << std::setw(14) << time_prod(vcl_dense, vcl_x, vcl_result);
+    }
+    else
+      std::cout << std::setw(14) << "-" << std::setw(14) << "-";
+    std::cout << std::endl;
+  }
+
+
+  std::cout << "------- Toeplitz matrix times " << BENCHMARK_BATCH_SIZE << " vectors (time in seconds) ----------" << std::endl;
+  std::cout << std::setw(10) << "n"
+            << std::setw(14) << "single"
+            << std::setw(14) << "batched"
+            << std::setw(14) << "dense" << std::endl;
+
+  for (std::size_t k=0; k<sizeof(sizes) / sizeof(std::size_t); ++k)
+  {
+    std::size_t n = sizes[k];
+
+    std::vector<ScalarType> std_toep(2 * n - 1);
+    for (std::size_t i=0; i<std_toep.size(); ++i)
+      std_toep[i] = ScalarType(1) / ScalarType(1 + (i > n - 1 ? i - n + 1 : n - 1 - i));
+
+    viennacl::toeplitz_matrix<ScalarType> vcl_toep(n, n);
+    viennacl::copy(std_toep, vcl_toep);
+
+    viennacl::vector<ScalarType> vcl_x = viennacl::scalar_vector<ScalarType>(n, ScalarType(1));
+    viennacl::vector<ScalarType> vcl_result(n);
+    viennacl::matrix<ScalarType> vcl_X = viennacl::scalar_matrix<ScalarType>(n, BENCHMARK_BATCH_SIZE, ScalarType(1));
+    viennacl::matrix<ScalarType> vcl_Result(n, BENCHMARK_BATCH_SIZE);
+
+    std::cout << std::setw(10) << n;
+    std::cout << std::setw(14) << time_prod_single(vcl_toep, vcl_x, vcl_result) << std::flush;
+    std::cout << std::setw(14) << time_prod(vcl_toep, vcl_X, vcl_Result) << std::flush;
+    if (n <= BENCHMARK_QUADRATIC_MAX_SIZE)
+    {
+      viennacl::matrix<ScalarType> vcl_dense(n, n);
+      fill_dense_toeplitz(std_toep, vcl_dense);
+      std::cout << std::setw(14) << time_prod(vcl_dense, vcl_X, vcl_Result);
+    }
+    else
+      std::cout << std::setw(14) << "-";
+    std::cout << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Benchmark :: Structured Matrices" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  std::cout << "   # benchmarking single-precision" << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  run_benchmark<float>();
+  {
+    std::cout << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    std::cout << "   # benchmarking double-precision" << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    run_benchmark<double>();
+  }
+  return 0;
+}
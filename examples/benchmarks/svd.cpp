@@ -0,0 +1,208 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/*
+*
+*   Benchmark:   Singular value decomposition
+*
+*/
+
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+#include <boost/numeric/ublas/matrix.hpp>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/svd.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "benchmark-utils.hpp"
+
+
+/** @brief Reads a test matrix and its singular values from one of the files in examples/testdata/svd/ */
+template <typename ScalarType>
+bool read_svd_example(std::string const & filename,
+                      boost::numeric::ublas::matrix<ScalarType> & A,
+                      std::vector<ScalarType> & sigma)
+{
+  std::ifstream f(filename.c_str());
+  if (!f.is_open())
+    return false;
+
+  std::size_t sz1, sz2;
+  f >> sz1 >> sz2;
+
+  A.resize(sz1, sz2, false);
+  for (std::size_t i = 0; i < sz1; ++i)
+    for (std::size_t j = 0; j < sz2; ++j)
+      f >> A(i, j);
+
+  sigma.resize(std::min(sz1, sz2));
+  for (std::size_t i = 0; i < sigma.size(); ++i)
+    f >> sigma[i];
+
+  return true;
+}
+
+
+/** @brief Runs the SVD on A and prints the execution time, the relative error of the singular values (if available), and the relative error of QL * Sigma * QR^T */
+template <typename ScalarType, typename F>
+void run_svd(std::string const & name, boost::numeric::ublas::matrix<ScalarType> const & ublas_A, std::vector<ScalarType> sigma_ref)
+{
+  std::size_t sz1 = ublas_A.size1();
+  std::size_t sz2 = ublas_A.size2();
+
+  viennacl::matrix<ScalarType, F> A(sz1, sz2), QL(sz1, sz1), QR(sz2, sz2);
+  viennacl::copy(ublas_A, A);
+
+  viennacl::backend::finish();
+  Timer timer;
+  timer.start();
+  viennacl::linalg::svd(A, QL, QR);
+  viennacl::backend::finish();
+  double exec_time = timer.get();
+
+  // relative error of the singular values:
+  boost::numeric::ublas::matrix<ScalarType> ublas_Sigma(sz1, sz2);
+  viennacl::copy(A, ublas_Sigma);
+
+  double sigma_diff = 0;
+  if (sigma_ref.size() > 0)
+  {
+    std::vector<ScalarType> sigma(sigma_ref.size());
+    for (std::size_t i = 0; i < sigma.size(); ++i)
+      sigma[i] = ublas_Sigma(i, i);
+
+    std::sort(sigma.begin(), sigma.end());
+    std::sort(sigma_ref.begin(), sigma_ref.end());
+
+    double sigma_max = 0;
+    for (std::size_t i = 0; i < sigma.size(); ++i)
+    {
+      sigma_diff = std::max(sigma_diff, static_cast<double>(std::fabs(sigma[i] - sigma_ref[i])));
+      sigma_max  = std::max(sigma_max,  static_cast<double>(std::fabs(sigma_ref[i])));
+    }
+    sigma_diff /= sigma_max;
+  }
+
+  // relative error of the reconstruction:
+  viennacl::matrix<ScalarType, F> temp(sz1, sz2), result(sz1, sz2);
+  temp   = viennacl::linalg::prod(QL, A);
+  result = viennacl::linalg::prod(temp, trans(QR));
+
+  boost::numeric::ublas::matrix<ScalarType> ublas_result(sz1, sz2);
+  viennacl::copy(result, ublas_result);
+
+  double prod_diff = 0;
+  double A_max = 0;
+  for (std::size_t i = 0; i < sz1; ++i)
+    for (std::size_t j = 0; j < sz2; ++j)
+    {
+      prod_diff = std::max(prod_diff, static_cast<double>(std::fabs(ublas_result(i, j) - ublas_A(i, j))));
+      A_max     = std::max(A_max,     static_cast<double>(std::fabs(ublas_A(i, j))));
+    }
+  prod_diff /= A_max;
+
+  std::cout << std::setw(20) << name
+            << std::setw(7) << sz1 << " x" << std::setw(5) << sz2
+            << std::setw(14) << exec_time;
+  if (sigma_ref.size() > 0)
+    std::cout << std::setw(14) << sigma_diff;
+  else
+    std::cout << std::setw(14) << "-";
+  std::cout << std::setw(14) << prod_diff << std::endl;
+}
+
+
+template <typename ScalarType, typename F>
+int run_benchmark()
+{
+  std::cout << std::setw(20) << "matrix" << std::setw(14) << "size"
+            << std::setw(14) << "time (sec)" << std::setw(14) << "sigma error" << std::setw(14) << "prod error" << std::endl;
+
+  // matrices with known singular values:
+  char const * examples[] = { "qr", "wiki", "wiki.qr", "pysvd", "random" };
+  for (std::size_t i = 0; i < sizeof(examples) / sizeof(examples[0]); ++i)
+  {
+    boost::numeric::ublas::matrix<ScalarType> A;
+    std::vector<ScalarType> sigma;
+    if (!read_svd_example(std::string("../examples/testdata/svd/") + examples[i] + ".example", A, sigma))
+    {
+      std::cout << "Error reading file ../examples/testdata/svd/" << examples[i] << ".example" << std::endl;
+      return EXIT_FAILURE;
+    }
+    run_svd<ScalarType, F>(examples[i], A, sigma);
+  }
+
+  // random matrices of the sizes used in tests/src/svd.cpp:
+  std::size_t sizes[][2] = { {500, 500}, {1000, 1000}, {4096, 512}, {512, 4096}, {2048, 2048} };
+  for (std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+  {
+    boost::numeric::ublas::matrix<ScalarType> A(sizes[i][0], sizes[i][1]);
+    for (std::size_t r = 0; r < A.size1(); ++r)
+      for (std::size_t c = 0; c < A.size2(); ++c)
+        A(r, c) = static_cast<ScalarType>(rand()) / static_cast<ScalarType>(RAND_MAX);
+    run_svd<ScalarType, F>("random", A, std::vector<ScalarType>());
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Benchmark :: Singular Value Decomposition" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  std::cout << "   # benchmarking single-precision" << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  if (run_benchmark<float, viennacl::row_major>() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+#ifdef VIENNACL_WITH_OPENCL
+  if( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    std::cout << "   # benchmarking double-precision" << std::endl;
+    std::cout << "   -------------------------------" << std::endl;
+    if (run_benchmark<double, viennacl::row_major>() != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+#ifndef VIENNACL_WITH_OPENCL
+    std::cout << std::endl;
+    std::cout << "   -------------------------------------------" << std::endl;
+    std::cout << "   # benchmarking double-precision, column-major" << std::endl;
+    std::cout << "   -------------------------------------------" << std::endl;
+    if (run_benchmark<double, viennacl::column_major>() != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+#endif
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,245 @@
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+//
+// *** System
+//
+#include <iostream>
+#include <string>
+
+//
+// *** Boost
+//
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+
+// Must be set if you want to use ViennaCL algorithms on ublas objects
+#define VIENNACL_WITH_UBLAS 1
+
+//
+// *** ViennaCL
+//
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/amg.hpp"
+
+
+using namespace boost::numeric;
+
+
+/** @brief Assembles the 5-point finite difference Laplacian on an m-by-m grid */
+template <typename NumericT>
+void fill_laplace_2d(ublas::compressed_matrix<NumericT> & A, std::size_t m)
+{
+  A.resize(m * m, m * m, false);
+  for (std::size_t i = 0; i < m; ++i)
+  {
+    for (std::size_t j = 0; j < m; ++j)
+    {
+      std::size_t row = i * m + j;
+
+      if (i > 0)
+        A.push_back(row, row - m, NumericT(-1));
+      if (j > 0)
+        A.push_back(row, row - 1, NumericT(-1));
+
+      A.push_back(row, row, NumericT(4));
+
+      if (j < m - 1)
+        A.push_back(row, row + 1, NumericT(-1));
+      if (i < m - 1)
+        A.push_back(row, row + m, NumericT(-1));
+    }
+  }
+}
+
+
+/** @brief Solves A x = b with AMG-preconditioned CG and checks the true residual as well as the number of iterations */
+template <typename NumericT>
+int test_amg(viennacl::compressed_matrix<NumericT> const & A,
+             viennacl::vector<NumericT> const & b,
+             viennacl::linalg::amg_tag const & amg_config,
+             std::string const & name,
+             NumericT tolerance,
+             std::size_t max_iterations)
+{
+  viennacl::linalg::amg_tag amg_tag(amg_config);
+  viennacl::linalg::amg_precond<viennacl::compressed_matrix<NumericT> > amg_precond(A, amg_tag);
+  amg_precond.setup();
+
+  viennacl::linalg::cg_tag solver_tag(tolerance, 300);
+  viennacl::vector<NumericT> x = viennacl::linalg::solve(A, b, solver_tag, amg_precond);
+
+  viennacl::vector<NumericT> residual = b;
+  residual -= viennacl::linalg::prod(A, x);
+  NumericT rel_residual = viennacl::linalg::norm_2(residual) / viennacl::linalg::norm_2(b);
+
+  std::cout << "  " << name << ": " << solver_tag.iters() << " iterations, relative residual " << rel_residual << std::endl;
+
+  if (rel_residual > 100 * tolerance)
+  {
+    std::cout << "# Error at operation: AMG " << name << " (residual too large)" << std::endl;
+    std::cout << "  rel. residual: " << rel_residual << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (solver_tag.iters() > max_iterations)
+  {
+    std::cout << "# Error at operation: AMG " << name << " (too many iterations)" << std::endl;
+    std::cout << "  iterations: " << solver_tag.iters() << " (expected at most " << max_iterations << ")" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+template <typename NumericT>
+int test(NumericT tolerance)
+{
+  std::size_t m = 40;
+
+  ublas::compressed_matrix<NumericT> ublas_A;
+  fill_laplace_2d(ublas_A, m);
+
+  viennacl::compressed_matrix<NumericT> A(m * m, m * m);
+  viennacl::copy(ublas_A, A);
+
+  viennacl::vector<NumericT> b = viennacl::scalar_vector<NumericT>(m * m, NumericT(1));
+
+  //
+  // Reference: Unpreconditioned CG needs about 75 iterations for this system
+  //
+  std::cout << "Testing classical coarsening..." << std::endl;
+  unsigned int coarse[] = { VIENNACL_AMG_COARSE_RS, VIENNACL_AMG_COARSE_ONEPASS, VIENNACL_AMG_COARSE_RS0, VIENNACL_AMG_COARSE_RS3 };
+  std::string  coarse_name[] = { "RS", "ONEPASS", "RS0", "RS3" };
+  unsigned int interpol[] = { VIENNACL_AMG_INTERPOL_DIRECT, VIENNACL_AMG_INTERPOL_CLASSIC };
+  std::string  interpol_name[] = { "DIRECT", "CLASSIC" };
+
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    for (std::size_t j = 0; j < 2; ++j)
+    {
+      viennacl::linalg::amg_tag amg_config(coarse[i], interpol[j], 0.25, 0.2);
+      if (test_amg(A, b, amg_config, coarse_name[i] + "+" + interpol_name[j], tolerance, 40) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Testing aggregation..." << std::endl;
+  {
+    viennacl::linalg::amg_tag amg_config(VIENNACL_AMG_COARSE_AG, VIENNACL_AMG_INTERPOL_AG, 0.08, 0);
+    if (test_amg(A, b, amg_config, "AG+AG", tolerance, 70) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+  {
+    viennacl::linalg::amg_tag amg_config(VIENNACL_AMG_COARSE_AG, VIENNACL_AMG_INTERPOL_SA, 0.08, 0.67);
+    if (test_amg(A, b, amg_config, "AG+SA", tolerance, 70) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  //
+  // The stronger smoothers must beat damped Jacobi by a wide margin, for both V- and W-cycles
+  //
+  std::cout << "Testing smoothers and cycles..." << std::endl;
+  unsigned int smoother[] = { VIENNACL_AMG_SMOOTHER_JACOBI, VIENNACL_AMG_SMOOTHER_L1_JACOBI, VIENNACL_AMG_SMOOTHER_GAUSS_SEIDEL, VIENNACL_AMG_SMOOTHER_CHEBYSHEV };
+  std::string  smoother_name[] = { "Jacobi", "l1-Jacobi", "Gauss-Seidel", "Chebyshev" };
+  std::size_t  smoother_max_iterations[] = { 40, 15, 15, 15 };
+  unsigned int cycle[] = { VIENNACL_AMG_CYCLE_V, VIENNACL_AMG_CYCLE_W };
+  std::string  cycle_name[] = { "V", "W" };
+
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    for (std::size_t j = 0; j < 2; ++j)
+    {
+      viennacl::linalg::amg_tag classic_config(VIENNACL_AMG_COARSE_RS, VIENNACL_AMG_INTERPOL_CLASSIC, 0.25, 0.2);
+      classic_config.set_smoother(smoother[i]);
+      classic_config.set_cycle(cycle[j]);
+      if (test_amg(A, b, classic_config, "RS+CLASSIC, " + smoother_name[i] + ", " + cycle_name[j] + "-cycle", tolerance, smoother_max_iterations[i]) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+      viennacl::linalg::amg_tag sa_config(VIENNACL_AMG_COARSE_AG, VIENNACL_AMG_INTERPOL_SA, 0.08, 0.67);
+      sa_config.set_smoother(smoother[i]);
+      sa_config.set_cycle(cycle[j]);
+      if (test_amg(A, b, sa_config, "AG+SA, " + smoother_name[i] + ", " + cycle_name[j] + "-cycle", tolerance, (i == 0) ? 70 : 20) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Algebraic Multigrid" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  {
+    typedef float NumericT;
+    NumericT tolerance = static_cast<NumericT>(1E-5);
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  tolerance: " << tolerance << std::endl;
+    std::cout << "  numeric: float" << std::endl;
+    retval = test<NumericT>(tolerance);
+    if( retval == EXIT_SUCCESS )
+      std::cout << "# Test passed" << std::endl;
+    else
+      return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    typedef double NumericT;
+    NumericT tolerance = 1.0E-8;
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  tolerance: " << tolerance << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    retval = test<NumericT>(tolerance);
+    if( retval == EXIT_SUCCESS )
+      std::cout << "# Test passed" << std::endl;
+    else
+      return retval;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
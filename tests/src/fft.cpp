@@ -22,14 +22,18 @@
 #include <complex>
 #include <fstream>
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 
 //#define VIENNACL_BUILD_INFO
 
+#include "viennacl/matrix.hpp"
 #include "viennacl/fft.hpp"
 
 typedef float ScalarType;
 
 const ScalarType EPS = 0.06;  //use smaller values in double precision
+const ScalarType REF_EPS = 1e-4;  //tolerance for the comparison with the reference DFT computed in double precision
 
 typedef ScalarType (*test_function_ptr)(std::vector<ScalarType>&,
                                         std::vector<ScalarType>&,
@@ -145,6 +149,73 @@ void convolve_ref(std::vector<ScalarType>& in1,
     }
 }
 
+/** @brief Reference DFT of batch_num complex vectors of the given size, stored one after another with interleaved real and imaginary parts */
+void dft_ref(std::vector<ScalarType> const & in,
+             std::vector<ScalarType> & out,
+             unsigned int size,
+             unsigned int batch_num)
+{
+    const double pi = 3.14159265358979323846;
+    out.resize(in.size());
+
+    for(unsigned int b = 0; b < batch_num; b++) {
+        for(unsigned int n = 0; n < size; n++) {
+            std::complex<double> el;
+            for(unsigned int k = 0; k < size; k++) {
+                double phase = -2.0 * pi * static_cast<double>((static_cast<unsigned long>(n) * k) % size) / size;
+                el += std::complex<double>(in[2*(b*size + k)], in[2*(b*size + k) + 1]) * std::complex<double>(cos(phase), sin(phase));
+            }
+            out[2*(b*size + n)]     = static_cast<ScalarType>(el.real());
+            out[2*(b*size + n) + 1] = static_cast<ScalarType>(el.imag());
+        }
+    }
+}
+
+/** @brief Reference 2D DFT of a row-major matrix of complex numbers: transforms the rows, then the columns */
+void dft_2d_ref(std::vector<ScalarType> const & in,
+                std::vector<ScalarType> & out,
+                unsigned int rows,
+                unsigned int cols)
+{
+    std::vector<ScalarType> tmp;
+    dft_ref(in, tmp, cols, rows);
+
+    std::vector<ScalarType> column(2 * rows);
+    std::vector<ScalarType> column_result;
+    out.resize(in.size());
+    for(unsigned int j = 0; j < cols; j++) {
+        for(unsigned int i = 0; i < rows; i++) {
+            column[2*i]     = tmp[2*(i*cols + j)];
+            column[2*i + 1] = tmp[2*(i*cols + j) + 1];
+        }
+        dft_ref(column, column_result, rows, 1);
+        for(unsigned int i = 0; i < rows; i++) {
+            out[2*(i*cols + j)]     = column_result[2*i];
+            out[2*(i*cols + j) + 1] = column_result[2*i + 1];
+        }
+    }
+}
+
+/** @brief Copies a row-major matrix of complex numbers (interleaved real and imaginary parts) to a ViennaCL matrix with padding */
+void copy_matrix(std::vector<ScalarType> const & in, viennacl::matrix<ScalarType> & out)
+{
+    std::vector<std::vector<ScalarType> > tmp(out.size1(), std::vector<ScalarType>(out.size2()));
+    for(std::size_t i = 0; i < out.size1(); i++)
+        for(std::size_t j = 0; j < out.size2(); j++)
+            tmp[i][j] = in[i * out.size2() + j];
+    viennacl::copy(tmp, out);
+}
+
+/** @brief Copies a ViennaCL matrix of complex numbers back to a contiguous row-major array */
+void copy_matrix(viennacl::matrix<ScalarType> const & in, std::vector<ScalarType> & out)
+{
+    std::vector<std::vector<ScalarType> > tmp(in.size1(), std::vector<ScalarType>(in.size2()));
+    viennacl::copy(in, tmp);
+    for(std::size_t i = 0; i < in.size1(); i++)
+        for(std::size_t j = 0; j < in.size2(); j++)
+            out[i * in.size2() + j] = tmp[i][j];
+}
+
 ScalarType opencl_fft(std::vector<ScalarType>& in,
                       std::vector<ScalarType>& out,
                       unsigned int /*row*/, unsigned int /*col*/, unsigned int batch_size)
@@ -172,12 +243,12 @@ ScalarType opencl_2d_fft_1arg(std::vector<ScalarType>& in,
 
     std::vector<ScalarType> res(in.size());
 
-    viennacl::fast_copy(&in[0], &in[0] + in.size(), input);
+    copy_matrix(in, input);
     //std::cout << input << "\n";
     viennacl::inplace_fft(input);
     //std::cout << input << "\n";
     viennacl::backend::finish();
-    viennacl::fast_copy(input, &res[0]);
+    copy_matrix(input, res);
 
     return diff_max(res, out);
 }
@@ -191,16 +262,17 @@ ScalarType opencl_2d_fft_2arg(std::vector<ScalarType>& in,
 
     std::vector<ScalarType> res(in.size());
 
-    viennacl::fast_copy(&in[0], &in[0] + in.size(), input);
+    copy_matrix(in, input);
     //std::cout << input << "\n";
     viennacl::fft(input, output);
     //std::cout << input << "\n";
     viennacl::backend::finish();
-    viennacl::fast_copy(output, &res[0]);
+    copy_matrix(output, res);
 
     return diff_max(res, out);
 }
 
+#ifdef VIENNACL_WITH_OPENCL
 ScalarType opencl_direct(std::vector<ScalarType>& in,
                          std::vector<ScalarType>& out,
                          unsigned int /*row*/, unsigned int /*col*/, unsigned int batch_num)
@@ -222,6 +294,8 @@ ScalarType opencl_direct(std::vector<ScalarType>& in,
     return diff_max(res, out);
 }
 
+#endif
+
 ScalarType opencl_bluestein(std::vector<ScalarType>& in,
                             std::vector<ScalarType>& out,
                             unsigned int /*row*/, unsigned int /*col*/, unsigned int batch_size)
@@ -241,6 +315,7 @@ ScalarType opencl_bluestein(std::vector<ScalarType>& in,
     return diff_max(res, out);
 }
 
+#ifdef VIENNACL_WITH_OPENCL
 ScalarType opencl_radix2(std::vector<ScalarType>& in,
                          std::vector<ScalarType>& out,
                          unsigned int /*row*/, unsigned int /*col*/, unsigned int batch_num)
@@ -262,6 +337,8 @@ ScalarType opencl_radix2(std::vector<ScalarType>& in,
     return diff_max(res, out);
 }
 
+#endif
+
 ScalarType opencl_convolve(std::vector<ScalarType>& in1,
                            std::vector<ScalarType>& in2,
                            unsigned int /*row*/, unsigned int /*col*/, unsigned int /*batch_size*/)
@@ -320,6 +397,33 @@ int test_correctness(const std::string& log_tag,
 }
 
 
+/** @brief Compares a transform of random data of the given dimensions with the reference DFT. rows == 1 denotes a (batched) 1D transform */
+int test_reference(const std::string& log_tag,
+                   unsigned int rows_num,
+                   unsigned int cols_num,
+                   unsigned int batch_size,
+                   test_function_ptr func) {
+
+    std::vector<ScalarType> input(2 * rows_num * cols_num * batch_size);
+    std::vector<ScalarType> output;
+
+    for(std::size_t i = 0; i < input.size(); i++)
+        input[i] = ScalarType(rand()) / ScalarType(RAND_MAX) - ScalarType(0.5);
+
+    if (rows_num == 1)
+        dft_ref(input, output, cols_num, batch_size);
+    else
+        dft_2d_ref(input, output, rows_num, cols_num);
+
+    ScalarType df = func(input, output, rows_num, cols_num, batch_size);
+    printf("%7s %-24s NX=%6d NY=%6d; BATCH=%3d; DIFF=%3.15f;\n", ((fabs(df) < REF_EPS)?"[Ok]":"[Fail]"), log_tag.c_str(), rows_num, cols_num, batch_size, df);
+    if (df > REF_EPS)
+      return EXIT_FAILURE;
+
+    return EXIT_SUCCESS;
+}
+
+
 
 int main()
 {
@@ -328,16 +432,20 @@ int main()
   std::cout << "*" << std::endl;
 
   //1D FFT tests
+#ifdef VIENNACL_WITH_OPENCL
   if (test_correctness("fft::direct", "../non-release/testdata/cufft.data", read_vectors_pair, &opencl_direct) == EXIT_FAILURE)
     return EXIT_FAILURE;
+#endif
   if (test_correctness("fft::fft", "../non-release/testdata/cufft.data", read_vectors_pair, &opencl_fft) == EXIT_FAILURE)
     return EXIT_FAILURE;
+#ifdef VIENNACL_WITH_OPENCL
   if (test_correctness("fft::batch::direct", "../non-release/testdata/batch_radix.data", read_vectors_pair, &opencl_direct) == EXIT_FAILURE)
     return EXIT_FAILURE;
   if (test_correctness("fft::radix2", "../non-release/testdata/radix2.data", read_vectors_pair, &opencl_radix2) == EXIT_FAILURE)
     return EXIT_FAILURE;
   if (test_correctness("fft::batch::radix2", "../non-release/testdata/batch_radix.data", read_vectors_pair, &opencl_radix2) == EXIT_FAILURE)
     return EXIT_FAILURE;
+#endif
   if (test_correctness("fft::batch::fft", "../non-release/testdata/batch_radix.data", read_vectors_pair, &opencl_fft) == EXIT_FAILURE)
     return EXIT_FAILURE;
   if (test_correctness("fft::convolve::1", "../non-release/testdata/cufft.data", read_vectors_pair, &opencl_convolve) == EXIT_FAILURE)
@@ -370,6 +478,27 @@ int main()
                         "../non-release/testdata/fft2d_direct_big.data", read_matrices_pair, &opencl_2d_fft_2arg) == EXIT_FAILURE)
     return EXIT_FAILURE;
 
+  //comparison with the reference DFT for power-of-two, mixed-radix and prime sizes (the latter use Bluestein's algorithm)
+  unsigned int sizes_1d[] = { 1, 16, 60, 97, 100, 243, 1021 };
+  for(std::size_t i = 0; i < sizeof(sizes_1d) / sizeof(sizes_1d[0]); i++) {
+    if (test_reference("fft::ref", 1, sizes_1d[i], 1, &opencl_fft) == EXIT_FAILURE)
+      return EXIT_FAILURE;
+    if (test_reference("fft::batch::ref", 1, sizes_1d[i], 7, &opencl_fft) == EXIT_FAILURE)
+      return EXIT_FAILURE;
+    if (test_reference("fft::bluestein::ref", 1, sizes_1d[i], 1, &opencl_bluestein) == EXIT_FAILURE)
+      return EXIT_FAILURE;
+    if (test_reference("fft::convolve::ref", 1, sizes_1d[i], 1, &opencl_convolve) == EXIT_FAILURE)
+      return EXIT_FAILURE;
+  }
+
+  unsigned int sizes_2d[][2] = { {1, 1}, {4, 8}, {6, 10}, {7, 13}, {32, 17}, {50, 64} };
+  for(std::size_t i = 0; i < sizeof(sizes_2d) / sizeof(sizes_2d[0]); i++) {
+    if (test_reference("fft:2d::ref::1_arg", sizes_2d[i][0], sizes_2d[i][1], 1, &opencl_2d_fft_1arg) == EXIT_FAILURE)
+      return EXIT_FAILURE;
+    if (test_reference("fft:2d::ref::2_arg", sizes_2d[i][0], sizes_2d[i][1], 1, &opencl_2d_fft_2arg) == EXIT_FAILURE)
+      return EXIT_FAILURE;
+  }
+
   std::cout << std::endl;
   std::cout << "------- Test completed --------" << std::endl;
   std::cout << std::endl;
@@ -0,0 +1,401 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+//
+// *** Boost
+//
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+
+//
+// *** ViennaCL
+//
+#define VIENNACL_WITH_UBLAS 1
+
+#include "viennacl/vector.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_inf.hpp"
+#include "viennacl/generator/host_based/generate.hpp"
+
+#define CHECK_RESULT(cpu,vcl, op) \
+    if ( diff ( cpu, vcl ) > epsilon ) {\
+        std::cout << "# Error at operation: " #op << std::endl;\
+        std::cout << "  diff: " << diff ( cpu, vcl ) << std::endl;\
+        retval = EXIT_FAILURE;\
+    }\
+
+
+using namespace boost::numeric;
+using namespace viennacl;
+
+template <typename ScalarType, typename VCLMatrixType>
+ScalarType diff(ublas::matrix<ScalarType> & mat1, VCLMatrixType & mat2)
+{
+    ublas::matrix<ScalarType> mat2_cpu(mat2.size1(), mat2.size2());
+    viennacl::backend::finish();
+    viennacl::copy(mat2, mat2_cpu);
+    ScalarType ret = 0;
+    for (unsigned int i = 0; i < mat2_cpu.size1(); ++i)
+    {
+      for (unsigned int j = 0; j < mat2_cpu.size2(); ++j)
+      {
+         ScalarType act = std::fabs(mat2_cpu(i,j) - mat1(i,j)) / std::max( std::fabs(mat2_cpu(i, j)), std::fabs(mat1(i,j)) );
+         if (act > ret)
+           ret = act;
+      }
+    }
+    return ret;
+}
+
+template <typename ScalarType>
+ScalarType diff(ublas::vector<ScalarType> & v1, viennacl::vector<ScalarType> & v2)
+{
+    ublas::vector<ScalarType> v2_cpu ( v2.size() );
+    viennacl::backend::finish();
+    viennacl::copy( v2.begin(), v2.end(), v2_cpu.begin() );
+    for ( unsigned int i=0; i<v1.size(); ++i ) {
+        if ( std::max ( std::fabs ( v2_cpu[i] ), std::fabs ( v1[i] ) ) > 0 )
+            v2_cpu[i] = std::fabs ( v2_cpu[i] - v1[i] ) / std::max ( std::fabs ( v2_cpu[i] ), std::fabs ( v1[i] ) );
+        else
+            v2_cpu[i] = 0.0;
+    }
+    return norm_inf ( v2_cpu );
+}
+
+template <typename ScalarType>
+ScalarType diff(ScalarType s, viennacl::scalar<ScalarType> & gs)
+{
+  ScalarType other = gs;
+  return std::fabs(s - other) / std::max(std::fabs(s), std::fabs(other));
+}
+
+
+template< typename NumericT, typename Epsilon >
+int test_vector ( Epsilon const& epsilon) {
+    int retval = EXIT_SUCCESS;
+
+    unsigned int size = 10000;
+
+    ublas::vector<NumericT> cw(size);
+    ublas::vector<NumericT> cx(size);
+    ublas::vector<NumericT> cy(size);
+    ublas::vector<NumericT> cz(size);
+
+    NumericT s;
+
+    for(unsigned int i=0; i<cw.size(); ++i){
+      cw[i] = NumericT(1) + std::rand()/(NumericT)RAND_MAX;
+    }
+
+    std::cout << "Running tests for vector of size " << cw.size() << std::endl;
+
+    viennacl::vector<NumericT> w (size);
+    viennacl::vector<NumericT> x (size);
+    viennacl::vector<NumericT> y (size);
+    viennacl::vector<NumericT> z (size);
+    viennacl::scalar<NumericT> gs(0);
+    viennacl::scalar<NumericT> gt(0);
+
+    cx = NumericT(2)*cw;
+    cy = NumericT(3)*cw;
+    cz = NumericT(4)*cw;
+    viennacl::copy (cw, w);
+    viennacl::copy (cx, x);
+    viennacl::copy (cy, y);
+    viennacl::copy (cz, z);
+
+    NumericT alpha = NumericT(3.14);
+    NumericT beta  = NumericT(3.51);
+
+    // --------------------------------------------------------------------------
+
+    {
+    std::cout << "w = x + y ..." << std::endl;
+    cw = cx + cy;
+    viennacl::scheduler::statement statement(w, viennacl::op_assign(), x + y);
+    generator::host_based::generate_enqueue_statement(statement, statement.array()[0]);
+    CHECK_RESULT(cw, w, w = x + y);
+    }
+
+    {
+    std::cout << "w = alpha*x + beta*y ..." << std::endl;
+    cw = alpha*cx + beta*cy;
+    viennacl::scheduler::statement statement(w, viennacl::op_assign(), alpha*x + beta*y);
+    generator::host_based::generate_enqueue_statement(statement, statement.array()[0]);
+    CHECK_RESULT(cw, w, w = alpha*x + beta*y);
+    }
+
+    {
+    std::cout << "w -= element_prod(x, y) / alpha ..." << std::endl;
+    cw -= ublas::element_prod(cx, cy) / alpha;
+    viennacl::scheduler::statement statement(w, viennacl::op_inplace_sub(), viennacl::linalg::element_prod(x, y) / alpha);
+    generator::host_based::generate_enqueue_statement(statement, statement.array()[0]);
+    CHECK_RESULT(cw, w, w -= element_prod(x, y) / alpha);
+    }
+
+    {
+    std::cout << "s = inner_prod(x,y)..." << std::endl;
+    s = 0;
+    for(unsigned int i=0 ; i<size ; ++i)  s+=cx[i]*cy[i];
+    viennacl::scheduler::statement statement(gs, viennacl::op_assign(), viennacl::linalg::inner_prod(x,y));
+    generator::host_based::generate_enqueue_statement(statement, statement.array()[0]);
+    CHECK_RESULT(s, gs, s = inner_prod(x,y));
+    }
+
+    {
+    std::cout << "s = inner_prod(x + y, x - alpha*z)..." << std::endl;
+    s = 0;
+    for(unsigned int i=0 ; i<size ; ++i)  s+=(cx[i] + cy[i])*(cx[i] - alpha*cz[i]);
+    viennacl::scheduler::statement statement(gs, viennacl::op_assign(), viennacl::linalg::inner_prod(x + y, x - alpha*z));
+    generator::host_based::generate_enqueue_statement(statement, statement.array()[0]);
+    CHECK_RESULT(s, gs, s = inner_prod(x + y, x - alpha*z));
+    }
+
+    {
+    std::cout << "w = x + y(slice) ..." << std::endl;
+    viennacl::vector<NumericT> big(2*size);
+    ublas::vector<NumericT> cbig(2*size);
+    for(unsigned int i=0; i<cbig.size(); ++i)
+      cbig[i] = std::rand()/(NumericT)RAND_MAX;
+    viennacl::copy(cbig, big);
+    viennacl::vector_slice<viennacl::vector<NumericT> > big_slice(big, viennacl::slice(1, 2, size));
+    cw = cx + ublas::vector_slice<ublas::vector<NumericT> >(cbig, ublas::slice(1, 2, size));
+    viennacl::scheduler::statement statement(w, viennacl::op_assign(), x + big_slice);
+    generator::host_based::generate_enqueue_statement(statement, statement.array()[0]);
+    CHECK_RESULT(cw, w, w = x + y(slice));
+    }
+
+    {
+    std::cout << "Multiline ..." << std::endl;
+    viennacl::scheduler::statement statement1(w, viennacl::op_assign(), x - y);
+    viennacl::scheduler::statement statement2(gs, viennacl::op_assign(), viennacl::linalg::inner_prod(w, z));
+    viennacl::scheduler::statement statement3(y, viennacl::op_assign(), viennacl::linalg::element_prod(w, z));
+    viennacl::scheduler::statement statement4(z, viennacl::op_inplace_add(), gs * x);
+    viennacl::scheduler::statement statement5(gt, viennacl::op_assign(), viennacl::linalg::inner_prod(z, y));
+
+    generator::host_based::code_generator gen;
+    gen.add(statement1, statement1.array()[0]);
+    gen.add(statement2, statement2.array()[0]);
+    gen.add(statement3, statement3.array()[0]);
+    gen.add(statement4, statement4.array()[0]);
+    gen.add(statement5, statement5.array()[0]);
+    if (gen.statements().size() != 5)
+    {
+      std::cout << "# Error: Statements not supported by the generator" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+    generator::host_based::enqueue(gen);
+
+    cw = cx - cy;
+    s = 0;
+    for(unsigned int i=0 ; i<size ; ++i)  s+=cw[i]*cz[i];
+    cy = ublas::element_prod(cw, cz);
+    cz += s * cx;
+    NumericT t = 0;
+    for(unsigned int i=0 ; i<size ; ++i)  t+=cz[i]*cy[i];
+
+    CHECK_RESULT(cw, w, Multiline);
+    CHECK_RESULT(s, gs, Multiline);
+    CHECK_RESULT(cy, y, Multiline);
+    CHECK_RESULT(cz, z, Multiline);
+    CHECK_RESULT(t, gt, Multiline);
+    }
+
+    return retval;
+}
+
+
+
+template< typename NumericT, class Layout, typename Epsilon >
+int test_matrix ( Epsilon const& epsilon) {
+    int retval = EXIT_SUCCESS;
+
+    unsigned int size1 = 123;
+    unsigned int size2 = 271;
+
+    ublas::matrix<NumericT> cA(size1,size2);
+    ublas::matrix<NumericT> cB(size1,size2);
+    ublas::matrix<NumericT> cC(size1,size2);
+
+    for(unsigned int i=0; i<size1; ++i)
+        for(unsigned int j=0 ; j<size2; ++j)
+        {
+            cA(i,j) = NumericT(1) + (NumericT)std::rand()/RAND_MAX;
+            cB(i,j) = NumericT(1) + (NumericT)std::rand()/RAND_MAX;
+        }
+
+    viennacl::matrix<NumericT,Layout> A (size1, size2);
+    viennacl::matrix<NumericT,Layout> B (size1, size2);
+    viennacl::matrix<NumericT,Layout> C (size1, size2);
+
+    cC = cA;
+    viennacl::copy(cA,A);
+    viennacl::copy(cB,B);
+    viennacl::copy(cC,C);
+
+    NumericT alpha = NumericT(2.5);
+
+    {
+      std::cout << "C = A + B ..." << std::endl;
+      cC     = ( cA + cB );
+      viennacl::scheduler::statement statement(C, viennacl::op_assign(), A + B);
+      generator::host_based::generate_enqueue_statement(statement, statement.array()[0]);
+      CHECK_RESULT(cC, C, C=A+B)
+    }
+
+    {
+      std::cout << "C += alpha * element_prod(A, B) - B ..." << std::endl;
+      cC    += alpha * ublas::element_prod(cA, cB) - cB;
+      viennacl::scheduler::statement statement(C, viennacl::op_inplace_add(), alpha * viennacl::linalg::element_prod(A, B) - B);
+      generator::host_based::generate_enqueue_statement(statement, statement.array()[0]);
+      CHECK_RESULT(cC, C, C += alpha * element_prod(A, B) - B)
+    }
+
+    {
+      std::cout << "C(range) = A(range) - B(range) / alpha ..." << std::endl;
+      viennacl::range r1(3, size1 - 2);
+      viennacl::range r2(5, size2 - 7);
+      ublas::range cr1(3, size1 - 2);
+      ublas::range cr2(5, size2 - 7);
+      ublas::matrix_range<ublas::matrix<NumericT> >(cC, cr1, cr2) = ublas::matrix_range<ublas::matrix<NumericT> >(cA, cr1, cr2) - ublas::matrix_range<ublas::matrix<NumericT> >(cB, cr1, cr2) / alpha;
+
+      viennacl::matrix_range<viennacl::matrix<NumericT,Layout> > A_range(A, r1, r2);
+      viennacl::matrix_range<viennacl::matrix<NumericT,Layout> > B_range(B, r1, r2);
+      viennacl::matrix_range<viennacl::matrix<NumericT,Layout> > C_range(C, r1, r2);
+      viennacl::scheduler::statement statement(C_range, viennacl::op_assign(), A_range - B_range / alpha);
+      generator::host_based::generate_enqueue_statement(statement, statement.array()[0]);
+      CHECK_RESULT(cC, C, C(range) = A(range) - B(range) / alpha)
+    }
+
+    {
+      std::cout << "x = prod(A, y) (not supported, executed by the scheduler) ..." << std::endl;
+      viennacl::vector<NumericT> x(size1);
+      viennacl::vector<NumericT> y(size2);
+      ublas::vector<NumericT> cx(size1);
+      ublas::vector<NumericT> cy(size2);
+      for(unsigned int i=0; i<size2; ++i)
+        cy[i] = (NumericT)std::rand()/RAND_MAX;
+      viennacl::copy(cy, y);
+
+      cx = ublas::prod(cA, cy);
+      viennacl::scheduler::statement statement(x, viennacl::op_assign(), viennacl::linalg::prod(A, y));
+      generator::host_based::code_generator gen;
+      if (gen.add(statement, statement.array()[0]))
+      {
+        std::cout << "# Error: Matrix-vector product accepted by the generator" << std::endl;
+        retval = EXIT_FAILURE;
+      }
+      generator::host_based::generate_enqueue_statement(statement, statement.array()[0]);
+      CHECK_RESULT(cx, x, x = prod(A, y))
+    }
+
+    return retval;
+}
+
+
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "----------------------------------------------" << std::endl;
+    std::cout << "----------------------------------------------" << std::endl;
+    std::cout << "## Test :: Host Generator" << std::endl;
+    std::cout << "----------------------------------------------" << std::endl;
+    std::cout << "----------------------------------------------" << std::endl;
+    std::cout << std::endl;
+
+    int retval = EXIT_SUCCESS;
+
+    std::cout << std::endl;
+    std::cout << "----------------------------------------------" << std::endl;
+    std::cout << "## Test :: Vector" << std::endl;
+    std::cout << "----------------------------------------------" << std::endl;
+    {
+        std::cout << "# Testing setup:" << std::endl;
+        std::cout << "  numeric: float" << std::endl;
+        retval = test_vector<float> (1.0E-4);
+        if ( retval != EXIT_SUCCESS )
+            return retval;
+
+        std::cout << "# Testing setup:" << std::endl;
+        std::cout << "  numeric: double" << std::endl;
+        retval = test_vector<double> (1.0E-10);
+        if ( retval != EXIT_SUCCESS )
+            return retval;
+
+        std::cout << "# Test passed" << std::endl;
+    }
+
+    std::cout << std::endl;
+    std::cout << "----------------------------------------------" << std::endl;
+    std::cout << "## Test :: Matrix" << std::endl;
+    std::cout << "----------------------------------------------" << std::endl;
+    {
+        std::cout << "# Testing setup:" << std::endl;
+        std::cout << "  numeric: float" << std::endl;
+        std::cout << "  --------------" << std::endl;
+        std::cout << "  Row-Major"      << std::endl;
+        std::cout << "  --------------" << std::endl;
+        retval = test_matrix<float, viennacl::row_major> (1.0E-4);
+        if ( retval != EXIT_SUCCESS )
+            return retval;
+
+        std::cout << "  --------------" << std::endl;
+        std::cout << "  Column-Major"   << std::endl;
+        std::cout << "  --------------" << std::endl;
+        retval = test_matrix<float, viennacl::column_major> (1.0E-4);
+        if ( retval != EXIT_SUCCESS )
+            return retval;
+
+        std::cout << "  numeric: double" << std::endl;
+        std::cout << "  --------------" << std::endl;
+        std::cout << "  Row-Major"      << std::endl;
+        std::cout << "  --------------" << std::endl;
+        retval = test_matrix<double, viennacl::row_major> (1.0E-10);
+        if ( retval != EXIT_SUCCESS )
+            return retval;
+
+        std::cout << "  --------------" << std::endl;
+        std::cout << "  Column-Major"   << std::endl;
+        std::cout << "  --------------" << std::endl;
+        retval = test_matrix<double, viennacl::column_major> (1.0E-10);
+        if ( retval != EXIT_SUCCESS )
+            return retval;
+
+        std::cout << "# Test passed" << std::endl;
+    }
+
+    std::cout << std::endl;
+    std::cout << "------- Test completed --------" << std::endl;
+    std::cout << std::endl;
+
+    return retval;
+}
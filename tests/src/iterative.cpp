@@ -0,0 +1,467 @@
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+//
+// *** System
+//
+#include <iostream>
+#include <cmath>
+#include <string>
+
+//
+// *** Boost
+//
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/operation_sparse.hpp>
+
+// Must be set if you want to use ViennaCL algorithms on ublas objects
+#define VIENNACL_WITH_UBLAS 1
+
+//
+// *** ViennaCL
+//
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/coordinate_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/mixed_precision_cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/gmres.hpp"
+
+
+using namespace boost::numeric;
+
+
+/** @brief Assembles the 5-point finite difference Laplacian on an m-by-m grid */
+template <typename NumericT>
+void fill_laplace_2d(ublas::compressed_matrix<NumericT> & A, std::size_t m)
+{
+  A.resize(m * m, m * m, false);
+  for (std::size_t i = 0; i < m; ++i)
+  {
+    for (std::size_t j = 0; j < m; ++j)
+    {
+      std::size_t row = i * m + j;
+
+      if (i > 0)
+        A.push_back(row, row - m, NumericT(-1));
+      if (j > 0)
+        A.push_back(row, row - 1, NumericT(-1));
+
+      A.push_back(row, row, NumericT(4));
+
+      if (j < m - 1)
+        A.push_back(row, row + 1, NumericT(-1));
+      if (i < m - 1)
+        A.push_back(row, row + m, NumericT(-1));
+    }
+  }
+}
+
+
+/** @brief Assembles a nonsymmetric convection-diffusion operator on an m-by-m grid (5-point Laplacian plus upwind convection in x-direction) */
+template <typename NumericT>
+void fill_convection_diffusion_2d(ublas::compressed_matrix<NumericT> & A, std::size_t m)
+{
+  A.resize(m * m, m * m, false);
+  for (std::size_t i = 0; i < m; ++i)
+  {
+    for (std::size_t j = 0; j < m; ++j)
+    {
+      std::size_t row = i * m + j;
+
+      if (i > 0)
+        A.push_back(row, row - m, NumericT(-1));
+      if (j > 0)
+        A.push_back(row, row - 1, NumericT(-2));
+
+      A.push_back(row, row, NumericT(5));
+
+      if (j < m - 1)
+        A.push_back(row, row + 1, NumericT(-1));
+      if (i < m - 1)
+        A.push_back(row, row + m, NumericT(-1));
+    }
+  }
+}
+
+
+/** @brief Returns ||b - A x|| / ||b|| */
+template <typename MatrixType, typename NumericT>
+NumericT relative_residual(MatrixType const & A, viennacl::vector<NumericT> const & x, viennacl::vector<NumericT> const & b)
+{
+  viennacl::vector<NumericT> residual = b;
+  residual -= viennacl::linalg::prod(A, x);
+  return viennacl::linalg::norm_2(residual) / viennacl::linalg::norm_2(b);
+}
+
+
+/** @brief Returns ||x - y|| / ||y|| */
+template <typename NumericT>
+NumericT relative_difference(viennacl::vector<NumericT> const & x, viennacl::vector<NumericT> const & y)
+{
+  viennacl::vector<NumericT> diff = x;
+  diff -= y;
+  return viennacl::linalg::norm_2(diff) / viennacl::linalg::norm_2(y);
+}
+
+
+/** @brief Checks the result of a solver variant against the result of the classical solver */
+template <typename MatrixType, typename NumericT>
+int check_solutions(MatrixType const & A,
+                    viennacl::vector<NumericT> const & b,
+                    viennacl::vector<NumericT> const & x_reference,
+                    viennacl::vector<NumericT> const & x,
+                    std::string const & name,
+                    NumericT tolerance)
+{
+  NumericT res_reference = relative_residual(A, x_reference, b);
+  NumericT res           = relative_residual(A, x, b);
+  NumericT diff          = relative_difference(x, x_reference);
+
+  std::cout << "  " << name << ": residual classical " << res_reference << ", variant " << res
+            << ", difference of solutions " << diff << std::endl;
+
+  if (res_reference > 10 * tolerance || res > 10 * tolerance)
+  {
+    std::cout << "# Error at operation: " << name << " (residual too large)" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the condition number of the test system is a few hundred:
+  if (diff > 1000 * tolerance)
+  {
+    std::cout << "# Error at operation: " << name << " (solutions differ)" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+template <typename MatrixType, typename NumericT>
+int test_pipelined_cg(MatrixType const & A, viennacl::vector<NumericT> const & b, std::string const & name, NumericT tolerance)
+{
+  viennacl::linalg::cg_tag classical_tag(tolerance, 1000);
+  viennacl::vector<NumericT> x_classical = viennacl::linalg::solve(A, b, classical_tag);
+
+  viennacl::linalg::pipelined_cg_tag pipelined_tag(tolerance, 1000);
+  viennacl::vector<NumericT> x_pipelined = viennacl::linalg::solve(A, b, pipelined_tag);
+
+  std::cout << "  " << name << ": iterations classical " << classical_tag.iters() << ", pipelined " << pipelined_tag.iters() << std::endl;
+
+  // both variants are mathematically equivalent, so only round-off may change the iteration count:
+  if (pipelined_tag.iters() > classical_tag.iters() + 2 || classical_tag.iters() > pipelined_tag.iters() + 2)
+  {
+    std::cout << "# Error at operation: " << name << " (iteration counts differ)" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return check_solutions(A, b, x_classical, x_pipelined, name, tolerance);
+}
+
+
+template <typename MatrixType, typename NumericT>
+int test_pipelined_bicgstab(MatrixType const & A, viennacl::vector<NumericT> const & b, std::string const & name, NumericT tolerance)
+{
+  viennacl::linalg::bicgstab_tag classical_tag(tolerance, 1000);
+  viennacl::vector<NumericT> x_classical = viennacl::linalg::solve(A, b, classical_tag);
+
+  viennacl::linalg::pipelined_bicgstab_tag pipelined_tag(tolerance, 1000);
+  viennacl::vector<NumericT> x_pipelined = viennacl::linalg::solve(A, b, pipelined_tag);
+
+  std::cout << "  " << name << ": iterations classical " << classical_tag.iters() << ", pipelined " << pipelined_tag.iters() << std::endl;
+
+  return check_solutions(A, b, x_classical, x_pipelined, name, tolerance);
+}
+
+
+template <typename MatrixType, typename NumericT>
+int test_pipelined_gmres(MatrixType const & A, viennacl::vector<NumericT> const & b, std::string const & name, NumericT tolerance)
+{
+  // small Krylov space in order to exercise restarts:
+  viennacl::linalg::gmres_tag classical_tag(tolerance, 1000, 10);
+  viennacl::vector<NumericT> x_classical = viennacl::linalg::solve(A, b, classical_tag);
+
+  viennacl::linalg::pipelined_gmres_tag pipelined_tag(tolerance, 1000, 10);
+  viennacl::vector<NumericT> x_pipelined = viennacl::linalg::solve(A, b, pipelined_tag);
+
+  std::cout << "  " << name << ": iterations classical " << classical_tag.iters() << ", pipelined " << pipelined_tag.iters() << std::endl;
+
+  return check_solutions(A, b, x_classical, x_pipelined, name, tolerance);
+}
+
+
+/** @brief Solves for several right hand sides with block CG and compares each column with the result of the single-vector CG
+*
+* Column 0 is a generic right hand side, column 1 is zero, column 2 is an eigenvector of the system matrix (converges in one iteration),
+* and column 3 is a unit vector.
+*/
+template <typename F, typename MatrixType, typename NumericT>
+int test_block_cg(MatrixType const & A, ublas::vector<NumericT> const & ublas_b, std::size_t m, std::string const & name, NumericT tolerance)
+{
+  std::size_t problem_size = m * m;
+  std::size_t num_rhs      = 4;
+
+  ublas::matrix<NumericT> ublas_B(problem_size, num_rhs);
+  ublas_B.clear();
+  ublas::column(ublas_B, 0) = ublas_b;
+  for (std::size_t i = 0; i < m; ++i)
+    for (std::size_t j = 0; j < m; ++j)
+      ublas_B(i * m + j, 2) = static_cast<NumericT>(std::sin(3.1415926535897932 * double(i + 1) / double(m + 1)) * std::sin(3.1415926535897932 * double(j + 1) / double(m + 1)));
+  ublas_B(m / 2, 3) = NumericT(1);
+
+  viennacl::matrix<NumericT, F> B(problem_size, num_rhs);
+  viennacl::copy(ublas_B, B);
+
+  viennacl::linalg::block_cg_tag block_tag(tolerance, 1000);
+  viennacl::matrix<NumericT, F> X = viennacl::linalg::solve(A, B, block_tag);
+
+  ublas::matrix<NumericT> ublas_X(problem_size, num_rhs);
+  viennacl::copy(X, ublas_X);
+
+  std::cout << "  " << name << ": iterations block CG " << block_tag.iters() << std::endl;
+
+  for (std::size_t j = 0; j < num_rhs; ++j)
+  {
+    viennacl::vector<NumericT> b_j(problem_size);
+    viennacl::vector<NumericT> x_j(problem_size);
+    ublas::vector<NumericT> ublas_b_j = ublas::column(ublas_B, j);
+    ublas::vector<NumericT> ublas_x_j = ublas::column(ublas_X, j);
+    viennacl::copy(ublas_b_j, b_j);
+    viennacl::copy(ublas_x_j, x_j);
+
+    if (j == 1) // zero right hand side
+    {
+      if (viennacl::linalg::norm_2(x_j) > 0 || block_tag.column_iters()[j] != 0)
+      {
+        std::cout << "# Error at operation: " << name << " (nonzero solution or iterations for zero right hand side)" << std::endl;
+        return EXIT_FAILURE;
+      }
+      continue;
+    }
+
+    viennacl::linalg::cg_tag single_tag(tolerance, 1000);
+    viennacl::vector<NumericT> x_single = viennacl::linalg::solve(A, b_j, single_tag);
+
+    std::cout << "    column " << j << ": iterations block CG " << block_tag.column_iters()[j] << ", CG " << single_tag.iters() << std::endl;
+
+    // the iterates of each column are the same as for the single-vector CG, only the order of floating point operations differs:
+    if (block_tag.column_iters()[j] > single_tag.iters() + 2 || single_tag.iters() > block_tag.column_iters()[j] + 2)
+    {
+      std::cout << "# Error at operation: " << name << " (iteration counts differ in column " << j << ")" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (check_solutions(A, b_j, x_single, x_j, name, tolerance) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // the eigenvector column must converge (and be deflated) long before the others:
+  if (block_tag.column_iters()[2] > 2 || block_tag.column_iters()[2] >= block_tag.column_iters()[0])
+  {
+    std::cout << "# Error at operation: " << name << " (eigenvector column did not converge early)" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+template <typename NumericT>
+int test(NumericT tolerance)
+{
+  std::size_t m = 20;
+
+  ublas::compressed_matrix<NumericT> ublas_A;
+  fill_laplace_2d(ublas_A, m);
+
+  ublas::vector<NumericT> ublas_x(m * m);
+  for (std::size_t i = 0; i < ublas_x.size(); ++i)
+    ublas_x[i] = NumericT(1) + NumericT(i % 7) / NumericT(7);
+  ublas::vector<NumericT> ublas_b = ublas::prod(ublas_A, ublas_x);
+
+  viennacl::compressed_matrix<NumericT> compressed_A(m * m, m * m);
+  viennacl::copy(ublas_A, compressed_A);
+  viennacl::coordinate_matrix<NumericT> coordinate_A(m * m, m * m);
+  viennacl::copy(ublas_A, coordinate_A);
+
+  viennacl::vector<NumericT> b(m * m);
+  viennacl::copy(ublas_b, b);
+
+  std::cout << "Testing pipelined CG..." << std::endl;
+  if (test_pipelined_cg(compressed_A, b, "pipelined CG, compressed_matrix", tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_pipelined_cg(coordinate_A, b, "pipelined CG, coordinate_matrix", tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "Testing block CG..." << std::endl;
+  if (test_block_cg<viennacl::row_major>(compressed_A, ublas_b, m, "block CG, compressed_matrix, row_major", tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_block_cg<viennacl::column_major>(compressed_A, ublas_b, m, "block CG, compressed_matrix, column_major", tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_block_cg<viennacl::row_major>(coordinate_A, ublas_b, m, "block CG, coordinate_matrix, row_major", tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  //
+  // nonsymmetric system for BiCGStab and GMRES:
+  //
+  ublas::compressed_matrix<NumericT> ublas_N;
+  fill_convection_diffusion_2d(ublas_N, m);
+  ublas_b = ublas::prod(ublas_N, ublas_x);
+
+  viennacl::compressed_matrix<NumericT> compressed_N(m * m, m * m);
+  viennacl::copy(ublas_N, compressed_N);
+  viennacl::coordinate_matrix<NumericT> coordinate_N(m * m, m * m);
+  viennacl::copy(ublas_N, coordinate_N);
+
+  viennacl::copy(ublas_b, b);
+
+  std::cout << "Testing pipelined BiCGStab..." << std::endl;
+  if (test_pipelined_bicgstab(compressed_N, b, "pipelined BiCGStab, compressed_matrix", tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_pipelined_bicgstab(coordinate_N, b, "pipelined BiCGStab, coordinate_matrix", tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "Testing pipelined GMRES..." << std::endl;
+  if (test_pipelined_gmres(compressed_N, b, "pipelined GMRES, compressed_matrix", tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_pipelined_gmres(coordinate_N, b, "pipelined GMRES, coordinate_matrix", tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+
+/** @brief Solves the 2D Laplacian with the mixed precision CG (single precision inner iterations, double precision defect corrections) and compares with the double precision CG */
+int test_mixed_precision_cg(double tolerance)
+{
+  typedef double NumericT;
+
+  std::size_t m = 20;
+
+  ublas::compressed_matrix<NumericT> ublas_A;
+  fill_laplace_2d(ublas_A, m);
+
+  ublas::vector<NumericT> ublas_x(m * m);
+  for (std::size_t i = 0; i < ublas_x.size(); ++i)
+    ublas_x[i] = NumericT(1) + NumericT(i % 7) / NumericT(7);
+  ublas::vector<NumericT> ublas_b = ublas::prod(ublas_A, ublas_x);
+
+  viennacl::compressed_matrix<NumericT> A(m * m, m * m);
+  viennacl::copy(ublas_A, A);
+  viennacl::vector<NumericT> b(m * m);
+  viennacl::copy(ublas_b, b);
+
+  std::cout << "Testing mixed precision CG..." << std::endl;
+
+  viennacl::linalg::cg_tag classical_tag(tolerance, 1000);
+  viennacl::vector<NumericT> x_classical = viennacl::linalg::solve(A, b, classical_tag);
+
+  viennacl::linalg::mixed_precision_cg_tag mixed_tag(tolerance, 1000);
+  viennacl::vector<NumericT> x_mixed = viennacl::linalg::solve(A, b, mixed_tag);
+
+  std::cout << "  mixed precision CG: inner iterations " << mixed_tag.inner_iters() << ", outer iterations " << mixed_tag.outer_iters()
+            << ", estimated error " << mixed_tag.error() << " (CG: " << classical_tag.iters() << " iterations)" << std::endl;
+
+  // every outer iteration (defect correction) finishes at least one inner iteration, and the last one has to meet the tolerance:
+  if (   mixed_tag.outer_iters() == 0
+      || mixed_tag.inner_iters() < mixed_tag.outer_iters()
+      || mixed_tag.iters() != mixed_tag.inner_iters()
+      || mixed_tag.inner_iters() >= mixed_tag.max_iterations()
+      || mixed_tag.error() > tolerance)
+  {
+    std::cout << "# Error at operation: mixed precision CG (inconsistent iteration counters or error estimate)" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the true residual is computed in double precision at the end of each outer iteration:
+  if (relative_residual(A, x_mixed, b) > tolerance)
+  {
+    std::cout << "# Error at operation: mixed precision CG (residual " << relative_residual(A, x_mixed, b) << " too large)" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return check_solutions(A, b, x_classical, x_mixed, "mixed precision CG", tolerance);
+}
+
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Iterative Solvers" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  {
+    typedef float NumericT;
+    NumericT tolerance = static_cast<NumericT>(1E-5);
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  tolerance: " << tolerance << std::endl;
+    std::cout << "  numeric: float" << std::endl;
+    retval = test<NumericT>(tolerance);
+    if( retval == EXIT_SUCCESS )
+      std::cout << "# Test passed" << std::endl;
+    else
+      return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    typedef double NumericT;
+    NumericT tolerance = 1.0E-10;
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  tolerance: " << tolerance << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    retval = test<NumericT>(tolerance);
+    if( retval == EXIT_SUCCESS )
+      retval = test_mixed_precision_cg(tolerance);
+    if( retval == EXIT_SUCCESS )
+      std::cout << "# Test passed" << std::endl;
+    else
+      return retval;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
@@ -1042,6 +1042,75 @@ int test(Epsilon const& epsilon)
       retval = EXIT_FAILURE;
    }
 
+   //full solver with partial pivoting (zero diagonal, dominant entries on the first superdiagonal):
+   std::cout << "Full solver with pivoting" << std::endl;
+   unsigned int lu_pivot_dim = 300;
+   ublas::matrix<NumericT> pivot_matrix(lu_pivot_dim, lu_pivot_dim);
+   ublas::vector<NumericT> lu_pivot_rhs(lu_pivot_dim);
+   viennacl::matrix<NumericT, F> vcl_pivot_matrix(lu_pivot_dim, lu_pivot_dim);
+   viennacl::vector<NumericT> vcl_lu_pivot_rhs(lu_pivot_dim);
+
+   for (std::size_t i=0; i<lu_pivot_dim; ++i)
+     for (std::size_t j=0; j<lu_pivot_dim; ++j)
+       pivot_matrix(i,j) = -static_cast<NumericT>(0.1) * random<NumericT>();
+
+   for (std::size_t j=0; j<lu_pivot_dim; ++j)
+   {
+     pivot_matrix(j,j) = 0;
+     pivot_matrix(j, (j+1) % lu_pivot_dim) = static_cast<NumericT>(50.0) + random<NumericT>();
+     lu_pivot_rhs(j) = random<NumericT>();
+   }
+
+   viennacl::copy(pivot_matrix, vcl_pivot_matrix);
+   viennacl::copy(lu_pivot_rhs, vcl_lu_pivot_rhs);
+
+   //ublas::
+   ublas::permutation_matrix<std::size_t> ublas_pivots(lu_pivot_dim);
+   ublas::lu_factorize(pivot_matrix, ublas_pivots);
+   ublas::lu_substitute(pivot_matrix, ublas_pivots, lu_pivot_rhs);
+
+   // ViennaCL:
+   std::vector<viennacl::vcl_size_t> vcl_permutation;
+   viennacl::linalg::lu_factorize(vcl_pivot_matrix, vcl_permutation);
+   viennacl::linalg::lu_substitute(vcl_pivot_matrix, vcl_permutation, vcl_lu_pivot_rhs);
+
+   if( fabs(diff(lu_pivot_rhs, vcl_lu_pivot_rhs)) > epsilon )
+   {
+      std::cout << "# Error at operation: dense solver with pivoting" << std::endl;
+      std::cout << "  diff: " << fabs(diff(lu_pivot_rhs, vcl_lu_pivot_rhs)) << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
+   //multiple right hand sides, reusing the factorizations from above:
+   std::cout << "Full solver with pivoting, multiple right hand sides" << std::endl;
+   std::size_t lu_pivot_rhs_num = 7;
+   ublas::matrix<NumericT> lu_pivot_rhs_matrix(lu_pivot_dim, lu_pivot_rhs_num);
+   for (std::size_t i=0; i<lu_pivot_dim; ++i)
+     for (std::size_t j=0; j<lu_pivot_rhs_num; ++j)
+       lu_pivot_rhs_matrix(i,j) = random<NumericT>();
+
+   viennacl::matrix<NumericT, viennacl::row_major>    vcl_lu_pivot_rhs_row(lu_pivot_dim, lu_pivot_rhs_num);
+   viennacl::matrix<NumericT, viennacl::column_major> vcl_lu_pivot_rhs_col(lu_pivot_dim, lu_pivot_rhs_num);
+   viennacl::copy(lu_pivot_rhs_matrix, vcl_lu_pivot_rhs_row);
+   viennacl::copy(lu_pivot_rhs_matrix, vcl_lu_pivot_rhs_col);
+
+   ublas::lu_substitute(pivot_matrix, ublas_pivots, lu_pivot_rhs_matrix);
+   viennacl::linalg::lu_substitute(vcl_pivot_matrix, vcl_permutation, vcl_lu_pivot_rhs_row);
+   viennacl::linalg::lu_substitute(vcl_pivot_matrix, vcl_permutation, vcl_lu_pivot_rhs_col);
+
+   if( fabs(diff(lu_pivot_rhs_matrix, vcl_lu_pivot_rhs_row)) > epsilon )
+   {
+      std::cout << "# Error at operation: dense solver with pivoting, row-major right hand sides" << std::endl;
+      std::cout << "  diff: " << fabs(diff(lu_pivot_rhs_matrix, vcl_lu_pivot_rhs_row)) << std::endl;
+      retval = EXIT_FAILURE;
+   }
+   if( fabs(diff(lu_pivot_rhs_matrix, vcl_lu_pivot_rhs_col)) > epsilon )
+   {
+      std::cout << "# Error at operation: dense solver with pivoting, column-major right hand sides" << std::endl;
+      std::cout << "  diff: " << fabs(diff(lu_pivot_rhs_matrix, vcl_lu_pivot_rhs_col)) << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
 
 
    return retval;
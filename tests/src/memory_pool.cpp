@@ -0,0 +1,207 @@
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+//
+// *** System
+//
+#include <iostream>
+#include <cstdlib>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/backend/cpu_ram.hpp"
+#include "viennacl/vector.hpp"
+
+
+namespace cpu_ram = viennacl::backend::cpu_ram;
+
+
+/** @brief Compares a statistics entry with its expected value */
+int check(std::size_t value, std::size_t expected, const char * what)
+{
+  if (value != expected)
+  {
+    std::cout << "# Error: " << what << " is " << value << ", expected " << expected << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+
+int test_cache_hits()
+{
+  std::size_t class_size = cpu_ram::detail::size_class(1000);
+  cpu_ram::memory_statistics before = cpu_ram::statistics();
+
+  // first allocation of this size class goes to the system allocator:
+  cpu_ram::handle_type h = cpu_ram::memory_create(1000);
+  cpu_ram::memory_statistics stats = cpu_ram::statistics();
+  if (reinterpret_cast<std::size_t>(h.get()) % cpu_ram::memory_alignment != 0)
+  {
+    std::cout << "# Error: buffer not aligned" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (   check(stats.allocations, before.allocations + 1, "allocations")
+      || check(stats.cache_hits,  before.cache_hits,      "cache hits")
+      || check(stats.bytes_live,  before.bytes_live + class_size, "bytes_live")
+      || check(stats.bytes_peak,  before.bytes_live + class_size, "bytes_peak"))
+    return EXIT_FAILURE;
+
+  // released buffer is kept in the cache:
+  h.reset();
+  stats = cpu_ram::statistics();
+  if (   check(stats.bytes_live,   before.bytes_live, "bytes_live after release")
+      || check(stats.bytes_cached, before.bytes_cached + class_size, "bytes_cached after release"))
+    return EXIT_FAILURE;
+
+  // repeated allocations of the same size are served from the cache:
+  for (std::size_t i=0; i<10; ++i)
+  {
+    cpu_ram::handle_type h2 = cpu_ram::memory_create(1000);
+    if (check(cpu_ram::statistics().bytes_cached, before.bytes_cached, "bytes_cached while in use"))
+      return EXIT_FAILURE;
+  }
+  stats = cpu_ram::statistics();
+  if (   check(stats.allocations,  before.allocations + 11, "allocations after reuse")
+      || check(stats.cache_hits,   before.cache_hits + 10,  "cache hits after reuse")
+      || check(stats.bytes_cached, before.bytes_cached + class_size, "bytes_cached after reuse")
+      || check(stats.bytes_peak,   before.bytes_live + class_size,   "bytes_peak after reuse"))
+    return EXIT_FAILURE;
+
+  // two buffers alive at the same time: one from the cache, one from the system:
+  {
+    cpu_ram::handle_type h3 = cpu_ram::memory_create(1000);
+    cpu_ram::handle_type h4 = cpu_ram::memory_create(1000);
+    stats = cpu_ram::statistics();
+    if (   check(stats.bytes_live,  before.bytes_live + 2 * class_size, "bytes_live with two buffers")
+        || check(stats.bytes_peak,  before.bytes_live + 2 * class_size, "bytes_peak with two buffers")
+        || check(stats.cache_hits,  before.cache_hits + 11, "cache hits with two buffers"))
+      return EXIT_FAILURE;
+  }
+  stats = cpu_ram::statistics();
+  if (   check(stats.bytes_live,   before.bytes_live, "bytes_live after releasing two buffers")
+      || check(stats.bytes_peak,   before.bytes_live + 2 * class_size, "bytes_peak after releasing two buffers")
+      || check(stats.bytes_cached, before.bytes_cached + 2 * class_size, "bytes_cached after releasing two buffers"))
+    return EXIT_FAILURE;
+
+  // a different size class does not hit the cache:
+  {
+    cpu_ram::handle_type h5 = cpu_ram::memory_create(5000);
+    if (check(cpu_ram::statistics().cache_hits, before.cache_hits + 11, "cache hits for other size class"))
+      return EXIT_FAILURE;
+  }
+
+  // temporaries of ViennaCL types are served from the cache as well:
+  {
+    viennacl::vector<float> x = viennacl::scalar_vector<float>(1000, 1.0f);
+  }
+  std::size_t hits = cpu_ram::statistics().cache_hits;
+  {
+    viennacl::vector<float> x = viennacl::scalar_vector<float>(1000, 1.0f);
+  }
+  if (cpu_ram::statistics().cache_hits <= hits)
+  {
+    std::cout << "# Error: no cache hit for repeated viennacl::vector" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+int test_release()
+{
+  // release_cached_memory() empties the cache, so the next allocation goes to the system allocator:
+  {
+    cpu_ram::handle_type h = cpu_ram::memory_create(1000);
+  }
+  if (cpu_ram::statistics().bytes_cached == 0)
+  {
+    std::cout << "# Error: released buffer not cached" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  cpu_ram::release_cached_memory();
+  cpu_ram::memory_statistics before = cpu_ram::statistics();
+  if (check(before.bytes_cached, 0, "bytes_cached after release_cached_memory()"))
+    return EXIT_FAILURE;
+
+  {
+    cpu_ram::handle_type h = cpu_ram::memory_create(1000);
+  }
+  cpu_ram::memory_statistics stats = cpu_ram::statistics();
+  if (   check(stats.cache_hits,   before.cache_hits, "cache hits after release_cached_memory()")
+      || check(stats.bytes_cached, cpu_ram::detail::size_class(1000), "bytes_cached after release_cached_memory()"))
+    return EXIT_FAILURE;
+
+  // set_cache_limit(0) empties the cache and disables caching:
+  std::size_t old_limit = cpu_ram::cache_limit();
+  cpu_ram::set_cache_limit(0);
+  if (   check(cpu_ram::cache_limit(), 0, "cache limit")
+      || check(cpu_ram::statistics().bytes_cached, 0, "bytes_cached after set_cache_limit(0)"))
+    return EXIT_FAILURE;
+
+  before = cpu_ram::statistics();
+  for (std::size_t i=0; i<5; ++i)
+  {
+    cpu_ram::handle_type h = cpu_ram::memory_create(1000);
+  }
+  stats = cpu_ram::statistics();
+  if (   check(stats.cache_hits,   before.cache_hits, "cache hits with caching disabled")
+      || check(stats.allocations,  before.allocations + 5, "allocations with caching disabled")
+      || check(stats.bytes_cached, 0, "bytes_cached with caching disabled")
+      || check(stats.bytes_live,   before.bytes_live, "bytes_live with caching disabled"))
+    return EXIT_FAILURE;
+
+  cpu_ram::set_cache_limit(old_limit);
+  return EXIT_SUCCESS;
+}
+
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Memory Pool in Main RAM" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  // start with an empty cache:
+  cpu_ram::release_cached_memory();
+  cpu_ram::reset_statistics();
+
+  std::cout << "# Testing cache hits and accounting..." << std::endl;
+  if (test_cache_hits() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Testing release of cached buffers..." << std::endl;
+  if (test_release() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -57,7 +57,7 @@ void fill_random(std::vector< std::vector<ScalarType> >& v)
 }
 
 
-void test_nmf(std::size_t m, std::size_t k, std::size_t n)
+void test_nmf(std::size_t m, std::size_t k, std::size_t n, std::size_t max_iters = 10000)
 {
     std::vector< std::vector<ScalarType> > stl_w(m, std::vector<ScalarType>(k));
     std::vector< std::vector<ScalarType> > stl_h(k, std::vector<ScalarType>(n));
@@ -84,7 +84,7 @@ void test_nmf(std::size_t m, std::size_t k, std::size_t n)
     viennacl::copy(stl_w, w_nmf);
     viennacl::copy(stl_h, h_nmf);
 
-    viennacl::linalg::nmf_config conf;
+    viennacl::linalg::nmf_config conf(1e-4, 1e-5, max_iters);
     viennacl::linalg::nmf(v_ref, w_nmf, h_nmf, conf);
 
     viennacl::matrix<ScalarType> v_nmf = viennacl::linalg::prod(w_nmf, h_nmf);
@@ -97,17 +97,32 @@ void test_nmf(std::size_t m, std::size_t k, std::size_t n)
 
     if (!diff_ok)
       exit(EXIT_FAILURE);
+
+    // one relative residual per convergence check:
+    if (conf.residuals().size() != (conf.iters() - 1) / conf.check_after_steps() + 1)
+    {
+      std::cout << "# Error: Number of recorded residuals does not match the number of iterations" << std::endl;
+      exit(EXIT_FAILURE);
+    }
 }
 
 int main()
 {
   //srand(time(NULL));  //let's use deterministic tests, so keep the default srand() initialization
 
+#ifdef VIENNACL_WITH_OPENCL
   test_nmf(3, 3, 3);
   test_nmf(3, 2, 3);
   test_nmf(16, 7, 12);
   test_nmf(160, 73, 200);
   test_nmf(687, 15, 713);
+#else
+  // smaller problems and fewer iterations keep the host backend test short:
+  test_nmf(3, 3, 3, 2000);
+  test_nmf(3, 2, 3, 2000);
+  test_nmf(16, 7, 12, 2000);
+  test_nmf(60, 10, 80, 1000);
+#endif
 
   std::cout << std::endl;
   std::cout << "------- Test completed --------" << std::endl;
@@ -0,0 +1,292 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+  #include <windows.h>
+  #include <direct.h>
+  #include <process.h>
+#else
+  #include <sys/stat.h>
+  #include <sys/types.h>
+  #include <dirent.h>
+  #include <unistd.h>
+#endif
+
+//
+// *** ViennaCL
+//
+#include "viennacl/vector.hpp"
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/enqueue.hpp"
+#include "viennacl/ocl/program_cache.hpp"
+
+
+//
+// -------------------------------------------------------------
+//
+static const char * cache_test_source_1 =
+"__kernel void cache_test(__global float * x, unsigned int size) \n"
+"{ \n"
+"  for (unsigned int i = get_global_id(0); i < size; i += get_global_size(0)) \n"
+"    x[i] = 2.0f * x[i] + 1.0f; \n"
+"} \n";
+
+static const char * cache_test_source_2 =
+"__kernel void cache_test(__global float * x, unsigned int size) \n"
+"{ \n"
+"  for (unsigned int i = get_global_id(0); i < size; i += get_global_size(0)) \n"
+"    x[i] = 3.0f * x[i] - 1.0f; \n"
+"} \n";
+
+/** @brief Creates a new, empty directory for the cache files and returns its path */
+std::string create_cache_directory()
+{
+  std::string tmp_dir;
+#ifdef _WIN32
+  if (std::getenv("TEMP"))
+    tmp_dir = std::getenv("TEMP");
+  else
+    tmp_dir = ".";
+  std::ostringstream path;
+  path << tmp_dir << "\\viennacl_program_cache_test_" << _getpid();
+  _mkdir(path.str().c_str());
+#else
+  if (std::getenv("TMPDIR"))
+    tmp_dir = std::getenv("TMPDIR");
+  else
+    tmp_dir = "/tmp";
+  std::ostringstream path;
+  path << tmp_dir << "/viennacl_program_cache_test_" << getpid();
+  mkdir(path.str().c_str(), 0700);
+#endif
+  return path.str();
+}
+
+/** @brief Returns the sorted names of the cache files (viennacl_*.clbin) in the directory */
+std::vector<std::string> cache_files(std::string const & path)
+{
+  std::vector<std::string> result;
+#ifdef _WIN32
+  WIN32_FIND_DATAA entry;
+  HANDLE search = FindFirstFileA((path + "\\viennacl_*.clbin").c_str(), &entry);
+  if (search != INVALID_HANDLE_VALUE)
+  {
+    do
+      result.push_back(entry.cFileName);
+    while (FindNextFileA(search, &entry));
+    FindClose(search);
+  }
+#else
+  DIR * dir = opendir(path.c_str());
+  if (dir)
+  {
+    while (dirent * entry = readdir(dir))
+    {
+      std::string name(entry->d_name);
+      if (name.size() > 15 && name.substr(0, 9) == "viennacl_" && name.substr(name.size() - 6) == ".clbin")
+        result.push_back(name);
+    }
+    closedir(dir);
+  }
+#endif
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+/** @brief Removes the cache files and the directory */
+void remove_cache_directory(std::string const & path)
+{
+  std::vector<std::string> files = cache_files(path);
+  for (std::size_t i=0; i<files.size(); ++i)
+    std::remove((path + "/" + files[i]).c_str());
+#ifdef _WIN32
+  _rmdir(path.c_str());
+#else
+  rmdir(path.c_str());
+#endif
+}
+
+/** @brief Runs the kernel 'cache_test' of the program on x = (0, 1, 2, ...) and compares the result with a * x + b */
+bool check_kernel(viennacl::ocl::program & prog, float a, float b, std::string const & name)
+{
+  std::size_t N = 1000;
+  std::vector<float> x(N);
+  for (std::size_t i=0; i<N; ++i)
+    x[i] = static_cast<float>(i);
+
+  viennacl::vector<float> vcl_x(N);
+  viennacl::copy(x, vcl_x);
+
+  viennacl::ocl::kernel & k = prog.get_kernel("cache_test");
+  viennacl::ocl::enqueue(k(vcl_x, static_cast<cl_uint>(N)));
+  viennacl::copy(vcl_x, x);
+
+  for (std::size_t i=0; i<N; ++i)
+  {
+    if (x[i] != a * static_cast<float>(i) + b)
+    {
+      std::cout << "# Error at operation: " << name << std::endl;
+      std::cout << "  entry " << i << ": " << x[i] << " (expected " << a * static_cast<float>(i) + b << ")" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int test(std::string const & path)
+{
+  viennacl::ocl::context & ctx = viennacl::ocl::current_context();
+  std::string old_cache_path = ctx.cache_path();
+  std::string old_build_options = ctx.build_options();
+  ctx.cache_path(path);
+
+  //
+  // First program is built from source and written to the cache:
+  //
+  std::cout << "Testing creation of the cache file..." << std::endl;
+  viennacl::ocl::program & prog_1 = ctx.add_program(cache_test_source_1, "cache_test_1");
+  std::vector<std::string> files = cache_files(path);
+  if (files.size() != 1)
+  {
+    std::cout << "# Error: Expected one cache file after building the program, found " << files.size() << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!check_kernel(prog_1, 2.0f, 1.0f, "kernel built from source"))
+    return EXIT_FAILURE;
+
+  //
+  // Same source and build options: program is loaded from the cache file
+  //
+  std::cout << "Testing reload from the cache file..." << std::endl;
+  viennacl::ocl::program & prog_2 = ctx.add_program(cache_test_source_1, "cache_test_2");
+  if (cache_files(path) != files)
+  {
+    std::cout << "# Error: Cache files changed when adding the same program again" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!check_kernel(prog_2, 2.0f, 1.0f, "kernel loaded from the cache"))
+    return EXIT_FAILURE;
+
+  // Store the binaries of the first source under the key of the second source.
+  // If the second source is loaded from the cache, the kernel computes the result of the first source:
+  std::cout << "Testing that programs are created from the cached binaries..." << std::endl;
+  std::string file_2_name;
+  {
+    std::string key_1 = viennacl::ocl::detail::program_cache_key(ctx.devices(), ctx.build_options(), cache_test_source_1);
+    std::string key_2 = viennacl::ocl::detail::program_cache_key(ctx.devices(), ctx.build_options(), cache_test_source_2);
+
+    std::ifstream file_1(viennacl::ocl::detail::program_cache_file(path, key_1).c_str(), std::ios::binary);
+    std::stringstream content;
+    content << file_1.rdbuf();
+    std::string binaries = content.str().substr(key_1.size());
+
+    file_2_name = viennacl::ocl::detail::program_cache_file(path, key_2);
+    std::ofstream file_2(file_2_name.c_str(), std::ios::binary);
+    file_2 << key_2 << binaries;
+  }
+  viennacl::ocl::program & prog_3 = ctx.add_program(cache_test_source_2, "cache_test_3");
+  if (!check_kernel(prog_3, 2.0f, 1.0f, "kernel created from substituted binaries"))
+    return EXIT_FAILURE;
+  std::remove(file_2_name.c_str());  // leave only the cache file of the first source
+
+  //
+  // Different build options result in a different cache file:
+  //
+  std::cout << "Testing different build options..." << std::endl;
+  ctx.build_options(old_build_options + " -cl-mad-enable");
+  viennacl::ocl::program & prog_4 = ctx.add_program(cache_test_source_1, "cache_test_4");
+  ctx.build_options(old_build_options);
+  std::vector<std::string> files_options = cache_files(path);
+  if (files_options.size() != 2 || std::find(files_options.begin(), files_options.end(), files[0]) == files_options.end())
+  {
+    std::cout << "# Error: Expected a second cache file for different build options, found " << files_options.size() << " files" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!check_kernel(prog_4, 2.0f, 1.0f, "kernel with different build options"))
+    return EXIT_FAILURE;
+
+  //
+  // Kernels are created lazily, unknown names are still reported:
+  //
+  std::cout << "Testing unknown kernel name..." << std::endl;
+  bool thrown = false;
+  try
+  {
+    ctx.get_program("cache_test_2").get_kernel("no_such_kernel");  // references obtained from add_program() are invalidated by later calls
+  }
+  catch (...)
+  {
+    thrown = true;
+  }
+  if (!thrown)
+  {
+    std::cout << "# Error: No exception thrown for unknown kernel name" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ctx.delete_program("cache_test_1");
+  ctx.delete_program("cache_test_2");
+  ctx.delete_program("cache_test_3");
+  ctx.delete_program("cache_test_4");
+  ctx.cache_path(old_cache_path);
+
+  return EXIT_SUCCESS;
+}
+
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: OpenCL Program Binary Cache" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::string path = create_cache_directory();
+  std::cout << "# Cache directory: " << path << std::endl;
+
+  int retval = test(path);
+  remove_cache_directory(path);
+
+  if (retval == EXIT_SUCCESS)
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
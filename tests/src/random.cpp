@@ -0,0 +1,279 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/vector.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/rand/uniform.hpp"
+#include "viennacl/rand/gaussian.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+  #include <omp.h>
+#endif
+
+
+//
+// -------------------------------------------------------------
+//
+/** @brief Checks mean and variance of the samples against the expected values */
+template <typename NumericT>
+bool check_moments(std::vector<NumericT> const & samples, double mean_ref, double variance_ref, std::string const & name)
+{
+  double mean = 0;
+  for (std::size_t i=0; i<samples.size(); ++i)
+    mean += samples[i];
+  mean /= samples.size();
+
+  double variance = 0;
+  for (std::size_t i=0; i<samples.size(); ++i)
+    variance += (samples[i] - mean) * (samples[i] - mean);
+  variance /= samples.size() - 1;
+
+  // standard error of the mean is sqrt(variance / N), i.e. about 0.001 * sqrt(variance) for the sample sizes used here
+  double tol = 5.0 * std::sqrt(variance_ref / samples.size());
+  if (std::fabs(mean - mean_ref) > tol || std::fabs(variance - variance_ref) > 0.01 * variance_ref)
+  {
+    std::cout << "# Error at operation: " << name << std::endl;
+    std::cout << "  mean: " << mean << " (expected " << mean_ref << "), variance: " << variance << " (expected " << variance_ref << ")" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <typename NumericT>
+int test()
+{
+  std::size_t N = 1000000;
+
+  //
+  // Moments of the distributions:
+  //
+  viennacl::vector<NumericT> vcl_uniform = viennacl::random_vector<NumericT>(N, viennacl::rand::uniform_tag(-1, 3, 42));
+  viennacl::vector<NumericT> vcl_gaussian = viennacl::random_vector<NumericT>(N, viennacl::rand::gaussian_tag(1, 2, 42));
+
+  std::vector<NumericT> uniform(N), gaussian(N);
+  viennacl::copy(vcl_uniform, uniform);
+  viennacl::copy(vcl_gaussian, gaussian);
+
+  for (std::size_t i=0; i<N; ++i)
+  {
+    if (uniform[i] < NumericT(-1) || uniform[i] > NumericT(3))
+    {
+      std::cout << "# Error: uniform random value " << uniform[i] << " out of range" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (!check_moments(uniform, 1.0, 16.0 / 12.0, "uniform"))
+    return EXIT_FAILURE;
+
+  //
+  // Upper bound is excluded even if a + (b - a) * u rounds to b:
+  //
+  std::cout << "Testing half-open interval of uniform random values..." << std::endl;
+  unsigned int largest_word[1] = { 0xFFFFFFFFu };  // u = 1 - 2^-24 for float, 1 - 2^-53 for double
+  NumericT largest_values[4];
+  viennacl::linalg::host_based::detail::random_uniform_generator<NumericT> uniform_gen_12(1, 2);
+  uniform_gen_12(largest_word, largest_word, largest_word, largest_word, 1, largest_values);
+  for (std::size_t i=0; i<sizeof(float) * 4 / sizeof(NumericT); ++i)
+  {
+    if (largest_values[i] >= NumericT(2))
+    {
+      std::cout << "# Error: uniform random value for the largest random word is " << largest_values[i] << ", not in [1, 2)" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::vector<NumericT> uniform_12(N);
+  for (unsigned int seed = 0; seed < 16; ++seed)
+  {
+    viennacl::rand::fill(vcl_uniform, viennacl::rand::uniform_tag(1, 2, seed));
+    viennacl::copy(vcl_uniform, uniform_12);
+    for (std::size_t i=0; i<N; ++i)
+    {
+      if (uniform_12[i] < NumericT(1) || uniform_12[i] >= NumericT(2))
+      {
+        std::cout << "# Error: uniform random value " << uniform_12[i] << " not in [1, 2)" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (!check_moments(gaussian, 1.0, 4.0, "gaussian"))
+    return EXIT_FAILURE;
+
+  //
+  // Reproducibility: same seed gives the same values, a different seed gives different values:
+  //
+  std::cout << "Testing reproducibility..." << std::endl;
+  viennacl::vector<NumericT> vcl_gaussian2(N);
+  viennacl::rand::fill(vcl_gaussian2, viennacl::rand::gaussian_tag(1, 2, 42));
+  std::vector<NumericT> gaussian2(N);
+  viennacl::copy(vcl_gaussian2, gaussian2);
+  if (gaussian2 != gaussian)
+  {
+    std::cout << "# Error: Results for identical seeds differ" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  viennacl::rand::fill(vcl_gaussian2, viennacl::rand::gaussian_tag(1, 2, 43));
+  viennacl::copy(vcl_gaussian2, gaussian2);
+  std::size_t num_equal = 0;
+  for (std::size_t i=0; i<N; ++i)
+    num_equal += (gaussian2[i] == gaussian[i]) ? 1 : 0;
+  if (num_equal > N / 1000)
+  {
+    std::cout << "# Error: Results for different seeds agree in " << num_equal << " entries" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+#ifdef VIENNACL_WITH_OPENMP
+  std::cout << "Testing independence of the number of threads..." << std::endl;
+  int num_threads = omp_get_max_threads();
+  omp_set_num_threads(num_threads + 2);
+  viennacl::rand::fill(vcl_gaussian2, viennacl::rand::gaussian_tag(1, 2, 42));
+  omp_set_num_threads(num_threads);
+  viennacl::copy(vcl_gaussian2, gaussian2);
+  if (gaussian2 != gaussian)
+  {
+    std::cout << "# Error: Results depend on the number of threads" << std::endl;
+    return EXIT_FAILURE;
+  }
+#endif
+
+  //
+  // Ranges and slices get the same values as the leading entries of a vector:
+  //
+  std::cout << "Testing vector ranges and slices..." << std::endl;
+  std::size_t M = 1001;
+  viennacl::vector<NumericT> vcl_big(3 * M + 5);
+  viennacl::vector_range<viennacl::vector<NumericT> > vcl_range(vcl_big, viennacl::range(3, 3 + M));
+  viennacl::vector_slice<viennacl::vector<NumericT> > vcl_slice(vcl_big, viennacl::slice(4, 3, M));
+
+  viennacl::rand::fill(vcl_range, viennacl::rand::gaussian_tag(1, 2, 42));
+  for (std::size_t i=0; i<M; ++i)
+  {
+    if (NumericT(vcl_range[i]) != gaussian[i])
+    {
+      std::cout << "# Error: Vector range at entry " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  viennacl::rand::fill(vcl_slice, viennacl::rand::gaussian_tag(1, 2, 42));
+  for (std::size_t i=0; i<M; ++i)
+  {
+    if (NumericT(vcl_slice[i]) != gaussian[i])
+    {
+      std::cout << "# Error: Vector slice at entry " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  //
+  // Matrices are numbered row by row (row-major) or column by column (column-major), irrespective of padding, ranges, and slices:
+  //
+  std::cout << "Testing matrices, matrix ranges, and matrix slices..." << std::endl;
+  std::size_t rows = 37, cols = 29;
+  viennacl::matrix<NumericT, viennacl::row_major>    vcl_A = viennacl::random_matrix<NumericT>(rows, cols, viennacl::rand::uniform_tag(-1, 3, 42));
+  viennacl::matrix<NumericT, viennacl::column_major> vcl_B(2 * rows + 3, 2 * cols + 3);
+  viennacl::matrix_slice<viennacl::matrix<NumericT, viennacl::column_major> > vcl_B_slice(vcl_B, viennacl::slice(1, 2, rows), viennacl::slice(2, 2, cols));
+  viennacl::rand::fill(vcl_B_slice, viennacl::rand::uniform_tag(-1, 3, 42));
+  viennacl::matrix<NumericT, viennacl::row_major>    vcl_C(rows + 10, cols + 10);
+  viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::row_major> > vcl_C_range(vcl_C, viennacl::range(4, 4 + rows), viennacl::range(7, 7 + cols));
+  viennacl::rand::fill(vcl_C_range, viennacl::rand::uniform_tag(-1, 3, 42));
+
+  for (std::size_t i=0; i<rows; ++i)
+    for (std::size_t j=0; j<cols; ++j)
+    {
+      if (NumericT(vcl_A(i, j)) != uniform[i * cols + j] || NumericT(vcl_C_range(i, j)) != uniform[i * cols + j])
+      {
+        std::cout << "# Error: Row-major matrix at entry (" << i << ", " << j << ")" << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (NumericT(vcl_B_slice(i, j)) != uniform[i + j * rows])
+      {
+        std::cout << "# Error: Column-major matrix slice at entry (" << i << ", " << j << ")" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
+
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+   std::cout << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << "## Test :: Random Numbers" << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << std::endl;
+
+   int retval = EXIT_SUCCESS;
+
+   std::cout << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << std::endl;
+   {
+      std::cout << "# Testing setup:" << std::endl;
+      std::cout << "  numeric: float" << std::endl;
+      retval = test<float>();
+      if( retval == EXIT_SUCCESS )
+         std::cout << "# Test passed" << std::endl;
+      else
+         return retval;
+   }
+   std::cout << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << std::endl;
+#ifdef VIENNACL_WITH_OPENCL
+   if( viennacl::ocl::current_device().double_support() )
+#endif
+   {
+      std::cout << "# Testing setup:" << std::endl;
+      std::cout << "  numeric: double" << std::endl;
+      retval = test<double>();
+      if( retval == EXIT_SUCCESS )
+         std::cout << "# Test passed" << std::endl;
+      else
+         return retval;
+   }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+
+   return retval;
+}
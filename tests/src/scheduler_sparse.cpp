@@ -46,6 +46,7 @@
 #include "viennacl/coordinate_matrix.hpp"
 #include "viennacl/ell_matrix.hpp"
 #include "viennacl/hyb_matrix.hpp"
+#include "viennacl/sliced_ell_matrix.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/vector_proxy.hpp"
 #include "viennacl/linalg/prod.hpp"
@@ -210,6 +211,7 @@ int test(Epsilon const& epsilon)
   viennacl::coordinate_matrix<NumericT> vcl_coordinate_matrix(rhs.size(), rhs.size());
   viennacl::ell_matrix<NumericT> vcl_ell_matrix;
   viennacl::hyb_matrix<NumericT> vcl_hyb_matrix;
+  viennacl::sliced_ell_matrix<NumericT> vcl_sliced_ell_matrix;
 
   viennacl::copy(rhs.begin(), rhs.end(), vcl_rhs.begin());
   viennacl::copy(ublas_matrix, vcl_compressed_matrix);
@@ -305,6 +307,28 @@ int test(Epsilon const& epsilon)
     retval = EXIT_FAILURE;
   }
 
+  //std::cout << "Copying sliced_ell_matrix" << std::endl;
+  viennacl::copy(ublas_matrix, vcl_sliced_ell_matrix);
+  ublas_matrix.clear();
+  viennacl::copy(vcl_sliced_ell_matrix, ublas_matrix);// just to check that it's works
+  viennacl::copy(ublas_matrix, vcl_sliced_ell_matrix);
+
+  std::cout << "Testing products: sliced_ell_matrix" << std::endl;
+  rhs *= NumericT(1.1);
+  vcl_rhs *= NumericT(1.1);
+  result     = viennacl::linalg::prod(ublas_matrix, rhs);
+  {
+  viennacl::scheduler::statement my_statement(vcl_result, viennacl::op_assign(), viennacl::linalg::prod(vcl_sliced_ell_matrix, vcl_rhs));
+  viennacl::scheduler::execute(my_statement);
+  }
+
+  if( std::fabs(diff(result, vcl_result)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product with sliced_ell_matrix" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
 
   // --------------------------------------------------------------------------
   // --------------------------------------------------------------------------
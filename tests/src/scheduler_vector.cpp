@@ -27,6 +27,7 @@
 #include <boost/numeric/ublas/io.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/vector_proxy.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
 
 //
 // *** ViennaCL
@@ -40,8 +41,10 @@
 #include "viennacl/linalg/norm_1.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/norm_inf.hpp"
+#include "viennacl/linalg/prod.hpp"
 
 #include "viennacl/scheduler/execute.hpp"
+#include "viennacl/scheduler/statement_list.hpp"
 #include "viennacl/scheduler/io.hpp"
 
 #include "Random.hpp"
@@ -476,6 +479,32 @@ int test(Epsilon const& epsilon,
     return EXIT_FAILURE;
   }
 
+  std::cout << "--- Testing statement lists ---" << std::endl;
+  std::cout << "s1 = <x, y>; s2 = <x, x>; y = y - alpha * x; s3 = <y, y>..." << std::endl;
+  {
+  NumericT cpu_s1 = inner_prod(ublas_v1, ublas_v2);
+  NumericT cpu_s2 = inner_prod(ublas_v1, ublas_v1);
+  ublas_v2 = ublas_v2 - alpha * ublas_v1;
+  NumericT cpu_s3 = inner_prod(ublas_v2, ublas_v2);
+
+  viennacl::scalar<NumericT> gpu_s1(0), gpu_s2(0), gpu_s3(0);
+  viennacl::scheduler::statement_list my_statements;
+  my_statements.add(viennacl::scheduler::statement(gpu_s1, viennacl::op_assign(), viennacl::linalg::inner_prod(vcl_v1, vcl_v2)));
+  my_statements.add(viennacl::scheduler::statement(gpu_s2, viennacl::op_assign(), viennacl::linalg::inner_prod(vcl_v1, vcl_v1)));
+  my_statements.add(viennacl::scheduler::statement(vcl_v2, viennacl::op_assign(), vcl_v2 - alpha * vcl_v1));
+  my_statements.add(viennacl::scheduler::statement(gpu_s3, viennacl::op_assign(), viennacl::linalg::inner_prod(vcl_v2, vcl_v2)));
+  viennacl::scheduler::execute(my_statements);
+
+  if (check(cpu_s1, gpu_s1, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check(cpu_s2, gpu_s2, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check(cpu_s3, gpu_s3, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check(ublas_v2, vcl_v2, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  }
+
 
   // --------------------------------------------------------------------------
   return retval;
@@ -633,6 +662,144 @@ int test(Epsilon const& epsilon)
 }
 
 
+/** @brief Statement lists with float statements using the results of double statements and vice versa */
+int test_mixed_statement_list(float epsilon)
+{
+  std::size_t size = 1000;
+
+  ublas::vector<double> ublas_xd(size), ublas_yd(size);
+  ublas::vector<float>  ublas_xf(size), ublas_yf(size), ublas_zf(size);
+  for (std::size_t i=0; i<size; ++i)
+  {
+    ublas_xd[i] = 1.0 + random<double>();
+    ublas_yd[i] = 1.0 + random<double>();
+    ublas_yf[i] = 1.0f + random<float>();
+    ublas_zf[i] = 1.0f + random<float>();
+  }
+
+  viennacl::vector<double> vcl_xd(size), vcl_yd(size);
+  viennacl::vector<float>  vcl_xf(size), vcl_yf(size), vcl_zf(size);
+  viennacl::copy(ublas_xd, vcl_xd);
+  viennacl::copy(ublas_yd, vcl_yd);
+  viennacl::copy(ublas_yf, vcl_yf);
+  viennacl::copy(ublas_zf, vcl_zf);
+
+  std::cout << "sd = <xd, yd>; xf = yf * sd + element_prod(zf, yf); sf = <xf, zf>; yd = yd - sd * xd..." << std::endl;
+
+  double cpu_sd = inner_prod(ublas_xd, ublas_yd);
+  for (std::size_t i=0; i<size; ++i)
+    ublas_xf[i] = ublas_yf[i] * static_cast<float>(cpu_sd) + ublas_zf[i] * ublas_yf[i];
+  float cpu_sf = inner_prod(ublas_xf, ublas_zf);
+  ublas_yd = ublas_yd - cpu_sd * ublas_xd;
+
+  viennacl::scalar<double> gpu_sd(0);
+  viennacl::scalar<float>  gpu_sf(0);
+  viennacl::scheduler::statement_list my_statements;
+  my_statements.add(viennacl::scheduler::statement(gpu_sd, viennacl::op_assign(), viennacl::linalg::inner_prod(vcl_xd, vcl_yd)));
+  my_statements.add(viennacl::scheduler::statement(vcl_xf, viennacl::op_assign(), vcl_yf * gpu_sd + viennacl::linalg::element_prod(vcl_zf, vcl_yf)));
+  my_statements.add(viennacl::scheduler::statement(gpu_sf, viennacl::op_assign(), viennacl::linalg::inner_prod(vcl_xf, vcl_zf)));
+  my_statements.add(viennacl::scheduler::statement(vcl_yd, viennacl::op_assign(), vcl_yd - gpu_sd * vcl_xd));
+  viennacl::scheduler::execute(my_statements);
+
+  if (check(cpu_sd, gpu_sd, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check(ublas_xf, vcl_xf, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check(cpu_sf, gpu_sf, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check(ublas_yd, vcl_yd, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Statement lists with levels of several independent statements, which are executed concurrently if OpenMP is enabled, including a failing statement */
+int test_statement_list_levels(double epsilon)
+{
+  std::size_t size = 60;
+  std::size_t num_products = 3;
+
+  ublas::matrix<double> ublas_A(size, size);
+  for (std::size_t i=0; i<size; ++i)
+    for (std::size_t j=0; j<size; ++j)
+      ublas_A(i,j) = random<double>();
+  viennacl::matrix<double> vcl_A(size, size);
+  viennacl::copy(ublas_A, vcl_A);
+
+  std::vector<ublas::vector<double> >    ublas_x(num_products, ublas::vector<double>(size));
+  std::vector<ublas::vector<double> >    ublas_y(num_products, ublas::vector<double>(size));
+  std::vector<viennacl::vector<double> > vcl_x(num_products, viennacl::vector<double>(size));
+  std::vector<viennacl::vector<double> > vcl_y(num_products, viennacl::vector<double>(size));
+  for (std::size_t k=0; k<num_products; ++k)
+  {
+    for (std::size_t i=0; i<size; ++i)
+    {
+      ublas_x[k][i] = 1.0 + random<double>();
+      ublas_y[k][i] = 1.0 + random<double>();
+    }
+    viennacl::copy(ublas_x[k], vcl_x[k]);
+    viennacl::copy(ublas_y[k], vcl_y[k]);
+  }
+
+  std::cout << "x_k += prod(A, y_k) for independent x_k, y_k..." << std::endl;
+  {
+  viennacl::scheduler::statement_list my_statements;
+  for (std::size_t k=0; k<num_products; ++k)
+  {
+    ublas_x[k] += ublas::prod(ublas_A, ublas_y[k]);
+    my_statements.add(viennacl::scheduler::statement(vcl_x[k], viennacl::op_inplace_add(), viennacl::linalg::prod(vcl_A, vcl_y[k])));
+  }
+  viennacl::scheduler::execute(my_statements);
+
+  if (my_statements.schedule().size() != 1 || my_statements.schedule()[0].size() != num_products)
+  {
+    std::cout << "# Error! Independent statements not executed in a single level" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (std::size_t k=0; k<num_products; ++k)
+    if (check(ublas_x[k], vcl_x[k], epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "x_k += prod(A, y_k) with a failing statement in the same level..." << std::endl;
+  {
+  viennacl::scalar<float> gpu_sf(2.0f);
+  viennacl::scheduler::statement_list my_statements;
+  for (std::size_t k=0; k<num_products; ++k)
+  {
+    if (k + 1 < num_products)
+    {
+      ublas_x[k] += ublas::prod(ublas_A, ublas_y[k]);
+      my_statements.add(viennacl::scheduler::statement(vcl_x[k], viennacl::op_inplace_add(), viennacl::linalg::prod(vcl_A, vcl_y[k])));
+    }
+    else // mixing double vectors with float scalars is not supported by the scheduler:
+      my_statements.add(viennacl::scheduler::statement(vcl_x[k], viennacl::op_inplace_add(), viennacl::linalg::prod(vcl_A, vcl_y[k]) - gpu_sf * vcl_y[k]));
+  }
+
+  bool thrown = false;
+  try
+  {
+    viennacl::scheduler::execute(my_statements);
+  }
+  catch (viennacl::scheduler::statement_not_supported_exception const &)
+  {
+    thrown = true;
+  }
+
+  if (!thrown)
+  {
+    std::cout << "# Error! Exception of failing statement not propagated" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (std::size_t k=0; k<num_products; ++k)
+    if (check(ublas_x[k], vcl_x[k], epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
 
 //
 // -------------------------------------------------------------
@@ -686,6 +853,21 @@ int main()
       std::cout << std::endl;
       std::cout << "----------------------------------------------" << std::endl;
       std::cout << std::endl;
+
+      {
+         std::cout << "# Testing setup:" << std::endl;
+         std::cout << "  numeric: float and double" << std::endl;
+         retval = test_mixed_statement_list(1.0E-4f);
+         if( retval == EXIT_SUCCESS )
+           retval = test_statement_list_levels(1.0E-12);
+         if( retval == EXIT_SUCCESS )
+           std::cout << "# Test passed" << std::endl;
+         else
+           return retval;
+      }
+      std::cout << std::endl;
+      std::cout << "----------------------------------------------" << std::endl;
+      std::cout << std::endl;
    }
 
   std::cout << std::endl;
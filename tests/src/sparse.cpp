@@ -23,6 +23,8 @@
 // *** System
 //
 #include <iostream>
+#include <vector>
+#include <map>
 
 //
 // *** Boost
@@ -47,6 +49,7 @@
 #include "viennacl/coordinate_matrix.hpp"
 #include "viennacl/ell_matrix.hpp"
 #include "viennacl/hyb_matrix.hpp"
+#include "viennacl/sliced_ell_matrix.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/vector_proxy.hpp"
 #include "viennacl/linalg/prod.hpp"
@@ -216,6 +219,309 @@ int strided_matrix_vector_product_test(Epsilon epsilon,
 }
 
 
+template <typename NumericT, typename VCL_MatrixT, typename Epsilon>
+int irregular_matrix_vector_product_test(Epsilon epsilon, std::size_t long_row_nnz)
+{
+    int retval = EXIT_SUCCESS;
+
+    // rows with very different numbers of nonzeros, including a few rows with at least long_row_nnz nonzeros:
+    std::size_t N = 20000;
+    ublas::compressed_matrix<NumericT> ublas_matrix(N, N);
+    for (std::size_t i=0; i<N; ++i)
+    {
+      std::size_t row_nnz = (i % 1000 == 7) ? long_row_nnz + i / 1000 : i % 13;
+      for (std::size_t k=0; k<row_nnz; ++k)
+        ublas_matrix(i, (i + 7 * k) % N) = NumericT(1) + random<NumericT>();
+    }
+
+    ublas::vector<NumericT> rhs(N);
+    for (std::size_t i=0; i<N; ++i)
+      rhs[i] = NumericT(1) + random<NumericT>();
+    ublas::vector<NumericT> result = ublas::prod(ublas_matrix, rhs);
+
+    VCL_MatrixT vcl_matrix;
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    viennacl::vector<NumericT> vcl_rhs(N);
+    viennacl::vector<NumericT> vcl_result(N);
+    viennacl::copy(rhs, vcl_rhs);
+
+    vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_rhs);
+
+    if( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product with irregular number of nonzeros per row" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // strided vectors:
+    viennacl::vector<NumericT> vcl_rhs2(2 * N);
+    viennacl::vector<NumericT> vcl_result2(3 * N);
+    viennacl::project(vcl_rhs2, viennacl::slice(1, 2, N)) = vcl_rhs;
+    viennacl::project(vcl_result2, viennacl::slice(2, 3, N)) = viennacl::linalg::prod(vcl_matrix, viennacl::project(vcl_rhs2, viennacl::slice(1, 2, N)));
+    vcl_result = viennacl::project(vcl_result2, viennacl::slice(2, 3, N));
+
+    if( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product with irregular number of nonzeros per row, strided vectors" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // products with a matrix which is overwritten by another sparsity pattern:
+    ublas::compressed_matrix<NumericT> ublas_matrix2(N, N);
+    for (std::size_t i=0; i<N; ++i)
+      ublas_matrix2(i, N - i - 1) = NumericT(2);
+    result = ublas::prod(ublas_matrix2, rhs);
+
+    viennacl::copy(ublas_matrix2, vcl_matrix);
+    vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_rhs);
+
+    if( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product after changing the sparsity pattern" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    return retval;
+}
+
+
+template <typename NumericT, typename SolverTag>
+NumericT level_scheduled_solve_diff(std::vector<unsigned int> const & row_buffer,
+                                    std::vector<unsigned int> const & col_buffer,
+                                    std::vector<NumericT> const & elements,
+                                    std::vector<NumericT> const & rhs,
+                                    bool transposed, SolverTag tag)
+{
+    std::size_t N = rhs.size();
+    std::vector<NumericT> result(rhs);
+    std::vector<NumericT> result_levels(rhs);
+
+    if (transposed)
+      viennacl::linalg::host_based::detail::csr_trans_inplace_solve<NumericT>(row_buffer, col_buffer, elements, result, N, tag);
+    else
+      viennacl::linalg::host_based::detail::csr_inplace_solve<NumericT>(row_buffer, col_buffer, elements, result, N, tag);
+
+    viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> schedule;
+    viennacl::linalg::host_based::detail::csr_level_schedule_setup(row_buffer, col_buffer, elements, N, schedule, transposed, tag);
+    viennacl::linalg::host_based::detail::csr_level_scheduled_inplace_solve(schedule, result_levels);
+
+    NumericT error = 0;
+    for (std::size_t i=0; i<N; ++i)
+      error = std::max<NumericT>(error, std::fabs(result[i] - result_levels[i]) / std::max<NumericT>(std::fabs(result[i]), NumericT(1)));
+    return error;
+}
+
+template <typename NumericT, typename Epsilon>
+int level_scheduled_solve_test(Epsilon epsilon)
+{
+    int retval = EXIT_SUCCESS;
+
+    // diagonally dominant matrix with entries on both sides of the diagonal, so that each triangular part has many levels of different sizes:
+    std::size_t N = 20000;
+    ublas::compressed_matrix<NumericT> ublas_matrix(N, N);
+    std::vector<unsigned int> row_buffer(N + 1);
+    std::vector<unsigned int> col_buffer;
+    std::vector<NumericT> elements;
+    for (std::size_t i=0; i<N; ++i)
+    {
+      std::map<unsigned int, NumericT> row;
+      row[static_cast<unsigned int>(i)] = NumericT(4) + random<NumericT>();
+      if (i > 0)
+        row[static_cast<unsigned int>(i-1)] = NumericT(-0.5);
+      for (std::size_t k=1; k<=i%5; ++k)
+        row[static_cast<unsigned int>((i * 31 + 97 * k) % N)] = NumericT(0.1) * random<NumericT>();
+
+      for (typename std::map<unsigned int, NumericT>::const_iterator it = row.begin(); it != row.end(); ++it)
+      {
+        ublas_matrix(i, it->first) = it->second;
+        col_buffer.push_back(it->first);
+        elements.push_back(it->second);
+      }
+      row_buffer[i+1] = static_cast<unsigned int>(col_buffer.size());
+    }
+
+    std::vector<NumericT> rhs(N);
+    for (std::size_t i=0; i<N; ++i)
+      rhs[i] = NumericT(1) + random<NumericT>();
+
+    for (int transposed = 0; transposed < 2; ++transposed)
+    {
+      NumericT error = std::max(std::max(level_scheduled_solve_diff(row_buffer, col_buffer, elements, rhs, transposed != 0, viennacl::linalg::lower_tag()),
+                                         level_scheduled_solve_diff(row_buffer, col_buffer, elements, rhs, transposed != 0, viennacl::linalg::unit_lower_tag())),
+                                std::max(level_scheduled_solve_diff(row_buffer, col_buffer, elements, rhs, transposed != 0, viennacl::linalg::upper_tag()),
+                                         level_scheduled_solve_diff(row_buffer, col_buffer, elements, rhs, transposed != 0, viennacl::linalg::unit_upper_tag())));
+      if (error > epsilon)
+      {
+        std::cout << "# Error at operation: level-scheduled triangular solve" << (transposed ? " (transposed)" : "") << std::endl;
+        std::cout << "  diff: " << error << std::endl;
+        retval = EXIT_FAILURE;
+      }
+    }
+
+    // ILU0 and ILUT preconditioners with and without level scheduling:
+    viennacl::compressed_matrix<NumericT> vcl_matrix;
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    viennacl::vector<NumericT> vcl_vec(N);
+    viennacl::vector<NumericT> vcl_vec_levels(N);
+    viennacl::copy(rhs.begin(), rhs.end(), vcl_vec.begin());
+    vcl_vec_levels = vcl_vec;
+
+    viennacl::linalg::ilu0_tag ilu0_config;
+    viennacl::linalg::ilu0_tag ilu0_levels_config(true);
+    viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > vcl_ilu0(vcl_matrix, ilu0_config);
+    viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > vcl_ilu0_levels(vcl_matrix, ilu0_levels_config);
+    vcl_ilu0.apply(vcl_vec);
+    vcl_ilu0_levels.apply(vcl_vec_levels);
+
+    ublas::vector<NumericT> result(N);
+    viennacl::copy(vcl_vec, result);
+    if( std::fabs(diff(result, vcl_vec_levels)) > epsilon )
+    {
+      std::cout << "# Error at operation: ILU0 with level scheduling" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_vec_levels)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+#ifdef VIENNACL_WITH_OPENCL
+    // system matrix on the host, vector on the device:
+    {
+      viennacl::compressed_matrix<NumericT> host_matrix(N, N, viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::copy(ublas_matrix, host_matrix);
+      viennacl::copy(rhs.begin(), rhs.end(), vcl_vec_levels.begin());
+
+      viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > host_ilu0_levels(host_matrix, ilu0_levels_config);
+      host_ilu0_levels.apply(vcl_vec_levels);
+      if( std::fabs(diff(result, vcl_vec_levels)) > epsilon )
+      {
+        std::cout << "# Error at operation: ILU0 with level scheduling on the host applied to a device vector" << std::endl;
+        std::cout << "  diff: " << std::fabs(diff(result, vcl_vec_levels)) << std::endl;
+        retval = EXIT_FAILURE;
+      }
+
+      viennacl::linalg::ilut_tag host_ilut_config;
+      viennacl::linalg::ilut_tag host_ilut_levels_config(20, 1e-4, true);
+      viennacl::linalg::ilut_precond< viennacl::compressed_matrix<NumericT> > vcl_ilut(vcl_matrix, host_ilut_config);
+      viennacl::linalg::ilut_precond< viennacl::compressed_matrix<NumericT> > host_ilut_levels(host_matrix, host_ilut_levels_config);
+      viennacl::copy(rhs.begin(), rhs.end(), vcl_vec.begin());
+      viennacl::copy(rhs.begin(), rhs.end(), vcl_vec_levels.begin());
+      vcl_ilut.apply(vcl_vec);
+      host_ilut_levels.apply(vcl_vec_levels);
+      ublas::vector<NumericT> ilut_result(N);
+      viennacl::copy(vcl_vec, ilut_result);
+      if( std::fabs(diff(ilut_result, vcl_vec_levels)) > epsilon )
+      {
+        std::cout << "# Error at operation: ILUT with level scheduling on the host applied to a device vector" << std::endl;
+        std::cout << "  diff: " << std::fabs(diff(ilut_result, vcl_vec_levels)) << std::endl;
+        retval = EXIT_FAILURE;
+      }
+    }
+#endif
+
+    viennacl::linalg::ilut_tag ilut_config;
+    viennacl::linalg::ilut_tag ilut_levels_config(20, 1e-4, true);
+    viennacl::linalg::ilut_precond< ublas::compressed_matrix<NumericT> > ublas_ilut(ublas_matrix, ilut_config);
+    viennacl::linalg::ilut_precond< ublas::compressed_matrix<NumericT> > ublas_ilut_levels(ublas_matrix, ilut_levels_config);
+    ublas::vector<NumericT> ublas_vec(N);
+    std::copy(rhs.begin(), rhs.end(), ublas_vec.begin());
+    ublas_ilut.apply(ublas_vec);
+    result = ublas_vec;
+    std::copy(rhs.begin(), rhs.end(), ublas_vec.begin());
+    ublas_ilut_levels.apply(ublas_vec);
+    viennacl::copy(ublas_vec, vcl_vec_levels);
+    if( std::fabs(diff(result, vcl_vec_levels)) > epsilon )
+    {
+      std::cout << "# Error at operation: ILUT with level scheduling" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_vec_levels)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    return retval;
+}
+
+
+template <typename NumericT, typename Epsilon>
+int ilu_exact_factorization_test(Epsilon epsilon)
+{
+    int retval = EXIT_SUCCESS;
+
+    // entries at distances 0, s, and 2s from the diagonal only. The sparsity pattern is closed under elimination,
+    // so ILU0 and ILUT without dropping compute the exact LU factorization and the preconditioners solve the system:
+    std::size_t N = 20000;
+    std::size_t s = 100;
+    ublas::compressed_matrix<NumericT> ublas_matrix(N, N);
+    for (std::size_t i=0; i<N; ++i)
+    {
+      ublas_matrix(i, i) = NumericT(6) + random<NumericT>();
+      for (std::size_t k=1; k<=2; ++k)
+      {
+        if (i >= k*s)
+          ublas_matrix(i, i - k*s) = -random<NumericT>();
+        if (i + k*s < N)
+          ublas_matrix(i, i + k*s) = -random<NumericT>();
+      }
+    }
+
+    ublas::vector<NumericT> ublas_x(N);
+    for (std::size_t i=0; i<N; ++i)
+      ublas_x[i] = NumericT(1) + random<NumericT>();
+    ublas::vector<NumericT> ublas_rhs = ublas::prod(ublas_matrix, ublas_x);
+
+    viennacl::compressed_matrix<NumericT> vcl_matrix;
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    viennacl::vector<NumericT> vcl_vec(N);
+
+    viennacl::linalg::ilu0_tag ilu0_config;
+    viennacl::linalg::ilu0_tag ilu0_levels_config(true);
+    viennacl::linalg::ilut_tag ilut_config(2, 0);  // keeps all entries of the exact factors
+
+    viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > vcl_ilu0(vcl_matrix, ilu0_config);
+    viennacl::copy(ublas_rhs, vcl_vec);
+    vcl_ilu0.apply(vcl_vec);
+    if( std::fabs(diff(ublas_x, vcl_vec)) > epsilon )
+    {
+      std::cout << "# Error at operation: exact ILU0 factorization" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(ublas_x, vcl_vec)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > vcl_ilu0_levels(vcl_matrix, ilu0_levels_config);
+    viennacl::copy(ublas_rhs, vcl_vec);
+    vcl_ilu0_levels.apply(vcl_vec);
+    if( std::fabs(diff(ublas_x, vcl_vec)) > epsilon )
+    {
+      std::cout << "# Error at operation: exact ILU0 factorization with level scheduling" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(ublas_x, vcl_vec)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    viennacl::linalg::ilut_precond< viennacl::compressed_matrix<NumericT> > vcl_ilut(vcl_matrix, ilut_config);
+    viennacl::copy(ublas_rhs, vcl_vec);
+    vcl_ilut.apply(vcl_vec);
+    if( std::fabs(diff(ublas_x, vcl_vec)) > epsilon )
+    {
+      std::cout << "# Error at operation: exact ILUT factorization" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(ublas_x, vcl_vec)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    viennacl::linalg::ilut_precond< ublas::compressed_matrix<NumericT> > ublas_ilut(ublas_matrix, ilut_config);
+    ublas::vector<NumericT> ublas_vec = ublas_rhs;
+    ublas_ilut.apply(ublas_vec);
+    viennacl::copy(ublas_vec, vcl_vec);
+    if( std::fabs(diff(ublas_x, vcl_vec)) > epsilon )
+    {
+      std::cout << "# Error at operation: exact ILUT factorization (ublas)" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(ublas_x, vcl_vec)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    return retval;
+}
+
+
 template< typename NumericT, typename VCL_MATRIX, typename Epsilon >
 int resize_test(Epsilon const& epsilon)
 {
@@ -387,6 +693,34 @@ int test(Epsilon const& epsilon)
 {
   std::cout << "Testing resizing of compressed_matrix..." << std::endl;
   int retval = resize_test<NumericT, viennacl::compressed_matrix<NumericT> >(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing products with irregular number of nonzeros per row: compressed_matrix" << std::endl;
+  retval = irregular_matrix_vector_product_test<NumericT, viennacl::compressed_matrix<NumericT> >(epsilon, 10000);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing products with irregular number of nonzeros per row: coordinate_matrix" << std::endl;
+  retval = irregular_matrix_vector_product_test<NumericT, viennacl::coordinate_matrix<NumericT> >(epsilon, 10000);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing products with irregular number of nonzeros per row: ell_matrix" << std::endl;
+  retval = irregular_matrix_vector_product_test<NumericT, viennacl::ell_matrix<NumericT> >(epsilon, 100);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing products with irregular number of nonzeros per row: hyb_matrix" << std::endl;
+  retval = irregular_matrix_vector_product_test<NumericT, viennacl::hyb_matrix<NumericT> >(epsilon, 100);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing products with irregular number of nonzeros per row: sliced_ell_matrix" << std::endl;
+  retval = irregular_matrix_vector_product_test<NumericT, viennacl::sliced_ell_matrix<NumericT> >(epsilon, 100);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing level-scheduled triangular solves and ILU preconditioners" << std::endl;
+  retval = level_scheduled_solve_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing ILU0 and ILUT factorizations without dropping" << std::endl;
+  retval = ilu_exact_factorization_test<NumericT>(epsilon);
   if (retval != EXIT_SUCCESS)
     return retval;
   std::cout << "Testing resizing of coordinate_matrix..." << std::endl;
@@ -442,6 +776,7 @@ int test(Epsilon const& epsilon)
   viennacl::coordinate_matrix<NumericT> vcl_coordinate_matrix(rhs.size(), rhs.size());
   viennacl::ell_matrix<NumericT> vcl_ell_matrix;
   viennacl::hyb_matrix<NumericT> vcl_hyb_matrix;
+  viennacl::sliced_ell_matrix<NumericT> vcl_sliced_ell_matrix;
 
   viennacl::copy(rhs.begin(), rhs.end(), vcl_rhs.begin());
   viennacl::copy(ublas_matrix, vcl_compressed_matrix);
@@ -768,6 +1103,30 @@ int test(Epsilon const& epsilon)
     return retval;
 
 
+  //std::cout << "Copying sliced_ell_matrix" << std::endl;
+  viennacl::copy(ublas_matrix, vcl_sliced_ell_matrix);
+  ublas_matrix.clear();
+  viennacl::copy(vcl_sliced_ell_matrix, ublas_matrix);// just to check that it's works
+  viennacl::copy(ublas_matrix, vcl_sliced_ell_matrix);
+
+  std::cout << "Testing products: sliced_ell_matrix" << std::endl;
+  result     = viennacl::linalg::prod(ublas_matrix, rhs);
+  vcl_result.clear();
+  vcl_result = viennacl::linalg::prod(vcl_sliced_ell_matrix, vcl_rhs);
+
+  if( std::fabs(diff(result, vcl_result)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product with sliced_ell_matrix" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  std::cout << "Testing products: sliced_ell_matrix, strided vectors" << std::endl;
+  retval = strided_matrix_vector_product_test<NumericT, viennacl::sliced_ell_matrix<NumericT> >(epsilon, result, rhs, vcl_result, vcl_rhs);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
+
   // --------------------------------------------------------------------------
   // --------------------------------------------------------------------------
   NumericT alpha = static_cast<NumericT>(2.786);
@@ -818,6 +1177,16 @@ int test(Epsilon const& epsilon)
     retval = EXIT_FAILURE;
   }
 
+  vcl_result2.clear();
+  vcl_result2 = alpha * viennacl::linalg::prod(vcl_sliced_ell_matrix, vcl_rhs) + beta * vcl_result;
+
+  if( std::fabs(diff(result, vcl_result2)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product (sliced_ell_matrix) with scaled additions" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result2)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
 
   // --------------------------------------------------------------------------
   return retval;
@@ -35,6 +35,7 @@
 #include "viennacl/coordinate_matrix.hpp"
 #include "viennacl/ell_matrix.hpp"
 #include "viennacl/hyb_matrix.hpp"
+#include "viennacl/sliced_ell_matrix.hpp"
 #include "viennacl/linalg/prod.hpp"       //generic matrix-vector product
 #include "viennacl/linalg/norm_2.hpp"     //generic l2-norm for vectors
 #include "viennacl/linalg/lu.hpp"         //LU substitution routines
@@ -78,6 +79,7 @@ int main()
   ublas::compressed_matrix<ScalarType> ublas_lhs(size/2, size);
   viennacl::compressed_matrix<ScalarType> compressed_lhs(size/2, size);
   viennacl::ell_matrix<ScalarType> ell_lhs;
+  viennacl::sliced_ell_matrix<ScalarType> sliced_ell_lhs;
   viennacl::coordinate_matrix<ScalarType> coo_lhs;
 
   ublas::matrix<ScalarType> ublas_rhs1(size, size/2);
@@ -106,6 +108,7 @@ int main()
 
   viennacl::copy( ublas_lhs, compressed_lhs);
   viennacl::copy( ublas_lhs, ell_lhs);
+  viennacl::copy( ublas_lhs, sliced_ell_lhs);
   viennacl::copy( ublas_lhs, coo_lhs);
 
   size1 = size;
@@ -139,6 +142,16 @@ int main()
   check_matrices(ublas_result, temp);
 
   /******************************************************************/
+  std::cout << "Testing compressed(sliced ELL) lhs * dense rhs" << std::endl;
+  result.clear();
+  result = viennacl::linalg::prod( sliced_ell_lhs, rhs1);
+
+  temp.clear();
+  viennacl::copy( result, temp);
+  if (check_matrices(ublas_result, temp) != EXIT_SUCCESS)
+    retVal = EXIT_FAILURE;
+
+  /******************************************************************/
 
 //  std::cout << "Testing compressed(COO) lhs * dense rhs" << std::endl;
 //  result.clear();
@@ -171,6 +184,16 @@ int main()
   viennacl::copy( result, temp);
   check_matrices(ublas_result, temp);
 
+  /******************************************************************/
+  std::cout << "Testing compressed(sliced ELL) lhs * transposed dense rhs" << std::endl;
+  result.clear();
+  result = viennacl::linalg::prod( sliced_ell_lhs, viennacl::trans(rhs2));
+
+  temp.clear();
+  viennacl::copy( result, temp);
+  if (check_matrices(ublas_result, temp) != EXIT_SUCCESS)
+    retVal = EXIT_FAILURE;
+
   /******************************************************************/
 //  std::cout << "Testing compressed(COO) lhs * transposed dense rhs" << std::endl;
 //  result.clear();
@@ -29,6 +29,7 @@
 #include "viennacl/circulant_matrix.hpp"
 #include "viennacl/vandermonde_matrix.hpp"
 #include "viennacl/hankel_matrix.hpp"
+#include "viennacl/matrix.hpp"
 #include "viennacl/linalg/prod.hpp"
 
 #include "viennacl/fft.hpp"
@@ -138,6 +139,60 @@ ScalarType diff_max(std::vector<ScalarType>& vec, std::vector<ScalarType>& ref)
 }
 
 
+/** @brief Compares each column of the product of a structured matrix with a dense matrix to the matrix-vector product with that column */
+template <typename F, typename StructuredMatrixType, typename ScalarType>
+int batched_prod_test(StructuredMatrixType const & vcl_mat, ScalarType epsilon)
+{
+    std::size_t num_cols = 5;  // odd, so that one column is left over after transforming columns in pairs
+
+    std::vector<std::vector<ScalarType> > input_ref(vcl_mat.size2(), std::vector<ScalarType>(num_cols));
+    for (std::size_t i = 0; i < input_ref.size(); i++)
+      for (std::size_t j = 0; j < num_cols; j++)
+        input_ref[i][j] = ScalarType(i % 11) - ScalarType(j * j) / ScalarType(3);
+
+    viennacl::matrix<ScalarType, F> vcl_input(vcl_mat.size2(), num_cols);
+    viennacl::matrix<ScalarType, F> vcl_result(vcl_mat.size1(), num_cols);
+    viennacl::copy(input_ref, vcl_input);
+
+    vcl_result = viennacl::linalg::prod(vcl_mat, vcl_input);
+
+    std::vector<std::vector<ScalarType> > result(vcl_mat.size1(), std::vector<ScalarType>(num_cols));
+    viennacl::copy(vcl_result, result);
+
+    ScalarType max_diff = 0;
+    for (std::size_t j = 0; j < num_cols; j++)
+    {
+      std::vector<ScalarType> column(vcl_mat.size2());
+      for (std::size_t i = 0; i < column.size(); i++)
+        column[i] = input_ref[i][j];
+
+      viennacl::vector<ScalarType> vcl_column(column.size());
+      viennacl::vector<ScalarType> vcl_column_result(vcl_mat.size1());
+      viennacl::copy(column, vcl_column);
+      vcl_column_result = viennacl::linalg::prod(vcl_mat, vcl_column);
+
+      std::vector<ScalarType> column_ref(vcl_mat.size1());
+      std::vector<ScalarType> column_result(vcl_mat.size1());
+      viennacl::copy(vcl_column_result, column_ref);
+      for (std::size_t i = 0; i < column_result.size(); i++)
+        column_result[i] = result[i][j];
+
+      max_diff = std::max<ScalarType>(max_diff, diff_max(column_result, column_ref));
+    }
+
+    std::cout << "Matrix-Matrix Product (" << (viennacl::is_row_major<F>::value ? "row" : "column") << "-major): " << max_diff;
+    if (max_diff < epsilon)
+      std::cout << " [OK]" << std::endl;
+    else
+    {
+      std::cout << " [FAILED]" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
 template <typename ScalarType>
 void transpose_test()
 {
@@ -215,6 +270,14 @@ int toeplitz_test(ScalarType epsilon)
       return EXIT_FAILURE;
     }
 
+    //
+    // Matrix-Matrix product:
+    //
+    if (batched_prod_test<viennacl::row_major>(vcl_toeplitz1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (batched_prod_test<viennacl::column_major>(vcl_toeplitz1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
 
     //
     // Matrix addition:
@@ -316,6 +379,14 @@ int circulant_test(ScalarType epsilon)
       return EXIT_FAILURE;
     }
 
+    //
+    // Matrix-Matrix product:
+    //
+    if (batched_prod_test<viennacl::row_major>(vcl_circulant1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (batched_prod_test<viennacl::column_major>(vcl_circulant1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
 
     //
     // Matrix addition:
@@ -419,6 +490,14 @@ int vandermonde_test(ScalarType epsilon)
       return EXIT_FAILURE;
     }
 
+    //
+    // Matrix-Matrix product:
+    //
+    if (batched_prod_test<viennacl::row_major>(vcl_vandermonde1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (batched_prod_test<viennacl::column_major>(vcl_vandermonde1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
 
     //
     // Note: Matrix addition does not make sense for a Vandermonde matrix
@@ -505,6 +584,14 @@ int hankel_test(ScalarType epsilon)
       return EXIT_FAILURE;
     }
 
+    //
+    // Matrix-Matrix product:
+    //
+    if (batched_prod_test<viennacl::row_major>(vcl_hankel1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (batched_prod_test<viennacl::column_major>(vcl_hankel1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
 
     //
     // Matrix addition:
@@ -585,7 +672,9 @@ int main()
 
   std::cout << std::endl;
 
+#ifdef VIENNACL_WITH_OPENCL
   if( viennacl::ocl::current_device().double_support() )
+#endif
   {
     eps = 1e-10;
 
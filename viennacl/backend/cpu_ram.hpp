@@ -24,8 +24,41 @@
 
 
 #include <vector>
+#include <map>
+#include <cstring>
+#include <cstdlib>
+#include <cassert>
+#include <new>
+#include <algorithm>
 #include "viennacl/tools/shared_ptr.hpp"
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+// Upper bound for the number of bytes kept in the cache of released buffers (set to zero to disable caching):
+#ifndef VIENNACL_CPU_RAM_CACHE_LIMIT
+  #define VIENNACL_CPU_RAM_CACHE_LIMIT  (std::size_t(256) * 1024 * 1024)
+#endif
+
+// Buffers of at least this size are aligned to and advised for huge pages where available:
+#ifndef VIENNACL_CPU_RAM_HUGEPAGE_MIN_SIZE
+  #define VIENNACL_CPU_RAM_HUGEPAGE_MIN_SIZE  (std::size_t(4) * 1024 * 1024)
+#endif
+
+// Minimum number of bytes for copying data with multiple threads:
+#ifndef VIENNACL_CPU_RAM_OPENMP_COPY_MIN_SIZE
+  #define VIENNACL_CPU_RAM_OPENMP_COPY_MIN_SIZE  (std::size_t(1024) * 1024)
+#endif
+
 namespace viennacl
 {
   namespace backend
@@ -44,18 +77,303 @@ namespace viennacl
       // *
       //
 
+      /** @brief Alignment (in bytes) of all buffers in main RAM. Matches the cache line size of current CPUs. */
+      static const std::size_t memory_alignment = 64;
+
+      /** @brief Statistics on the buffers allocated in main RAM, see statistics() */
+      struct memory_statistics
+      {
+        memory_statistics() : bytes_live(0), bytes_peak(0), bytes_cached(0), allocations(0), cache_hits(0) {}
+
+        /** @brief Returns the fraction of allocations served from the cache of released buffers */
+        double cache_hit_rate() const { return allocations ? static_cast<double>(cache_hits) / static_cast<double>(allocations) : 0.0; }
+
+        std::size_t bytes_live;    //!< Bytes held by buffers currently in use (rounded up to the size class)
+        std::size_t bytes_peak;    //!< Maximum of bytes_live since start or the last call to reset_statistics()
+        std::size_t bytes_cached;  //!< Bytes held by released buffers kept for reuse
+        std::size_t allocations;   //!< Number of buffers handed out
+        std::size_t cache_hits;    //!< Number of buffers handed out from the cache instead of the system allocator
+      };
+
       namespace detail
       {
-        /** @brief Helper struct for deleting an pointer to an array */
-        template<class U>
-        struct array_deleter
+        /** @brief Rounds the requested size up to its size class.
+        *
+        * Sizes up to 256 bytes are rounded to multiples of the alignment, larger sizes to one of four classes per power of two.
+        * Thus, at most 25 percent of a buffer are unused, while buffers of similar size can be reused for each other.
+        */
+        inline std::size_t size_class(std::size_t size_in_bytes)
+        {
+          if (size_in_bytes <= 4 * memory_alignment)
+            return size_in_bytes ? (size_in_bytes + memory_alignment - 1) / memory_alignment * memory_alignment : memory_alignment;
+
+          std::size_t power_of_two = 4 * memory_alignment;
+          while (2 * power_of_two < size_in_bytes)
+            power_of_two *= 2;
+
+          std::size_t granularity = power_of_two / 4;
+          return (size_in_bytes + granularity - 1) / granularity * granularity;
+        }
+
+        /** @brief Allocates an aligned buffer from the system. Large buffers are aligned to huge pages and advised for transparent huge page backing on Linux. */
+        inline char * system_allocate(std::size_t size_in_bytes)
+        {
+          std::size_t alignment = memory_alignment;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+          if (size_in_bytes >= VIENNACL_CPU_RAM_HUGEPAGE_MIN_SIZE)
+            alignment = 2 * 1024 * 1024;
+#endif
+
+          void * ptr = NULL;
+#ifdef _WIN32
+          ptr = _aligned_malloc(size_in_bytes, alignment);
+#else
+          if (posix_memalign(&ptr, alignment, size_in_bytes) != 0)
+            ptr = NULL;
+#endif
+          if (!ptr)
+            throw std::bad_alloc();
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+          if (size_in_bytes >= VIENNACL_CPU_RAM_HUGEPAGE_MIN_SIZE)
+            madvise(ptr, size_in_bytes, MADV_HUGEPAGE);  // only a hint, hence failures are ignored
+#endif
+
+          return static_cast<char *>(ptr);
+        }
+
+        /** @brief Returns a buffer obtained from system_allocate() to the system */
+        inline void system_free(char * ptr)
+        {
+#ifdef _WIN32
+          _aligned_free(ptr);
+#else
+          free(ptr);
+#endif
+        }
+
+        /** @brief Copies data between distinct buffers. Large copies are split into contiguous chunks, one per thread, so that the pages of a new buffer are first touched by the same threads as in the (statically scheduled) vector operations. */
+        inline void parallel_copy(char * dst, const char * src, std::size_t bytes_to_copy)
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          if (bytes_to_copy >= VIENNACL_CPU_RAM_OPENMP_COPY_MIN_SIZE)
+          {
+            #pragma omp parallel
+            {
+              std::size_t num_threads = static_cast<std::size_t>(omp_get_num_threads());
+              std::size_t thread_id   = static_cast<std::size_t>(omp_get_thread_num());
+              std::size_t chunk_size  = (bytes_to_copy / num_threads + memory_alignment - 1) / memory_alignment * memory_alignment;
+              std::size_t chunk_start = std::min(thread_id * chunk_size, bytes_to_copy);
+              std::size_t chunk_stop  = std::min(chunk_start + chunk_size, bytes_to_copy);
+              if (chunk_start < chunk_stop)
+                std::memcpy(dst + chunk_start, src + chunk_start, chunk_stop - chunk_start);
+            }
+            return;
+          }
+#endif
+          std::memcpy(dst, src, bytes_to_copy);
+        }
+
+        /** @brief Caches released buffers per size class for reuse and keeps track of the allocation statistics.
+        *
+        * Repeated allocations of the same size (temporaries in iterative solvers, scheduler temporaries, copies of vectors)
+        * are served from the cache without a call to the system allocator.
+        */
+        class memory_pool
+        {
+          typedef std::map<std::size_t, std::vector<char *> >   cache_type;
+
+        public:
+          memory_pool() : cache_limit_(VIENNACL_CPU_RAM_CACHE_LIMIT) {}
+
+          ~memory_pool()
+          {
+            release_cached();
+            destroyed() = true;
+          }
+
+          /** @brief Returns true once the pool has been destroyed at program exit. Buffers released afterwards are returned to the system directly. */
+          static bool & destroyed()
+          {
+            static bool is_destroyed = false;
+            return is_destroyed;
+          }
+
+          char * allocate(std::size_t class_size)
+          {
+            char * ptr = NULL;
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical (viennacl_cpu_ram_pool)
+#endif
+            {
+              cache_type::iterator it = cache_.find(class_size);
+              if (it != cache_.end() && it->second.size() > 0)
+              {
+                ptr = it->second.back();
+                it->second.pop_back();
+                stats_.bytes_cached -= class_size;
+                ++stats_.cache_hits;
+              }
+            }
+
+            if (!ptr)
+            {
+              try
+              {
+                ptr = system_allocate(class_size);
+              }
+              catch (std::bad_alloc const &)
+              {
+                // the cache may hold the memory needed, hence retry after releasing it:
+                release_cached();
+                ptr = system_allocate(class_size);
+              }
+            }
+
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical (viennacl_cpu_ram_pool)
+#endif
+            {
+              ++stats_.allocations;
+              stats_.bytes_live += class_size;
+              stats_.bytes_peak = std::max(stats_.bytes_peak, stats_.bytes_live);
+            }
+            return ptr;
+          }
+
+          void deallocate(char * ptr, std::size_t class_size)
+          {
+            bool keep = false;
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical (viennacl_cpu_ram_pool)
+#endif
+            {
+              stats_.bytes_live -= class_size;
+              if (stats_.bytes_cached + class_size <= cache_limit_)
+              {
+                cache_[class_size].push_back(ptr);
+                stats_.bytes_cached += class_size;
+                keep = true;
+              }
+            }
+
+            if (!keep)
+              system_free(ptr);
+          }
+
+          void release_cached()
+          {
+            cache_type released;
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical (viennacl_cpu_ram_pool)
+#endif
+            {
+              released.swap(cache_);
+              stats_.bytes_cached = 0;
+            }
+
+            for (cache_type::iterator it = released.begin(); it != released.end(); ++it)
+              for (std::size_t i=0; i<it->second.size(); ++i)
+                system_free(it->second[i]);
+          }
+
+          void cache_limit(std::size_t limit)
+          {
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical (viennacl_cpu_ram_pool)
+#endif
+            {
+              cache_limit_ = limit;
+            }
+            if (limit < statistics().bytes_cached)
+              release_cached();
+          }
+
+          std::size_t cache_limit() const
+          {
+            std::size_t result;
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical (viennacl_cpu_ram_pool)
+#endif
+            {
+              result = cache_limit_;
+            }
+            return result;
+          }
+
+          memory_statistics statistics() const
+          {
+            memory_statistics result;
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical (viennacl_cpu_ram_pool)
+#endif
+            {
+              result = stats_;
+            }
+            return result;
+          }
+
+          void reset_statistics()
+          {
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical (viennacl_cpu_ram_pool)
+#endif
+            {
+              stats_.bytes_peak  = stats_.bytes_live;
+              stats_.allocations = 0;
+              stats_.cache_hits  = 0;
+            }
+          }
+
+        private:
+          cache_type         cache_;
+          std::size_t        cache_limit_;
+          memory_statistics  stats_;
+        };
+
+        /** @brief Returns the memory pool shared by all buffers in main RAM. Constructed on first use, so that it outlives all buffers allocated from it. */
+        inline memory_pool & get_memory_pool()
+        {
+          static memory_pool pool;
+          return pool;
+        }
+
+        /** @brief Deleter returning a buffer to the memory pool */
+        struct pool_deleter
         {
-          void operator()(U* p) const { delete[] p; }
+          pool_deleter(std::size_t class_size) : class_size_(class_size) {}
+
+          void operator()(char * p) const
+          {
+            if (memory_pool::destroyed())
+              system_free(p);
+            else
+              get_memory_pool().deallocate(p, class_size_);
+          }
+
+          std::size_t class_size_;
         };
 
       }
 
+      /** @brief Returns statistics on the buffers allocated in main RAM (bytes in use, peak usage, bytes cached, cache hit rate) */
+      inline memory_statistics statistics() { return detail::get_memory_pool().statistics(); }
+
+      /** @brief Resets the peak usage to the current usage and the allocation counters to zero */
+      inline void reset_statistics() { detail::get_memory_pool().reset_statistics(); }
+
+      /** @brief Returns all cached buffers in main RAM to the system */
+      inline void release_cached_memory() { detail::get_memory_pool().release_cached(); }
+
+      /** @brief Sets the maximum number of bytes kept in the cache of released buffers. A limit of zero disables caching. */
+      inline void set_cache_limit(std::size_t limit_in_bytes) { detail::get_memory_pool().cache_limit(limit_in_bytes); }
+
+      /** @brief Returns the maximum number of bytes kept in the cache of released buffers */
+      inline std::size_t cache_limit() { return detail::get_memory_pool().cache_limit(); }
+
       /** @brief Creates an array of the specified size in main RAM. If the second argument is provided, the buffer is initialized with data from that pointer.
+       *
+       * The buffer is aligned to 'memory_alignment' bytes and reused from the pool of released buffers of the same size class if possible.
        *
        * @param size_in_bytes   Number of bytes to allocate
        * @param host_ptr        Pointer to data which will be copied to the new array. Must point to at least 'size_in_bytes' bytes of data.
@@ -63,16 +381,11 @@ namespace viennacl
        */
       inline handle_type  memory_create(std::size_t size_in_bytes, const void * host_ptr = NULL)
       {
-        if (!host_ptr)
-          return handle_type(new char[size_in_bytes], detail::array_deleter<char>());
-
-        handle_type new_handle(new char[size_in_bytes], detail::array_deleter<char>());
+        std::size_t class_size = detail::size_class(size_in_bytes);
+        handle_type new_handle(detail::get_memory_pool().allocate(class_size), detail::pool_deleter(class_size));
 
-        // copy data:
-        char * raw_ptr = new_handle.get();
-        const char * data_ptr = static_cast<const char *>(host_ptr);
-        for (std::size_t i=0; i<size_in_bytes; ++i)
-          raw_ptr[i] = data_ptr[i];
+        if (host_ptr)
+          detail::parallel_copy(new_handle.get(), static_cast<const char *>(host_ptr), size_in_bytes);
 
         return new_handle;
       }
@@ -94,8 +407,10 @@ namespace viennacl
         assert( (dst_buffer.get() != NULL) && bool("Memory not initialized!"));
         assert( (src_buffer.get() != NULL) && bool("Memory not initialized!"));
 
-        for (std::size_t i=0; i<bytes_to_copy; ++i)
-          dst_buffer.get()[i+dst_offset] = src_buffer.get()[i + src_offset];
+        if (src_buffer.get() == dst_buffer.get())
+          std::memmove(dst_buffer.get() + dst_offset, src_buffer.get() + src_offset, bytes_to_copy);
+        else
+          detail::parallel_copy(dst_buffer.get() + dst_offset, src_buffer.get() + src_offset, bytes_to_copy);
       }
 
       /** @brief Writes data from main RAM identified by 'ptr' to the buffer identified by 'dst_buffer'
@@ -113,8 +428,7 @@ namespace viennacl
       {
         assert( (dst_buffer.get() != NULL) && bool("Memory not initialized!"));
 
-        for (std::size_t i=0; i<bytes_to_copy; ++i)
-          dst_buffer.get()[i+dst_offset] = static_cast<const char *>(ptr)[i];
+        detail::parallel_copy(dst_buffer.get() + dst_offset, static_cast<const char *>(ptr), bytes_to_copy);
       }
 
       /** @brief Reads data from a buffer back to main RAM.
@@ -132,8 +446,7 @@ namespace viennacl
       {
         assert( (src_buffer.get() != NULL) && bool("Memory not initialized!"));
 
-        for (std::size_t i=0; i<bytes_to_copy; ++i)
-          static_cast<char *>(ptr)[i] = src_buffer.get()[i+src_offset];
+        detail::parallel_copy(static_cast<char *>(ptr), src_buffer.get() + src_offset, bytes_to_copy);
       }
 
 
@@ -433,7 +433,7 @@ namespace viennacl
         typedef vcl_size_t                                                                                 size_type;
 
         /** @brief Default construction of a compressed matrix. No memory is allocated */
-        compressed_matrix() : rows_(0), cols_(0), nonzeros_(0) {}
+        compressed_matrix() : rows_(0), cols_(0), nonzeros_(0), row_blocks_nnz_(0) {}
 
         /** @brief Construction of a compressed matrix with the supplied number of rows and columns. If the number of nonzeros is positive, memory is allocated
         *
@@ -443,7 +443,7 @@ namespace viennacl
         * @param ctx      Optional context in which the matrix is created (one out of multiple OpenCL contexts, CUDA, host)
         */
         explicit compressed_matrix(std::size_t rows, std::size_t cols, std::size_t nonzeros = 0, viennacl::context ctx = viennacl::context())
-          : rows_(rows), cols_(cols), nonzeros_(nonzeros)
+          : rows_(rows), cols_(cols), nonzeros_(nonzeros), row_blocks_nnz_(0)
         {
           row_buffer_.switch_active_handle_id(ctx.memory_type());
           col_buffer_.switch_active_handle_id(ctx.memory_type());
@@ -475,7 +475,7 @@ namespace viennacl
         * @param ctx      Context in which to create the matrix
         */
         explicit compressed_matrix(std::size_t rows, std::size_t cols, viennacl::context ctx)
-          : rows_(rows), cols_(cols), nonzeros_(0)
+          : rows_(rows), cols_(cols), nonzeros_(0), row_blocks_nnz_(0)
         {
           row_buffer_.switch_active_handle_id(ctx.memory_type());
           col_buffer_.switch_active_handle_id(ctx.memory_type());
@@ -495,7 +495,7 @@ namespace viennacl
           }
         }
 
-        explicit compressed_matrix(viennacl::context ctx) : rows_(0), cols_(0), nonzeros_(0)
+        explicit compressed_matrix(viennacl::context ctx) : rows_(0), cols_(0), nonzeros_(0), row_blocks_nnz_(0)
         {
           row_buffer_.switch_active_handle_id(ctx.memory_type());
           col_buffer_.switch_active_handle_id(ctx.memory_type());
@@ -515,7 +515,7 @@ namespace viennacl
 #ifdef VIENNACL_WITH_OPENCL
         explicit compressed_matrix(cl_mem mem_row_buffer, cl_mem mem_col_buffer, cl_mem mem_elements,
                                   std::size_t rows, std::size_t cols, std::size_t nonzeros) :
-          rows_(rows), cols_(cols), nonzeros_(nonzeros)
+          rows_(rows), cols_(cols), nonzeros_(nonzeros), row_blocks_nnz_(0)
         {
             row_buffer_.switch_active_handle_id(viennacl::OPENCL_MEMORY);
             row_buffer_.opencl_handle() = mem_row_buffer;
@@ -549,6 +549,8 @@ namespace viennacl
           viennacl::backend::typesafe_memory_copy<unsigned int>(other.col_buffer_, col_buffer_);
           viennacl::backend::typesafe_memory_copy<SCALARTYPE>(other.elements_, elements_);
 
+          discard_row_blocks();
+
           return *this;
         }
 
@@ -586,6 +588,8 @@ namespace viennacl
           nonzeros_ = nonzeros;
           rows_ = rows;
           cols_ = cols;
+
+          discard_row_blocks();
         }
 
         /** @brief Allocate memory for the supplied number of nonzeros in the matrix. Old values are preserved. */
@@ -628,8 +632,10 @@ namespace viennacl
               {
                 stl_sparse_matrix.resize(rows_);
                 viennacl::copy(*this, stl_sparse_matrix);
-              } else
-                stl_sparse_matrix[0][0] = 0;
+              } else {
+                stl_sparse_matrix.resize(new_size1);
+                stl_sparse_matrix[0][0] = 0;    //enforces nonzero array sizes
+              }
             } else {
               stl_sparse_matrix.resize(new_size1);
               stl_sparse_matrix[0][0] = 0;      //enforces nonzero array sizes if matrix was initially empty
@@ -702,8 +708,8 @@ namespace viennacl
         /** @brief  Returns the OpenCL handle to the matrix entry array */
         const handle_type & handle() const { return elements_; }
 
-        /** @brief  Returns the OpenCL handle to the row index array */
-        handle_type & handle1() { return row_buffer_; }
+        /** @brief  Returns the OpenCL handle to the row index array. Since the row indices may be modified through the handle, the cached row blocks are discarded. */
+        handle_type & handle1() { discard_row_blocks(); return row_buffer_; }
         /** @brief  Returns the OpenCL handle to the column index array */
         handle_type & handle2() { return col_buffer_; }
         /** @brief  Returns the OpenCL handle to the matrix entry array */
@@ -721,8 +727,62 @@ namespace viennacl
           return row_buffer_.get_active_handle_id();
         }
 
+        /** @brief Returns a partition of the rows into consecutive blocks with about the same number of nonzeros.
+        *
+        * Block i consists of the rows row_blocks()[i], ..., row_blocks()[i+1] - 1. A row with more than 'block_nnz' nonzeros forms a block on its own.
+        * The partition is computed on first use and cached until the sparsity pattern is changed through set(), assignment, or handle1().
+        * It does not depend on the number of threads, hence results obtained with the partition are reproducible.
+        * The cache is accessed in a critical section and a copy of the partition is returned, so concurrent calls on the same (const) matrix are safe, even with different 'block_nnz'.
+        *
+        * @param block_nnz   Target number of nonzeros per block. Each row additionally accounts for one nonzero.
+        */
+        std::vector<unsigned int> row_blocks(std::size_t block_nnz = 2048) const
+        {
+          std::vector<unsigned int> result;
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp critical (viennacl_compressed_matrix_row_blocks)
+#endif
+          {
+            if (row_blocks_nnz_ != block_nnz)
+            {
+              std::vector<unsigned int> blocks;
+              blocks.push_back(0);
+              if (rows_ > 0)
+              {
+                viennacl::backend::typesafe_host_array<unsigned int> row_indices(row_buffer_, rows_ + 1);
+                viennacl::backend::memory_read(row_buffer_, 0, row_indices.raw_size(), row_indices.get());
+
+                std::size_t block_cost = 0;
+                for (std::size_t row = 0; row < rows_; ++row)
+                {
+                  std::size_t row_cost = row_indices[row+1] - row_indices[row] + 1;
+                  if (block_cost > 0 && block_cost + row_cost > block_nnz)  //close current block
+                  {
+                    blocks.push_back(static_cast<unsigned int>(row));
+                    block_cost = 0;
+                  }
+                  block_cost += row_cost;
+                }
+              }
+              blocks.push_back(static_cast<unsigned int>(rows_));
+
+              row_blocks_.swap(blocks);
+              row_blocks_nnz_ = block_nnz;
+            }
+            result = row_blocks_;
+          }
+          return result;
+        }
+
       private:
 
+        /** @brief Discards the cached row partition, cf. row_blocks(). Must be called whenever the row indices change. */
+        void discard_row_blocks()
+        {
+          row_blocks_.clear();
+          row_blocks_nnz_ = 0;
+        }
+
         std::size_t element_index(std::size_t i, std::size_t j)
         {
           //read row indices
@@ -757,6 +817,8 @@ namespace viennacl
         handle_type row_buffer_;
         handle_type col_buffer_;
         handle_type elements_;
+        mutable std::vector<unsigned int> row_blocks_;
+        mutable std::size_t row_blocks_nnz_;
     };
 
 
@@ -25,7 +25,11 @@
 #include <viennacl/vector.hpp>
 #include <viennacl/matrix.hpp>
 
-#include "viennacl/linalg/opencl/kernels/fft.hpp"
+#include "viennacl/linalg/host_based/fft_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/kernels/fft.hpp"
+#endif
 
 #include <cmath>
 
@@ -90,6 +94,7 @@ namespace viennacl
         }
 
 
+#ifdef VIENNACL_WITH_OPENCL
         /**
          * @brief Direct algorithm for computing Fourier transformation.
          *
@@ -219,30 +224,40 @@ namespace viennacl
             }
         }
 
+#endif
+
         /**
          * @brief Bluestein's algorithm for computing Fourier transformation.
          *
-         * Currently,  Works only for sizes of input data which less than 2^16.
+         * OpenCL: Currently,  Works only for sizes of input data which less than 2^16.
          * Uses a lot of additional memory, but should be fast for any size of data.
          * Serial implementation has something about o(n * lg n) complexity
         */
         template<class SCALARTYPE, unsigned int ALIGNMENT>
         void bluestein(viennacl::vector<SCALARTYPE, ALIGNMENT>& in,
                        viennacl::vector<SCALARTYPE, ALIGNMENT>& out,
-                       std::size_t /*batch_num*/)
+                       std::size_t batch_num)
         {
-          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(in).context());
-          viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
+          switch (viennacl::traits::handle(in).get_active_handle_id())
+          {
+            case viennacl::MAIN_MEMORY:
+              viennacl::linalg::host_based::fft(in, out, (in.size() >> 1) / batch_num, batch_num, SCALARTYPE(-1.0), true);
+              break;
+#ifdef VIENNACL_WITH_OPENCL
+            case viennacl::OPENCL_MEMORY:
+            {
+              viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(in).context());
+              viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
 
-          std::size_t size = in.size() >> 1;
-          std::size_t ext_size = next_power_2(2 * size - 1);
+              std::size_t size = in.size() >> 1;
+              std::size_t ext_size = next_power_2(2 * size - 1);
 
-          viennacl::vector<SCALARTYPE, ALIGNMENT> A(ext_size << 1);
-          viennacl::vector<SCALARTYPE, ALIGNMENT> B(ext_size << 1);
+              viennacl::vector<SCALARTYPE, ALIGNMENT> A(ext_size << 1);
+              viennacl::vector<SCALARTYPE, ALIGNMENT> B(ext_size << 1);
 
-          viennacl::vector<SCALARTYPE, ALIGNMENT> Z(ext_size << 1);
+              viennacl::vector<SCALARTYPE, ALIGNMENT> Z(ext_size << 1);
 
-            {
+              {
                 viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "zero2");
                 viennacl::ocl::enqueue(kernel(
                                             A,
@@ -250,8 +265,8 @@ namespace viennacl
                                             static_cast<cl_uint>(ext_size)
                                             ));
 
-            }
-            {
+              }
+              {
                 viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "bluestein_pre");
                 viennacl::ocl::enqueue(kernel(
                                            in,
@@ -260,18 +275,26 @@ namespace viennacl
                                            static_cast<cl_uint>(size),
                                            static_cast<cl_uint>(ext_size)
                                        ));
-            }
+              }
 
-            viennacl::linalg::convolve_i(A, B, Z);
+              viennacl::linalg::convolve_i(A, B, Z);
 
-            {
+              {
                 viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "bluestein_post");
                 viennacl::ocl::enqueue(kernel(
                                             Z,
                                             out,
                                             static_cast<cl_uint>(size)
                                             ));
+              }
+              break;
             }
+#endif
+            case viennacl::MEMORY_NOT_INITIALIZED:
+              throw memory_exception("not initialised!");
+            default:
+              throw memory_exception("not implemented");
+          }
         }
 
         template<class SCALARTYPE, unsigned int ALIGNMENT>
@@ -279,50 +302,114 @@ namespace viennacl
                       viennacl::vector<SCALARTYPE, ALIGNMENT> const & input2,
                       viennacl::vector<SCALARTYPE, ALIGNMENT> & output)
         {
-          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(input1).context());
-          viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
-          std::size_t size = input1.size() >> 1;
-          viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "fft_mult_vec");
-          viennacl::ocl::enqueue(kernel(input1, input2, output, static_cast<cl_uint>(size)));
+          switch (viennacl::traits::handle(input1).get_active_handle_id())
+          {
+            case viennacl::MAIN_MEMORY:
+              viennacl::linalg::host_based::fft_multiply(input1, input2, output);
+              break;
+#ifdef VIENNACL_WITH_OPENCL
+            case viennacl::OPENCL_MEMORY:
+            {
+              viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(input1).context());
+              viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
+              std::size_t size = input1.size() >> 1;
+              viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "fft_mult_vec");
+              viennacl::ocl::enqueue(kernel(input1, input2, output, static_cast<cl_uint>(size)));
+              break;
+            }
+#endif
+            case viennacl::MEMORY_NOT_INITIALIZED:
+              throw memory_exception("not initialised!");
+            default:
+              throw memory_exception("not implemented");
+          }
         }
 
         template<class SCALARTYPE, unsigned int ALIGNMENT>
         void normalize(viennacl::vector<SCALARTYPE, ALIGNMENT> & input)
         {
-          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(input).context());
-          viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
-
-          viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "fft_div_vec_scalar");
-          std::size_t size = input.size() >> 1;
-          SCALARTYPE norm_factor = static_cast<SCALARTYPE>(size);
-          viennacl::ocl::enqueue(kernel(input, static_cast<cl_uint>(size), norm_factor));
+          switch (viennacl::traits::handle(input).get_active_handle_id())
+          {
+            case viennacl::MAIN_MEMORY:
+              viennacl::linalg::host_based::fft_normalize(input);
+              break;
+#ifdef VIENNACL_WITH_OPENCL
+            case viennacl::OPENCL_MEMORY:
+            {
+              viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(input).context());
+              viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
+
+              viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "fft_div_vec_scalar");
+              std::size_t size = input.size() >> 1;
+              SCALARTYPE norm_factor = static_cast<SCALARTYPE>(size);
+              viennacl::ocl::enqueue(kernel(input, static_cast<cl_uint>(size), norm_factor));
+              break;
+            }
+#endif
+            case viennacl::MEMORY_NOT_INITIALIZED:
+              throw memory_exception("not initialised!");
+            default:
+              throw memory_exception("not implemented");
+          }
         }
 
         template<class SCALARTYPE, unsigned int ALIGNMENT>
         void transpose(viennacl::matrix<SCALARTYPE, viennacl::row_major, ALIGNMENT> & input)
         {
-          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(input).context());
-          viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
-
-          viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "transpose_inplace");
-          viennacl::ocl::enqueue(kernel(input,
-                                        static_cast<cl_uint>(input.internal_size1()),
-                                        static_cast<cl_uint>(input.internal_size2()) >> 1));
+          switch (viennacl::traits::handle(input).get_active_handle_id())
+          {
+            case viennacl::MAIN_MEMORY:
+              viennacl::linalg::host_based::fft_transpose(input, input);
+              break;
+#ifdef VIENNACL_WITH_OPENCL
+            case viennacl::OPENCL_MEMORY:
+            {
+              viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(input).context());
+              viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
+
+              viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "transpose_inplace");
+              viennacl::ocl::enqueue(kernel(input,
+                                            static_cast<cl_uint>(input.internal_size1()),
+                                            static_cast<cl_uint>(input.internal_size2()) >> 1));
+              break;
+            }
+#endif
+            case viennacl::MEMORY_NOT_INITIALIZED:
+              throw memory_exception("not initialised!");
+            default:
+              throw memory_exception("not implemented");
+          }
         }
 
         template<class SCALARTYPE, unsigned int ALIGNMENT>
         void transpose(viennacl::matrix<SCALARTYPE, viennacl::row_major, ALIGNMENT> const & input,
                        viennacl::matrix<SCALARTYPE, viennacl::row_major, ALIGNMENT> & output)
         {
-          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(input).context());
-          viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
-
-          viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "transpose");
-          viennacl::ocl::enqueue(kernel(input,
-                                        output,
-                                        static_cast<cl_uint>(input.internal_size1()),
-                                        static_cast<cl_uint>(input.internal_size2() >> 1))
-                                );
+          switch (viennacl::traits::handle(input).get_active_handle_id())
+          {
+            case viennacl::MAIN_MEMORY:
+              viennacl::linalg::host_based::fft_transpose(input, output);
+              break;
+#ifdef VIENNACL_WITH_OPENCL
+            case viennacl::OPENCL_MEMORY:
+            {
+              viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(input).context());
+              viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
+
+              viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "transpose");
+              viennacl::ocl::enqueue(kernel(input,
+                                            output,
+                                            static_cast<cl_uint>(input.internal_size1()),
+                                            static_cast<cl_uint>(input.internal_size2() >> 1))
+                                    );
+              break;
+            }
+#endif
+            case viennacl::MEMORY_NOT_INITIALIZED:
+              throw memory_exception("not initialised!");
+            default:
+              throw memory_exception("not implemented");
+          }
         }
 
         template<class SCALARTYPE>
@@ -330,10 +417,26 @@ namespace viennacl
                              viennacl::vector_base<SCALARTYPE> & out,
                              std::size_t size)
         {
-          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(in).context());
-          viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
-          viennacl::ocl::kernel & kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "real_to_complex");
-          viennacl::ocl::enqueue(kernel(in, out, static_cast<cl_uint>(size)));
+          switch (viennacl::traits::handle(in).get_active_handle_id())
+          {
+            case viennacl::MAIN_MEMORY:
+              viennacl::linalg::host_based::real_to_complex(in, out, size);
+              break;
+#ifdef VIENNACL_WITH_OPENCL
+            case viennacl::OPENCL_MEMORY:
+            {
+              viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(in).context());
+              viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
+              viennacl::ocl::kernel & kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "real_to_complex");
+              viennacl::ocl::enqueue(kernel(in, out, static_cast<cl_uint>(size)));
+              break;
+            }
+#endif
+            case viennacl::MEMORY_NOT_INITIALIZED:
+              throw memory_exception("not initialised!");
+            default:
+              throw memory_exception("not implemented");
+          }
         }
 
         template<class SCALARTYPE>
@@ -341,23 +444,54 @@ namespace viennacl
                              viennacl::vector_base<SCALARTYPE>& out,
                              std::size_t size)
         {
-          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(in).context());
-          viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
-          viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "complex_to_real");
-          viennacl::ocl::enqueue(kernel(in, out, static_cast<cl_uint>(size)));
+          switch (viennacl::traits::handle(in).get_active_handle_id())
+          {
+            case viennacl::MAIN_MEMORY:
+              viennacl::linalg::host_based::complex_to_real(in, out, size);
+              break;
+#ifdef VIENNACL_WITH_OPENCL
+            case viennacl::OPENCL_MEMORY:
+            {
+              viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(in).context());
+              viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
+              viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "complex_to_real");
+              viennacl::ocl::enqueue(kernel(in, out, static_cast<cl_uint>(size)));
+              break;
+            }
+#endif
+            case viennacl::MEMORY_NOT_INITIALIZED:
+              throw memory_exception("not initialised!");
+            default:
+              throw memory_exception("not implemented");
+          }
         }
 
         template<class SCALARTYPE>
         void reverse(viennacl::vector_base<SCALARTYPE>& in)
         {
-          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(in).context());
-          viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
-          std::size_t size = in.size();
-          viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "reverse_inplace");
-          viennacl::ocl::enqueue(kernel(in, static_cast<cl_uint>(size)));
+          switch (viennacl::traits::handle(in).get_active_handle_id())
+          {
+            case viennacl::MAIN_MEMORY:
+              viennacl::linalg::host_based::reverse(in);
+              break;
+#ifdef VIENNACL_WITH_OPENCL
+            case viennacl::OPENCL_MEMORY:
+            {
+              viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(in).context());
+              viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::init(ctx);
+              std::size_t size = in.size();
+              viennacl::ocl::kernel& kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<SCALARTYPE>::program_name(), "reverse_inplace");
+              viennacl::ocl::enqueue(kernel(in, static_cast<cl_uint>(size)));
+              break;
+            }
+#endif
+            case viennacl::MEMORY_NOT_INITIALIZED:
+              throw memory_exception("not initialised!");
+            default:
+              throw memory_exception("not implemented");
+          }
         }
 
-
     } //namespace fft
   } //namespace detail
 
@@ -375,19 +509,33 @@ namespace viennacl
   {
       std::size_t size = (input.size() >> 1) / batch_num;
 
-      if(!viennacl::detail::fft::is_radix2(size))
+      switch (viennacl::traits::handle(input).get_active_handle_id())
       {
-          viennacl::vector<SCALARTYPE, ALIGNMENT> output(input.size());
-          viennacl::detail::fft::direct(viennacl::traits::opencl_handle(input),
-                                        viennacl::traits::opencl_handle(output),
-                                        size,
-                                        size,
-                                        batch_num,
-                                        sign);
-
-          viennacl::copy(output, input);
-      } else {
-          viennacl::detail::fft::radix2(viennacl::traits::opencl_handle(input), size, size, batch_num, sign);
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::fft(input, input, size, batch_num, sign);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          if(!viennacl::detail::fft::is_radix2(size))
+          {
+              viennacl::vector<SCALARTYPE, ALIGNMENT> output(input.size());
+              viennacl::detail::fft::direct(viennacl::traits::opencl_handle(input),
+                                            viennacl::traits::opencl_handle(output),
+                                            size,
+                                            size,
+                                            batch_num,
+                                            sign);
+
+              viennacl::copy(output, input);
+          } else {
+              viennacl::detail::fft::radix2(viennacl::traits::opencl_handle(input), size, size, batch_num, sign);
+          }
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
       }
   }
 
@@ -408,17 +556,31 @@ namespace viennacl
   {
       std::size_t size = (input.size() >> 1) / batch_num;
 
-      if(viennacl::detail::fft::is_radix2(size))
+      switch (viennacl::traits::handle(input).get_active_handle_id())
       {
-          viennacl::copy(input, output);
-          viennacl::detail::fft::radix2(viennacl::traits::opencl_handle(output), size, size, batch_num, sign);
-      } else {
-          viennacl::detail::fft::direct(viennacl::traits::opencl_handle(input),
-                                        viennacl::traits::opencl_handle(output),
-                                        size,
-                                        size,
-                                        batch_num,
-                                        sign);
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::fft(input, output, size, batch_num, sign);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          if(viennacl::detail::fft::is_radix2(size))
+          {
+              viennacl::copy(input, output);
+              viennacl::detail::fft::radix2(viennacl::traits::opencl_handle(output), size, size, batch_num, sign);
+          } else {
+              viennacl::detail::fft::direct(viennacl::traits::opencl_handle(input),
+                                            viennacl::traits::opencl_handle(output),
+                                            size,
+                                            size,
+                                            batch_num,
+                                            sign);
+          }
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
       }
   }
 
@@ -432,49 +594,64 @@ namespace viennacl
   void inplace_fft(viennacl::matrix<SCALARTYPE, viennacl::row_major, ALIGNMENT>& input,
             SCALARTYPE sign = -1.0)
   {
-      std::size_t rows_num = input.size1();
-      std::size_t cols_num = input.size2() >> 1;
+      switch (viennacl::traits::handle(input).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::fft(input, input, sign);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+        {
+          std::size_t rows_num = input.size1();
+          std::size_t cols_num = input.size2() >> 1;
 
-      std::size_t cols_int = input.internal_size2() >> 1;
+          std::size_t cols_int = input.internal_size2() >> 1;
 
-      // batch with rows
-      if(viennacl::detail::fft::is_radix2(cols_num))
-      {
-          viennacl::detail::fft::radix2(viennacl::traits::opencl_handle(input), cols_num, cols_int, rows_num, sign, viennacl::detail::fft::FFT_DATA_ORDER::ROW_MAJOR);
-      }
-      else
-      {
-          viennacl::matrix<SCALARTYPE, viennacl::row_major, ALIGNMENT> output(input.size1(), input.size2());
-
-          viennacl::detail::fft::direct(viennacl::traits::opencl_handle(input),
-                                        viennacl::traits::opencl_handle(output),
-                                        cols_num,
-                                        cols_int,
-                                        rows_num,
-                                        sign,
-                                        viennacl::detail::fft::FFT_DATA_ORDER::ROW_MAJOR
-                                        );
-
-          input = output;
-      }
+          // batch with rows
+          if(viennacl::detail::fft::is_radix2(cols_num))
+          {
+              viennacl::detail::fft::radix2(viennacl::traits::opencl_handle(input), cols_num, cols_int, rows_num, sign, viennacl::detail::fft::FFT_DATA_ORDER::ROW_MAJOR);
+          }
+          else
+          {
+              viennacl::matrix<SCALARTYPE, viennacl::row_major, ALIGNMENT> output(input.size1(), input.size2());
+
+              viennacl::detail::fft::direct(viennacl::traits::opencl_handle(input),
+                                            viennacl::traits::opencl_handle(output),
+                                            cols_num,
+                                            cols_int,
+                                            rows_num,
+                                            sign,
+                                            viennacl::detail::fft::FFT_DATA_ORDER::ROW_MAJOR
+                                            );
+
+              input = output;
+          }
 
-      // batch with cols
-      if (viennacl::detail::fft::is_radix2(rows_num)) {
-          viennacl::detail::fft::radix2(viennacl::traits::opencl_handle(input), rows_num, cols_int, cols_num, sign, viennacl::detail::fft::FFT_DATA_ORDER::COL_MAJOR);
-      } else {
-          viennacl::matrix<SCALARTYPE, viennacl::row_major, ALIGNMENT> output(input.size1(), input.size2());
-
-          viennacl::detail::fft::direct(viennacl::traits::opencl_handle(input),
-                                        viennacl::traits::opencl_handle(output),
-                                        rows_num,
-                                        cols_int,
-                                        cols_num,
-                                        sign,
-                                        viennacl::detail::fft::FFT_DATA_ORDER::COL_MAJOR);
-
-          input = output;
+          // batch with cols
+          if (viennacl::detail::fft::is_radix2(rows_num)) {
+              viennacl::detail::fft::radix2(viennacl::traits::opencl_handle(input), rows_num, cols_int, cols_num, sign, viennacl::detail::fft::FFT_DATA_ORDER::COL_MAJOR);
+          } else {
+              viennacl::matrix<SCALARTYPE, viennacl::row_major, ALIGNMENT> output(input.size1(), input.size2());
+
+              viennacl::detail::fft::direct(viennacl::traits::opencl_handle(input),
+                                            viennacl::traits::opencl_handle(output),
+                                            rows_num,
+                                            cols_int,
+                                            cols_num,
+                                            sign,
+                                            viennacl::detail::fft::FFT_DATA_ORDER::COL_MAJOR);
+
+              input = output;
+          }
+          break;
+        }
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
       }
-
   }
 
   /**
@@ -489,46 +666,62 @@ namespace viennacl
             viennacl::matrix<SCALARTYPE, viennacl::row_major, ALIGNMENT>& output,
             SCALARTYPE sign = -1.0)
   {
-      std::size_t rows_num = input.size1();
-      std::size_t cols_num = input.size2() >> 1;
+      switch (viennacl::traits::handle(input).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::fft(input, output, sign);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+        {
+          std::size_t rows_num = input.size1();
+          std::size_t cols_num = input.size2() >> 1;
 
-      std::size_t cols_int = input.internal_size2() >> 1;
+          std::size_t cols_int = input.internal_size2() >> 1;
 
-      // batch with rows
-      if(viennacl::detail::fft::is_radix2(cols_num))
-      {
-          output = input;
-          viennacl::detail::fft::radix2(viennacl::traits::opencl_handle(output), cols_num, cols_int, rows_num, sign, viennacl::detail::fft::FFT_DATA_ORDER::ROW_MAJOR);
-      }
-      else
-      {
-          viennacl::detail::fft::direct(viennacl::traits::opencl_handle(input),
-                                        viennacl::traits::opencl_handle(output),
-                                        cols_num,
-                                        cols_int,
-                                        rows_num,
-                                        sign,
-                                        viennacl::detail::fft::FFT_DATA_ORDER::ROW_MAJOR
-                                        );
-      }
+          // batch with rows
+          if(viennacl::detail::fft::is_radix2(cols_num))
+          {
+              output = input;
+              viennacl::detail::fft::radix2(viennacl::traits::opencl_handle(output), cols_num, cols_int, rows_num, sign, viennacl::detail::fft::FFT_DATA_ORDER::ROW_MAJOR);
+          }
+          else
+          {
+              viennacl::detail::fft::direct(viennacl::traits::opencl_handle(input),
+                                            viennacl::traits::opencl_handle(output),
+                                            cols_num,
+                                            cols_int,
+                                            rows_num,
+                                            sign,
+                                            viennacl::detail::fft::FFT_DATA_ORDER::ROW_MAJOR
+                                            );
+          }
 
-      // batch with cols
-      if(viennacl::detail::fft::is_radix2(rows_num))
-      {
-          viennacl::detail::fft::radix2(viennacl::traits::opencl_handle(output), rows_num, cols_int, cols_num, sign, viennacl::detail::fft::FFT_DATA_ORDER::COL_MAJOR);
-      }
-      else
-      {
-          viennacl::matrix<SCALARTYPE, viennacl::row_major, ALIGNMENT> tmp(output.size1(), output.size2());
-          tmp = output;
-
-          viennacl::detail::fft::direct(viennacl::traits::opencl_handle(tmp),
-                              viennacl::traits::opencl_handle(output),
-                              rows_num,
-                              cols_int,
-                              cols_num,
-                              sign,
-                              viennacl::detail::fft::FFT_DATA_ORDER::COL_MAJOR);
+          // batch with cols
+          if(viennacl::detail::fft::is_radix2(rows_num))
+          {
+              viennacl::detail::fft::radix2(viennacl::traits::opencl_handle(output), rows_num, cols_int, cols_num, sign, viennacl::detail::fft::FFT_DATA_ORDER::COL_MAJOR);
+          }
+          else
+          {
+              viennacl::matrix<SCALARTYPE, viennacl::row_major, ALIGNMENT> tmp(output.size1(), output.size2());
+              tmp = output;
+
+              viennacl::detail::fft::direct(viennacl::traits::opencl_handle(tmp),
+                                  viennacl::traits::opencl_handle(output),
+                                  rows_num,
+                                  cols_int,
+                                  cols_num,
+                                  sign,
+                                  viennacl::detail::fft::FFT_DATA_ORDER::COL_MAJOR);
+          }
+          break;
+        }
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
       }
   }
 
@@ -0,0 +1,572 @@
+#ifndef VIENNACL_GENERATOR_HOST_BASED_GENERATE_HPP
+#define VIENNACL_GENERATOR_HOST_BASED_GENERATE_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/generator/host_based/generate.hpp
+    @brief The host counterpart of the code generator: Executes statements on buffers in main memory with fused element-wise and reduction loops.
+
+    The expression tree of a statement is translated into a program of element-wise instructions, which is interpreted block by block (see viennacl/scheduler/execute_fused.hpp).
+    Programs are cached by the shape of the statement, i.e. its operations, the kinds of its operands, and which operands are the same object,
+    so that the translation is carried out only once for all statements of the same shape.
+    Similar to the kernels created by the OpenCL code generator, consecutive statements of the same size are executed in a single pass over their operands.
+*/
+
+#include <string>
+#include <map>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/scheduler/forwards.h"
+#include "viennacl/scheduler/execute.hpp"
+#include "viennacl/scheduler/execute_fused.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+
+namespace viennacl
+{
+  namespace generator
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        using scheduler::detail::fused_operand;
+        using scheduler::detail::fused_instruction;
+        using scheduler::detail::fused_program;
+        using scheduler::detail::fused_statement;
+        using scheduler::detail::fused_segment;
+
+        /** @brief A statement translated into element-wise instructions. Operands are referred to by their position in the statement, hence the program applies to all statements of the same shape. */
+        struct host_program
+        {
+          host_program() : valid(false) {}
+
+          bool                             valid;          // false if the statement cannot be executed with fused loops
+          std::vector<fused_instruction>   instructions;
+          fused_operand                    lhs;            // value assigned to the result, or first operand of the inner product
+          fused_operand                    rhs;            // second operand of the inner product
+        };
+
+        /** @brief Returns the address of a dense vector or matrix in the statement, NULL for all other elements */
+        inline void const * array_object(scheduler::lhs_rhs_element const & elem)
+        {
+          switch (elem.subtype)
+          {
+            case scheduler::DENSE_VECTOR_TYPE:
+              return (elem.numeric_type == scheduler::FLOAT_TYPE) ? static_cast<void const *>(elem.vector_float) : static_cast<void const *>(elem.vector_double);
+            case scheduler::DENSE_ROW_MATRIX_TYPE:
+              return (elem.numeric_type == scheduler::FLOAT_TYPE) ? static_cast<void const *>(elem.matrix_row_float) : static_cast<void const *>(elem.matrix_row_double);
+            case scheduler::DENSE_COL_MATRIX_TYPE:
+              return (elem.numeric_type == scheduler::FLOAT_TYPE) ? static_cast<void const *>(elem.matrix_col_float) : static_cast<void const *>(elem.matrix_col_double);
+            default:
+              return NULL;
+          }
+        }
+
+        /** @brief Returns the position of the vector or matrix in the list of distinct operands */
+        inline std::size_t array_index(std::vector<scheduler::lhs_rhs_element> const & arrays, scheduler::lhs_rhs_element const & elem)
+        {
+          void const * object = array_object(elem);
+          std::size_t i = 0;
+          for (; i < arrays.size(); ++i)
+            if (array_object(arrays[i]) == object)
+              break;
+          return i;
+        }
+
+        inline void append_number(std::string & key, std::size_t value)
+        {
+          do
+          {
+            key += static_cast<char>('0' + value % 10);
+            value /= 10;
+          } while (value > 0);
+          key += '.';
+        }
+
+        /** @brief Appends the shape of the subexpression to 'key' and collects the distinct vectors and matrices as well as the scalars in the order of their appearance.
+        *
+        * Returns false if the subexpression contains other operands than dense vectors, dense matrices, and scalars.
+        */
+        inline bool append_shape(scheduler::statement const & s, scheduler::lhs_rhs_element const & elem, std::string & key,
+                                 std::vector<scheduler::lhs_rhs_element> & arrays, std::vector<scheduler::lhs_rhs_element> & scalars)
+        {
+          switch (elem.type_family)
+          {
+            case scheduler::SCALAR_TYPE_FAMILY:
+              if (elem.subtype != scheduler::HOST_SCALAR_TYPE && elem.subtype != scheduler::DEVICE_SCALAR_TYPE)
+                return false;
+              key += 's';
+              scalars.push_back(elem);
+              return true;
+
+            case scheduler::VECTOR_TYPE_FAMILY:
+            case scheduler::MATRIX_TYPE_FAMILY:
+            {
+              if (array_object(elem) == NULL)
+                return false;
+
+              std::size_t index = array_index(arrays, elem);
+              if (index == arrays.size())
+                arrays.push_back(elem);
+              key += (elem.type_family == scheduler::VECTOR_TYPE_FAMILY) ? 'v' : 'm';
+              append_number(key, index);
+              return true;
+            }
+
+            case scheduler::COMPOSITE_OPERATION_FAMILY:
+            {
+              scheduler::statement_node const & node = s.array()[elem.node_index];
+              key += '(';
+              append_number(key, static_cast<std::size_t>(node.op.type));
+              if (!append_shape(s, node.lhs, key, arrays, scalars))
+                return false;
+              if (node.op.type_family != scheduler::OPERATION_UNARY_TYPE_FAMILY && !append_shape(s, node.rhs, key, arrays, scalars))
+                return false;
+              key += ')';
+              return true;
+            }
+
+            default:
+              return false;
+          }
+        }
+
+        /** @brief Appends the instructions for the subexpression 'elem' to the program. Returns false if the subexpression contains operations which cannot be applied element-wise. */
+        inline bool compile_host_program(scheduler::statement const & s, scheduler::lhs_rhs_element const & elem, std::vector<scheduler::lhs_rhs_element> const & arrays,
+                                         std::size_t & num_scalars, host_program & program, fused_operand & result)
+        {
+          switch (elem.type_family)
+          {
+            case scheduler::SCALAR_TYPE_FAMILY:
+              result = fused_operand(fused_operand::SCALAR_OPERAND, num_scalars++);
+              return true;
+
+            case scheduler::VECTOR_TYPE_FAMILY:
+            case scheduler::MATRIX_TYPE_FAMILY:
+              result = fused_operand(fused_operand::VECTOR_OPERAND, array_index(arrays, elem));
+              return true;
+
+            case scheduler::COMPOSITE_OPERATION_FAMILY:
+            {
+              scheduler::statement_node const & node = s.array()[elem.node_index];
+
+              fused_instruction instruction;
+              instruction.op = node.op.type;
+              if (!compile_host_program(s, node.lhs, arrays, num_scalars, program, instruction.lhs))
+                return false;
+
+              bool lhs_is_scalar = (instruction.lhs.type == fused_operand::SCALAR_OPERAND);
+              if (node.op.type_family == scheduler::OPERATION_UNARY_TYPE_FAMILY)
+              {
+                if (!scheduler::detail::is_fusable_unary_operation(node.op.type) || lhs_is_scalar)
+                  return false;
+              }
+              else
+              {
+                if (!compile_host_program(s, node.rhs, arrays, num_scalars, program, instruction.rhs))
+                  return false;
+                if (!scheduler::detail::is_fusable_binary_operation(node.op.type, lhs_is_scalar, instruction.rhs.type == fused_operand::SCALAR_OPERAND))
+                  return false;
+              }
+
+              program.instructions.push_back(instruction);
+              result = fused_operand(fused_operand::RESULT_OPERAND, program.instructions.size() - 1);
+              return true;
+            }
+
+            default:
+              return false;
+          }
+        }
+
+        /** @brief Translates the statement x = RHS (also +=, -=) with a vector or matrix x, or alpha = inner_prod(RHS1, RHS2) (also +=, -=), into a program */
+        inline void compile_host_program(scheduler::statement const & s, scheduler::statement_node const & root_node,
+                                         std::vector<scheduler::lhs_rhs_element> const & arrays, host_program & program)
+        {
+          std::size_t num_scalars = 0;
+          if (root_node.lhs.type_family == scheduler::SCALAR_TYPE_FAMILY)
+          {
+            scheduler::statement_node const & node = s.array()[root_node.rhs.node_index];
+            program.valid =    compile_host_program(s, node.lhs, arrays, num_scalars, program, program.lhs)
+                            && compile_host_program(s, node.rhs, arrays, num_scalars, program, program.rhs)
+                            && program.lhs.type != fused_operand::SCALAR_OPERAND
+                            && program.rhs.type != fused_operand::SCALAR_OPERAND;
+          }
+          else
+            program.valid =    compile_host_program(s, root_node.rhs, arrays, num_scalars, program, program.lhs)
+                            && program.lhs.type != fused_operand::SCALAR_OPERAND;
+        }
+
+        /** @brief Returns the program for the statement with the provided shape, which is translated on first use */
+        inline host_program const & get_host_program(std::string const & key, scheduler::statement const & s, scheduler::statement_node const & root_node,
+                                                     std::vector<scheduler::lhs_rhs_element> const & arrays)
+        {
+          static std::map<std::string, host_program> programs;
+
+          host_program const * program = NULL;
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp critical (viennacl_generator_host_programs)
+#endif
+          {
+            std::map<std::string, host_program>::iterator it = programs.find(key);
+            if (it == programs.end())
+            {
+              host_program new_program;
+              compile_host_program(s, root_node, arrays, new_program);
+              it = programs.insert(std::make_pair(key, new_program)).first;
+            }
+            program = &(it->second);
+          }
+          return *program;
+        }
+
+
+        inline viennacl::matrix_base<float,  viennacl::row_major>    * row_matrix(scheduler::lhs_rhs_element const & elem, float)  { return elem.matrix_row_float; }
+        inline viennacl::matrix_base<double, viennacl::row_major>    * row_matrix(scheduler::lhs_rhs_element const & elem, double) { return elem.matrix_row_double; }
+
+        inline viennacl::matrix_base<float,  viennacl::column_major> * col_matrix(scheduler::lhs_rhs_element const & elem, float)  { return elem.matrix_col_float; }
+        inline viennacl::matrix_base<double, viennacl::column_major> * col_matrix(scheduler::lhs_rhs_element const & elem, double) { return elem.matrix_col_double; }
+
+        /** @brief Raw data of a vector or matrix in main memory: The entry (i,j) is located at data[start + i * inc1 + j * inc2]. Vectors are treated as a single column. */
+        template <typename NumericT>
+        struct array_layout
+        {
+          NumericT   * data;
+          long         start;
+          long         inc1;
+          long         inc2;
+          vcl_size_t   size1;
+          vcl_size_t   size2;
+        };
+
+        template <typename NumericT>
+        bool get_layout(viennacl::vector_base<NumericT> & vec, array_layout<NumericT> & layout)
+        {
+          if (viennacl::traits::handle(vec).get_active_handle_id() != viennacl::MAIN_MEMORY)
+            return false;
+
+          layout.data  = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec);
+          layout.start = static_cast<long>(viennacl::traits::start(vec));
+          layout.inc1  = static_cast<long>(viennacl::traits::stride(vec));
+          layout.inc2  = 0;
+          layout.size1 = vec.size();
+          layout.size2 = 1;
+          return true;
+        }
+
+        template <typename NumericT>
+        bool get_layout(viennacl::matrix_base<NumericT, viennacl::row_major> & mat, array_layout<NumericT> & layout)
+        {
+          if (viennacl::traits::handle(mat).get_active_handle_id() != viennacl::MAIN_MEMORY)
+            return false;
+
+          long internal_size2 = static_cast<long>(viennacl::traits::internal_size2(mat));
+          layout.data  = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(mat);
+          layout.start = static_cast<long>(viennacl::traits::start1(mat)) * internal_size2 + static_cast<long>(viennacl::traits::start2(mat));
+          layout.inc1  = static_cast<long>(viennacl::traits::stride1(mat)) * internal_size2;
+          layout.inc2  = static_cast<long>(viennacl::traits::stride2(mat));
+          layout.size1 = mat.size1();
+          layout.size2 = mat.size2();
+          return true;
+        }
+
+        template <typename NumericT>
+        bool get_layout(viennacl::matrix_base<NumericT, viennacl::column_major> & mat, array_layout<NumericT> & layout)
+        {
+          if (viennacl::traits::handle(mat).get_active_handle_id() != viennacl::MAIN_MEMORY)
+            return false;
+
+          long internal_size1 = static_cast<long>(viennacl::traits::internal_size1(mat));
+          layout.data  = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(mat);
+          layout.start = static_cast<long>(viennacl::traits::start1(mat)) + static_cast<long>(viennacl::traits::start2(mat)) * internal_size1;
+          layout.inc1  = static_cast<long>(viennacl::traits::stride1(mat));
+          layout.inc2  = static_cast<long>(viennacl::traits::stride2(mat)) * internal_size1;
+          layout.size1 = mat.size1();
+          layout.size2 = mat.size2();
+          return true;
+        }
+
+        /** @brief Sets up the layout of a dense vector or matrix of the provided numeric type in main memory. Returns false for all other elements. */
+        template <typename NumericT>
+        bool get_layout(scheduler::lhs_rhs_element const & elem, array_layout<NumericT> & layout)
+        {
+          if (elem.numeric_type != scheduler::statement_node_numeric_type(scheduler::result_of::numeric_type_id<NumericT>::value))
+            return false;
+
+          switch (elem.subtype)
+          {
+            case scheduler::DENSE_VECTOR_TYPE:     return get_layout(*scheduler::detail::fused_result_vector(elem, NumericT()), layout);
+            case scheduler::DENSE_ROW_MATRIX_TYPE: return get_layout(*row_matrix(elem, NumericT()), layout);
+            case scheduler::DENSE_COL_MATRIX_TYPE: return get_layout(*col_matrix(elem, NumericT()), layout);
+            default:                               return false;
+          }
+        }
+
+        /** @brief Sets up the statement for execution with fused loops: The program is taken from the cache, the raw data of all operands and the values of all scalars are extracted.
+        *
+        * The operands are traversed row by row if the result is a row-major matrix, and column by column otherwise.
+        * Returns false if the statement cannot be executed with fused loops.
+        */
+        template <typename NumericT>
+        bool prepare_statement(scheduler::statement const & s, scheduler::statement_node const & root_node,
+                               fused_statement<NumericT> & fs, vcl_size_t & num_rows, vcl_size_t & row_size)
+        {
+          if (   root_node.op.type != scheduler::OPERATION_BINARY_ASSIGN_TYPE
+              && root_node.op.type != scheduler::OPERATION_BINARY_INPLACE_ADD_TYPE
+              && root_node.op.type != scheduler::OPERATION_BINARY_INPLACE_SUB_TYPE)
+            return false;
+
+          std::string key;
+          std::vector<scheduler::lhs_rhs_element> arrays;
+          std::vector<scheduler::lhs_rhs_element> scalars;
+
+          // the shape of the left hand side and of the assignment:
+          bool row_major_traversal = false;
+          switch (root_node.lhs.subtype)
+          {
+            case scheduler::DENSE_VECTOR_TYPE:     key += 'v'; break;
+            case scheduler::DENSE_ROW_MATRIX_TYPE: key += 'm'; row_major_traversal = true; break;
+            case scheduler::DENSE_COL_MATRIX_TYPE: key += 'm'; break;
+            case scheduler::DEVICE_SCALAR_TYPE:
+            {
+              if (   root_node.rhs.type_family != scheduler::COMPOSITE_OPERATION_FAMILY
+                  || s.array()[root_node.rhs.node_index].op.type != scheduler::OPERATION_BINARY_INNER_PROD_TYPE)
+                return false;
+              key += 's';
+              break;
+            }
+            default:
+              return false;
+          }
+          append_number(key, static_cast<std::size_t>(root_node.op.type));
+
+          if (!append_shape(s, root_node.rhs, key, arrays, scalars))
+            return false;
+
+          host_program const & program = get_host_program(key, s, root_node, arrays);
+          if (!program.valid)
+            return false;
+
+          // the result:
+          array_layout<NumericT> result_layout;
+          fs.assign_op = root_node.op.type;
+          if (root_node.lhs.type_family == scheduler::SCALAR_TYPE_FAMILY)
+          {
+            if (root_node.lhs.numeric_type != scheduler::statement_node_numeric_type(scheduler::result_of::numeric_type_id<NumericT>::value))
+              return false;
+            fs.alpha = scheduler::detail::fused_result_scalar(root_node.lhs, NumericT());
+            if (viennacl::traits::handle(*fs.alpha).get_active_handle_id() != viennacl::MAIN_MEMORY)
+              return false;
+
+            // the inner product has the dimensions of its (vector) operands:
+            if (arrays.empty() || arrays[0].type_family != scheduler::VECTOR_TYPE_FAMILY || !get_layout(arrays[0], result_layout))
+              return false;
+          }
+          else
+          {
+            if (!get_layout(root_node.lhs, result_layout))
+              return false;
+
+            fs.x_data = result_layout.data;
+            if (root_node.lhs.type_family == scheduler::VECTOR_TYPE_FAMILY)
+              fs.x = scheduler::detail::fused_result_vector(root_node.lhs, NumericT());
+          }
+
+          num_rows = row_major_traversal ? result_layout.size1 : result_layout.size2;
+          row_size = row_major_traversal ? result_layout.size2 : result_layout.size1;
+          if (!fs.alpha)
+          {
+            fs.x_start   = result_layout.start;
+            fs.x_inc     = row_major_traversal ? result_layout.inc2 : result_layout.inc1;
+            fs.x_row_inc = row_major_traversal ? result_layout.inc1 : result_layout.inc2;
+          }
+
+          // the operands:
+          fused_program<NumericT> & p = fs.program;
+          p.data.resize(arrays.size());
+          p.start.resize(arrays.size());
+          p.inc.resize(arrays.size());
+          p.row_inc.resize(arrays.size());
+          for (std::size_t j = 0; j < arrays.size(); ++j)
+          {
+            array_layout<NumericT> layout;
+            if (   arrays[j].type_family != (fs.alpha ? scheduler::VECTOR_TYPE_FAMILY : root_node.lhs.type_family)
+                || !get_layout(arrays[j], layout)
+                || layout.size1 != result_layout.size1
+                || layout.size2 != result_layout.size2)
+              return false;
+
+            p.data[j]    = layout.data;
+            p.start[j]   = layout.start;
+            p.inc[j]     = row_major_traversal ? layout.inc2 : layout.inc1;
+            p.row_inc[j] = row_major_traversal ? layout.inc1 : layout.inc2;
+          }
+
+          p.scalars.resize(scalars.size());
+          for (std::size_t i = 0; i < scalars.size(); ++i)
+            if (!scheduler::detail::fused_scalar_value(scalars[i], p.scalars[i]))
+              return false;
+          p.scalar_operands = scalars;
+
+          p.instructions = program.instructions;
+          fs.lhs = program.lhs;
+          fs.rhs = program.rhs;
+          return true;
+        }
+
+        /** @brief Returns true if the statement can be executed with fused loops in its current state */
+        inline bool is_supported(scheduler::statement const & s, scheduler::statement_node const & root_node)
+        {
+          vcl_size_t num_rows = 0;
+          vcl_size_t row_size = 0;
+          switch (root_node.lhs.numeric_type)
+          {
+            case scheduler::FLOAT_TYPE:
+            {
+              fused_statement<float> fs;
+              return prepare_statement(s, root_node, fs, num_rows, row_size);
+            }
+            case scheduler::DOUBLE_TYPE:
+            {
+              fused_statement<double> fs;
+              return prepare_statement(s, root_node, fs, num_rows, row_size);
+            }
+            default:
+              return false;
+          }
+        }
+
+        /** @brief Appends the statement to the segment, which is executed first if the statement cannot be executed in the same pass. Statements which cannot be fused at all are executed by the scheduler. */
+        template <typename NumericT>
+        void enqueue_statement(scheduler::statement const & s, scheduler::statement_node const & root_node, fused_segment<NumericT> & segment)
+        {
+          fused_statement<NumericT> fs;
+          vcl_size_t num_rows = 0;
+          vcl_size_t row_size = 0;
+          if (prepare_statement(s, root_node, fs, num_rows, row_size))
+          {
+            if (segment.append(fs, num_rows, row_size))
+              return;
+
+            segment.execute();
+            segment.clear();
+
+            // scalar operands may have been computed by the segment:
+            scheduler::detail::load_fused_scalars(fs.program);
+            if (segment.append(fs, num_rows, row_size))
+              return;
+          }
+
+          segment.execute();
+          segment.clear();
+          scheduler::detail::execute_impl(s, root_node);
+        }
+
+      } // namespace detail
+
+
+      /** @brief The host counterpart of viennacl::generator::code_generator: Executes statements on buffers in main memory with fused loops.
+      *
+      * Supported are element-wise operations on dense vectors or matrices (x = RHS, also +=, -=) and inner products of element-wise vector expressions (alpha = inner_prod(RHS1, RHS2), also +=, -=).
+      */
+      class code_generator
+      {
+        public:
+          typedef std::vector<std::pair<scheduler::statement, scheduler::statement_node> >   statements_type;
+
+          /** @brief Add a statement and the root node to the expression list
+          *   @return Whether or not the operation could be handled by the generator
+          */
+          bool add(scheduler::statement const & statement, scheduler::statement_node const & root_node)
+          {
+            if (!detail::is_supported(statement, root_node))
+              return false;
+            statements_.push_back(std::make_pair(statement, root_node));
+            return true;
+          }
+
+          statements_type const & statements() const { return statements_; }
+
+          void clear() { statements_.clear(); }
+
+        private:
+          statements_type statements_;
+      };
+
+      /** @brief Executes the statements of a generator object in the order they were added. Consecutive statements of the same size are executed in a single pass over their operands. */
+      inline void enqueue(code_generator const & generator)
+      {
+        scheduler::detail::fused_segment<float>  float_segment;
+        scheduler::detail::fused_segment<double> double_segment;
+
+        code_generator::statements_type const & statements = generator.statements();
+        for (std::size_t i = 0; i < statements.size(); ++i)
+        {
+          scheduler::statement const & s = statements[i].first;
+          scheduler::statement_node const & root_node = statements[i].second;
+
+          // pending statements of the other numeric type are executed first in order to preserve the order of the statements:
+          if (root_node.lhs.numeric_type == scheduler::FLOAT_TYPE)
+          {
+            double_segment.execute();
+            double_segment.clear();
+            detail::enqueue_statement(s, root_node, float_segment);
+          }
+          else
+          {
+            float_segment.execute();
+            float_segment.clear();
+            detail::enqueue_statement(s, root_node, double_segment);
+          }
+        }
+
+        float_segment.execute();
+        double_segment.execute();
+      }
+
+      /** @brief Executes a statement+root_node with fused loops, or by the scheduler if not supported */
+      inline void generate_enqueue_statement(scheduler::statement const & s, scheduler::statement_node const & root_node)
+      {
+        code_generator gen;
+        if (gen.add(s, root_node))
+          viennacl::generator::host_based::enqueue(gen);
+        else
+          scheduler::detail::execute_impl(s, root_node);
+      }
+
+      /** @brief Executes a statement with fused loops, assumes the root_node is the first node of the statement */
+      inline void generate_enqueue_statement(scheduler::statement const & s)
+      {
+        generate_enqueue_statement(s, s.array()[0]);
+      }
+
+    } // namespace host_based
+  } // namespace generator
+} // namespace viennacl
+
+#endif
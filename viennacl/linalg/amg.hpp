@@ -37,10 +37,13 @@
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
 
 #include "viennacl/linalg/detail/amg/amg_base.hpp"
 #include "viennacl/linalg/detail/amg/amg_coarse.hpp"
 #include "viennacl/linalg/detail/amg/amg_interpol.hpp"
+#include "viennacl/linalg/detail/amg/amg_cycle.hpp"
 
 #include <map>
 
@@ -74,7 +77,7 @@ namespace viennacl
       typedef typename InternalType2::value_type PointVectorType;
 
       unsigned int i, iterations, c_points, f_points;
-      detail::amg::amg_slicing<InternalType1,InternalType2> Slicing;
+      detail::amg::amg_slicing Slicing;
 
       // Set number of iterations. If automatic coarse grid construction is chosen (0), then set a maximum size and stop during the process.
       iterations = tag.get_coarselevels();
@@ -87,9 +90,8 @@ namespace viennacl
 
       for (i=0; i<iterations; ++i)
       {
-        // Initialize Pointvector on level i and construct points.
+        // Initialize Pointvector on level i.
         Pointvector[i] = PointVectorType(A[i].size1());
-        Pointvector[i].init_points();
 
         // Construct C and F points on coarse level (i is fine level, i+1 coarse level).
         detail::amg::amg_coarse (i, A, Pointvector, Slicing, tag);
@@ -114,10 +116,8 @@ namespace viennacl
         // Compute coarse grid operator (A[i+1] = R * A[i] * P) with R = trans(P).
         detail::amg::amg_galerkin_prod(A[i], P[i], A[i+1]);
 
-        // Test triple matrix product. Very slow for large matrix sizes (ublas).
-        // test_triplematprod(A[i],P[i],A[i+1]);
-
-        Pointvector[i].delete_points();
+        // Influence graphs are no longer needed once the coarse level is built.
+        Pointvector[i].clear_influencelists();
 
         #ifdef VIENNACL_AMG_DEBUG
         std::cout << "Coarse Grid Operator Matrix:" << std::endl;
@@ -166,45 +166,6 @@ namespace viennacl
       A.insert_element (0, A0);
     }
 
-    /** @brief Save operators after setup phase for CPU computation.
-    *
-    * @param A      Operator matrices on all levels on the CPU
-    * @param P      Prolongation/Interpolation operators on all levels on the CPU
-    * @param R      Restriction operators on all levels on the CPU
-    * @param A_setup    Operators matrices on all levels from setup phase
-    * @param P_setup    Prolongation/Interpolation operators on all levels from setup phase
-    * @param tag    AMG preconditioner tag
-    */
-    template <typename InternalType1, typename InternalType2>
-    void amg_transform_cpu (InternalType1 & A, InternalType1 & P, InternalType1 & R, InternalType2 & A_setup, InternalType2 & P_setup, amg_tag & tag)
-    {
-      //typedef typename InternalType1::value_type MatrixType;
-
-      // Resize internal data structures to actual size.
-      A.resize(tag.get_coarselevels()+1);
-      P.resize(tag.get_coarselevels());
-      R.resize(tag.get_coarselevels());
-
-      // Transform into matrix type.
-      for (unsigned int i=0; i<tag.get_coarselevels()+1; ++i)
-      {
-        A[i].resize(A_setup[i].size1(),A_setup[i].size2(),false);
-        A[i] = A_setup[i];
-      }
-      for (unsigned int i=0; i<tag.get_coarselevels(); ++i)
-      {
-        P[i].resize(P_setup[i].size1(),P_setup[i].size2(),false);
-        P[i] = P_setup[i];
-      }
-      for (unsigned int i=0; i<tag.get_coarselevels(); ++i)
-      {
-        R[i].resize(P_setup[i].size2(),P_setup[i].size1(),false);
-        P_setup[i].set_trans(true);
-        R[i] = P_setup[i];
-        P_setup[i].set_trans(false);
-      }
-    }
-
     /** @brief Save operators after setup phase for GPU computation.
     *
     * @param A      Operator matrices on all levels on the GPU
@@ -223,62 +184,26 @@ namespace viennacl
       P.resize(tag.get_coarselevels());
       R.resize(tag.get_coarselevels());
 
-      // Copy to GPU using the internal sparse matrix structure: std::vector<std::map>.
+      // Copy the CSR arrays of the setup phase directly to the device.
       for (unsigned int i=0; i<tag.get_coarselevels()+1; ++i)
       {
         viennacl::switch_memory_context(A[i], ctx);
-        //A[i].resize(A_setup[i].size1(),A_setup[i].size2(),false);
-        viennacl::copy(*(A_setup[i].get_internal_pointer()),A[i]);
+        detail::amg::amg_copy(A_setup[i], A[i]);
       }
       for (unsigned int i=0; i<tag.get_coarselevels(); ++i)
       {
         viennacl::switch_memory_context(P[i], ctx);
-        //P[i].resize(P_setup[i].size1(),P_setup[i].size2(),false);
-        viennacl::copy(*(P_setup[i].get_internal_pointer()),P[i]);
-        //viennacl::copy((boost::numeric::ublas::compressed_matrix<ScalarType>)P_setup[i],P[i]);
+        detail::amg::amg_copy(P_setup[i], P[i]);
       }
       for (unsigned int i=0; i<tag.get_coarselevels(); ++i)
       {
         viennacl::switch_memory_context(R[i], ctx);
-        //R[i].resize(P_setup[i].size2(),P_setup[i].size1(),false);
-        P_setup[i].set_trans(true);
-        viennacl::copy(*(P_setup[i].get_internal_pointer()),R[i]);
-        P_setup[i].set_trans(false);
+        typename InternalType2::value_type R_setup;
+        P_setup[i].trans(R_setup);
+        detail::amg::amg_copy(R_setup, R[i]);
       }
     }
 
-    /** @brief Setup data structures for precondition phase.
-    *
-    * @param result    Result vector on all levels
-    * @param rhs    RHS vector on all levels
-    * @param residual    Residual vector on all levels
-    * @param A      Operators matrices on all levels from setup phase
-    * @param tag    AMG preconditioner tag
-    */
-    template <typename InternalVectorType, typename SparseMatrixType>
-    void amg_setup_apply (InternalVectorType & result, InternalVectorType & rhs, InternalVectorType & residual, SparseMatrixType const & A, amg_tag const & tag)
-    {
-      typedef typename InternalVectorType::value_type VectorType;
-
-      result.resize(tag.get_coarselevels()+1);
-      rhs.resize(tag.get_coarselevels()+1);
-      residual.resize(tag.get_coarselevels());
-
-      for (unsigned int level=0; level < tag.get_coarselevels()+1; ++level)
-      {
-        result[level] = VectorType(A[level].size1());
-        result[level].clear();
-        rhs[level] = VectorType(A[level].size1());
-        rhs[level].clear();
-      }
-      for (unsigned int level=0; level < tag.get_coarselevels(); ++level)
-      {
-        residual[level] = VectorType(A[level].size1());
-        residual[level].clear();
-      }
-    }
-
-
     /** @brief Setup data structures for precondition phase for later use on the GPU
     *
     * @param result    Result vector on all levels
@@ -309,71 +234,33 @@ namespace viennacl
     }
 
 
-    /** @brief Pre-compute LU factorization for direct solve (ublas library).
-     *  @brief Speeds up precondition phase as this is computed only once overall instead of once per iteration.
-    *
-    * @param op      Operator matrix for direct solve
-    * @param Permutation  Permutation matrix which saves the factorization result
-    * @param A      Operator matrix on coarsest level
-    */
-    template <typename ScalarType, typename SparseMatrixType>
-    void amg_lu(boost::numeric::ublas::compressed_matrix<ScalarType> & op, boost::numeric::ublas::permutation_matrix<> & Permutation, SparseMatrixType const & A)
-    {
-      typedef typename SparseMatrixType::const_iterator1 ConstRowIterator;
-      typedef typename SparseMatrixType::const_iterator2 ConstColIterator;
-
-      // Copy to operator matrix. Needed
-      op.resize(A.size1(),A.size2(),false);
-      for (ConstRowIterator row_iter = A.begin1(); row_iter != A.end1(); ++row_iter)
-        for (ConstColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-          op (col_iter.index1(), col_iter.index2()) = *col_iter;
-
-      // Permutation matrix has to be reinitialized with actual size. Do not clear() or resize()!
-      Permutation = boost::numeric::ublas::permutation_matrix<> (op.size1());
-      boost::numeric::ublas::lu_factorize(op,Permutation);
-    }
-
     /** @brief AMG preconditioner class, can be supplied to solve()-routines
     */
     template <typename MatrixType>
     class amg_precond
     {
       typedef typename MatrixType::value_type ScalarType;
-      typedef boost::numeric::ublas::vector<ScalarType> VectorType;
       typedef detail::amg::amg_sparsematrix<ScalarType> SparseMatrixType;
       typedef detail::amg::amg_pointvector PointVectorType;
 
-      typedef typename SparseMatrixType::const_iterator1 InternalConstRowIterator;
-      typedef typename SparseMatrixType::const_iterator2 InternalConstColIterator;
-      typedef typename SparseMatrixType::iterator1 InternalRowIterator;
-      typedef typename SparseMatrixType::iterator2 InternalColIterator;
-
       boost::numeric::ublas::vector <SparseMatrixType> A_setup;
       boost::numeric::ublas::vector <SparseMatrixType> P_setup;
-      boost::numeric::ublas::vector <MatrixType> A;
-      boost::numeric::ublas::vector <MatrixType> P;
-      boost::numeric::ublas::vector <MatrixType> R;
       boost::numeric::ublas::vector <PointVectorType> Pointvector;
 
-      mutable boost::numeric::ublas::compressed_matrix<ScalarType> op;
-      mutable boost::numeric::ublas::permutation_matrix<> Permutation;
-
-      mutable boost::numeric::ublas::vector <VectorType> result;
-      mutable boost::numeric::ublas::vector <VectorType> rhs;
-      mutable boost::numeric::ublas::vector <VectorType> residual;
+      mutable detail::amg::amg_host_cycle<ScalarType> host_cycle_;
 
       mutable bool done_init_apply;
 
-      amg_tag tag_;
+      mutable amg_tag tag_;    // accumulates the timings of the precondition phase
     public:
 
-      amg_precond(): Permutation(0) {}
+      amg_precond(): done_init_apply(false) {}
       /** @brief The constructor. Saves system matrix, tag and builds data structures for setup.
       *
       * @param mat  System matrix
       * @param tag  The AMG tag
       */
-      amg_precond(MatrixType const & mat, amg_tag const & tag): Permutation(0)
+      amg_precond(MatrixType const & mat, amg_tag const & tag)
       {
         tag_ = tag;
         // Initialize data structures.
@@ -386,24 +273,19 @@ namespace viennacl
       */
       void setup()
       {
-        // Start setup phase.
+        // Start setup phase. The precondition phase works on the operators of the setup phase directly.
         amg_setup(A_setup,P_setup,Pointvector,tag_);
-        // Transform to CPU-Matrixtype for precondition phase.
-        amg_transform_cpu(A,P,R,A_setup,P_setup,tag_);
 
         done_init_apply = false;
       }
 
       /** @brief Prepare data structures for preconditioning:
-       *  Build data structures for precondition phase.
+       *  Build work vectors, restriction operators and smoothers on all levels.
        *  Do LU factorization on coarsest level.
       */
       void init_apply() const
       {
-        // Setup precondition phase (Data structures).
-        amg_setup_apply(result,rhs,residual,A_setup,tag_);
-        // Do LU factorization for direct solve.
-        amg_lu(op,Permutation,A_setup[tag_.get_coarselevels()]);
+        host_cycle_.init(A_setup, P_setup, tag_);
 
         done_init_apply = true;
       }
@@ -421,23 +303,16 @@ namespace viennacl
 
         for (unsigned int level=0; level < tag_.get_coarselevels()+1; ++level)
         {
-          level_coefficients = 0;
-          for (InternalRowIterator row_iter = A_setup[level].begin1(); row_iter != A_setup[level].end1(); ++row_iter)
-          {
-            for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-            {
-              if (level == 0)
-                systemmat_nonzero++;
-              nonzero++;
-              level_coefficients++;
-            }
-          }
+          level_coefficients = static_cast<unsigned int>(A_setup[level].nnz());
+          if (level == 0)
+            systemmat_nonzero = level_coefficients;
+          nonzero += level_coefficients;
           avgstencil[level] = level_coefficients/static_cast<ScalarType>(A_setup[level].size1());
         }
         return nonzero/static_cast<ScalarType>(systemmat_nonzero);
       }
 
-      /** @brief Precondition Operation
+      /** @brief Precondition Operation: Applies one V- or W-cycle (Yang, p.3) with the smoother selected in the tag.
       *
       * @param vec The vector to which preconditioning is applied to (ublas version)
       */
@@ -448,110 +323,7 @@ namespace viennacl
         if (!done_init_apply)
           init_apply();
 
-        int level;
-
-        // Precondition operation (Yang, p.3)
-        rhs[0] = vec;
-        for (level=0; level <static_cast<int>(tag_.get_coarselevels()); level++)
-        {
-          result[level].clear();
-
-          // Apply Smoother presmooth_ times.
-          smooth_jacobi (level, tag_.get_presmooth(), result[level], rhs[level]);
-
-          #ifdef VIENNACL_AMG_DEBUG
-          std::cout << "After presmooth:" << std::endl;
-          printvector(result[level]);
-          #endif
-
-          // Compute residual.
-          residual[level] = rhs[level] - boost::numeric::ublas::prod (A[level],result[level]);
-
-          #ifdef VIENNACL_AMG_DEBUG
-          std::cout << "Residual:" << std::endl;
-          printvector(residual[level]);
-          #endif
-
-          // Restrict to coarse level. Restricted residual is RHS of coarse level.
-          rhs[level+1] = boost::numeric::ublas::prod (R[level],residual[level]);
-
-          #ifdef VIENNACL_AMG_DEBUG
-          std::cout << "Restricted Residual: " << std::endl;
-          printvector(rhs[level+1]);
-          #endif
-        }
-
-        // On highest level use direct solve to solve equation.
-        result[level] = rhs[level];
-        boost::numeric::ublas::lu_substitute(op,Permutation,result[level]);
-
-        #ifdef VIENNACL_AMG_DEBUG
-        std::cout << "After direct solve: " << std::endl;
-        printvector (result[level]);
-        #endif
-
-        for (level=tag_.get_coarselevels()-1; level >= 0; level--)
-        {
-          #ifdef VIENNACL_AMG_DEBUG
-          std::cout << "Coarse Error: " << std::endl;
-          printvector(result[level+1]);
-          #endif
-
-          // Interpolate error to fine level. Correct solution by adding error.
-          result[level] += boost::numeric::ublas::prod (P[level], result[level+1]);
-
-          #ifdef VIENNACL_AMG_DEBUG
-          std::cout << "Corrected Result: " << std::endl;
-          printvector (result[level]);
-          #endif
-
-          // Apply Smoother postsmooth_ times.
-          smooth_jacobi (level, tag_.get_postsmooth(), result[level], rhs[level]);
-
-          #ifdef VIENNACL_AMG_DEBUG
-          std::cout << "After postsmooth: " << std::endl;
-          printvector (result[level]);
-          #endif
-        }
-        vec = result[0];
-      }
-
-      /** @brief (Weighted) Jacobi Smoother (CPU version)
-      * @param level    Coarse level to which smoother is applied to
-      * @param iterations  Number of smoother iterations
-      * @param x     The vector smoothing is applied to
-      * @param rhs    The right hand side of the equation for the smoother
-      */
-      template <typename VectorType>
-      void smooth_jacobi(int level, int const iterations, VectorType & x, VectorType const & rhs) const
-      {
-        VectorType old_result (x.size());
-        unsigned int index;
-        ScalarType sum = 0, diag = 1;
-
-        for (int i=0; i<iterations; ++i)
-        {
-          old_result = x;
-          x.clear();
-#ifdef VIENNACL_WITH_OPENMP
-          #pragma omp parallel for private (sum,diag) shared (rhs,x)
-#endif
-          for (index=0; index<A_setup[level].size1(); ++index)
-          {
-            InternalConstRowIterator row_iter = A_setup[level].begin1();
-            row_iter += index;
-            sum = 0;
-            diag = 1;
-            for (InternalConstColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-            {
-              if (col_iter.index1() == col_iter.index2())
-                diag = *col_iter;
-              else
-                sum += *col_iter * old_result[col_iter.index2()];
-            }
-            x[index]= static_cast<ScalarType>(tag_.get_jacobiweight()) * (rhs[index] - sum) / diag + (1-static_cast<ScalarType>(tag_.get_jacobiweight())) * old_result[index];
-          }
-        }
+        host_cycle_.apply(A_setup, P_setup, &(vec[0]), tag_);
       }
 
       amg_tag & tag() { return tag_; }
@@ -569,11 +341,6 @@ namespace viennacl
       typedef detail::amg::amg_sparsematrix<ScalarType> SparseMatrixType;
       typedef detail::amg::amg_pointvector PointVectorType;
 
-      typedef typename SparseMatrixType::const_iterator1 InternalConstRowIterator;
-      typedef typename SparseMatrixType::const_iterator2 InternalConstColIterator;
-      typedef typename SparseMatrixType::iterator1 InternalRowIterator;
-      typedef typename SparseMatrixType::iterator2 InternalColIterator;
-
       boost::numeric::ublas::vector <SparseMatrixType> A_setup;
       boost::numeric::ublas::vector <SparseMatrixType> P_setup;
       boost::numeric::ublas::vector <MatrixType> A;
@@ -581,38 +348,34 @@ namespace viennacl
       boost::numeric::ublas::vector <MatrixType> R;
       boost::numeric::ublas::vector <PointVectorType> Pointvector;
 
-      mutable boost::numeric::ublas::compressed_matrix<ScalarType> op;
-      mutable boost::numeric::ublas::permutation_matrix<> Permutation;
+      mutable detail::amg::amg_host_cycle<ScalarType> host_cycle_;
 
       mutable boost::numeric::ublas::vector <VectorType> result;
       mutable boost::numeric::ublas::vector <VectorType> rhs;
       mutable boost::numeric::ublas::vector <VectorType> residual;
+      mutable boost::numeric::ublas::vector <ScalarType> coarse_result;
 
       viennacl::context ctx_;
 
       mutable bool done_init_apply;
 
-      amg_tag tag_;
+      mutable amg_tag tag_;    // accumulates the timings of the precondition phase
 
     public:
 
-      amg_precond(): Permutation(0) {}
+      amg_precond(): done_init_apply(false) {}
 
       /** @brief The constructor. Builds data structures.
       *
       * @param mat  System matrix
       * @param tag  The AMG tag
       */
-      amg_precond(compressed_matrix<ScalarType, MAT_ALIGNMENT> const & mat, amg_tag const & tag): Permutation(0), ctx_(viennacl::traits::context(mat))
+      amg_precond(compressed_matrix<ScalarType, MAT_ALIGNMENT> const & mat, amg_tag const & tag): ctx_(viennacl::traits::context(mat))
       {
         tag_ = tag;
 
-        // Copy to CPU. Internal structure of sparse matrix is used for copy operation.
-        std::vector<std::map<unsigned int, ScalarType> > mat2 = std::vector<std::map<unsigned int, ScalarType> >(mat.size1());
-        viennacl::copy(mat, mat2);
-
-        // Initialize data structures.
-        amg_init (mat2,A_setup,P_setup,Pointvector,tag_);
+        // Initialize data structures. The system matrix is read into the CSR format of the setup phase directly.
+        amg_init (mat,A_setup,P_setup,Pointvector,tag_);
 
         done_init_apply = false;
       }
@@ -623,8 +386,9 @@ namespace viennacl
       {
         // Start setup phase.
         amg_setup(A_setup,P_setup,Pointvector, tag_);
-        // Transform to GPU-Matrixtype for precondition phase.
-        amg_transform_gpu(A,P,R,A_setup,P_setup, tag_, ctx_);
+        // Transform to GPU-Matrixtype for precondition phase. In main memory the operators of the setup phase are used directly.
+        if (ctx_.memory_type() != viennacl::MAIN_MEMORY)
+          amg_transform_gpu(A,P,R,A_setup,P_setup, tag_, ctx_);
 
         done_init_apply = false;
       }
@@ -635,10 +399,15 @@ namespace viennacl
       */
       void init_apply() const
       {
-        // Setup precondition phase (Data structures).
-        amg_setup_apply(result,rhs,residual,A_setup,tag_, ctx_);
-        // Do LU factorization for direct solve.
-        amg_lu(op,Permutation,A_setup[tag_.get_coarselevels()]);
+        // Work vectors, smoothers and LU factorization on the host. The direct solve on the coarsest level always runs on the host.
+        host_cycle_.init(A_setup, P_setup, tag_);
+
+        // Setup precondition phase (Data structures) on the device.
+        if (ctx_.memory_type() != viennacl::MAIN_MEMORY)
+        {
+          amg_setup_apply(result,rhs,residual,A_setup,tag_, ctx_);
+          coarse_result.resize(A_setup[tag_.get_coarselevels()].size1());
+        }
 
         done_init_apply = true;
       }
@@ -656,24 +425,20 @@ namespace viennacl
 
         for (unsigned int level=0; level < tag_.get_coarselevels()+1; ++level)
         {
-          level_coefficients = 0;
-          for (InternalRowIterator row_iter = A_setup[level].begin1(); row_iter != A_setup[level].end1(); ++row_iter)
-          {
-            for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-            {
-              if (level == 0)
-                systemmat_nonzero++;
-              nonzero++;
-              level_coefficients++;
-            }
-          }
-          avgstencil[level] = level_coefficients/(double)A[level].size1();
+          level_coefficients = static_cast<unsigned int>(A_setup[level].nnz());
+          if (level == 0)
+            systemmat_nonzero = level_coefficients;
+          nonzero += level_coefficients;
+          avgstencil[level] = level_coefficients/(double)A_setup[level].size1();
         }
         return nonzero/static_cast<double>(systemmat_nonzero);
       }
 
       /** @brief Precondition Operation
       *
+      *  In main memory, one V- or W-cycle with the smoother selected in the tag is applied on the host.
+      *  Otherwise, a V-cycle with damped Jacobi smoothing is applied on the device.
+      *
       * @param vec The vector to which preconditioning is applied to
       */
       template <typename VectorType>
@@ -682,6 +447,26 @@ namespace viennacl
         if (!done_init_apply)
           init_apply();
 
+        switch (viennacl::traits::active_handle_id(vec))
+        {
+          case viennacl::MAIN_MEMORY:
+            assert(viennacl::traits::stride(vec) == 1 && bool("AMG preconditioner requires a contiguous vector"));
+            host_cycle_.apply(A_setup, P_setup, viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(vec) + viennacl::traits::start(vec), tag_);
+            break;
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            apply_device(vec);
+        }
+      }
+
+      amg_tag & tag() { return tag_; }
+
+    private:
+      /** @brief V-cycle on the device (Yang, p.3). */
+      template <typename VectorType>
+      void apply_device(VectorType & vec) const
+      {
         int level;
 
         // Precondition operation (Yang, p.3).
@@ -695,7 +480,7 @@ namespace viennacl
 
           #ifdef VIENNACL_AMG_DEBUG
           std::cout << "After presmooth: " << std::endl;
-          printvector(result[level]);
+          detail::amg::printvector(result[level]);
           #endif
 
           // Compute residual.
@@ -705,7 +490,7 @@ namespace viennacl
 
           #ifdef VIENNACL_AMG_DEBUG
           std::cout << "Residual: " << std::endl;
-          printvector(residual[level]);
+          detail::amg::printvector(residual[level]);
           #endif
 
           // Restrict to coarse level. Result is RHS of coarse level equation.
@@ -714,29 +499,26 @@ namespace viennacl
 
           #ifdef VIENNACL_AMG_DEBUG
           std::cout << "Restricted Residual: " << std::endl;
-          printvector(rhs[level+1]);
+          detail::amg::printvector(rhs[level+1]);
           #endif
         }
 
         // On highest level use direct solve to solve equation (on the CPU)
         //TODO: Use GPU direct solve!
-        result[level] = rhs[level];
-        boost::numeric::ublas::vector <ScalarType> result_cpu (result[level].size());
-
-        copy (result[level],result_cpu);
-        boost::numeric::ublas::lu_substitute(op,Permutation,result_cpu);
-        copy (result_cpu, result[level]);
+        copy (rhs[level], coarse_result);
+        host_cycle_.coarse_solve(&(coarse_result[0]));
+        copy (coarse_result, result[level]);
 
         #ifdef VIENNACL_AMG_DEBUG
         std::cout << "After direct solve: " << std::endl;
-        printvector (result[level]);
+        detail::amg::printvector(result[level]);
         #endif
 
         for (level=tag_.get_coarselevels()-1; level >= 0; level--)
         {
           #ifdef VIENNACL_AMG_DEBUG
           std::cout << "Coarse Error: " << std::endl;
-          printvector(result[level+1]);
+          detail::amg::printvector(result[level+1]);
           #endif
 
           // Interpolate error to fine level and correct solution.
@@ -744,7 +526,7 @@ namespace viennacl
 
           #ifdef VIENNACL_AMG_DEBUG
           std::cout << "Corrected Result: " << std::endl;
-          printvector (result[level]);
+          detail::amg::printvector(result[level]);
           #endif
 
           // Apply Smoother postsmooth_ times.
@@ -752,7 +534,7 @@ namespace viennacl
 
           #ifdef VIENNACL_AMG_DEBUG
           std::cout << "After postsmooth: " << std::endl;
-          printvector (result[level]);
+          detail::amg::printvector(result[level]);
           #endif
         }
         vec = result[0];
@@ -768,27 +550,39 @@ namespace viennacl
       void smooth_jacobi(int level, unsigned int iterations, VectorType & x, VectorType const & rhs) const
       {
         VectorType old_result = x;
+        (void)level; (void)iterations; (void)rhs; //silence unused variable warnings if compiled without OpenCL support
 
-        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(x).context());
-        viennacl::linalg::opencl::kernels::compressed_matrix<ScalarType>::init(ctx);
-        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::compressed_matrix<ScalarType>::program_name(), "jacobi");
-
-        for (unsigned int i=0; i<iterations; ++i)
+        switch (viennacl::traits::active_handle_id(x))
         {
-          if (i > 0)
-            old_result = x;
-          x.clear();
-          viennacl::ocl::enqueue(k(A[level].handle1().opencl_handle(), A[level].handle2().opencl_handle(), A[level].handle().opencl_handle(),
-                                  static_cast<ScalarType>(tag_.get_jacobiweight()),
-                                  viennacl::traits::opencl_handle(old_result),
-                                  viennacl::traits::opencl_handle(x),
-                                  viennacl::traits::opencl_handle(rhs),
-                                  static_cast<cl_uint>(rhs.size())));
+#ifdef VIENNACL_WITH_OPENCL
+          case viennacl::OPENCL_MEMORY:
+          {
+            viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(x).context());
+            viennacl::linalg::opencl::kernels::compressed_matrix<ScalarType>::init(ctx);
+            viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::compressed_matrix<ScalarType>::program_name(), "jacobi");
+
+            for (unsigned int i=0; i<iterations; ++i)
+            {
+              if (i > 0)
+                old_result = x;
+              x.clear();
+              viennacl::ocl::enqueue(k(A[level].handle1().opencl_handle(), A[level].handle2().opencl_handle(), A[level].handle().opencl_handle(),
+                                      static_cast<ScalarType>(tag_.get_jacobiweight()),
+                                      viennacl::traits::opencl_handle(old_result),
+                                      viennacl::traits::opencl_handle(x),
+                                      viennacl::traits::opencl_handle(rhs),
+                                      static_cast<cl_uint>(rhs.size())));
 
+            }
+            break;
+          }
+#endif
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            throw memory_exception("not implemented");
         }
       }
-
-      amg_tag & tag() { return tag_; }
     };
 
   }
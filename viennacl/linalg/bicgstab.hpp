@@ -24,11 +24,14 @@
 
 #include <vector>
 #include <cmath>
+#include <algorithm>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/inner_prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/backend/memory.hpp"
 #include "viennacl/traits/clear.hpp"
 #include "viennacl/traits/size.hpp"
 #include "viennacl/meta/result_of.hpp"
@@ -79,6 +82,25 @@ namespace viennacl
     };
 
 
+    /** @brief A tag for the pipelined stabilized Bi-conjugate gradient solver. Used for supplying solver parameters and for dispatching the solve() function
+    *
+    * The pipelined variant computes all inner products within the two matrix-vector products and the vector update, so that only two synchronizations with the host
+    * are required per iteration, whereas the classical implementation requires five.
+    */
+    class pipelined_bicgstab_tag : public bicgstab_tag
+    {
+      public:
+        /** @brief The constructor
+        *
+        * @param tol              Relative tolerance for the residual (solver quits if ||r|| < tol * ||r_initial||)
+        * @param max_iters        The maximum number of iterations
+        * @param max_iters_before_restart   The maximum number of iterations before BiCGStab is reinitialized (to avoid accumulation of round-off errors)
+        */
+        pipelined_bicgstab_tag(double tol = 1e-8, std::size_t max_iters = 400, std::size_t max_iters_before_restart = 200)
+          : bicgstab_tag(tol, max_iters, max_iters_before_restart) {};
+    };
+
+
     /** @brief Implementation of the stabilized Bi-conjugate gradient solver
     *
     * Following the description in "Iterative Methods for Sparse Linear Systems" by Y. Saad
@@ -174,6 +196,156 @@ namespace viennacl
       return solve(matrix, rhs, tag);
     }
 
+    namespace detail
+    {
+      /** @brief Reads the chunks 'first_chunk', ..., 'first_chunk' + 'num_chunks' - 1 of the inner product buffer of the pipelined BiCGStab method from the device and sums up each of them */
+      template <typename VectorType, typename NumericT>
+      void pipelined_bicgstab_fetch_inner_prods(VectorType const & inner_prod_buffer,
+                                                std::vector<NumericT> & host_inner_prod_buffer,
+                                                std::size_t buffer_chunk_size,
+                                                std::size_t first_chunk,
+                                                std::size_t num_chunks,
+                                                NumericT * inner_prods)
+      {
+        viennacl::backend::memory_read(inner_prod_buffer.handle(),
+                                       sizeof(NumericT) * first_chunk * buffer_chunk_size,
+                                       sizeof(NumericT) * num_chunks * buffer_chunk_size,
+                                       &(host_inner_prod_buffer[0]));
+
+        for (std::size_t k = 0; k < num_chunks; ++k)
+        {
+          inner_prods[k] = 0;
+          for (std::size_t j = 0; j < buffer_chunk_size; ++j)
+            inner_prods[k] += host_inner_prod_buffer[k * buffer_chunk_size + j];
+        }
+      }
+    }
+
+    /** @brief Implementation of the pipelined stabilized Bi-conjugate gradient solver without preconditioner
+    *
+    * The inner products <Ap, r0star>, <As, s>, and <As, As> are computed within the matrix-vector products, while <residual, r0star> and <residual, residual>
+    * are obtained from the fused vector update. The inner product <residual, r0star> required for beta and the residual norm required for the convergence check
+    * are obtained from the recurrences
+    *
+    *   <residual, r0star> = <residual_old, r0star> - alpha * <Ap, r0star> - omega * <As, r0star>
+    *   <residual, residual> = <s, s> - 2 * omega * <As, s> + omega^2 * <As, As>
+    *
+    * such that there are only two synchronizations with the host per iteration.
+    *
+    * @param matrix     The system matrix
+    * @param rhs        The load vector
+    * @param tag        Solver configuration tag
+    * @return The result vector
+    */
+    template <typename MatrixType, typename NumericT, unsigned int ALIGNMENT>
+    viennacl::vector<NumericT, ALIGNMENT> solve(MatrixType const & matrix, viennacl::vector<NumericT, ALIGNMENT> const & rhs, pipelined_bicgstab_tag const & tag)
+    {
+      typedef viennacl::vector<NumericT, ALIGNMENT>     VectorType;
+
+      VectorType result = rhs;
+      viennacl::traits::clear(result);
+
+      VectorType residual = rhs;
+      VectorType p = rhs;
+      VectorType r0star = rhs;
+      VectorType Ap = rhs;
+      VectorType As = rhs;
+      VectorType s = rhs;
+
+      // chunks of the inner product buffer (one partial result per work group or block of rows on the host):
+      //   0, 1: <residual, residual>, <residual, r0star> from the vector update
+      //   2-5:  <Ap, Ap>, <p, Ap>, <r0star, Ap>, <p, p> from the first matrix-vector product
+      //   6-9:  <As, As>, <s, As>, <r0star, As>, <s, s> from the second matrix-vector product
+      std::size_t buffer_chunk_size = 128;
+      VectorType inner_prod_buffer = viennacl::zero_vector<NumericT>(10 * buffer_chunk_size, viennacl::traits::context(rhs));
+      std::vector<NumericT> host_inner_prod_buffer(6 * buffer_chunk_size);
+      NumericT inner_prods[6];
+
+      NumericT norm_rhs_host = viennacl::linalg::norm_2(rhs);
+      NumericT ip_rr0star = norm_rhs_host * norm_rhs_host;
+      NumericT residual_norm = norm_rhs_host;
+      NumericT alpha = 0;
+      NumericT omega = 0;
+      NumericT beta = 0;
+
+      tag.iters(0);
+      tag.error(0);
+      if (norm_rhs_host == 0) //solution is zero if RHS norm is zero
+        return result;
+
+      bool restart_flag = true;
+      std::size_t last_restart = 0;
+      for (std::size_t i = 0; i < tag.max_iterations(); ++i)
+      {
+        bool restarted = restart_flag;
+        if (restart_flag)
+        {
+          residual = rhs;
+          residual -= viennacl::linalg::prod(matrix, result);
+          p = residual;
+          r0star = residual;
+          ip_rr0star = viennacl::linalg::norm_2(residual);
+          ip_rr0star *= ip_rr0star;
+          restart_flag = false;
+          last_restart = i;
+        }
+
+        tag.iters(i+1);
+
+        // Ap = A * p along with <Ap, r0star>. The results of the previous vector update are fetched in the same go:
+        viennacl::linalg::pipelined_bicgstab_prod(matrix, p, Ap, r0star, inner_prod_buffer, buffer_chunk_size, 2);
+        detail::pipelined_bicgstab_fetch_inner_prods(inner_prod_buffer, host_inner_prod_buffer, buffer_chunk_size, 0, 6, inner_prods);
+        if (!restarted)
+          ip_rr0star = inner_prods[1];
+        NumericT ip_Apr0star = inner_prods[4];
+
+        alpha = ip_rr0star / ip_Apr0star;
+
+        s = residual - alpha * Ap;
+
+        // As = A * s along with <As, As>, <s, As>, <As, r0star>, and <s, s>:
+        viennacl::linalg::pipelined_bicgstab_prod(matrix, s, As, r0star, inner_prod_buffer, buffer_chunk_size, 6);
+        detail::pipelined_bicgstab_fetch_inner_prods(inner_prod_buffer, host_inner_prod_buffer, buffer_chunk_size, 6, 4, inner_prods);
+        NumericT ip_AsAs     = inner_prods[0];
+        NumericT ip_sAs      = inner_prods[1];
+        NumericT ip_Asr0star = inner_prods[2];
+        NumericT ip_ss       = inner_prods[3];
+
+        omega = ip_sAs / ip_AsAs;
+
+        NumericT new_ip_rr0star = ip_rr0star - alpha * ip_Apr0star - omega * ip_Asr0star;
+        beta = new_ip_rr0star / ip_rr0star * alpha/omega;
+
+        // result += alpha * p + omega * s; residual = s - omega * As; p = residual + beta * (p - omega * Ap); along with <residual, residual> and <residual, r0star>:
+        viennacl::linalg::pipelined_bicgstab_vector_update(result, alpha, p, omega, s, residual, As, beta, Ap, r0star, inner_prod_buffer, buffer_chunk_size);
+
+        residual_norm = std::sqrt(std::max<NumericT>(ip_ss - 2 * omega * ip_sAs + omega * omega * ip_AsAs, 0));
+        if (std::fabs(residual_norm / norm_rhs_host) < tag.tolerance())
+          break;
+
+        ip_rr0star = new_ip_rr0star;
+
+        if (ip_rr0star == 0 || omega == 0 || i - last_restart > tag.max_iterations_before_restart()) //search direction degenerate. A restart might help
+          restart_flag = true;
+      }
+
+      //store last error estimate, using the true norm of the last residual:
+      if (tag.iters() > 0)
+      {
+        detail::pipelined_bicgstab_fetch_inner_prods(inner_prod_buffer, host_inner_prod_buffer, buffer_chunk_size, 0, 1, inner_prods);
+        residual_norm = std::sqrt(inner_prods[0]);
+      }
+      tag.error(residual_norm / norm_rhs_host);
+
+      return result;
+    }
+
+    template <typename MatrixType, typename NumericT, unsigned int ALIGNMENT>
+    viennacl::vector<NumericT, ALIGNMENT> solve(MatrixType const & matrix, viennacl::vector<NumericT, ALIGNMENT> const & rhs, pipelined_bicgstab_tag const & tag, viennacl::linalg::no_precond)
+    {
+      return solve(matrix, rhs, tag);
+    }
+
     /** @brief Implementation of the preconditioned stabilized Bi-conjugate gradient solver
     *
     * Following the description of the unpreconditioned case in "Iterative Methods for Sparse Linear Systems" by Y. Saad
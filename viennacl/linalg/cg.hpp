@@ -25,12 +25,17 @@
 #include <vector>
 #include <map>
 #include <cmath>
+#include <algorithm>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/ilu.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/inner_prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+#include "viennacl/backend/memory.hpp"
 #include "viennacl/traits/clear.hpp"
 #include "viennacl/traits/size.hpp"
 #include "viennacl/meta/result_of.hpp"
@@ -77,6 +82,85 @@ namespace viennacl
     };
 
 
+    /** @brief A tag for the pipelined conjugate gradient method. Used for supplying solver parameters and for dispatching the solve() function
+    *
+    * The pipelined variant carries out only two passes over memory per iteration: a fused matrix-vector product, which also computes the
+    * inner products <Ap, Ap> and <p, Ap>, and a fused vector update, which also computes <r, r>. All three inner products are transferred to the host in one go.
+    * Mathematically equivalent to the classical conjugate gradient method, see Chronopoulos and Gear, J. Comput. Appl. Math. 25, pp. 153-168 (1989).
+    *
+    * Only available for viennacl::vector without preconditioner. For all other cases, the classical conjugate gradient method is used.
+    */
+    class pipelined_cg_tag : public cg_tag
+    {
+      public:
+        /** @brief The constructor
+        *
+        * @param tol              Relative tolerance for the residual (solver quits if ||r|| < tol * ||r_initial||)
+        * @param max_iterations   The maximum number of iterations
+        */
+        pipelined_cg_tag(double tol = 1e-8, unsigned int max_iterations = 300) : cg_tag(tol, max_iterations) {};
+    };
+
+
+    /** @brief A tag for the conjugate gradient method with multiple right hand sides. Used for supplying solver parameters and for dispatching the solve() function
+    *
+    * The right hand sides are supplied as the columns of a dense matrix. Each column is iterated by the conjugate gradient method with its own step sizes,
+    * but the matrix-vector products for all columns are carried out by a single sparse matrix-dense matrix product, so the system matrix is read only once per iteration.
+    * Columns are removed from the iteration (deflated) as soon as they are converged.
+    */
+    class block_cg_tag
+    {
+      public:
+        /** @brief The constructor
+        *
+        * @param tol              Relative tolerance for the residual of each column (column is converged if ||r_j|| < tol * ||b_j||)
+        * @param max_iterations   The maximum number of iterations
+        */
+        block_cg_tag(double tol = 1e-8, unsigned int max_iterations = 300) : tol_(tol), iterations_(max_iterations), iters_taken_(0), last_error_(0) {};
+
+        /** @brief Returns the relative tolerance */
+        double tolerance() const { return tol_; }
+        /** @brief Returns the maximum number of iterations */
+        unsigned int max_iterations() const { return iterations_; }
+
+        /** @brief Return the number of solver iterations until all columns converged: */
+        unsigned int iters() const { return iters_taken_; }
+        void iters(unsigned int i) const { iters_taken_ = i; }
+
+        /** @brief Returns the largest estimated relative error of all columns at the end of the solver run */
+        double error() const { return last_error_; }
+        /** @brief Sets the largest estimated relative error of all columns at the end of the solver run */
+        void error(double e) const { last_error_ = e; }
+
+        /** @brief Returns the number of iterations for each of the columns */
+        std::vector<unsigned int> const & column_iters() const { return column_iters_; }
+        /** @brief Returns the estimated relative error for each of the columns at the end of the solver run */
+        std::vector<double> const & column_errors() const { return column_errors_; }
+
+        /** @brief Sets the number of iterations and the estimated relative error of the j-th column (should only be modified by the solver) */
+        void column_result(std::size_t j, unsigned int iterations, double e) const
+        {
+          if (column_iters_.size() <= j)
+          {
+            column_iters_.resize(j+1);
+            column_errors_.resize(j+1);
+          }
+          column_iters_[j] = iterations;
+          column_errors_[j] = e;
+        }
+
+      private:
+        double tol_;
+        unsigned int iterations_;
+
+        //return values from solver
+        mutable unsigned int iters_taken_;
+        mutable double last_error_;
+        mutable std::vector<unsigned int> column_iters_;
+        mutable std::vector<double> column_errors_;
+    };
+
+
     /** @brief Implementation of the conjugate gradient solver without preconditioner
     *
     * Following the algorithm in the book by Y. Saad "Iterative Methods for sparse linear systems"
@@ -142,6 +226,302 @@ namespace viennacl
       return solve(matrix, rhs, tag);
     }
 
+    namespace detail
+    {
+      /** @brief Reads the partial inner products of the pipelined CG method from the device and sums them up. <r, r> is only updated if 'update_rr' is true. */
+      template <typename VectorType, typename NumericT>
+      void pipelined_cg_fetch_inner_prods(VectorType const & inner_prod_buffer,
+                                          std::vector<NumericT> & host_inner_prod_buffer,
+                                          NumericT & ip_rr, NumericT & ip_ApAp, NumericT & ip_pAp,
+                                          bool update_rr)
+      {
+        std::size_t chunk_size = host_inner_prod_buffer.size() / 3;
+        viennacl::backend::memory_read(inner_prod_buffer.handle(), 0, sizeof(NumericT) * host_inner_prod_buffer.size(), &(host_inner_prod_buffer[0]));
+
+        NumericT rr = 0;
+        ip_ApAp = 0;
+        ip_pAp = 0;
+        for (std::size_t j = 0; j < chunk_size; ++j)
+        {
+          rr      += host_inner_prod_buffer[j];
+          ip_ApAp += host_inner_prod_buffer[    chunk_size + j];
+          ip_pAp  += host_inner_prod_buffer[2 * chunk_size + j];
+        }
+        if (update_rr)
+          ip_rr = rr;
+      }
+    }
+
+    /** @brief Implementation of the pipelined conjugate gradient solver without preconditioner
+    *
+    * The update of the search direction uses beta = (alpha^2 <Ap, Ap> - <r, r>) / <r, r>, which only requires the inner products of the previous iteration.
+    * Thus, the vector updates can be fused into a single kernel, and there is only one synchronization with the host per iteration.
+    *
+    * @param matrix     The system matrix
+    * @param rhs        The load vector
+    * @param tag        Solver configuration tag
+    * @return The result vector
+    */
+    template <typename MatrixType, typename NumericT, unsigned int ALIGNMENT>
+    viennacl::vector<NumericT, ALIGNMENT> solve(MatrixType const & matrix, viennacl::vector<NumericT, ALIGNMENT> const & rhs, pipelined_cg_tag const & tag)
+    {
+      typedef viennacl::vector<NumericT, ALIGNMENT>     VectorType;
+
+      VectorType result = rhs;
+      viennacl::traits::clear(result);
+
+      VectorType residual = rhs;
+      VectorType p = rhs;
+      VectorType Ap = rhs;
+
+      // one partial result per work group (or block of rows on the host) for each of <r, r>, <Ap, Ap> and <p, Ap>:
+      std::size_t buffer_chunk_size = 128;
+      VectorType inner_prod_buffer = viennacl::zero_vector<NumericT>(3 * buffer_chunk_size, viennacl::traits::context(rhs));
+      std::vector<NumericT> host_inner_prod_buffer(3 * buffer_chunk_size);
+
+      NumericT ip_rr = viennacl::linalg::inner_prod(rhs, rhs);
+      NumericT ip_ApAp = 0;
+      NumericT ip_pAp = 0;
+      NumericT norm_rhs_squared = ip_rr;
+
+      tag.iters(0);
+      tag.error(0);
+      if (norm_rhs_squared == 0) //solution is zero if RHS norm is zero
+        return result;
+
+      viennacl::linalg::pipelined_cg_prod(matrix, p, Ap, inner_prod_buffer);
+      detail::pipelined_cg_fetch_inner_prods(inner_prod_buffer, host_inner_prod_buffer, ip_rr, ip_ApAp, ip_pAp, false);
+
+      NumericT alpha = ip_rr / ip_pAp;
+      NumericT beta  = alpha * alpha * ip_ApAp / ip_rr - 1;
+
+      for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+      {
+        tag.iters(i+1);
+
+        // result += alpha * p; residual -= alpha * Ap; p = residual + beta * p; along with <residual, residual>:
+        viennacl::linalg::pipelined_cg_vector_update(result, alpha, p, residual, Ap, beta, inner_prod_buffer);
+
+        // Ap = A * p, along with <Ap, Ap> and <p, Ap>:
+        viennacl::linalg::pipelined_cg_prod(matrix, p, Ap, inner_prod_buffer);
+
+        // the only synchronization with the host per iteration:
+        detail::pipelined_cg_fetch_inner_prods(inner_prod_buffer, host_inner_prod_buffer, ip_rr, ip_ApAp, ip_pAp, true);
+
+        if (std::sqrt(ip_rr / norm_rhs_squared) < tag.tolerance())
+          break;
+
+        alpha = ip_rr / ip_pAp;
+        beta  = alpha * alpha * ip_ApAp / ip_rr - 1;
+      }
+
+      //store last error estimate:
+      tag.error(std::sqrt(ip_rr / norm_rhs_squared));
+
+      return result;
+    }
+
+    template <typename MatrixType, typename NumericT, unsigned int ALIGNMENT>
+    viennacl::vector<NumericT, ALIGNMENT> solve(MatrixType const & matrix, viennacl::vector<NumericT, ALIGNMENT> const & rhs, pipelined_cg_tag const & tag, viennacl::linalg::no_precond)
+    {
+      return solve(matrix, rhs, tag);
+    }
+
+    namespace detail
+    {
+      /** @brief Returns a vector referring to the j-th column of the matrix A */
+      template <typename NumericT, typename F>
+      viennacl::vector_base<NumericT> block_cg_column(matrix_base<NumericT, F> const & A, std::size_t j)
+      {
+        typedef typename matrix_base<NumericT, F>::handle_type  HandleType;
+
+        std::size_t start  = F::mem_index(viennacl::traits::start1(A), viennacl::traits::start2(A) + j * viennacl::traits::stride2(A), A.internal_size1(), A.internal_size2());
+        std::size_t stride = F::mem_index(viennacl::traits::stride1(A), 0, A.internal_size1(), A.internal_size2());
+        return viennacl::vector_base<NumericT>(const_cast<HandleType &>(A.handle()), A.size1(), start, stride);
+      }
+
+      /** @brief Returns the first 'num_columns' columns of the densely packed row-major matrix with 'size1' rows and 'internal_size2' columns stored in 'h' */
+      template <typename NumericT>
+      matrix_base<NumericT, viennacl::row_major> block_cg_active_columns(viennacl::backend::mem_handle & h, std::size_t size1, std::size_t num_columns, std::size_t internal_size2)
+      {
+        return matrix_base<NumericT, viennacl::row_major>(h, size1, 0, 1, size1, num_columns, 0, 1, internal_size2);
+      }
+
+      /** @brief Reads the partial inner products of the first 'num_columns' columns from the inner product buffer and sums them up */
+      template <typename VectorType, typename NumericT>
+      void block_cg_fetch_inner_prods(VectorType const & inner_prod_buffer,
+                                      std::vector<NumericT> & host_inner_prod_buffer,
+                                      std::size_t buffer_chunk_size, std::size_t num_columns,
+                                      std::vector<NumericT> & inner_prods)
+      {
+        viennacl::backend::memory_read(inner_prod_buffer.handle(), 0, sizeof(NumericT) * buffer_chunk_size * num_columns, &(host_inner_prod_buffer[0]));
+
+        for (std::size_t j = 0; j < num_columns; ++j)
+        {
+          inner_prods[j] = 0;
+          for (std::size_t k = 0; k < buffer_chunk_size; ++k)
+            inner_prods[j] += host_inner_prod_buffer[j * buffer_chunk_size + k];
+        }
+      }
+    }
+
+    /** @brief Implementation of the conjugate gradient solver for multiple right hand sides without preconditioner
+    *
+    * The columns of the solution, the residuals, and the search directions are kept in densely packed row-major matrices, in which the active (not yet converged)
+    * columns are kept in front. Per iteration, there is one sparse matrix-dense matrix product for all active columns, one fused update of the solutions and residuals,
+    * and one update of the search directions. The step sizes of all columns are obtained with two transfers to the host.
+    * If a column converges, its solution is written to the result and the last active column is moved to its place.
+    *
+    * @param matrix     The system matrix
+    * @param rhs        The right hand sides in the columns of a dense matrix
+    * @param tag        Solver configuration tag
+    * @return The matrix of solution vectors
+    */
+    template <typename MatrixType, typename NumericT, typename F>
+    viennacl::matrix<NumericT, F> solve(MatrixType const & matrix, matrix_base<NumericT, F> const & rhs, block_cg_tag const & tag)
+    {
+      typedef matrix_base<NumericT, viennacl::row_major>   BlockType;
+
+      std::size_t problem_size = rhs.size1();
+      std::size_t num_rhs      = rhs.size2();
+      viennacl::context ctx    = viennacl::traits::context(rhs);
+
+      viennacl::matrix<NumericT, F> result(problem_size, num_rhs, ctx);
+
+      tag.iters(0);
+      tag.error(0);
+      for (std::size_t j = 0; j < num_rhs; ++j)
+        tag.column_result(j, 0, 0);
+      if (problem_size == 0 || num_rhs == 0)
+        return result;
+
+      // densely packed row-major matrices, so that the sparse matrix-dense matrix product reads the rows of the system matrix once for all columns:
+      std::vector<NumericT> zeros(problem_size * num_rhs);
+      viennacl::backend::mem_handle X_handle, R_handle, P_handle, AP_handle;
+      viennacl::backend::memory_create(X_handle,  sizeof(NumericT) * problem_size * num_rhs, ctx, &(zeros[0]));
+      viennacl::backend::memory_create(R_handle,  sizeof(NumericT) * problem_size * num_rhs, ctx, &(zeros[0]));
+      viennacl::backend::memory_create(P_handle,  sizeof(NumericT) * problem_size * num_rhs, ctx, &(zeros[0]));
+      viennacl::backend::memory_create(AP_handle, sizeof(NumericT) * problem_size * num_rhs, ctx, &(zeros[0]));
+
+      BlockType X = detail::block_cg_active_columns<NumericT>(X_handle, problem_size, num_rhs, num_rhs);
+      BlockType R = detail::block_cg_active_columns<NumericT>(R_handle, problem_size, num_rhs, num_rhs);
+      BlockType P = detail::block_cg_active_columns<NumericT>(P_handle, problem_size, num_rhs, num_rhs);
+
+      for (std::size_t j = 0; j < num_rhs; ++j)
+      {
+        viennacl::vector_base<NumericT> R_j = detail::block_cg_column(R, j);
+        viennacl::vector_base<NumericT> P_j = detail::block_cg_column(P, j);
+        R_j = detail::block_cg_column(rhs, j);
+        P_j = R_j;
+      }
+
+      // one partial result per work group (or block of rows on the host) and column:
+      std::size_t buffer_chunk_size = 128;
+      viennacl::vector<NumericT> inner_prod_buffer = viennacl::zero_vector<NumericT>(num_rhs * buffer_chunk_size, ctx);
+      std::vector<NumericT> host_inner_prod_buffer(num_rhs * buffer_chunk_size);
+
+      // step sizes of the active columns (device and host):
+      viennacl::vector<NumericT> step_sizes = viennacl::zero_vector<NumericT>(num_rhs, ctx);
+      std::vector<NumericT> alphas(num_rhs);
+      std::vector<NumericT> betas(num_rhs);
+
+      std::vector<NumericT> ip_rr(num_rhs);
+      std::vector<NumericT> ip_pAp(num_rhs);
+      std::vector<NumericT> new_ip_rr(num_rhs);
+      std::vector<NumericT> norm_rhs_squared(num_rhs);
+      std::vector<std::size_t> column_index(num_rhs);   // column of 'rhs' the active column j belongs to
+
+      viennacl::linalg::block_cg_inner_prods(R, R, inner_prod_buffer, buffer_chunk_size);
+      detail::block_cg_fetch_inner_prods(inner_prod_buffer, host_inner_prod_buffer, buffer_chunk_size, num_rhs, ip_rr);
+      for (std::size_t j = 0; j < num_rhs; ++j)
+      {
+        norm_rhs_squared[j] = ip_rr[j];
+        column_index[j] = j;
+      }
+
+      std::size_t num_active = num_rhs;
+      double max_error = 0;
+      for (unsigned int i = 0; i <= tag.max_iterations() && num_active > 0; ++i)
+      {
+        //
+        // Deflation: Write converged columns to the result and move the last active column to their place.
+        // Columns with zero right hand side are converged from the start.
+        //
+        for (std::size_t j = num_active; j > 0; --j)
+        {
+          std::size_t col = j - 1;
+          bool zero_rhs = (norm_rhs_squared[col] == 0);
+          double rel_residual = zero_rhs ? 0 : std::sqrt(ip_rr[col] / norm_rhs_squared[col]);
+          if (zero_rhs || rel_residual < tag.tolerance() || i == tag.max_iterations())
+          {
+            viennacl::vector_base<NumericT> result_col = detail::block_cg_column(result, column_index[col]);
+            result_col = detail::block_cg_column(X, col);
+            tag.column_result(column_index[col], i, rel_residual);
+            max_error = std::max(max_error, rel_residual);
+
+            --num_active;
+            if (col != num_active) // move last active column to position 'col':
+            {
+              viennacl::vector_base<NumericT> X_col = detail::block_cg_column(X, col);
+              viennacl::vector_base<NumericT> R_col = detail::block_cg_column(R, col);
+              viennacl::vector_base<NumericT> P_col = detail::block_cg_column(P, col);
+              X_col = detail::block_cg_column(X, num_active);
+              R_col = detail::block_cg_column(R, num_active);
+              P_col = detail::block_cg_column(P, num_active);
+              ip_rr[col]            = ip_rr[num_active];
+              norm_rhs_squared[col] = norm_rhs_squared[num_active];
+              column_index[col]     = column_index[num_active];
+            }
+          }
+        }
+
+        if (num_active == 0 || i == tag.max_iterations())
+          break;
+
+        tag.iters(i+1);
+
+        BlockType X_active  = detail::block_cg_active_columns<NumericT>(X_handle,  problem_size, num_active, num_rhs);
+        BlockType R_active  = detail::block_cg_active_columns<NumericT>(R_handle,  problem_size, num_active, num_rhs);
+        BlockType P_active  = detail::block_cg_active_columns<NumericT>(P_handle,  problem_size, num_active, num_rhs);
+        BlockType AP_active = detail::block_cg_active_columns<NumericT>(AP_handle, problem_size, num_active, num_rhs);
+
+        // a single sparse matrix-dense matrix product for all active columns:
+        viennacl::linalg::prod_impl(matrix, P_active, AP_active);
+
+        viennacl::linalg::block_cg_inner_prods(P_active, AP_active, inner_prod_buffer, buffer_chunk_size);
+        detail::block_cg_fetch_inner_prods(inner_prod_buffer, host_inner_prod_buffer, buffer_chunk_size, num_active, ip_pAp);
+
+        for (std::size_t j = 0; j < num_active; ++j)
+          alphas[j] = ip_rr[j] / ip_pAp[j];
+        viennacl::backend::memory_write(step_sizes.handle(), 0, sizeof(NumericT) * num_active, &(alphas[0]));
+
+        // X_j += alpha_j * P_j; R_j -= alpha_j * AP_j; along with <R_j, R_j>:
+        viennacl::linalg::block_cg_vector_update(X_active, step_sizes, P_active, R_active, AP_active, inner_prod_buffer, buffer_chunk_size);
+        detail::block_cg_fetch_inner_prods(inner_prod_buffer, host_inner_prod_buffer, buffer_chunk_size, num_active, new_ip_rr);
+
+        for (std::size_t j = 0; j < num_active; ++j)
+        {
+          betas[j] = new_ip_rr[j] / ip_rr[j];
+          ip_rr[j] = new_ip_rr[j];
+        }
+        viennacl::backend::memory_write(step_sizes.handle(), 0, sizeof(NumericT) * num_active, &(betas[0]));
+
+        // P_j = R_j + beta_j * P_j:
+        viennacl::linalg::block_cg_direction_update(P_active, R_active, step_sizes);
+      }
+
+      //store last error estimate:
+      tag.error(max_error);
+
+      return result;
+    }
+
+    template <typename MatrixType, typename NumericT, typename F>
+    viennacl::matrix<NumericT, F> solve(MatrixType const & matrix, matrix_base<NumericT, F> const & rhs, block_cg_tag const & tag, viennacl::linalg::no_precond)
+    {
+      return solve(matrix, rhs, tag);
+    }
+
     /** @brief Implementation of the preconditioned conjugate gradient solver
     *
     * Following Algorithm 9.1 in "Iterative Methods for Sparse Linear Systems" by Y. Saad
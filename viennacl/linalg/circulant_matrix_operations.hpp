@@ -23,14 +23,11 @@
 */
 
 #include "viennacl/forwards.h"
-#include "viennacl/ocl/device.hpp"
-#include "viennacl/ocl/handle.hpp"
-#include "viennacl/ocl/kernel.hpp"
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/fft.hpp"
-//#include "viennacl/linalg/kernels/coordinate_matrix_kernels.h"
+#include "viennacl/linalg/host_based/structured_matrix_operations.hpp"
 
 namespace viennacl
 {
@@ -54,20 +51,61 @@ namespace viennacl
       {
         assert(mat.size1() == result.size());
         assert(mat.size2() == vec.size());
-        //result.clear();
 
-        //std::cout << "prod(circulant_matrix" << ALIGNMENT << ", vector) called with internal_nnz=" << mat.internal_nnz() << std::endl;
-
-        viennacl::vector<SCALARTYPE> circ(mat.elements().size() * 2);
-        viennacl::detail::fft::real_to_complex(mat.elements(), circ, mat.elements().size());
-
-        viennacl::vector<SCALARTYPE> tmp(vec.size() * 2);
-        viennacl::vector<SCALARTYPE> tmp2(vec.size() * 2);
-
-        viennacl::detail::fft::real_to_complex(vec, tmp, vec.size());
-        viennacl::linalg::convolve(circ, tmp, tmp2);
-        viennacl::detail::fft::complex_to_real(tmp2, result, vec.size());
+        switch (viennacl::traits::handle(mat).get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            viennacl::linalg::host_based::prod_impl(mat, vec, result);
+            break;
+#ifdef VIENNACL_WITH_OPENCL
+          case viennacl::OPENCL_MEMORY:
+          {
+            viennacl::vector<SCALARTYPE> circ(mat.elements().size() * 2);
+            viennacl::detail::fft::real_to_complex(mat.elements(), circ, mat.elements().size());
+
+            viennacl::vector<SCALARTYPE> tmp(vec.size() * 2);
+            viennacl::vector<SCALARTYPE> tmp2(vec.size() * 2);
+
+            viennacl::detail::fft::real_to_complex(vec, tmp, vec.size());
+            viennacl::linalg::convolve(circ, tmp, tmp2);
+            viennacl::detail::fft::complex_to_real(tmp2, result, vec.size());
+            break;
+          }
+#endif
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            throw memory_exception("not implemented");
+        }
+      }
 
+    /** @brief Carries out the product of a circulant_matrix with each column of a dense matrix
+    *
+    * Implementation of the convenience expression result = prod(mat, B);
+    *
+    * @param mat    The matrix
+    * @param B      The dense matrix
+    * @param result The result matrix
+    */
+      template<class SCALARTYPE, unsigned int ALIGNMENT, typename F>
+      void prod_impl(const viennacl::circulant_matrix<SCALARTYPE, ALIGNMENT> & mat,
+                     const viennacl::matrix_base<SCALARTYPE, F> & B,
+                           viennacl::matrix_base<SCALARTYPE, F> & result)
+      {
+        assert(mat.size1() == result.size1());
+        assert(mat.size2() == B.size1());
+        assert(B.size2() == result.size2());
+
+        switch (viennacl::traits::handle(mat).get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            viennacl::linalg::host_based::prod_impl(mat, B, result);
+            break;
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            throw memory_exception("not implemented");
+        }
       }
 
   } //namespace linalg
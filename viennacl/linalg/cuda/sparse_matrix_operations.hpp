@@ -1409,6 +1409,198 @@ namespace viennacl
         VIENNACL_CUDA_LAST_ERROR_CHECK("hyb_matrix_vec_mul_kernel");
       }
 
+      //
+      // Sliced ELL Matrix
+      //
+
+      template <typename T>
+      __global__ void sliced_ell_matrix_vec_mul_kernel(const unsigned int * chunk_start,
+                                                       const unsigned int * column_indices,
+                                                       const unsigned int * row_indices,
+                                                       const T * elements,
+                                                       const T * x,
+                                                       unsigned int start_x,
+                                                       unsigned int inc_x,
+                                                             T * result,
+                                                       unsigned int start_result,
+                                                       unsigned int inc_result,
+                                                       unsigned int row_num,
+                                                       unsigned int chunk_size)
+      {
+        for (unsigned int slot = blockDim.x * blockIdx.x + threadIdx.x; slot < row_num; slot += gridDim.x * blockDim.x)
+        {
+          unsigned int chunk = slot / chunk_size;
+          unsigned int end   = chunk_start[chunk + 1];
+          T sum = 0;
+
+          for (unsigned int offset = chunk_start[chunk] + slot % chunk_size; offset < end; offset += chunk_size)
+          {
+            T val = elements[offset];
+            if (val != (T)0)
+              sum += val * x[column_indices[offset] * inc_x + start_x];
+          }
+
+          result[row_indices[slot] * inc_result + start_result] = sum;
+        }
+      }
+
+      /** @brief Carries out matrix-vector multiplication with a sliced_ell_matrix
+      *
+      * Implementation of the convenience expression result = prod(mat, vec);
+      *
+      * @param mat    The matrix
+      * @param vec    The vector
+      * @param result The result vector
+      */
+      template<class ScalarType>
+      void prod_impl(const viennacl::sliced_ell_matrix<ScalarType> & mat,
+                     const viennacl::vector_base<ScalarType> & vec,
+                           viennacl::vector_base<ScalarType> & result)
+      {
+        sliced_ell_matrix_vec_mul_kernel<<<256, 128>>>(detail::cuda_arg<unsigned int>(mat.handle1().cuda_handle()),
+                                                       detail::cuda_arg<unsigned int>(mat.handle2().cuda_handle()),
+                                                       detail::cuda_arg<unsigned int>(mat.handle3().cuda_handle()),
+                                                       detail::cuda_arg<ScalarType>(mat.handle().cuda_handle()),
+                                                       detail::cuda_arg<ScalarType>(vec),
+                                                       static_cast<unsigned int>(vec.start()),
+                                                       static_cast<unsigned int>(vec.stride()),
+                                                       detail::cuda_arg<ScalarType>(result),
+                                                       static_cast<unsigned int>(result.start()),
+                                                       static_cast<unsigned int>(result.stride()),
+                                                       static_cast<unsigned int>(mat.size1()),
+                                                       static_cast<unsigned int>(mat.chunk_size())
+                                                      );
+        VIENNACL_CUDA_LAST_ERROR_CHECK("sliced_ell_matrix_vec_mul_kernel");
+      }
+
+      template <typename ScalarType, typename NumericT>
+      __global__ void sliced_ell_matrix_d_mat_mul_kernel(const unsigned int * chunk_start,
+                                                         const unsigned int * column_indices,
+                                                         const unsigned int * row_indices,
+                                                         const ScalarType * elements,
+                                                         unsigned int sp_mat_row_num,
+                                                         unsigned int chunk_size,
+                                                         const NumericT * d_mat,
+                                                         unsigned int d_mat_row_start,
+                                                         unsigned int d_mat_col_start,
+                                                         unsigned int d_mat_row_inc,
+                                                         unsigned int d_mat_col_inc,
+                                                         unsigned int d_mat_internal_rows,
+                                                         unsigned int d_mat_internal_cols,
+                                                         bool d_mat_row_major,
+                                                         bool d_mat_transposed,
+                                                         NumericT * result,
+                                                         unsigned int result_row_start,
+                                                         unsigned int result_col_start,
+                                                         unsigned int result_row_inc,
+                                                         unsigned int result_col_inc,
+                                                         unsigned int result_col_size,
+                                                         unsigned int result_internal_rows,
+                                                         unsigned int result_internal_cols,
+                                                         bool result_row_major)
+      {
+        for (unsigned int rc = blockDim.x * blockIdx.x + threadIdx.x; rc < sp_mat_row_num * result_col_size; rc += gridDim.x * blockDim.x)
+        {
+          unsigned int slot  = rc % sp_mat_row_num;
+          unsigned int col   = rc / sp_mat_row_num;
+          unsigned int chunk = slot / chunk_size;
+          unsigned int end   = chunk_start[chunk + 1];
+          NumericT r = 0;
+
+          for (unsigned int offset = chunk_start[chunk] + slot % chunk_size; offset < end; offset += chunk_size)
+          {
+            NumericT val = static_cast<NumericT>(elements[offset]);
+            if (val != (NumericT)0)
+            {
+              unsigned int i = d_mat_transposed ? col : column_indices[offset];
+              unsigned int j = d_mat_transposed ? column_indices[offset] : col;
+              i = d_mat_row_start + i * d_mat_row_inc;
+              j = d_mat_col_start + j * d_mat_col_inc;
+              r += val * (d_mat_row_major ? d_mat[i * d_mat_internal_cols + j] : d_mat[i + j * d_mat_internal_rows]);
+            }
+          }
+
+          unsigned int i = result_row_start + row_indices[slot] * result_row_inc;
+          unsigned int j = result_col_start + col * result_col_inc;
+          if (result_row_major)
+            result[i * result_internal_cols + j] = r;
+          else
+            result[i + j * result_internal_rows] = r;
+        }
+      }
+
+      /** @brief Carries out Sparse Matrix(sliced ELL)-Dense Matrix multiplication
+      *
+      * Implementation of the convenience expression result = prod(sp_mat, d_mat);
+      *
+      * @param sp_mat     The sparse matrix (sliced ELL)
+      * @param d_mat      The dense matrix
+      * @param result     The result matrix
+      */
+      template<class ScalarType, class NumericT, typename F>
+      void prod_impl(const viennacl::sliced_ell_matrix<ScalarType> & sp_mat,
+                     const viennacl::matrix_base<NumericT, F> & d_mat,
+                           viennacl::matrix_base<NumericT, F> & result)
+      {
+        sliced_ell_matrix_d_mat_mul_kernel<<<128, 128>>>(detail::cuda_arg<unsigned int>(sp_mat.handle1().cuda_handle()),
+                                                         detail::cuda_arg<unsigned int>(sp_mat.handle2().cuda_handle()),
+                                                         detail::cuda_arg<unsigned int>(sp_mat.handle3().cuda_handle()),
+                                                         detail::cuda_arg<ScalarType>(sp_mat.handle().cuda_handle()),
+                                                         static_cast<unsigned int>(sp_mat.size1()),
+                                                         static_cast<unsigned int>(sp_mat.chunk_size()),
+                                                         detail::cuda_arg<NumericT>(d_mat),
+                                                         static_cast<unsigned int>(viennacl::traits::start1(d_mat)),         static_cast<unsigned int>(viennacl::traits::start2(d_mat)),
+                                                         static_cast<unsigned int>(viennacl::traits::stride1(d_mat)),        static_cast<unsigned int>(viennacl::traits::stride2(d_mat)),
+                                                         static_cast<unsigned int>(viennacl::traits::internal_size1(d_mat)), static_cast<unsigned int>(viennacl::traits::internal_size2(d_mat)),
+                                                         bool(viennacl::is_row_major<F>::value),
+                                                         false,
+                                                         detail::cuda_arg<NumericT>(result),
+                                                         static_cast<unsigned int>(viennacl::traits::start1(result)),         static_cast<unsigned int>(viennacl::traits::start2(result)),
+                                                         static_cast<unsigned int>(viennacl::traits::stride1(result)),        static_cast<unsigned int>(viennacl::traits::stride2(result)),
+                                                         static_cast<unsigned int>(viennacl::traits::size2(result)),
+                                                         static_cast<unsigned int>(viennacl::traits::internal_size1(result)), static_cast<unsigned int>(viennacl::traits::internal_size2(result)),
+                                                         bool(viennacl::is_row_major<F>::value)
+                                                        );
+        VIENNACL_CUDA_LAST_ERROR_CHECK("sliced_ell_matrix_d_mat_mul_kernel");
+      }
+
+      /** @brief Carries out Sparse Matrix(sliced ELL)-Dense Transposed Matrix multiplication
+      *
+      * Implementation of the convenience expression result = prod(sp_mat, trans(d_mat));
+      *
+      * @param sp_mat     The sparse matrix (sliced ELL)
+      * @param d_mat      The dense transposed matrix
+      * @param result     The result matrix
+      */
+      template<class ScalarType, class NumericT, typename F>
+      void prod_impl(const viennacl::sliced_ell_matrix<ScalarType> & sp_mat,
+                     const viennacl::matrix_expression< const viennacl::matrix_base<NumericT, F>,
+                                                        const viennacl::matrix_base<NumericT, F>,
+                                                        viennacl::op_trans > & d_mat,
+                           viennacl::matrix_base<NumericT, F> & result)
+      {
+        sliced_ell_matrix_d_mat_mul_kernel<<<128, 128>>>(detail::cuda_arg<unsigned int>(sp_mat.handle1().cuda_handle()),
+                                                         detail::cuda_arg<unsigned int>(sp_mat.handle2().cuda_handle()),
+                                                         detail::cuda_arg<unsigned int>(sp_mat.handle3().cuda_handle()),
+                                                         detail::cuda_arg<ScalarType>(sp_mat.handle().cuda_handle()),
+                                                         static_cast<unsigned int>(sp_mat.size1()),
+                                                         static_cast<unsigned int>(sp_mat.chunk_size()),
+                                                         detail::cuda_arg<NumericT>(d_mat.lhs()),
+                                                         static_cast<unsigned int>(viennacl::traits::start1(d_mat.lhs())),         static_cast<unsigned int>(viennacl::traits::start2(d_mat.lhs())),
+                                                         static_cast<unsigned int>(viennacl::traits::stride1(d_mat.lhs())),        static_cast<unsigned int>(viennacl::traits::stride2(d_mat.lhs())),
+                                                         static_cast<unsigned int>(viennacl::traits::internal_size1(d_mat.lhs())), static_cast<unsigned int>(viennacl::traits::internal_size2(d_mat.lhs())),
+                                                         bool(viennacl::is_row_major<F>::value),
+                                                         true,
+                                                         detail::cuda_arg<NumericT>(result),
+                                                         static_cast<unsigned int>(viennacl::traits::start1(result)),         static_cast<unsigned int>(viennacl::traits::start2(result)),
+                                                         static_cast<unsigned int>(viennacl::traits::stride1(result)),        static_cast<unsigned int>(viennacl::traits::stride2(result)),
+                                                         static_cast<unsigned int>(viennacl::traits::size2(result)),
+                                                         static_cast<unsigned int>(viennacl::traits::internal_size1(result)), static_cast<unsigned int>(viennacl::traits::internal_size2(result)),
+                                                         bool(viennacl::is_row_major<F>::value)
+                                                        );
+        VIENNACL_CUDA_LAST_ERROR_CHECK("sliced_ell_matrix_d_mat_mul_kernel");
+      }
+
 
     } // namespace opencl
   } //namespace linalg
@@ -27,14 +27,18 @@
 #include <boost/numeric/ublas/vector.hpp>
 #include <cmath>
 #include <set>
-#include <list>
+#include <vector>
 #include <algorithm>
+#include <iterator>
 
 #include <map>
 #ifdef VIENNACL_WITH_OPENMP
 #include <omp.h>
 #endif
 
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/backend/memory.hpp"
 #include "amg_debug.hpp"
 
 #define VIENNACL_AMG_COARSE_RS 1
@@ -46,6 +50,12 @@
 #define VIENNACL_AMG_INTERPOL_CLASSIC 2
 #define VIENNACL_AMG_INTERPOL_AG 3
 #define VIENNACL_AMG_INTERPOL_SA 4
+#define VIENNACL_AMG_SMOOTHER_JACOBI 1
+#define VIENNACL_AMG_SMOOTHER_L1_JACOBI 2
+#define VIENNACL_AMG_SMOOTHER_GAUSS_SEIDEL 3
+#define VIENNACL_AMG_SMOOTHER_CHEBYSHEV 4
+#define VIENNACL_AMG_CYCLE_V 1
+#define VIENNACL_AMG_CYCLE_W 2
 
 namespace viennacl
 {
@@ -65,7 +75,7 @@ namespace viennacl
             * @param interpol  Interpolation routine (Default: VIENNACL_AMG_INTERPOL_DIRECT)
             * @param threshold    Strength of dependence threshold for the coarsening process (Default: 0.25)
             * @param interpolweight  Interpolation parameter for SA interpolation and truncation parameter for direct+classical interpolation
-            * @param jacobiweight  Weight of the weighted Jacobi smoother iteration step (Default: 1 = Regular Jacobi smoother)
+            * @param jacobiweight  Weight of the weighted (l1-)Jacobi smoother iteration step (Default: 1 = Regular Jacobi smoother)
             * @param presmooth    Number of presmoothing operations on every level (Default: 1)
             * @param postsmooth   Number of postsmoothing operations on every level (Default: 1)
             * @param coarselevels  Number of coarse levels that are constructed
@@ -82,7 +92,8 @@ namespace viennacl
                     unsigned int coarselevels = 0)
             : coarse_(coarse), interpol_(interpol),
               threshold_(threshold), interpolweight_(interpolweight), jacobiweight_(jacobiweight),
-              presmooth_(presmooth), postsmooth_(postsmooth), coarselevels_(coarselevels) {};
+              presmooth_(presmooth), postsmooth_(postsmooth), coarselevels_(coarselevels),
+              smoother_(VIENNACL_AMG_SMOOTHER_JACOBI), cycle_(VIENNACL_AMG_CYCLE_V), timing_(false) {};
 
             // Getter-/Setter-Functions
             void set_coarse(unsigned int coarse) { if (coarse > 0) coarse_ = coarse; }
@@ -109,1072 +120,487 @@ namespace viennacl
             void set_coarselevels(int coarselevels)  { if (coarselevels >= 0) coarselevels_ = coarselevels; }
             unsigned int get_coarselevels() const { return coarselevels_; }
 
-          private:
-            unsigned int coarse_, interpol_;
-            double threshold_, interpolweight_, jacobiweight_;
-            unsigned int presmooth_, postsmooth_, coarselevels_;
-        };
-
-        /** @brief A class for a scalar that can be written to the sparse matrix or sparse vector datatypes.
-        *  @brief Values are only written to those datatypes if non-zero to optimize memory usage and performance.
-        *  @brief Needed for the []- and ()-operators.
-        */
-        template <typename InternalType, typename IteratorType, typename ScalarType>
-        class amg_nonzero_scalar
-        {
-          private:
-            InternalType *m_;
-            IteratorType iter_;
-            unsigned int i_,j_;
-            ScalarType s_;
-
-          public:
-            amg_nonzero_scalar();
+            /** @brief Sets the smoother (VIENNACL_AMG_SMOOTHER_JACOBI, _L1_JACOBI, _GAUSS_SEIDEL or _CHEBYSHEV). Only damped Jacobi is available for OpenCL. */
+            void set_smoother(unsigned int smoother) { if (smoother > 0 && smoother <= VIENNACL_AMG_SMOOTHER_CHEBYSHEV) smoother_ = smoother; }
+            unsigned int get_smoother() const { return smoother_; }
 
-            /** @brief The constructor.
-            *  @param m    Pointer to the sparse vector/matrix the scalar will be written to
-            *  @param iter    Iterator pointing to the respective element in the vector/matrix if available
-            *  @param i    Row index scalar will be written to
-            *  @param j    Col index scalar will be written to
-            *  @param s    Value of the scalar (usually used as dummy here as it will be set by the assignment operator)
-            */
-            amg_nonzero_scalar(InternalType *m,
-                              IteratorType & iter,
-                              unsigned int i,
-                              unsigned int j,
-                              ScalarType s = 0): m_(m), iter_(iter), i_(i), j_(j), s_(s) {}
-
-            /** @brief Assignment operator. Writes value into matrix at the given position.
-            *  @param value  Value that will be written
-            */
-            ScalarType operator = (const ScalarType value)
-            {
-              s_ = value;
-              // Only write if scalar is nonzero
-              if (s_ == 0) return s_;
-              // Write to m_ using iterator iter_ or indices (i_,j_)
-              m_->addscalar (iter_,i_,j_,s_);
-              return s_;
-            }
+            /** @brief Sets the cycle type (VIENNACL_AMG_CYCLE_V or VIENNACL_AMG_CYCLE_W). W-cycles are only available on the host. */
+            void set_cycle(unsigned int cycle) { if (cycle > 0 && cycle <= VIENNACL_AMG_CYCLE_W) cycle_ = cycle; }
+            unsigned int get_cycle() const { return cycle_; }
 
-            /** @brief Addition operator. Adds a constant.
-            *  @param value  Value that will be written
-            */
-            ScalarType operator += (const ScalarType value)
-            {
-              // If zero is added, then no change necessary
-              if (value == 0)
-                return s_;
+            /** @brief Enables or disables the accumulation of the execution time spent on each level while applying the preconditioner on the host */
+            void set_timing(bool timing) { timing_ = timing; }
+            bool get_timing() const { return timing_; }
 
-              s_ += value;
-              // Remove entry if resulting scalar is zero
-              if (s_ == 0)
-              {
-                m_->removescalar(iter_,i_);
-                return s_;
-              }
-              //Write to m_ using iterator iter_ or indices (i_,j_)
-              m_->addscalar (iter_,i_,j_,s_);
-              return s_;
-            }
-            ScalarType operator ++ (int)
+            /** @brief Returns the accumulated time (in seconds) of smoothing and grid transfers on the given level, or of the direct solve on the coarsest level */
+            double get_level_time(unsigned int level) const { return (level < level_times_.size()) ? level_times_[level] : 0; }
+            void add_level_time(unsigned int level, double time)
             {
-              s_++;
-              if (s_ == 0)
-                m_->removescalar(iter_,i_);
-              m_->addscalar (iter_,i_,j_,s_);
-              return s_;
+              if (level >= level_times_.size())
+                level_times_.resize(level + 1, 0);
+              level_times_[level] += time;
             }
-            ScalarType operator ++ ()
-            {
-              s_++;
-              if (s_ == 0)
-                m_->removescalar(iter_,i_);
-              m_->addscalar (iter_,i_,j_,s_);
-              return s_;
-            }
-            operator ScalarType (void) { return s_;  }
-        };
+            void reset_timings() { level_times_.clear(); }
 
-        /** @brief Defines an iterator for the sparse vector type.
-        */
-        template <typename InternalType>
-        class amg_sparsevector_iterator
-        {
           private:
-            typedef amg_sparsevector_iterator<InternalType> self_type;
-            typedef typename InternalType::mapped_type ScalarType;
-
-            InternalType & internal_vec;
-            typename InternalType::iterator iter;
-
-          public:
-
-            /** @brief The constructor.
-            *  @param vec    Internal sparse vector
-            *  @param begin  Whether the iterator starts at the beginning or end of vec
-            */
-            amg_sparsevector_iterator(InternalType & vec, bool begin=true): internal_vec(vec)
-            {
-              if (begin)
-                iter = internal_vec.begin();
-              else
-                iter = internal_vec.end();
-            }
-
-            bool operator == (self_type other)
-            {
-              if (iter == other.iter)
-                return true;
-              else
-                return false;
-            }
-            bool operator != (self_type other)
-            {
-              if (iter != other.iter)
-                return true;
-              else
-                return false;
-            }
-
-            self_type & operator ++ () const { iter++; return *this; }
-            self_type & operator ++ () { iter++; return *this; }
-            self_type & operator -- () const { iter--; return *this; }
-            self_type & operator -- () { iter--; return *this; }
-            ScalarType & operator * () const { return (*iter).second; }
-            ScalarType & operator * () { return (*iter).second; }
-            unsigned int index() const { return (*iter).first; }
-            unsigned int index() { return (*iter).first; }
+            unsigned int coarse_, interpol_;
+            double threshold_, interpolweight_, jacobiweight_;
+            unsigned int presmooth_, postsmooth_, coarselevels_;
+            unsigned int smoother_, cycle_;
+            bool timing_;
+            std::vector<double> level_times_;
         };
 
-        /** @brief A class for the sparse vector type.
+        /** @brief A sparse matrix in compressed sparse row (CSR) format for the operators of the AMG setup phase.
+        *
+        *  Column indices within each row are sorted in ascending order and no explicit zeros are stored.
+        *  All entries are held in three flat arrays, so coarsening, interpolation and the Galerkin product traverse contiguous memory.
         */
         template <typename ScalarType>
-        class amg_sparsevector
+        class amg_sparsematrix
         {
           public:
             typedef ScalarType value_type;
 
-          private:
-            // A map is used internally which saves all non-zero elements with pairs of (index,value)
-            typedef std::map<unsigned int,ScalarType> InternalType;
-            typedef amg_sparsevector<ScalarType> self_type;
-            typedef amg_nonzero_scalar<self_type,typename InternalType::iterator,ScalarType> NonzeroScalarType;
-
-            // Size is only a dummy variable. Not needed for internal map structure but for compatible vector interface.
-            unsigned int size_;
-            InternalType internal_vector;
-
-          public:
-            typedef amg_sparsevector_iterator<InternalType> iterator;
-            typedef typename InternalType::const_iterator const_iterator;
-
-          public:
-            /** @brief The constructor.
-            *  @param size    Size of the vector
-            */
-            amg_sparsevector(unsigned int size = 0): size_(size)
-            {
-              internal_vector = InternalType();
-            }
-
-            void resize(unsigned int size) { size_ = size; }
-            unsigned int size() const { return size_;}
+            /** @brief Standard constructor. */
+            amg_sparsematrix() : size1_(0), size2_(0), row_buffer_(1, 0) {}
 
-            // Returns number of non-zero entries in vector equal to the size of the underlying map.
-            unsigned int internal_size() const { return internal_vector.size(); }
-            // Delete underlying map.
-            void clear() { internal_vector.clear();  }
-            // Remove entry at position i.
-            void remove(unsigned int i) { internal_vector.erase(i); }
+            /** @brief Constructor. Builds a matrix of size (rows, cols) without any nonzero entries.
+              * @param rows  Size of first dimension
+              * @param cols  Size of second dimension
+              */
+            amg_sparsematrix(std::size_t rows, std::size_t cols) : size1_(rows), size2_(cols), row_buffer_(rows + 1, 0) {}
 
-            // Add s to the entry at position i
-            void add (unsigned int i, ScalarType s)
+            /** @brief Constructor. Builds the matrix from a std::vector<std::map> by copying memory
+              * @param mat  Vector of maps
+              */
+            amg_sparsematrix(std::vector<std::map<unsigned int, ScalarType> > const & mat)
+              : size1_(mat.size()), size2_(mat.size()), row_buffer_(mat.size() + 1, 0)
             {
-              typename InternalType::iterator iter = internal_vector.find(i);
-              // If there is no entry at position i, add new entry at that position
-              if (iter == internal_vector.end())
-                addscalar(iter,i,i,s);
-              else
+              for (std::size_t i=0; i<mat.size(); ++i)
               {
-                s += (*iter).second;
-                // If new value is zero, then erase the entry, otherwise write new value
-                if (s != 0)
-                  (*iter).second = s;
-                else
-                  internal_vector.erase(iter);
+                for (typename std::map<unsigned int, ScalarType>::const_iterator iter = mat[i].begin(); iter != mat[i].end(); ++iter)
+                {
+                  if (iter->second != ScalarType(0))
+                  {
+                    col_buffer_.push_back(iter->first);
+                    elements_.push_back(iter->second);
+                  }
+                }
+                row_buffer_[i+1] = static_cast<unsigned int>(col_buffer_.size());
               }
             }
 
-            // Write to the map. Is called from non-zero scalar type.
-            template <typename IteratorType>
-            void addscalar(IteratorType & iter, unsigned int i, unsigned int /* j */, ScalarType s)
-            {
-              // Don't write if value is zero
-              if (s == 0)
-                return;
-
-              // If entry is already present, overwrite value, otherwise make new entry
-              if (iter != internal_vector.end())
-                (*iter).second = s;
-              else
-                internal_vector[i] = s;
-            }
-
-            // Remove value from the map. Is called from non-zero scalar type.
-            template <typename IteratorType>
-            void removescalar(IteratorType & iter, unsigned int /* i */) { internal_vector.erase(iter); }
-
-            // Bracket operator. Returns non-zero scalar type with actual values of the respective entry which calls addscalar/removescalar after value is altered.
-            NonzeroScalarType operator [] (unsigned int i)
-            {
-              typename InternalType::iterator it = internal_vector.find(i);
-              // If value is already present then build non-zero scalar with actual value, otherwise 0.
-              if (it != internal_vector.end())
-                return NonzeroScalarType (this,it,i,i,(*it).second);
-              else
-                return NonzeroScalarType (this,it,i,i,0);
-            }
-
-            // Use internal data structure directly for read-only access. No need to use non-zero scalar as no write access possible.
-            ScalarType operator [] (unsigned int i) const
+            /** @brief Constructor. Builds the matrix from another matrix type.
+              * (Only necessary feature of this other matrix type is to have const iterators)
+              * @param mat  Matrix
+              */
+            template <typename MatrixType>
+            amg_sparsematrix(MatrixType const & mat)
+              : size1_(mat.size1()), size2_(mat.size2()), row_buffer_(mat.size1() + 1, 0)
             {
-              const_iterator it = internal_vector.find(i);
+              typedef typename MatrixType::const_iterator1   ConstRowIterator;
+              typedef typename MatrixType::const_iterator2   ConstColIterator;
 
-              if (it != internal_vector.end())
-                return (*it).second;
-              else
-                return 0;
-            }
+              // count the nonzeros of each row first, then fill the rows:
+              for (ConstRowIterator row_iter = mat.begin1(); row_iter != mat.end1(); ++row_iter)
+                for (ConstColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+                  if (*col_iter != ScalarType(0))
+                    ++row_buffer_[col_iter.index1() + 1];
 
-            // Iterator functions.
-            iterator begin() { return iterator(internal_vector); }
-            const_iterator begin() const { return internal_vector.begin(); }
-            iterator end() { return iterator(internal_vector,false); }
-            const_iterator end() const { return internal_vector.end(); }
+              for (std::size_t i=0; i<size1_; ++i)
+                row_buffer_[i+1] += row_buffer_[i];
 
-            // checks whether value at index i is nonzero. More efficient than doing [] == 0.
-            bool isnonzero(unsigned int i) const { return internal_vector.find(i) != internal_vector.end();  }
+              col_buffer_.resize(row_buffer_[size1_]);
+              elements_.resize(row_buffer_[size1_]);
 
-            // Copies data into a ublas vector type.
-            operator boost::numeric::ublas::vector<ScalarType> (void)
-            {
-              boost::numeric::ublas::vector<ScalarType> vec (size_);
-              for (iterator iter = begin(); iter != end(); ++iter)
-                vec [iter.index()] = *iter;
-              return vec;
-            }
-         };
-
-        /** @brief A class for the sparse matrix type.
-        *  Uses vector of maps as data structure for higher performance and lower memory usage.
-        *  Uses similar interface as ublas::compressed_matrix.
-        *  Can deal with transposed of matrix internally: Creation, Storage, Iterators, etc.
-        */
-        template <typename ScalarType>
-        class amg_sparsematrix
-        {
-          public:
-            typedef ScalarType value_type;
-          private:
-            typedef std::map<unsigned int,ScalarType> RowType;
-            typedef std::vector<RowType> InternalType;
-            typedef amg_sparsematrix<ScalarType> self_type;
-
-            // Adapter is used for certain functionality, especially iterators.
-            typedef typename viennacl::tools::sparse_matrix_adapter<ScalarType> AdapterType;
-            typedef typename viennacl::tools::const_sparse_matrix_adapter<ScalarType> ConstAdapterType;
-
-            // Non-zero scalar is used to write to the matrix.
-            typedef amg_nonzero_scalar<self_type,typename RowType::iterator,ScalarType> NonzeroScalarType;
-
-            // Holds matrix coefficients.
-            InternalType internal_mat;
-            // Holds matrix coefficient of transposed matrix if built.
-            // Note: Only internal_mat is written using operators and methods while internal_mat_trans is built from internal_mat using do_trans().
-            InternalType internal_mat_trans;
-            // Saves sizes.
-            std::size_t s1, s2;
-
-            // True if the transposed of the matrix is used (for calculations, iteration, etc.).
-            bool transposed_mode;
-            // True if the transposed is already built (saved in internal_mat_trans) and also up to date (no changes to internal_mat).
-            bool transposed;
-
-          public:
-            typedef typename AdapterType::iterator1 iterator1;
-            typedef typename AdapterType::iterator2 iterator2;
-            typedef typename ConstAdapterType::const_iterator1 const_iterator1;
-            typedef typename ConstAdapterType::const_iterator2 const_iterator2;
+              std::vector<unsigned int> row_fill(row_buffer_.begin(), row_buffer_.end() - 1);
+              for (ConstRowIterator row_iter = mat.begin1(); row_iter != mat.end1(); ++row_iter)
+                for (ConstColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+                  if (*col_iter != ScalarType(0))
+                  {
+                    unsigned int k = row_fill[col_iter.index1()]++;
+                    col_buffer_[k] = static_cast<unsigned int>(col_iter.index2());
+                    elements_[k]   = *col_iter;
+                  }
 
-            /** @brief Standard constructor. */
-            amg_sparsematrix ()
-            {
-              transposed_mode = false;
-              transposed = false;
+              sort_rows();
             }
 
-            /** @brief Constructor. Builds matrix of size (i,j).
-              * @param i  Size of first dimension
-              * @param j  Size of second dimension
+            /** @brief Constructor. Builds the matrix from a ViennaCL compressed_matrix by reading its buffers.
+              * @param mat  Matrix
               */
-            amg_sparsematrix (unsigned int i, unsigned int j)
-            {
-              AdapterType a (internal_mat, i, j);
-              a.resize (i,j,false);
-              AdapterType a_trans (internal_mat_trans, j, i);
-              a_trans.resize (j,i,false);
-              s1 = i;
-              s2 = j;
-              a.clear();
-              a_trans.clear();
-              transposed_mode = false;
-              transposed = false;
-            }
-
-            /** @brief Constructor. Builds matrix via std::vector<std::map> by copying memory
-            * (Only necessary feature of this other matrix type is to have const iterators)
-            * @param mat  Vector of maps
-            */
-            amg_sparsematrix (std::vector<std::map<unsigned int, ScalarType> > const & mat)
+            template <unsigned int ALIGNMENT>
+            amg_sparsematrix(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & mat)
+              : size1_(mat.size1()), size2_(mat.size2()), row_buffer_(mat.size1() + 1, 0)
             {
-              AdapterType a (internal_mat, mat.size(), mat.size());
-              AdapterType a_trans (internal_mat_trans, mat.size(), mat.size());
-              a.resize(mat.size(), mat.size());
-              a_trans.resize(mat.size(), mat.size());
+              if (mat.nnz() == 0)
+                return;
 
-              internal_mat = mat;
-              s1 = s2 = mat.size();
+              viennacl::backend::typesafe_host_array<unsigned int> row_buffer(mat.handle1(), mat.size1() + 1);
+              viennacl::backend::typesafe_host_array<unsigned int> col_buffer(mat.handle2(), mat.nnz());
+              std::vector<ScalarType> elements(mat.nnz());
 
-              transposed_mode = false;
-              transposed = false;
-            }
+              viennacl::backend::memory_read(mat.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+              viennacl::backend::memory_read(mat.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+              viennacl::backend::memory_read(mat.handle(),  0, sizeof(ScalarType) * mat.nnz(), &(elements[0]));
 
-            /** @brief Constructor. Builds matrix via another matrix type.
-              * (Only necessary feature of this other matrix type is to have const iterators)
-              * @param mat  Matrix
-              */
-            template <typename MatrixType>
-            amg_sparsematrix (MatrixType const & mat)
-            {
-              AdapterType a (internal_mat, mat.size1(), mat.size2());
-              AdapterType a_trans (internal_mat_trans, mat.size2(), mat.size1());
-              a.resize(mat.size1(), mat.size2());
-              a_trans.resize (mat.size2(), mat.size1());
-              s1 = mat.size1();
-              s2 = mat.size2();
-              a.clear();
-              a_trans.clear();
-
-              for (typename MatrixType::const_iterator1 row_iter = mat.begin1(); row_iter != mat.end1(); ++row_iter)
+              col_buffer_.reserve(mat.nnz());
+              elements_.reserve(mat.nnz());
+              for (std::size_t i=0; i<size1_; ++i)
               {
-                for (typename MatrixType::const_iterator2 col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+                for (std::size_t k = row_buffer[i]; k < row_buffer[i+1]; ++k)
                 {
-                  if (*col_iter != 0)
+                  if (elements[k] != ScalarType(0))
                   {
-                    unsigned int x = col_iter.index1();
-                    unsigned int y = col_iter.index2();
-                    a (x,y) = *col_iter;
-                    a_trans (y,x) = *col_iter;
+                    col_buffer_.push_back(static_cast<unsigned int>(col_buffer[k]));
+                    elements_.push_back(elements[k]);
                   }
                 }
+                row_buffer_[i+1] = static_cast<unsigned int>(col_buffer_.size());
               }
-              transposed_mode = false;
-              transposed = true;
-            }
 
-            // Build transposed of the current matrix.
-            void do_trans()
-            {
-              // Do it only once if called in a parallel section
-            #ifdef VIENNACL_WITH_OPENMP
-              #pragma omp critical
-            #endif
-              {
-                // Only build transposed if it is not built or not up to date
-                if (!transposed)
-                {
-                  // Mode has to be set to standard mode temporarily
-                  bool save_mode = transposed_mode;
-                  transposed_mode = false;
+              sort_rows();
+            }
 
-                  for (iterator1 row_iter = begin1(); row_iter != end1(); ++row_iter)
-                for (iterator2 col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-                  internal_mat_trans[col_iter.index2()][col_iter.index1()] = *col_iter;
+            std::size_t size1() const { return size1_; }
+            std::size_t size2() const { return size2_; }
+            std::size_t nnz() const { return col_buffer_.size(); }
 
-                  transposed_mode = save_mode;
-                  transposed = true;
-                }
-              }
-            } //do_trans()
+            std::vector<unsigned int> const & row_buffer() const { return row_buffer_; }
+            std::vector<unsigned int> const & col_buffer() const { return col_buffer_; }
+            std::vector<ScalarType>   const & elements()   const { return elements_; }
 
-            // Set transposed mode (true=transposed, false=regular)
-            void set_trans(bool mode)
+            /** @brief Returns the entry (i,j) or zero if there is no such entry. Uses a binary search within row i. */
+            ScalarType operator()(unsigned int i, unsigned int j) const
             {
-              transposed_mode = mode;
-              if (mode)
-                do_trans();
+              std::vector<unsigned int>::const_iterator row_begin = col_buffer_.begin() + row_buffer_[i];
+              std::vector<unsigned int>::const_iterator row_end   = col_buffer_.begin() + row_buffer_[i+1];
+              std::vector<unsigned int>::const_iterator iter = std::lower_bound(row_begin, row_end, j);
+              if (iter != row_end && *iter == j)
+                return elements_[iter - col_buffer_.begin()];
+              return ScalarType(0);
             }
 
-            bool get_trans() const { return transposed_mode; }
-
-            // Checks whether coefficient (i,j) is non-zero. More efficient than using (i,j) == 0.
-            bool isnonzero (unsigned int i, unsigned int j) const
+            /** @brief Computes the transposed matrix by a counting sort over the column indices.
+              * @param result  The transposed matrix
+              */
+            void trans(amg_sparsematrix & result) const
             {
-              if (!transposed_mode)
-              {
-                if (internal_mat[i].find(j) != internal_mat[i].end())
-                  return true;
-                else
-                  return false;
-              }
-              else
-              {
-                if (internal_mat[j].find(i) != internal_mat[j].end())
-                  return true;
-                else
-                  return false;
-              }
-            } //isnonzero()
+              result.size1_ = size2_;
+              result.size2_ = size1_;
+              result.row_buffer_.assign(size2_ + 1, 0);
+              result.col_buffer_.resize(nnz());
+              result.elements_.resize(nnz());
 
-            // Add s to value at (i,j)
-            void add (unsigned int i, unsigned int j, ScalarType s)
-            {
-              // If zero is added then do nothing.
-              if (s == 0)
-                return;
+              for (std::size_t k=0; k<nnz(); ++k)
+                ++result.row_buffer_[col_buffer_[k] + 1];
+              for (std::size_t i=0; i<size2_; ++i)
+                result.row_buffer_[i+1] += result.row_buffer_[i];
 
-              typename RowType::iterator col_iter = internal_mat[i].find(j);
-              // If there is no entry at position (i,j), then make new entry.
-              if (col_iter == internal_mat[i].end())
-                addscalar(col_iter,i,j,s);
-              else
+              // rows are traversed in ascending order, hence the column indices of the transposed matrix come out sorted:
+              std::vector<unsigned int> row_fill(result.row_buffer_.begin(), result.row_buffer_.end() - 1);
+              for (std::size_t i=0; i<size1_; ++i)
               {
-                s += (*col_iter).second;
-                // Update value and erase entry if value is zero.
-                if (s != 0)
-                  (*col_iter).second = s;
-                else
-                  internal_mat[i].erase(col_iter);
+                for (unsigned int k = row_buffer_[i]; k < row_buffer_[i+1]; ++k)
+                {
+                  unsigned int pos = row_fill[col_buffer_[k]]++;
+                  result.col_buffer_[pos] = static_cast<unsigned int>(i);
+                  result.elements_[pos]   = elements_[k];
+                }
               }
-              transposed = false;
-            } //add()
-
-            // Write to the internal data structure. Is called from non-zero scalar type.
-            template <typename IteratorType>
-            void addscalar(IteratorType & iter, unsigned int i, unsigned int j, ScalarType s)
-            {
-              // Don't write if value is zero
-              if (s == 0)
-                return;
-
-              if (iter != internal_mat[i].end())
-                (*iter).second = s;
-              else
-                internal_mat[i][j] = s;
-
-              transposed = false;
-            }
-
-            // Remove entry from internal data structure. Is called from non-zero scalar type.
-            template <typename IteratorType>
-            void removescalar(IteratorType & iter, unsigned int i)
-            {
-              internal_mat[i].erase(iter);
-              transposed = false;
             }
 
-            // Return non-zero scalar at position (i,j). Value is written to the non-zero scalar and updated via addscalar()/removescalar().
-            NonzeroScalarType operator()(unsigned int i, unsigned int j)
+            /** @brief Sets the matrix from rows which were computed independently of each other (typically in parallel).
+              *
+              * Row i was written to the positions slot_start[i], ..., slot_start[i] + row_nnz[i] - 1 of slot_cols and slot_vals, sorted by column index.
+              * Zeros are dropped when compacting the rows into the matrix.
+              * @param rows        Size of first dimension
+              * @param cols        Size of second dimension
+              * @param slot_start  Start of the slot for each row
+              * @param row_nnz     Number of entries written to the slot of each row
+              * @param slot_cols   Column indices of all slots
+              * @param slot_vals   Values of all slots
+              */
+            void set_rows(std::size_t rows, std::size_t cols,
+                          std::vector<unsigned int> const & slot_start,
+                          std::vector<unsigned int> const & row_nnz,
+                          std::vector<unsigned int> const & slot_cols,
+                          std::vector<ScalarType>   const & slot_vals)
             {
-              typename RowType::iterator iter;
+              size1_ = rows;
+              size2_ = cols;
+              row_buffer_.assign(rows + 1, 0);
 
-              if (!transposed_mode)
+#ifdef VIENNACL_WITH_OPENMP
+              #pragma omp parallel for if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+              for (long i = 0; i < static_cast<long>(rows); ++i)
               {
-                iter = internal_mat[i].find(j);
-                if (iter != internal_mat[i].end())
-                  return NonzeroScalarType (this,iter,i,j,(*iter).second);
-                else
-                  return NonzeroScalarType (this,iter,i,j,0);
+                unsigned int count = 0;
+                for (unsigned int k = slot_start[i]; k < slot_start[i] + row_nnz[i]; ++k)
+                  if (slot_vals[k] != ScalarType(0))
+                    ++count;
+                row_buffer_[i+1] = count;
               }
-              else
+
+              for (std::size_t i=0; i<rows; ++i)
+                row_buffer_[i+1] += row_buffer_[i];
+
+              col_buffer_.resize(row_buffer_[rows]);
+              elements_.resize(row_buffer_[rows]);
+
+#ifdef VIENNACL_WITH_OPENMP
+              #pragma omp parallel for if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+              for (long i = 0; i < static_cast<long>(rows); ++i)
               {
-                iter = internal_mat[j].find(i);
-                if (iter != internal_mat[j].end())
-                  return NonzeroScalarType (this,iter,j,i,(*iter).second);
-                else
-                  return NonzeroScalarType (this,iter,j,i,0);
+                unsigned int pos = row_buffer_[i];
+                for (unsigned int k = slot_start[i]; k < slot_start[i] + row_nnz[i]; ++k)
+                {
+                  if (slot_vals[k] != ScalarType(0))
+                  {
+                    col_buffer_[pos] = slot_cols[k];
+                    elements_[pos]   = slot_vals[k];
+                    ++pos;
+                  }
+                }
               }
             }
 
-            // For read-only access return the actual value directly. Non-zero datatype not needed as no write access possible.
-            ScalarType operator()(unsigned int i, unsigned int j) const
+          private:
+            /** @brief Sorts the entries of each row by column index (only required for input matrices with unsorted rows). */
+            void sort_rows()
             {
-              typename RowType::const_iterator iter;
-
-              if (!transposed_mode)
+              std::vector<std::pair<unsigned int, ScalarType> > row;
+              for (std::size_t i=0; i<size1_; ++i)
               {
-                iter = internal_mat[i].find(j);
-                if (iter != internal_mat[i].end())
-                  return (*iter).second;
-                else
-                  return 0;
-              }
-              else
-              {
-                iter = internal_mat[j].find(i);
-                if (iter != internal_mat[j].end())
-                  return (*iter).second;
-                else
-                  return 0;
+                bool sorted = true;
+                for (unsigned int k = row_buffer_[i] + 1; k < row_buffer_[i+1]; ++k)
+                  if (col_buffer_[k-1] > col_buffer_[k])
+                    sorted = false;
+
+                if (sorted)
+                  continue;
+
+                row.clear();
+                for (unsigned int k = row_buffer_[i]; k < row_buffer_[i+1]; ++k)
+                  row.push_back(std::make_pair(col_buffer_[k], elements_[k]));
+                std::sort(row.begin(), row.end());
+                for (unsigned int k = row_buffer_[i]; k < row_buffer_[i+1]; ++k)
+                {
+                  col_buffer_[k] = row[k - row_buffer_[i]].first;
+                  elements_[k]   = row[k - row_buffer_[i]].second;
+                }
               }
             }
 
-            void resize(unsigned int i, unsigned int j, bool preserve = true)
-            {
-              AdapterType a (internal_mat);
-              a.resize(i,j,preserve);
-              AdapterType a_trans (internal_mat_trans);
-              a_trans.resize(j,i,preserve);
-              s1 = i;
-              s2 = j;
-            }
+            std::size_t size1_, size2_;
+            std::vector<unsigned int> row_buffer_;
+            std::vector<unsigned int> col_buffer_;
+            std::vector<ScalarType>   elements_;
+        };
 
-            void clear()
-            {
-              AdapterType a (internal_mat, s1, s2);
-              a.clear();
-              AdapterType a_trans (internal_mat_trans, s2, s1);
-              a_trans.clear();
-              transposed = true;
-            }
 
-            std::size_t size1()
-            {
-              if (!transposed_mode)
-                return s1;
-              else
-                return s2;
-            }
+        /** @brief Strength-of-connection graph of one AMG level in compressed sparse row format.
+        *
+        *  Row i holds the indices of all points strongly influencing point i (or, for the transposed graph, all points influenced by point i) in ascending order.
+        */
+        class amg_influence_graph
+        {
+          public:
+            amg_influence_graph() : row_buffer_(1, 0) {}
 
-            std::size_t size1() const
-            {
-              if (!transposed_mode)
-                return s1;
-              else
-                return s2;
-            }
+            std::size_t size() const { return row_buffer_.size() - 1; }
+            unsigned int row_size(std::size_t i) const { return row_buffer_[i+1] - row_buffer_[i]; }
 
+            std::vector<unsigned int> const & row_buffer() const { return row_buffer_; }
+            std::vector<unsigned int> const & col_buffer() const { return col_buffer_; }
 
-            std::size_t size2()
+            /** @brief Returns true if point j is in row i of the graph. */
+            bool contains(std::size_t i, unsigned int j) const
             {
-              if (!transposed_mode)
-                return s2;
-              else
-                return s1;
+              return std::binary_search(col_buffer_.begin() + row_buffer_[i], col_buffer_.begin() + row_buffer_[i+1], j);
             }
 
-            std::size_t size2() const
+            /** @brief Builds the graph from the sparsity pattern of a matrix, keeping all entries k with is_strong[k] != 0.
+              * @param pattern_rows  Row array of the CSR matrix
+              * @param pattern_cols  Column array of the CSR matrix (sorted within each row)
+              * @param is_strong     One flag per entry of the matrix
+              */
+            void set(std::vector<unsigned int> const & pattern_rows,
+                     std::vector<unsigned int> const & pattern_cols,
+                     std::vector<char> const & is_strong)
             {
-              if (!transposed_mode)
-                return s2;
-              else
-                return s1;
-            }
+              std::size_t rows = pattern_rows.size() - 1;
+              row_buffer_.assign(rows + 1, 0);
 
-            iterator1 begin1(bool trans = false)
-            {
-              if (!trans && !transposed_mode)
-              {
-                AdapterType a (internal_mat, s1, s2);
-                return a.begin1();
-              }
-              else
+#ifdef VIENNACL_WITH_OPENMP
+              #pragma omp parallel for if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+              for (long i = 0; i < static_cast<long>(rows); ++i)
               {
-                do_trans();
-                AdapterType a_trans (internal_mat_trans, s2, s1);
-                return a_trans.begin1();
+                unsigned int count = 0;
+                for (unsigned int k = pattern_rows[i]; k < pattern_rows[i+1]; ++k)
+                  if (is_strong[k])
+                    ++count;
+                row_buffer_[i+1] = count;
               }
-            }
 
-            iterator1 end1(bool trans = false)
-            {
-              if (!trans && !transposed_mode)
-              {
-                AdapterType a (internal_mat, s1, s2);
-                return a.end1();
-              }
-              else
-              {
-                //do_trans();
-                AdapterType a_trans (internal_mat_trans, s2, s1);
-                return a_trans.end1();
-              }
-            }
+              for (std::size_t i=0; i<rows; ++i)
+                row_buffer_[i+1] += row_buffer_[i];
 
-            iterator2 begin2(bool trans = false)
-            {
-              if (!trans && !transposed_mode)
-              {
-                AdapterType a (internal_mat, s1, s2);
-                return a.begin2();
-              }
-              else
-              {
-                do_trans();
-                AdapterType a_trans (internal_mat_trans, s2, s1);
-                return a_trans.begin2();
-              }
-            }
+              col_buffer_.resize(row_buffer_[rows]);
 
-            iterator2 end2(bool trans = false)
-            {
-              if (!trans && !transposed_mode)
-              {
-                AdapterType a (internal_mat, s1, s2);
-                return a.end2();
-              }
-              else
+#ifdef VIENNACL_WITH_OPENMP
+              #pragma omp parallel for if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+              for (long i = 0; i < static_cast<long>(rows); ++i)
               {
-                //do_trans();
-                AdapterType a_trans (internal_mat_trans, s2, s1);
-                return a_trans.end2();
+                unsigned int pos = row_buffer_[i];
+                for (unsigned int k = pattern_rows[i]; k < pattern_rows[i+1]; ++k)
+                  if (is_strong[k])
+                    col_buffer_[pos++] = pattern_cols[k];
               }
             }
 
-            const_iterator1 begin1() const
+            /** @brief Computes the transposed graph, i.e. for each point the points influenced by it. */
+            void trans(amg_influence_graph & result) const
             {
-              // Const_iterator of transposed can only be used if transposed matrix is already built and up to date.
-              assert((!transposed_mode || (transposed_mode && transposed)) && bool("Error: Cannot build const_iterator when transposed has not been built yet!"));
-                    ConstAdapterType a_const (internal_mat, s1, s2);
-              return a_const.begin1();
-            }
+              result.row_buffer_.assign(size() + 1, 0);
+              result.col_buffer_.resize(col_buffer_.size());
 
-            const_iterator1 end1(bool trans = false) const
-            {
-              assert((!transposed_mode || (transposed_mode && transposed)) && bool("Error: Cannot build const_iterator when transposed has not been built yet!"));
-              ConstAdapterType a_const (internal_mat, trans ? s2 : s1, trans ? s1 : s2);
-              return a_const.end1();
-            }
+              for (std::size_t k=0; k<col_buffer_.size(); ++k)
+                ++result.row_buffer_[col_buffer_[k] + 1];
+              for (std::size_t i=0; i<size(); ++i)
+                result.row_buffer_[i+1] += result.row_buffer_[i];
 
-            const_iterator2 begin2(bool trans = false) const
-            {
-              assert((!transposed_mode || (transposed_mode && transposed)) && bool("Error: Cannot build const_iterator when transposed has not been built yet!"));
-              ConstAdapterType a_const (internal_mat, trans ? s2 : s1, trans ? s1 : s2);
-              return a_const.begin2();
+              std::vector<unsigned int> row_fill(result.row_buffer_.begin(), result.row_buffer_.end() - 1);
+              for (std::size_t i=0; i<size(); ++i)
+                for (unsigned int k = row_buffer_[i]; k < row_buffer_[i+1]; ++k)
+                  result.col_buffer_[row_fill[col_buffer_[k]]++] = static_cast<unsigned int>(i);
             }
 
-            const_iterator2 end2(bool trans = false) const
+            /** @brief Replaces each row of the graph by its union with the respective row of another graph of the same size. */
+            void merge(amg_influence_graph const & other)
             {
-              assert((!transposed_mode || (transposed_mode && transposed)) && bool("Error: Cannot build const_iterator when transposed has not been built yet!"));
-              ConstAdapterType a_const (internal_mat, trans ? s2 : s1, trans ? s1 : s2);
-              return a_const.end2();
-            }
+              std::vector<unsigned int> new_rows(size() + 1, 0);
+              std::vector<unsigned int> new_cols;
+              new_cols.reserve(col_buffer_.size() + other.col_buffer_.size());
 
-            // Returns pointer to the internal data structure. Improves performance of copy operation to GPU.
-            std::vector<std::map<unsigned int, ScalarType> > * get_internal_pointer()
-            {
-              if (!transposed_mode)
-                return &internal_mat;
+              for (std::size_t i=0; i<size(); ++i)
+              {
+                std::set_union(col_buffer_.begin() + row_buffer_[i], col_buffer_.begin() + row_buffer_[i+1],
+                               other.col_buffer_.begin() + other.row_buffer_[i], other.col_buffer_.begin() + other.row_buffer_[i+1],
+                               std::back_inserter(new_cols));
+                new_rows[i+1] = static_cast<unsigned int>(new_cols.size());
+              }
 
-              if (!transposed)
-                do_trans();
-              return &internal_mat_trans;
+              row_buffer_.swap(new_rows);
+              col_buffer_.swap(new_cols);
             }
-            operator boost::numeric::ublas::compressed_matrix<ScalarType> (void)
-            {
-              boost::numeric::ublas::compressed_matrix<ScalarType> mat;
-              mat.resize(size1(),size2(),false);
-              mat.clear();
 
-              for (iterator1 row_iter = begin1(); row_iter != end1(); ++row_iter)
-                  for (iterator2 col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-                    mat (col_iter.index1(), col_iter.index2()) = *col_iter;
-
-              return mat;
-            }
-            operator boost::numeric::ublas::matrix<ScalarType> (void)
+            /** @brief Releases the memory of the graph. */
+            void clear()
             {
-              boost::numeric::ublas::matrix<ScalarType> mat;
-              mat.resize(size1(),size2(),false);
-              mat.clear();
-
-              for (iterator1 row_iter = begin1(); row_iter != end1(); ++row_iter)
-                  for (iterator2 col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-                    mat (col_iter.index1(), col_iter.index2()) = *col_iter;
-
-              return mat;
+              std::vector<unsigned int>(1, 0).swap(row_buffer_);
+              std::vector<unsigned int>().swap(col_buffer_);
             }
-        };
 
-        /** @brief A class for the AMG points.
-        *   Saves point index and influence measure
-        *  Holds information whether point is undecided, C or F point.
-        *  Holds lists of points that are influenced by or influencing this point
-        */
-        class amg_point
-        {
           private:
-            typedef amg_sparsevector<amg_point*> ListType;
-
-            unsigned int index_;
-            unsigned int influence_;
-            // Determines whether point is undecided.
-            bool undecided_;
-            // Determines wheter point is C point (true) or F point (false).
-            bool cpoint_;
-            unsigned int coarse_index_;
-            // Index offset of parallel coarsening. In that case a point acts as if it had an index of index_-offset_ and treats other points as if they had an index of index+offset_
-            unsigned int offset_;
-            // Aggregate the point belongs to.
-            unsigned int aggregate_;
-
-            // Holds all points influencing this point.
-            ListType influencing_points;
-            // Holds all points that are influenced by this point.
-            ListType influenced_points;
-
-          public:
-            typedef ListType::iterator iterator;
-            typedef ListType::const_iterator const_iterator;
-
-            /** @brief The constructor.
-            */
-            amg_point (unsigned int index, unsigned int size): index_(index), influence_(0), undecided_(true), cpoint_(false), coarse_index_(0), offset_(0), aggregate_(0)
-            {
-              influencing_points = ListType(size);
-              influenced_points = ListType(size);
-            }
-
-            void set_offset(unsigned int offset) { offset_ = offset; }
-            unsigned int get_offset() { return offset_; }
-            void set_index(unsigned int index) { index_ = index+offset_; }
-            unsigned int get_index() const { return index_-offset_;  }
-            unsigned int get_influence() const { return influence_;  }
-            void set_aggregate(unsigned int aggregate) { aggregate_ = aggregate; }
-            unsigned int get_aggregate () { return aggregate_; }
-
-            bool is_cpoint() const { return cpoint_ && !undecided_;  }
-            bool is_fpoint() const { return !cpoint_ && !undecided_; }
-            bool is_undecided() const { return undecided_; }
-
-            // Returns number of influencing points
-            unsigned int number_influencing() const  { return influencing_points.internal_size(); }
-            // Returns true if *point is influencing this point
-            bool is_influencing(amg_point* point) const { return influencing_points.isnonzero(point->get_index()+offset_); }
-            // Add *point to influencing points
-            void add_influencing_point(amg_point* point) { influencing_points[point->get_index()+offset_] = point;  }
-            // Add *point to influenced points
-            void add_influenced_point(amg_point* point) { influenced_points[point->get_index()+offset_] = point; }
-
-            // Clear influencing points
-            void clear_influencing() { influencing_points.clear(); }
-            // Clear influenced points
-            void clear_influenced() {influenced_points.clear(); }
-
-
-            unsigned int get_coarse_index() const { return coarse_index_; }
-            void set_coarse_index(unsigned int index) { coarse_index_ = index; }
-
-            // Calculates the initial influence measure equal to the number of influenced points.
-            void calc_influence() { influence_ = influenced_points.internal_size();  }
-
-            // Add to influence measure.
-            unsigned int add_influence(int add)
-            {
-              influence_ += add;
-              return influence_;
-            }
-            // Make this point C point. Only call via amg_pointvector.
-            void make_cpoint()
-            {
-              undecided_ = false;
-              cpoint_ = true;
-              influence_ = 0;
-            }
-            // Make this point F point. Only call via amg_pointvector.
-            void make_fpoint()
-            {
-              undecided_ = false;
-              cpoint_ = false;
-              influence_ = 0;
-            }
-            // Switch point from F to C point. Only call via amg_pointvector.
-            void switch_ftoc() { cpoint_ = true; }
-
-            // Iterator handling for influencing and influenced points.
-            iterator begin_influencing() { return influencing_points.begin(); }
-            iterator end_influencing() { return influencing_points.end(); }
-            const_iterator begin_influencing() const { return influencing_points.begin(); }
-            const_iterator end_influencing() const { return influencing_points.end(); }
-            iterator begin_influenced() { return influenced_points.begin();  }
-            iterator end_influenced() { return influenced_points.end(); }
-            const_iterator begin_influenced() const { return influenced_points.begin(); }
-            const_iterator end_influenced() const { return influenced_points.end(); }
+            std::vector<unsigned int> row_buffer_;
+            std::vector<unsigned int> col_buffer_;
         };
 
-        /** @brief Comparison class for the sorted set of points in amg_pointvector. Set is sorted by influence measure from lower to higher with the point-index as tie-breaker.
-        */
-        struct classcomp
-        {
-          // Function returns true if l comes before r in the ordering.
-          bool operator() (amg_point* l, amg_point* r) const
-          {
-            // Map is sorted by influence number starting with the highest
-            // If influence number is the same then lowest point index comes first
-            return (l->get_influence() < r->get_influence() || (l->get_influence() == r->get_influence() && l->get_index() > r->get_index()));
-          }
-        };
 
-        /** @brief A class for the AMG points.
-        *  Holds pointers of type amg_point in a vector that can be accessed using [point-index].
-        *  Additional list of pointers sorted by influence number and index to improve coarsening performance (see amg_coarse_classic_onepass() in amg_coarse.hpp)
-        *  Constructs indices for C points on the coarse level, needed for interpolation.
+        /** @brief The points of one AMG level: C/F splitting, coarse indices, aggregates, and the strength-of-connection graphs.
+        *
+        *  All information is kept in flat arrays indexed by the point index (i.e. the row index of the system matrix on this level).
         */
         class amg_pointvector
         {
           private:
-            // Type for the sorted list
-            typedef std::set<amg_point*,classcomp> ListType;
-            // Type for the vector of pointers
-            typedef std::vector<amg_point*> VectorType;
-            VectorType pointvector;
-            ListType pointlist;
-            unsigned int size_;
-            unsigned int c_points, f_points;
+            enum { undecided_point = 0, c_point = 1, f_point = 2 };
 
           public:
-            typedef VectorType::iterator iterator;
-            typedef VectorType::const_iterator const_iterator;
-
             /** @brief The constructor.
-            *  @param size    Number of points
+            * @param size    Number of points
             */
-            amg_pointvector(unsigned int size = 0): size_(size)
-            {
-              pointvector = VectorType(size);
-              c_points = f_points = 0;
-            }
+            amg_pointvector(std::size_t size = 0)
+              : types_(size, undecided_point), coarse_index_(size, 0), aggregate_(size, 0), cpoints_(0), fpoints_(0) {}
 
-            // Construct all the points dynamically and save pointers into vector.
-            void init_points()
-            {
-              for (unsigned int i=0; i<size(); ++i)
-                pointvector[i] = new amg_point(i,size());
-            }
-            // Delete all the points.
-            void delete_points()
-            {
-              for (unsigned int i=0; i<size(); ++i)
-                delete pointvector[i];
-            }
-            // Add point to the vector. Note: User has to make sure that point at point->get_index() does not exist yet, otherwise it will be overwritten!
-            void add_point(amg_point *point)
-            {
-              pointvector[point->get_index()] = point;
-              if (point->is_cpoint()) c_points++;
-              else if (point->is_fpoint()) f_points++;
-            }
+            std::size_t size() const { return types_.size(); }
 
-            // Update C and F count for point *point.
-            // Necessary if C and F points were constructed outside this data structure (e.g. by parallel coarsening RS0 or RS3).
-            void update_cf(amg_point *point)
-            {
-              if (point->is_cpoint()) c_points++;
-              else if (point->is_fpoint()) f_points++;
-            }
-            // Clear the C and F point count.
-            void clear_cf() { c_points = f_points = 0; }
+            bool is_cpoint(std::size_t i) const { return types_[i] == c_point; }
+            bool is_fpoint(std::size_t i) const { return types_[i] == f_point; }
+            bool is_undecided(std::size_t i) const { return types_[i] == undecided_point; }
 
-            // Clear both point lists.
-            void clear_influencelists()
+            void make_cpoint(std::size_t i) { types_[i] = c_point; }
+            void make_fpoint(std::size_t i) { types_[i] = f_point; }
+
+            /** @brief Recounts the number of C and F points. To be called once the coarsening of the level is complete. */
+            void update_cf()
             {
-              for (iterator iter = pointvector.begin(); iter != pointvector.end(); ++iter)
+              cpoints_ = 0;
+              fpoints_ = 0;
+              for (std::size_t i=0; i<types_.size(); ++i)
               {
-                (*iter)->clear_influencing();
-                (*iter)->clear_influenced();
+                if (types_[i] == c_point)
+                  ++cpoints_;
+                else if (types_[i] == f_point)
+                  ++fpoints_;
               }
             }
+            unsigned int get_cpoints() const { return cpoints_; }
+            unsigned int get_fpoints() const { return fpoints_; }
 
-            amg_point* operator [] (unsigned int i) const { return pointvector[i]; }
-            iterator begin() { return pointvector.begin(); }
-            iterator end() { return pointvector.end(); }
-            const_iterator begin() const { return pointvector.begin(); }
-            const_iterator end() const { return pointvector.end(); }
-
-            void resize(unsigned int size)
-            {
-              size_ = size;
-              pointvector = VectorType(size);
-            }
-            unsigned int size() const { return size_; }
-
-            // Returns number of C points
-            unsigned int get_cpoints() const { return c_points; }
-            // Returns number of F points
-            unsigned int get_fpoints() const { return f_points; }
-
-            // Does the initial sorting of points into the list. Sorting is automatically done by the std::set data type.
-            void sort()
-            {
-              for (iterator iter = begin(); iter != end(); ++iter)
-                pointlist.insert(*iter);
-            }
-            // Returns the point with the highest influence measure
-            amg_point* get_nextpoint()
-            {
-              // No points remaining? Return NULL such that coarsening will stop.
-              if (pointlist.size() == 0)
-                return NULL;
-              // If point with highest influence measure (end of the list) has measure of zero, then no further C points can be constructed. Return NULL.
-              if ((*(--pointlist.end()))->get_influence() == 0)
-                return NULL;
-              // Otherwise, return the point with highest influence measure located at the end of the list.
-              else
-                return *(--pointlist.end());
-            }
-            // Add "add" to influence measure for point *point in the sorted list.
-            void add_influence(amg_point* point, unsigned int add)
-            {
-              ListType::iterator iter = pointlist.find(point);
-              // If point is not in the list then stop.
-              if (iter == pointlist.end()) return;
-
-              // Save iterator and decrement
-              ListType::iterator iter2 = iter;
-              iter2--;
-
-              // Point has to be erased first as changing the value does not re-order the std::set
-              pointlist.erase(iter);
-              point->add_influence(add);
-
-              // Insert point back into the list. Using the iterator improves performance. The new position has to be at the same position or to the right of the old.
-              pointlist.insert(iter2,point);
-            }
-            // Make *point to C point and remove from sorted list
-            void make_cpoint(amg_point* point)
-            {
-              pointlist.erase(point);
-              point->make_cpoint();
-              c_points++;
-            }
-            // Make *point to F point and remove from sorted list
-            void make_fpoint(amg_point* point)
-            {
-              pointlist.erase(point);
-              point->make_fpoint();
-              f_points++;
-            }
-            // Swich *point from F to C point
-            void switch_ftoc(amg_point* point)
-            {
-              point->switch_ftoc();
-              c_points++;
-              f_points--;
-            }
-
-            // Build vector of indices for C point on the coarse level.
+            /** @brief Numbers the C points consecutively. The coarse index of a C point is its index on the next coarser level. */
             void build_index()
             {
               unsigned int count = 0;
-              // Use simple counter for index creation.
-              for (iterator iter = pointvector.begin(); iter != pointvector.end(); ++iter)
-              {
-                // Set index on coarse level using counter variable
-                if ((*iter)->is_cpoint())
-                {
-                  (*iter)->set_coarse_index(count);
-                  count++;
-                }
-              }
+              for (std::size_t i=0; i<types_.size(); ++i)
+                if (types_[i] == c_point)
+                  coarse_index_[i] = count++;
             }
+            unsigned int get_coarse_index(std::size_t i) const { return coarse_index_[i]; }
 
-            // Return information for debugging purposes
-            template <typename MatrixType>
-            void get_influence_matrix(MatrixType & mat) const
-            {
-              mat = MatrixType(size(),size());
-              mat.clear();
+            void set_aggregate(std::size_t i, unsigned int aggregate) { aggregate_[i] = aggregate; }
+            unsigned int get_aggregate(std::size_t i) const { return aggregate_[i]; }
 
-              for (const_iterator row_iter = begin(); row_iter != end(); ++row_iter)
-                for (amg_point::iterator col_iter = (*row_iter)->begin_influencing(); col_iter != (*row_iter)->end_influencing(); ++col_iter)
-                  mat((*row_iter)->get_index(),(*col_iter)->get_index()) = true;
-            }
-            template <typename VectorType>
-            void get_influence(VectorType & vec) const
-            {
-              vec = VectorType(size_);
-              vec.clear();
+            /** @brief Returns the graph holding for each point the points it is strongly influenced by. */
+            amg_influence_graph       & influencing()       { return influencing_; }
+            amg_influence_graph const & influencing() const { return influencing_; }
 
-              for (const_iterator iter = begin(); iter != end(); ++iter)
-                vec[(*iter)->get_index()] = (*iter)->get_influence();
-            }
-            template <typename VectorType>
-            void get_sorting(VectorType & vec) const
-            {
-              vec = VectorType(pointlist.size());
-              vec.clear();
-              unsigned int i=0;
+            /** @brief Returns the graph holding for each point the points it strongly influences. */
+            amg_influence_graph       & influenced()       { return influenced_; }
+            amg_influence_graph const & influenced() const { return influenced_; }
 
-              for (ListType::const_iterator iter = pointlist.begin(); iter != pointlist.end(); ++iter)
-              {
-                vec[i] = (*iter)->get_index();
-                i++;
-              }
-            }
-            template <typename VectorType>
-            void get_C(VectorType & vec) const
+            /** @brief Releases the memory of the influence graphs once the level is set up. */
+            void clear_influencelists()
             {
-              vec = VectorType(size_);
-              vec.clear();
-
-              for (const_iterator iter = begin(); iter != end(); ++iter)
-              {
-                if ((*iter)->is_cpoint())
-                  vec[(*iter)->get_index()] = true;
-              }
+              influencing_.clear();
+              influenced_.clear();
             }
-            template <typename VectorType>
-            void get_F(VectorType & vec) const
-            {
-              vec = VectorType(size_);
-              vec.clear();
 
-              for (const_iterator iter = begin(); iter != end(); ++iter)
-              {
-                if ((*iter)->is_fpoint())
-                  vec[(*iter)->get_index()] = true;
-              }
-            }
-            template <typename MatrixType>
-            void get_Aggregates(MatrixType & mat) const
-            {
-              mat = MatrixType(size_,size_);
-              mat.clear();
+          private:
+            std::vector<char>         types_;
+            std::vector<unsigned int> coarse_index_;
+            std::vector<unsigned int> aggregate_;
+            unsigned int cpoints_, fpoints_;
 
-              for (const_iterator iter = begin(); iter != end(); ++iter)
-              {
-                if (!(*iter)->is_undecided())
-                  mat((*iter)->get_aggregate(),(*iter)->get_index()) = true;
-              }
-            }
+            amg_influence_graph influencing_;
+            amg_influence_graph influenced_;
         };
 
+
         /** @brief A class for the matrix slicing for parallel coarsening schemes (RS0/RS3).
-          * @brief Holds information on a per-processor basis and offers functionality to slice and join the data structures.
+          * @brief Each thread coarsens a contiguous range of points. Points stay in the same slice on all levels.
           */
-        template <typename InternalType1, typename InternalType2>
         class amg_slicing
         {
-            typedef typename InternalType1::value_type SparseMatrixType;
-            typedef typename InternalType2::value_type PointVectorType;
-
           public:
-            // Data structures on a per-processor basis.
-            boost::numeric::ublas::vector<InternalType1> A_slice;
-            boost::numeric::ublas::vector<InternalType2> Pointvector_slice;
-            // Holds the offsets showing the indices for which a new slice begins.
-            boost::numeric::ublas::vector<boost::numeric::ublas::vector<unsigned int> > Offset;
+            // Holds the offsets showing the indices for which a new slice begins: Offset[level][i] is the first point of slice i, Offset[level][threads_] the number of points.
+            std::vector<std::vector<unsigned int> > Offset;
 
             unsigned int threads_;
             unsigned int levels_;
@@ -1193,304 +619,339 @@ namespace viennacl
 
               levels_ = levels;
 
-              A_slice.resize(threads_);
-              Pointvector_slice.resize(threads_);
-              // Offset has threads_+1 entries to also hold the total size
-              Offset.resize(threads_+1);
-
-              for (unsigned int i=0; i<threads_; ++i)
-              {
-                A_slice[i].resize(levels_);
-                Pointvector_slice[i].resize(levels_);
-                // Offset needs one more level for the build-up of the next offset
-                Offset[i].resize(levels_+1);
-              }
-              Offset[threads_].resize(levels_+1);
+              // Offset needs one more level for the build-up of the next offset
+              Offset.assign(levels_ + 1, std::vector<unsigned int>(threads_ + 1, 0));
             } //init()
 
-            // Slice matrix A into as many parts as threads are used.
-            void slice (unsigned int level, InternalType1 const & A, InternalType2 const & Pointvector)
-            {
-              // On the finest level, build a new slicing first.
-              if (level == 0)
-                slice_new (level, A);
-
-              // On coarser levels use the same slicing as on the finest level (Points stay together on the same thread on all levels).
-              // This is necessary as due to interpolation and galerkin product there only exist connections between points on the same thread on coarser levels.
-              // Note: Offset is determined in amg_coarse_rs0() after fine level was built.
-              slice_build (level, A, Pointvector);
-            }
-
-            // Join point data structure into Pointvector
-            void join (unsigned int level, InternalType2 & Pointvector) const
-            {
-              typedef typename InternalType2::value_type PointVectorType;
-
-              // Reset index offset of all points and update overall C and F point count
-              Pointvector[level].clear_cf();
-              for (typename PointVectorType::iterator iter = Pointvector[level].begin(); iter != Pointvector[level].end(); ++iter)
-              {
-                (*iter)->set_offset(0);
-                Pointvector[level].update_cf(*iter);
-              }
-            }
-
-          private:
-            /** @brief Slices mat into this->threads parts of (almost) equal size
+            /** @brief Slices the points of a level into threads_ parts of (almost) equal size
             * @param level    Level for which slicing is requested
-            * @param A     System matrix on all levels
+            * @param size     Number of points on the level
             */
-            void slice_new (unsigned int level, InternalType1 const & A)
+            void slice_new(unsigned int level, std::size_t size)
             {
-              // Determine index offset of all the slices (index of A[level] when the respective slice starts).
-            #ifdef VIENNACL_WITH_OPENMP
-              #pragma omp parallel for
-            #endif
-              for (unsigned int i=0; i<=threads_; ++i)
-              {
-                // Offset of first piece is zero. Pieces 1,...,threads-1 have equal size while the last one might be greater.
-                if (i == 0) Offset[i][level] = 0;
-                else if (i == threads_) Offset[i][level] = A[level].size1();
-                else Offset[i][level] = i*(A[level].size1()/threads_);
-              }
+              // Offset of first piece is zero. Pieces 1,...,threads-1 have equal size while the last one might be greater.
+              for (unsigned int i=0; i<threads_; ++i)
+                Offset[level][i] = i * static_cast<unsigned int>(size / threads_);
+              Offset[level][threads_] = static_cast<unsigned int>(size);
             }
 
-            /** @brief Slices mat into pieces determined by this->Offset
-            * @param level    Level to which Slices are saved
-            * @param A     System matrix on all levels
-            * @param Pointvector  Vector of points on all levels
+            /** @brief Determines the slices of the next coarser level: The C points of a slice form the respective slice on the next level.
+            * @param level    Level on which the coarsening is complete
+            * @param points   Points of this level
             */
-            void slice_build (unsigned int level, InternalType1 const & A, InternalType2 const & Pointvector)
+            void slice_next(unsigned int level, amg_pointvector const & points)
             {
-              typedef typename SparseMatrixType::const_iterator1 ConstRowIterator;
-              typedef typename SparseMatrixType::const_iterator2 ConstColIterator;
-
-              unsigned int x, y;
-              amg_point *point;
-
-            #ifdef VIENNACL_WITH_OPENMP
-              #pragma omp parallel for private (x,y,point)
-            #endif
+              Offset[level+1][0] = 0;
               for (unsigned int i=0; i<threads_; ++i)
               {
-                // Allocate space for the matrix slice and the pointvector.
-                A_slice[i][level] = SparseMatrixType(Offset[i+1][level]-Offset[i][level],Offset[i+1][level]-Offset[i][level]);
-                Pointvector_slice[i][level] = PointVectorType(Offset[i+1][level]-Offset[i][level]);
-
-                // Iterate over the part that belongs to thread i (from Offset[i][level] to Offset[i+1][level]).
-                ConstRowIterator row_iter = A[level].begin1();
-                row_iter += Offset[i][level];
-                x = row_iter.index1();
-
-                while (x < Offset[i+1][level] && row_iter != A[level].end1())
-                {
-                  // Set offset for point index and save point for the respective thread
-                  point = Pointvector[level][x];
-                  point->set_offset(Offset[i][level]);
-                  Pointvector_slice[i][level].add_point(point);
-
-                  ConstColIterator col_iter = row_iter.begin();
-                  y = col_iter.index2();
-
-                  // Save all coefficients from the matrix slice
-                  while (y < Offset[i+1][level] && col_iter != row_iter.end())
-                  {
-                    if (y >= Offset[i][level])
-                A_slice[i][level](x-Offset[i][level],y-Offset[i][level]) = *col_iter;
-
-                    ++col_iter;
-                    y = col_iter.index2();
-                  }
-
-                  ++row_iter;
-                  x = row_iter.index1();
-                }
+                unsigned int cpoints = 0;
+                for (unsigned int j = Offset[level][i]; j < Offset[level][i+1]; ++j)
+                  if (points.is_cpoint(j))
+                    ++cpoints;
+                Offset[level+1][i+1] = Offset[level+1][i] + cpoints;
               }
             }
         };
 
         /** @brief Sparse matrix product. Calculates RES = A*B.
+          *
+          * Row-by-row product in two passes: A symbolic pass counts the entries of each row of RES, the numeric pass then accumulates each row in a dense work array.
+          * Both passes run in parallel over the rows of A.
           * @param A    Left Matrix
           * @param B    Right Matrix
           * @param RES    Result Matrix
           */
-        template <typename SparseMatrixType>
-        void amg_mat_prod (SparseMatrixType & A, SparseMatrixType & B, SparseMatrixType & RES)
+        template <typename ScalarType>
+        void amg_mat_prod(amg_sparsematrix<ScalarType> const & A, amg_sparsematrix<ScalarType> const & B, amg_sparsematrix<ScalarType> & RES)
         {
-          typedef typename SparseMatrixType::value_type ScalarType;
-          typedef typename SparseMatrixType::iterator1 InternalRowIterator;
-          typedef typename SparseMatrixType::iterator2 InternalColIterator;
-
-          unsigned int x,y,z;
-          ScalarType prod;
-          RES = SparseMatrixType(A.size1(), B.size2());
-          RES.clear();
-
-    #ifdef VIENNACL_WITH_OPENMP
-          #pragma omp parallel for private (x,y,z,prod) shared (A,B,RES)
-    #endif
-          for (x=0; x<A.size1(); ++x)
+          std::vector<unsigned int> const & A_rows = A.row_buffer();
+          std::vector<unsigned int> const & A_cols = A.col_buffer();
+          std::vector<ScalarType>   const & A_vals = A.elements();
+          std::vector<unsigned int> const & B_rows = B.row_buffer();
+          std::vector<unsigned int> const & B_cols = B.col_buffer();
+          std::vector<ScalarType>   const & B_vals = B.elements();
+
+          long rows = static_cast<long>(A.size1());
+          unsigned int const no_entry = static_cast<unsigned int>(A.size1());
+
+          // symbolic pass: number of entries in each row of the result
+          std::vector<unsigned int> slot_start(A.size1() + 1, 0);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
           {
-            InternalRowIterator row_iter = A.begin1();
-            row_iter += x;
-            for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-            {
-              y = col_iter.index2();
-              InternalRowIterator row_iter2 = B.begin1();
-              row_iter2 += y;
+            std::vector<unsigned int> marker(B.size2(), no_entry);
 
-              for(InternalColIterator col_iter2 = row_iter2.begin(); col_iter2 != row_iter2.end(); ++col_iter2)
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for
+#endif
+            for (long x = 0; x < rows; ++x)
+            {
+              unsigned int count = 0;
+              for (unsigned int k = A_rows[x]; k < A_rows[x+1]; ++k)
               {
-                z = col_iter2.index2();
-                prod = *col_iter * *col_iter2;
-                RES.add(x,z,prod);
+                unsigned int y = A_cols[k];
+                for (unsigned int l = B_rows[y]; l < B_rows[y+1]; ++l)
+                {
+                  if (marker[B_cols[l]] != static_cast<unsigned int>(x))
+                  {
+                    marker[B_cols[l]] = static_cast<unsigned int>(x);
+                    ++count;
+                  }
+                }
               }
+              slot_start[x+1] = count;
             }
           }
-        }
 
-        /** @brief Sparse Galerkin product: Calculates RES = trans(P)*A*P
-          * @param A    Operator matrix (quadratic)
-          * @param P    Prolongation/Interpolation matrix
-          * @param RES    Result Matrix (Galerkin operator)
-          */
-        template <typename SparseMatrixType>
-        void amg_galerkin_prod (SparseMatrixType & A, SparseMatrixType & P, SparseMatrixType & RES)
-        {
-          typedef typename SparseMatrixType::value_type ScalarType;
-          typedef typename SparseMatrixType::iterator1 InternalRowIterator;
-          typedef typename SparseMatrixType::iterator2 InternalColIterator;
-
-          unsigned int x,y1,y2,z;
-          amg_sparsevector<ScalarType> row;
-          RES = SparseMatrixType(P.size2(), P.size2());
-          RES.clear();
-
-    #ifdef VIENNACL_WITH_OPENMP
-          #pragma omp parallel for private (x,y1,y2,z,row) shared (A,P,RES)
-    #endif
-          for (x=0; x<P.size2(); ++x)
+          for (long x = 0; x < rows; ++x)
+            slot_start[x+1] += slot_start[x];
+
+          // numeric pass:
+          std::vector<unsigned int> row_nnz(A.size1());
+          std::vector<unsigned int> slot_cols(slot_start[A.size1()]);
+          std::vector<ScalarType>   slot_vals(slot_start[A.size1()]);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
           {
-            row = amg_sparsevector<ScalarType>(A.size2());
-            InternalRowIterator row_iter = P.begin1(true);
-            row_iter += x;
+            std::vector<ScalarType> row(B.size2());
+            std::vector<unsigned int> marker(B.size2(), no_entry);
+            std::vector<unsigned int> row_cols;
 
-            for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for
+#endif
+            for (long x = 0; x < rows; ++x)
             {
-              y1 = col_iter.index2();
-              InternalRowIterator row_iter2 = A.begin1();
-              row_iter2 += y1;
-
-              for(InternalColIterator col_iter2 = row_iter2.begin(); col_iter2 != row_iter2.end(); ++col_iter2)
+              row_cols.clear();
+              for (unsigned int k = A_rows[x]; k < A_rows[x+1]; ++k)
               {
-                y2 = col_iter2.index2();
-                row.add (y2, *col_iter * *col_iter2);
+                unsigned int y = A_cols[k];
+                for (unsigned int l = B_rows[y]; l < B_rows[y+1]; ++l)
+                {
+                  unsigned int z = B_cols[l];
+                  if (marker[z] != static_cast<unsigned int>(x))
+                  {
+                    marker[z] = static_cast<unsigned int>(x);
+                    row[z] = 0;
+                    row_cols.push_back(z);
+                  }
+                  row[z] += A_vals[k] * B_vals[l];
+                }
               }
-            }
-            for (typename amg_sparsevector<ScalarType>::iterator iter = row.begin(); iter != row.end(); ++iter)
-            {
-              y2 = iter.index();
-              InternalRowIterator row_iter3 = P.begin1();
-              row_iter3 += y2;
 
-              for (InternalColIterator col_iter3 = row_iter3.begin(); col_iter3 != row_iter3.end(); ++col_iter3)
+              std::sort(row_cols.begin(), row_cols.end());
+              for (std::size_t i=0; i<row_cols.size(); ++i)
               {
-                z = col_iter3.index2();
-                RES.add (x, z, *col_iter3 * *iter);
+                slot_cols[slot_start[x] + i] = row_cols[i];
+                slot_vals[slot_start[x] + i] = row[row_cols[i]];
               }
+              row_nnz[x] = static_cast<unsigned int>(row_cols.size());
             }
           }
 
-          #ifdef VIENNACL_AMG_DEBUG
-          std::cout << "Galerkin Operator: " << std::endl;
-          printmatrix (RES);
-          #endif
+          RES.set_rows(A.size1(), B.size2(), slot_start, row_nnz, slot_cols, slot_vals);
         }
 
-        /** @brief Test triple-matrix product by comparing it to ublas functions. Very slow for large matrices!
+        /** @brief Sparse Galerkin product: Calculates RES = trans(P)*A*P
+          *
+          * Each row x of RES is computed from row x of trans(P) by first accumulating the fine-level row trans(P)*A in a dense work array and then multiplying it with P.
+          * As for amg_mat_prod(), a symbolic pass determines the size of each row, so that the numeric pass can run in parallel without synchronization.
           * @param A    Operator matrix (quadratic)
           * @param P    Prolongation/Interpolation matrix
-          * @param A_i1    Result Matrix
+          * @param RES    Result Matrix (Galerkin operator)
           */
-        template <typename SparseMatrixType>
-        void test_triplematprod(SparseMatrixType & A, SparseMatrixType & P, SparseMatrixType  & A_i1)
+        template <typename ScalarType>
+        void amg_galerkin_prod(amg_sparsematrix<ScalarType> const & A, amg_sparsematrix<ScalarType> const & P, amg_sparsematrix<ScalarType> & RES)
         {
-          typedef typename SparseMatrixType::value_type ScalarType;
-
-          boost::numeric::ublas::compressed_matrix<ScalarType> A_temp (A.size1(), A.size2());
-          A_temp = A;
-          boost::numeric::ublas::compressed_matrix<ScalarType> P_temp (P.size1(), P.size2());
-          P_temp = P;
-          P.set_trans(true);
-          boost::numeric::ublas::compressed_matrix<ScalarType> R_temp (P.size1(), P.size2());
-          R_temp = P;
-          P.set_trans(false);
-
-          boost::numeric::ublas::compressed_matrix<ScalarType> RA (R_temp.size1(),A_temp.size2());
-          RA = boost::numeric::ublas::prod(R_temp,A_temp);
-          boost::numeric::ublas::compressed_matrix<ScalarType> RAP (RA.size1(),P_temp.size2());
-          RAP = boost::numeric::ublas::prod(RA,P_temp);
-
-          for (unsigned int x=0; x<RAP.size1(); ++x)
+          amg_sparsematrix<ScalarType> R;
+          P.trans(R);
+
+          std::vector<unsigned int> const & R_rows = R.row_buffer();
+          std::vector<unsigned int> const & R_cols = R.col_buffer();
+          std::vector<ScalarType>   const & R_vals = R.elements();
+          std::vector<unsigned int> const & A_rows = A.row_buffer();
+          std::vector<unsigned int> const & A_cols = A.col_buffer();
+          std::vector<ScalarType>   const & A_vals = A.elements();
+          std::vector<unsigned int> const & P_rows = P.row_buffer();
+          std::vector<unsigned int> const & P_cols = P.col_buffer();
+          std::vector<ScalarType>   const & P_vals = P.elements();
+
+          long coarse_rows = static_cast<long>(P.size2());
+          unsigned int const no_entry = static_cast<unsigned int>(P.size2());
+
+          // symbolic pass: number of entries in each row of the result
+          std::vector<unsigned int> slot_start(P.size2() + 1, 0);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel if (coarse_rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
           {
-            for (unsigned int y=0; y<RAP.size2(); ++y)
+            std::vector<unsigned int> fine_marker(A.size2(), no_entry);
+            std::vector<unsigned int> coarse_marker(P.size2(), no_entry);
+
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for
+#endif
+            for (long x = 0; x < coarse_rows; ++x)
             {
-              if (std::fabs(static_cast<ScalarType>(RAP(x,y)) - static_cast<ScalarType>(A_i1(x,y))) > 0.0001)
-                std::cout << x << " " << y << " " << RAP(x,y) << " " << A_i1(x,y) << std::endl;
+              unsigned int count = 0;
+              for (unsigned int k = R_rows[x]; k < R_rows[x+1]; ++k)
+              {
+                unsigned int y1 = R_cols[k];
+                for (unsigned int l = A_rows[y1]; l < A_rows[y1+1]; ++l)
+                {
+                  unsigned int y2 = A_cols[l];
+                  if (fine_marker[y2] == static_cast<unsigned int>(x))
+                    continue;
+                  fine_marker[y2] = static_cast<unsigned int>(x);
+
+                  for (unsigned int m = P_rows[y2]; m < P_rows[y2+1]; ++m)
+                  {
+                    if (coarse_marker[P_cols[m]] != static_cast<unsigned int>(x))
+                    {
+                      coarse_marker[P_cols[m]] = static_cast<unsigned int>(x);
+                      ++count;
+                    }
+                  }
+                }
+              }
+              slot_start[x+1] = count;
             }
           }
-        }
 
-        /** @brief Test if interpolation matrix makes sense. Only vanilla test though! Only checks if basic requirements are met!
-          * @param A    Operator matrix (quadratic)
-          * @param P    Prolongation/Interpolation matrix
-          * @param Pointvector  Vector of points
-          */
-        template <typename SparseMatrixType, typename PointVectorType>
-        void test_interpolation(SparseMatrixType & A, SparseMatrixType & P, PointVectorType & Pointvector)
-        {
-          for (unsigned int i=0; i<P.size1(); ++i)
+          for (long x = 0; x < coarse_rows; ++x)
+            slot_start[x+1] += slot_start[x];
+
+          // numeric pass:
+          std::vector<unsigned int> row_nnz(P.size2());
+          std::vector<unsigned int> slot_cols(slot_start[P.size2()]);
+          std::vector<ScalarType>   slot_vals(slot_start[P.size2()]);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel if (coarse_rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
           {
-            if (Pointvector.is_cpoint(i))
+            std::vector<ScalarType>   fine_row(A.size2());
+            std::vector<unsigned int> fine_marker(A.size2(), no_entry);
+            std::vector<unsigned int> fine_cols;
+            std::vector<ScalarType>   coarse_row(P.size2());
+            std::vector<unsigned int> coarse_marker(P.size2(), no_entry);
+            std::vector<unsigned int> coarse_cols;
+
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for
+#endif
+            for (long x = 0; x < coarse_rows; ++x)
             {
-              bool set = false;
-              for (unsigned int j=0; j<P.size2(); ++j)
+              // row x of trans(P)*A:
+              fine_cols.clear();
+              for (unsigned int k = R_rows[x]; k < R_rows[x+1]; ++k)
               {
-                if (P.isnonzero(i,j))
+                unsigned int y1 = R_cols[k];
+                for (unsigned int l = A_rows[y1]; l < A_rows[y1+1]; ++l)
                 {
-                  if (P(i,j) != 1)
-                    std::cout << "Error 1 in row " << i << std::endl;
-                  if (P(i,j) == 1 && set)
-                    std::cout << "Error 2 in row " << i << std::endl;
-                  if (P(i,j) == 1 && !set)
-                    set = true;
+                  unsigned int y2 = A_cols[l];
+                  if (fine_marker[y2] != static_cast<unsigned int>(x))
+                  {
+                    fine_marker[y2] = static_cast<unsigned int>(x);
+                    fine_row[y2] = 0;
+                    fine_cols.push_back(y2);
+                  }
+                  fine_row[y2] += R_vals[k] * A_vals[l];
                 }
               }
-            }
+              std::sort(fine_cols.begin(), fine_cols.end());
 
-            if (Pointvector.is_fpoint(i))
-              for (unsigned int j=0; j<P.size2(); ++j)
+              // row x of trans(P)*A*P:
+              coarse_cols.clear();
+              for (std::size_t i=0; i<fine_cols.size(); ++i)
               {
-                if (P.isnonzero(i,j) && j> Pointvector.get_cpoints()-1)
-                  std::cout << "Error 3 in row " << i << std::endl;
-                if (P.isnonzero(i,j))
+                unsigned int y2 = fine_cols[i];
+                if (fine_row[y2] == ScalarType(0))
+                  continue;
+
+                for (unsigned int m = P_rows[y2]; m < P_rows[y2+1]; ++m)
                 {
-                  bool set = false;
-                  for (unsigned int k=0; k<P.size1(); ++k)
+                  unsigned int z = P_cols[m];
+                  if (coarse_marker[z] != static_cast<unsigned int>(x))
                   {
-                    if (P.isnonzero(k,j))
-                    {
-                      if (Pointvector.is_cpoint(k) && P(k,j) == 1 && A.isnonzero(i,k))
-                        set = true;
-                    }
+                    coarse_marker[z] = static_cast<unsigned int>(x);
+                    coarse_row[z] = 0;
+                    coarse_cols.push_back(z);
                   }
-                  if (!set)
-                    std::cout << "Error 4 in row " << i << std::endl;
+                  coarse_row[z] += P_vals[m] * fine_row[y2];
                 }
               }
+              std::sort(coarse_cols.begin(), coarse_cols.end());
+
+              for (std::size_t i=0; i<coarse_cols.size(); ++i)
+              {
+                slot_cols[slot_start[x] + i] = coarse_cols[i];
+                slot_vals[slot_start[x] + i] = coarse_row[coarse_cols[i]];
+              }
+              row_nnz[x] = static_cast<unsigned int>(coarse_cols.size());
             }
+          }
+
+          RES.set_rows(P.size2(), P.size2(), slot_start, row_nnz, slot_cols, slot_vals);
+
+          #ifdef VIENNACL_AMG_DEBUG
+          std::cout << "Galerkin Operator: " << std::endl;
+          printmatrix (RES);
+          #endif
         }
 
+        /** @brief Copies an operator of the setup phase to a host matrix type providing resize(), clear() and operator() (e.g. ublas::compressed_matrix)
+          * @param src    Operator from the setup phase
+          * @param dst    Destination matrix
+          */
+        template <typename ScalarType, typename MatrixType>
+        void amg_copy(amg_sparsematrix<ScalarType> const & src, MatrixType & dst)
+        {
+          std::vector<unsigned int> const & row_buffer = src.row_buffer();
+          std::vector<unsigned int> const & col_buffer = src.col_buffer();
+          std::vector<ScalarType>   const & elements   = src.elements();
+
+          dst.resize(src.size1(), src.size2(), false);
+          dst.clear();
+          for (std::size_t i=0; i<src.size1(); ++i)
+            for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+              dst(i, col_buffer[k]) = elements[k];
+        }
+
+        /** @brief Copies an operator of the setup phase to a ViennaCL compressed_matrix. The CSR arrays are written to the memory of the matrix directly.
+          * @param src    Operator from the setup phase
+          * @param dst    Destination matrix
+          */
+        template <typename ScalarType, unsigned int ALIGNMENT>
+        void amg_copy(amg_sparsematrix<ScalarType> const & src, viennacl::compressed_matrix<ScalarType, ALIGNMENT> & dst)
+        {
+          if (src.nnz() > 0)
+          {
+            viennacl::backend::typesafe_host_array<unsigned int> row_buffer(dst.handle1(), src.size1() + 1);
+            viennacl::backend::typesafe_host_array<unsigned int> col_buffer(dst.handle2(), src.nnz());
+
+            for (std::size_t i=0; i<=src.size1(); ++i)
+              row_buffer.set(i, src.row_buffer()[i]);
+            for (std::size_t k=0; k<src.nnz(); ++k)
+              col_buffer.set(k, src.col_buffer()[k]);
+
+            dst.set(row_buffer.get(), col_buffer.get(), &(src.elements()[0]), src.size1(), src.size2(), src.nnz());
+          }
+          else
+          {
+            // zero operator: all rows are empty, but the arrays keep one (unused) entry as for viennacl::copy() of an empty matrix
+            viennacl::backend::typesafe_host_array<unsigned int> row_buffer(dst.handle1(), src.size1() + 1);
+            viennacl::backend::typesafe_host_array<unsigned int> col_buffer(dst.handle2(), 1);
+            ScalarType zero = 0;
+
+            for (std::size_t i=0; i<=src.size1(); ++i)
+              row_buffer.set(i, 0);
+            col_buffer.set(0, 0);
+
+            dst.set(row_buffer.get(), col_buffer.get(), &zero, src.size1(), src.size2(), 1);
+          }
+        }
 
       } //namespace amg
     }
@@ -25,7 +25,9 @@
 #include <cmath>
 #include "viennacl/linalg/amg.hpp"
 
-#include <map>
+#include <set>
+#include <vector>
+#include <limits>
 #ifdef VIENNACL_WITH_OPENMP
 #include <omp.h>
 #endif
@@ -59,179 +61,245 @@ namespace viennacl
         case VIENNACL_AMG_COARSE_RS3: amg_coarse_rs3 (level, A, Pointvector, Slicing, tag); break;
         case VIENNACL_AMG_COARSE_AG:   amg_coarse_ag (level, A, Pointvector, tag); break;
       }
+
+      Pointvector[level].update_cf();
     }
 
-    /** @brief Determines strong influences in system matrix, classical approach (RS). Multithreaded!
-    * @param level    Coarse level identifier
-    * @param A      Operator matrix on all levels
-    * @param Pointvector   Vector of points on all levels
-    * @param tag    AMG preconditioner tag
+    /** @brief Determines the strong connections (classical approach, RS) within each slice of the system matrix. Multithreaded!
+    *
+    * A point j strongly influences point i if -a_ij >= threshold * max_k(-a_ik), where only off-diagonal entries within the slice of i are taken into account.
+    * The signs are flipped if the diagonal entry is negative.
+    * @param A           Operator matrix on the current level
+    * @param offsets     First point of each slice, the last entry holds the number of points
+    * @param threshold   Strength of dependence threshold
+    * @param graph       The graph of strong influences (row i holds the points strongly influencing point i)
     */
-    template <typename InternalType1, typename InternalType2>
-    void amg_influence(unsigned int level, InternalType1 const & A, InternalType2 & Pointvector, amg_tag & tag)
+    template <typename ScalarType>
+    void amg_strong_connections(amg_sparsematrix<ScalarType> const & A, std::vector<unsigned int> const & offsets, double threshold, amg_influence_graph & graph)
     {
-      typedef typename InternalType1::value_type SparseMatrixType;
-      typedef typename InternalType2::value_type PointVectorType;
-      typedef typename SparseMatrixType::value_type ScalarType;
-      typedef typename SparseMatrixType::value_type ScalarType;
-      typedef typename SparseMatrixType::const_iterator1 ConstRowIterator;
-      typedef typename SparseMatrixType::const_iterator2 ConstColIterator;
+      std::vector<unsigned int> const & row_buffer = A.row_buffer();
+      std::vector<unsigned int> const & col_buffer = A.col_buffer();
+      std::vector<ScalarType>   const & elements   = A.elements();
+
+      std::vector<char> is_strong(A.nnz(), 0);
 
-      ScalarType max;
-      int diag_sign;
-      //unsigned int i;
+      for (std::size_t s=0; s+1<offsets.size(); ++s)
+      {
+        long slice_begin = static_cast<long>(offsets[s]);
+        long slice_end   = static_cast<long>(offsets[s+1]);
 
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for private (max,diag_sign) shared (A,Pointvector)
+        #pragma omp parallel for if (slice_end - slice_begin > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
 #endif
-      for (unsigned int i=0; i<A[level].size1(); ++i)
-      {
-        diag_sign = 1;
-        if (A[level](i,i) < 0)
-          diag_sign = -1;
-
-        ConstRowIterator row_iter = A[level].begin1();
-        row_iter += i;
-        // Find greatest non-diagonal negative value (positive if diagonal is negative) in row
-        max = 0;
-        for (ConstColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+        for (long i = slice_begin; i < slice_end; ++i)
         {
-            if (i == (unsigned int) col_iter.index2()) continue;
+          int diag_sign = 1;
+          if (A(static_cast<unsigned int>(i), static_cast<unsigned int>(i)) < 0)
+            diag_sign = -1;
+
+          // Find greatest non-diagonal negative value (positive if diagonal is negative) in row
+          ScalarType max = 0;
+          for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+          {
+            long j = static_cast<long>(col_buffer[k]);
+            if (j == i || j < slice_begin || j >= slice_end) continue;
             if (diag_sign == 1)
-              if (max > *col_iter)  max = *col_iter;
+              if (max > elements[k])  max = elements[k];
             if (diag_sign == -1)
-              if (max < *col_iter)  max = *col_iter;
-        }
+              if (max < elements[k])  max = elements[k];
+          }
 
-        // If maximum is 0 then the row is independent of the others
-        if (max == 0)
-          continue;
+          // If maximum is 0 then the row is independent of the others
+          if (max == 0)
+            continue;
 
-        // Find all points that strongly influence current point (Yang, p.5)
-        for (ConstColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-        {
-          unsigned int j = col_iter.index2();
-          if (i == j) continue;
-          if (diag_sign * (-*col_iter) >= tag.get_threshold() * (diag_sign * (-max)))
+          // Find all points that strongly influence current point (Yang, p.5)
+          for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
           {
-            // Strong influence from j to i found, save information
-            Pointvector[level][i]->add_influencing_point(Pointvector[level][j]);
+            long j = static_cast<long>(col_buffer[k]);
+            if (j == i || j < slice_begin || j >= slice_end) continue;
+            if (diag_sign * (-elements[k]) >= threshold * (diag_sign * (-max)))
+              is_strong[k] = 1;
           }
         }
       }
 
-      #ifdef VIENNACL_AMG_DEBUG
-      std::cout << "Influence Matrix: " << std::endl;
-      boost::numeric::ublas::matrix<bool> mat;
-      Pointvector[level].get_influence_matrix(mat);
-      printmatrix (mat);
-      #endif
-
-      // Save influenced points
-      for (typename PointVectorType::iterator iter = Pointvector[level].begin(); iter != Pointvector[level].end(); ++iter)
-      {
-        for (typename amg_point::iterator iter2 = (*iter)->begin_influencing(); iter2 != (*iter)->end_influencing(); ++iter2)
-        {
-          (*iter2)->add_influenced_point(*iter);
-        }
-      }
-
-      #ifdef VIENNACL_AMG_DEBUG
-      std::cout << "Influence Measures: " << std::endl;
-      boost::numeric::ublas::vector<unsigned int> temp;
-      Pointvector[level].get_influence(temp);
-      printvector (temp);
-      std::cout << "Point Sorting: " << std::endl;
-      Pointvector[level].get_sorting(temp);
-      printvector (temp);
-      #endif
+      graph.set(row_buffer, col_buffer, is_strong);
     }
 
-    /** @brief Classical (RS) one-pass coarsening. Single-Threaded! (VIENNACL_AMG_COARSE_CLASSIC_ONEPASS)
-    * @param level     Course level identifier
+    /** @brief Determines strong influences in system matrix, classical approach (RS). Multithreaded!
+    * @param level    Coarse level identifier
     * @param A      Operator matrix on all levels
     * @param Pointvector   Vector of points on all levels
     * @param tag    AMG preconditioner tag
     */
     template <typename InternalType1, typename InternalType2>
-    void amg_coarse_classic_onepass(unsigned int level, InternalType1 & A, InternalType2 & Pointvector, amg_tag & tag)
+    void amg_influence(unsigned int level, InternalType1 const & A, InternalType2 & Pointvector, amg_tag & tag)
     {
-      amg_point* c_point, *point1, *point2;
-      unsigned int i;
+      std::vector<unsigned int> offsets(2, 0);
+      offsets[1] = static_cast<unsigned int>(A[level].size1());
 
-      // Check and save all strong influences
-      amg_influence (level, A, Pointvector, tag);
+      amg_strong_connections(A[level], offsets, tag.get_threshold(), Pointvector[level].influencing());
 
-      // Traverse through points and calculate initial influence measure
-#ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for private (i) shared (Pointvector)
-#endif
-      for (i=0; i<Pointvector[level].size(); ++i)
-  Pointvector[level][i]->calc_influence();
+      // Save influenced points
+      Pointvector[level].influencing().trans(Pointvector[level].influenced());
+    }
+
+    /** @brief First pass of the classical (RS) coarsening for the points begin, ..., end-1. Single-Threaded!
+    *
+    * Repeatedly picks the undecided point with the highest influence measure (lowest index on ties) as C point and makes all undecided points it influences F points.
+    * Only the strong connections between the points in the range must be stored in the influence graphs of the point vector.
+    * @param points   Points on the current level
+    * @param begin    First point of the range
+    * @param end      End of the range
+    */
+    inline void amg_coarse_onepass_range(amg_pointvector & points, unsigned int begin, unsigned int end)
+    {
+      // Sorted by influence measure and then by the inverted point index, such that the last entry is the next C point:
+      typedef std::pair<unsigned int, unsigned int>   KeyType;
+      unsigned int const inverted = std::numeric_limits<unsigned int>::max();
+
+      amg_influence_graph const & influencing = points.influencing();
+      amg_influence_graph const & influenced  = points.influenced();
 
-       // Do initial sorting
-      Pointvector[level].sort();
+      // Initial influence measure is the number of influenced points
+      std::vector<unsigned int> influence(end - begin);
+      std::set<KeyType> pointlist;
+      for (unsigned int i = begin; i < end; ++i)
+      {
+        influence[i - begin] = influenced.row_size(i);
+        pointlist.insert(KeyType(influence[i - begin], inverted - i));
+      }
 
       // Get undecided point with highest influence measure
-      while ((c_point = Pointvector[level].get_nextpoint()) != NULL)
+      while (!pointlist.empty() && (--pointlist.end())->first > 0)
       {
+        unsigned int c_point = inverted - (--pointlist.end())->second;
+
         // Make this point C point
-        Pointvector[level].make_cpoint(c_point);
+        pointlist.erase(--pointlist.end());
+        points.make_cpoint(c_point);
 
         // All strongly influenced points become F points
-        for (typename amg_point::iterator iter = c_point->begin_influenced(); iter != c_point->end_influenced(); ++iter)
+        for (unsigned int k = influenced.row_buffer()[c_point]; k < influenced.row_buffer()[c_point+1]; ++k)
         {
-          point1 = *iter;
+          unsigned int point1 = influenced.col_buffer()[k];
           // Found strong influence from C point (c_point influences point1), check whether point is still undecided, otherwise skip
-          if (!point1->is_undecided()) continue;
+          if (!points.is_undecided(point1)) continue;
           // Make this point F point if it is still undecided point
-          Pointvector[level].make_fpoint(point1);
+          pointlist.erase(KeyType(influence[point1 - begin], inverted - point1));
+          points.make_fpoint(point1);
 
           // Add +1 to influence measure for all undecided points that strongly influence new F point
-          for (typename amg_point::iterator iter2 = point1->begin_influencing(); iter2 != point1->end_influencing(); ++iter2)
+          for (unsigned int l = influencing.row_buffer()[point1]; l < influencing.row_buffer()[point1+1]; ++l)
           {
-            point2 = *iter2;
-            // Found strong influence to F point (point2 influences point1)
-            if (point2->is_undecided())
-              Pointvector[level].add_influence(point2,1);
+            unsigned int point2 = influencing.col_buffer()[l];
+            if (points.is_undecided(point2))
+            {
+              pointlist.erase(KeyType(influence[point2 - begin], inverted - point2));
+              ++influence[point2 - begin];
+              pointlist.insert(KeyType(influence[point2 - begin], inverted - point2));
+            }
           }
         }
       }
+    }
+
+    /** @brief Second pass of the classical (RS) coarsening for the F points begin, ..., end-1. Single-Threaded!
+    *
+    * A strongly connected F point without a common C point is switched to a C point.
+    * Connections to the points skip_begin, ..., skip_end-1 are not checked.
+    * @param points       Points on the current level
+    * @param begin        First point of the range
+    * @param end          End of the range
+    * @param skip_begin   First point of the range of connections to skip
+    * @param skip_end     End of the range of connections to skip
+    */
+    inline void amg_coarse_common_cpoints(amg_pointvector & points, unsigned int begin, unsigned int end, unsigned int skip_begin, unsigned int skip_end)
+    {
+      std::vector<unsigned int> const & influencing_rows = points.influencing().row_buffer();
+      std::vector<unsigned int> const & influencing_cols = points.influencing().col_buffer();
+      std::vector<unsigned int> const & influenced_rows  = points.influenced().row_buffer();
+      std::vector<unsigned int> const & influenced_cols  = points.influenced().col_buffer();
 
-      // If a point is neither C nor F point but is nevertheless influenced by other points make it F point
-      // (this situation can happen when this point does not influence other points and the points that influence this point became F points already)
-      /*#pragma omp parallel for private (i,point1)
-      for (i=0; i<Pointvector[level].size(); ++i)
+      for (unsigned int point1 = begin; point1 < end; ++point1)
       {
-        point1 = Pointvector[level][i];
-        if (point1->is_undecided())
+        // If point is F point, check for strong connections.
+        if (!points.is_fpoint(point1))
+          continue;
+
+        // Check for strong connections from influencing and influenced points.
+        unsigned int iter2 = influencing_rows[point1];
+        unsigned int iter3 = influenced_rows[point1];
+
+        // Iterate over both lists at once. This makes sure that points are no checked twice when influence relation is symmetric (which is often the case).
+        // Note: Only works because influencing and influenced lists are sorted by point-index.
+        while (iter2 != influencing_rows[point1+1] || iter3 != influenced_rows[point1+1])
         {
-          // Undecided point found. Check whether it is influenced by other point and if so: Make it F point.
-          if (point1->number_influencing() > 0)
+          unsigned int point2;
+          if (iter2 == influencing_rows[point1+1])
+            point2 = influenced_cols[iter3++];
+          else if (iter3 == influenced_rows[point1+1])
+            point2 = influencing_cols[iter2++];
+          else if (influencing_cols[iter2] == influenced_cols[iter3])
+          {
+            point2 = influencing_cols[iter2++];
+            ++iter3;
+          }
+          else if (influencing_cols[iter2] < influenced_cols[iter3])
+            point2 = influencing_cols[iter2++];
+          else
+            point2 = influenced_cols[iter3++];
+
+          // Only check points with higher index as points with lower index have been checked already.
+          if (point2 < point1)
+            continue;
+
+          if (point2 >= skip_begin && point2 < skip_end)
+            continue;
+
+          // If there is a strong connection then it has to either be a C point or a F point with common C point.
+          // F point? Then check whether F points point1 and point2 have a common C point.
+          if (points.is_fpoint(point2))
           {
-            #pragma omp critical
-            Pointvector[level].make_fpoint(point1);
+            bool add_C = true;
+            // C point is common for two F points if they are both strongly influenced by that C point.
+            for (unsigned int k = influencing_rows[point1]; k < influencing_rows[point1+1]; ++k)
+            {
+              unsigned int c_point = influencing_cols[k];
+              if (points.is_cpoint(c_point) && points.influencing().contains(point2, c_point))
+              {
+                add_C = false;
+                break;
+              }
+            }
+            // No common C point found? Then make second F point to C point.
+            if (add_C)
+              points.make_cpoint(point2);
           }
         }
-      }*/
+      }
+    }
+
+    /** @brief Classical (RS) one-pass coarsening. Single-Threaded! (VIENNACL_AMG_COARSE_CLASSIC_ONEPASS)
+    * @param level     Course level identifier
+    * @param A      Operator matrix on all levels
+    * @param Pointvector   Vector of points on all levels
+    * @param tag    AMG preconditioner tag
+    */
+    template <typename InternalType1, typename InternalType2>
+    void amg_coarse_classic_onepass(unsigned int level, InternalType1 & A, InternalType2 & Pointvector, amg_tag & tag)
+    {
+      // Check and save all strong influences
+      amg_influence (level, A, Pointvector, tag);
+
+      amg_coarse_onepass_range(Pointvector[level], 0, static_cast<unsigned int>(Pointvector[level].size()));
 
       #if defined (VIENNACL_AMG_DEBUG)//  or defined (VIENNACL_AMG_DEBUGBENCH)
-      unsigned int c_points = Pointvector[level].get_cpoints();
-      unsigned int f_points = Pointvector[level].get_fpoints();
+      Pointvector[level].update_cf();
       std::cout << "1st pass: Level " << level << ": ";
-      std::cout << "No of C points = " << c_points << ", ";
-      std::cout << "No of F points = " << f_points << std::endl;
-      #endif
-
-      #ifdef VIENNACL_AMG_DEBUG
-      std::cout << "Coarse Points:" << std::endl;
-      boost::numeric::ublas::vector<bool> C;
-      Pointvector[level].get_C(C);
-      printvector (C);
-      std::cout << "Fine Points:" << std::endl;
-      boost::numeric::ublas::vector<bool> F;
-      Pointvector[level].get_F(F);
-      printvector (F);
+      std::cout << "No of C points = " << Pointvector[level].get_cpoints() << ", ";
+      std::cout << "No of F points = " << Pointvector[level].get_fpoints() << std::endl;
       #endif
     }
 
@@ -244,117 +312,12 @@ namespace viennacl
     template <typename InternalType1, typename InternalType2>
     void amg_coarse_classic(unsigned int level, InternalType1 & A, InternalType2 & Pointvector, amg_tag & tag)
     {
-      typedef typename InternalType2::value_type PointVectorType;
-
-      bool add_C;
-      amg_point *c_point, *point1, *point2;
-
       // Use one-pass-coarsening as first pass.
       amg_coarse_classic_onepass(level, A, Pointvector, tag);
 
       // 2nd pass: Add more C points if F-F connection does not have a common C point.
-      for (typename PointVectorType::iterator iter = Pointvector[level].begin(); iter != Pointvector[level].end(); ++iter)
-      {
-        point1 = *iter;
-        // If point is F point, check for strong connections.
-        if (point1->is_fpoint())
-        {
-          // Check for strong connections from influencing and influenced points.
-          amg_point::iterator iter2 = point1->begin_influencing();
-          amg_point::iterator iter3 = point1->begin_influenced();
-
-          // Iterate over both lists at once. This makes sure that points are no checked twice when influence relation is symmetric (which is often the case).
-          // Note: Only works because influencing and influenced lists are sorted by point-index.
-          while(iter2 != point1->end_influencing() || iter3 != point1->end_influenced())
-          {
-            if (iter2 == point1->end_influencing())
-            {
-              point2 = *iter3;
-              ++iter3;
-            }
-            else if (iter3 == point1->end_influenced())
-            {
-              point2 = *iter2;
-              ++iter2;
-            }
-            else
-            {
-              if ((*iter2)->get_index() == (*iter3)->get_index())
-              {
-                point2 = *iter2;
-                ++iter2;
-                ++iter3;
-              }
-              else if ((*iter2)->get_index() < (*iter3)->get_index())
-              {
-                point2 = *iter2;
-                ++iter2;
-              }
-              else
-              {
-                point2 = *iter3;
-                ++iter3;
-              }
-            }
-            // Only check points with higher index as points with lower index have been checked already.
-            if (point2->get_index() < point1->get_index())
-              continue;
-
-            // If there is a strong connection then it has to either be a C point or a F point with common C point.
-            // C point? Then skip as everything is ok.
-            if (point2->is_cpoint())
-              continue;
-            // F point? Then check whether F points point1 and point2 have a common C point.
-            if (point2->is_fpoint())
-            {
-              add_C = true;
-              // C point is common for two F points if they are both strongly influenced by that C point.
-              // Compare strong influences for point1 and point2.
-              for (amg_point::iterator iter3 = point1->begin_influencing(); iter3 != point1 -> end_influencing(); ++iter3)
-              {
-                c_point = *iter3;
-                // Stop search when strong common influence is found via c_point.
-                if (c_point->is_cpoint())
-                {
-                  if (point2->is_influencing(c_point))
-                  {
-                    add_C = false;
-                    break;
-                  }
-                }
-              }
-              // No common C point found? Then make second F point to C point.
-              if (add_C == true)
-                Pointvector[level].switch_ftoc(point2);
-            }
-          }
-        }
-      }
-
-      #ifdef VIENNACL_AMG_DEBUG
-      std::cout << "After 2nd pass:" << std::endl;
-      std::cout << "Coarse Points:" << std::endl;
-      boost::numeric::ublas::vector<bool> C;
-      Pointvector[level].get_C(C);
-      printvector (C);
-      std::cout << "Fine Points:" << std::endl;
-      boost::numeric::ublas::vector<bool> F;
-      Pointvector[level].get_F(F);
-      printvector (F);
-      #endif
-
-      #ifdef VIENNACL_AMG_DEBUG
-#ifdef VIENNACL_WITH_OPENMP
-      #pragma omp critical
-#endif
-      {
-      std::cout << "No C and no F point: ";
-      for (typename PointVectorType::iterator iter = Pointvector[level].begin(); iter != Pointvector[level].end(); ++iter)
-  if ((*iter)->is_undecided())
-    std::cout << (*iter)->get_index() << " ";
-      std::cout << std::endl;
-      }
-      #endif
+      unsigned int size = static_cast<unsigned int>(Pointvector[level].size());
+      amg_coarse_common_cpoints(Pointvector[level], 0, size, size, size);
     }
 
     /** @brief Parallel classical RS0 coarsening. Multi-Threaded! (VIENNACL_AMG_COARSE_RS0 || VIENNACL_AMG_COARSE_RS3)
@@ -367,66 +330,54 @@ namespace viennacl
     template <typename InternalType1, typename InternalType2, typename InternalType3>
     void amg_coarse_rs0(unsigned int level, InternalType1 & A, InternalType2 & Pointvector, InternalType3 & Slicing, amg_tag & tag)
     {
-      unsigned int total_points;
+      amg_pointvector & points = Pointvector[level];
+
+      // On the finest level, build a new slicing first. Coarser levels use the C points of the respective slice on the finer level.
+      if (level == 0)
+        Slicing.slice_new(level, A[level].size1());
+      std::vector<unsigned int> const & Offset = Slicing.Offset[level];
 
-      // Slice matrix into parts such that points are distributed among threads
-      Slicing.slice(level, A, Pointvector);
+      // Strong influences within each slice
+      amg_strong_connections(A[level], Offset, tag.get_threshold(), points.influencing());
+      points.influencing().trans(points.influenced());
 
       // Run classical coarsening in parallel
-      total_points = 0;
+      long threads = static_cast<long>(Slicing.threads_);
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for shared (total_points,Slicing,level)
+      #pragma omp parallel for
 #endif
-      for (unsigned int i=0; i<Slicing.threads_; ++i)
+      for (long i=0; i<threads; ++i)
       {
-        amg_coarse_classic(level,Slicing.A_slice[i],Slicing.Pointvector_slice[i],tag);
-
-        // Save C points (using Slicing.Offset on the next level as temporary memory)
-        // Note: Number of C points for point i is saved in i+1!! (makes it easier later to compute offset)
-        Slicing.Offset[i+1][level+1] = Slicing.Pointvector_slice[i][level].get_cpoints();
-      #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp critical
-      #endif
-        total_points += Slicing.Pointvector_slice[i][level].get_cpoints();
+        amg_coarse_onepass_range(points, Offset[i], Offset[i+1]);
+        amg_coarse_common_cpoints(points, Offset[i], Offset[i+1], Offset[i+1], Offset[i+1]);
       }
 
+      Slicing.slice_next(level, points);
+
       // If no coarser level can be found on any level then resume and coarsening will stop in amg_coarse()
-      if (total_points != 0)
+      if (Slicing.Offset[level+1][Slicing.threads_] != 0)
       {
-      #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for shared (Slicing)
-      #endif
         for (unsigned int i=0; i<Slicing.threads_; ++i)
         {
-          // If no higher coarse level can be found on slice i (saved in Slicing.Offset[i+1][level+1]) then pull C point(s) to the next level
-          if (Slicing.Offset[i+1][level+1] == 0)
-          {
-            // All points become C points
-            for (unsigned int j=0; j<Slicing.A_slice[i][level].size1(); ++j)
-              Slicing.Pointvector_slice[i][level].make_cpoint(Slicing.Pointvector_slice[i][level][j]);
-            Slicing.Offset[i+1][level+1] = Slicing.A_slice[i][level].size1();
-          }
+          // If no higher coarse level can be found on slice i then pull all its points to the next level
+          if (Slicing.Offset[level+1][i+1] == Slicing.Offset[level+1][i])
+            for (unsigned int j=Offset[i]; j<Offset[i+1]; ++j)
+              points.make_cpoint(j);
         }
-
-        // Build slicing offset from number of C points (offset = total sum of C points on threads with lower number)
-        for (unsigned int i=2; i<=Slicing.threads_; ++i)
-          Slicing.Offset[i][level+1] += Slicing.Offset[i-1][level+1];
-
-        // Join C and F points
-        Slicing.join(level, Pointvector);
+        Slicing.slice_next(level, points);
       }
 
-      // Calculate global influence measures for interpolation and/or RS3.
+      // Calculate global influence measures for interpolation and/or RS3. Strong influences found within the slices are kept.
+      amg_influence_graph slice_influencing = points.influencing();
       amg_influence(level, A, Pointvector, tag);
+      points.influencing().merge(slice_influencing);
+      points.influencing().trans(points.influenced());
 
       #if defined(VIENNACL_AMG_DEBUG)// or defined (VIENNACL_AMG_DEBUGBENCH)
-      for (unsigned int i=0; i<Slicing._threads; ++i)
+      for (unsigned int i=0; i<Slicing.threads_; ++i)
       {
-        unsigned int c_points = Slicing.Pointvector_slice[i][level].get_cpoints();
-        unsigned int f_points = Slicing.Pointvector_slice[i][level].get_fpoints();
         std::cout << "Thread " << i << ": ";
-        std::cout << "No of C points = " << c_points << ", ";
-        std::cout << "No of F points = " << f_points << std::endl;
+        std::cout << "No of C points = " << Slicing.Offset[level+1][i+1] - Slicing.Offset[level+1][i] << std::endl;
       }
       #endif
     }
@@ -441,229 +392,89 @@ namespace viennacl
     template <typename InternalType1, typename InternalType2, typename InternalType3>
     void amg_coarse_rs3(unsigned int level, InternalType1 & A, InternalType2 & Pointvector, InternalType3 & Slicing, amg_tag & tag)
     {
-      amg_point *c_point, *point1, *point2;
-      bool add_C;
-      unsigned int i, j;
-
       // Run RS0 first (parallel).
       amg_coarse_rs0(level, A, Pointvector, Slicing, tag);
 
-      // Save slicing offset
-      boost::numeric::ublas::vector<unsigned int> Offset = boost::numeric::ublas::vector<unsigned int> (Slicing.Offset.size());
-      for (i=0; i<Slicing.Offset.size(); ++i)
-        Offset[i] = Slicing.Offset[i][level];
+      // Correct the coarsening with a third pass: Don't allow strong F-F connections without common C point.
+      // Only connections leaving the slice are checked, interior F-F connections have already been checked in the second pass.
+      std::vector<unsigned int> const & Offset = Slicing.Offset[level];
+      for (unsigned int i=0; i<Slicing.threads_; ++i)
+        amg_coarse_common_cpoints(Pointvector[level], Offset[i], Offset[i+1], Offset[i], Offset[i+1]);
 
-      // Correct the coarsening with a third pass: Don't allow strong F-F connections without common C point
-      for (i=0; i<Slicing.threads_; ++i)
-      {
-      //for (j=Slicing.Offset[i][level]; j<Slicing.Offset[i+1][level]; ++j)
-      for (j=Offset[i]; j<Offset[i+1]; ++j)
-      {
-        point1 = Pointvector[level][j];
-        // If point is F point, check for strong connections.
-        if (point1->is_fpoint())
-        {
-          // Check for strong connections from influencing and influenced points.
-          amg_point::iterator iter2 = point1->begin_influencing();
-          amg_point::iterator iter3 = point1->begin_influenced();
+      // Update the slicing of the next level with the C points that have been added
+      Slicing.slice_next(level, Pointvector[level]);
+    }
 
-          // Iterate over both lists at once. This makes sure that points are no checked twice when influence relation is symmetric (which is often the case).
-          // Note: Only works because influencing and influenced lists are sorted by point-index.
-          while(iter2 != point1->end_influencing() || iter3 != point1->end_influenced())
-          {
-            if (iter2 == point1->end_influencing())
-            {
-              point2 = *iter3;
-              ++iter3;
-            }
-            else if (iter3 == point1->end_influenced())
-            {
-              point2 = *iter2;
-              ++iter2;
-            }
-            else
-            {
-              if ((*iter2)->get_index() == (*iter3)->get_index())
-              {
-                point2 = *iter2;
-                ++iter2;
-                ++iter3;
-              }
-              else if ((*iter2)->get_index() < (*iter3)->get_index())
-              {
-                point2 = *iter2;
-                ++iter2;
-              }
-              else
-              {
-                point2 = *iter3;
-                ++iter3;
-              }
-            }
+    /** @brief AG (aggregation based) coarsening. Single-Threaded! (VIENNACL_AMG_COARSE_SA)
+    *
+    * @param level    Coarse level identifier
+    * @param A      Operator matrix on all levels
+    * @param Pointvector   Vector of points on all levels
+    * @param tag    AMG preconditioner tag
+    */
+    template <typename InternalType1, typename InternalType2>
+    void amg_coarse_ag(unsigned int level, InternalType1 & A, InternalType2 & Pointvector, amg_tag & tag)
+    {
+      typedef typename InternalType1::value_type SparseMatrixType;
+      typedef typename SparseMatrixType::value_type ScalarType;
 
-            // Only check points with higher index as points with lower index have been checked already.
-            if (point2->get_index() < point1->get_index())
-              continue;
-
-            // Only check points that are outside the slicing boundaries (interior F-F connections have already been checked in second pass)
-            //if (point2->get_index() >= Slicing.Offset[i][level] || point2->get_index() < Slicing.Offset[i+1][level])
-            if (point2->get_index() >= Offset[i] && point2->get_index() < Offset[i+1])
-              continue;
-
-            // If there is a strong connection then it has to either be a C point or a F point with common C point.
-            // C point? Then skip as everything is ok.
-            if (point2->is_cpoint())
-              continue;
-            // F point? Then check whether F points point1 and point2 have a common C point.
-            if (point2->is_fpoint())
-            {
-              add_C = true;
-              // C point is common for two F points if they are both strongly influenced by that C point.
-              // Compare strong influences for point1 and point2.
-              for (amg_point::iterator iter3 = point1->begin_influencing(); iter3 != point1 -> end_influencing(); ++iter3)
-              {
-                c_point = *iter3;
-                // Stop search when strong common influence is found via c_point.
-                if (c_point->is_cpoint())
-                {
-                  if (point2->is_influencing(c_point))
-                  {
-                    add_C = false;
-                    break;
-                  }
-                }
-              }
-              // No common C point found? Then make second F point to C point.
-              if (add_C == true)
-              {
-                Pointvector[level].switch_ftoc(point2);
-                // Add +1 to offsets as one C point has been added.
-                for (unsigned int j=i+1; j<=Slicing.threads_; ++j)
-                  Slicing.Offset[j][level+1]++;
-              }
-                  }
-                }
-              }
-            }
-          }
+      // Cannot determine aggregates if size == 1 as then a new aggregate would always consist of this point (infinite loop)
+      if (A[level].size1() == 1) return;
 
-          #ifdef VIENNACL_AMG_DEBUG
-          std::cout << "After 3rd pass:" << std::endl;
-          std::cout << "Coarse Points:" << std::endl;
-          boost::numeric::ublas::vector<bool> C;
-          Pointvector[level].get_C(C);
-          printvector (C);
-          std::cout << "Fine Points:" << std::endl;
-          boost::numeric::ublas::vector<bool> F;
-          Pointvector[level].get_F(F);
-          printvector (F);
-          #endif
-
-          #ifdef VIENNACL_AMG_DEBUG
-          unsigned int i;
-    #ifdef VIENNACL_WITH_OPENMP
-          #pragma omp critical
-    #endif
-          {
-            std::cout << "No C and no F point: ";
-            for (typename PointVectorType::iterator iter = Pointvector[level].begin(); iter != Pointvector[level].end(); ++iter)
-              if ((*iter)->is_undecided())
-                std::cout << i << " ";
-            std::cout << std::endl;
-          }
-          #endif
-        }
+      amg_pointvector & points = Pointvector[level];
+      std::vector<unsigned int> const & row_buffer = A[level].row_buffer();
+      std::vector<unsigned int> const & col_buffer = A[level].col_buffer();
+      std::vector<ScalarType>   const & elements   = A[level].elements();
+      long size = static_cast<long>(A[level].size1());
 
-        /** @brief AG (aggregation based) coarsening. Single-Threaded! (VIENNACL_AMG_COARSE_SA)
-        *
-        * @param level    Coarse level identifier
-        * @param A      Operator matrix on all levels
-        * @param Pointvector   Vector of points on all levels
-        * @param tag    AMG preconditioner tag
-        */
-        template <typename InternalType1, typename InternalType2>
-        void amg_coarse_ag(unsigned int level, InternalType1 & A, InternalType2 & Pointvector, amg_tag & tag)
-        {
-          typedef typename InternalType1::value_type SparseMatrixType;
-          typedef typename InternalType2::value_type PointVectorType;
-          typedef typename SparseMatrixType::value_type ScalarType;
-
-          typedef typename SparseMatrixType::iterator1 InternalRowIterator;
-          typedef typename SparseMatrixType::iterator2 InternalColIterator;
-
-          unsigned int x,y;
-          ScalarType diag;
-          amg_point *pointx, *pointy;
-
-          // Cannot determine aggregates if size == 1 as then a new aggregate would always consist of this point (infinite loop)
-          if (A[level].size1() == 1) return;
-
-          // SA algorithm (Vanek et al. p.6)
-          // Build neighborhoods
-    #ifdef VIENNACL_WITH_OPENMP
-          #pragma omp parallel for private (x,y,diag) shared (A)
-    #endif
-          for (x=0; x<A[level].size1(); ++x)
-          {
-            InternalRowIterator row_iter = A[level].begin1();
-            row_iter += x;
-            diag = A[level](x,x);
-            for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-            {
-              y = col_iter.index2();
-              if (y == x || (std::fabs(*col_iter) >= tag.get_threshold()*pow(0.5, static_cast<double>(level-1)) * std::sqrt(std::fabs(diag*A[level](y,y)))))
-              {
-                // Neighborhood x includes point y
-                Pointvector[level][x]->add_influencing_point(Pointvector[level][y]);
-              }
-            }
-          }
+      std::vector<ScalarType> diag(A[level].size1());
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+      for (long x=0; x<size; ++x)
+        diag[x] = A[level](static_cast<unsigned int>(x), static_cast<unsigned int>(x));
 
-          #ifdef VIENNACL_AMG_DEBUG
-          std::cout << "Neighborhoods:" << std::endl;
-          boost::numeric::ublas::matrix<bool> mat;
-          Pointvector[level].get_influence_matrix(mat);
-          printmatrix (mat);
-          #endif
+      // SA algorithm (Vanek et al. p.6)
+      // Build neighborhoods
+      double threshold = tag.get_threshold()*std::pow(0.5, static_cast<double>(level-1));
+      std::vector<char> in_neighborhood(A[level].nnz(), 0);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+      for (long x=0; x<size; ++x)
+      {
+        for (unsigned int k = row_buffer[x]; k < row_buffer[x+1]; ++k)
+        {
+          unsigned int y = col_buffer[k];
+          if (y == static_cast<unsigned int>(x) || (std::fabs(elements[k]) >= threshold * std::sqrt(std::fabs(diag[x]*diag[y]))))
+            in_neighborhood[k] = 1;  // Neighborhood x includes point y
+        }
+      }
+      points.influencing().set(row_buffer, col_buffer, in_neighborhood);
 
-          // Build aggregates from neighborhoods
-          for (typename PointVectorType::iterator iter = Pointvector[level].begin(); iter != Pointvector[level].end(); ++iter)
+      // Build aggregates from neighborhoods
+      std::vector<unsigned int> const & neighbor_rows = points.influencing().row_buffer();
+      std::vector<unsigned int> const & neighbor_cols = points.influencing().col_buffer();
+      for (unsigned int x=0; x<points.size(); ++x)
+      {
+        if (points.is_undecided(x))
+        {
+          // Make center of aggregate to C point and include it to aggregate x.
+          points.make_cpoint(x);
+          points.set_aggregate(x, x);
+          for (unsigned int k = neighbor_rows[x]; k < neighbor_rows[x+1]; ++k)
           {
-            pointx = (*iter);
-
-            if (pointx->is_undecided())
+            unsigned int y = neighbor_cols[k];
+            if (points.is_undecided(y))
             {
-              // Make center of aggregate to C point and include it to aggregate x.
-              Pointvector[level].make_cpoint(pointx);
-              pointx->set_aggregate (pointx->get_index());
-              for (amg_point::iterator iter2 = pointx->begin_influencing(); iter2 != pointx->end_influencing(); ++iter2)
-              {
-              pointy = (*iter2);
-
-                if (pointy->is_undecided())
-                {
-                  // Make neighbor y to F point and include it to aggregate x.
-                  Pointvector[level].make_fpoint(pointy);
-                  pointy->set_aggregate (pointx->get_index());
-                }
-              }
+              // Make neighbor y to F point and include it to aggregate x.
+              points.make_fpoint(y);
+              points.set_aggregate(y, x);
             }
           }
-
-          #ifdef VIENNACL_AMG_DEBUG
-          std::cout << "After aggregation:" << std::endl;
-          std::cout << "Coarse Points:" << std::endl;
-          boost::numeric::ublas::vector<bool> C;
-          Pointvector[level].get_C(C);
-          printvector (C);
-          std::cout << "Fine Points:" << std::endl;
-          boost::numeric::ublas::vector<bool> F;
-          Pointvector[level].get_F(F);
-          printvector (F);
-          std::cout << "Aggregates:" << std::endl;
-          printvector (Aggregates[level]);
-          #endif
         }
+      }
+    }
       } //namespace amg
     }
   }
@@ -0,0 +1,512 @@
+#ifndef VIENNACL_LINALG_DETAIL_AMG_AMG_CYCLE_HPP
+#define VIENNACL_LINALG_DETAIL_AMG_AMG_CYCLE_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file amg_cycle.hpp
+    @brief Smoothers, grid transfers and the multigrid cycle of the AMG preconditioner on the host (precondition phase).
+*/
+
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+#include <cmath>
+#include <vector>
+#include <limits>
+
+#include "viennacl/tools/timer.hpp"
+#include "viennacl/linalg/detail/amg/amg_base.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace detail
+    {
+      namespace amg
+      {
+
+        /** @brief Smoother for one level of the AMG hierarchy on the host.
+        *
+        *  Holds the (l1-)diagonal of the operator, the coloring of the rows for multicolor Gauss-Seidel, and the eigenvalue bounds for Chebyshev smoothing.
+        *  The operator itself is passed to apply(), so that the smoother does not keep references into the setup data.
+        */
+        template <typename ScalarType>
+        class amg_smoother
+        {
+          public:
+            amg_smoother() : type_(VIENNACL_AMG_SMOOTHER_JACOBI), weight_(1), lambda_min_(0), lambda_max_(0) {}
+
+            /** @brief Computes the auxiliary data of the smoother selected in the tag for the operator A. */
+            void init(amg_sparsematrix<ScalarType> const & A, amg_tag const & tag)
+            {
+              std::vector<unsigned int> const & row_buffer = A.row_buffer();
+              std::vector<unsigned int> const & col_buffer = A.col_buffer();
+              std::vector<ScalarType>   const & elements   = A.elements();
+              long size = static_cast<long>(A.size1());
+
+              type_   = tag.get_smoother();
+              weight_ = static_cast<ScalarType>(tag.get_jacobiweight());
+
+              // Rows without (nonzero) diagonal entry are treated as if the diagonal entry was one.
+              inv_diag_.resize(A.size1());
+              std::vector<ScalarType> row_l1(A.size1());
+#ifdef VIENNACL_WITH_OPENMP
+              #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+              for (long row = 0; row < size; ++row)
+              {
+                ScalarType diag = 0, l1 = 0;
+                for (unsigned int k = row_buffer[row]; k < row_buffer[row+1]; ++k)
+                {
+                  if (col_buffer[k] == static_cast<unsigned int>(row))
+                    diag = elements[k];
+                  l1 += std::fabs(elements[k]);
+                }
+                if (type_ == VIENNACL_AMG_SMOOTHER_L1_JACOBI)
+                  inv_diag_[row] = (l1 > 0) ? ScalarType(1) / l1 : ScalarType(1);
+                else
+                  inv_diag_[row] = (diag != 0) ? ScalarType(1) / diag : ScalarType(1);
+                row_l1[row] = l1;
+              }
+
+              if (type_ == VIENNACL_AMG_SMOOTHER_CHEBYSHEV)
+              {
+                // Gershgorin bound for the largest eigenvalue of D^{-1} A. The smoother only targets the upper part [0.3 lambda_max, lambda_max] of the spectrum.
+                lambda_max_ = 0;
+                for (std::size_t row = 0; row < A.size1(); ++row)
+                  lambda_max_ = std::max(lambda_max_, std::fabs(inv_diag_[row]) * row_l1[row]);
+                if (lambda_max_ <= 0)
+                  lambda_max_ = 1;
+                lambda_min_ = ScalarType(0.3) * lambda_max_;
+              }
+
+              if (type_ == VIENNACL_AMG_SMOOTHER_GAUSS_SEIDEL)
+                init_colors(A);
+            }
+
+            /** @brief Applies the given number of smoothing steps to x.
+            *
+            * @param A           Operator of this level
+            * @param x           Current iterate, overwritten with the smoothed iterate
+            * @param rhs         Right hand side
+            * @param work        Work array with at least A.size1() entries
+            * @param iterations  Number of smoothing steps (polynomial degree for Chebyshev)
+            * @param zero_guess  If true, x is assumed to be zero on entry (its content is ignored)
+            * @param reverse     Processes the colors in reverse order (multicolor Gauss-Seidel only), which keeps the cycle symmetric if used for postsmoothing
+            */
+            void apply(amg_sparsematrix<ScalarType> const & A, ScalarType * x, ScalarType const * rhs, ScalarType * work,
+                       unsigned int iterations, bool zero_guess, bool reverse) const
+            {
+              if (iterations == 0)
+              {
+                if (zero_guess)
+                  std::fill(x, x + A.size1(), ScalarType(0));
+                return;
+              }
+
+              switch (type_)
+              {
+                case VIENNACL_AMG_SMOOTHER_GAUSS_SEIDEL: gauss_seidel(A, x, rhs, iterations, zero_guess, reverse); break;
+                case VIENNACL_AMG_SMOOTHER_CHEBYSHEV: chebyshev(A, x, rhs, work, iterations, zero_guess); break;
+                default: jacobi(A, x, rhs, work, iterations, zero_guess);
+              }
+            }
+
+          private:
+            /** @brief Damped (l1-)Jacobi: x <- x + w D^{-1} (rhs - A x). For a zero initial guess, the first step reduces to x = w D^{-1} rhs. */
+            void jacobi(amg_sparsematrix<ScalarType> const & A, ScalarType * x, ScalarType const * rhs, ScalarType * old_x,
+                        unsigned int iterations, bool zero_guess) const
+            {
+              std::vector<unsigned int> const & row_buffer = A.row_buffer();
+              std::vector<unsigned int> const & col_buffer = A.col_buffer();
+              std::vector<ScalarType>   const & elements   = A.elements();
+              long size = static_cast<long>(A.size1());
+
+              for (unsigned int i = 0; i < iterations; ++i)
+              {
+                if (i == 0 && zero_guess)
+                {
+#ifdef VIENNACL_WITH_OPENMP
+                  #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+                  for (long row = 0; row < size; ++row)
+                    x[row] = weight_ * inv_diag_[row] * rhs[row];
+                  continue;
+                }
+
+#ifdef VIENNACL_WITH_OPENMP
+                #pragma omp parallel if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+                {
+#ifdef VIENNACL_WITH_OPENMP
+                  #pragma omp for
+#endif
+                  for (long row = 0; row < size; ++row)
+                    old_x[row] = x[row];
+
+#ifdef VIENNACL_WITH_OPENMP
+                  #pragma omp for
+#endif
+                  for (long row = 0; row < size; ++row)
+                  {
+                    ScalarType sum = rhs[row];
+                    for (unsigned int k = row_buffer[row]; k < row_buffer[row+1]; ++k)
+                      sum -= elements[k] * old_x[col_buffer[k]];
+                    x[row] = old_x[row] + weight_ * inv_diag_[row] * sum;
+                  }
+                }
+              }
+            }
+
+            /** @brief Multicolor Gauss-Seidel: rows of the same color do not couple, hence each color is updated in parallel. */
+            void gauss_seidel(amg_sparsematrix<ScalarType> const & A, ScalarType * x, ScalarType const * rhs,
+                              unsigned int iterations, bool zero_guess, bool reverse) const
+            {
+              std::vector<unsigned int> const & row_buffer = A.row_buffer();
+              std::vector<unsigned int> const & col_buffer = A.col_buffer();
+              std::vector<ScalarType>   const & elements   = A.elements();
+              long num_colors = static_cast<long>(color_offsets_.size()) - 1;
+
+              if (zero_guess)
+                std::fill(x, x + A.size1(), ScalarType(0));
+
+              for (unsigned int i = 0; i < iterations; ++i)
+              {
+                for (long c = 0; c < num_colors; ++c)
+                {
+                  long color = reverse ? num_colors - c - 1 : c;
+                  long color_begin = static_cast<long>(color_offsets_[color]);
+                  long color_end   = static_cast<long>(color_offsets_[color + 1]);
+#ifdef VIENNACL_WITH_OPENMP
+                  #pragma omp parallel for if (color_end - color_begin > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+                  for (long index = color_begin; index < color_end; ++index)
+                  {
+                    unsigned int row = color_rows_[index];
+                    ScalarType sum = rhs[row];
+                    for (unsigned int k = row_buffer[row]; k < row_buffer[row+1]; ++k)
+                    {
+                      if (col_buffer[k] != row)
+                        sum -= elements[k] * x[col_buffer[k]];
+                    }
+                    x[row] = inv_diag_[row] * sum;
+                  }
+                }
+              }
+            }
+
+            /** @brief Chebyshev polynomial of the given degree in D^{-1} A for the interval [lambda_min, lambda_max]. direction holds the current update. */
+            void chebyshev(amg_sparsematrix<ScalarType> const & A, ScalarType * x, ScalarType const * rhs, ScalarType * direction,
+                           unsigned int degree, bool zero_guess) const
+            {
+              std::vector<unsigned int> const & row_buffer = A.row_buffer();
+              std::vector<unsigned int> const & col_buffer = A.col_buffer();
+              std::vector<ScalarType>   const & elements   = A.elements();
+              long size = static_cast<long>(A.size1());
+
+              ScalarType theta = (lambda_max_ + lambda_min_) / ScalarType(2);
+              ScalarType delta = (lambda_max_ - lambda_min_) / ScalarType(2);
+              ScalarType sigma = theta / delta;
+              ScalarType rho   = ScalarType(1) / sigma;
+
+              for (unsigned int i = 0; i < degree; ++i)
+              {
+                ScalarType rho_new = ScalarType(1) / (ScalarType(2) * sigma - rho);
+                ScalarType factor_dir = (i == 0) ? ScalarType(0) : rho_new * rho;
+                ScalarType factor_res = (i == 0) ? ScalarType(1) / theta : ScalarType(2) * rho_new / delta;
+                bool skip_matrix = (i == 0 && zero_guess);
+
+#ifdef VIENNACL_WITH_OPENMP
+                #pragma omp parallel if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+                {
+#ifdef VIENNACL_WITH_OPENMP
+                  #pragma omp for
+#endif
+                  for (long row = 0; row < size; ++row)
+                  {
+                    ScalarType sum = rhs[row];
+                    if (!skip_matrix)
+                      for (unsigned int k = row_buffer[row]; k < row_buffer[row+1]; ++k)
+                        sum -= elements[k] * x[col_buffer[k]];
+                    direction[row] = (i == 0) ? factor_res * inv_diag_[row] * sum
+                                              : factor_dir * direction[row] + factor_res * inv_diag_[row] * sum;
+                  }
+
+#ifdef VIENNACL_WITH_OPENMP
+                  #pragma omp for
+#endif
+                  for (long row = 0; row < size; ++row)
+                    x[row] = skip_matrix ? direction[row] : x[row] + direction[row];
+                }
+
+                if (i > 0)
+                  rho = rho_new;
+              }
+            }
+
+            /** @brief Greedy coloring of the rows such that no two rows of the same color are coupled in A or in its transpose. */
+            void init_colors(amg_sparsematrix<ScalarType> const & A)
+            {
+              amg_sparsematrix<ScalarType> A_trans;
+              A.trans(A_trans);
+
+              std::size_t size = A.size1();
+              unsigned int const no_color = std::numeric_limits<unsigned int>::max();
+              std::vector<unsigned int> colors(size, no_color);
+              std::vector<unsigned int> color_marker;   // color_marker[c] == row if color c is taken by a neighbor of row
+              unsigned int num_colors = 0;
+
+              for (std::size_t row = 0; row < size; ++row)
+              {
+                for (unsigned int k = A.row_buffer()[row]; k < A.row_buffer()[row+1]; ++k)
+                  if (colors[A.col_buffer()[k]] != no_color)
+                    color_marker[colors[A.col_buffer()[k]]] = static_cast<unsigned int>(row);
+                for (unsigned int k = A_trans.row_buffer()[row]; k < A_trans.row_buffer()[row+1]; ++k)
+                  if (colors[A_trans.col_buffer()[k]] != no_color)
+                    color_marker[colors[A_trans.col_buffer()[k]]] = static_cast<unsigned int>(row);
+
+                unsigned int color = 0;
+                while (color < num_colors && color_marker[color] == row)
+                  ++color;
+                if (color == num_colors)
+                {
+                  color_marker.push_back(no_color);
+                  ++num_colors;
+                }
+                colors[row] = color;
+              }
+
+              // sort rows by color (counting sort, rows of one color remain in ascending order):
+              color_offsets_.assign(num_colors + 1, 0);
+              for (std::size_t row = 0; row < size; ++row)
+                ++color_offsets_[colors[row] + 1];
+              for (unsigned int c = 0; c < num_colors; ++c)
+                color_offsets_[c + 1] += color_offsets_[c];
+
+              color_rows_.resize(size);
+              std::vector<unsigned int> position(color_offsets_.begin(), color_offsets_.end() - 1);
+              for (std::size_t row = 0; row < size; ++row)
+                color_rows_[position[colors[row]]++] = static_cast<unsigned int>(row);
+            }
+
+            unsigned int type_;
+            ScalarType weight_;
+            ScalarType lambda_min_, lambda_max_;
+            std::vector<ScalarType> inv_diag_;
+            std::vector<unsigned int> color_offsets_;
+            std::vector<unsigned int> color_rows_;
+        };
+
+
+        /** @brief Computes the residual rhs - A x on the fine level and restricts it to the coarse level within a single parallel region.
+        *
+        * @param A           Operator of the fine level
+        * @param R           Restriction operator
+        * @param x           Current iterate on the fine level
+        * @param rhs         Right hand side on the fine level
+        * @param residual    Work array for the fine level residual
+        * @param coarse_rhs  Restricted residual, i.e. right hand side of the coarse level
+        */
+        template <typename ScalarType>
+        void amg_residual_restrict(amg_sparsematrix<ScalarType> const & A, amg_sparsematrix<ScalarType> const & R,
+                                   ScalarType const * x, ScalarType const * rhs, ScalarType * residual, ScalarType * coarse_rhs)
+        {
+          std::vector<unsigned int> const & A_row_buffer = A.row_buffer();
+          std::vector<unsigned int> const & A_col_buffer = A.col_buffer();
+          std::vector<ScalarType>   const & A_elements   = A.elements();
+          std::vector<unsigned int> const & R_row_buffer = R.row_buffer();
+          std::vector<unsigned int> const & R_col_buffer = R.col_buffer();
+          std::vector<ScalarType>   const & R_elements   = R.elements();
+          long size        = static_cast<long>(A.size1());
+          long coarse_size = static_cast<long>(R.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+          {
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for
+#endif
+            for (long row = 0; row < size; ++row)
+            {
+              ScalarType sum = rhs[row];
+              for (unsigned int k = A_row_buffer[row]; k < A_row_buffer[row+1]; ++k)
+                sum -= A_elements[k] * x[A_col_buffer[k]];
+              residual[row] = sum;
+            }
+
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for
+#endif
+            for (long row = 0; row < coarse_size; ++row)
+            {
+              ScalarType sum = 0;
+              for (unsigned int k = R_row_buffer[row]; k < R_row_buffer[row+1]; ++k)
+                sum += R_elements[k] * residual[R_col_buffer[k]];
+              coarse_rhs[row] = sum;
+            }
+          }
+        }
+
+        /** @brief Interpolates the coarse level correction and adds it to the fine level iterate: x += P * coarse_x */
+        template <typename ScalarType>
+        void amg_prolongate_correct(amg_sparsematrix<ScalarType> const & P, ScalarType const * coarse_x, ScalarType * x)
+        {
+          std::vector<unsigned int> const & row_buffer = P.row_buffer();
+          std::vector<unsigned int> const & col_buffer = P.col_buffer();
+          std::vector<ScalarType>   const & elements   = P.elements();
+          long size = static_cast<long>(P.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+          for (long row = 0; row < size; ++row)
+          {
+            ScalarType sum = x[row];
+            for (unsigned int k = row_buffer[row]; k < row_buffer[row+1]; ++k)
+              sum += elements[k] * coarse_x[col_buffer[k]];
+            x[row] = sum;
+          }
+        }
+
+
+        /** @brief V- or W-cycle of the AMG preconditioner on the host.
+        *
+        *  All work vectors, the restriction operators, the smoother data and the LU factorization on the coarsest level are set up once by init().
+        *  Operators and interpolation matrices of the setup phase are passed to apply(), so copies of the preconditioner remain valid.
+        */
+        template <typename ScalarType>
+        class amg_host_cycle
+        {
+            typedef amg_sparsematrix<ScalarType> SparseMatrixType;
+
+          public:
+            amg_host_cycle() : coarse_permutation_(0) {}
+
+            /** @brief Builds the data structures for the precondition phase.
+            *
+            * @param A    Operators on all levels from the setup phase
+            * @param P    Prolongation operators on all levels from the setup phase
+            * @param tag  AMG preconditioner tag
+            */
+            template <typename SparseMatrixVectorType>
+            void init(SparseMatrixVectorType const & A, SparseMatrixVectorType const & P, amg_tag const & tag)
+            {
+              unsigned int levels = tag.get_coarselevels();
+
+              R_.resize(levels);
+              smoothers_.resize(levels);
+              x_.resize(levels + 1);
+              rhs_.resize(levels + 1);
+              work_.resize(levels);
+              for (unsigned int level = 0; level < levels; ++level)
+              {
+                P[level].trans(R_[level]);
+                smoothers_[level].init(A[level], tag);
+                if (level > 0)
+                  x_[level].resize(A[level].size1());
+                rhs_[level].resize(A[level].size1());
+                work_[level].resize(A[level].size1());
+              }
+              x_[levels].resize(A[levels].size1());
+              rhs_[levels].resize(A[levels].size1());
+
+              // LU factorization for the direct solve on the coarsest level:
+              amg_copy(A[levels], coarse_lu_);
+              coarse_permutation_ = boost::numeric::ublas::permutation_matrix<>(coarse_lu_.size1());
+              boost::numeric::ublas::lu_factorize(coarse_lu_, coarse_permutation_);
+              coarse_vec_.resize(A[levels].size1());
+            }
+
+            /** @brief Applies one cycle to vec, which holds the right hand side on entry and the result on exit. */
+            template <typename SparseMatrixVectorType>
+            void apply(SparseMatrixVectorType const & A, SparseMatrixVectorType const & P, ScalarType * vec, amg_tag & tag)
+            {
+              std::copy(vec, vec + rhs_[0].size(), rhs_[0].begin());
+              cycle(A, P, 0, vec, true, tag);
+            }
+
+            /** @brief Direct solve on the coarsest level. vec holds the right hand side on entry and the solution on exit. */
+            void coarse_solve(ScalarType * vec)
+            {
+              std::copy(vec, vec + coarse_vec_.size(), coarse_vec_.begin());
+              boost::numeric::ublas::lu_substitute(coarse_lu_, coarse_permutation_, coarse_vec_);
+              std::copy(coarse_vec_.begin(), coarse_vec_.end(), vec);
+            }
+
+          private:
+            template <typename SparseMatrixVectorType>
+            void cycle(SparseMatrixVectorType const & A, SparseMatrixVectorType const & P, unsigned int level, ScalarType * x, bool zero_guess, amg_tag & tag)
+            {
+              viennacl::tools::timer timer;
+              if (tag.get_timing())
+                timer.start();
+
+              if (level == R_.size())
+              {
+                std::copy(rhs_[level].begin(), rhs_[level].end(), x);
+                coarse_solve(x);
+                if (tag.get_timing())
+                  tag.add_level_time(level, timer.get());
+                return;
+              }
+
+              ScalarType * rhs  = &(rhs_[level][0]);
+              ScalarType * work = &(work_[level][0]);
+              ScalarType * coarse_x = &(x_[level+1][0]);
+
+              smoothers_[level].apply(A[level], x, rhs, work, tag.get_presmooth(), zero_guess, false);
+              amg_residual_restrict(A[level], R_[level], x, rhs, work, &(rhs_[level+1][0]));
+
+              if (tag.get_timing())
+                tag.add_level_time(level, timer.get());
+
+              // W-cycle: visit the coarser level twice, unless it is the coarsest level, where the second direct solve would not change anything.
+              unsigned int coarse_cycles = (tag.get_cycle() == VIENNACL_AMG_CYCLE_W && level + 1 < R_.size()) ? 2 : 1;
+              for (unsigned int i = 0; i < coarse_cycles; ++i)
+                cycle(A, P, level + 1, coarse_x, i == 0, tag);
+
+              if (tag.get_timing())
+                timer.start();
+
+              amg_prolongate_correct(P[level], coarse_x, x);
+              smoothers_[level].apply(A[level], x, rhs, work, tag.get_postsmooth(), false, true);
+
+              if (tag.get_timing())
+                tag.add_level_time(level, timer.get());
+            }
+
+            std::vector<SparseMatrixType> R_;
+            std::vector<amg_smoother<ScalarType> > smoothers_;
+            std::vector<std::vector<ScalarType> > x_;
+            std::vector<std::vector<ScalarType> > rhs_;
+            std::vector<std::vector<ScalarType> > work_;
+
+            boost::numeric::ublas::compressed_matrix<ScalarType> coarse_lu_;
+            boost::numeric::ublas::permutation_matrix<> coarse_permutation_;
+            boost::numeric::ublas::vector<ScalarType> coarse_vec_;
+        };
+
+      } //namespace amg
+    }
+  }
+}
+
+#endif
@@ -27,12 +27,6 @@
 #include <iostream>
 #include "viennacl/io/matrix_market.hpp"
 
-#ifdef SMALL_SIZE
-#define VIENNACL_AMG_MATRIXTYPE boost::numeric::ublas::matrix<ScalarType>
-#else
-#define VIENNACL_AMG_MATRIXTYPE MatrixType
-#endif
-
 namespace viennacl
 {
   namespace linalg
@@ -46,18 +40,10 @@ namespace viennacl
         template <typename MatrixType>
         void printmatrix(MatrixType & mat, int const value=-1)
         {
-          typedef typename MatrixType::value_type ScalarType;
-          typedef typename VIENNACL_AMG_MATRIXTYPE::iterator1 InternalRowIterator;
-          typedef typename VIENNACL_AMG_MATRIXTYPE::iterator2 InternalColIterator;
-
-          VIENNACL_AMG_MATRIXTYPE mat2 = mat;
-
-          for (InternalRowIterator row_iter = mat2.begin1(); row_iter != mat2.end1(); ++row_iter)
+          for (unsigned int i = 0; i < mat.size1(); ++i)
           {
-            for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-            {
-              std::cout << *col_iter << " ";
-            }
+            for (unsigned int j = 0; j < mat.size2(); ++j)
+              std::cout << mat(i,j) << " ";
             std::cout << std::endl;
           }
           std::cout << std::endl;
@@ -26,7 +26,8 @@
 #include <cmath>
 #include "viennacl/linalg/amg.hpp"
 
-#include <map>
+#include <vector>
+#include <utility>
 #ifdef VIENNACL_WITH_OPENMP
 #include <omp.h>
 #endif
@@ -60,6 +61,65 @@ namespace viennacl
         case VIENNACL_AMG_INTERPOL_SA: amg_interpol_sa (level, A, P, Pointvector, tag); break;
       }
     }
+
+    /** @brief Interpolation truncation (for VIENNACL_AMG_INTERPOL_DIRECT and VIENNACL_AMG_INTERPOL_CLASSIC)
+    *
+    * @param values       Entries of the row which has to be truncated
+    * @param num_values   Number of entries in the row
+    * @param tag  AMG preconditioner tag
+    */
+    template <typename ScalarType>
+    void amg_truncate_row(ScalarType * values, unsigned int num_values, amg_tag const & tag)
+    {
+      ScalarType row_max, row_min, row_sum_pos, row_sum_neg, row_sum_pos_scale, row_sum_neg_scale;
+
+      row_max = 0;
+      row_min = 0;
+      row_sum_pos = 0;
+      row_sum_neg = 0;
+
+      // Truncate interpolation by making values to zero that are a lot smaller than the biggest value in a row
+      // Determine max entry and sum of row (seperately for negative and positive entries)
+      for (unsigned int k=0; k<num_values; ++k)
+      {
+        if (values[k] > row_max)
+          row_max = values[k];
+        if (values[k] < row_min)
+          row_min = values[k];
+        if (values[k] > 0)
+          row_sum_pos += values[k];
+        if (values[k] < 0)
+          row_sum_neg += values[k];
+      }
+
+      row_sum_pos_scale = row_sum_pos;
+      row_sum_neg_scale = row_sum_neg;
+
+      // Make certain values to zero (seperately for negative and positive entries)
+      for (unsigned int k=0; k<num_values; ++k)
+      {
+        if (values[k] > 0 && values[k] < tag.get_interpolweight() * row_max)
+        {
+          row_sum_pos_scale -= values[k];
+          values[k] = 0;
+        }
+        if (values[k] < 0 && values[k] > tag.get_interpolweight() * row_min)
+        {
+          row_sum_pos_scale -= values[k];
+          values[k] = 0;
+        }
+      }
+
+      // Scale remaining values such that row sum is unchanged
+      for (unsigned int k=0; k<num_values; ++k)
+      {
+        if (values[k] > 0)
+          values[k] = values[k] *(row_sum_pos/row_sum_pos_scale);
+        if (values[k] < 0)
+          values[k] = values[k] *(row_sum_neg/row_sum_neg_scale);
+      }
+    }
+
     /** @brief Direct interpolation. Multi-threaded! (VIENNACL_AMG_INTERPOL_DIRECT)
      * @param level    Coarse level identifier
      * @param A      Operator matrix on all levels
@@ -71,90 +131,93 @@ namespace viennacl
     void amg_interpol_direct(unsigned int level, InternalType1 & A, InternalType1 & P, InternalType2 & Pointvector, amg_tag & tag)
     {
       typedef typename InternalType1::value_type SparseMatrixType;
-      //typedef typename InternalType2::value_type PointVectorType;
       typedef typename SparseMatrixType::value_type ScalarType;
-      typedef typename SparseMatrixType::iterator1 InternalRowIterator;
-      typedef typename SparseMatrixType::iterator2 InternalColIterator;
-
-      ScalarType temp_res;
-      ScalarType row_sum, c_sum, diag;
-      //int diag_sign;
-      unsigned int x, y;
-      amg_point *pointx, *pointy;
-      unsigned int c_points = Pointvector[level].get_cpoints();
 
-      // Setup Prolongation/Interpolation matrix
-      P[level] = SparseMatrixType(A[level].size1(),c_points);
-      P[level].clear();
+      amg_pointvector const & points = Pointvector[level];
+      std::vector<unsigned int> const & row_buffer = A[level].row_buffer();
+      std::vector<unsigned int> const & col_buffer = A[level].col_buffer();
+      std::vector<ScalarType>   const & elements   = A[level].elements();
+      std::vector<unsigned int> const & influencing_rows = points.influencing().row_buffer();
+      std::vector<unsigned int> const & influencing_cols = points.influencing().col_buffer();
+      long size = static_cast<long>(points.size());
 
       // Assign indices to C points
       Pointvector[level].build_index();
 
+      // Each row gets a slot for at most as many entries as there are strongly influencing points (one entry for C points)
+      std::vector<unsigned int> slot_start(points.size() + 1, 0);
+      for (long x=0; x < size; ++x)
+        slot_start[x+1] = slot_start[x] + (points.is_cpoint(x) ? 1 : (points.is_fpoint(x) ? points.influencing().row_size(x) : 0));
+
+      std::vector<unsigned int> row_nnz(points.size(), 0);
+      std::vector<unsigned int> slot_cols(slot_start[points.size()]);
+      std::vector<ScalarType>   slot_vals(slot_start[points.size()]);
+
       // Direct Interpolation (Yang, p.14)
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for private (pointx,pointy,row_sum,c_sum,temp_res,y,x,diag) shared (P,A,Pointvector,tag)
+      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
 #endif
-      for (x=0; x < Pointvector[level].size(); ++x)
+      for (long x=0; x < size; ++x)
       {
-        pointx = Pointvector[level][x];
-        /*if (A[level](x,x) > 0)
-          diag_sign = 1;
-        else
-          diag_sign = -1;*/
+        unsigned int pos = slot_start[x];
 
         // When the current line corresponds to a C point then the diagonal coefficient is 1 and the rest 0
-        if (pointx->is_cpoint())
-          P[level](x,pointx->get_coarse_index()) = 1;
+        if (points.is_cpoint(x))
+        {
+          slot_cols[pos] = points.get_coarse_index(x);
+          slot_vals[pos] = 1;
+          ++pos;
+        }
 
         // When the current line corresponds to a F point then the diagonal is 0 and the rest has to be computed (Yang, p.14)
-        if (pointx->is_fpoint())
+        if (points.is_fpoint(x))
         {
-          // Jump to row x
-          InternalRowIterator row_iter = A[level].begin1();
-          row_iter += x;
-
           // Row sum of coefficients (without diagonal) and sum of influencing C point coefficients has to be computed
-          row_sum = c_sum = diag = 0;
-          for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+          ScalarType row_sum = 0, c_sum = 0, diag = 0;
+          for (unsigned int k = row_buffer[x]; k < row_buffer[x+1]; ++k)
           {
-            y = col_iter.index2();
-            if (x == y)// || *col_iter * diag_sign > 0)
+            unsigned int y = col_buffer[k];
+            if (static_cast<unsigned int>(x) == y)
             {
-              diag += *col_iter;
+              diag += elements[k];
               continue;
             }
 
             // Sum all other coefficients in line x
-            row_sum += *col_iter;
+            row_sum += elements[k];
 
-            pointy = Pointvector[level][y];
             // Sum all coefficients that correspond to a strongly influencing C point
-            if (pointy->is_cpoint())
-              if (pointx->is_influencing(pointy))
-                c_sum += *col_iter;
+            if (points.is_cpoint(y))
+              if (points.influencing().contains(x, y))
+                c_sum += elements[k];
           }
-          temp_res = -row_sum/(c_sum*diag);
+          ScalarType temp_res = -row_sum/(c_sum*diag);
 
           // Iterate over all strongly influencing points of point x
-          for (amg_point::iterator iter = pointx->begin_influencing(); iter != pointx->end_influencing(); ++iter)
+          if (temp_res != 0)
           {
-            pointy = *iter;
-            // The value is only non-zero for columns that correspond to a C point
-            if (pointy->is_cpoint())
+            for (unsigned int k = influencing_rows[x]; k < influencing_rows[x+1]; ++k)
             {
-              if (temp_res != 0)
-                P[level](x, pointy->get_coarse_index()) = temp_res * A[level](x,pointy->get_index());
+              unsigned int y = influencing_cols[k];
+              // The value is only non-zero for columns that correspond to a C point
+              if (points.is_cpoint(y))
+              {
+                slot_cols[pos] = points.get_coarse_index(y);
+                slot_vals[pos] = temp_res * A[level](static_cast<unsigned int>(x), y);
+                ++pos;
+              }
             }
           }
 
           //Truncate interpolation if chosen
-          if (tag.get_interpolweight() != 0)
-            amg_truncate_row(P[level], x, tag);
+          if (tag.get_interpolweight() != 0 && pos > slot_start[x])
+            amg_truncate_row(&(slot_vals[slot_start[x]]), pos - slot_start[x], tag);
         }
+
+        row_nnz[x] = pos - slot_start[x];
       }
 
-      // P test
-      //test_interpolation(A[level], P[level], Pointvector[level]);
+      P[level].set_rows(points.size(), points.get_cpoints(), slot_start, row_nnz, slot_cols, slot_vals);
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "Prolongation Matrix:" << std::endl;
@@ -173,185 +236,134 @@ namespace viennacl
     void amg_interpol_classic(unsigned int level, InternalType1 & A, InternalType1 & P, InternalType2 & Pointvector, amg_tag & tag)
     {
       typedef typename InternalType1::value_type SparseMatrixType;
-      //typedef typename InternalType2::value_type PointVectorType;
       typedef typename SparseMatrixType::value_type ScalarType;
-      typedef typename SparseMatrixType::iterator1 InternalRowIterator;
-      typedef typename SparseMatrixType::iterator2 InternalColIterator;
 
-      ScalarType temp_res;
-      ScalarType weak_sum, strong_sum;
-      int diag_sign;
-      amg_sparsevector<ScalarType> c_sum_row;
-      amg_point *pointx, *pointy, *pointk, *pointm;
-      unsigned int x, y, k, m;
-
-      unsigned int c_points = Pointvector[level].get_cpoints();
-
-      // Setup Prolongation/Interpolation matrix
-      P[level] = SparseMatrixType(A[level].size1(), c_points);
-      P[level].clear();
+      amg_pointvector const & points = Pointvector[level];
+      SparseMatrixType const & A_level = A[level];
+      std::vector<unsigned int> const & row_buffer = A_level.row_buffer();
+      std::vector<unsigned int> const & col_buffer = A_level.col_buffer();
+      std::vector<ScalarType>   const & elements   = A_level.elements();
+      std::vector<unsigned int> const & influencing_rows = points.influencing().row_buffer();
+      std::vector<unsigned int> const & influencing_cols = points.influencing().col_buffer();
+      long size = static_cast<long>(points.size());
 
       // Assign indices to C points
       Pointvector[level].build_index();
 
+      // Each row gets a slot for at most as many entries as there are strongly influencing points (one entry for C points)
+      std::vector<unsigned int> slot_start(points.size() + 1, 0);
+      for (long x=0; x < size; ++x)
+        slot_start[x+1] = slot_start[x] + (points.is_cpoint(x) ? 1 : (points.is_fpoint(x) ? points.influencing().row_size(x) : 0));
+
+      std::vector<unsigned int> row_nnz(points.size(), 0);
+      std::vector<unsigned int> slot_cols(slot_start[points.size()]);
+      std::vector<ScalarType>   slot_vals(slot_start[points.size()]);
+
       // Classical Interpolation (Yang, p.13-14)
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for private (pointx,pointy,pointk,pointm,weak_sum,strong_sum,c_sum_row,temp_res,x,y,k,m,diag_sign) shared (A,P,Pointvector)
+      #pragma omp parallel if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
 #endif
-      for (x=0; x < Pointvector[level].size(); ++x)
       {
-        pointx = Pointvector[level][x];
-        if (A[level](x,x) > 0)
-          diag_sign = 1;
-        else
-          diag_sign = -1;
+        // Strongly influencing F neighbors k of x with the coefficient a_xk and the sum of the coefficients of row k belonging to C points influencing x
+        std::vector<std::pair<unsigned int, std::pair<ScalarType, ScalarType> > > c_sum_row;
 
-        // When the current line corresponds to a C point then the diagonal coefficient is 1 and the rest 0
-        if (pointx->is_cpoint())
-          P[level](x,pointx->get_coarse_index()) = 1;
-
-        // When the current line corresponds to a F point then the diagonal is 0 and the rest has to be computed (Yang, p.14)
-        if (pointx->is_fpoint())
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp for
+#endif
+        for (long x=0; x < size; ++x)
         {
-          // Jump to row x
-          InternalRowIterator row_iter = A[level].begin1();
-          row_iter += x;
-
-          weak_sum = 0;
-          c_sum_row = amg_sparsevector<ScalarType>(A[level].size1());
-          c_sum_row.clear();
-          for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+          unsigned int pos = slot_start[x];
+          int diag_sign = 1;
+          if (!(A_level(static_cast<unsigned int>(x), static_cast<unsigned int>(x)) > 0))
+            diag_sign = -1;
+
+          // When the current line corresponds to a C point then the diagonal coefficient is 1 and the rest 0
+          if (points.is_cpoint(x))
           {
-            k = col_iter.index2();
-            pointk = Pointvector[level][k];
+            slot_cols[pos] = points.get_coarse_index(x);
+            slot_vals[pos] = 1;
+            ++pos;
+          }
 
-            // Sum of weakly influencing neighbors + diagonal coefficient
-            if (x == k || !pointx->is_influencing(pointk))// || *col_iter * diag_sign > 0)
+          // When the current line corresponds to a F point then the diagonal is 0 and the rest has to be computed (Yang, p.14)
+          if (points.is_fpoint(x))
+          {
+            ScalarType weak_sum = 0;
+            c_sum_row.clear();
+            for (unsigned int l = row_buffer[x]; l < row_buffer[x+1]; ++l)
             {
-              weak_sum += *col_iter;
-              continue;
-            }
+              unsigned int k = col_buffer[l];
 
-            // Sums of coefficients in row k (strongly influening F neighbors) of C point neighbors of x are calculated
-            if (pointk->is_fpoint() && pointx->is_influencing(pointk))
-            {
-              for (amg_point::iterator iter = pointx->begin_influencing(); iter != pointx->end_influencing(); ++iter)
+              // Sum of weakly influencing neighbors + diagonal coefficient
+              if (static_cast<unsigned int>(x) == k || !points.influencing().contains(x, k))
               {
-                pointm = *iter;
-                m = pointm->get_index();
+                weak_sum += elements[l];
+                continue;
+              }
 
-                if (pointm->is_cpoint())
-                  // Only use coefficients that have opposite sign of diagonal.
-                  if (A[level](k,m) * diag_sign < 0)
-                    c_sum_row[k] += A[level](k,m);
+              // Sums of coefficients in row k (strongly influening F neighbors) of C point neighbors of x are calculated
+              if (points.is_fpoint(k))
+              {
+                ScalarType c_sum = 0;
+                for (unsigned int i = influencing_rows[x]; i < influencing_rows[x+1]; ++i)
+                {
+                  unsigned int m = influencing_cols[i];
+                  if (points.is_cpoint(m))
+                    // Only use coefficients that have opposite sign of diagonal.
+                    if (A_level(k,m) * diag_sign < 0)
+                      c_sum += A_level(k,m);
+                }
+                if (c_sum != 0)
+                  c_sum_row.push_back(std::make_pair(k, std::make_pair(elements[l], c_sum)));
               }
-              continue;
             }
-          }
-
-          // Iterate over all strongly influencing points of point x
-          for (amg_point::iterator iter = pointx->begin_influencing(); iter != pointx->end_influencing(); ++iter)
-          {
-            pointy = *iter;
-            y = pointy->get_index();
 
-            // The value is only non-zero for columns that correspond to a C point
-            if (pointy->is_cpoint())
+            // Iterate over all strongly influencing points of point x
+            for (unsigned int i = influencing_rows[x]; i < influencing_rows[x+1]; ++i)
             {
-              strong_sum = 0;
-              // Calculate term for strongly influencing F neighbors
-              for (typename amg_sparsevector<ScalarType>::iterator iter2 = c_sum_row.begin(); iter2 != c_sum_row.end(); ++iter2)
+              unsigned int y = influencing_cols[i];
+
+              // The value is only non-zero for columns that correspond to a C point
+              if (points.is_cpoint(y))
               {
-                k = iter2.index();
-                // Only use coefficients that have opposite sign of diagonal.
-                if (A[level](k,y) * diag_sign < 0)
-                  strong_sum += (A[level](x,k) * A[level](k,y)) / (*iter2);
+                ScalarType strong_sum = 0;
+                // Calculate term for strongly influencing F neighbors
+                for (std::size_t j=0; j<c_sum_row.size(); ++j)
+                {
+                  unsigned int k = c_sum_row[j].first;
+                  // Only use coefficients that have opposite sign of diagonal.
+                  if (A_level(k,y) * diag_sign < 0)
+                    strong_sum += (c_sum_row[j].second.first * A_level(k,y)) / c_sum_row[j].second.second;
+                }
+
+                // Calculate coefficient
+                ScalarType temp_res = - (A_level(static_cast<unsigned int>(x), y) + strong_sum) / (weak_sum);
+                if (temp_res != 0)
+                {
+                  slot_cols[pos] = points.get_coarse_index(y);
+                  slot_vals[pos] = temp_res;
+                  ++pos;
+                }
               }
-
-              // Calculate coefficient
-              temp_res = - (A[level](x,y) + strong_sum) / (weak_sum);
-              if (temp_res != 0)
-                P[level](x,pointy->get_coarse_index()) = temp_res;
             }
+
+            //Truncate iteration if chosen
+            if (tag.get_interpolweight() != 0 && pos > slot_start[x])
+              amg_truncate_row(&(slot_vals[slot_start[x]]), pos - slot_start[x], tag);
           }
 
-          //Truncate iteration if chosen
-          if (tag.get_interpolweight() != 0)
-            amg_truncate_row(P[level], x, tag);
+          row_nnz[x] = pos - slot_start[x];
         }
       }
 
+      P[level].set_rows(points.size(), points.get_cpoints(), slot_start, row_nnz, slot_cols, slot_vals);
+
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "Prolongation Matrix:" << std::endl;
       printmatrix (P[level]);
       #endif
     }
 
-    /** @brief Interpolation truncation (for VIENNACL_AMG_INTERPOL_DIRECT and VIENNACL_AMG_INTERPOL_CLASSIC)
-    *
-    * @param P    Interpolation matrix
-    * @param row  Row which has to be truncated
-    * @param tag  AMG preconditioner tag
-    */
-    template <typename SparseMatrixType>
-    void amg_truncate_row(SparseMatrixType & P, unsigned int row, amg_tag & tag)
-    {
-      typedef typename SparseMatrixType::value_type ScalarType;
-      typedef typename SparseMatrixType::iterator1 InternalRowIterator;
-      typedef typename SparseMatrixType::iterator2 InternalColIterator;
-
-      ScalarType row_max, row_min, row_sum_pos, row_sum_neg, row_sum_pos_scale, row_sum_neg_scale;
-
-      InternalRowIterator row_iter = P.begin1();
-      row_iter += row;
-
-      row_max = 0;
-      row_min = 0;
-      row_sum_pos = 0;
-      row_sum_neg = 0;
-
-      // Truncate interpolation by making values to zero that are a lot smaller than the biggest value in a row
-      // Determine max entry and sum of row (seperately for negative and positive entries)
-      for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-      {
-        if (*col_iter > row_max)
-          row_max = *col_iter;
-        if (*col_iter < row_min)
-          row_min = *col_iter;
-        if (*col_iter > 0)
-          row_sum_pos += *col_iter;
-        if (*col_iter < 0)
-          row_sum_neg += *col_iter;
-      }
-
-      row_sum_pos_scale = row_sum_pos;
-      row_sum_neg_scale = row_sum_neg;
-
-      // Make certain values to zero (seperately for negative and positive entries)
-      for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-      {
-        if (*col_iter > 0 && *col_iter < tag.get_interpolweight() * row_max)
-        {
-          row_sum_pos_scale -= *col_iter;
-          *col_iter = 0;
-        }
-        if (*col_iter < 0 && *col_iter > tag.get_interpolweight() * row_min)
-        {
-          row_sum_pos_scale -= *col_iter;
-          *col_iter = 0;
-        }
-      }
-
-      // Scale remaining values such that row sum is unchanged
-      for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-      {
-        if (*col_iter > 0)
-          *col_iter = *col_iter *(row_sum_pos/row_sum_pos_scale);
-        if (*col_iter < 0)
-          *col_iter = *col_iter *(row_sum_neg/row_sum_neg_scale);
-      }
-    }
-
     /** @brief AG (aggregation based) interpolation. Multi-Threaded! (VIENNACL_INTERPOL_SA)
      * @param level    Coarse level identifier
      * @param A      Operator matrix on all levels
@@ -362,32 +374,31 @@ namespace viennacl
     void amg_interpol_ag(unsigned int level, InternalType1 & A, InternalType1 & P, InternalType2 & Pointvector, amg_tag)
     {
       typedef typename InternalType1::value_type SparseMatrixType;
-      //typedef typename InternalType2::value_type PointVectorType;
-      //typedef typename SparseMatrixType::value_type ScalarType;
-      //typedef typename SparseMatrixType::iterator1 InternalRowIterator;
-      //typedef typename SparseMatrixType::iterator2 InternalColIterator;
-
-      unsigned int x;
-      amg_point *pointx, *pointy;
-      unsigned int c_points = Pointvector[level].get_cpoints();
+      typedef typename SparseMatrixType::value_type ScalarType;
 
-      P[level] = SparseMatrixType(A[level].size1(), c_points);
-      P[level].clear();
+      amg_pointvector const & points = Pointvector[level];
+      long size = static_cast<long>(A[level].size1());
 
       // Assign indices to C points
       Pointvector[level].build_index();
 
       // Set prolongation such that F point is interpolated (weight=1) by the aggregate it belongs to (Vanek et al p.6)
+      std::vector<unsigned int> slot_start(A[level].size1() + 1);
+      std::vector<unsigned int> row_nnz(A[level].size1(), 1);
+      std::vector<unsigned int> slot_cols(A[level].size1());
+      std::vector<ScalarType>   slot_vals(A[level].size1(), ScalarType(1));
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for private (x,pointx) shared (P)
+      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
 #endif
-      for (x=0; x<Pointvector[level].size(); ++x)
+      for (long x=0; x<size; ++x)
       {
-        pointx = Pointvector[level][x];
-        pointy = Pointvector[level][pointx->get_aggregate()];
         // Point x belongs to aggregate y.
-        P[level](x,pointy->get_coarse_index()) = 1;
+        slot_start[x] = static_cast<unsigned int>(x);
+        slot_cols[x]  = points.get_coarse_index(points.get_aggregate(x));
       }
+      slot_start[A[level].size1()] = static_cast<unsigned int>(A[level].size1());
+
+      P[level].set_rows(A[level].size1(), points.get_cpoints(), slot_start, row_nnz, slot_cols, slot_vals);
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "Aggregation based Prolongation:" << std::endl;
@@ -406,61 +417,83 @@ namespace viennacl
     void amg_interpol_sa(unsigned int level, InternalType1 & A, InternalType1 & P, InternalType2 & Pointvector, amg_tag & tag)
     {
       typedef typename InternalType1::value_type SparseMatrixType;
-      //typedef typename InternalType2::value_type PointVectorType;
       typedef typename SparseMatrixType::value_type ScalarType;
-      typedef typename SparseMatrixType::iterator1 InternalRowIterator;
-      typedef typename SparseMatrixType::iterator2 InternalColIterator;
 
-      unsigned int x,y;
-      ScalarType diag = 0;
-      unsigned int c_points = Pointvector[level].get_cpoints();
+      amg_pointvector const & points = Pointvector[level];
+      std::vector<unsigned int> const & row_buffer = A[level].row_buffer();
+      std::vector<unsigned int> const & col_buffer = A[level].col_buffer();
+      std::vector<ScalarType>   const & elements   = A[level].elements();
+      long size = static_cast<long>(A[level].size1());
 
-      InternalType1 P_tentative = InternalType1(P.size());
-      SparseMatrixType Jacobi = SparseMatrixType(A[level].size1(), A[level].size2());
-      Jacobi.clear();
-      P[level] = SparseMatrixType(A[level].size1(), c_points);
-      P[level].clear();
+      // Each row of the Jacobi matrix has the sparsity pattern of A plus the diagonal
+      std::vector<unsigned int> slot_start(A[level].size1() + 1, 0);
+      for (long x=0; x<size; ++x)
+        slot_start[x+1] = slot_start[x] + (row_buffer[x+1] - row_buffer[x]) + 1;
+
+      std::vector<unsigned int> row_nnz(A[level].size1(), 0);
+      std::vector<unsigned int> slot_cols(slot_start[A[level].size1()]);
+      std::vector<ScalarType>   slot_vals(slot_start[A[level].size1()]);
 
       // Build Jacobi Matrix via filtered A matrix (Vanek et al. p.6)
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for private (x,y,diag) shared (A,Pointvector)
+      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
 #endif
-      for (x=0; x<A[level].size1(); ++x)
+      for (long x=0; x<size; ++x)
       {
-        diag = 0;
-        InternalRowIterator row_iter = A[level].begin1();
-        row_iter += x;
-        for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+        ScalarType diag = 0;
+        unsigned int pos = slot_start[x];
+        unsigned int diag_pos = pos;
+        bool diag_found = false;
+        for (unsigned int k = row_buffer[x]; k < row_buffer[x+1]; ++k)
         {
-          y = col_iter.index2();
+          unsigned int y = col_buffer[k];
+          // Reserve the position of the diagonal entry (the columns of each row are sorted)
+          if (!diag_found && y >= static_cast<unsigned int>(x))
+          {
+            diag_found = true;
+            diag_pos = pos++;
+          }
+
           // Determine the structure of the Jacobi matrix by using a filtered matrix of A:
           // The diagonal consists of the diagonal coefficient minus all coefficients of points not in the neighborhood of x.
           // All other coefficients are the same as in A.
           // Already use Jacobi matrix to save filtered A matrix to speed up computation.
-          if (x == y)
-            diag += *col_iter;
-          else if (!Pointvector[level][x]->is_influencing(Pointvector[level][y]))
-            diag += -*col_iter;
+          if (static_cast<unsigned int>(x) == y)
+            diag += elements[k];
+          else if (!points.influencing().contains(x, y))
+            diag += -elements[k];
           else
-            Jacobi (x,y) = *col_iter;
+          {
+            slot_cols[pos] = y;
+            slot_vals[pos] = elements[k];
+            ++pos;
+          }
         }
-        InternalRowIterator row_iter2 = Jacobi.begin1();
-        row_iter2 += x;
+        if (!diag_found)
+          diag_pos = pos++;
+
         // Traverse through filtered A matrix and compute the Jacobi filtering
-        for (InternalColIterator col_iter2 = row_iter2.begin(); col_iter2 != row_iter2.end(); ++col_iter2)
-        {
-            *col_iter2 = - static_cast<ScalarType>(tag.get_interpolweight())/diag * *col_iter2;
-        }
+        for (unsigned int k = slot_start[x]; k < pos; ++k)
+          if (k != diag_pos)
+            slot_vals[k] = - static_cast<ScalarType>(tag.get_interpolweight())/diag * slot_vals[k];
+
         // Diagonal can be computed seperately.
-        Jacobi (x,x) = 1 - static_cast<ScalarType>(tag.get_interpolweight());
+        slot_cols[diag_pos] = static_cast<unsigned int>(x);
+        slot_vals[diag_pos] = 1 - static_cast<ScalarType>(tag.get_interpolweight());
+
+        row_nnz[x] = pos - slot_start[x];
       }
 
+      SparseMatrixType Jacobi;
+      Jacobi.set_rows(A[level].size1(), A[level].size2(), slot_start, row_nnz, slot_cols, slot_vals);
+
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "Jacobi Matrix:" << std::endl;
       printmatrix(Jacobi);
       #endif
 
       // Use AG interpolation as tentative prolongation
+      InternalType1 P_tentative = InternalType1(P.size());
       amg_interpol_ag(level, A, P_tentative, Pointvector, tag);
 
       #ifdef VIENNACL_AMG_DEBUG
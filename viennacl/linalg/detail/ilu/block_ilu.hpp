@@ -231,11 +231,7 @@ namespace viennacl
                                      viennacl::compressed_matrix<ScalarType> & LU,
                                      viennacl::linalg::ilut_tag)
         {
-          std::vector< std::map<unsigned int, ScalarType> > temp(mat_block.size1());
-
-          viennacl::linalg::precondition(mat_block, temp, tag_);
-
-          viennacl::copy(temp, LU);
+          viennacl::linalg::precondition(mat_block, LU, tag_);
         }
 
         ILUTag const & tag_;
@@ -477,11 +473,7 @@ namespace viennacl
                                      viennacl::compressed_matrix<ScalarType> & LU,
                                      viennacl::linalg::ilut_tag)
         {
-          std::vector< std::map<unsigned int, ScalarType> > temp(mat_block.size1());
-
-          viennacl::linalg::precondition(mat_block, temp, tag_);
-
-          viennacl::copy(temp, LU);
+          viennacl::linalg::precondition(mat_block, LU, tag_);
         }
 
 
@@ -33,6 +33,7 @@
 #include "viennacl/backend/memory.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
 #include "viennacl/linalg/misc_operations.hpp"
 
 namespace viennacl
@@ -217,6 +218,25 @@ namespace viennacl
       }
 
 
+      //
+      // Level scheduling setup of L and U for substitutions on the host:
+      //
+
+      /** @brief Sets up the level schedules for the substitutions with the unit lower triangular factor L and the upper triangular factor U stored in LU. */
+      template <typename ScalarType, unsigned int ALIGNMENT>
+      void level_scheduling_setup_host(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & LU,
+                                       viennacl::linalg::host_based::detail::csr_level_schedule<ScalarType> & L_schedule,
+                                       viennacl::linalg::host_based::detail::csr_level_schedule<ScalarType> & U_schedule)
+      {
+        ScalarType   const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(LU.handle());
+        unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle1());
+        unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle2());
+
+        viennacl::linalg::host_based::detail::csr_level_schedule_setup(row_buffer, col_buffer, elements, LU.size1(), L_schedule, false, viennacl::linalg::unit_lower_tag());
+        viennacl::linalg::host_based::detail::csr_level_schedule_setup(row_buffer, col_buffer, elements, LU.size1(), U_schedule, false, viennacl::linalg::upper_tag());
+      }
+
+
       //
       // Multifrontal substitution (both L and U). Will partly be moved to single_threaded/opencl/cuda implementations
       //
@@ -39,6 +39,7 @@
 #include <vector>
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/detail/ilu/common.hpp"
@@ -73,6 +74,9 @@ namespace viennacl
       *
       * refer to the Algorithm in Saad's book (1996 edition)
       *
+      * Row i only depends on the rows k < i with a nonzero entry a_ik, hence rows are grouped into levels (as for the substitution with L) and all rows of a level are factorized in parallel.
+      * Each row is processed exactly as in the sequential algorithm, so the result does not depend on the number of threads.
+      *
       *  @param A       The sparse matrix matrix. The result is directly written to A.
       */
     template<typename ScalarType>
@@ -86,58 +90,104 @@ namespace viennacl
       unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
       unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
 
-      // Note: Line numbers in the following refer to the algorithm in Saad's book
-
-      for (std::size_t i=1; i<A.size1(); ++i)  // Line 1
+      std::size_t num_rows = A.size1();
+      if (num_rows == 0)
+        return;
+
+      //
+      // Step 1: Position of the diagonal entries and level of each row:
+      //
+      unsigned int const no_entry = static_cast<unsigned int>(-1);
+      std::vector<unsigned int> diagonal_index(num_rows, no_entry);
+      std::vector<unsigned int> row_level(num_rows);
+      unsigned int num_levels = 0;
+      for (std::size_t i=0; i<num_rows; ++i)
       {
-        unsigned int row_i_begin = row_buffer[i];
-        unsigned int row_i_end   = row_buffer[i+1];
-        for (unsigned int buf_index_k = row_i_begin; buf_index_k < row_i_end; ++buf_index_k) //Note: We do not assume that the column indices within a row are sorted
+        unsigned int level = 0;
+        for (unsigned int buf_index = row_buffer[i]; buf_index < row_buffer[i+1]; ++buf_index)
         {
-          unsigned int k = col_buffer[buf_index_k];
-          if (k >= i)
-            continue; //Note: We do not assume that the column indices within a row are sorted
+          unsigned int col = col_buffer[buf_index];
+          if (col < i)
+            level = std::max<unsigned int>(level, row_level[col] + 1);
+          else if (col == i)
+            diagonal_index[i] = buf_index;
+        }
+        row_level[i] = level;
+        num_levels = std::max<unsigned int>(num_levels, level + 1);
+      }
 
-          unsigned int row_k_begin = row_buffer[k];
-          unsigned int row_k_end   = row_buffer[k+1];
+      std::vector<unsigned int> level_buffer(num_levels + 1);
+      for (std::size_t i=0; i<num_rows; ++i)
+        ++level_buffer[row_level[i] + 1];
+      for (std::size_t level=0; level<num_levels; ++level)
+        level_buffer[level+1] += level_buffer[level];
+
+      std::vector<unsigned int> level_rows(num_rows);
+      std::vector<unsigned int> fill_index(level_buffer.begin(), level_buffer.end() - 1);
+      for (std::size_t i=0; i<num_rows; ++i)
+        level_rows[fill_index[row_level[i]]++] = static_cast<unsigned int>(i);
+
+      //
+      // Step 2: Factorize rows level by level. Note: Line numbers in the following refer to the algorithm in Saad's book
+      //
+      long levels_long = static_cast<long>(num_levels);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel if (num_rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE && num_rows > 32 * static_cast<std::size_t>(num_levels))
+#endif
+      {
+        std::vector<unsigned int> entry_index(num_rows, no_entry);           // position of a_ij in row i for column j
+        std::vector<std::pair<unsigned int, unsigned int> > lower_entries;   // (k, position of a_ik) for all k < i
 
-          // get a_kk:
-          ScalarType a_kk = 0;
-          for (unsigned int buf_index_akk = row_k_begin; buf_index_akk < row_k_end; ++buf_index_akk)
+        for (long level = 0; level < levels_long; ++level)
+        {
+          long level_begin = static_cast<long>(level_buffer[level]);
+          long level_end   = static_cast<long>(level_buffer[level+1]);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp for
+#endif
+          for (long row_index = level_begin; row_index < level_end; ++row_index)  // Line 1
           {
-            if (col_buffer[buf_index_akk] == k)
+            unsigned int i = level_rows[row_index];
+            unsigned int row_i_begin = row_buffer[i];
+            unsigned int row_i_end   = row_buffer[i+1];
+
+            //Note: We do not assume that the column indices within a row are sorted, but entries of L have to be processed in ascending order
+            lower_entries.clear();
+            for (unsigned int buf_index = row_i_begin; buf_index < row_i_end; ++buf_index)
             {
-              a_kk = elements[buf_index_akk];
-              break;
+              unsigned int col = col_buffer[buf_index];
+              entry_index[col] = buf_index;
+              if (col < i)
+                lower_entries.push_back(std::make_pair(col, buf_index));
             }
-          }
+            std::sort(lower_entries.begin(), lower_entries.end());
 
-          ScalarType & a_ik = elements[buf_index_k];
-          a_ik /= a_kk;                                 //Line 3
+            for (std::size_t l = 0; l < lower_entries.size(); ++l)
+            {
+              unsigned int k = lower_entries[l].first;
 
-          for (unsigned int buf_index_j = row_i_begin; buf_index_j < row_i_end; ++buf_index_j) //Note: We do not assume that the column indices within a row are sorted
-          {
-            unsigned int j = col_buffer[buf_index_j];
-            if (j <= k)
-              continue;
+              // get a_kk:
+              ScalarType a_kk = (diagonal_index[k] != no_entry) ? elements[diagonal_index[k]] : ScalarType(0);
 
-            // determine a_kj:
-            ScalarType a_kj = 0;
-            for (unsigned int buf_index_akj = row_k_begin; buf_index_akj < row_k_end; ++buf_index_akj)
-            {
-              if (col_buffer[buf_index_akj] == j)
+              ScalarType & a_ik = elements[lower_entries[l].second];
+              a_ik /= a_kk;                                 //Line 3
+
+              for (unsigned int buf_index_akj = row_buffer[k]; buf_index_akj < row_buffer[k+1]; ++buf_index_akj)
               {
-                a_kk = elements[buf_index_akj];
-                break;
+                unsigned int j = col_buffer[buf_index_akj];
+                if (j <= k || entry_index[j] == no_entry)
+                  continue;
+
+                //a_ij -= a_ik * a_kj
+                elements[entry_index[j]] -= a_ik * elements[buf_index_akj];  //Line 5
               }
             }
 
-            //a_ij -= a_ik * a_kj
-            elements[buf_index_j] -= a_ik * a_kj;  //Line 5
+            for (unsigned int buf_index = row_i_begin; buf_index < row_i_end; ++buf_index)
+              entry_index[col_buffer[buf_index]] = no_entry;
           }
         }
       }
-
     }
 
 
@@ -164,10 +214,20 @@ namespace viennacl
           unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle2());
           ScalarType   const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(LU.handle());
 
-          viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LU.size2(), unit_lower_tag());
-          viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LU.size2(), upper_tag());
+          if (tag_.use_level_scheduling())
+          {
+            viennacl::linalg::host_based::detail::csr_level_scheduled_inplace_solve(L_schedule_, vec);
+            viennacl::linalg::host_based::detail::csr_level_scheduled_inplace_solve(U_schedule_, vec);
+          }
+          else
+          {
+            viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LU.size2(), unit_lower_tag());
+            viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LU.size2(), upper_tag());
+          }
         }
 
+        vcl_size_t levels() const { return L_schedule_.levels(); }
+
       private:
         void init(MatrixType const & mat)
         {
@@ -176,11 +236,17 @@ namespace viennacl
 
           viennacl::copy(mat, LU);
           viennacl::linalg::precondition(LU, tag_);
+
+          if (tag_.use_level_scheduling())
+            detail::level_scheduling_setup_host(LU, L_schedule_, U_schedule_);
         }
 
         ilu0_tag const & tag_;
 
         viennacl::compressed_matrix<ScalarType> LU;
+
+        viennacl::linalg::host_based::detail::csr_level_schedule<ScalarType> L_schedule_;
+        viennacl::linalg::host_based::detail::csr_level_schedule<ScalarType> U_schedule_;
     };
 
 
@@ -205,7 +271,16 @@ namespace viennacl
         void apply(vector<ScalarType> & vec) const
         {
           viennacl::context host_context(viennacl::MAIN_MEMORY);
-          if (vec.handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
+          if (tag_.use_level_scheduling() && L_schedule_.levels() > 0) //level schedules on the host, the vector is moved there if necessary
+          {
+            viennacl::context old_context = viennacl::traits::context(vec);
+            viennacl::switch_memory_context(vec, host_context);
+            ScalarType * vec_buf = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(vec.handle());
+            viennacl::linalg::host_based::detail::csr_level_scheduled_inplace_solve(L_schedule_, vec_buf);
+            viennacl::linalg::host_based::detail::csr_level_scheduled_inplace_solve(U_schedule_, vec_buf);
+            viennacl::switch_memory_context(vec, old_context);
+          }
+          else if (vec.handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
           {
             if (tag_.use_level_scheduling())
             {
@@ -264,7 +339,7 @@ namespace viennacl
           }
         }
 
-        vcl_size_t levels() const { return multifrontal_L_row_index_arrays_.size(); }
+        vcl_size_t levels() const { return L_schedule_.levels() > 0 ? L_schedule_.levels() : multifrontal_L_row_index_arrays_.size(); }
 
       private:
         void init(MatrixType const & mat)
@@ -277,6 +352,13 @@ namespace viennacl
           if (!tag_.use_level_scheduling())
             return;
 
+          // level schedules are used directly on the host if the system matrix resides there:
+          if (viennacl::traits::context(mat).memory_type() == viennacl::MAIN_MEMORY)
+          {
+            detail::level_scheduling_setup_host(LU, L_schedule_, U_schedule_);
+            return;
+          }
+
           // multifrontal part:
           viennacl::switch_memory_context(multifrontal_U_diagonal_, host_context);
           multifrontal_U_diagonal_.resize(LU.size1(), false);
@@ -367,6 +449,8 @@ namespace viennacl
         std::list< viennacl::backend::mem_handle > multifrontal_U_element_buffers_;
         std::list< std::size_t > multifrontal_U_row_elimination_num_list_;
 
+        viennacl::linalg::host_based::detail::csr_level_schedule<ScalarType> L_schedule_;
+        viennacl::linalg::host_based::detail::csr_level_schedule<ScalarType> U_schedule_;
     };
 
   }
@@ -25,6 +25,7 @@
 #include <vector>
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 
@@ -49,7 +50,7 @@ namespace viennacl
         *
         * @param entries_per_row        Number of nonzero entries per row in L and U. Note that L and U are stored in a single matrix, thus there are 2*entries_per_row in total.
         * @param drop_tolerance         The drop tolerance for ILUT
-        * @param with_level_scheduling  Flag for enabling level scheduling on GPUs.
+        * @param with_level_scheduling  Flag for enabling level scheduling (parallel substitutions on the host and on GPUs).
         */
         ilut_tag(unsigned int entries_per_row = 20,
                  double drop_tolerance = 1e-4,
@@ -80,11 +81,13 @@ namespace viennacl
     };
 
 
-    /** @brief Dispatcher overload for extracting the row of nonzeros of a compressed matrix */
-    template <typename ScalarType, typename SizeType, typename SparseVector>
+    /** @brief Dispatcher overload for extracting the row of nonzeros of a compressed matrix into a dense work row. Returns the 2-norm of the row. */
+    template <typename ScalarType, typename SizeType>
     ScalarType setup_w(viennacl::compressed_matrix<ScalarType> const & A,
                        SizeType row,
-                       SparseVector & w)
+                       std::vector<ScalarType> & w,
+                       std::vector<bool> & w_used,
+                       std::vector<SizeType> & w_cols)
     {
       assert( (A.handle1().get_active_handle_id() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILU0") );
       assert( (A.handle2().get_active_handle_id() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILU0") );
@@ -99,69 +102,127 @@ namespace viennacl
       ScalarType row_norm = 0;
       for (SizeType buf_index_i = row_i_begin; buf_index_i < row_i_end; ++buf_index_i) //Note: We do not assume that the column indices within a row are sorted
       {
+        SizeType col = static_cast<SizeType>(col_buffer[buf_index_i]);
         ScalarType entry = elements[buf_index_i];
-        w[col_buffer[buf_index_i]] = entry;
+        if (!w_used[col])
+        {
+          w_used[col] = true;
+          w_cols.push_back(col);
+        }
+        w[col] = entry;
         row_norm += entry * entry;
       }
       return std::sqrt(row_norm);
     }
 
-    /** @brief Dispatcher overload for extracting the row of nonzeros of a STL-grown sparse matrix */
-    template <typename ScalarType, typename SizeType, typename SparseVector>
+    /** @brief Dispatcher overload for extracting the row of nonzeros of a STL-grown sparse matrix into a dense work row. Returns the 2-norm of the row. */
+    template <typename ScalarType, typename SizeType>
     ScalarType setup_w(std::vector< std::map<SizeType, ScalarType> > const & A,
                        SizeType row,
-                       SparseVector & w)
+                       std::vector<ScalarType> & w,
+                       std::vector<bool> & w_used,
+                       std::vector<SizeType> & w_cols)
     {
       ScalarType row_norm = 0;
-      w = A[row];
-      for (typename std::map<SizeType, ScalarType>::const_iterator iter_w  = w.begin(); iter_w != w.end(); ++iter_w)
-        row_norm += iter_w->second * iter_w->second;
+      for (typename std::map<SizeType, ScalarType>::const_iterator iter_a = A[row].begin(); iter_a != A[row].end(); ++iter_a)
+      {
+        w_used[iter_a->first] = true;
+        w_cols.push_back(iter_a->first);
+        w[iter_a->first] = iter_a->second;
+        row_norm += iter_a->second * iter_a->second;
+      }
 
       return std::sqrt(row_norm);
     }
 
 
-    /** @brief Implementation of a ILU-preconditioner with threshold. Optimized implementation for compressed_matrix.
+    namespace detail
+    {
+      /** @brief Orders pairs (absolute value, column) such that entries of larger magnitude come first. Ties are broken by the column index. */
+      template <typename ScalarType, typename SizeType>
+      bool ilut_larger_entry(std::pair<ScalarType, SizeType> const & a, std::pair<ScalarType, SizeType> const & b)
+      {
+        return (a.first > b.first) || (a.first == b.first && a.second < b.second);
+      }
+
+      /** @brief Orders pairs (absolute value, column) by the column index */
+      template <typename ScalarType, typename SizeType>
+      bool ilut_smaller_column(std::pair<ScalarType, SizeType> const & a, std::pair<ScalarType, SizeType> const & b)
+      {
+        return a.second < b.second;
+      }
+
+      /** @brief Keeps the (at most) max_entries entries of largest magnitude and sorts them by column index */
+      template <typename ScalarType, typename SizeType>
+      void ilut_keep_largest(std::vector< std::pair<ScalarType, SizeType> > & entries, std::size_t max_entries)
+      {
+        if (entries.size() > max_entries)
+        {
+          std::nth_element(entries.begin(), entries.begin() + static_cast<long>(max_entries), entries.end(), ilut_larger_entry<ScalarType, SizeType>);
+          entries.resize(max_entries);
+        }
+        std::sort(entries.begin(), entries.end(), ilut_smaller_column<ScalarType, SizeType>);
+      }
+    }
+
+
+    /** @brief Implementation of a ILU-preconditioner with threshold. Writes the factors L and U directly to a compressed_matrix.
     *
     * refer to Algorithm 10.6 by Saad's book (1996 edition)
     *
+    * The current row is held in a dense work row. Its nonzero columns are kept in a linked list in ascending order,
+    * so the pivots k < i are visited in order and fill-in is inserted behind the current pivot without any search tree.
+    *
     *  @param A       The input matrix. Either a compressed_matrix or of type std::vector< std::map<T, U> >
-    *  @param output  The output matrix. Type requirements: const_iterator1 for iteration along rows, const_iterator2 for iteration along columns and write access via operator()
+    *  @param LU      The output matrix holding L (unit diagonal not stored) and U. Column indices are sorted within each row.
     *  @param tag     An ilut_tag in order to dispatch among several other preconditioners.
     */
-    template<typename SparseMatrixType, typename ScalarType, typename SizeType>
+    template<typename SparseMatrixType, typename ScalarType>
     void precondition(SparseMatrixType const & A,
-                      std::vector< std::map<SizeType, ScalarType> > & output,
+                      viennacl::compressed_matrix<ScalarType> & LU,
                       ilut_tag const & tag)
     {
-      typedef std::map<SizeType, ScalarType>          SparseVector;
-      typedef typename SparseVector::iterator         SparseVectorIterator;
-      typedef typename std::map<SizeType, ScalarType>::const_iterator   OutputRowConstIterator;
-      typedef std::multimap<ScalarType, std::pair<SizeType, ScalarType> >  TemporarySortMap;
+      typedef unsigned int                          SizeType;
+      typedef std::pair<ScalarType, SizeType>       EntryType;
 
-      assert(viennacl::traits::size1(A) == output.size() && bool("Output matrix size mismatch") );
+      SizeType num_rows = static_cast<SizeType>(viennacl::traits::size1(A));
+      if (num_rows == 0)
+        return;
 
-      SparseVector w;
-      TemporarySortMap temp_map;
+      std::vector<ScalarType> w(num_rows);
+      std::vector<bool>       w_used(num_rows, false);
+      std::vector<SizeType>   w_cols;
+      std::vector<SizeType>   w_next(num_rows + 1);   //linked list of the nonzero columns of w in ascending order. Entry num_rows is the list head, the value num_rows marks the end of the list.
 
-      for (SizeType i=0; i<viennacl::traits::size1(A); ++i)  // Line 1
-      {
-    /*    if (i%10 == 0)
-      std::cout << i << std::endl;*/
+      std::vector<SizeType>   LU_row_buffer(num_rows + 1);
+      std::vector<SizeType>   LU_col_buffer;
+      std::vector<ScalarType> LU_elements;
+      std::vector<SizeType>   LU_diagonal(num_rows);  //position of the diagonal entry in each row. U is stored behind the diagonal.
+
+      std::vector<EntryType>  L_entries;
+      std::vector<EntryType>  U_entries;
 
+      for (SizeType i=0; i<num_rows; ++i)  // Line 1
+      {
         //line 2: set up w
-        ScalarType row_norm = setup_w(A, i, w);
+        w_cols.clear();
+        ScalarType row_norm = setup_w(A, i, w, w_used, w_cols);
         ScalarType tau_i = static_cast<ScalarType>(tag.get_drop_tolerance()) * row_norm;
 
-        //line 3:
-        for (SparseVectorIterator w_k = w.begin(); w_k != w.end(); ++w_k)
+        std::sort(w_cols.begin(), w_cols.end());
+        SizeType list_tail = num_rows;
+        for (std::size_t k=0; k<w_cols.size(); ++k)
         {
-          SizeType k = w_k->first;
-          if (k >= i)
-            break;
+          w_next[list_tail] = w_cols[k];
+          list_tail = w_cols[k];
+        }
+        w_next[list_tail] = num_rows;
 
+        //line 3:
+        for (SizeType k = w_next[num_rows]; k < i; k = w_next[k])
+        {
           //line 4:
-          ScalarType a_kk = output[k][k];
+          ScalarType a_kk = LU_elements[LU_diagonal[k]];
           if (a_kk == 0)
           {
             std::cerr << "ViennaCL: FATAL ERROR in ILUT(): Diagonal entry is zero in row " << k
@@ -169,77 +230,111 @@ namespace viennacl
             throw "ILUT zero diagonal!";
           }
 
-          ScalarType w_k_entry = w_k->second / a_kk;
-          w_k->second = w_k_entry;
+          ScalarType w_k_entry = w[k] / a_kk;
+          w[k] = w_k_entry;
 
           //line 5: (dropping rule to w_k)
           if ( std::fabs(w_k_entry) > tau_i)
           {
-            //line 7:
-            for (OutputRowConstIterator u_k = output[k].begin(); u_k != output[k].end(); ++u_k)
+            //line 7: the columns of u_k are sorted, hence the insertion position of fill-in is searched from the last column of u_k onwards
+            SizeType insert_after = k;
+            for (SizeType buf_index = LU_diagonal[k] + 1; buf_index < LU_row_buffer[k+1]; ++buf_index)
             {
-              if (u_k->first > k)
-                w[u_k->first] -= w_k_entry * u_k->second;
+              SizeType j = LU_col_buffer[buf_index];
+              if (!w_used[j])
+              {
+                while (w_next[insert_after] < j)
+                  insert_after = w_next[insert_after];
+                w_next[j] = w_next[insert_after];
+                w_next[insert_after] = j;
+                w_used[j] = true;
+                w_cols.push_back(j);
+                w[j] = 0;
+              }
+              insert_after = j;
+              w[j] -= w_k_entry * LU_elements[buf_index];
             }
           }
-          //else
-          //  w.erase(k);
-
-        } //for w_k
+        } //for k
 
         //Line 10: Apply a dropping rule to w
-        //Sort entries which are kept
-        temp_map.clear();
-        for (SparseVectorIterator w_k = w.begin(); w_k != w.end(); ++w_k)
+        L_entries.clear();
+        U_entries.clear();
+        bool has_diagonal = false;
+        for (SizeType k = w_next[num_rows]; k != num_rows; k = w_next[k])
         {
-          SizeType k = w_k->first;
-          ScalarType w_k_entry = w_k->second;
-
-          ScalarType abs_w_k = std::fabs(w_k_entry);
-          if ( (abs_w_k > tau_i) || (k == i) )//do not drop diagonal element!
+          ScalarType abs_w_k = std::fabs(w[k]);
+          if (k == i) //do not drop diagonal element!
+            has_diagonal = (abs_w_k > 0);
+          else if (abs_w_k > tau_i)
           {
-
-            if (abs_w_k == 0) // this can only happen for diagonal entry
-              throw "Triangular factor in ILUT singular!";
-
-            temp_map.insert(std::make_pair(abs_w_k, std::make_pair(k, w_k_entry)));
+            if (k < i)
+              L_entries.push_back(EntryType(abs_w_k, k));
+            else
+              U_entries.push_back(EntryType(abs_w_k, k));
           }
         }
 
+        if (!has_diagonal)
+          throw "Triangular factor in ILUT singular!";
+
         //Lines 10-12: write the largest p values to L and U
-        SizeType written_L = 0;
-        SizeType written_U = 0;
-        for (typename TemporarySortMap::reverse_iterator iter = temp_map.rbegin(); iter != temp_map.rend(); ++iter)
-        {
-          std::map<SizeType, ScalarType> & row_i = output[i];
-          SizeType j = (iter->second).first;
-          ScalarType w_j_entry = (iter->second).second;
+        detail::ilut_keep_largest(L_entries, tag.get_entries_per_row());
+        detail::ilut_keep_largest(U_entries, tag.get_entries_per_row());
 
-          if (j < i) // Line 11: entry for L
-          {
-            if (written_L < tag.get_entries_per_row())
-            {
-              row_i[j] = w_j_entry;
-              ++written_L;
-            }
-          }
-          else if (j == i)  // Diagonal entry is always kept
-          {
-            row_i[j] = w_j_entry;
-          }
-          else //Line 12: entry for U
-          {
-            if (written_U < tag.get_entries_per_row())
-            {
-              row_i[j] = w_j_entry;
-              ++written_U;
-            }
-          }
+        for (std::size_t k=0; k<L_entries.size(); ++k)
+        {
+          LU_col_buffer.push_back(L_entries[k].second);
+          LU_elements.push_back(w[L_entries[k].second]);
         }
+        LU_diagonal[i] = static_cast<SizeType>(LU_col_buffer.size());
+        LU_col_buffer.push_back(i);
+        LU_elements.push_back(w[i]);
+        for (std::size_t k=0; k<U_entries.size(); ++k)
+        {
+          LU_col_buffer.push_back(U_entries[k].second);
+          LU_elements.push_back(w[U_entries[k].second]);
+        }
+        LU_row_buffer[i+1] = static_cast<SizeType>(LU_col_buffer.size());
 
-        w.clear(); //Line 13
+        //Line 13: reset work row
+        for (std::size_t k=0; k<w_cols.size(); ++k)
+        {
+          w[w_cols[k]] = 0;
+          w_used[w_cols[k]] = false;
+        }
 
       } //for i
+
+      LU.set(&(LU_row_buffer[0]), &(LU_col_buffer[0]), &(LU_elements[0]), num_rows, num_rows, LU_elements.size());
+    }
+
+
+    /** @brief Implementation of a ILU-preconditioner with threshold writing the factors L and U to a STL-grown sparse matrix. See the overload for compressed_matrix for details.
+    *
+    *  @param A       The input matrix. Either a compressed_matrix or of type std::vector< std::map<T, U> >
+    *  @param output  The output matrix. Type requirements: const_iterator1 for iteration along rows, const_iterator2 for iteration along columns and write access via operator()
+    *  @param tag     An ilut_tag in order to dispatch among several other preconditioners.
+    */
+    template<typename SparseMatrixType, typename ScalarType, typename SizeType>
+    void precondition(SparseMatrixType const & A,
+                      std::vector< std::map<SizeType, ScalarType> > & output,
+                      ilut_tag const & tag)
+    {
+      assert(viennacl::traits::size1(A) == output.size() && bool("Output matrix size mismatch") );
+
+      viennacl::compressed_matrix<ScalarType> LU(viennacl::context(viennacl::MAIN_MEMORY));
+      precondition(A, LU, tag);
+      if (output.size() == 0)
+        return;
+
+      ScalarType   const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(LU.handle());
+      unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle1());
+      unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle2());
+
+      for (std::size_t i=0; i<output.size(); ++i)
+        for (unsigned int buf_index = row_buffer[i]; buf_index < row_buffer[i+1]; ++buf_index)
+          output[i][static_cast<SizeType>(col_buffer[buf_index])] = elements[buf_index];
     }
 
 
@@ -267,10 +362,20 @@ namespace viennacl
           unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle2());
           ScalarType   const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(LU.handle());
 
-          viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LU.size2(), unit_lower_tag());
-          viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LU.size2(), upper_tag());
+          if (tag_.use_level_scheduling())
+          {
+            viennacl::linalg::host_based::detail::csr_level_scheduled_inplace_solve(L_schedule_, vec);
+            viennacl::linalg::host_based::detail::csr_level_scheduled_inplace_solve(U_schedule_, vec);
+          }
+          else
+          {
+            viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LU.size2(), unit_lower_tag());
+            viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LU.size2(), upper_tag());
+          }
         }
 
+        vcl_size_t levels() const { return L_schedule_.levels(); }
+
       private:
         void init(MatrixType const & mat)
         {
@@ -280,16 +385,18 @@ namespace viennacl
 
           viennacl::copy(mat, temp);
 
-          std::vector< std::map<unsigned int, ScalarType> > LU_temp(mat.size1());
-
-          viennacl::linalg::precondition(temp, LU_temp, tag_);
-
           viennacl::switch_memory_context(LU, host_context);
-          viennacl::copy(LU_temp, LU);
+          viennacl::linalg::precondition(temp, LU, tag_);
+
+          if (tag_.use_level_scheduling())
+            detail::level_scheduling_setup_host(LU, L_schedule_, U_schedule_);
         }
 
         ilut_tag const & tag_;
         viennacl::compressed_matrix<ScalarType> LU;
+
+        viennacl::linalg::host_based::detail::csr_level_schedule<ScalarType> L_schedule_;
+        viennacl::linalg::host_based::detail::csr_level_schedule<ScalarType> U_schedule_;
     };
 
 
@@ -313,7 +420,17 @@ namespace viennacl
 
         void apply(vector<ScalarType> & vec) const
         {
-          if (vec.handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
+          if (tag_.use_level_scheduling() && L_schedule_.levels() > 0) //level schedules on the host, the vector is moved there if necessary
+          {
+            viennacl::context host_context(viennacl::MAIN_MEMORY);
+            viennacl::context old_context = viennacl::traits::context(vec);
+            viennacl::switch_memory_context(vec, host_context);
+            ScalarType * vec_buf = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(vec.handle());
+            viennacl::linalg::host_based::detail::csr_level_scheduled_inplace_solve(L_schedule_, vec_buf);
+            viennacl::linalg::host_based::detail::csr_level_scheduled_inplace_solve(U_schedule_, vec_buf);
+            viennacl::switch_memory_context(vec, old_context);
+          }
+          else if (vec.handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
           {
             if (tag_.use_level_scheduling())
             {
@@ -351,17 +468,17 @@ namespace viennacl
           }
         }
 
+        vcl_size_t levels() const { return L_schedule_.levels() > 0 ? L_schedule_.levels() : multifrontal_L_row_index_arrays_.size(); }
+
       private:
         void init(MatrixType const & mat)
         {
           viennacl::context host_context(viennacl::MAIN_MEMORY);
           viennacl::switch_memory_context(LU, host_context);
 
-          std::vector< std::map<unsigned int, ScalarType> > LU_temp(mat.size1());
-
           if (viennacl::traits::context(mat).memory_type() == viennacl::MAIN_MEMORY)
           {
-            viennacl::linalg::precondition(mat, LU_temp, tag_);
+            viennacl::linalg::precondition(mat, LU, tag_);
           }
           else //we need to copy to CPU
           {
@@ -370,14 +487,19 @@ namespace viennacl
 
             cpu_mat = mat;
 
-            viennacl::linalg::precondition(cpu_mat, LU_temp, tag_);
+            viennacl::linalg::precondition(cpu_mat, LU, tag_);
           }
 
-          viennacl::copy(LU_temp, LU);
-
           if (!tag_.use_level_scheduling())
             return;
 
+          // level schedules are used directly on the host if the system matrix resides there:
+          if (viennacl::traits::context(mat).memory_type() == viennacl::MAIN_MEMORY)
+          {
+            detail::level_scheduling_setup_host(LU, L_schedule_, U_schedule_);
+            return;
+          }
+
           //
           // multifrontal part:
           //
@@ -472,6 +594,9 @@ namespace viennacl
         std::list< viennacl::backend::mem_handle > multifrontal_U_col_buffers_;
         std::list< viennacl::backend::mem_handle > multifrontal_U_element_buffers_;
         std::list< std::size_t > multifrontal_U_row_elimination_num_list_;
+
+        viennacl::linalg::host_based::detail::csr_level_schedule<ScalarType> L_schedule_;
+        viennacl::linalg::host_based::detail::csr_level_schedule<ScalarType> U_schedule_;
     };
 
   }
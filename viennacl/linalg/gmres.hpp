@@ -25,11 +25,15 @@
 #include <vector>
 #include <cmath>
 #include <limits>
+#include <algorithm>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/backend/memory.hpp"
 #include "viennacl/traits/clear.hpp"
 #include "viennacl/traits/size.hpp"
 #include "viennacl/meta/result_of.hpp"
@@ -47,7 +51,7 @@ namespace viennacl
         /** @brief The constructor
         *
         * @param tol            Relative tolerance for the residual (solver quits if ||r|| < tol * ||r_initial||)
-        * @param max_iterations The maximum number of iterations (including restarts
+        * @param max_iterations The maximum number of iterations (including restarts)
         * @param krylov_dim     The maximum dimension of the Krylov space before restart (number of restarts is found by max_iterations / krylov_dim)
         */
         gmres_tag(double tol = 1e-10, unsigned int max_iterations = 300, unsigned int krylov_dim = 20)
@@ -88,6 +92,28 @@ namespace viennacl
         mutable double last_error_;
     };
 
+    /** @brief A tag for the pipelined GMRES solver. Used for supplying solver parameters and for dispatching the solve() function
+    *
+    * The Krylov basis is stored in a contiguous matrix, which allows for orthogonalizing the new basis vector against all previous basis vectors
+    * with a single multi-inner product and a single matrix-vector product (classical Gram-Schmidt).
+    * Thus, only two synchronizations with the host are required per iteration, whereas the Householder-based implementation requires a number of synchronizations
+    * proportional to the dimension of the Krylov space.
+    * Classical Gram-Schmidt is less robust with respect to loss of orthogonality than the Householder-based implementation, which may result in more iterations
+    * for ill-conditioned systems.
+    */
+    class pipelined_gmres_tag : public gmres_tag
+    {
+      public:
+        /** @brief The constructor
+        *
+        * @param tol            Relative tolerance for the residual (solver quits if ||r|| < tol * ||r_initial||)
+        * @param max_iterations The maximum number of iterations (including restarts)
+        * @param krylov_dim     The maximum dimension of the Krylov space before restart (number of restarts is found by max_iterations / krylov_dim)
+        */
+        pipelined_gmres_tag(double tol = 1e-10, unsigned int max_iterations = 300, unsigned int krylov_dim = 20)
+         : gmres_tag(tol, max_iterations, krylov_dim) {};
+    };
+
     namespace detail
     {
 
@@ -335,6 +361,182 @@ namespace viennacl
       return result;
     }
 
+    /** @brief Implementation of the pipelined GMRES solver.
+    *
+    * Arnoldi process with classical Gram-Schmidt orthogonalization on a Krylov basis stored in the columns of a dense matrix:
+    * The projections of the new basis vector onto all previous basis vectors are computed in a single pass using inner_prod() with a vector_tuple,
+    * and are then subtracted using a single matrix-vector product. The least-squares problem is solved on the host using Givens rotations.
+    *
+    * @param matrix     The system matrix
+    * @param rhs        The load vector
+    * @param tag        Solver configuration tag
+    * @param precond    A preconditioner. Precondition operation is done via member function apply()
+    * @return The result vector
+    */
+    template <typename MatrixType, typename NumericT, unsigned int ALIGNMENT, typename PreconditionerType>
+    viennacl::vector<NumericT, ALIGNMENT> solve(MatrixType const & matrix, viennacl::vector<NumericT, ALIGNMENT> const & rhs, pipelined_gmres_tag const & tag, PreconditionerType const & precond)
+    {
+      typedef viennacl::vector<NumericT, ALIGNMENT>                          VectorType;
+      typedef viennacl::matrix<NumericT, viennacl::column_major>             KrylovBasisType;
+
+      std::size_t problem_size = viennacl::traits::size(rhs);
+      VectorType result = rhs;
+      viennacl::traits::clear(result);
+
+      std::size_t krylov_dim = tag.krylov_dim();
+      if (problem_size < tag.krylov_dim())
+        krylov_dim = problem_size; //A Krylov space larger than the matrix would lead to seg-faults (mathematically, error is certain to be zero already)
+
+      VectorType res = rhs;
+      VectorType w = rhs;
+
+      // Krylov basis v_0, ..., v_{krylov_dim} in the columns of a single matrix:
+      KrylovBasisType krylov_basis(problem_size, krylov_dim + 1, viennacl::traits::context(rhs));
+      std::vector< vector_base<NumericT> > basis_vectors;
+      std::vector< vector_base<NumericT> const * > basis_vector_ptrs;
+      for (std::size_t j = 0; j <= krylov_dim; ++j)
+        basis_vectors.push_back(vector_base<NumericT>(krylov_basis.handle(), problem_size, j * krylov_basis.internal_size1(), 1));
+      for (std::size_t j = 0; j <= krylov_dim; ++j)
+        basis_vector_ptrs.push_back(&(basis_vectors[j]));
+
+      // projection coefficients of the current iteration (device and host) and Hessenberg matrix (column-wise, host):
+      VectorType projections = viennacl::zero_vector<NumericT>(krylov_dim + 1, viennacl::traits::context(rhs));
+      std::vector<NumericT> host_projections(krylov_dim + 1);
+      std::vector< std::vector<NumericT> > H(krylov_dim, std::vector<NumericT>(krylov_dim + 1));
+      std::vector<NumericT> givens_cos(krylov_dim);
+      std::vector<NumericT> givens_sin(krylov_dim);
+      std::vector<NumericT> projection_rhs(krylov_dim + 1);
+
+      NumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+
+      tag.iters(0);
+      tag.error(0);
+      if (norm_rhs == 0) //solution is zero if RHS norm is zero
+        return result;
+
+      for (unsigned int it = 0; it <= tag.max_restarts(); ++it)
+      {
+        //
+        // (Re-)Initialize residual: r = b - A*x (without temporary for the result of A*x)
+        //
+        res = rhs;
+        res -= viennacl::linalg::prod(matrix, result);
+        precond.apply(res);
+
+        NumericT rho_0 = viennacl::linalg::norm_2(res);
+
+        //
+        // Check for premature convergence
+        //
+        if (rho_0 / norm_rhs < tag.tolerance() ) // norm_rhs is known to be nonzero here
+        {
+          tag.error(rho_0 / norm_rhs);
+          return result;
+        }
+
+        basis_vectors[0] = res / rho_0;
+        std::fill(projection_rhs.begin(), projection_rhs.end(), NumericT(0));
+        projection_rhs[0] = rho_0;
+        NumericT rho = rho_0;
+
+        //
+        // Arnoldi process until maximal Krylov space dimension is reached:
+        //
+        std::size_t k = 0;
+        for (k = 0; k < krylov_dim; ++k)
+        {
+          tag.iters( tag.iters() + 1 ); //increase iteration counter
+
+          w = viennacl::linalg::prod(matrix, basis_vectors[k]);
+          precond.apply(w);
+
+          // h_{i,k} = <w, v_i> for i = 0, ..., k in a single pass over w:
+          vector_base<NumericT> h(projections.handle(), k + 1, 0, 1);
+          h = viennacl::linalg::inner_prod(w, viennacl::vector_tuple<NumericT>(std::vector< vector_base<NumericT> const * >(basis_vector_ptrs.begin(), basis_vector_ptrs.begin() + k + 1)));
+
+          // w -= V_k * h:
+          viennacl::matrix_range<KrylovBasisType> V_k(krylov_basis, viennacl::range(0, problem_size), viennacl::range(0, k + 1));
+          w -= viennacl::linalg::prod(V_k, h);
+
+          NumericT h_next = viennacl::linalg::norm_2(w);
+          viennacl::backend::memory_read(projections.handle(), 0, sizeof(NumericT) * (k + 1), &(host_projections[0]));
+
+          if (h_next > 0)
+            basis_vectors[k+1] = w / h_next;
+
+          //
+          // Update the QR factorization of the Hessenberg matrix with the previous Givens rotations and eliminate h_{k+1,k} by a new rotation:
+          //
+          for (std::size_t i = 0; i <= k; ++i)
+            H[k][i] = host_projections[i];
+          H[k][k+1] = h_next;
+
+          for (std::size_t i = 0; i < k; ++i)
+          {
+            NumericT tmp = givens_cos[i] * H[k][i] + givens_sin[i] * H[k][i+1];
+            H[k][i+1]    = givens_cos[i] * H[k][i+1] - givens_sin[i] * H[k][i];
+            H[k][i]      = tmp;
+          }
+
+          NumericT denominator = std::sqrt(H[k][k] * H[k][k] + h_next * h_next);
+          givens_cos[k] = (denominator > 0) ? H[k][k] / denominator : NumericT(1);
+          givens_sin[k] = (denominator > 0) ? h_next  / denominator : NumericT(0);
+          H[k][k]   = denominator;
+          H[k][k+1] = 0;
+
+          projection_rhs[k+1] = -givens_sin[k] * projection_rhs[k];
+          projection_rhs[k]   =  givens_cos[k] * projection_rhs[k];
+          rho = std::fabs(projection_rhs[k+1]);
+
+          if (rho / norm_rhs < tag.tolerance() || h_next <= 0)  // Residual is sufficiently reduced or Krylov space is invariant, stop here
+          {
+            ++k;
+            break;
+          }
+        } // for k
+
+        //
+        // Triangular solver stage (H is stored column-wise):
+        //
+        for (long i = static_cast<long>(k)-1; i > -1; --i)
+        {
+          for (std::size_t j = static_cast<std::size_t>(i)+1; j < k; ++j)
+            projection_rhs[i] -= H[j][i] * projection_rhs[j];
+
+          projection_rhs[i] /= H[i][i];
+        }
+
+        //
+        // x += V_k * y, where 'projection_rhs' now holds y:
+        //
+        if (k > 0)
+        {
+          vector_base<NumericT> y(projections.handle(), k, 0, 1);
+          viennacl::backend::memory_write(projections.handle(), 0, sizeof(NumericT) * k, &(projection_rhs[0]));
+
+          viennacl::matrix_range<KrylovBasisType> V_k(krylov_basis, viennacl::range(0, problem_size), viennacl::range(0, k));
+          result += viennacl::linalg::prod(V_k, y);
+        }
+
+        //
+        // Check for convergence:
+        //
+        tag.error(rho / norm_rhs);
+        if ( tag.error() < tag.tolerance() )
+          return result;
+      }
+
+      return result;
+    }
+
+    /** @brief Convenience overload of the solve() function using the pipelined GMRES method. Per default, no preconditioner is used
+    */
+    template <typename MatrixType, typename NumericT, unsigned int ALIGNMENT>
+    viennacl::vector<NumericT, ALIGNMENT> solve(MatrixType const & matrix, viennacl::vector<NumericT, ALIGNMENT> const & rhs, pipelined_gmres_tag const & tag)
+    {
+      return solve(matrix, rhs, tag, no_precond());
+    }
+
     /** @brief Convenience overload of the solve() function using GMRES. Per default, no preconditioner is used
     */
     template <typename MatrixType, typename VectorType>
@@ -24,6 +24,11 @@
 
 #include "viennacl/traits/handle.hpp"
 
+// Minimum vector size for using OpenMP on vector operations:
+#ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
+  #define VIENNACL_OPENMP_VECTOR_MIN_SIZE  5000
+#endif
+
 namespace viennacl
 {
   namespace linalg
@@ -0,0 +1,664 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_FFT_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_FFT_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file  viennacl/linalg/host_based/fft_operations.hpp
+    @brief Implementations of the Fast Fourier Transform using a plain single-threaded or OpenMP-enabled execution on CPU. Experimental.
+
+    Complex numbers are stored interleaved (real part followed by imaginary part), just like for the OpenCL backend.
+    Transform sizes with prime factors 2, 3, and 5 are computed by a self-sorting mixed-radix Stockham algorithm,
+    all other sizes are computed via Bluestein's algorithm. Twiddle factors are precomputed once per transform size and cached.
+*/
+
+#include <cmath>
+#include <complex>
+#include <map>
+#include <vector>
+#include <utility>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        namespace fft
+        {
+          /** @brief Complex multiplication without the overflow/NaN-handling of std::complex (which results in a library call for each multiplication) */
+          template <typename NumericT>
+          inline std::complex<NumericT> mul(std::complex<NumericT> const & a, std::complex<NumericT> const & b)
+          {
+            return std::complex<NumericT>(a.real() * b.real() - a.imag() * b.imag(),
+                                          a.real() * b.imag() + a.imag() * b.real());
+          }
+
+          /** @brief Returns sign * i * z */
+          template <typename NumericT>
+          inline std::complex<NumericT> rotate(std::complex<NumericT> const & z, NumericT sign)
+          {
+            return std::complex<NumericT>(-sign * z.imag(), sign * z.real());
+          }
+
+          /** @brief Computes the DFT of length R of the values in a[] in-place. */
+          template <typename NumericT, std::size_t R>
+          struct butterfly;
+
+          template <typename NumericT>
+          struct butterfly<NumericT, 2>
+          {
+            static void apply(std::complex<NumericT> * a, NumericT)
+            {
+              std::complex<NumericT> t = a[1];
+              a[1] = a[0] - t;
+              a[0] = a[0] + t;
+            }
+          };
+
+          template <typename NumericT>
+          struct butterfly<NumericT, 3>
+          {
+            static void apply(std::complex<NumericT> * a, NumericT sign)
+            {
+              NumericT const s60 = static_cast<NumericT>(0.86602540378443864676);
+              std::complex<NumericT> t1 = a[1] + a[2];
+              std::complex<NumericT> t2 = a[0] - NumericT(0.5) * t1;
+              std::complex<NumericT> t3 = rotate(s60 * (a[1] - a[2]), sign);
+              a[0] = a[0] + t1;
+              a[1] = t2 + t3;
+              a[2] = t2 - t3;
+            }
+          };
+
+          template <typename NumericT>
+          struct butterfly<NumericT, 4>
+          {
+            static void apply(std::complex<NumericT> * a, NumericT sign)
+            {
+              std::complex<NumericT> t0 = a[0] + a[2];
+              std::complex<NumericT> t1 = a[0] - a[2];
+              std::complex<NumericT> t2 = a[1] + a[3];
+              std::complex<NumericT> t3 = rotate(a[1] - a[3], sign);
+              a[0] = t0 + t2;
+              a[1] = t1 + t3;
+              a[2] = t0 - t2;
+              a[3] = t1 - t3;
+            }
+          };
+
+          template <typename NumericT>
+          struct butterfly<NumericT, 5>
+          {
+            static void apply(std::complex<NumericT> * a, NumericT sign)
+            {
+              NumericT const c1 = static_cast<NumericT>( 0.30901699437494742410);  // cos(2 pi / 5)
+              NumericT const c2 = static_cast<NumericT>(-0.80901699437494742410);  // cos(4 pi / 5)
+              NumericT const s1 = static_cast<NumericT>( 0.95105651629515357212);  // sin(2 pi / 5)
+              NumericT const s2 = static_cast<NumericT>( 0.58778525229247312917);  // sin(4 pi / 5)
+
+              std::complex<NumericT> t1 = a[1] + a[4];
+              std::complex<NumericT> t2 = a[2] + a[3];
+              std::complex<NumericT> t3 = a[1] - a[4];
+              std::complex<NumericT> t4 = a[2] - a[3];
+
+              std::complex<NumericT> r1 = a[0] + c1 * t1 + c2 * t2;
+              std::complex<NumericT> r2 = a[0] + c2 * t1 + c1 * t2;
+              std::complex<NumericT> i1 = rotate(s1 * t3 + s2 * t4, sign);
+              std::complex<NumericT> i2 = rotate(s2 * t3 - s1 * t4, sign);
+
+              a[0] = a[0] + t1 + t2;
+              a[1] = r1 + i1;
+              a[4] = r1 - i1;
+              a[2] = r2 + i2;
+              a[3] = r2 - i2;
+            }
+          };
+
+          /** @brief One pass of the self-sorting Stockham algorithm with radix R.
+          *
+          * Computes y[q + s*(R*p + u)] = w^(p*u) * sum_t x[q + s*(p + t*m)] * exp(sign * 2 pi i * t * u / R) for p < m, q < s and u < R.
+          */
+          template <std::size_t R, typename NumericT>
+          void stockham_pass(std::complex<NumericT> const * x, std::complex<NumericT> * y,
+                             std::size_t m, std::size_t s,
+                             std::complex<NumericT> const * twiddles,
+                             NumericT sign, bool parallel)
+          {
+            (void)parallel;
+            if (m >= s)
+            {
+#ifdef VIENNACL_WITH_OPENMP
+              #pragma omp parallel for if (parallel)
+#endif
+              for (std::size_t p = 0; p < m; ++p)
+              {
+                std::complex<NumericT> const * w = twiddles + p * (R - 1);
+                for (std::size_t q = 0; q < s; ++q)
+                {
+                  std::complex<NumericT> a[R];
+                  for (std::size_t t = 0; t < R; ++t)
+                    a[t] = x[q + s * (p + t * m)];
+                  butterfly<NumericT, R>::apply(a, sign);
+                  y[q + s * R * p] = a[0];
+                  for (std::size_t u = 1; u < R; ++u)
+                    y[q + s * (R * p + u)] = mul(a[u], w[u-1]);
+                }
+              }
+            }
+            else
+            {
+              for (std::size_t p = 0; p < m; ++p)
+              {
+                std::complex<NumericT> const * w = twiddles + p * (R - 1);
+#ifdef VIENNACL_WITH_OPENMP
+                #pragma omp parallel for if (parallel)
+#endif
+                for (std::size_t q = 0; q < s; ++q)
+                {
+                  std::complex<NumericT> a[R];
+                  for (std::size_t t = 0; t < R; ++t)
+                    a[t] = x[q + s * (p + t * m)];
+                  butterfly<NumericT, R>::apply(a, sign);
+                  y[q + s * R * p] = a[0];
+                  for (std::size_t u = 1; u < R; ++u)
+                    y[q + s * (R * p + u)] = mul(a[u], w[u-1]);
+                }
+              }
+            }
+          }
+
+
+          template <typename NumericT>
+          class plan;
+
+          /** @brief Returns the cached plan for the given transform size and sign of the exponent. Plans are created on first use.
+          *
+          * Note that the plan cache is not protected against concurrent first use of a transform size from several user threads.
+          */
+          template <typename NumericT>
+          plan<NumericT> const & get_plan(std::size_t size, NumericT sign, bool force_bluestein = false)
+          {
+            typedef std::pair<std::size_t, int>             key_type;
+            typedef std::map<key_type, plan<NumericT> >     cache_type;
+            static cache_type cache;
+
+            key_type key(size, (sign < 0 ? 0 : 1) + (force_bluestein ? 2 : 0));
+            typename cache_type::iterator it = cache.find(key);
+            if (it == cache.end())
+            {
+              plan<NumericT> new_plan(size, sign, force_bluestein);  //might create further plans for Bluestein's algorithm
+              it = cache.insert(std::make_pair(key, new_plan)).first;
+            }
+            return it->second;
+          }
+
+          /** @brief Precomputed factorization and twiddle factors for a transform of fixed size and sign of the exponent. */
+          template <typename NumericT>
+          class plan
+          {
+            public:
+              typedef std::complex<NumericT>    complex_type;
+
+              plan(std::size_t size, NumericT sign, bool force_bluestein = false)
+                : size_(size), sign_(sign < 0 ? NumericT(-1) : NumericT(1)), bluestein_size_(0), bluestein_fwd_(NULL), bluestein_inv_(NULL)
+              {
+                std::size_t remainder = size;
+                while (remainder % 4 == 0) { radices_.push_back(4); remainder /= 4; }
+                while (remainder % 2 == 0) { radices_.push_back(2); remainder /= 2; }
+                while (remainder % 3 == 0) { radices_.push_back(3); remainder /= 3; }
+                while (remainder % 5 == 0) { radices_.push_back(5); remainder /= 5; }
+
+                if (size > 1 && (remainder > 1 || force_bluestein))
+                  setup_bluestein();
+                else
+                  setup_stockham();
+              }
+
+              std::size_t size() const { return size_; }
+
+              /** @brief Number of complex values required for the work buffer passed to execute() */
+              std::size_t work_size() const { return bluestein_size_ > 0 ? 2 * bluestein_size_ : size_; }
+
+              /** @brief Transforms the 'size' complex values in data in-place. 'work' must provide work_size() entries. */
+              void execute(complex_type * data, complex_type * work, bool parallel) const
+              {
+                if (bluestein_size_ > 0)
+                  execute_bluestein(data, work, parallel);
+                else
+                  execute_stockham(data, work, parallel);
+              }
+
+            private:
+              void setup_stockham()
+              {
+                double const pi = 3.14159265358979323846;
+                std::size_t n = size_;
+                for (std::size_t i=0; i<radices_.size(); ++i)
+                {
+                  std::size_t r = radices_[i];
+                  std::size_t m = n / r;
+                  twiddle_offsets_.push_back(twiddles_.size());
+                  for (std::size_t p=0; p<m; ++p)
+                    for (std::size_t u=1; u<r; ++u)
+                    {
+                      double angle = sign_ * 2.0 * pi * static_cast<double>((p * u) % n) / static_cast<double>(n);
+                      twiddles_.push_back(complex_type(static_cast<NumericT>(std::cos(angle)), static_cast<NumericT>(std::sin(angle))));
+                    }
+                  n = m;
+                }
+              }
+
+              void execute_stockham(complex_type * data, complex_type * work, bool parallel) const
+              {
+                complex_type * x = data;
+                complex_type * y = work;
+                std::size_t n = size_;
+                std::size_t s = 1;
+                for (std::size_t i=0; i<radices_.size(); ++i)
+                {
+                  std::size_t r = radices_[i];
+                  std::size_t m = n / r;
+                  complex_type const * tw = &(twiddles_[0]) + twiddle_offsets_[i];
+                  switch (r)
+                  {
+                    case 2: stockham_pass<2>(x, y, m, s, tw, sign_, parallel); break;
+                    case 3: stockham_pass<3>(x, y, m, s, tw, sign_, parallel); break;
+                    case 4: stockham_pass<4>(x, y, m, s, tw, sign_, parallel); break;
+                    case 5: stockham_pass<5>(x, y, m, s, tw, sign_, parallel); break;
+                  }
+                  std::swap(x, y);
+                  n = m;
+                  s *= r;
+                }
+
+                if (x != data)
+                  for (std::size_t i=0; i<size_; ++i)
+                    data[i] = x[i];
+              }
+
+              // Bluestein: X_k = w_k * sum_j (x_j w_j) conj(w_{k-j}) with chirp w_k = exp(sign * pi * i * k^2 / n), evaluated as a cyclic convolution of length M >= 2n-1
+              void setup_bluestein()
+              {
+                double const pi = 3.14159265358979323846;
+
+                bluestein_size_ = 1;
+                while (bluestein_size_ < 2 * size_ - 1)
+                  bluestein_size_ *= 2;
+
+                chirp_.resize(size_);
+                std::size_t k_squared = 0;  // k^2 mod 2n, updated incrementally to avoid overflow
+                for (std::size_t k=0; k<size_; ++k)
+                {
+                  double angle = sign_ * pi * static_cast<double>(k_squared) / static_cast<double>(size_);
+                  chirp_[k] = complex_type(static_cast<NumericT>(std::cos(angle)), static_cast<NumericT>(std::sin(angle)));
+                  k_squared = (k_squared + 2 * k + 1) % (2 * size_);
+                }
+
+                bluestein_fwd_ = &get_plan<NumericT>(bluestein_size_, NumericT(-1));
+                bluestein_inv_ = &get_plan<NumericT>(bluestein_size_, NumericT(1));
+
+                // transformed convolution kernel, scaled by 1/M to account for the unnormalized inverse transform:
+                std::vector<complex_type> kernel(bluestein_size_);
+                std::vector<complex_type> work(bluestein_fwd_->work_size());
+                NumericT scale = NumericT(1) / static_cast<NumericT>(bluestein_size_);
+                kernel[0] = std::conj(chirp_[0]) * scale;
+                for (std::size_t k=1; k<size_; ++k)
+                {
+                  kernel[k]                   = std::conj(chirp_[k]) * scale;
+                  kernel[bluestein_size_ - k] = std::conj(chirp_[k]) * scale;
+                }
+                bluestein_fwd_->execute(&(kernel[0]), &(work[0]), false);
+                bluestein_kernel_.swap(kernel);
+              }
+
+              void execute_bluestein(complex_type * data, complex_type * work, bool parallel) const
+              {
+                complex_type * a     = work;
+                complex_type * inner = work + bluestein_size_;
+
+                for (std::size_t k=0; k<size_; ++k)
+                  a[k] = mul(data[k], chirp_[k]);
+                for (std::size_t k=size_; k<bluestein_size_; ++k)
+                  a[k] = 0;
+
+                bluestein_fwd_->execute(a, inner, parallel);
+                for (std::size_t k=0; k<bluestein_size_; ++k)
+                  a[k] = mul(a[k], bluestein_kernel_[k]);
+                bluestein_inv_->execute(a, inner, parallel);
+
+                for (std::size_t k=0; k<size_; ++k)
+                  data[k] = mul(a[k], chirp_[k]);
+              }
+
+              std::size_t                  size_;
+              NumericT                     sign_;
+              std::vector<std::size_t>     radices_;
+              std::vector<std::size_t>     twiddle_offsets_;
+              std::vector<complex_type>    twiddles_;
+
+              std::size_t                  bluestein_size_;
+              std::vector<complex_type>    chirp_;
+              std::vector<complex_type>    bluestein_kernel_;
+              plan const *                 bluestein_fwd_;
+              plan const *                 bluestein_inv_;
+          };
+
+
+          /** @brief Describes the location of a batch of complex sequences in memory. All offsets are in units of NumericT.
+          *
+          * Real part of entry k in batch b: start + b * batch_stride + k * elem_stride; the imaginary part follows at offset imag_offset.
+          */
+          struct layout
+          {
+            layout(std::size_t start, std::size_t elem_stride, std::size_t batch_stride, std::size_t imag_offset)
+              : start_(start), elem_stride_(elem_stride), batch_stride_(batch_stride), imag_offset_(imag_offset) {}
+
+            std::size_t index(std::size_t b, std::size_t k) const { return start_ + b * batch_stride_ + k * elem_stride_; }
+
+            std::size_t start_;
+            std::size_t elem_stride_;
+            std::size_t batch_stride_;
+            std::size_t imag_offset_;
+          };
+
+          /** @brief Computes batch_num transforms of length size. Input and output may refer to the same memory. */
+          template <typename NumericT>
+          void transform(NumericT const * in, layout const & in_layout,
+                         NumericT * out, layout const & out_layout,
+                         std::size_t size, std::size_t batch_num, NumericT sign, bool force_bluestein = false)
+          {
+            typedef std::complex<NumericT>   complex_type;
+
+            if (size == 0 || batch_num == 0)
+              return;
+
+            plan<NumericT> const & p = get_plan(size, sign, force_bluestein);
+            bool parallel_batches = (batch_num > 1);
+
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp parallel if (parallel_batches)
+#endif
+            {
+              std::vector<complex_type> data(size);
+              std::vector<complex_type> work(p.work_size());
+
+#ifdef VIENNACL_WITH_OPENMP
+              #pragma omp for
+#endif
+              for (std::size_t b = 0; b < batch_num; ++b)
+              {
+                for (std::size_t k=0; k<size; ++k)
+                {
+                  std::size_t idx = in_layout.index(b, k);
+                  data[k] = complex_type(in[idx], in[idx + in_layout.imag_offset_]);
+                }
+
+                p.execute(&(data[0]), &(work[0]), !parallel_batches);
+
+                for (std::size_t k=0; k<size; ++k)
+                {
+                  std::size_t idx = out_layout.index(b, k);
+                  out[idx]                          = data[k].real();
+                  out[idx + out_layout.imag_offset_] = data[k].imag();
+                }
+              }
+            }
+          }
+
+          template <typename NumericT>
+          layout vector_layout(viennacl::vector_base<NumericT> const & vec, std::size_t size)
+          {
+            std::size_t inc = viennacl::traits::stride(vec);
+            return layout(viennacl::traits::start(vec), 2 * inc, 2 * inc * size, inc);
+          }
+
+          /** @brief Layout of the rows (row_wise == true) or columns of a row-major matrix holding complex values interleaved along each row. */
+          template <typename NumericT>
+          layout matrix_layout(viennacl::matrix_base<NumericT, viennacl::row_major> const & mat, bool row_wise)
+          {
+            std::size_t start = viennacl::traits::start1(mat) * viennacl::traits::internal_size2(mat) + viennacl::traits::start2(mat);
+            std::size_t row_stride = viennacl::traits::stride1(mat) * viennacl::traits::internal_size2(mat);
+            std::size_t col_stride = 2 * viennacl::traits::stride2(mat);
+            if (row_wise)
+              return layout(start, col_stride, row_stride, viennacl::traits::stride2(mat));
+            return layout(start, row_stride, col_stride, viennacl::traits::stride2(mat));
+          }
+
+        } //namespace fft
+      } //namespace detail
+
+
+      /** @brief Computes batch_num 1-D Fourier transforms of length size, where the complex values are stored interleaved and the transforms are stored consecutively.
+      *
+      * @param input       Input vector
+      * @param output      Output vector, may be the same as input
+      * @param size        Length of each transform
+      * @param batch_num   Number of transforms
+      * @param sign        Sign of the exponent (-1 for the forward transform, 1 for the unnormalized inverse transform)
+      * @param force_bluestein  Use Bluestein's algorithm even if the size has only the prime factors 2, 3, and 5
+      */
+      template <typename NumericT>
+      void fft(viennacl::vector_base<NumericT> const & input,
+               viennacl::vector_base<NumericT> & output,
+               std::size_t size, std::size_t batch_num, NumericT sign,
+               bool force_bluestein = false)
+      {
+        NumericT const * data_in  = detail::extract_raw_pointer<NumericT>(input);
+        NumericT       * data_out = detail::extract_raw_pointer<NumericT>(output);
+
+        detail::fft::transform(data_in,  detail::fft::vector_layout(input, size),
+                               data_out, detail::fft::vector_layout(output, size),
+                               size, batch_num, sign, force_bluestein);
+      }
+
+      /** @brief Computes the 2-D Fourier transform of a row-major matrix holding complex values interleaved along each row.
+      *
+      * The rows are transformed first (batched), then the columns (batched).
+      *
+      * @param input       Input matrix
+      * @param output      Output matrix, may be the same as input
+      * @param sign        Sign of the exponent
+      */
+      template <typename NumericT>
+      void fft(viennacl::matrix_base<NumericT, viennacl::row_major> const & input,
+               viennacl::matrix_base<NumericT, viennacl::row_major> & output,
+               NumericT sign)
+      {
+        NumericT const * data_in  = detail::extract_raw_pointer<NumericT>(input);
+        NumericT       * data_out = detail::extract_raw_pointer<NumericT>(output);
+
+        std::size_t rows_num = viennacl::traits::size1(input);
+        std::size_t cols_num = viennacl::traits::size2(input) / 2;
+
+        // batch with rows
+        detail::fft::transform(data_in,  detail::fft::matrix_layout(input, true),
+                               data_out, detail::fft::matrix_layout(output, true),
+                               cols_num, rows_num, sign);
+
+        // batch with cols
+        detail::fft::transform(data_out, detail::fft::matrix_layout(output, false),
+                               data_out, detail::fft::matrix_layout(output, false),
+                               rows_num, cols_num, sign);
+      }
+
+      /** @brief Element-wise multiplication of two complex vectors stored interleaved */
+      template <typename NumericT>
+      void fft_multiply(viennacl::vector_base<NumericT> const & input1,
+                        viennacl::vector_base<NumericT> const & input2,
+                        viennacl::vector_base<NumericT> & output)
+      {
+        NumericT const * data_in1 = detail::extract_raw_pointer<NumericT>(input1);
+        NumericT const * data_in2 = detail::extract_raw_pointer<NumericT>(input2);
+        NumericT       * data_out = detail::extract_raw_pointer<NumericT>(output);
+
+        std::size_t start1 = viennacl::traits::start(input1);
+        std::size_t inc1   = viennacl::traits::stride(input1);
+        std::size_t start2 = viennacl::traits::start(input2);
+        std::size_t inc2   = viennacl::traits::stride(input2);
+        std::size_t start3 = viennacl::traits::start(output);
+        std::size_t inc3   = viennacl::traits::stride(output);
+
+        std::size_t size = viennacl::traits::size(input1) / 2;
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (std::size_t i = 0; i < size; ++i)
+        {
+          NumericT re1 = data_in1[start1 + 2 * i * inc1];
+          NumericT im1 = data_in1[start1 + (2 * i + 1) * inc1];
+          NumericT re2 = data_in2[start2 + 2 * i * inc2];
+          NumericT im2 = data_in2[start2 + (2 * i + 1) * inc2];
+          data_out[start3 + 2 * i * inc3]       = re1 * re2 - im1 * im2;
+          data_out[start3 + (2 * i + 1) * inc3] = re1 * im2 + im1 * re2;
+        }
+      }
+
+      /** @brief Divides the complex vector by its length (normalization of the inverse transform) */
+      template <typename NumericT>
+      void fft_normalize(viennacl::vector_base<NumericT> & input)
+      {
+        NumericT * data = detail::extract_raw_pointer<NumericT>(input);
+        std::size_t start = viennacl::traits::start(input);
+        std::size_t inc   = viennacl::traits::stride(input);
+        std::size_t size  = viennacl::traits::size(input);
+
+        NumericT norm_factor = static_cast<NumericT>(size / 2);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (std::size_t i = 0; i < size; ++i)
+          data[start + i * inc] /= norm_factor;
+      }
+
+      /** @brief Transposes the complex matrix (interleaved storage, including padding) */
+      template <typename NumericT>
+      void fft_transpose(viennacl::matrix_base<NumericT, viennacl::row_major> const & input,
+                         viennacl::matrix_base<NumericT, viennacl::row_major> & output)
+      {
+        NumericT const * data_in  = detail::extract_raw_pointer<NumericT>(input);
+        NumericT       * data_out = detail::extract_raw_pointer<NumericT>(output);
+
+        std::size_t row_num = viennacl::traits::internal_size1(input);
+        std::size_t col_num = viennacl::traits::internal_size2(input) / 2;
+
+        std::vector<NumericT> temp;
+        if (data_in == data_out)  //in-place
+        {
+          temp.assign(data_in, data_in + 2 * row_num * col_num);
+          data_in = &(temp[0]);
+        }
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (std::size_t row = 0; row < row_num; ++row)
+        {
+          for (std::size_t col = 0; col < col_num; ++col)
+          {
+            std::size_t new_pos = col * row_num + row;
+            data_out[2 * new_pos]     = data_in[2 * (row * col_num + col)];
+            data_out[2 * new_pos + 1] = data_in[2 * (row * col_num + col) + 1];
+          }
+        }
+      }
+
+      /** @brief Writes the first size real values of in to the real parts of out, imaginary parts are set to zero */
+      template <typename NumericT>
+      void real_to_complex(viennacl::vector_base<NumericT> const & in,
+                           viennacl::vector_base<NumericT> & out,
+                           std::size_t size)
+      {
+        NumericT const * data_in  = detail::extract_raw_pointer<NumericT>(in);
+        NumericT       * data_out = detail::extract_raw_pointer<NumericT>(out);
+
+        std::size_t start1 = viennacl::traits::start(in);
+        std::size_t inc1   = viennacl::traits::stride(in);
+        std::size_t start2 = viennacl::traits::start(out);
+        std::size_t inc2   = viennacl::traits::stride(out);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (std::size_t i = 0; i < size; ++i)
+        {
+          data_out[start2 + 2 * i * inc2]       = data_in[start1 + i * inc1];
+          data_out[start2 + (2 * i + 1) * inc2] = 0;
+        }
+      }
+
+      /** @brief Extracts the real parts of the first size complex values of in */
+      template <typename NumericT>
+      void complex_to_real(viennacl::vector_base<NumericT> const & in,
+                           viennacl::vector_base<NumericT> & out,
+                           std::size_t size)
+      {
+        NumericT const * data_in  = detail::extract_raw_pointer<NumericT>(in);
+        NumericT       * data_out = detail::extract_raw_pointer<NumericT>(out);
+
+        std::size_t start1 = viennacl::traits::start(in);
+        std::size_t inc1   = viennacl::traits::stride(in);
+        std::size_t start2 = viennacl::traits::start(out);
+        std::size_t inc2   = viennacl::traits::stride(out);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (std::size_t i = 0; i < size; ++i)
+        {
+          data_out[start2 + i * inc2] = data_in[start1 + 2 * i * inc1];
+        }
+      }
+
+      /** @brief Reverses the order of the (real) entries of the vector */
+      template <typename NumericT>
+      void reverse(viennacl::vector_base<NumericT> & in)
+      {
+        NumericT * data = detail::extract_raw_pointer<NumericT>(in);
+        std::size_t start = viennacl::traits::start(in);
+        std::size_t inc   = viennacl::traits::stride(in);
+        std::size_t size  = viennacl::traits::size(in);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (std::size_t i = 0; i < size / 2; ++i)
+        {
+          NumericT val1 = data[start + i * inc];
+          NumericT val2 = data[start + (size - i - 1) * inc];
+          data[start + i * inc]              = val2;
+          data[start + (size - i - 1) * inc] = val1;
+        }
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
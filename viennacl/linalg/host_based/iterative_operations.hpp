@@ -0,0 +1,417 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_ITERATIVE_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_ITERATIVE_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/iterative_operations.hpp
+    @brief Implementations of the fused operations of the pipelined iterative solvers on the CPU using a single thread or OpenMP.
+
+    Each of the chunks of the inner product buffer holds one partial result per block of the vectors (or rows of the matrix).
+    The blocks are fixed, so that the results do not depend on the number of threads.
+*/
+
+#include <vector>
+#include <algorithm>
+#include "viennacl/forwards.h"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Returns the first index of the i-th of 'num_blocks' blocks of about the same size covering 0, ..., size-1 */
+        inline std::size_t pipelined_block_start(std::size_t i, std::size_t num_blocks, std::size_t size)
+        {
+          return (size / num_blocks) * i + std::min(i, size % num_blocks);
+        }
+      }
+
+      /** @brief Performs the fused vector update of the pipelined CG method: x += alpha * p, r -= alpha * Ap, p = r + beta * p.
+      *
+      * The partial results of <r, r> for the updated r are written to the first chunk of 'inner_prod_buffer'.
+      */
+      template <typename T>
+      void pipelined_cg_vector_update(vector_base<T> & result,
+                                      T alpha,
+                                      vector_base<T> & p,
+                                      vector_base<T> & r,
+                                      vector_base<T> const & Ap,
+                                      T beta,
+                                      vector_base<T> & inner_prod_buffer)
+      {
+        T       * data_result = detail::extract_raw_pointer<T>(result);
+        T       * data_p      = detail::extract_raw_pointer<T>(p);
+        T       * data_r      = detail::extract_raw_pointer<T>(r);
+        T const * data_Ap     = detail::extract_raw_pointer<T>(Ap);
+        T       * data_buffer = detail::extract_raw_pointer<T>(inner_prod_buffer);
+
+        std::size_t size       = viennacl::traits::size(result);
+        long        num_blocks = static_cast<long>(viennacl::traits::size(inner_prod_buffer) / 3);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long block = 0; block < num_blocks; ++block)
+        {
+          std::size_t block_end = detail::pipelined_block_start(block + 1, num_blocks, size);
+          T inner_prod_rr = 0;
+          for (std::size_t i = detail::pipelined_block_start(block, num_blocks, size); i < block_end; ++i)
+          {
+            T value_p = data_p[i];
+            T value_r = data_r[i] - alpha * data_Ap[i];
+
+            data_result[i] += alpha * value_p;
+            data_r[i] = value_r;
+            data_p[i] = value_r + beta * value_p;
+
+            inner_prod_rr += value_r * value_r;
+          }
+          data_buffer[block] = inner_prod_rr;
+        }
+      }
+
+      /** @brief Computes Ap = prod(A, p) for a compressed_matrix and writes the partial results of <Ap, Ap> and <p, Ap> to the second and third chunk of 'inner_prod_buffer'
+      *
+      * The inner products are accumulated row by row while the respective entry of Ap is still in registers.
+      */
+      template <typename T, unsigned int ALIGNMENT>
+      void pipelined_cg_prod(compressed_matrix<T, ALIGNMENT> const & A,
+                             vector_base<T> const & p,
+                             vector_base<T> & Ap,
+                             vector_base<T> & inner_prod_buffer)
+      {
+        T            const * elements    = detail::extract_raw_pointer<T>(A.handle());
+        unsigned int const * row_buffer  = detail::extract_raw_pointer<unsigned int>(A.handle1());
+        unsigned int const * col_buffer  = detail::extract_raw_pointer<unsigned int>(A.handle2());
+        T            const * data_p      = detail::extract_raw_pointer<T>(p);
+        T                  * data_Ap     = detail::extract_raw_pointer<T>(Ap);
+        T                  * data_buffer = detail::extract_raw_pointer<T>(inner_prod_buffer);
+
+        std::size_t size       = A.size1();
+        long        num_blocks = static_cast<long>(viennacl::traits::size(inner_prod_buffer) / 3);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (A.nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long block = 0; block < num_blocks; ++block)
+        {
+          std::size_t block_end = detail::pipelined_block_start(block + 1, num_blocks, size);
+          T inner_prod_ApAp = 0;
+          T inner_prod_pAp  = 0;
+          for (std::size_t row = detail::pipelined_block_start(block, num_blocks, size); row < block_end; ++row)
+          {
+            std::size_t row_start = row_buffer[row];
+            T value_Ap = detail::csr_row_dot(elements + row_start, col_buffer + row_start, row_buffer[row+1] - row_start, data_p);
+
+            data_Ap[row] = value_Ap;
+            inner_prod_ApAp += value_Ap * value_Ap;
+            inner_prod_pAp  += data_p[row] * value_Ap;
+          }
+          data_buffer[    num_blocks + block] = inner_prod_ApAp;
+          data_buffer[2 * num_blocks + block] = inner_prod_pAp;
+        }
+      }
+
+      /** @brief Writes the partial results of <Ap, Ap> and <p, Ap> to the second and third chunk of 'inner_prod_buffer' using a single pass over p and Ap */
+      template <typename T>
+      void pipelined_cg_inner_prods(vector_base<T> const & p,
+                                    vector_base<T> const & Ap,
+                                    vector_base<T> & inner_prod_buffer)
+      {
+        T const * data_p      = detail::extract_raw_pointer<T>(p);
+        T const * data_Ap     = detail::extract_raw_pointer<T>(Ap);
+        T       * data_buffer = detail::extract_raw_pointer<T>(inner_prod_buffer);
+
+        std::size_t size       = viennacl::traits::size(p);
+        long        num_blocks = static_cast<long>(viennacl::traits::size(inner_prod_buffer) / 3);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long block = 0; block < num_blocks; ++block)
+        {
+          std::size_t block_end = detail::pipelined_block_start(block + 1, num_blocks, size);
+          T inner_prod_ApAp = 0;
+          T inner_prod_pAp  = 0;
+          for (std::size_t i = detail::pipelined_block_start(block, num_blocks, size); i < block_end; ++i)
+          {
+            T value_Ap = data_Ap[i];
+            inner_prod_ApAp += value_Ap * value_Ap;
+            inner_prod_pAp  += data_p[i] * value_Ap;
+          }
+          data_buffer[    num_blocks + block] = inner_prod_ApAp;
+          data_buffer[2 * num_blocks + block] = inner_prod_pAp;
+        }
+      }
+
+      /** @brief Performs the fused vector update of the pipelined BiCGStab method: result += alpha * p + omega * s, residual = s - omega * As, p = residual + beta * (p - omega * Ap).
+      *
+      * The partial results of <residual, residual> and <residual, r0star> are written to the first and the second chunk of 'inner_prod_buffer'.
+      */
+      template <typename T>
+      void pipelined_bicgstab_vector_update(vector_base<T> & result, T alpha, vector_base<T> & p, T omega, vector_base<T> const & s,
+                                            vector_base<T> & residual, vector_base<T> const & As,
+                                            T beta, vector_base<T> const & Ap,
+                                            vector_base<T> const & r0star,
+                                            vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size)
+      {
+        T       * data_result   = detail::extract_raw_pointer<T>(result);
+        T       * data_p        = detail::extract_raw_pointer<T>(p);
+        T const * data_s        = detail::extract_raw_pointer<T>(s);
+        T       * data_residual = detail::extract_raw_pointer<T>(residual);
+        T const * data_As       = detail::extract_raw_pointer<T>(As);
+        T const * data_Ap       = detail::extract_raw_pointer<T>(Ap);
+        T const * data_r0star   = detail::extract_raw_pointer<T>(r0star);
+        T       * data_buffer   = detail::extract_raw_pointer<T>(inner_prod_buffer);
+
+        std::size_t size       = viennacl::traits::size(result);
+        long        num_blocks = static_cast<long>(buffer_chunk_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long block = 0; block < num_blocks; ++block)
+        {
+          std::size_t block_end = detail::pipelined_block_start(block + 1, num_blocks, size);
+          T inner_prod_rr      = 0;
+          T inner_prod_rr0star = 0;
+          for (std::size_t i = detail::pipelined_block_start(block, num_blocks, size); i < block_end; ++i)
+          {
+            T value_p = data_p[i];
+            T value_s = data_s[i];
+            T value_r = value_s - omega * data_As[i];
+
+            data_result[i]  += alpha * value_p + omega * value_s;
+            data_residual[i] = value_r;
+            data_p[i]        = value_r + beta * (value_p - omega * data_Ap[i]);
+
+            inner_prod_rr      += value_r * value_r;
+            inner_prod_rr0star += value_r * data_r0star[i];
+          }
+          data_buffer[             block] = inner_prod_rr;
+          data_buffer[num_blocks + block] = inner_prod_rr0star;
+        }
+      }
+
+      /** @brief Computes y = prod(A, x) for a compressed_matrix and writes the partial results of <y, y>, <x, y>, <r0star, y>, and <x, x> to the chunks 'buffer_chunk_offset', ..., 'buffer_chunk_offset' + 3 of 'inner_prod_buffer' */
+      template <typename T, unsigned int ALIGNMENT>
+      void pipelined_bicgstab_prod(compressed_matrix<T, ALIGNMENT> const & A,
+                                   vector_base<T> const & x,
+                                   vector_base<T> & y,
+                                   vector_base<T> const & r0star,
+                                   vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size, std::size_t buffer_chunk_offset)
+      {
+        T            const * elements    = detail::extract_raw_pointer<T>(A.handle());
+        unsigned int const * row_buffer  = detail::extract_raw_pointer<unsigned int>(A.handle1());
+        unsigned int const * col_buffer  = detail::extract_raw_pointer<unsigned int>(A.handle2());
+        T            const * data_x      = detail::extract_raw_pointer<T>(x);
+        T                  * data_y      = detail::extract_raw_pointer<T>(y);
+        T            const * data_r0star = detail::extract_raw_pointer<T>(r0star);
+        T                  * data_buffer = detail::extract_raw_pointer<T>(inner_prod_buffer) + buffer_chunk_size * buffer_chunk_offset;
+
+        std::size_t size       = A.size1();
+        long        num_blocks = static_cast<long>(buffer_chunk_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (A.nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long block = 0; block < num_blocks; ++block)
+        {
+          std::size_t block_end = detail::pipelined_block_start(block + 1, num_blocks, size);
+          T inner_prod_yy      = 0;
+          T inner_prod_xy      = 0;
+          T inner_prod_r0stary = 0;
+          T inner_prod_xx      = 0;
+          for (std::size_t row = detail::pipelined_block_start(block, num_blocks, size); row < block_end; ++row)
+          {
+            std::size_t row_start = row_buffer[row];
+            T value_y = detail::csr_row_dot(elements + row_start, col_buffer + row_start, row_buffer[row+1] - row_start, data_x);
+            T value_x = data_x[row];
+
+            data_y[row] = value_y;
+            inner_prod_yy      += value_y * value_y;
+            inner_prod_xy      += value_x * value_y;
+            inner_prod_r0stary += data_r0star[row] * value_y;
+            inner_prod_xx      += value_x * value_x;
+          }
+          data_buffer[                 block] = inner_prod_yy;
+          data_buffer[    num_blocks + block] = inner_prod_xy;
+          data_buffer[2 * num_blocks + block] = inner_prod_r0stary;
+          data_buffer[3 * num_blocks + block] = inner_prod_xx;
+        }
+      }
+
+      /** @brief Writes the partial results of <y, y>, <x, y>, <r0star, y>, and <x, x> to the chunks 'buffer_chunk_offset', ..., 'buffer_chunk_offset' + 3 of 'inner_prod_buffer' using a single pass over x, y, and r0star */
+      template <typename T>
+      void pipelined_bicgstab_inner_prods(vector_base<T> const & x,
+                                          vector_base<T> const & y,
+                                          vector_base<T> const & r0star,
+                                          vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size, std::size_t buffer_chunk_offset)
+      {
+        T const * data_x      = detail::extract_raw_pointer<T>(x);
+        T const * data_y      = detail::extract_raw_pointer<T>(y);
+        T const * data_r0star = detail::extract_raw_pointer<T>(r0star);
+        T       * data_buffer = detail::extract_raw_pointer<T>(inner_prod_buffer) + buffer_chunk_size * buffer_chunk_offset;
+
+        std::size_t size       = viennacl::traits::size(x);
+        long        num_blocks = static_cast<long>(buffer_chunk_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long block = 0; block < num_blocks; ++block)
+        {
+          std::size_t block_end = detail::pipelined_block_start(block + 1, num_blocks, size);
+          T inner_prod_yy      = 0;
+          T inner_prod_xy      = 0;
+          T inner_prod_r0stary = 0;
+          T inner_prod_xx      = 0;
+          for (std::size_t i = detail::pipelined_block_start(block, num_blocks, size); i < block_end; ++i)
+          {
+            T value_y = data_y[i];
+            T value_x = data_x[i];
+
+            inner_prod_yy      += value_y * value_y;
+            inner_prod_xy      += value_x * value_y;
+            inner_prod_r0stary += data_r0star[i] * value_y;
+            inner_prod_xx      += value_x * value_x;
+          }
+          data_buffer[                 block] = inner_prod_yy;
+          data_buffer[    num_blocks + block] = inner_prod_xy;
+          data_buffer[2 * num_blocks + block] = inner_prod_r0stary;
+          data_buffer[3 * num_blocks + block] = inner_prod_xx;
+        }
+      }
+
+      /** @brief Writes the partial results of the inner products <A_j, B_j> of the columns of A and B to the j-th chunk of 'inner_prod_buffer' */
+      template <typename T>
+      void block_cg_inner_prods(matrix_base<T, viennacl::row_major> const & A,
+                                matrix_base<T, viennacl::row_major> const & B,
+                                vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size)
+      {
+        T const * data_A      = detail::extract_raw_pointer<T>(A);
+        T const * data_B      = detail::extract_raw_pointer<T>(B);
+        T       * data_buffer = detail::extract_raw_pointer<T>(inner_prod_buffer);
+
+        std::size_t size1          = A.size1();
+        std::size_t num_columns    = A.size2();
+        std::size_t internal_size2 = A.internal_size2();
+        long        num_blocks     = static_cast<long>(buffer_chunk_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (size1 * num_columns > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long block = 0; block < num_blocks; ++block)
+        {
+          std::vector<T> inner_prods(num_columns);
+          std::size_t block_end = detail::pipelined_block_start(block + 1, num_blocks, size1);
+          for (std::size_t row = detail::pipelined_block_start(block, num_blocks, size1); row < block_end; ++row)
+          {
+            T const * row_A = data_A + row * internal_size2;
+            T const * row_B = data_B + row * internal_size2;
+            for (std::size_t j = 0; j < num_columns; ++j)
+              inner_prods[j] += row_A[j] * row_B[j];
+          }
+          for (std::size_t j = 0; j < num_columns; ++j)
+            data_buffer[j * num_blocks + block] = inner_prods[j];
+        }
+      }
+
+      /** @brief Performs the update X_j += alpha_j * P_j, R_j -= alpha_j * AP_j for all columns j and writes the partial results of <R_j, R_j> to the j-th chunk of 'inner_prod_buffer' */
+      template <typename T>
+      void block_cg_vector_update(matrix_base<T, viennacl::row_major> & X,
+                                  vector_base<T> const & alphas,
+                                  matrix_base<T, viennacl::row_major> const & P,
+                                  matrix_base<T, viennacl::row_major> & R,
+                                  matrix_base<T, viennacl::row_major> const & AP,
+                                  vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size)
+      {
+        T       * data_X      = detail::extract_raw_pointer<T>(X);
+        T const * data_alphas = detail::extract_raw_pointer<T>(alphas);
+        T const * data_P      = detail::extract_raw_pointer<T>(P);
+        T       * data_R      = detail::extract_raw_pointer<T>(R);
+        T const * data_AP     = detail::extract_raw_pointer<T>(AP);
+        T       * data_buffer = detail::extract_raw_pointer<T>(inner_prod_buffer);
+
+        std::size_t size1          = X.size1();
+        std::size_t num_columns    = X.size2();
+        std::size_t internal_size2 = X.internal_size2();
+        long        num_blocks     = static_cast<long>(buffer_chunk_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (size1 * num_columns > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long block = 0; block < num_blocks; ++block)
+        {
+          std::vector<T> inner_prods(num_columns);
+          std::size_t block_end = detail::pipelined_block_start(block + 1, num_blocks, size1);
+          for (std::size_t row = detail::pipelined_block_start(block, num_blocks, size1); row < block_end; ++row)
+          {
+            std::size_t offset = row * internal_size2;
+            for (std::size_t j = 0; j < num_columns; ++j)
+            {
+              T value_R = data_R[offset + j] - data_alphas[j] * data_AP[offset + j];
+
+              data_X[offset + j] += data_alphas[j] * data_P[offset + j];
+              data_R[offset + j]  = value_R;
+
+              inner_prods[j] += value_R * value_R;
+            }
+          }
+          for (std::size_t j = 0; j < num_columns; ++j)
+            data_buffer[j * num_blocks + block] = inner_prods[j];
+        }
+      }
+
+      /** @brief Performs the update P_j = R_j + beta_j * P_j for all columns j */
+      template <typename T>
+      void block_cg_direction_update(matrix_base<T, viennacl::row_major> & P,
+                                     matrix_base<T, viennacl::row_major> const & R,
+                                     vector_base<T> const & betas)
+      {
+        T       * data_P     = detail::extract_raw_pointer<T>(P);
+        T const * data_R     = detail::extract_raw_pointer<T>(R);
+        T const * data_betas = detail::extract_raw_pointer<T>(betas);
+
+        std::size_t num_columns    = P.size2();
+        std::size_t internal_size2 = P.internal_size2();
+        long        size1          = static_cast<long>(P.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (P.size1() * num_columns > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long row = 0; row < size1; ++row)
+        {
+          std::size_t offset = static_cast<std::size_t>(row) * internal_size2;
+          for (std::size_t j = 0; j < num_columns; ++j)
+            data_P[offset + j] = data_R[offset + j] + data_betas[j] * data_P[offset + j];
+        }
+      }
+
+    } // namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
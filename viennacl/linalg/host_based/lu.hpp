@@ -0,0 +1,293 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_LU_HPP_
+#define VIENNACL_LINALG_HOST_BASED_LU_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/lu.hpp
+    @brief Implementations of the blocked LU factorization (optionally with partial pivoting) for dense matrices on the CPU using a single thread or OpenMP.
+
+    The factorization is right-looking: Each panel of block_size columns is factored recursively (splitting the panel into halves,
+    such that most of the work is carried out by matrix-matrix products), the row interchanges are applied to the remaining columns,
+    and the trailing submatrix is updated with the multithreaded matrix-matrix product of the host backend.
+*/
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Blocking parameters of the LU factorization */
+        struct lu_blocking
+        {
+          static const std::size_t block_size = 256;  // width of the panels factored before each update of the trailing submatrix
+          static const std::size_t panel_base = 8;    // panels up to this width are factored column by column
+          static const std::size_t trsm_base  = 16;   // triangular solves up to this size are not split further
+          static const std::size_t swap_chunk = 64;   // number of columns handled by a thread when applying row interchanges
+        };
+
+        /** @brief Dense matrix (or submatrix) in host memory, from which accessors for the matrix-matrix product kernels of submatrices are derived */
+        template <typename NumericT, typename F>
+        class lu_matrix_view
+        {
+          public:
+            typedef matrix_array_wrapper<NumericT, typename F::orientation_category, false>   wrapper_type;
+
+            lu_matrix_view(NumericT * data,
+                           std::size_t start1, std::size_t start2,
+                           std::size_t inc1,   std::size_t inc2,
+                           std::size_t internal_size1, std::size_t internal_size2)
+             : data_(data),
+               start1_(start1), start2_(start2),
+               inc1_(inc1), inc2_(inc2),
+               internal_size1_(internal_size1), internal_size2_(internal_size2) {}
+
+            NumericT & operator()(std::size_t i, std::size_t j)
+            {
+              return data_[F::mem_index(i * inc1_ + start1_, j * inc2_ + start2_, internal_size1_, internal_size2_)];
+            }
+
+            /** @brief Returns an accessor for the submatrix starting at entry (row, col) */
+            wrapper_type block(std::size_t row, std::size_t col) const
+            {
+              return wrapper_type(data_, start1_ + row * inc1_, start2_ + col * inc2_, inc1_, inc2_, internal_size1_, internal_size2_);
+            }
+
+          private:
+            NumericT * data_;
+            std::size_t start1_, start2_;
+            std::size_t inc1_, inc2_;
+            std::size_t internal_size1_, internal_size2_;
+        };
+
+        /** @brief Interchanges rows k and pivots[k] for k = k_begin, ..., k_end-1 in the columns [col_begin, col_end) */
+        template <typename NumericT, typename F>
+        void lu_swap_rows(lu_matrix_view<NumericT, F> & A, std::vector<std::size_t> const & pivots,
+                          std::size_t k_begin, std::size_t k_end,
+                          std::size_t col_begin, std::size_t col_end)
+        {
+          if (col_begin >= col_end)
+            return;
+
+          std::size_t chunk_num = (col_end - col_begin - 1) / lu_blocking::swap_chunk + 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (chunk_num > 1)
+#endif
+          for (std::size_t chunk = 0; chunk < chunk_num; ++chunk)
+          {
+            std::size_t j_begin = col_begin + chunk * lu_blocking::swap_chunk;
+            std::size_t j_end   = std::min(j_begin + lu_blocking::swap_chunk, col_end);
+            for (std::size_t k = k_begin; k < k_end; ++k)
+            {
+              std::size_t p = pivots[k];
+              if (p != k)
+                for (std::size_t j = j_begin; j < j_end; ++j)
+                  std::swap(A(k, j), A(p, j));
+            }
+          }
+        }
+
+        /** @brief Computes B = L^{-1} B for the unit lower triangular matrix L = A(k, k), ..., A(k+size-1, k+size-1) and B = A(k, col_begin), ..., A(k+size-1, col_end-1) */
+        template <typename NumericT, typename F>
+        void lu_unit_lower_solve(lu_matrix_view<NumericT, F> & A, std::size_t k, std::size_t size,
+                                 std::size_t col_begin, std::size_t col_end)
+        {
+          if (col_begin >= col_end || size == 0)
+            return;
+
+          if (size > lu_blocking::trsm_base)
+          {
+            // [L11 0; L21 L22] [X1; X2] = [B1; B2]:  X1 = L11^{-1} B1,  B2 -= L21 X1,  X2 = L22^{-1} B2
+            std::size_t size1 = size / 2;
+            lu_unit_lower_solve(A, k, size1, col_begin, col_end);
+
+            typename lu_matrix_view<NumericT, F>::wrapper_type L21 = A.block(k + size1, k);
+            typename lu_matrix_view<NumericT, F>::wrapper_type X1  = A.block(k,         col_begin);
+            typename lu_matrix_view<NumericT, F>::wrapper_type B2  = A.block(k + size1, col_begin);
+            detail::prod(L21, X1, B2, size - size1, col_end - col_begin, size1, NumericT(-1), NumericT(1));
+
+            lu_unit_lower_solve(A, k + size1, size - size1, col_begin, col_end);
+            return;
+          }
+
+          std::size_t chunk_num = (col_end - col_begin - 1) / lu_blocking::swap_chunk + 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (chunk_num > 1)
+#endif
+          for (std::size_t chunk = 0; chunk < chunk_num; ++chunk)
+          {
+            std::size_t j_begin = col_begin + chunk * lu_blocking::swap_chunk;
+            std::size_t j_end   = std::min(j_begin + lu_blocking::swap_chunk, col_end);
+            for (std::size_t i = k + 1; i < k + size; ++i)
+              for (std::size_t l = k; l < i; ++l)
+              {
+                NumericT l_il = A(i, l);
+                for (std::size_t j = j_begin; j < j_end; ++j)
+                  A(i, j) -= l_il * A(l, j);
+              }
+          }
+        }
+
+        /** @brief Factors the columns [col, col+width) of the panel [panel_begin, panel_end), where all rows from col to size-1 are considered.
+        *
+        * Row interchanges are recorded in pivots and are only applied within the panel.
+        */
+        template <typename NumericT, typename F>
+        void lu_factorize_panel(lu_matrix_view<NumericT, F> & A, std::size_t size,
+                                std::size_t col, std::size_t width,
+                                std::size_t panel_begin, std::size_t panel_end,
+                                std::vector<std::size_t> & pivots, bool pivoting)
+        {
+          if (width > lu_blocking::panel_base)
+          {
+            std::size_t width1 = width / 2;
+            std::size_t col2   = col + width1;
+
+            lu_factorize_panel(A, size, col, width1, panel_begin, panel_end, pivots, pivoting);
+
+            // U12 = L11^{-1} A12, A22 -= L21 U12
+            lu_unit_lower_solve(A, col, width1, col2, col + width);
+
+            typename lu_matrix_view<NumericT, F>::wrapper_type L21 = A.block(col2, col);
+            typename lu_matrix_view<NumericT, F>::wrapper_type U12 = A.block(col,  col2);
+            typename lu_matrix_view<NumericT, F>::wrapper_type A22 = A.block(col2, col2);
+            detail::prod(L21, U12, A22, size - col2, width - width1, width1, NumericT(-1), NumericT(1));
+
+            lu_factorize_panel(A, size, col2, width - width1, panel_begin, panel_end, pivots, pivoting);
+            return;
+          }
+
+          for (std::size_t k = col; k < col + width; ++k)
+          {
+            std::size_t pivot_row = k;
+            if (pivoting)
+            {
+              NumericT pivot_abs = std::fabs(A(k, k));
+              for (std::size_t i = k + 1; i < size; ++i)
+              {
+                NumericT candidate = std::fabs(A(i, k));
+                if (candidate > pivot_abs)
+                {
+                  pivot_abs = candidate;
+                  pivot_row = i;
+                }
+              }
+            }
+
+            pivots[k] = pivot_row;
+            if (pivot_row != k)
+              for (std::size_t j = panel_begin; j < panel_end; ++j)
+                std::swap(A(k, j), A(pivot_row, j));
+
+            // compute column of L (for a singular matrix the zero column below a zero pivot is kept, just like LAPACK does):
+            NumericT pivot = A(k, k);
+            if (pivot != NumericT(0))
+              for (std::size_t i = k + 1; i < size; ++i)
+                A(i, k) /= pivot;
+
+            // rank-1 update of the remaining columns of the current panel:
+            for (std::size_t j = k + 1; j < col + width; ++j)
+            {
+              NumericT a_kj = A(k, j);
+              for (std::size_t i = k + 1; i < size; ++i)
+                A(i, j) -= A(i, k) * a_kj;
+            }
+          }
+        }
+
+        /** @brief Blocked right-looking LU factorization of the square matrix accessed via A.
+        *
+        * On return, row i of L U is row permutation[i] of the original matrix. Without pivoting, permutation is the identity.
+        */
+        template <typename NumericT, typename F>
+        void lu_factorize(lu_matrix_view<NumericT, F> & A, std::size_t size,
+                          std::vector<vcl_size_t> & permutation, bool pivoting)
+        {
+          std::vector<std::size_t> pivots(size);
+
+          for (std::size_t k = 0; k < size; k += lu_blocking::block_size)
+          {
+            std::size_t k_end = std::min(k + lu_blocking::block_size, size);
+
+            lu_factorize_panel(A, size, k, k_end - k, k, k_end, pivots, pivoting);
+
+            if (pivoting)
+            {
+              lu_swap_rows(A, pivots, k, k_end, 0, k);
+              lu_swap_rows(A, pivots, k, k_end, k_end, size);
+            }
+
+            if (k_end < size)
+            {
+              lu_unit_lower_solve(A, k, k_end - k, k_end, size);
+
+              typename lu_matrix_view<NumericT, F>::wrapper_type L21 = A.block(k_end, k);
+              typename lu_matrix_view<NumericT, F>::wrapper_type U12 = A.block(k,     k_end);
+              typename lu_matrix_view<NumericT, F>::wrapper_type A22 = A.block(k_end, k_end);
+              detail::prod(L21, U12, A22, size - k_end, size - k_end, k_end - k, NumericT(-1), NumericT(1));
+            }
+          }
+
+          permutation.resize(size);
+          for (std::size_t i = 0; i < size; ++i)
+            permutation[i] = i;
+          for (std::size_t k = 0; k < size; ++k)
+            std::swap(permutation[k], permutation[pivots[k]]);
+        }
+
+      } //namespace detail
+
+
+      /** @brief LU factorization of a dense matrix, optionally with partial (row) pivoting such that P A = L U.
+      *
+      * @param A            The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+      * @param permutation  Row i of L U is row permutation[i] of the original matrix A
+      * @param pivoting     If false, no rows are interchanged and permutation is the identity
+      */
+      template <typename NumericT, typename F>
+      void lu_factorize(matrix_base<NumericT, F> & A, std::vector<vcl_size_t> & permutation, bool pivoting = true)
+      {
+        detail::lu_matrix_view<NumericT, F> view(detail::extract_raw_pointer<NumericT>(A),
+                                                 viennacl::traits::start1(A), viennacl::traits::start2(A),
+                                                 viennacl::traits::stride1(A), viennacl::traits::stride2(A),
+                                                 viennacl::traits::internal_size1(A), viennacl::traits::internal_size2(A));
+        detail::lu_factorize(view, viennacl::traits::size1(A), permutation, pivoting);
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
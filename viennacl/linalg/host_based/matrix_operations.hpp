@@ -22,6 +22,9 @@
     @brief Implementations of dense matrix related operations, including matrix-vector products, using a plain single-threaded or OpenMP-enabled execution on CPU.
 */
 
+#include <vector>
+#include <algorithm>
+
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
@@ -37,6 +40,12 @@
 #include "viennacl/linalg/detail/op_applier.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
 
+#if defined(VIENNACL_WITH_AVX2)
+#include <immintrin.h>
+#elif defined(VIENNACL_WITH_SSE2)
+#include <emmintrin.h>
+#endif
+
 namespace viennacl
 {
   namespace linalg
@@ -866,26 +875,339 @@ namespace viennacl
 
       namespace detail
       {
+        /** @brief Blocking parameters for the packed matrix-matrix product.
+        *
+        * A register tile of size mr x nr is computed by the micro-kernel. Blocks of size mc x kc of A are packed such that they stay in L2 cache,
+        * panels of size kc x nc of B are packed such that they stay in L3 cache. mc must be a multiple of mr, nc a multiple of nr.
+        */
+        template <typename NumericT>
+        struct gemm_blocking
+        {
+          static const std::size_t mr = 4;
+          static const std::size_t nr = 4;
+          static const std::size_t mc = 96;
+          static const std::size_t kc = 256;
+          static const std::size_t nc = 2048;
+        };
+
+#if defined(VIENNACL_WITH_AVX2)
+        template <>
+        struct gemm_blocking<float>
+        {
+          static const std::size_t mr = 6;
+          static const std::size_t nr = 16;
+          static const std::size_t mc = 144;
+          static const std::size_t kc = 256;
+          static const std::size_t nc = 4096;
+        };
+
+        template <>
+        struct gemm_blocking<double>
+        {
+          static const std::size_t mr = 6;
+          static const std::size_t nr = 8;
+          static const std::size_t mc = 96;
+          static const std::size_t kc = 256;
+          static const std::size_t nc = 2048;
+        };
+#elif defined(VIENNACL_WITH_SSE2)
+        template <>
+        struct gemm_blocking<float>
+        {
+          static const std::size_t mr = 4;
+          static const std::size_t nr = 8;
+          static const std::size_t mc = 128;
+          static const std::size_t kc = 256;
+          static const std::size_t nc = 4096;
+        };
+#endif
+
+        /** @brief Generic micro-kernel: computes the mr x nr tile ab = A_panel * B_panel from packed panels of length kc. The result tile is stored row-wise. */
+        template <typename NumericT>
+        void gemm_micro_kernel(std::size_t kc, NumericT const * pA, NumericT const * pB, NumericT * ab)
+        {
+          std::size_t const mr = gemm_blocking<NumericT>::mr;
+          std::size_t const nr = gemm_blocking<NumericT>::nr;
+
+          NumericT tile[gemm_blocking<NumericT>::mr * gemm_blocking<NumericT>::nr];
+          for (std::size_t i=0; i<mr*nr; ++i)
+            tile[i] = 0;
+
+          for (std::size_t k=0; k<kc; ++k)
+          {
+            for (std::size_t i=0; i<mr; ++i)
+            {
+              NumericT a_ik = pA[i];
+              for (std::size_t j=0; j<nr; ++j)
+                tile[i*nr + j] += a_ik * pB[j];
+            }
+            pA += mr;
+            pB += nr;
+          }
+
+          for (std::size_t i=0; i<mr*nr; ++i)
+            ab[i] = tile[i];
+        }
+
+#if defined(VIENNACL_WITH_AVX2)
+        // 6x16 tile for float: 12 accumulators, two registers for B, one broadcast register
+        inline void gemm_micro_kernel(std::size_t kc, float const * pA, float const * pB, float * ab)
+        {
+          __m256 c[6][2];
+          for (std::size_t i=0; i<6; ++i)
+            c[i][0] = c[i][1] = _mm256_setzero_ps();
+
+          for (std::size_t k=0; k<kc; ++k)
+          {
+            __m256 b0 = _mm256_loadu_ps(pB);
+            __m256 b1 = _mm256_loadu_ps(pB + 8);
+            for (std::size_t i=0; i<6; ++i)
+            {
+              __m256 a = _mm256_broadcast_ss(pA + i);
+              c[i][0] = _mm256_fmadd_ps(a, b0, c[i][0]);
+              c[i][1] = _mm256_fmadd_ps(a, b1, c[i][1]);
+            }
+            pA += 6;
+            pB += 16;
+          }
+
+          for (std::size_t i=0; i<6; ++i)
+          {
+            _mm256_storeu_ps(ab + i*16,     c[i][0]);
+            _mm256_storeu_ps(ab + i*16 + 8, c[i][1]);
+          }
+        }
+
+        // 6x8 tile for double
+        inline void gemm_micro_kernel(std::size_t kc, double const * pA, double const * pB, double * ab)
+        {
+          __m256d c[6][2];
+          for (std::size_t i=0; i<6; ++i)
+            c[i][0] = c[i][1] = _mm256_setzero_pd();
+
+          for (std::size_t k=0; k<kc; ++k)
+          {
+            __m256d b0 = _mm256_loadu_pd(pB);
+            __m256d b1 = _mm256_loadu_pd(pB + 4);
+            for (std::size_t i=0; i<6; ++i)
+            {
+              __m256d a = _mm256_broadcast_sd(pA + i);
+              c[i][0] = _mm256_fmadd_pd(a, b0, c[i][0]);
+              c[i][1] = _mm256_fmadd_pd(a, b1, c[i][1]);
+            }
+            pA += 6;
+            pB += 8;
+          }
+
+          for (std::size_t i=0; i<6; ++i)
+          {
+            _mm256_storeu_pd(ab + i*8,     c[i][0]);
+            _mm256_storeu_pd(ab + i*8 + 4, c[i][1]);
+          }
+        }
+#elif defined(VIENNACL_WITH_SSE2)
+        // 4x8 tile for float
+        inline void gemm_micro_kernel(std::size_t kc, float const * pA, float const * pB, float * ab)
+        {
+          __m128 c[4][2];
+          for (std::size_t i=0; i<4; ++i)
+            c[i][0] = c[i][1] = _mm_setzero_ps();
+
+          for (std::size_t k=0; k<kc; ++k)
+          {
+            __m128 b0 = _mm_loadu_ps(pB);
+            __m128 b1 = _mm_loadu_ps(pB + 4);
+            for (std::size_t i=0; i<4; ++i)
+            {
+              __m128 a = _mm_set1_ps(pA[i]);
+              c[i][0] = _mm_add_ps(c[i][0], _mm_mul_ps(a, b0));
+              c[i][1] = _mm_add_ps(c[i][1], _mm_mul_ps(a, b1));
+            }
+            pA += 4;
+            pB += 8;
+          }
+
+          for (std::size_t i=0; i<4; ++i)
+          {
+            _mm_storeu_ps(ab + i*8,     c[i][0]);
+            _mm_storeu_ps(ab + i*8 + 4, c[i][1]);
+          }
+        }
+
+        // 4x4 tile for double
+        inline void gemm_micro_kernel(std::size_t kc, double const * pA, double const * pB, double * ab)
+        {
+          __m128d c[4][2];
+          for (std::size_t i=0; i<4; ++i)
+            c[i][0] = c[i][1] = _mm_setzero_pd();
+
+          for (std::size_t k=0; k<kc; ++k)
+          {
+            __m128d b0 = _mm_loadu_pd(pB);
+            __m128d b1 = _mm_loadu_pd(pB + 2);
+            for (std::size_t i=0; i<4; ++i)
+            {
+              __m128d a = _mm_set1_pd(pA[i]);
+              c[i][0] = _mm_add_pd(c[i][0], _mm_mul_pd(a, b0));
+              c[i][1] = _mm_add_pd(c[i][1], _mm_mul_pd(a, b1));
+            }
+            pA += 4;
+            pB += 4;
+          }
+
+          for (std::size_t i=0; i<4; ++i)
+          {
+            _mm_storeu_pd(ab + i*4,     c[i][0]);
+            _mm_storeu_pd(ab + i*4 + 2, c[i][1]);
+          }
+        }
+#endif
+
+        /** @brief Packs the block A(i0:i0+mc, k0:k0+kc) into consecutive panels of mr rows. Each panel is stored column by column, rows beyond mc are zero-padded. */
+        template <typename A, typename NumericT>
+        void gemm_pack_A(A & a, std::size_t i0, std::size_t k0, std::size_t mc, std::size_t kc, NumericT * buffer)
+        {
+          std::size_t const mr = gemm_blocking<NumericT>::mr;
+          std::size_t num_panels = (mc + mr - 1) / mr;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (std::size_t p=0; p<num_panels; ++p)
+          {
+            NumericT * panel = buffer + p * mr * kc;
+            std::size_t rows = std::min(mr, mc - p * mr);
+            for (std::size_t k=0; k<kc; ++k)
+            {
+              std::size_t r=0;
+              for (; r<rows; ++r)
+                panel[k * mr + r] = a(i0 + p * mr + r, k0 + k);
+              for (; r<mr; ++r)
+                panel[k * mr + r] = 0;
+            }
+          }
+        }
+
+        /** @brief Packs the panel B(k0:k0+kc, j0:j0+nc) into consecutive panels of nr columns. Each panel is stored row by row, columns beyond nc are zero-padded. */
+        template <typename B, typename NumericT>
+        void gemm_pack_B(B & b, std::size_t k0, std::size_t j0, std::size_t kc, std::size_t nc, NumericT * buffer)
+        {
+          std::size_t const nr = gemm_blocking<NumericT>::nr;
+          std::size_t num_panels = (nc + nr - 1) / nr;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (std::size_t p=0; p<num_panels; ++p)
+          {
+            NumericT * panel = buffer + p * nr * kc;
+            std::size_t cols = std::min(nr, nc - p * nr);
+            for (std::size_t k=0; k<kc; ++k)
+            {
+              std::size_t c=0;
+              for (; c<cols; ++c)
+                panel[k * nr + c] = b(k0 + k, j0 + p * nr + c);
+              for (; c<nr; ++c)
+                panel[k * nr + c] = 0;
+            }
+          }
+        }
+
+        /** @brief Multiplies a packed mc x kc block of A with a packed kc x nc panel of B and accumulates the result into C(i0:i0+mc, j0:j0+nc).
+        *
+        * The register tiles are distributed over the threads in both dimensions.
+        * If first_block is true, C is scaled by beta (C is not read for beta == 0), otherwise the product is added to C.
+        */
+        template <typename C, typename NumericT>
+        void gemm_macro_kernel(NumericT const * packed_A, NumericT const * packed_B, C & c,
+                               std::size_t i0, std::size_t j0, std::size_t mc, std::size_t nc, std::size_t kc,
+                               NumericT alpha, NumericT beta, bool first_block)
+        {
+          std::size_t const mr = gemm_blocking<NumericT>::mr;
+          std::size_t const nr = gemm_blocking<NumericT>::nr;
+
+          std::size_t panels_A = (mc + mr - 1) / mr;
+          std::size_t panels_B = (nc + nr - 1) / nr;
+          std::size_t num_tiles = panels_A * panels_B;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (std::size_t tile=0; tile<num_tiles; ++tile)
+          {
+            std::size_t pa = tile % panels_A;  //consecutive tiles share the same panel of B
+            std::size_t pb = tile / panels_A;
+
+            NumericT ab[gemm_blocking<NumericT>::mr * gemm_blocking<NumericT>::nr];
+            gemm_micro_kernel(kc, packed_A + pa * mr * kc, packed_B + pb * nr * kc, ab);
+
+            std::size_t rows = std::min(mr, mc - pa * mr);
+            std::size_t cols = std::min(nr, nc - pb * nr);
+            for (std::size_t i=0; i<rows; ++i)
+            {
+              std::size_t row = i0 + pa * mr + i;
+              for (std::size_t j=0; j<cols; ++j)
+              {
+                std::size_t col = j0 + pb * nr + j;
+                NumericT temp = alpha * ab[i * nr + j];
+                if (!first_block)
+                  temp += c(row, col);
+                else if (beta != 0)
+                  temp += beta * c(row, col);
+                c(row, col) = temp;
+              }
+            }
+          }
+        }
+
+        /** @brief Computes C = alpha * A * B + beta * C, where the operands are accessed through matrix_array_wrapper objects.
+        *
+        * Blocks of A and panels of B are packed into contiguous buffers (which also resolves the different memory layouts, transpositions, ranges and slices),
+        * then the product is computed by a register-tiled micro-kernel.
+        */
         template <typename A, typename B, typename C, typename NumericT>
         void prod(A & a, B & b, C & c,
                   std::size_t C_size1, std::size_t C_size2, std::size_t A_size2,
                   NumericT alpha, NumericT beta)
         {
+          std::size_t const mc = gemm_blocking<NumericT>::mc;
+          std::size_t const kc = gemm_blocking<NumericT>::kc;
+          std::size_t const nc = gemm_blocking<NumericT>::nc;
+
+          if (C_size1 == 0 || C_size2 == 0)
+            return;
+
+          if (A_size2 == 0)  //empty product, only scale C
+          {
 #ifdef VIENNACL_WITH_OPENMP
-          #pragma omp parallel for
+            #pragma omp parallel for
 #endif
-          for (std::size_t i=0; i<C_size1; ++i)
+            for (std::size_t i=0; i<C_size1; ++i)
+              for (std::size_t j=0; j<C_size2; ++j)
+                c(i, j) = (beta != 0) ? beta * c(i, j) : 0;
+            return;
+          }
+
+          std::size_t const mr = gemm_blocking<NumericT>::mr;
+          std::size_t const nr = gemm_blocking<NumericT>::nr;
+
+          std::vector<NumericT> packed_A(((std::min(mc, C_size1) + mr - 1) / mr) * mr * std::min(kc, A_size2));
+          std::vector<NumericT> packed_B(((std::min(nc, C_size2) + nr - 1) / nr) * nr * std::min(kc, A_size2));
+
+          for (std::size_t j0 = 0; j0 < C_size2; j0 += nc)
           {
-            for (std::size_t j=0; j<C_size2; ++j)
+            std::size_t nc_block = std::min(nc, C_size2 - j0);
+            for (std::size_t k0 = 0; k0 < A_size2; k0 += kc)
             {
-              NumericT temp = 0;
-              for (std::size_t k=0; k<A_size2; ++k)
-                temp += a(i, k) * b(k, j);
-
-              temp *= alpha;
-              if (beta != 0)
-                temp += beta * c(i,j);
-              c(i,j) = temp;
+              std::size_t kc_block = std::min(kc, A_size2 - k0);
+              gemm_pack_B(b, k0, j0, kc_block, nc_block, &(packed_B[0]));
+
+              for (std::size_t i0 = 0; i0 < C_size1; i0 += mc)
+              {
+                std::size_t mc_block = std::min(mc, C_size1 - i0);
+                gemm_pack_A(a, i0, k0, mc_block, kc_block, &(packed_A[0]));
+                gemm_macro_kernel(&(packed_A[0]), &(packed_B[0]), c, i0, j0, mc_block, nc_block, kc_block, alpha, beta, k0 == 0);
+              }
             }
           }
         }
@@ -0,0 +1,78 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_MIXED_PRECISION_CG_HPP_
+#define VIENNACL_LINALG_HOST_BASED_MIXED_PRECISION_CG_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/mixed_precision_cg.hpp
+    @brief Precision conversions for the mixed precision conjugate gradient solver on the CPU using a single thread or OpenMP.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/backend/mem_handle.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/vector_operations.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      /** @brief Converts the first 'size' entries of a buffer of doubles to single precision: dst[i] = (float)src[i]
+      *
+      * @param dst    Buffer holding at least 'size' floats
+      * @param src    Buffer holding at least 'size' doubles
+      * @param size   Number of entries to convert
+      */
+      inline void assign_double_to_float(viennacl::backend::mem_handle & dst, viennacl::backend::mem_handle const & src, std::size_t size)
+      {
+        float        * data_dst = detail::extract_raw_pointer<float>(dst);
+        double const * data_src = detail::extract_raw_pointer<double>(src);
+
+        // plain unit-stride loop without aliasing, so that the compiler emits packed conversions
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long i = 0; i < static_cast<long>(size); ++i)
+          data_dst[i] = static_cast<float>(data_src[i]);
+      }
+
+      /** @brief Adds the first 'size' entries of a buffer of floats to a buffer of doubles: dst[i] += (double)src[i]
+      *
+      * @param dst    Buffer holding at least 'size' doubles
+      * @param src    Buffer holding at least 'size' floats
+      * @param size   Number of entries to update
+      */
+      inline void inplace_add_float_to_double(viennacl::backend::mem_handle & dst, viennacl::backend::mem_handle const & src, std::size_t size)
+      {
+        double      * data_dst = detail::extract_raw_pointer<double>(dst);
+        float const * data_src = detail::extract_raw_pointer<float>(src);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long i = 0; i < static_cast<long>(size); ++i)
+          data_dst[i] += static_cast<double>(data_src[i]);
+      }
+
+    } // namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,281 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_NMF_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_NMF_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/nmf_operations.hpp
+    @brief Implementations of the multiplicative update steps and the residual evaluation of the nonnegative matrix factorization on the CPU using a single thread or OpenMP.
+
+    The products with the (small) Gram matrices are fused with the element-wise multiplication and division,
+    so neither W * H nor the denominators of the update rules are ever stored.
+*/
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Blocking parameters of the NMF kernels */
+        struct nmf_blocking
+        {
+          static const std::size_t update_block  = 64;        // number of columns (rows) of H (W) updated by a thread at once
+          static const std::size_t residual_size = 1 << 20;   // maximum number of entries of V - W * H held in memory at the same time
+        };
+
+        /** @brief The multiplicative update x = x * num / den. Small denominators result in a zero entry (just like in the OpenCL kernel) */
+        template <typename NumericT>
+        NumericT nmf_mul_div(NumericT x, NumericT num, NumericT den)
+        {
+          return (den > NumericT(0.00001)) ? (x * num) / den : NumericT(0);
+        }
+
+        template <typename NumericT, typename F>
+        matrix_array_wrapper<NumericT, typename F::orientation_category, false> nmf_wrapper(matrix_base<NumericT, F> & A)
+        {
+          return matrix_array_wrapper<NumericT, typename F::orientation_category, false>(detail::extract_raw_pointer<NumericT>(A),
+                                                                                          viennacl::traits::start1(A),  viennacl::traits::start2(A),
+                                                                                          viennacl::traits::stride1(A), viennacl::traits::stride2(A),
+                                                                                          viennacl::traits::internal_size1(A), viennacl::traits::internal_size2(A));
+        }
+
+        template <typename NumericT, typename F>
+        matrix_array_wrapper<NumericT const, typename F::orientation_category, false> nmf_wrapper(matrix_base<NumericT, F> const & A)
+        {
+          return matrix_array_wrapper<NumericT const, typename F::orientation_category, false>(detail::extract_raw_pointer<NumericT>(A),
+                                                                                                viennacl::traits::start1(A),  viennacl::traits::start2(A),
+                                                                                                viennacl::traits::stride1(A), viennacl::traits::stride2(A),
+                                                                                                viennacl::traits::internal_size1(A), viennacl::traits::internal_size2(A));
+        }
+
+        /** @brief Copies the rows [row_begin, row_begin + rows) of the matrix accessed through A to the row-major buffer of width cols */
+        template <typename WrapperT, typename NumericT>
+        void nmf_pack(WrapperT A, std::size_t row_begin, std::size_t rows, std::size_t cols, NumericT * buffer)
+        {
+          for (std::size_t i = 0; i < rows; ++i)
+            for (std::size_t j = 0; j < cols; ++j)
+              buffer[i * cols + j] = A(row_begin + i, j);
+        }
+      }
+
+
+      /** @brief Update step H = H .* numerator ./ (gram * H) of the nonnegative matrix factorization, where gram = W^T * W.
+      *
+      * The product gram * H is computed block by block and consumed immediately.
+      *
+      * @param H          The factor to be updated (k x n)
+      * @param numerator  The numerator W^T * V of the update rule (k x n)
+      * @param gram       The Gram matrix W^T * W (k x k)
+      */
+      template <typename NumericT, typename F1, typename F2, typename F3>
+      void nmf_update_left(matrix_base<NumericT, F1> & H,
+                           matrix_base<NumericT, F2> const & numerator,
+                           matrix_base<NumericT, F3> const & gram)
+      {
+        std::size_t const block_size = detail::nmf_blocking::update_block;
+        std::size_t k = viennacl::traits::size1(H);
+        std::size_t n = viennacl::traits::size2(H);
+        std::size_t block_num = (n + block_size - 1) / block_size;
+
+        std::vector<NumericT> packed_G(k * k);
+        detail::nmf_pack(detail::nmf_wrapper(gram), 0, k, k, &(packed_G[0]));
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel if (block_num > 1)
+#endif
+        {
+          detail::matrix_array_wrapper<NumericT,       typename F1::orientation_category, false> wrapper_H = detail::nmf_wrapper(H);
+          detail::matrix_array_wrapper<NumericT const, typename F2::orientation_category, false> wrapper_N = detail::nmf_wrapper(numerator);
+
+          std::vector<NumericT> H_block(k * block_size);
+          std::vector<NumericT> denominator(k * block_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp for
+#endif
+          for (long block = 0; block < static_cast<long>(block_num); ++block)
+          {
+            std::size_t j_begin = static_cast<std::size_t>(block) * block_size;
+            std::size_t width   = std::min(block_size, n - j_begin);
+
+            // denominator = gram * H(:, j_begin:j_begin+width) for the current block of columns:
+            for (std::size_t l = 0; l < k; ++l)
+              for (std::size_t j = 0; j < width; ++j)
+                H_block[l * block_size + j] = wrapper_H(l, j_begin + j);
+
+            std::fill(denominator.begin(), denominator.end(), NumericT(0));
+            for (std::size_t i = 0; i < k; ++i)
+            {
+              NumericT * den_row = &(denominator[i * block_size]);
+              for (std::size_t l = 0; l < k; ++l)
+              {
+                NumericT g_il = packed_G[i * k + l];
+                NumericT const * H_row = &(H_block[l * block_size]);
+                for (std::size_t j = 0; j < width; ++j)
+                  den_row[j] += g_il * H_row[j];
+              }
+            }
+
+            for (std::size_t i = 0; i < k; ++i)
+              for (std::size_t j = 0; j < width; ++j)
+                wrapper_H(i, j_begin + j) = detail::nmf_mul_div(H_block[i * block_size + j], wrapper_N(i, j_begin + j), denominator[i * block_size + j]);
+          }
+        }
+      }
+
+
+      /** @brief Update step W = W .* numerator ./ (W * gram) of the nonnegative matrix factorization, where gram = H * H^T.
+      *
+      * The product W * gram is computed block by block and consumed immediately.
+      *
+      * @param W          The factor to be updated (m x k)
+      * @param numerator  The numerator V * H^T of the update rule (m x k)
+      * @param gram       The Gram matrix H * H^T (k x k)
+      */
+      template <typename NumericT, typename F1, typename F2, typename F3>
+      void nmf_update_right(matrix_base<NumericT, F1> & W,
+                            matrix_base<NumericT, F2> const & numerator,
+                            matrix_base<NumericT, F3> const & gram)
+      {
+        std::size_t const block_size = detail::nmf_blocking::update_block;
+        std::size_t m = viennacl::traits::size1(W);
+        std::size_t k = viennacl::traits::size2(W);
+        std::size_t block_num = (m + block_size - 1) / block_size;
+
+        std::vector<NumericT> packed_G(k * k);
+        detail::nmf_pack(detail::nmf_wrapper(gram), 0, k, k, &(packed_G[0]));
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel if (block_num > 1)
+#endif
+        {
+          detail::matrix_array_wrapper<NumericT,       typename F1::orientation_category, false> wrapper_W = detail::nmf_wrapper(W);
+          detail::matrix_array_wrapper<NumericT const, typename F2::orientation_category, false> wrapper_N = detail::nmf_wrapper(numerator);
+
+          std::vector<NumericT> W_block(block_size * k);
+          std::vector<NumericT> denominator(block_size * k);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp for
+#endif
+          for (long block = 0; block < static_cast<long>(block_num); ++block)
+          {
+            std::size_t i_begin = static_cast<std::size_t>(block) * block_size;
+            std::size_t height  = std::min(block_size, m - i_begin);
+
+            // denominator = W(i_begin:i_begin+height, :) * gram for the current block of rows:
+            detail::nmf_pack(wrapper_W, i_begin, height, k, &(W_block[0]));
+
+            std::fill(denominator.begin(), denominator.end(), NumericT(0));
+            for (std::size_t i = 0; i < height; ++i)
+            {
+              NumericT * den_row = &(denominator[i * k]);
+              for (std::size_t l = 0; l < k; ++l)
+              {
+                NumericT w_il = W_block[i * k + l];
+                NumericT const * G_row = &(packed_G[l * k]);
+                for (std::size_t j = 0; j < k; ++j)
+                  den_row[j] += w_il * G_row[j];
+              }
+            }
+
+            for (std::size_t i = 0; i < height; ++i)
+              for (std::size_t j = 0; j < k; ++j)
+                wrapper_W(i_begin + i, j) = detail::nmf_mul_div(W_block[i * k + j], wrapper_N(i_begin + i, j), denominator[i * k + j]);
+          }
+        }
+      }
+
+
+      /** @brief Computes the residual norm ||V - W * H||_F of the nonnegative matrix factorization.
+      *
+      * V - W * H is computed for blocks of rows with the matrix-matrix product kernel and immediately reduced,
+      * so no temporary of the size of V is needed.
+      */
+      template <typename NumericT, typename F1, typename F2, typename F3>
+      NumericT nmf_residual(matrix_base<NumericT, F1> const & V,
+                            matrix_base<NumericT, F2> const & W,
+                            matrix_base<NumericT, F3> const & H)
+      {
+        std::size_t m = viennacl::traits::size1(V);
+        std::size_t n = viennacl::traits::size2(V);
+        std::size_t k = viennacl::traits::size2(W);
+
+        if (m == 0 || n == 0)
+          return NumericT(0);
+
+        std::size_t block_rows = std::max<std::size_t>(1, std::min<std::size_t>(m, detail::nmf_blocking::residual_size / n));
+        std::vector<NumericT> buffer(block_rows * n);
+
+        detail::matrix_array_wrapper<NumericT const, typename F1::orientation_category, false> wrapper_V = detail::nmf_wrapper(V);
+        detail::matrix_array_wrapper<NumericT const, typename F3::orientation_category, false> wrapper_H = detail::nmf_wrapper(H);
+
+        double squared_norm = 0;  // accumulated in double precision, since V may have many entries
+        for (std::size_t i_begin = 0; i_begin < m; i_begin += block_rows)
+        {
+          std::size_t height = std::min(block_rows, m - i_begin);
+
+          // buffer = V(i_begin:i_begin+height, :)
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long i = 0; i < static_cast<long>(height); ++i)
+            for (std::size_t j = 0; j < n; ++j)
+              buffer[static_cast<std::size_t>(i) * n + j] = wrapper_V(i_begin + static_cast<std::size_t>(i), j);
+
+          // buffer -= W(i_begin:i_begin+height, :) * H
+          detail::matrix_array_wrapper<NumericT const, typename F2::orientation_category, false>
+            wrapper_W(detail::extract_raw_pointer<NumericT>(W),
+                      viennacl::traits::start1(W) + i_begin * viennacl::traits::stride1(W), viennacl::traits::start2(W),
+                      viennacl::traits::stride1(W), viennacl::traits::stride2(W),
+                      viennacl::traits::internal_size1(W), viennacl::traits::internal_size2(W));
+          detail::matrix_array_wrapper<NumericT, row_major_tag, false> wrapper_buffer(&(buffer[0]), 0, 0, 1, 1, height, n);
+          detail::prod(wrapper_W, wrapper_H, wrapper_buffer, height, n, k, NumericT(-1), NumericT(1));
+
+          double block_norm = 0;
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for reduction(+: block_norm)
+#endif
+          for (long i = 0; i < static_cast<long>(height * n); ++i)
+            block_norm += static_cast<double>(buffer[static_cast<std::size_t>(i)]) * static_cast<double>(buffer[static_cast<std::size_t>(i)]);
+
+          squared_norm += block_norm;
+        }
+
+        return static_cast<NumericT>(std::sqrt(squared_norm));
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
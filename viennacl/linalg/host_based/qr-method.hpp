@@ -0,0 +1,1305 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_QR_METHOD_HPP_
+#define VIENNACL_LINALG_HOST_BASED_QR_METHOD_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/qr-method.hpp
+    @brief Implementation of the QR method for eigenvalue computations on the CPU using a single thread or OpenMP.
+
+    Symmetric matrices are reduced to tridiagonal form, nonsymmetric matrices to upper Hessenberg form by blocked Householder reflections,
+    such that most of the work is spent in matrix-matrix products updating the trailing submatrix (cf. LAPACK's xSYTRD and xGEHRD).
+    The orthogonal transformation is formed in blocked (compact WY) form. Eigenvalues and eigenvectors of the tridiagonal matrix are then
+    obtained by the implicit QL method with the Givens rotations applied to the eigenvectors in batches, while the Hessenberg matrix is
+    reduced to real Schur form by the Francis double shift QR method (hqr2).
+*/
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+#include "viennacl/linalg/host_based/svd.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Blocking parameters of the reductions to tridiagonal and Hessenberg form */
+        struct qr_method_blocking
+        {
+          static const std::size_t block_size = 32;    // number of reflectors per panel
+          static const std::size_t crossover  = 128;   // the trailing submatrix is reduced without blocking once it has at most this many columns
+          static const std::size_t max_iter   = 100;   // maximum number of implicit QL steps per eigenvalue of a tridiagonal matrix
+        };
+
+        // The reduction kernels below operate on column-major arrays: Entry (i, j) of A is located at A[i + j * lda].
+        // Basic building blocks (matrix-vector products, reflectors, rotations) are shared with the SVD.
+
+        /** @brief Reduces the first nb columns of the symmetric n x n matrix A to tridiagonal form and returns the matrix W needed for updating
+        *         the trailing submatrix as A - V * W^T - W * V^T, cf. LAPACK's xLATRD. A is fully stored and the trailing submatrix is kept symmetric.
+        */
+        template <typename NumericT>
+        void qr_tridiag_panel(std::size_t n, std::size_t nb, NumericT * A, std::size_t lda,
+                              NumericT * e, NumericT * tau, NumericT * W, std::size_t ldw)
+        {
+          for (std::size_t i = 0; i < nb; ++i)
+          {
+            NumericT * A_ii = A + i + i * lda;
+
+            // update A(i:n, i)
+            svd_gemv_n(n - i, i, NumericT(-1), A + i, lda, W + i, ldw, NumericT(1), A_ii, 1);
+            svd_gemv_n(n - i, i, NumericT(-1), W + i, ldw, A + i, lda, NumericT(1), A_ii, 1);
+
+            if (i + 1 < n)
+            {
+              // generate reflection H(i) to annihilate A(i+2:n, i)
+              tau[i] = svd_householder(n - i - 1, A_ii[1], A + std::min(i + 2, n - 1) + i * lda, 1);
+              e[i] = A_ii[1];
+              A_ii[1] = NumericT(1);
+
+              // compute W(i+1:n, i)
+              NumericT * v   = A_ii + 1;
+              NumericT * W_i = W + i * ldw;
+              svd_gemv_n(n - i - 1, n - i - 1, NumericT(1),  A_ii + 1 + lda, lda, v, 1, NumericT(0), W_i + i + 1, 1);
+              svd_gemv_t(n - i - 1, i,         NumericT(1),  W + i + 1, ldw, v, 1, NumericT(0), W_i, 1);
+              svd_gemv_n(n - i - 1, i,         NumericT(-1), A + i + 1, lda, W_i, 1, NumericT(1), W_i + i + 1, 1);
+              svd_gemv_t(n - i - 1, i,         NumericT(1),  A + i + 1, lda, v, 1, NumericT(0), W_i, 1);
+              svd_gemv_n(n - i - 1, i,         NumericT(-1), W + i + 1, ldw, W_i, 1, NumericT(1), W_i + i + 1, 1);
+
+              NumericT dot = 0;
+              for (std::size_t j = i + 1; j < n; ++j)
+              {
+                W_i[j] *= tau[i];
+                dot += W_i[j] * v[j - i - 1];
+              }
+              NumericT alpha = NumericT(-0.5) * tau[i] * dot;
+              for (std::size_t j = i + 1; j < n; ++j)
+                W_i[j] += alpha * v[j - i - 1];
+            }
+          }
+        }
+
+        /** @brief Unblocked reduction of the fully stored symmetric n x n matrix A to tridiagonal form, cf. LAPACK's xSYTD2 */
+        template <typename NumericT>
+        void qr_tridiag_unblocked(std::size_t n, NumericT * A, std::size_t lda, NumericT * d, NumericT * e, NumericT * tau)
+        {
+          std::vector<NumericT> x(n);
+
+          for (std::size_t i = 0; i + 1 < n; ++i)
+          {
+            NumericT * A_ii = A + i + i * lda;
+
+            tau[i] = svd_householder(n - i - 1, A_ii[1], A + std::min(i + 2, n - 1) + i * lda, 1);
+            e[i] = A_ii[1];
+
+            if (tau[i] != 0)
+            {
+              // A(i+1:n, i+1:n) -= v * x^T + x * v^T  with  x = tau * A * v - (tau^2/2 * v^T A v) * v
+              std::size_t len = n - i - 1;
+              NumericT * v     = A_ii + 1;
+              NumericT * A_sub = A_ii + 1 + lda;
+              A_ii[1] = NumericT(1);
+
+              svd_gemv_n(len, len, tau[i], A_sub, lda, v, 1, NumericT(0), &(x[0]), 1);
+              NumericT dot = 0;
+              for (std::size_t j = 0; j < len; ++j)
+                dot += x[j] * v[j];
+              NumericT alpha = NumericT(-0.5) * tau[i] * dot;
+              for (std::size_t j = 0; j < len; ++j)
+                x[j] += alpha * v[j];
+
+              svd_ger(len, len, NumericT(1), v, 1, &(x[0]), 1, A_sub, lda);
+              svd_ger(len, len, NumericT(1), &(x[0]), 1, v, 1, A_sub, lda);
+
+              A_ii[1] = e[i];
+            }
+            d[i] = A_ii[0];
+          }
+          if (n > 0)
+          {
+            d[n - 1] = A[(n - 1) + (n - 1) * lda];
+            e[n - 1] = NumericT(0);
+            tau[n - 1] = NumericT(0);
+          }
+        }
+
+        /** @brief Blocked reduction of the symmetric n x n matrix A to tridiagonal form T = Q^T A Q, cf. LAPACK's xSYTRD.
+        *
+        * The diagonal and the subdiagonal of T are returned in d and e, the reflectors defining Q are stored below the subdiagonal of A.
+        */
+        template <typename NumericT>
+        void qr_tridiag(std::size_t n, NumericT * A, std::size_t lda,
+                        std::vector<NumericT> & d, std::vector<NumericT> & e, std::vector<NumericT> & tau)
+        {
+          std::size_t const nb = qr_method_blocking::block_size;
+
+          std::vector<NumericT> W(n * nb);
+
+          std::size_t i = 0;
+          for (; i + qr_method_blocking::crossover < n; i += nb)
+          {
+            qr_tridiag_panel(n - i, nb, A + i + i * lda, lda, &(e[i]), &(tau[i]), &(W[0]), n);
+
+            // update the trailing submatrix: A = A - V * W^T - W * V^T
+            std::size_t rows = n - i - nb;
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_V(A, i + nb, i, 1, 1, lda, n);
+            matrix_array_wrapper<NumericT const, column_major_tag, true>  wrapper_Vt(A, i + nb, i, 1, 1, lda, n);
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_W(&(W[0]), nb, 0, 1, 1, n, nb);
+            matrix_array_wrapper<NumericT const, column_major_tag, true>  wrapper_Wt(&(W[0]), nb, 0, 1, 1, n, nb);
+            matrix_array_wrapper<NumericT,       column_major_tag, false> wrapper_A(A, i + nb, i + nb, 1, 1, lda, n);
+
+            detail::prod(wrapper_V, wrapper_Wt, wrapper_A, rows, rows, nb, NumericT(-1), NumericT(1));
+            detail::prod(wrapper_W, wrapper_Vt, wrapper_A, rows, rows, nb, NumericT(-1), NumericT(1));
+
+            // restore the subdiagonal entries overwritten by the unit entries of the reflectors:
+            for (std::size_t j = i; j < i + nb; ++j)
+            {
+              A[(j + 1) + j * lda] = e[j];
+              d[j] = A[j + j * lda];
+            }
+          }
+
+          qr_tridiag_unblocked(n - i, A + i + i * lda, lda, &(d[i]), &(e[i]), &(tau[i]));
+        }
+
+        /** @brief Reduces the columns [c, c+nb) of the n x n matrix A to upper Hessenberg form, cf. LAPACK's xLAHR2.
+        *
+        * Returns the triangular factor T of the block reflector I - V T V^T as well as Y = A V T, where rows c+1 to n-1 of Y are computed here.
+        * The unit entry of the last reflector is left in A(c+nb, c+nb-1), the subdiagonal entry belonging there is returned.
+        */
+        template <typename NumericT>
+        NumericT qr_hessenberg_panel(std::size_t n, std::size_t c, std::size_t nb, NumericT * A, std::size_t lda,
+                                     NumericT * tau, NumericT * T, std::size_t ldt, NumericT * Y, std::size_t ldy)
+        {
+          std::size_t k0 = c + 1;   // first row affected by the reflectors of the panel
+          std::vector<NumericT> w(nb);
+          NumericT e_prev = 0;
+
+          for (std::size_t i = 0; i < nb; ++i)
+          {
+            std::size_t col = c + i;
+            NumericT * b = A + col * lda;
+            NumericT * V2 = A + (col + 1) + c * lda;   // rows col+1, ..., n-1 of the previous reflectors
+
+            if (i > 0)
+            {
+              // apply the previous reflectors from the right: A(k0:n, col) -= Y(k0:n, 0:i) * V(col, 0:i)^T
+              svd_gemv_n(n - k0, i, NumericT(-1), Y + k0, ldy, A + col + c * lda, lda, NumericT(1), b + k0, 1);
+
+              // apply the previous reflectors from the left: b = (I - V T^T V^T) b, where V = [V1; V2] with unit lower triangular V1:
+              for (std::size_t j = 0; j < i; ++j)
+              {
+                NumericT sum = b[k0 + j];
+                for (std::size_t r = j + 1; r < i; ++r)
+                  sum += A[(k0 + r) + (c + j) * lda] * b[k0 + r];
+                w[j] = sum;
+              }
+              svd_gemv_t(n - col - 1, i, NumericT(1), V2, lda, b + col + 1, 1, NumericT(1), &(w[0]), 1);
+
+              for (std::size_t j = i; j > 0; --j)
+              {
+                NumericT sum = 0;
+                for (std::size_t l = 0; l < j; ++l)
+                  sum += T[l + (j - 1) * ldt] * w[l];
+                w[j - 1] = sum;
+              }
+
+              svd_gemv_n(n - col - 1, i, NumericT(-1), V2, lda, &(w[0]), 1, NumericT(1), b + col + 1, 1);
+              for (std::size_t r = i; r > 0; --r)
+              {
+                NumericT sum = w[r - 1];
+                for (std::size_t j = 0; j + 1 < r; ++j)
+                  sum += A[(k0 + r - 1) + (c + j) * lda] * w[j];
+                b[k0 + r - 1] -= sum;
+              }
+
+              A[col + (col - 1) * lda] = e_prev;
+            }
+
+            // generate reflection H(i) to annihilate A(col+2:n, col)
+            std::size_t len = n - col - 1;
+            tau[i] = svd_householder(len, b[col + 1], b + std::min(col + 2, n - 1), 1);
+            e_prev = b[col + 1];
+            b[col + 1] = NumericT(1);
+            NumericT * v   = b + col + 1;
+            NumericT * Y_i = Y + i * ldy;
+            NumericT * T_i = T + i * ldt;
+
+            // Y(k0:n, i) = tau * (A(k0:n, col+1:n) * v - Y(k0:n, 0:i) * (V(:, 0:i)^T v))
+            svd_gemv_n(n - k0, len, NumericT(1), A + k0 + (col + 1) * lda, lda, v, 1, NumericT(0), Y_i + k0, 1);
+            svd_gemv_t(len, i, NumericT(1), V2, lda, v, 1, NumericT(0), T_i, 1);
+            svd_gemv_n(n - k0, i, NumericT(-1), Y + k0, ldy, T_i, 1, NumericT(1), Y_i + k0, 1);
+            for (std::size_t r = k0; r < n; ++r)
+              Y_i[r] *= tau[i];
+
+            // T(0:i, i) = -tau * T(0:i, 0:i) * (V(:, 0:i)^T v),  T(i, i) = tau
+            for (std::size_t j = 0; j < i; ++j)
+            {
+              NumericT sum = 0;
+              for (std::size_t l = j; l < i; ++l)
+                sum += T[j + l * ldt] * T_i[l];
+              T_i[j] = -tau[i] * sum;
+            }
+            T_i[i] = tau[i];
+          }
+
+          return e_prev;
+        }
+
+        /** @brief Unblocked reduction of the columns [c, n-2) of the n x n matrix A to upper Hessenberg form, cf. LAPACK's xGEHD2 */
+        template <typename NumericT>
+        void qr_hessenberg_unblocked(std::size_t n, std::size_t c, NumericT * A, std::size_t lda, NumericT * tau)
+        {
+          std::vector<NumericT> work(n);
+
+          for (std::size_t col = c; col + 1 < n; ++col)
+          {
+            std::size_t len = n - col - 1;
+            NumericT * v = A + (col + 1) + col * lda;
+
+            tau[col] = svd_householder(len, *v, A + std::min(col + 2, n - 1) + col * lda, 1);
+            if (tau[col] != 0)
+            {
+              NumericT alpha = *v;
+              *v = NumericT(1);
+
+              // apply H(col) from the right to A(0:n, col+1:n):
+              svd_gemv_n(n, len, NumericT(1), A + (col + 1) * lda, lda, v, 1, NumericT(0), &(work[0]), 1);
+              svd_ger(n, len, tau[col], &(work[0]), 1, v, 1, A + (col + 1) * lda, lda);
+
+              // apply H(col) from the left to A(col+1:n, col+1:n):
+              svd_gemv_t(len, len, NumericT(1), A + (col + 1) + (col + 1) * lda, lda, v, 1, NumericT(0), &(work[0]), 1);
+              svd_ger(len, len, tau[col], v, 1, &(work[0]), 1, A + (col + 1) + (col + 1) * lda, lda);
+
+              *v = alpha;
+            }
+          }
+        }
+
+        /** @brief Blocked reduction of the n x n matrix A to upper Hessenberg form H = Q^T A Q, cf. LAPACK's xGEHRD.
+        *
+        * The reflectors defining Q are stored below the subdiagonal of A.
+        */
+        template <typename NumericT>
+        void qr_hessenberg(std::size_t n, NumericT * A, std::size_t lda, std::vector<NumericT> & tau)
+        {
+          std::size_t const nb = qr_method_blocking::block_size;
+
+          std::vector<NumericT> T(nb * nb);
+          std::vector<NumericT> Y(n * nb);
+          std::vector<NumericT> V;
+          std::vector<NumericT> W1(nb * n);
+          std::vector<NumericT> W2(nb * n);
+
+          std::size_t c = 0;
+          for (; c + qr_method_blocking::crossover < n; c += nb)
+          {
+            std::size_t k0 = c + 1;
+            std::size_t rows = n - k0;
+            std::size_t cols = n - c - nb;
+
+            std::fill(T.begin(), T.end(), NumericT(0));
+            NumericT e_last = qr_hessenberg_panel(n, c, nb, A, lda, &(tau[c]), &(T[0]), nb, &(Y[0]), n);
+
+            // reflectors of the panel with explicit zeros and unit diagonal:
+            V.resize(rows * nb);
+            for (std::size_t j = 0; j < nb; ++j)
+              for (std::size_t r = 0; r < rows; ++r)
+                V[r + j * rows] = (r < j) ? NumericT(0) : ((r == j) ? NumericT(1) : A[(k0 + r) + (c + j) * lda]);
+            A[(c + nb) + (c + nb - 1) * lda] = e_last;
+
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_V(&(V[0]), 0, 0, 1, 1, rows, nb);
+            matrix_array_wrapper<NumericT const, column_major_tag, true>  wrapper_Vt(&(V[0]), 0, 0, 1, 1, rows, nb);
+            matrix_array_wrapper<NumericT const, column_major_tag, true>  wrapper_Vt_trailing(&(V[0]), nb - 1, 0, 1, 1, rows, nb);
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_T(&(T[0]), 0, 0, 1, 1, nb, nb);
+            matrix_array_wrapper<NumericT const, column_major_tag, true>  wrapper_Tt(&(T[0]), 0, 0, 1, 1, nb, nb);
+            matrix_array_wrapper<NumericT,       column_major_tag, false> wrapper_Y(&(Y[0]), 0, 0, 1, 1, n, nb);
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_Y_const(&(Y[0]), 0, 0, 1, 1, n, nb);
+            matrix_array_wrapper<NumericT,       column_major_tag, false> wrapper_W1(&(W1[0]), 0, 0, 1, 1, nb, n);
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_W1_const(&(W1[0]), 0, 0, 1, 1, nb, n);
+            matrix_array_wrapper<NumericT,       column_major_tag, false> wrapper_W2(&(W2[0]), 0, 0, 1, 1, nb, n);
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_W2_const(&(W2[0]), 0, 0, 1, 1, nb, n);
+
+            // rows 0, ..., c of Y = A * V * T:
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_A_top(A, 0, k0, 1, 1, lda, n);
+            matrix_array_wrapper<NumericT,       column_major_tag, false> wrapper_AV(&(W1[0]), 0, 0, 1, 1, n, nb);
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_AV_const(&(W1[0]), 0, 0, 1, 1, n, nb);
+            detail::prod(wrapper_A_top, wrapper_V, wrapper_AV, k0, nb, rows, NumericT(1), NumericT(0));
+            detail::prod(wrapper_AV_const, wrapper_T, wrapper_Y, k0, nb, nb, NumericT(1), NumericT(0));
+
+            // apply the block reflector from the right to the trailing columns and to the top rows of the panel columns:
+            matrix_array_wrapper<NumericT, column_major_tag, false> wrapper_A_right(A, 0, c + nb, 1, 1, lda, n);
+            matrix_array_wrapper<NumericT, column_major_tag, false> wrapper_A_panel(A, 0, k0, 1, 1, lda, n);
+            detail::prod(wrapper_Y_const, wrapper_Vt_trailing, wrapper_A_right, n, cols, nb, NumericT(-1), NumericT(1));
+            detail::prod(wrapper_Y_const, wrapper_Vt, wrapper_A_panel, k0, nb - 1, nb, NumericT(-1), NumericT(1));
+
+            // apply the block reflector from the left to the trailing columns: A = (I - V T^T V^T) A
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_A_sub_const(A, k0, c + nb, 1, 1, lda, n);
+            matrix_array_wrapper<NumericT,       column_major_tag, false> wrapper_A_sub(A, k0, c + nb, 1, 1, lda, n);
+            detail::prod(wrapper_Vt, wrapper_A_sub_const, wrapper_W1, nb, cols, rows, NumericT(1), NumericT(0));
+            detail::prod(wrapper_Tt, wrapper_W1_const, wrapper_W2, nb, cols, nb, NumericT(1), NumericT(0));
+            detail::prod(wrapper_V, wrapper_W2_const, wrapper_A_sub, rows, cols, nb, NumericT(-1), NumericT(1));
+          }
+
+          qr_hessenberg_unblocked(n, c, A, lda, &(tau[0]));
+        }
+
+        /** @brief Forms the orthogonal matrix Q = H(0) H(1) ... H(n-2) from the reflectors stored below the subdiagonal of the n x n matrix A */
+        template <typename NumericT>
+        void qr_form_orthogonal(std::size_t n, NumericT const * A, std::size_t lda, std::vector<NumericT> const & tau, std::vector<NumericT> & Q)
+        {
+          Q.assign(n * n, NumericT(0));
+          for (std::size_t i = 0; i < n; ++i)
+            Q[i + i * n] = NumericT(1);
+
+          if (n < 2)
+            return;
+
+          std::size_t r = n - 1;
+          std::vector<NumericT> reflectors(r * r);
+          for (std::size_t j = 0; j < r; ++j)
+            for (std::size_t i = 0; i < r; ++i)
+              reflectors[i + j * r] = (i < j) ? NumericT(0) : ((i == j) ? NumericT(1) : A[(i + 1) + j * lda]);
+          svd_form_orthogonal(reflectors, r, r, &(tau[0]), &(Q[0]), n, n, 1);
+        }
+
+        /** @brief Symmetric tridiagonal QL algorithm with implicit shifts (tql2), where the rotations are applied to the columns of the n x n matrix Q in batches.
+        *
+        * @param d   The diagonal of the tridiagonal matrix. Holds the eigenvalues on return
+        * @param e   The subdiagonal, where e[i] is the entry in row i+1 and column i. Destroyed on return
+        *
+        * This is derived from the Algol procedures tql2, by Bowdler, Martin, Reinsch, and Wilkinson,
+        * Handbook for Auto. Comp., Vol.ii-Linear Algebra, and the corresponding Fortran subroutine in EISPACK.
+        */
+        template <typename NumericT>
+        void qr_tql2(std::vector<NumericT> & d, std::vector<NumericT> & e, NumericT * Q, std::size_t n)
+        {
+          NumericT const eps = std::numeric_limits<NumericT>::epsilon();
+
+          std::vector< svd_rotation<NumericT> > rotations;
+
+          if (n == 0)
+            return;
+          e[n - 1] = 0;
+
+          NumericT f = 0;
+          NumericT tst1 = 0;
+
+          for (std::size_t l = 0; l < n; l++)
+          {
+            // find small subdiagonal element
+            tst1 = std::max<NumericT>(tst1, std::fabs(d[l]) + std::fabs(e[l]));
+            std::size_t m = l;
+            while (m < n - 1)
+            {
+              if (std::fabs(e[m]) <= eps * tst1)
+                break;
+              m++;
+            }
+
+            // if m == l, d[l] is an eigenvalue, otherwise, iterate
+            if (m > l)
+            {
+              std::size_t iter = 0;
+              do
+              {
+                ++iter;
+
+                // Q is not needed for the iteration, hence rotations are only applied once enough of them are pending:
+                if (rotations.size() > svd_blocking::rotation_batch)
+                {
+                  svd_apply_rotations(rotations, Q, n, n);
+                  rotations.clear();
+                }
+
+                // compute implicit shift
+                NumericT g = d[l];
+                NumericT p = (d[l + 1] - g) / (2 * e[l]);
+                NumericT r = svd_hypot(p, NumericT(1));
+                if (p < 0)
+                  r = -r;
+
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                NumericT dl1 = d[l + 1];
+                NumericT h = g - d[l];
+                for (std::size_t i = l + 2; i < n; i++)
+                  d[i] -= h;
+
+                f = f + h;
+
+                // implicit QL transformation
+                p = d[m];
+                NumericT c = 1;
+                NumericT c2 = c;
+                NumericT c3 = c;
+                NumericT el1 = e[l + 1];
+                NumericT s = 0;
+                NumericT s2 = 0;
+                for (std::size_t i = m; i-- > l; )
+                {
+                  c3 = c2;
+                  c2 = c;
+                  s2 = s;
+                  g = c * e[i];
+                  h = c * p;
+                  r = svd_hypot(p, e[i]);
+                  e[i + 1] = s * r;
+                  s = e[i] / r;
+                  c = p / r;
+                  p = c * d[i] - s * g;
+                  d[i + 1] = h + s * (c * g + s * d[i]);
+
+                  rotations.push_back(svd_rotation<NumericT>(i + 1, i, c, s));
+                }
+
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+              }
+              while (std::fabs(e[l]) > eps * tst1 && iter < qr_method_blocking::max_iter);
+            }
+            d[l] = d[l] + f;
+            e[l] = 0;
+          }
+
+          svd_apply_rotations(rotations, Q, n, n);
+        }
+
+        /** @brief Complex scalar division (cdivr + i cdivi) = (xr + i xi) / (yr + i yi) */
+        template <typename T>
+        void cdiv(T xr, T xi, T yr, T yi, T& cdivr, T& cdivi)
+        {
+          T r;
+          T d;
+          if (std::fabs(yr) > std::fabs(yi))
+          {
+            r = yi / yr;
+            d = yr + r * yi;
+            cdivr = (xr + r * xi) / d;
+            cdivi = (xi - r * xr) / d;
+          }
+          else
+          {
+            r = yr / yi;
+            d = yi + r * yr;
+            cdivr = (r * xr + xi) / d;
+            cdivi = (r * xi - xr) / d;
+          }
+        }
+
+        /** @brief Applies the rotation of a converged real pair of eigenvalues to the columns n-1 and n of the first last_n rows of A */
+        template <typename NumericT, typename MatrixT>
+        void final_iter_update(MatrixT& A,
+                               int n,
+                               int last_n,
+                               NumericT q,
+                               NumericT p
+                              )
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (last_n > 4096)
+#endif
+          for (int i = 0; i < last_n; i++)
+          {
+            NumericT v_in = A(i, n);
+            NumericT z = A(i, n - 1);
+            A(i, n - 1) = q * z + p * v_in;
+            A(i, n) = q * v_in - p * z;
+          }
+        }
+
+        /** @brief Applies the reflections of a float QR step (stored in buf, five entries per step k) to the columns start_k, ..., n of a single row */
+        template <typename NumericT>
+        void update_float_QR_row(NumericT * a_row,
+                                 const std::vector<NumericT>& buf,
+                                 int start_k,
+                                 int n
+                                )
+        {
+          NumericT a_ik   = a_row[start_k];
+          NumericT a_ik_1 = 0;
+          NumericT a_ik_2 = 0;
+
+          if(start_k < n)
+            a_ik_1 = a_row[start_k + 1];
+
+          for(int k = start_k; k < n; k++)
+          {
+            bool notlast = (k != n - 1);
+
+            NumericT p = buf[5 * k] * a_ik + buf[5 * k + 1] * a_ik_1;
+
+            if (notlast)
+            {
+              a_ik_2 = a_row[k + 2];
+              p = p + buf[5 * k + 2] * a_ik_2;
+              a_ik_2 = a_ik_2 - p * buf[5 * k + 4];
+            }
+
+            a_row[k] = a_ik - p;
+            a_ik_1 = a_ik_1 - p * buf[5 * k + 3];
+
+            a_ik = a_ik_1;
+            a_ik_1 = a_ik_2;
+          }
+
+          if(start_k < n)
+            a_row[n] = a_ik;
+        }
+
+        /** @brief Same as update_float_QR_row(), but for four rows at once.
+        *
+        *  Each row is a chain of dependent operations along k, hence four independent chains are interleaved to keep the floating point units busy.
+        */
+        template <typename NumericT>
+        void update_float_QR_rows4(NumericT * r0, NumericT * r1, NumericT * r2, NumericT * r3,
+                                   const std::vector<NumericT>& buf,
+                                   int start_k,
+                                   int n
+                                  )
+        {
+          if (start_k >= n)
+            return;
+
+          NumericT x0 = r0[start_k],     x1 = r1[start_k],     x2 = r2[start_k],     x3 = r3[start_k];
+          NumericT y0 = r0[start_k + 1], y1 = r1[start_k + 1], y2 = r2[start_k + 1], y3 = r3[start_k + 1];
+
+          for(int k = start_k; k < n - 1; k++)
+          {
+            NumericT const * b = &(buf[5 * k]);
+
+            NumericT z0 = r0[k + 2], z1 = r1[k + 2], z2 = r2[k + 2], z3 = r3[k + 2];
+            NumericT p0 = b[0] * x0 + b[1] * y0 + b[2] * z0;
+            NumericT p1 = b[0] * x1 + b[1] * y1 + b[2] * z1;
+            NumericT p2 = b[0] * x2 + b[1] * y2 + b[2] * z2;
+            NumericT p3 = b[0] * x3 + b[1] * y3 + b[2] * z3;
+
+            r0[k] = x0 - p0;
+            r1[k] = x1 - p1;
+            r2[k] = x2 - p2;
+            r3[k] = x3 - p3;
+
+            x0 = y0 - p0 * b[3];
+            x1 = y1 - p1 * b[3];
+            x2 = y2 - p2 * b[3];
+            x3 = y3 - p3 * b[3];
+
+            y0 = z0 - p0 * b[4];
+            y1 = z1 - p1 * b[4];
+            y2 = z2 - p2 * b[4];
+            y3 = z3 - p3 * b[4];
+          }
+
+          // last step involves two columns only:
+          NumericT const * b = &(buf[5 * (n - 1)]);
+          NumericT p0 = b[0] * x0 + b[1] * y0;
+          NumericT p1 = b[0] * x1 + b[1] * y1;
+          NumericT p2 = b[0] * x2 + b[1] * y2;
+          NumericT p3 = b[0] * x3 + b[1] * y3;
+
+          r0[n - 1] = x0 - p0;
+          r1[n - 1] = x1 - p1;
+          r2[n - 1] = x2 - p2;
+          r3[n - 1] = x3 - p3;
+
+          r0[n] = y0 - p0 * b[3];
+          r1[n] = y1 - p1 * b[3];
+          r2[n] = y2 - p2 * b[3];
+          r3[n] = y3 - p3 * b[3];
+        }
+
+        /** @brief Applies the reflections of a float QR step to the columns m, ..., n of the first last_i rows of A. If is_triangular is true, row i is only updated from column i+1 on. */
+        template <typename NumericT, typename MatrixT>
+        void update_float_QR_column(MatrixT& A,
+                                    const std::vector<NumericT>& buf,
+                                    int m,
+                                    int n,
+                                    int last_i,
+                                    bool is_triangular
+                                   )
+        {
+          int block_num = (last_i + 3) / 4;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (last_i * (n - m) > 8192)
+#endif
+          for (int block = 0; block < block_num; block++)
+          {
+            int i = 4 * block;
+
+            // all four rows start at column m unless the triangular structure is to be exploited:
+            if (i + 4 <= last_i && (!is_triangular || i + 4 <= m))
+              update_float_QR_rows4(A.row(i), A.row(i + 1), A.row(i + 2), A.row(i + 3), buf, m, n);
+            else
+            {
+              for (int row = i; row < std::min(i + 4, last_i); row++)
+                update_float_QR_row(A.row(row), buf, is_triangular ? std::max(row + 1, m) : m, n);
+            }
+          }
+        }
+
+        /** @brief Dense square matrix with row-major storage, used for the Hessenberg matrix and the Schur vectors in hqr2 */
+        template <typename NumericT>
+        class FastMatrix
+        {
+        public:
+          FastMatrix()
+          {
+            size_ = 0;
+          }
+
+          FastMatrix(std::size_t sz)
+          {
+            size_ = sz;
+            data.resize(sz * sz);
+          }
+
+          NumericT& operator()(int i, int j)
+          {
+            return data[i * size_ + j];
+          }
+
+          std::size_t size() const
+          {
+            return size_;
+          }
+
+          NumericT* row(int i)
+          {
+            return &data[i * size_];
+          }
+
+          NumericT* begin()
+          {
+            return &data[0];
+          }
+
+          NumericT* end()
+          {
+            return &data[0] + data.size();
+          }
+
+          std::vector<NumericT> data;
+        private:
+          std::size_t size_;
+        };
+
+
+        /** @brief Applies the transformations of hqr2 to the columns of the row-major matrix V holding the Schur vectors */
+        template <typename NumericT>
+        class hqr2_updater
+        {
+        public:
+          hqr2_updater(FastMatrix<NumericT> & V) : V_(V) {}
+
+          void final_iter_update(int n, NumericT q, NumericT p)
+          {
+            detail::final_iter_update(V_, n, static_cast<int>(V_.size()), q, p);
+          }
+
+          void update_columns(std::vector<NumericT> const & buf, int m, int n)
+          {
+            detail::update_float_QR_column(V_, buf, m, n, static_cast<int>(V_.size()), false);
+          }
+
+        private:
+          FastMatrix<NumericT> & V_;
+        };
+
+        /** @brief Nonsymmetric reduction from Hessenberg to real Schur form, followed by the back-substitution for the eigenvectors of the quasi-triangular matrix.
+        *
+        * This is derived from the Algol procedure hqr2, by Martin and Wilkinson, Handbook for Auto. Comp.,
+        * Vol.ii-Linear Algebra, and the corresponding  Fortran subroutine in EISPACK.
+        * All transformations are also applied to the columns of the Schur vectors through V (see hqr2_updater), such that
+        * the eigenvectors are obtained as V * triu(H) on return. Returns false if H is zero, in which case no back-substitution takes place.
+        */
+        template <typename NumericT, typename UpdaterT, typename VectorT>
+        bool hqr2(FastMatrix<NumericT> & H, UpdaterT & V, VectorT & d, VectorT & e, NumericT eps)
+        {
+          int nn = static_cast<int>(H.size());
+
+          std::vector<NumericT> buf(5 * nn);
+
+          int n = nn - 1;
+
+          NumericT exshift = 0;
+          NumericT p = 0;
+          NumericT q = 0;
+          NumericT r = 0;
+          NumericT s = 0;
+          NumericT z = 0;
+          NumericT t;
+          NumericT w;
+          NumericT x;
+          NumericT y;
+
+          NumericT out1, out2;
+
+          // compute matrix norm
+          NumericT norm = 0;
+          for (int i = 0; i < nn; i++)
+          {
+            for (int j = std::max(i - 1, 0); j < nn; j++)
+              norm = norm + std::fabs(H(i, j));
+          }
+
+          // Outer loop over eigenvalue index
+          int iter = 0;
+          while (n >= 0)
+          {
+            // Look for single small sub-diagonal element
+            int l = n;
+            while (l > 0)
+            {
+              s = std::fabs(H(l - 1, l - 1)) + std::fabs(H(l, l));
+              if (s == 0) s = norm;
+              if (std::fabs(H(l, l - 1)) < eps * s)
+                break;
+
+              l--;
+            }
+
+            // Check for convergence
+            if (l == n)
+            {
+              // One root found
+              H(n, n) = H(n, n) + exshift;
+              d[n] = H(n, n);
+              e[n] = 0;
+              n--;
+              iter = 0;
+            }
+            else if (l == n - 1)
+            {
+              // Two roots found
+              w = H(n, n - 1) * H(n - 1, n);
+              p = (H(n - 1, n - 1) - H(n, n)) / 2;
+              q = p * p + w;
+              z = static_cast<NumericT>(std::sqrt(std::fabs(q)));
+              H(n, n) = H(n, n) + exshift;
+              H(n - 1, n - 1) = H(n - 1, n - 1) + exshift;
+              x = H(n, n);
+
+              if (q >= 0)
+              {
+                // Real pair
+                z = (p >= 0) ? (p + z) : (p - z);
+                d[n - 1] = x + z;
+                d[n] = d[n - 1];
+                if (z != 0)
+                  d[n] = x - w / z;
+                e[n - 1] = 0;
+                e[n] = 0;
+                x = H(n, n - 1);
+                s = std::fabs(x) + std::fabs(z);
+                p = x / s;
+                q = z / s;
+                r = static_cast<NumericT>(std::sqrt(p * p + q * q));
+                p = p / r;
+                q = q / r;
+
+                // Row modification
+                for (int j = n - 1; j < nn; j++)
+                {
+                  NumericT h_nj = H(n, j);
+                  z = H(n - 1, j);
+                  H(n - 1, j) = q * z + p * h_nj;
+                  H(n, j) = q * h_nj - p * z;
+                }
+
+                final_iter_update(H, n, n + 1, q, p);
+                V.final_iter_update(n, q, p);
+              }
+              else
+              {
+                // Complex pair
+                d[n - 1] = x + p;
+                d[n] = x + p;
+                e[n - 1] = z;
+                e[n] = -z;
+              }
+
+              n = n - 2;
+              iter = 0;
+            }
+            else
+            {
+              // No convergence yet
+
+              // Form shift
+              x = H(n, n);
+              y = 0;
+              w = 0;
+              if (l < n)
+              {
+                y = H(n - 1, n - 1);
+                w = H(n, n - 1) * H(n - 1, n);
+              }
+
+              // Wilkinson's original ad hoc shift
+              if (iter == 10)
+              {
+                exshift += x;
+                for (int i = 0; i <= n; i++)
+                  H(i, i) -= x;
+
+                s = std::fabs(H(n, n - 1)) + std::fabs(H(n - 1, n - 2));
+                x = y = 0.75 * s;
+                w = (-0.4375) * s * s;
+              }
+
+              // MATLAB's new ad hoc shift
+              if (iter == 30)
+              {
+                s = (y - x) / 2;
+                s = s * s + w;
+                if (s > 0)
+                {
+                  s = static_cast<NumericT>(std::sqrt(s));
+                  if (y < x) s = -s;
+                  s = x - w / ((y - x) / 2 + s);
+                  for (int i = 0; i <= n; i++)
+                    H(i, i) -= s;
+                  exshift += s;
+                  x = y = w = (NumericT)0.964;
+                }
+              }
+
+              iter = iter + 1;
+
+              // Look for two consecutive small sub-diagonal elements
+              int m = n - 2;
+              while (m >= l)
+              {
+                NumericT h_m1_m1 = H(m + 1, m + 1);
+                z = H(m, m);
+                r = x - z;
+                s = y - z;
+                p = (r * s - w) / H(m + 1, m) + H(m, m + 1);
+                q = h_m1_m1 - z - r - s;
+                r = H(m + 2, m + 1);
+                s = std::fabs(p) + std::fabs(q) + std::fabs(r);
+                p = p / s;
+                q = q / s;
+                r = r / s;
+                if (m == l)
+                  break;
+                if (std::fabs(H(m, m - 1)) * (std::fabs(q) + std::fabs(r)) < eps * (std::fabs(p) * (std::fabs(H(m - 1, m - 1)) + std::fabs(z) + std::fabs(h_m1_m1))))
+                  break;
+                m--;
+              }
+
+              for (int i = m + 2; i <= n; i++)
+              {
+                H(i, i - 2) = 0;
+                if (i > m + 2)
+                  H(i, i - 3) = 0;
+              }
+
+              // float QR step involving rows l:n and columns m:n
+              for (int k = m; k < n; k++)
+              {
+                bool notlast = (k != n - 1);
+                if (k != m)
+                {
+                  p = H(k, k - 1);
+                  q = H(k + 1, k - 1);
+                  r = (notlast ? H(k + 2, k - 1) : 0);
+                  x = std::fabs(p) + std::fabs(q) + std::fabs(r);
+                  if (x != 0)
+                  {
+                    p = p / x;
+                    q = q / x;
+                    r = r / x;
+                  }
+                }
+
+                if (x == 0)
+                {
+                  // the remaining reflections of this step are skipped, make sure they are not applied to the columns below:
+                  std::fill(buf.begin() + 5 * k, buf.begin() + 5 * n, NumericT(0));
+                  break;
+                }
+
+                s = static_cast<NumericT>(std::sqrt(p * p + q * q + r * r));
+                if (p < 0) s = -s;
+
+                if (s != 0)
+                {
+                  if (k != m)
+                    H(k, k - 1) = -s * x;
+                  else
+                    if (l != m)
+                      H(k, k - 1) = -H(k, k - 1);
+
+                  p = p + s;
+                  y = q / s;
+                  z = r / s;
+                  x = p / s;
+                  q = q / p;
+                  r = r / p;
+
+                  buf[5 * k] = x;
+                  buf[5 * k + 1] = y;
+                  buf[5 * k + 2] = z;
+                  buf[5 * k + 3] = q;
+                  buf[5 * k + 4] = r;
+
+
+                  NumericT* a_row_k = H.row(k);
+                  NumericT* a_row_k_1 = H.row(k + 1);
+                  NumericT* a_row_k_2 = H.row(k + 2);
+                  // Row modification
+                  for (int j = k; j < nn; j++)
+                  {
+                    NumericT h_kj = a_row_k[j];
+                    NumericT h_k1_j = a_row_k_1[j];
+
+                    p = h_kj + q * h_k1_j;
+                    if (notlast)
+                    {
+                      NumericT h_k2_j = a_row_k_2[j];
+                      p = p + r * h_k2_j;
+                      a_row_k_2[j] = h_k2_j - p * z;
+                    }
+
+                    a_row_k[j] = h_kj - p * x;
+                    a_row_k_1[j] = h_k1_j - p * y;
+                  }
+
+                  //H(k + 1, nn - 1) = h_kj;
+
+
+                  // Column modification
+                  for (int i = k; i < std::min(nn, k + 4); i++)
+                  {
+                    p = x * H(i, k) + y * H(i, k + 1);
+                    if (notlast)
+                    {
+                      p = p + z * H(i, k + 2);
+                      H(i, k + 2) = H(i, k + 2) - p * r;
+                    }
+
+                    H(i, k) = H(i, k) - p;
+                    H(i, k + 1) = H(i, k + 1) - p * q;
+                  }
+                }
+                else
+                {
+                  buf[5 * k] = 0;
+                  buf[5 * k + 1] = 0;
+                  buf[5 * k + 2] = 0;
+                  buf[5 * k + 3] = 0;
+                  buf[5 * k + 4] = 0;
+                }
+              }
+
+              update_float_QR_column(H, buf, m, n, n, true);
+              V.update_columns(buf, m, n);
+            }
+          }
+
+          // Backsubstitute to find vectors of upper triangular form
+          if (norm == 0)
+          {
+            return false;
+          }
+
+          for (n = nn - 1; n >= 0; n--)
+          {
+            p = d[n];
+            q = e[n];
+
+            // Real vector
+            if (q == 0)
+            {
+              int l = n;
+              H(n, n) = 1;
+              for (int i = n - 1; i >= 0; i--)
+              {
+                w = H(i, i) - p;
+                r = 0;
+                for (int j = l; j <= n; j++)
+                  r = r + H(i, j) * H(j, n);
+
+                if (e[i] < 0)
+                {
+                  z = w;
+                  s = r;
+                }
+                else
+                {
+                  l = i;
+                  if (e[i] == 0)
+                  {
+                    H(i, n) = (w != 0) ? (-r / w) : (-r / (eps * norm));
+                  }
+                  else
+                  {
+                    // Solve real equations
+                    x = H(i, i + 1);
+                    y = H(i + 1, i);
+                    q = (d[i] - p) * (d[i] - p) + e[i] * e[i];
+                    t = (x * s - z * r) / q;
+                    H(i, n) = t;
+                    H(i + 1, n) = (std::fabs(x) > std::fabs(z)) ? ((-r - w * t) / x) : ((-s - y * t) / z);
+                  }
+
+                  // Overflow control
+                  t = std::fabs(H(i, n));
+                  if ((eps * t) * t > 1)
+                    for (int j = i; j <= n; j++)
+                      H(j, n) /= t;
+                }
+              }
+            }
+            else if (q < 0)
+            {
+              // Complex vector
+              int l = n - 1;
+
+              // Last vector component imaginary so matrix is triangular
+              if (std::fabs(H(n, n - 1)) > std::fabs(H(n - 1, n)))
+              {
+                H(n - 1, n - 1) = q / H(n, n - 1);
+                H(n - 1, n) = -(H(n, n) - p) / H(n, n - 1);
+              }
+              else
+              {
+                cdiv<NumericT>(0, -H(n - 1, n), H(n - 1, n - 1) - p, q, out1, out2);
+
+                H(n - 1, n - 1) = out1;
+                H(n - 1, n) = out2;
+              }
+
+              H(n, n - 1) = 0;
+              H(n, n) = 1;
+              for (int i = n - 2; i >= 0; i--)
+              {
+                NumericT ra, sa, vr, vi;
+                ra = 0;
+                sa = 0;
+                for (int j = l; j <= n; j++)
+                {
+                  NumericT h_ij = H(i, j);
+                  ra = ra + h_ij * H(j, n - 1);
+                  sa = sa + h_ij * H(j, n);
+                }
+
+                w = H(i, i) - p;
+
+                if (e[i] < 0)
+                {
+                  z = w;
+                  r = ra;
+                  s = sa;
+                }
+                else
+                {
+                  l = i;
+                  if (e[i] == 0)
+                  {
+                    cdiv<NumericT>(-ra, -sa, w, q, out1, out2);
+                    H(i, n - 1) = out1;
+                    H(i, n) = out2;
+                  }
+                  else
+                  {
+                    // Solve complex equations
+                    x = H(i, i + 1);
+                    y = H(i + 1, i);
+                    vr = (d[i] - p) * (d[i] - p) + e[i] * e[i] - q * q;
+                    vi = (d[i] - p) * 2 * q;
+                    if ( (vr == 0) && (vi == 0) )
+                      vr = eps * norm * (std::fabs(w) + std::fabs(q) + std::fabs(x) + std::fabs(y) + std::fabs(z));
+
+                    cdiv<NumericT>(x * r - z * ra + q * sa, x * s - z * sa - q * ra, vr, vi, out1, out2);
+
+                    H(i, n - 1) = out1;
+                    H(i, n) = out2;
+
+
+                    if (std::fabs(x) > (std::fabs(z) + std::fabs(q)))
+                    {
+                      H(i + 1, n - 1) = (-ra - w * H(i, n - 1) + q * H(i, n)) / x;
+                      H(i + 1, n) = (-sa - w * H(i, n) - q * H(i, n - 1)) / x;
+                    }
+                    else
+                    {
+                      cdiv<NumericT>(-r - y * H(i, n - 1), -s - y * H(i, n), z, q, out1, out2);
+
+                      H(i + 1, n - 1) = out1;
+                      H(i + 1, n) = out2;
+                    }
+                  }
+
+                  // Overflow control
+                  t = std::max(std::fabs(H(i, n - 1)), std::fabs(H(i, n)));
+                  if ((eps * t) * t > 1)
+                  {
+                    for (int j = i; j <= n; j++)
+                    {
+                      H(j, n - 1) /= t;
+                      H(j, n) /= t;
+                    }
+                  }
+                }
+              }
+            }
+          }
+
+
+          return true;
+        }
+
+      } //namespace detail
+
+
+      /** @brief Computes the eigenvalues and eigenvectors of a square matrix by the QR method.
+      *
+      * @param A             The input matrix. Overwritten with the block diagonal matrix of eigenvalues on return (2x2 blocks for complex conjugate pairs)
+      * @param Q             The eigenvectors (as columns) on return. For a complex conjugate pair, the two columns hold the real and the imaginary part.
+      * @param D             Real parts of the eigenvalues
+      * @param E             Imaginary parts of the eigenvalues (zero for symmetric matrices)
+      * @param is_symmetric  If true, A is assumed to be symmetric
+      */
+      template <typename NumericT, typename F, typename VectorType>
+      void qr_method(matrix_base<NumericT, F> & A,
+                     matrix_base<NumericT, F> & Q,
+                     VectorType & D,
+                     VectorType & E,
+                     bool is_symmetric)
+      {
+        std::size_t n = viennacl::traits::size1(A);
+
+        detail::matrix_array_wrapper<NumericT, typename F::orientation_category, false>
+          wrapper_A(detail::extract_raw_pointer<NumericT>(A),
+                    viennacl::traits::start1(A),  viennacl::traits::start2(A),
+                    viennacl::traits::stride1(A), viennacl::traits::stride2(A),
+                    viennacl::traits::internal_size1(A), viennacl::traits::internal_size2(A));
+        detail::matrix_array_wrapper<NumericT, typename F::orientation_category, false>
+          wrapper_Q(detail::extract_raw_pointer<NumericT>(Q),
+                    viennacl::traits::start1(Q),  viennacl::traits::start2(Q),
+                    viennacl::traits::stride1(Q), viennacl::traits::stride2(Q),
+                    viennacl::traits::internal_size1(Q), viennacl::traits::internal_size2(Q));
+
+        D.resize(n);
+        E.resize(n);
+        if (n == 0)
+          return;
+
+        std::vector<NumericT> work(n * n);
+        for (std::size_t j = 0; j < n; ++j)
+          for (std::size_t i = 0; i < n; ++i)
+            work[i + j * n] = wrapper_A(i, j);
+
+        std::vector<NumericT> d(n), e(n), tau(n);
+        std::vector<NumericT> eigenvectors;
+
+        if (is_symmetric)
+        {
+          // A = Q * T * Q^T with tridiagonal T, followed by T = Q_T * diag(d) * Q_T^T:
+          detail::qr_tridiag(n, &(work[0]), n, d, e, tau);
+          detail::qr_form_orthogonal(n, &(work[0]), n, tau, eigenvectors);
+          detail::qr_tql2(d, e, &(eigenvectors[0]), n);
+        }
+        else
+        {
+          // A = Q * H * Q^T with upper Hessenberg H, followed by the reduction of H to real Schur form:
+          detail::qr_hessenberg(n, &(work[0]), n, tau);
+          detail::qr_form_orthogonal(n, &(work[0]), n, tau, eigenvectors);
+
+          detail::FastMatrix<NumericT> H(n), V(n);
+          for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+            {
+              H(static_cast<int>(i), static_cast<int>(j)) = (i > j + 1) ? NumericT(0) : work[i + j * n];
+              V(static_cast<int>(i), static_cast<int>(j)) = eigenvectors[i + j * n];
+            }
+
+          detail::hqr2_updater<NumericT> updater(V);
+          if (detail::hqr2(H, updater, d, e, NumericT(2) * std::numeric_limits<NumericT>::epsilon()))
+          {
+            // eigenvectors = V * triu(H)
+            for (std::size_t i = 1; i < n; ++i)
+              for (std::size_t j = 0; j < i; ++j)
+                H(static_cast<int>(i), static_cast<int>(j)) = 0;
+
+            detail::matrix_array_wrapper<NumericT const, row_major_tag, false>    wrapper_V(V.begin(), 0, 0, 1, 1, n, n);
+            detail::matrix_array_wrapper<NumericT const, row_major_tag, false>    wrapper_H(H.begin(), 0, 0, 1, 1, n, n);
+            detail::matrix_array_wrapper<NumericT,       column_major_tag, false> wrapper_X(&(eigenvectors[0]), 0, 0, 1, 1, n, n);
+            detail::prod(wrapper_V, wrapper_H, wrapper_X, n, n, n, NumericT(1), NumericT(0));
+          }
+          else
+          {
+            for (std::size_t i = 0; i < n; ++i)
+              for (std::size_t j = 0; j < n; ++j)
+                eigenvectors[i + j * n] = V(static_cast<int>(i), static_cast<int>(j));
+          }
+        }
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long row = 0; row < static_cast<long>(n); ++row)
+        {
+          std::size_t i = static_cast<std::size_t>(row);
+          for (std::size_t j = 0; j < n; ++j)
+          {
+            wrapper_Q(i, j) = eigenvectors[i + j * n];
+            wrapper_A(i, j) = 0;
+          }
+        }
+
+        // eigenvalues, with 2x2 blocks for complex conjugate pairs:
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          D[i] = d[i];
+          E[i] = is_symmetric ? NumericT(0) : e[i];
+
+          wrapper_A(i, i) = d[i];
+          if (!is_symmetric && e[i] != 0 && i + 1 < n)
+          {
+            D[i + 1] = d[i + 1];
+            E[i + 1] = e[i + 1];
+
+            wrapper_A(i, i + 1) = e[i];
+            wrapper_A(i + 1, i) = -e[i];
+            wrapper_A(i + 1, i + 1) = d[i + 1];
+            ++i;
+          }
+        }
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
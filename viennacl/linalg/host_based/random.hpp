@@ -0,0 +1,357 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_RANDOM_HPP_
+#define VIENNACL_LINALG_HOST_BASED_RANDOM_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/random.hpp
+    @brief Counter-based generation of random numbers on the CPU using a single thread or OpenMP.
+
+    The generator is Philox4x32-10 (Salmon et al., "Parallel random numbers: As easy as 1, 2, 3", SC'11).
+    Each call of the generator maps a 64-bit block counter and the 32-bit seed to four independent 32-bit words,
+    from which a fixed number of consecutive entries is computed. Since the counter of an entry only depends on its logical index,
+    the result depends neither on the number of threads nor on padding, offsets, and strides.
+*/
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Returns the high and the low 32 bits of the 64-bit product a * b. Falls back to 16-bit halves if 'unsigned long' has only 32 bits. */
+        inline void philox_mulhilo(unsigned int a, unsigned int b, unsigned int & hi, unsigned int & lo)
+        {
+          if (sizeof(unsigned long) >= 8)
+          {
+            unsigned long product = static_cast<unsigned long>(a) * static_cast<unsigned long>(b);
+            hi = static_cast<unsigned int>((product >> 16) >> 16);
+            lo = static_cast<unsigned int>(product);
+            return;
+          }
+
+          unsigned int a_lo = a & 0xFFFF, a_hi = a >> 16;
+          unsigned int b_lo = b & 0xFFFF, b_hi = b >> 16;
+
+          unsigned int t = a_lo * b_lo;
+          unsigned int u = a_hi * b_lo + (t >> 16);
+          unsigned int v = a_lo * b_hi + (u & 0xFFFF);
+
+          hi = a_hi * b_hi + (u >> 16) + (v >> 16);
+          lo = a * b;
+        }
+
+        /** @brief Number of blocks for which the generator is evaluated at once. The rounds are applied lane by lane, so the compiler can vectorize them. */
+        static const std::size_t random_batch_size = 64;
+
+        /** @brief Philox4x32 with ten rounds applied to 'num' counters, whose four words are stored in the separate arrays c0, c1, c2, c3. The results overwrite the counters. */
+        inline void philox4x32_10(unsigned int * c0, unsigned int * c1, unsigned int * c2, unsigned int * c3, std::size_t num,
+                                  unsigned int key0, unsigned int key1)
+        {
+          for (unsigned int round = 0; round < 10; ++round)
+          {
+            for (std::size_t i = 0; i < num; ++i)
+            {
+              unsigned int hi0, lo0, hi1, lo1;
+              philox_mulhilo(0xD2511F53u, c0[i], hi0, lo0);
+              philox_mulhilo(0xCD9E8D57u, c2[i], hi1, lo1);
+
+              unsigned int w1 = c1[i];
+              unsigned int w3 = c3[i];
+              c0[i] = hi1 ^ w1 ^ key0;
+              c1[i] = lo1;
+              c2[i] = hi0 ^ w3 ^ key1;
+              c3[i] = lo0;
+            }
+
+            key0 += 0x9E3779B9u;
+            key1 += 0xBB67AE85u;
+          }
+        }
+
+        // The conversions below only use the upper bits of each word, which fit into a signed int. This allows for vectorized int-to-float conversions.
+
+        /** @brief Maps a 32-bit word to [0, 1) (flag 'open_at_zero' false) or (0, 1] (flag true) using the 24 most significant bits */
+        inline float random_word_to_float(unsigned int w, bool open_at_zero)
+        {
+          return (static_cast<float>(static_cast<int>(w >> 8)) + (open_at_zero ? 1.0f : 0.0f)) * (1.0f / 16777216.0f);
+        }
+
+        /** @brief Maps two 32-bit words to [0, 1) (flag 'open_at_zero' false) or (0, 1] (flag true) using 53 random bits */
+        inline double random_words_to_double(unsigned int w0, unsigned int w1, bool open_at_zero)
+        {
+          double bits = static_cast<double>(static_cast<int>(w0 >> 5)) * 67108864.0 + static_cast<double>(static_cast<int>(w1 >> 6));
+          return (bits + (open_at_zero ? 1.0 : 0.0)) * (1.0 / 9007199254740992.0);
+        }
+
+        /** @brief Returns the floating point number next to 'b' in the direction of 'a' (C99 nextafter(), which is not available in C++98) */
+        template <typename NumericT>
+        NumericT random_next_toward(NumericT b, NumericT a)
+        {
+          if (!(a < b) && !(b < a))
+            return b;
+          if (b == 0)
+            return (a < b) ? -std::numeric_limits<NumericT>::denorm_min() : std::numeric_limits<NumericT>::denorm_min();
+
+          int exponent;
+          NumericT mantissa = std::frexp(b, &exponent);  // |mantissa| in [0.5, 1)
+          NumericT ulp = std::ldexp(NumericT(1), exponent - std::numeric_limits<NumericT>::digits);
+          bool toward_zero = (a < b) == (b > 0);
+          if (toward_zero && std::fabs(mantissa) == NumericT(0.5))  // spacing halves below a power of two
+            ulp /= NumericT(2);
+          ulp = std::max(ulp, std::numeric_limits<NumericT>::denorm_min());
+
+          return (a < b) ? b - ulp : b + ulp;
+        }
+
+        /** @brief Clamps 'value' to the bound 'last', which is the value next to b in the direction of a, cf. random_next_toward() */
+        template <typename NumericT>
+        NumericT random_clamp(NumericT value, NumericT last, bool ascending)
+        {
+          return ascending ? std::min(value, last) : std::max(value, last);
+        }
+
+        /** @brief Uniformly distributed values in [a, b). Four entries per block for float.
+        *
+        * a + (b - a) * u may round to b for u close to one, hence the values are clamped to 'last', the largest float below b.
+        */
+        inline void random_uniform_batch(unsigned int const * c0, unsigned int const * c1, unsigned int const * c2, unsigned int const * c3, std::size_t num,
+                                         float * out, float a, float b, float last)
+        {
+          bool ascending = (a < b);
+          for (std::size_t i = 0; i < num; ++i)
+          {
+            out[4*i  ] = random_clamp(a + (b - a) * random_word_to_float(c0[i], false), last, ascending);
+            out[4*i+1] = random_clamp(a + (b - a) * random_word_to_float(c1[i], false), last, ascending);
+            out[4*i+2] = random_clamp(a + (b - a) * random_word_to_float(c2[i], false), last, ascending);
+            out[4*i+3] = random_clamp(a + (b - a) * random_word_to_float(c3[i], false), last, ascending);
+          }
+        }
+
+        /** @brief Two entries per block for double, each using 53 random bits */
+        inline void random_uniform_batch(unsigned int const * c0, unsigned int const * c1, unsigned int const * c2, unsigned int const * c3, std::size_t num,
+                                         double * out, double a, double b, double last)
+        {
+          bool ascending = (a < b);
+          for (std::size_t i = 0; i < num; ++i)
+          {
+            out[2*i  ] = random_clamp(a + (b - a) * random_words_to_double(c0[i], c1[i], false), last, ascending);
+            out[2*i+1] = random_clamp(a + (b - a) * random_words_to_double(c2[i], c3[i], false), last, ascending);
+          }
+        }
+
+        /** @brief Box-Muller transform of two uniform random values, the first of which must be in (0, 1] */
+        template <typename NumericT>
+        void box_muller(NumericT u1, NumericT u2, NumericT mu, NumericT sigma, NumericT * out)
+        {
+          NumericT radius = sigma * std::sqrt(NumericT(-2) * std::log(u1));
+          NumericT angle  = NumericT(6.283185307179586476925286766559) * u2;
+          out[0] = mu + radius * std::cos(angle);
+          out[1] = mu + radius * std::sin(angle);
+        }
+
+        /** @brief Normally distributed values by the Box-Muller transform. Four entries per block for float. */
+        inline void random_gaussian_batch(unsigned int const * c0, unsigned int const * c1, unsigned int const * c2, unsigned int const * c3, std::size_t num,
+                                          float * out, float mu, float sigma)
+        {
+          for (std::size_t i = 0; i < num; ++i)
+          {
+            box_muller(random_word_to_float(c0[i], true), random_word_to_float(c1[i], false), mu, sigma, out + 4*i);
+            box_muller(random_word_to_float(c2[i], true), random_word_to_float(c3[i], false), mu, sigma, out + 4*i + 2);
+          }
+        }
+
+        /** @brief Two entries per block for double */
+        inline void random_gaussian_batch(unsigned int const * c0, unsigned int const * c1, unsigned int const * c2, unsigned int const * c3, std::size_t num,
+                                          double * out, double mu, double sigma)
+        {
+          for (std::size_t i = 0; i < num; ++i)
+            box_muller(random_words_to_double(c0[i], c1[i], true), random_words_to_double(c2[i], c3[i], false), mu, sigma, out + 2*i);
+        }
+
+        /** @brief Functor computing uniformly distributed entries from the random words of a batch of blocks */
+        template <typename NumericT>
+        struct random_uniform_generator
+        {
+          enum { values_per_block = (sizeof(NumericT) == sizeof(float)) ? 4 : 2 };
+
+          random_uniform_generator(NumericT a, NumericT b) : a_(a), b_(b), last_(random_next_toward(b, a)) {}
+
+          void operator()(unsigned int const * c0, unsigned int const * c1, unsigned int const * c2, unsigned int const * c3, std::size_t num, NumericT * out) const
+          {
+            random_uniform_batch(c0, c1, c2, c3, num, out, a_, b_, last_);
+          }
+
+          NumericT a_;
+          NumericT b_;
+          NumericT last_;
+        };
+
+        /** @brief Functor computing normally distributed entries from the random words of a batch of blocks */
+        template <typename NumericT>
+        struct random_gaussian_generator
+        {
+          enum { values_per_block = (sizeof(NumericT) == sizeof(float)) ? 4 : 2 };
+
+          random_gaussian_generator(NumericT mu, NumericT sigma) : mu_(mu), sigma_(sigma) {}
+
+          void operator()(unsigned int const * c0, unsigned int const * c1, unsigned int const * c2, unsigned int const * c3, std::size_t num, NumericT * out) const
+          {
+            random_gaussian_batch(c0, c1, c2, c3, num, out, mu_, sigma_);
+          }
+
+          NumericT mu_;
+          NumericT sigma_;
+        };
+
+        /** @brief Fills a strided two-dimensional array with random values.
+        *
+        * The entry j of line l has the logical index k = l * line_size + j and is located at data[start + l * line_inc + j * inc].
+        * Block b holds the logical indices [b * values_per_block, (b+1) * values_per_block) and is generated from the counter (b, 0, 0, 0).
+        */
+        template <typename NumericT, typename GeneratorT>
+        void random_fill(NumericT * data,
+                         std::size_t start, std::size_t inc, std::size_t line_inc,
+                         std::size_t num_lines, std::size_t line_size,
+                         GeneratorT const & gen, unsigned int seed)
+        {
+          std::size_t const values_per_block = GeneratorT::values_per_block;
+          std::size_t total_size = num_lines * line_size;
+          std::size_t num_blocks = (total_size + values_per_block - 1) / values_per_block;
+          long num_batches = static_cast<long>((num_blocks + random_batch_size - 1) / random_batch_size);
+          bool is_contiguous = (inc == 1 && (num_lines == 1 || line_inc == line_size));
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (total_size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+          for (long batch = 0; batch < num_batches; ++batch)
+          {
+            std::size_t block_begin = static_cast<std::size_t>(batch) * random_batch_size;
+            std::size_t block_num   = std::min(random_batch_size, num_blocks - block_begin);
+
+            unsigned int c0[random_batch_size], c1[random_batch_size], c2[random_batch_size], c3[random_batch_size];
+            for (std::size_t i = 0; i < block_num; ++i)
+            {
+              std::size_t block_index = block_begin + i;
+              c0[i] = static_cast<unsigned int>(block_index);
+              c1[i] = static_cast<unsigned int>((block_index >> 16) >> 16);
+              c2[i] = 0;
+              c3[i] = 0;
+            }
+            philox4x32_10(c0, c1, c2, c3, block_num, seed, 0);
+
+            NumericT values[4 * random_batch_size];
+            gen(c0, c1, c2, c3, block_num, values);
+
+            std::size_t k     = block_begin * values_per_block;
+            std::size_t k_num = std::min(block_num * values_per_block, total_size - k);
+            if (is_contiguous)
+            {
+              NumericT * dest = data + start + k;
+              for (std::size_t i = 0; i < k_num; ++i)
+                dest[i] = values[i];
+            }
+            else
+            {
+              std::size_t line  = k / line_size;
+              std::size_t entry = k - line * line_size;
+              for (std::size_t i = 0; i < k_num; ++i)
+              {
+                data[start + line * line_inc + entry * inc] = values[i];
+                if (++entry == line_size)
+                {
+                  entry = 0;
+                  ++line;
+                }
+              }
+            }
+          }
+        }
+
+      } //namespace detail
+
+
+      /** @brief Fills a vector (or a range/slice of a vector) with random values on the CPU.
+      *
+      * Entry i is computed from the seed and the counter of its block only.
+      *
+      * @param vec    The vector to be filled
+      * @param gen    Functor generating the values of a block, see detail::random_uniform_generator and detail::random_gaussian_generator
+      * @param seed   The seed (key) of the generator
+      */
+      template <typename NumericT, typename GeneratorT>
+      void random_fill(vector_base<NumericT> & vec, GeneratorT const & gen, unsigned int seed)
+      {
+        NumericT * data = detail::extract_raw_pointer<NumericT>(vec);
+
+        detail::random_fill(data,
+                            viennacl::traits::start(vec), viennacl::traits::stride(vec), 0,
+                            1, viennacl::traits::size(vec),
+                            gen, seed);
+      }
+
+      /** @brief Fills a matrix (or a range/slice of a matrix) with random values on the CPU.
+      *
+      * Entries are numbered in the order of the storage layout, i.e. row by row for row-major matrices and column by column for column-major matrices.
+      *
+      * @param mat    The matrix to be filled
+      * @param gen    Functor generating the values of a block, see detail::random_uniform_generator and detail::random_gaussian_generator
+      * @param seed   The seed (key) of the generator
+      */
+      template <typename NumericT, typename F, typename GeneratorT>
+      void random_fill(matrix_base<NumericT, F> & mat, GeneratorT const & gen, unsigned int seed)
+      {
+        NumericT * data = detail::extract_raw_pointer<NumericT>(mat);
+
+        std::size_t start1 = viennacl::traits::start1(mat);
+        std::size_t start2 = viennacl::traits::start2(mat);
+        std::size_t inc1   = viennacl::traits::stride1(mat);
+        std::size_t inc2   = viennacl::traits::stride2(mat);
+        std::size_t internal_size1 = viennacl::traits::internal_size1(mat);
+        std::size_t internal_size2 = viennacl::traits::internal_size2(mat);
+
+        if (detail::is_row_major(typename F::orientation_category()))
+          detail::random_fill(data,
+                              start1 * internal_size2 + start2, inc2, inc1 * internal_size2,
+                              viennacl::traits::size1(mat), viennacl::traits::size2(mat),
+                              gen, seed);
+        else
+          detail::random_fill(data,
+                              start1 + start2 * internal_size1, inc1, inc2 * internal_size1,
+                              viennacl::traits::size2(mat), viennacl::traits::size1(mat),
+                              gen, seed);
+      }
+
+    } // namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
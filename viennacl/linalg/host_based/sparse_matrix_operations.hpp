@@ -23,6 +23,8 @@
 */
 
 #include <list>
+#include <vector>
+#include <algorithm>
 
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
@@ -31,6 +33,10 @@
 #include "viennacl/linalg/host_based/common.hpp"
 #include "viennacl/linalg/host_based/vector_operations.hpp"
 
+#if defined(VIENNACL_WITH_AVX2)
+#include <immintrin.h>
+#endif
+
 namespace viennacl
 {
   namespace linalg
@@ -96,10 +102,109 @@ namespace viennacl
       }
 
 
+      namespace detail
+      {
+        /** @brief Target number of nonzeros per row block in the matrix-vector product with a compressed_matrix. */
+        static const std::size_t csr_block_nnz = 2048;
+
+        /** @brief Rows with more nonzeros than this are split into chunks of csr_block_nnz nonzeros which are processed in parallel. */
+        static const std::size_t csr_long_row_nnz = 4 * csr_block_nnz;
+
+        /** @brief Computes the dot product of a row of a compressed_matrix with a dense vector of unit stride.
+        *
+        * Four independent partial sums are used in order to hide the latency of the additions.
+        */
+        template<typename ScalarType>
+        ScalarType csr_row_dot(ScalarType const * elements, unsigned int const * col_indices, std::size_t row_nnz, ScalarType const * x)
+        {
+          ScalarType sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+          std::size_t i = 0;
+          for (; i + 4 <= row_nnz; i += 4)
+          {
+            sum0 += elements[i]   * x[col_indices[i]];
+            sum1 += elements[i+1] * x[col_indices[i+1]];
+            sum2 += elements[i+2] * x[col_indices[i+2]];
+            sum3 += elements[i+3] * x[col_indices[i+3]];
+          }
+          for (; i < row_nnz; ++i)
+            sum0 += elements[i] * x[col_indices[i]];
+          return (sum0 + sum1) + (sum2 + sum3);
+        }
+
+#if defined(VIENNACL_WITH_AVX2)
+        // gathers four entries of x per instruction, two independent accumulators
+        inline double csr_row_dot(double const * elements, unsigned int const * col_indices, std::size_t row_nnz, double const * x)
+        {
+          __m256d sum0 = _mm256_setzero_pd();
+          __m256d sum1 = _mm256_setzero_pd();
+          std::size_t i = 0;
+          for (; i + 8 <= row_nnz; i += 8)
+          {
+            __m256d x0 = _mm256_i32gather_pd(x, _mm_loadu_si128(reinterpret_cast<__m128i const *>(col_indices + i)),     8);
+            __m256d x1 = _mm256_i32gather_pd(x, _mm_loadu_si128(reinterpret_cast<__m128i const *>(col_indices + i + 4)), 8);
+            sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(elements + i),     x0, sum0);
+            sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(elements + i + 4), x1, sum1);
+          }
+          if (i + 4 <= row_nnz)
+          {
+            __m256d x0 = _mm256_i32gather_pd(x, _mm_loadu_si128(reinterpret_cast<__m128i const *>(col_indices + i)), 8);
+            sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(elements + i), x0, sum0);
+            i += 4;
+          }
+          sum0 = _mm256_add_pd(sum0, sum1);
+          __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(sum0), _mm256_extractf128_pd(sum0, 1));
+          sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+
+          double result = _mm_cvtsd_f64(sum);
+          for (; i < row_nnz; ++i)
+            result += elements[i] * x[col_indices[i]];
+          return result;
+        }
+
+        // gathers eight entries of x per instruction
+        inline float csr_row_dot(float const * elements, unsigned int const * col_indices, std::size_t row_nnz, float const * x)
+        {
+          __m256 sum0 = _mm256_setzero_ps();
+          std::size_t i = 0;
+          for (; i + 8 <= row_nnz; i += 8)
+          {
+            __m256 x0 = _mm256_i32gather_ps(x, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(col_indices + i)), 4);
+            sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(elements + i), x0, sum0);
+          }
+          __m128 sum = _mm_add_ps(_mm256_castps256_ps128(sum0), _mm256_extractf128_ps(sum0, 1));
+          sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+          sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+
+          float result = _mm_cvtss_f32(sum);
+          for (; i < row_nnz; ++i)
+            result += elements[i] * x[col_indices[i]];
+          return result;
+        }
+#endif
+
+        /** @brief Computes the dot product of a row of a compressed_matrix with a dense vector of arbitrary stride. */
+        template<typename ScalarType>
+        ScalarType csr_row_dot(ScalarType const * elements, unsigned int const * col_indices, std::size_t row_nnz, ScalarType const * x, std::size_t inc)
+        {
+          if (inc == 1)
+            return csr_row_dot(elements, col_indices, row_nnz, x);
+
+          ScalarType sum = 0;
+          for (std::size_t i = 0; i < row_nnz; ++i)
+            sum += elements[i] * x[col_indices[i] * inc];
+          return sum;
+        }
+      }
+
       /** @brief Carries out matrix-vector multiplication with a compressed_matrix
       *
       * Implementation of the convenience expression result = prod(mat, vec);
       *
+      * The rows are distributed over the threads in blocks of about the same number of nonzeros (cf. compressed_matrix::row_blocks()),
+      * so that matrices with a highly irregular number of nonzeros per row (e.g. power-law graphs) are processed efficiently.
+      * Very long rows are split into chunks, which are processed in parallel and summed up in a fixed order afterwards.
+      * Thus, the result does not depend on the number of threads.
+      *
       * @param mat    The matrix
       * @param vec    The vector
       * @param result The result vector
@@ -115,18 +220,73 @@ namespace viennacl
         unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle1());
         unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle2());
 
+        if (mat.size1() == 0)
+          return;
+
+        std::vector<unsigned int> row_blocks = mat.row_blocks(detail::csr_block_nnz);
+        long num_blocks = static_cast<long>(row_blocks.size()) - 1;
+
+        ScalarType const * x       = vec_buf + vec.start();
+        std::size_t        x_inc   = vec.stride();
+        ScalarType       * y       = result_buf + result.start();
+        std::size_t        y_inc   = result.stride();
+
+        // long rows are split into chunks of csr_block_nnz nonzeros:
+        std::vector<unsigned int> long_rows;
+        std::vector<unsigned int> long_row_chunk_start(1, 0);
+        for (long b = 0; b < num_blocks; ++b)
+        {
+          unsigned int row = row_blocks[b];
+          std::size_t row_nnz = row_buffer[row+1] - row_buffer[row];
+          if (row_blocks[b+1] == row + 1 && row_nnz > detail::csr_long_row_nnz)
+          {
+            long_rows.push_back(row);
+            long_row_chunk_start.push_back(static_cast<unsigned int>(long_row_chunk_start.back() + (row_nnz - 1) / detail::csr_block_nnz + 1));
+          }
+        }
+        long num_chunks = static_cast<long>(long_row_chunk_start.back());
+        std::vector<ScalarType> chunk_sums(num_chunks);
+
 #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
+        #pragma omp parallel for if (mat.nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
 #endif
-        for (std::size_t row = 0; row < mat.size1(); ++row)
+        for (long b = 0; b < num_blocks; ++b)
         {
-          ScalarType dot_prod = 0;
-          std::size_t row_end = row_buffer[row+1];
-          for (std::size_t i = row_buffer[row]; i < row_end; ++i)
-            dot_prod += elements[i] * vec_buf[col_buffer[i] * vec.stride() + vec.start()];
-          result_buf[row * result.stride() + result.start()] = dot_prod;
+          unsigned int row_stop = row_blocks[b+1];
+          for (unsigned int row = row_blocks[b]; row < row_stop; ++row)
+          {
+            std::size_t row_start = row_buffer[row];
+            std::size_t row_nnz   = row_buffer[row+1] - row_start;
+            if (row_nnz > detail::csr_long_row_nnz && row_stop == row + 1 && row == row_blocks[b])
+              continue; // processed in chunks below
+            y[row * y_inc] = detail::csr_row_dot(elements + row_start, col_buffer + row_start, row_nnz, x, x_inc);
+          }
         }
 
+        // chunks of long rows, summed up in a fixed order:
+        if (num_chunks > 0)
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long chunk = 0; chunk < num_chunks; ++chunk)
+          {
+            std::size_t i = static_cast<std::size_t>(std::upper_bound(long_row_chunk_start.begin(), long_row_chunk_start.end(), static_cast<unsigned int>(chunk)) - long_row_chunk_start.begin()) - 1;
+            std::size_t row_start   = row_buffer[long_rows[i]];
+            std::size_t row_end     = row_buffer[long_rows[i] + 1];
+            std::size_t chunk_start = row_start + (chunk - long_row_chunk_start[i]) * detail::csr_block_nnz;
+            std::size_t chunk_end   = std::min(chunk_start + detail::csr_block_nnz, row_end);
+            chunk_sums[chunk] = detail::csr_row_dot(elements + chunk_start, col_buffer + chunk_start, chunk_end - chunk_start, x, x_inc);
+          }
+
+          for (std::size_t i = 0; i < long_rows.size(); ++i)
+          {
+            ScalarType sum = 0;
+            for (unsigned int chunk = long_row_chunk_start[i]; chunk < long_row_chunk_start[i+1]; ++chunk)
+              sum += chunk_sums[chunk];
+            y[long_rows[i] * y_inc] = sum;
+          }
+        }
       }
 
       /** @brief Carries out sparse_matrix-matrix multiplication first matrix being compressed
@@ -169,18 +329,34 @@ namespace viennacl
             result_wrapper(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
 
         if ( detail::is_row_major(typename F::orientation_category()) ) {
+          // each nonzero updates a whole row of the result, so that the sparse matrix is traversed only once and the rows of d_mat are accessed contiguously:
 #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
+          #pragma omp parallel
 #endif
-          for (std::size_t row = 0; row < sp_mat.size1(); ++row) {
-            std::size_t row_start = sp_mat_row_buffer[row];
-            std::size_t row_end = sp_mat_row_buffer[row+1];
-            for (std::size_t col = 0; col < d_mat.size2(); ++col) {
-              NumericT temp = 0;
+          {
+            std::vector<NumericT> temp(d_mat.size2());
+
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for
+#endif
+            for (long row = 0; row < static_cast<long>(sp_mat.size1()); ++row) {
+              std::size_t row_start = sp_mat_row_buffer[row];
+              std::size_t row_end = sp_mat_row_buffer[row+1];
+              std::fill(temp.begin(), temp.end(), NumericT(0));
               for (std::size_t k = row_start; k < row_end; ++k) {
-                temp += sp_mat_elements[k] * d_mat_wrapper(sp_mat_col_buffer[k], col);
+                NumericT x = sp_mat_elements[k];
+                NumericT const * d_mat_row = &d_mat_wrapper(sp_mat_col_buffer[k], 0);
+                if (d_mat_inc2 == 1) {
+                  for (std::size_t col = 0; col < temp.size(); ++col)
+                    temp[col] += x * d_mat_row[col];
+                }
+                else {
+                  for (std::size_t col = 0; col < temp.size(); ++col)
+                    temp[col] += x * d_mat_row[col * d_mat_inc2];
+                }
               }
-              result_wrapper(row, col) = temp;
+              for (std::size_t col = 0; col < temp.size(); ++col)
+                result_wrapper(row, col) = temp[col];
             }
           }
         }
@@ -841,6 +1017,216 @@ namespace viennacl
       }
 
 
+      //
+      // Level-scheduled triangular solves for compressed_matrix
+      //
+
+      namespace detail
+      {
+        /** @brief Level schedule of a sparse triangular system for solves on the host.
+        *
+        * The rows of the system are grouped into levels such that each row only depends on rows in previous levels.
+        * Rows are stored level by level in a packed CSR format holding only the strictly triangular part, so all rows within a level can be substituted in parallel.
+        */
+        template <typename NumericT>
+        struct csr_level_schedule
+        {
+          csr_level_schedule() : unit_diagonal(true) {}
+
+          /** @brief Returns the number of levels (zero if the schedule has not been set up) */
+          std::size_t levels() const { return level_buffer.empty() ? 0 : level_buffer.size() - 1; }
+
+          std::vector<unsigned int> level_buffer;   //rows of level i are at positions level_buffer[i], ..., level_buffer[i+1] - 1
+          std::vector<unsigned int> row_indices;    //row of the system at each position
+          std::vector<unsigned int> row_buffer;     //packed CSR of the strictly triangular part, one row per position
+          std::vector<unsigned int> col_buffer;
+          std::vector<NumericT>     elements;
+          std::vector<NumericT>     diagonal;       //diagonal entry at each position, empty for unit diagonals
+          bool unit_diagonal;
+        };
+
+        inline bool is_lower_solve(viennacl::linalg::lower_tag)      { return true; }
+        inline bool is_lower_solve(viennacl::linalg::unit_lower_tag) { return true; }
+        inline bool is_lower_solve(viennacl::linalg::upper_tag)      { return false; }
+        inline bool is_lower_solve(viennacl::linalg::unit_upper_tag) { return false; }
+
+        inline bool is_unit_solve(viennacl::linalg::lower_tag)      { return false; }
+        inline bool is_unit_solve(viennacl::linalg::unit_lower_tag) { return true; }
+        inline bool is_unit_solve(viennacl::linalg::upper_tag)      { return false; }
+        inline bool is_unit_solve(viennacl::linalg::unit_upper_tag) { return true; }
+
+        /** @brief Computes the level schedule for the triangular solve with a CSR matrix A or its transpose.
+        *
+        * @param row_buffer      Row pointer array of A
+        * @param col_buffer      Column index array of A
+        * @param element_buffer  Nonzero entries of A
+        * @param num_rows        Number of rows (and columns) of A
+        * @param schedule        The level schedule to be set up
+        * @param transposed      If true, the schedule is set up for a solve with the transpose of A
+        * @param tag             The solver tag identifying the triangular part (of A or its transpose) to be used
+        */
+        template <typename NumericT, typename ConstScalarTypeArray, typename SizeTypeArray, typename SolverTag>
+        void csr_level_schedule_setup(SizeTypeArray const & row_buffer,
+                                      SizeTypeArray const & col_buffer,
+                                      ConstScalarTypeArray const & element_buffer,
+                                      std::size_t num_rows,
+                                      csr_level_schedule<NumericT> & schedule,
+                                      bool transposed,
+                                      SolverTag tag)
+        {
+          bool lower = is_lower_solve(tag);
+          schedule.unit_diagonal = is_unit_solve(tag);
+
+          //
+          // Step 1: Extract the strictly triangular part of the system matrix (transposing A if necessary) and the diagonal:
+          //
+          std::vector<unsigned int> tri_row_buffer(num_rows + 1);
+          std::vector<unsigned int> tri_col_buffer;
+          std::vector<NumericT>     tri_elements;
+          std::vector<NumericT>     tri_diagonal(schedule.unit_diagonal ? 0 : num_rows);
+
+          if (!transposed)
+          {
+            for (std::size_t row = 0; row < num_rows; ++row)
+            {
+              for (std::size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+              {
+                std::size_t col = col_buffer[i];
+                if (lower ? (col < row) : (col > row))
+                {
+                  tri_col_buffer.push_back(static_cast<unsigned int>(col));
+                  tri_elements.push_back(element_buffer[i]);
+                }
+                else if (col == row && !schedule.unit_diagonal)
+                  tri_diagonal[row] = element_buffer[i];
+              }
+              tri_row_buffer[row+1] = static_cast<unsigned int>(tri_col_buffer.size());
+            }
+          }
+          else // entry (row, col) of A is entry (col, row) of the system matrix
+          {
+            for (std::size_t row = 0; row < num_rows; ++row)
+              for (std::size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+              {
+                std::size_t col = col_buffer[i];
+                if (lower ? (row < col) : (row > col))
+                  ++tri_row_buffer[col+1];
+                else if (col == row && !schedule.unit_diagonal)
+                  tri_diagonal[row] = element_buffer[i];
+              }
+
+            for (std::size_t row = 0; row < num_rows; ++row)
+              tri_row_buffer[row+1] += tri_row_buffer[row];
+
+            std::vector<unsigned int> fill_index(tri_row_buffer.begin(), tri_row_buffer.end() - 1);
+            tri_col_buffer.resize(tri_row_buffer[num_rows]);
+            tri_elements.resize(tri_row_buffer[num_rows]);
+            for (std::size_t row = 0; row < num_rows; ++row)
+              for (std::size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+              {
+                std::size_t col = col_buffer[i];
+                if (lower ? (row < col) : (row > col))
+                {
+                  tri_col_buffer[fill_index[col]] = static_cast<unsigned int>(row);
+                  tri_elements[fill_index[col]]   = element_buffer[i];
+                  ++fill_index[col];
+                }
+              }
+          }
+
+          //
+          // Step 2: Level of each row is one plus the maximum level of the rows it depends on:
+          //
+          std::vector<unsigned int> row_level(num_rows);
+          unsigned int num_levels = 0;
+          for (std::size_t row2 = 0; row2 < num_rows; ++row2)
+          {
+            std::size_t row = lower ? row2 : (num_rows - row2) - 1;
+            unsigned int level = 0;
+            for (std::size_t i = tri_row_buffer[row]; i < tri_row_buffer[row+1]; ++i)
+              level = std::max<unsigned int>(level, row_level[tri_col_buffer[i]] + 1);
+            row_level[row] = level;
+            num_levels = std::max<unsigned int>(num_levels, level + 1);
+          }
+
+          //
+          // Step 3: Sort rows by level and pack the triangular part accordingly:
+          //
+          schedule.level_buffer.assign(num_levels + 1, 0);
+          for (std::size_t row = 0; row < num_rows; ++row)
+            ++schedule.level_buffer[row_level[row] + 1];
+          for (std::size_t level = 0; level < num_levels; ++level)
+            schedule.level_buffer[level+1] += schedule.level_buffer[level];
+
+          std::vector<unsigned int> fill_index(schedule.level_buffer.begin(), schedule.level_buffer.end() - 1);
+          schedule.row_indices.resize(num_rows);
+          for (std::size_t row = 0; row < num_rows; ++row)
+            schedule.row_indices[fill_index[row_level[row]]++] = static_cast<unsigned int>(row);
+
+          schedule.row_buffer.resize(num_rows + 1);
+          schedule.col_buffer.resize(tri_col_buffer.size());
+          schedule.elements.resize(tri_elements.size());
+          schedule.diagonal.resize(tri_diagonal.size());
+          schedule.row_buffer[0] = 0;
+          std::size_t nnz_index = 0;
+          for (std::size_t k = 0; k < num_rows; ++k)
+          {
+            std::size_t row = schedule.row_indices[k];
+            for (std::size_t i = tri_row_buffer[row]; i < tri_row_buffer[row+1]; ++i, ++nnz_index)
+            {
+              schedule.col_buffer[nnz_index] = tri_col_buffer[i];
+              schedule.elements[nnz_index]   = tri_elements[i];
+            }
+            schedule.row_buffer[k+1] = static_cast<unsigned int>(nnz_index);
+            if (!schedule.unit_diagonal)
+              schedule.diagonal[k] = tri_diagonal[row];
+          }
+        }
+
+        /** @brief Inplace triangular solve using a level schedule set up by csr_level_schedule_setup().
+        *
+        * Rows within a level are processed in parallel if OpenMP is enabled. Since the entries of each row are summed up in the original order, results do not depend on the number of threads.
+        * Levels with only a few rows on average do not pay off the synchronization after each level, hence such schedules are processed by a single thread.
+        */
+        template <typename NumericT, typename ScalarTypeArray>
+        void csr_level_scheduled_inplace_solve(csr_level_schedule<NumericT> const & schedule,
+                                               ScalarTypeArray & vec_buffer)
+        {
+          long num_levels = static_cast<long>(schedule.levels());
+          long num_rows   = static_cast<long>(schedule.row_indices.size());
+
+          unsigned int const * level_buffer = num_levels > 0 ? &(schedule.level_buffer[0]) : NULL;
+          unsigned int const * row_indices  = num_rows > 0   ? &(schedule.row_indices[0])  : NULL;
+          unsigned int const * row_buffer   = num_rows > 0   ? &(schedule.row_buffer[0])   : NULL;
+          unsigned int const * col_buffer   = schedule.col_buffer.size() > 0 ? &(schedule.col_buffer[0]) : NULL;
+          NumericT     const * elements     = schedule.elements.size() > 0   ? &(schedule.elements[0])   : NULL;
+          NumericT     const * diagonal     = schedule.diagonal.size() > 0   ? &(schedule.diagonal[0])   : NULL;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel if (num_rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE && num_rows > 32 * num_levels)
+#endif
+          for (long level = 0; level < num_levels; ++level)
+          {
+            long level_begin = static_cast<long>(level_buffer[level]);
+            long level_end   = static_cast<long>(level_buffer[level+1]);
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for
+#endif
+            for (long k = level_begin; k < level_end; ++k)
+            {
+              unsigned int row = row_indices[k];
+              NumericT vec_entry = vec_buffer[row];
+              unsigned int row_end = row_buffer[k+1];
+              for (unsigned int i = row_buffer[k]; i < row_end; ++i)
+                vec_entry -= vec_buffer[col_buffer[i]] * elements[i];
+              vec_buffer[row] = diagonal ? vec_entry / diagonal[k] : vec_entry;
+            }
+          }
+        }
+
+      } //namespace detail
+
+
 
       //
       // Compressed Compressed Matrix
@@ -947,6 +1333,136 @@ namespace viennacl
         }
       }
 
+      namespace detail
+      {
+        /** @brief Number of nonzeros of a coordinate_matrix processed as one chunk in the segmented reduction. */
+        static const std::size_t coo_chunk_nnz = 4096;
+
+        /** @brief Provides access to a vector through the two-index interface of matrix_array_wrapper, treating the vector as a matrix with a single column. */
+        template <typename NumericT>
+        class vector_as_column_wrapper
+        {
+          public:
+            typedef NumericT   value_type;
+
+            vector_as_column_wrapper(value_type * A, std::size_t start, std::size_t inc) : wrapper_(A, start, inc) {}
+
+            value_type & operator()(std::size_t i, std::size_t /*j*/) { return wrapper_(i); }
+
+          private:
+            vector_array_wrapper<NumericT> wrapper_;
+        };
+
+        /** @brief Computes result = A * B for a coordinate_matrix A and a dense matrix (or a vector) B by a segmented reduction.
+        *
+        * The nonzeros are split into chunks of coo_chunk_nnz entries, which are processed in parallel. Within a chunk, runs of entries of the same row are reduced locally.
+        * Rows completely inside a chunk are written directly, while the first and the last row of each chunk may be shared with the neighboring chunks.
+        * Their partial sums (carry-outs) are added in chunk order after the parallel phase, hence the result does not depend on the number of threads.
+        *
+        * This requires the entries to be sorted by rows, as it is the case for matrices set up via viennacl::copy(). The ordering is checked before the parallel phase,
+        * and unsorted entries are processed by a serial scatter instead.
+        *
+        * @param coords         The (row, column) index pairs of the nonzeros
+        * @param elements       The values of the nonzeros
+        * @param nnz            The number of nonzeros
+        * @param num_rows       The number of rows of A and of the result
+        * @param num_cols       The number of columns of B and of the result
+        * @param B              Accessor for B: B(i, j)
+        * @param result         Accessor for the result: result(i, j)
+        */
+        template <typename NumericT, typename ScalarType, typename InputWrapperT, typename ResultWrapperT>
+        void coo_prod(unsigned int const * coords, ScalarType const * elements, std::size_t nnz,
+                      std::size_t num_rows, std::size_t num_cols,
+                      InputWrapperT B, ResultWrapperT result)
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (num_rows * num_cols > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+          for (long row = 0; row < static_cast<long>(num_rows); ++row)
+            for (std::size_t j = 0; j < num_cols; ++j)
+              result(static_cast<std::size_t>(row), j) = 0;
+
+          if (nnz == 0 || num_cols == 0)
+            return;
+
+          // the chunks may only write to 'result' if rows are not shared beyond the first and the last run of a chunk, hence check the ordering first:
+          int is_sorted = 1;
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for reduction(&&: is_sorted) if (nnz > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+          for (long i = 1; i < static_cast<long>(nnz); ++i)
+            if (coords[2*i] < coords[2*(i-1)])
+              is_sorted = 0;
+
+          if (!is_sorted)
+          {
+            for (std::size_t i = 0; i < nnz; ++i)
+              for (std::size_t j = 0; j < num_cols; ++j)
+                result(coords[2*i], j) += static_cast<NumericT>(elements[i]) * B(coords[2*i+1], j);
+            return;
+          }
+
+          long num_chunks = static_cast<long>((nnz - 1) / coo_chunk_nnz + 1);
+          std::vector<unsigned int> head_rows(num_chunks);
+          std::vector<unsigned int> tail_rows(num_chunks);
+          std::vector<char>         has_tail(num_chunks, 0);
+          std::vector<NumericT>     head_sums(num_chunks * num_cols);
+          std::vector<NumericT>     tail_sums(num_chunks * num_cols);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (nnz * num_cols > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+          for (long chunk = 0; chunk < num_chunks; ++chunk)
+          {
+            std::size_t chunk_begin = static_cast<std::size_t>(chunk) * coo_chunk_nnz;
+            std::size_t chunk_end   = std::min(chunk_begin + coo_chunk_nnz, nnz);
+
+            head_rows[chunk] = coords[2*chunk_begin];
+
+            std::size_t run_begin = chunk_begin;
+            while (run_begin < chunk_end)
+            {
+              unsigned int row = coords[2*run_begin];
+              std::size_t run_end = run_begin + 1;
+              while (run_end < chunk_end && coords[2*run_end] == row)
+                ++run_end;
+
+              for (std::size_t j = 0; j < num_cols; ++j)
+              {
+                NumericT sum = 0;
+                for (std::size_t i = run_begin; i < run_end; ++i)
+                  sum += static_cast<NumericT>(elements[i]) * B(coords[2*i+1], j);
+
+                if (run_begin == chunk_begin)     // carry-out to the previous chunk
+                  head_sums[chunk * num_cols + j] = sum;
+                else if (run_end == chunk_end)    // carry-out to the next chunk
+                  tail_sums[chunk * num_cols + j] = sum;
+                else                              // row is complete within this chunk
+                  result(row, j) = sum;
+              }
+
+              if (run_begin != chunk_begin && run_end == chunk_end)
+              {
+                tail_rows[chunk] = row;
+                has_tail[chunk] = 1;
+              }
+
+              run_begin = run_end;
+            }
+          }
+
+          // fix-up of rows shared between chunks:
+          for (long chunk = 0; chunk < num_chunks; ++chunk)
+          {
+            for (std::size_t j = 0; j < num_cols; ++j)
+              result(head_rows[chunk], j) += head_sums[chunk * num_cols + j];
+            if (has_tail[chunk])
+              for (std::size_t j = 0; j < num_cols; ++j)
+                result(tail_rows[chunk], j) += tail_sums[chunk * num_cols + j];
+          }
+        }
+      }
+
       /** @brief Carries out matrix-vector multiplication with a coordinate_matrix
       *
       * Implementation of the convenience expression result = prod(mat, vec);
@@ -965,12 +1481,9 @@ namespace viennacl
         ScalarType   const * elements     = detail::extract_raw_pointer<ScalarType>(mat.handle());
         unsigned int const * coord_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle12());
 
-        for (std::size_t i = 0; i< result.size(); ++i)
-          result_buf[i * result.stride() + result.start()] = 0;
-
-        for (std::size_t i = 0; i < mat.nnz(); ++i)
-          result_buf[coord_buffer[2*i] * result.stride() + result.start()]
-            += elements[i] * vec_buf[coord_buffer[2*i+1] * vec.stride() + vec.start()];
+        detail::coo_prod<ScalarType>(coord_buffer, elements, mat.nnz(), result.size(), 1,
+                                     detail::vector_as_column_wrapper<ScalarType const>(vec_buf, vec.start(), vec.stride()),
+                                     detail::vector_as_column_wrapper<ScalarType>(result_buf, result.start(), result.stride()));
       }
 
       /** @brief Carries out Compressed Matrix(COO)-Dense Matrix multiplication
@@ -1011,56 +1524,7 @@ namespace viennacl
         detail::matrix_array_wrapper<NumericT,       typename F::orientation_category, false>
             result_wrapper(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
 
-        if ( detail::is_row_major(typename F::orientation_category()) ) {
-
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t row = 0; row < sp_mat.size1(); ++row)
-                for (std::size_t col = 0; col < d_mat.size2(); ++col)
-                  result_wrapper( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t i = 0; i < sp_mat.nnz(); ++i) {
-            NumericT x = static_cast<NumericT>(sp_mat_elements[i]);
-            unsigned int r = sp_mat_coords[2*i];
-            unsigned int c = sp_mat_coords[2*i+1];
-            for (std::size_t col = 0; col < d_mat.size2(); ++col) {
-              NumericT y = d_mat_wrapper( c, col);
-              result_wrapper(r, col) += x * y;
-            }
-          }
-        }
-
-        else {
-
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t col = 0; col < d_mat.size2(); ++col)
-            for (std::size_t row = 0; row < sp_mat.size1(); ++row)
-                result_wrapper( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t col = 0; col < d_mat.size2(); ++col) {
-
-            for (std::size_t i = 0; i < sp_mat.nnz(); ++i) {
-
-              NumericT x = static_cast<NumericT>(sp_mat_elements[i]);
-              unsigned int r = sp_mat_coords[2*i];
-              unsigned int c = sp_mat_coords[2*i+1];
-              NumericT y = d_mat_wrapper( c, col);
-
-              result_wrapper( r, col) += x*y;
-            }
-
-          }
-        }
-
+        detail::coo_prod<NumericT>(sp_mat_coords, sp_mat_elements, sp_mat.nnz(), sp_mat.size1(), d_mat.size2(), d_mat_wrapper, result_wrapper);
       }
 
 
@@ -1099,51 +1563,130 @@ namespace viennacl
         std::size_t result_internal_size1  = viennacl::traits::internal_size1(result);
         std::size_t result_internal_size2  = viennacl::traits::internal_size2(result);
 
-        detail::matrix_array_wrapper<NumericT const, typename F::orientation_category, false>
+        // the transposed wrapper swaps the indices, i.e. d_mat_wrapper(i, j) refers to entry (j, i) of d_mat.lhs():
+        detail::matrix_array_wrapper<NumericT const, typename F::orientation_category, true>
             d_mat_wrapper(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
         detail::matrix_array_wrapper<NumericT,       typename F::orientation_category, false>
             result_wrapper(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
 
-        if ( detail::is_row_major(typename F::orientation_category()) ) {
+        detail::coo_prod<NumericT>(sp_mat_coords, sp_mat_elements, sp_mat.nnz(), sp_mat.size1(), d_mat.size2(), d_mat_wrapper, result_wrapper);
+      }
 
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t row = 0; row < sp_mat.size1(); ++row)
-            for (std::size_t col = 0; col < d_mat.size2(); ++col)
-              result_wrapper( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-        }
-        else {
+      //
+      // ELL Matrix
+      //
+      namespace detail
+      {
+        /** @brief Number of consecutive rows of an ELL matrix processed together. Entries of these rows with the same item index are contiguous in memory. */
+        static const std::size_t ell_slice_rows = 8;
+
+        /** @brief Computes the products of the rows row_begin, ..., row_begin + num_rows - 1 of the column-interleaved ELL storage with a vector.
+        *
+        * Padding entries (value zero, column index zero) are masked out instead of branched on, so that the loop over the rows vectorizes.
+        *
+        * @param elements        The entries of the ELL storage, item_id-th entry of row i is located at i + item_id * internal_size1
+        * @param coords          The column indices of the ELL storage
+        * @param internal_size1  Leading dimension of the ELL storage
+        * @param num_items       Number of items per row to be processed
+        * @param row_begin       First row of the slice
+        * @param num_rows        Number of rows in the slice, at most ell_slice_rows
+        * @param x               Pointer to the first entry of the vector
+        * @param inc             Stride of the vector
+        * @param sums            Array of length num_rows receiving the results
+        */
+        template<typename ScalarType>
+        void ell_slice_prod(ScalarType const * elements, unsigned int const * coords, std::size_t internal_size1, std::size_t num_items,
+                            std::size_t row_begin, std::size_t num_rows, ScalarType const * x, std::size_t inc, ScalarType * sums)
+        {
+          for (std::size_t k = 0; k < num_rows; ++k)
+            sums[k] = 0;
 
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-          for (std::size_t col = 0; col < d_mat.size2(); ++col)
-            for (std::size_t row = 0; row < sp_mat.size1(); ++row)
-              result_wrapper( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
+          if (num_rows == ell_slice_rows && inc == 1) // loop with fixed trip count for full slices
+          {
+            for (std::size_t item_id = 0; item_id < num_items; ++item_id)
+            {
+              ScalarType   const * e = elements + item_id * internal_size1 + row_begin;
+              unsigned int const * c = coords   + item_id * internal_size1 + row_begin;
+              for (std::size_t k = 0; k < ell_slice_rows; ++k)
+              {
+                ScalarType x_k = x[c[k]];
+                sums[k] += (e[k] != 0) ? e[k] * x_k : ScalarType(0);
+              }
+            }
+            return;
+          }
+
+          for (std::size_t item_id = 0; item_id < num_items; ++item_id)
+          {
+            ScalarType   const * e = elements + item_id * internal_size1 + row_begin;
+            unsigned int const * c = coords   + item_id * internal_size1 + row_begin;
+            for (std::size_t k = 0; k < num_rows; ++k)
+            {
+              ScalarType x_k = x[c[k] * inc];
+              sums[k] += (e[k] != 0) ? e[k] * x_k : ScalarType(0);
+            }
+          }
         }
 
-#ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for
-#endif
-        for (std::size_t i = 0; i < sp_mat.nnz(); ++i) {
-          NumericT x = static_cast<NumericT>(sp_mat_elements[i]);
-          unsigned int r = sp_mat_coords[2*i];
-          unsigned int c = sp_mat_coords[2*i+1];
-          for (std::size_t col = 0; col < d_mat.size2(); ++col) {
-            NumericT y = d_mat_wrapper( col, c);
-            result_wrapper(r, col) += x * y;
+#if defined(VIENNACL_WITH_AVX2)
+        // full slices with unit stride: masked gathers, so that no entry of x is loaded for padding entries
+        inline void ell_slice_prod(double const * elements, unsigned int const * coords, std::size_t internal_size1, std::size_t num_items,
+                                   std::size_t row_begin, std::size_t num_rows, double const * x, std::size_t inc, double * sums)
+        {
+          if (num_rows != ell_slice_rows || inc != 1)
+          {
+            ell_slice_prod<double>(elements, coords, internal_size1, num_items, row_begin, num_rows, x, inc, sums);
+            return;
+          }
+
+          __m256d const zero = _mm256_setzero_pd();
+          __m256d sum0 = zero;
+          __m256d sum1 = zero;
+          for (std::size_t item_id = 0; item_id < num_items; ++item_id)
+          {
+            double       const * e = elements + item_id * internal_size1 + row_begin;
+            unsigned int const * c = coords   + item_id * internal_size1 + row_begin;
+            __m256d e0 = _mm256_loadu_pd(e);
+            __m256d e1 = _mm256_loadu_pd(e + 4);
+            __m256d x0 = _mm256_mask_i32gather_pd(zero, x, _mm_loadu_si128(reinterpret_cast<__m128i const *>(c)),     _mm256_cmp_pd(e0, zero, _CMP_NEQ_UQ), 8);
+            __m256d x1 = _mm256_mask_i32gather_pd(zero, x, _mm_loadu_si128(reinterpret_cast<__m128i const *>(c + 4)), _mm256_cmp_pd(e1, zero, _CMP_NEQ_UQ), 8);
+            sum0 = _mm256_fmadd_pd(e0, x0, sum0);
+            sum1 = _mm256_fmadd_pd(e1, x1, sum1);
           }
+          _mm256_storeu_pd(sums,     sum0);
+          _mm256_storeu_pd(sums + 4, sum1);
         }
 
+        inline void ell_slice_prod(float const * elements, unsigned int const * coords, std::size_t internal_size1, std::size_t num_items,
+                                   std::size_t row_begin, std::size_t num_rows, float const * x, std::size_t inc, float * sums)
+        {
+          if (num_rows != ell_slice_rows || inc != 1)
+          {
+            ell_slice_prod<float>(elements, coords, internal_size1, num_items, row_begin, num_rows, x, inc, sums);
+            return;
+          }
+
+          __m256 const zero = _mm256_setzero_ps();
+          __m256 sum = zero;
+          for (std::size_t item_id = 0; item_id < num_items; ++item_id)
+          {
+            float        const * e = elements + item_id * internal_size1 + row_begin;
+            unsigned int const * c = coords   + item_id * internal_size1 + row_begin;
+            __m256 e0 = _mm256_loadu_ps(e);
+            __m256 x0 = _mm256_mask_i32gather_ps(zero, x, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(c)), _mm256_cmp_ps(e0, zero, _CMP_NEQ_UQ), 4);
+            sum = _mm256_fmadd_ps(e0, x0, sum);
+          }
+          _mm256_storeu_ps(sums, sum);
+        }
+#endif
       }
-      //
-      // ELL Matrix
-      //
+
       /** @brief Carries out matrix-vector multiplication with a ell_matrix
       *
       * Implementation of the convenience expression result = prod(mat, vec);
       *
+      * Slices of detail::ell_slice_rows consecutive rows are distributed over the threads, matching the column-interleaved storage of the matrix.
+      *
       * @param mat    The matrix
       * @param vec    The vector
       * @param result The result vector
@@ -1158,23 +1701,28 @@ namespace viennacl
         ScalarType   const * elements     = detail::extract_raw_pointer<ScalarType>(mat.handle());
         unsigned int const * coords       = detail::extract_raw_pointer<unsigned int>(mat.handle2());
 
-        for(std::size_t row = 0; row < mat.size1(); ++row)
-        {
-          ScalarType sum = 0;
+        ScalarType const * x     = vec_buf + vec.start();
+        std::size_t        x_inc = vec.stride();
+        ScalarType       * y     = result_buf + result.start();
+        std::size_t        y_inc = result.stride();
 
-          for(unsigned int item_id = 0; item_id < mat.internal_maxnnz(); ++item_id)
-          {
-            std::size_t offset = row + item_id * mat.internal_size1();
-            ScalarType val = elements[offset];
+        std::size_t num_rows   = mat.size1();
+        std::size_t num_items  = mat.maxnnz();   // items beyond maxnnz() are padding in all rows
+        long        num_slices = static_cast<long>((num_rows + detail::ell_slice_rows - 1) / detail::ell_slice_rows);
 
-            if(val != 0)
-            {
-              unsigned int col = coords[offset];
-              sum += (vec_buf[col * vec.stride() + vec.start()] * val);
-            }
-          }
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (num_rows * num_items > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long slice = 0; slice < num_slices; ++slice)
+        {
+          std::size_t row_begin      = static_cast<std::size_t>(slice) * detail::ell_slice_rows;
+          std::size_t rows_in_slice  = std::min(detail::ell_slice_rows, num_rows - row_begin);
 
-          result_buf[row * result.stride() + result.start()] = sum;
+          ScalarType sums[detail::ell_slice_rows];
+          detail::ell_slice_prod(elements, coords, mat.internal_size1(), num_items, row_begin, rows_in_slice, x, x_inc, sums);
+
+          for (std::size_t k = 0; k < rows_in_slice; ++k)
+            y[(row_begin + k) * y_inc] = sums[k];
         }
       }
 
@@ -1383,6 +1931,8 @@ namespace viennacl
       *
       * Implementation of the convenience expression result = prod(mat, vec);
       *
+      * The ELL part is processed in slices of detail::ell_slice_rows rows as for ell_matrix, the CSR part is added row by row within each slice.
+      *
       * @param mat    The matrix
       * @param vec    The vector
       * @param result The result vector
@@ -1400,40 +1950,212 @@ namespace viennacl
         unsigned int const * csr_row_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle3());
         unsigned int const * csr_col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle4());
 
+        ScalarType const * x     = vec_buf + vec.start();
+        std::size_t        x_inc = vec.stride();
+        ScalarType       * y     = result_buf + result.start();
+        std::size_t        y_inc = result.stride();
+
+        std::size_t num_rows   = mat.size1();
+        std::size_t num_items  = mat.ell_nnz();
+        long        num_slices = static_cast<long>((num_rows + detail::ell_slice_rows - 1) / detail::ell_slice_rows);
 
-        for(std::size_t row = 0; row < mat.size1(); ++row)
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (num_rows * num_items + mat.csr_nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long slice = 0; slice < num_slices; ++slice)
         {
-          ScalarType sum = 0;
+          std::size_t row_begin      = static_cast<std::size_t>(slice) * detail::ell_slice_rows;
+          std::size_t rows_in_slice  = std::min(detail::ell_slice_rows, num_rows - row_begin);
 
           //
           // Part 1: Process ELL part
           //
-          for(unsigned int item_id = 0; item_id < mat.internal_ellnnz(); ++item_id)
+          ScalarType sums[detail::ell_slice_rows];
+          detail::ell_slice_prod(elements, coords, mat.internal_size1(), num_items, row_begin, rows_in_slice, x, x_inc, sums);
+
+          //
+          // Part 2: Process CSR part
+          //
+          for (std::size_t k = 0; k < rows_in_slice; ++k)
           {
-            std::size_t offset = row + item_id * mat.internal_size1();
-            ScalarType val = elements[offset];
+            std::size_t row       = row_begin + k;
+            std::size_t col_begin = csr_row_buffer[row];
+            std::size_t col_end   = csr_row_buffer[row + 1];
+            if (col_end > col_begin)
+              sums[k] += detail::csr_row_dot(csr_elements + col_begin, csr_col_buffer + col_begin, col_end - col_begin, x, x_inc);
 
-            if(val != 0)
-            {
-              unsigned int col = coords[offset];
-              sum += (vec_buf[col * vec.stride() + vec.start()] * val);
-            }
+            y[row * y_inc] = sums[k];
           }
+        }
+      }
 
-          //
-          // Part 2: Process HYB part
-          //
-          std::size_t col_begin = csr_row_buffer[row];
-          std::size_t col_end   = csr_row_buffer[row + 1];
+      //
+      // Sliced ELL Matrix
+      //
+      /** @brief Carries out matrix-vector multiplication with a sliced_ell_matrix
+      *
+      * Implementation of the convenience expression result = prod(mat, vec);
+      *
+      * Chunks are distributed over the threads. Each chunk is stored like an ell_matrix with chunk_size() rows, hence it is processed in slices of detail::ell_slice_rows rows.
+      *
+      * @param mat    The matrix
+      * @param vec    The vector
+      * @param result The result vector
+      */
+      template<class ScalarType>
+      void prod_impl(const viennacl::sliced_ell_matrix<ScalarType> & mat,
+                     const viennacl::vector_base<ScalarType> & vec,
+                           viennacl::vector_base<ScalarType> & result)
+      {
+        ScalarType         * result_buf   = detail::extract_raw_pointer<ScalarType>(result.handle());
+        ScalarType   const * vec_buf      = detail::extract_raw_pointer<ScalarType>(vec.handle());
+        ScalarType   const * elements     = detail::extract_raw_pointer<ScalarType>(mat.handle());
+        unsigned int const * chunk_start  = detail::extract_raw_pointer<unsigned int>(mat.handle1());
+        unsigned int const * coords       = detail::extract_raw_pointer<unsigned int>(mat.handle2());
+        unsigned int const * row_indices  = detail::extract_raw_pointer<unsigned int>(mat.handle3());
+
+        ScalarType const * x     = vec_buf + vec.start();
+        std::size_t        x_inc = vec.stride();
+        ScalarType       * y     = result_buf + result.start();
+        std::size_t        y_inc = result.stride();
+
+        std::size_t num_rows   = mat.size1();
+        std::size_t chunk_size = mat.chunk_size();
+        long        num_chunks = static_cast<long>(mat.num_chunks());
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (mat.internal_nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long chunk = 0; chunk < num_chunks; ++chunk)
+        {
+          std::size_t offset         = chunk_start[chunk];
+          std::size_t num_items      = (chunk_start[chunk + 1] - offset) / chunk_size;
+          std::size_t slot_begin     = static_cast<std::size_t>(chunk) * chunk_size;
+          std::size_t rows_in_chunk  = std::min(chunk_size, num_rows - slot_begin);
 
-          for(std::size_t item_id = col_begin; item_id < col_end; item_id++)
+          for (std::size_t row_begin = 0; row_begin < rows_in_chunk; row_begin += detail::ell_slice_rows)
           {
-              sum += (vec_buf[csr_col_buffer[item_id] * vec.stride() + vec.start()] * csr_elements[item_id]);
+            std::size_t rows_in_slice = std::min(detail::ell_slice_rows, rows_in_chunk - row_begin);
+
+            ScalarType sums[detail::ell_slice_rows];
+            detail::ell_slice_prod(elements + offset, coords + offset, chunk_size, num_items, row_begin, rows_in_slice, x, x_inc, sums);
+
+            for (std::size_t k = 0; k < rows_in_slice; ++k)
+              y[row_indices[slot_begin + row_begin + k] * y_inc] = sums[k];
           }
+        }
+      }
+
+      namespace detail
+      {
+        /** @brief Computes result = A * B for a sliced_ell_matrix A and a dense matrix B. Chunks are distributed over the threads, each row of the result is written by a single thread.
+        *
+        * @param mat         The sparse matrix
+        * @param B           Wrapper for the dense matrix (possibly transposed)
+        * @param result      Wrapper for the result matrix
+        * @param num_cols    Number of columns of B and of the result
+        */
+        template<typename NumericT, typename ScalarType, typename InputWrapperT, typename ResultWrapperT>
+        void sliced_ell_prod(viennacl::sliced_ell_matrix<ScalarType> const & mat, InputWrapperT B, ResultWrapperT result, std::size_t num_cols)
+        {
+          ScalarType   const * elements     = extract_raw_pointer<ScalarType>(mat.handle());
+          unsigned int const * chunk_start  = extract_raw_pointer<unsigned int>(mat.handle1());
+          unsigned int const * coords       = extract_raw_pointer<unsigned int>(mat.handle2());
+          unsigned int const * row_indices  = extract_raw_pointer<unsigned int>(mat.handle3());
+
+          std::size_t num_rows   = mat.size1();
+          std::size_t chunk_size = mat.chunk_size();
+          long        num_chunks = static_cast<long>(mat.num_chunks());
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (mat.internal_nnz() * num_cols > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+          for (long chunk = 0; chunk < num_chunks; ++chunk)
+          {
+            std::size_t offset     = chunk_start[chunk];
+            std::size_t num_items  = (chunk_start[chunk + 1] - offset) / chunk_size;
+            std::size_t slot_begin = static_cast<std::size_t>(chunk) * chunk_size;
+            std::size_t slot_end   = std::min(slot_begin + chunk_size, num_rows);
 
-          result_buf[row * result.stride() + result.start()] = sum;
+            for (std::size_t slot = slot_begin; slot < slot_end; ++slot)
+            {
+              std::size_t row = row_indices[slot];
+              for (std::size_t j = 0; j < num_cols; ++j)
+                result(row, j) = NumericT(0);
+
+              for (std::size_t item_id = 0; item_id < num_items; ++item_id)
+              {
+                std::size_t index = offset + item_id * chunk_size + (slot - slot_begin);
+                NumericT    val   = static_cast<NumericT>(elements[index]);
+                if (val != NumericT(0))
+                {
+                  std::size_t col = coords[index];
+                  for (std::size_t j = 0; j < num_cols; ++j)
+                    result(row, j) += val * B(col, j);
+                }
+              }
+            }
+          }
         }
+      }
+
+      /** @brief Carries out sliced_ell_matrix-d_matrix multiplication
+      *
+      * Implementation of the convenience expression result = prod(sp_mat, d_mat);
+      *
+      * @param sp_mat     The sparse matrix (sliced ELL)
+      * @param d_mat      The dense matrix
+      * @param result     The result dense matrix
+      */
+      template<class ScalarType, typename NumericT, typename F>
+      void prod_impl(const viennacl::sliced_ell_matrix<ScalarType> & sp_mat,
+                     const viennacl::matrix_base<NumericT, F> & d_mat,
+                           viennacl::matrix_base<NumericT, F> & result)
+      {
+        NumericT const * d_mat_data = detail::extract_raw_pointer<NumericT>(d_mat);
+        NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
+
+        detail::matrix_array_wrapper<NumericT const, typename F::orientation_category, false>
+            d_mat_wrapper(d_mat_data, viennacl::traits::start1(d_mat), viennacl::traits::start2(d_mat),
+                                      viennacl::traits::stride1(d_mat), viennacl::traits::stride2(d_mat),
+                                      viennacl::traits::internal_size1(d_mat), viennacl::traits::internal_size2(d_mat));
+        detail::matrix_array_wrapper<NumericT,       typename F::orientation_category, false>
+            result_wrapper(result_data, viennacl::traits::start1(result), viennacl::traits::start2(result),
+                                        viennacl::traits::stride1(result), viennacl::traits::stride2(result),
+                                        viennacl::traits::internal_size1(result), viennacl::traits::internal_size2(result));
+
+        detail::sliced_ell_prod<NumericT>(sp_mat, d_mat_wrapper, result_wrapper, d_mat.size2());
+      }
+
+      /** @brief Carries out matrix-trans(matrix) multiplication, the first matrix being a sparse sliced_ell_matrix and the second dense transposed
+      *
+      * Implementation of the convenience expression result = prod(sp_mat, trans(d_mat));
+      *
+      * @param sp_mat     The sparse matrix (sliced ELL)
+      * @param d_mat      The transposed dense matrix
+      * @param result     The result dense matrix
+      */
+      template<class ScalarType, typename NumericT, typename F>
+      void prod_impl(const viennacl::sliced_ell_matrix<ScalarType> & sp_mat,
+                     const viennacl::matrix_expression< const viennacl::matrix_base<NumericT, F>,
+                                                        const viennacl::matrix_base<NumericT, F>,
+                                                        viennacl::op_trans > & d_mat,
+                           viennacl::matrix_base<NumericT, F> & result)
+      {
+        NumericT const * d_mat_data = detail::extract_raw_pointer<NumericT>(d_mat.lhs());
+        NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
+
+        // the transposed wrapper swaps the indices, i.e. d_mat_wrapper(i, j) refers to entry (j, i) of d_mat.lhs():
+        detail::matrix_array_wrapper<NumericT const, typename F::orientation_category, true>
+            d_mat_wrapper(d_mat_data, viennacl::traits::start1(d_mat.lhs()), viennacl::traits::start2(d_mat.lhs()),
+                                      viennacl::traits::stride1(d_mat.lhs()), viennacl::traits::stride2(d_mat.lhs()),
+                                      viennacl::traits::internal_size1(d_mat.lhs()), viennacl::traits::internal_size2(d_mat.lhs()));
+        detail::matrix_array_wrapper<NumericT,       typename F::orientation_category, false>
+            result_wrapper(result_data, viennacl::traits::start1(result), viennacl::traits::start2(result),
+                                        viennacl::traits::stride1(result), viennacl::traits::stride2(result),
+                                        viennacl::traits::internal_size1(result), viennacl::traits::internal_size2(result));
 
+        detail::sliced_ell_prod<NumericT>(sp_mat, d_mat_wrapper, result_wrapper, d_mat.size2());
       }
 
 
@@ -0,0 +1,367 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_STRUCTURED_MATRIX_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_STRUCTURED_MATRIX_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file  viennacl/linalg/host_based/structured_matrix_operations.hpp
+    @brief Implementations of products with circulant, Toeplitz, Hankel, and Vandermonde matrices on the CPU using a single thread or OpenMP. Experimental.
+
+    Circulant, Toeplitz, and Hankel matrices are multiplied in O(n log n) operations by a cyclic convolution computed with the host FFT.
+    Toeplitz and Hankel matrices are embedded into a circulant matrix of the smallest size >= 2n-1 with prime factors 2, 3, and 5 only.
+    Products with Vandermonde matrices are evaluated row-wise using Horner's scheme.
+*/
+
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/fft_operations.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Returns the smallest integer >= n with prime factors 2, 3, and 5 only (transform sizes not requiring Bluestein's algorithm) */
+        inline std::size_t fft_friendly_size(std::size_t n)
+        {
+          std::size_t best = 1;
+          while (best < n)
+            best *= 2;
+
+          for (std::size_t p5 = 1; p5 < best; p5 *= 5)
+            for (std::size_t p35 = p5; p35 < best; p35 *= 3)
+            {
+              std::size_t candidate = p35;
+              while (candidate < n)
+                candidate *= 2;
+              best = std::min(best, candidate);
+            }
+
+          return best;
+        }
+
+        /** @brief Layout of a vector regarded as a batch of size one */
+        template <typename NumericT>
+        fft::layout structured_layout(viennacl::vector_base<NumericT> const & vec)
+        {
+          return fft::layout(viennacl::traits::start(vec), viennacl::traits::stride(vec), 0, 0);
+        }
+
+        /** @brief Layout of the columns of a row-major matrix, regarded as a batch of vectors */
+        template <typename NumericT>
+        fft::layout structured_layout(viennacl::matrix_base<NumericT, viennacl::row_major> const & mat)
+        {
+          std::size_t start = viennacl::traits::start1(mat) * viennacl::traits::internal_size2(mat) + viennacl::traits::start2(mat);
+          return fft::layout(start, viennacl::traits::stride1(mat) * viennacl::traits::internal_size2(mat), viennacl::traits::stride2(mat), 0);
+        }
+
+        /** @brief Layout of the columns of a column-major matrix, regarded as a batch of vectors */
+        template <typename NumericT>
+        fft::layout structured_layout(viennacl::matrix_base<NumericT, viennacl::column_major> const & mat)
+        {
+          std::size_t start = viennacl::traits::start1(mat) + viennacl::traits::start2(mat) * viennacl::traits::internal_size1(mat);
+          return fft::layout(start, viennacl::traits::stride1(mat), viennacl::traits::stride2(mat) * viennacl::traits::internal_size1(mat), 0);
+        }
+
+        /** @brief Writes the first column of a circulant matrix of size column.size() >= 2n-1 to 'column', whose leading n-by-n block is the Toeplitz matrix */
+        template <typename NumericT, unsigned int AlignmentV>
+        void circulant_embedding(viennacl::toeplitz_matrix<NumericT, AlignmentV> const & mat, std::vector<NumericT> & column)
+        {
+          // mat.elements() is the first column of a circulant matrix of size 2n: the first column of the Toeplitz matrix followed by a zero and the (reversed) first row
+          std::size_t n = mat.size1();
+          NumericT const * elements = detail::extract_raw_pointer<NumericT>(mat.elements());
+
+          std::fill(column.begin(), column.end(), NumericT(0));
+          for (std::size_t k = 0; k < n; ++k)
+            column[k] = elements[k];
+          for (std::size_t k = 1; k < n; ++k)
+            column[column.size() - k] = elements[2 * n - k];
+        }
+
+        /** @brief Computes y_b = C * x_b for a batch of vectors, where C is the circulant matrix with first column 'column'.
+        *
+        * Each x_b holds x_size <= column.size() entries and is implicitly padded with zeros. Only the first y_size entries of each result are written to y_b, in reversed order if reverse_result is set.
+        * Two real vectors are transformed at once by placing them in the real and the imaginary part of a complex sequence.
+        * Input and output may refer to the same memory.
+        */
+        template <typename NumericT>
+        void circulant_prod(std::vector<NumericT> const & column,
+                            NumericT const * x, fft::layout const & x_layout, std::size_t x_size,
+                            NumericT       * y, fft::layout const & y_layout, std::size_t y_size,
+                            std::size_t batch_num, bool reverse_result)
+        {
+          typedef std::complex<NumericT>   complex_type;
+
+          std::size_t L = column.size();
+          if (L == 0 || batch_num == 0)
+            return;
+
+          fft::plan<NumericT> const & fwd = fft::get_plan<NumericT>(L, NumericT(-1));
+          fft::plan<NumericT> const & inv = fft::get_plan<NumericT>(L, NumericT(1));
+          NumericT scale = NumericT(1) / static_cast<NumericT>(L);
+
+          if (batch_num == 1)
+          {
+            // transform matrix and vector at once: z = c + i x, hence C_k = (Z_k + conj(Z_{L-k})) / 2 and X_k = (Z_k - conj(Z_{L-k})) / 2i.
+            // Both parts are normalized to unit maximum norm first, so that the smaller part does not drown in the round-off of the larger one.
+            NumericT c_max = 0;
+            NumericT x_max = 0;
+            for (std::size_t k = 0; k < L; ++k)
+              c_max = std::max(c_max, std::fabs(column[k]));
+            for (std::size_t k = 0; k < x_size; ++k)
+              x_max = std::max(x_max, std::fabs(x[x_layout.index(0, k)]));
+
+            if (c_max <= 0 || x_max <= 0)
+            {
+              for (std::size_t i = 0; i < y_size; ++i)
+                y[y_layout.index(0, i)] = 0;
+              return;
+            }
+
+            std::vector<complex_type> z(L);
+            std::vector<complex_type> work(fwd.work_size());
+
+            for (std::size_t k = 0; k < x_size; ++k)
+              z[k] = complex_type(column[k] / c_max, x[x_layout.index(0, k)] / x_max);
+            for (std::size_t k = x_size; k < L; ++k)
+              z[k] = complex_type(column[k] / c_max, 0);
+
+            fwd.execute(&(z[0]), &(work[0]), true);
+
+            NumericT product_scale = scale * c_max * x_max;
+            std::size_t half = L / 2;
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp parallel for if (L > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+            for (std::size_t k = 0; k <= half; ++k)
+            {
+              std::size_t k_mirror = (L - k) % L;
+              complex_type z_k        = z[k];
+              complex_type z_mirror   = std::conj(z[k_mirror]);
+              complex_type c_k        = (z_k + z_mirror) * NumericT(0.5);
+              complex_type x_k        = (z_k - z_mirror) * complex_type(0, NumericT(-0.5));
+              complex_type product    = fft::mul(c_k, x_k) * product_scale;
+
+              z[k]        = product;
+              z[k_mirror] = std::conj(product);  // the result is real, hence its spectrum is Hermitian
+            }
+
+            inv.execute(&(z[0]), &(work[0]), true);
+
+            for (std::size_t i = 0; i < y_size; ++i)
+              y[y_layout.index(0, reverse_result ? y_size - i - 1 : i)] = z[i].real();
+            return;
+          }
+
+          std::vector<complex_type> kernel(L);
+          {
+            std::vector<complex_type> work(fwd.work_size());
+            for (std::size_t k = 0; k < L; ++k)
+              kernel[k] = complex_type(column[k] * scale, 0);
+            fwd.execute(&(kernel[0]), &(work[0]), true);
+          }
+
+          std::size_t pair_num = (batch_num + 1) / 2;
+          bool parallel_pairs = (pair_num > 1);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel if (parallel_pairs)
+#endif
+          {
+            std::vector<complex_type> z(L);
+            std::vector<complex_type> work(fwd.work_size());
+
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for
+#endif
+            for (std::size_t p = 0; p < pair_num; ++p)
+            {
+              std::size_t b = 2 * p;
+              bool has_second = (b + 1 < batch_num);
+
+              for (std::size_t k = 0; k < x_size; ++k)
+                z[k] = complex_type(x[x_layout.index(b, k)], has_second ? x[x_layout.index(b + 1, k)] : NumericT(0));
+              for (std::size_t k = x_size; k < L; ++k)
+                z[k] = 0;
+
+              fwd.execute(&(z[0]), &(work[0]), !parallel_pairs);
+              for (std::size_t k = 0; k < L; ++k)
+                z[k] = fft::mul(z[k], kernel[k]);
+              inv.execute(&(z[0]), &(work[0]), !parallel_pairs);
+
+              for (std::size_t i = 0; i < y_size; ++i)
+              {
+                std::size_t row = reverse_result ? y_size - i - 1 : i;
+                y[y_layout.index(b, row)] = z[i].real();
+                if (has_second)
+                  y[y_layout.index(b + 1, row)] = z[i].imag();
+              }
+            }
+          }
+        }
+
+        /** @brief Computes y_b = V * x_b for a batch of vectors, where V is the Vandermonde matrix with entries nodes[i]^j. Uses Horner's scheme for each row. */
+        template <typename NumericT>
+        void vandermonde_prod(NumericT const * nodes, std::size_t size,
+                              NumericT const * x, fft::layout const & x_layout,
+                              NumericT       * y, fft::layout const & y_layout,
+                              std::size_t batch_num)
+        {
+          // gather input first: contiguous access in the inner loop, and input and output may refer to the same memory
+          std::vector<NumericT> coeffs(size * batch_num);
+          for (std::size_t b = 0; b < batch_num; ++b)
+            for (std::size_t j = 0; j < size; ++j)
+              coeffs[b * size + j] = x[x_layout.index(b, j)];
+
+          // Horner's scheme is a chain of dependent multiply-adds, hence several rows are interleaved to keep the floating point units busy
+          std::size_t const rows_per_block = 8;
+          std::size_t block_num = (size + rows_per_block - 1) / rows_per_block;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (std::size_t block = 0; block < block_num; ++block)
+          {
+            std::size_t row_start = block * rows_per_block;
+            std::size_t row_num   = std::min(rows_per_block, size - row_start);
+
+            NumericT block_nodes[rows_per_block];
+            for (std::size_t r = 0; r < rows_per_block; ++r)
+              block_nodes[r] = (r < row_num) ? nodes[row_start + r] : NumericT(0);
+
+            for (std::size_t b = 0; b < batch_num; ++b)
+            {
+              NumericT const * c = &(coeffs[0]) + b * size;
+              NumericT sums[rows_per_block] = { 0 };
+              for (std::size_t j = size; j > 0; --j)
+              {
+                NumericT c_j = c[j - 1];
+                for (std::size_t r = 0; r < rows_per_block; ++r)
+                  sums[r] = sums[r] * block_nodes[r] + c_j;
+              }
+
+              for (std::size_t r = 0; r < row_num; ++r)
+                y[y_layout.index(b, row_start + r)] = sums[r];
+            }
+          }
+        }
+
+        //
+        // Common implementations for vectors (batch of size one) and matrices (batch of columns)
+        //
+
+        template <typename NumericT, unsigned int AlignmentV, typename ObjectT>
+        void structured_prod(viennacl::circulant_matrix<NumericT, AlignmentV> const & mat, ObjectT const & x, ObjectT & y, std::size_t batch_num)
+        {
+          std::size_t n = mat.size1();
+          NumericT const * elements = detail::extract_raw_pointer<NumericT>(mat.elements());
+          std::vector<NumericT> column(elements, elements + n);
+
+          detail::circulant_prod(column,
+                                 detail::extract_raw_pointer<NumericT>(x), detail::structured_layout(x), n,
+                                 detail::extract_raw_pointer<NumericT>(y), detail::structured_layout(y), n,
+                                 batch_num, false);
+        }
+
+        template <typename NumericT, unsigned int AlignmentV, typename ObjectT>
+        void structured_prod(viennacl::toeplitz_matrix<NumericT, AlignmentV> const & mat, ObjectT const & x, ObjectT & y, std::size_t batch_num,
+                             bool reverse_result = false)
+        {
+          std::size_t n = mat.size1();
+          if (n == 0)
+            return;
+
+          std::vector<NumericT> column(detail::fft_friendly_size(2 * n - 1));
+          detail::circulant_embedding(mat, column);
+
+          detail::circulant_prod(column,
+                                 detail::extract_raw_pointer<NumericT>(x), detail::structured_layout(x), n,
+                                 detail::extract_raw_pointer<NumericT>(y), detail::structured_layout(y), n,
+                                 batch_num, reverse_result);
+        }
+
+        template <typename NumericT, unsigned int AlignmentV, typename ObjectT>
+        void structured_prod(viennacl::hankel_matrix<NumericT, AlignmentV> const & mat, ObjectT const & x, ObjectT & y, std::size_t batch_num)
+        {
+          // H(i,j) = T(n-1-i, j) for the underlying Toeplitz matrix T, hence H * x is T * x in reversed order
+          detail::structured_prod(mat.elements(), x, y, batch_num, true);
+        }
+
+        template <typename NumericT, unsigned int AlignmentV, typename ObjectT>
+        void structured_prod(viennacl::vandermonde_matrix<NumericT, AlignmentV> const & mat, ObjectT const & x, ObjectT & y, std::size_t batch_num)
+        {
+          detail::vandermonde_prod(detail::extract_raw_pointer<NumericT>(mat.elements()), mat.size1(),
+                                   detail::extract_raw_pointer<NumericT>(x), detail::structured_layout(x),
+                                   detail::extract_raw_pointer<NumericT>(y), detail::structured_layout(y),
+                                   batch_num);
+        }
+
+      } //namespace detail
+
+
+      /** @brief Carries out matrix-vector multiplication with a circulant, Toeplitz, Hankel, or Vandermonde matrix
+      *
+      * Implementation of the convenience expression result = prod(mat, vec);
+      *
+      * @param mat    The structured matrix
+      * @param vec    The vector
+      * @param result The result vector
+      */
+      template <typename StructuredMatrixT, typename NumericT>
+      typename viennacl::enable_if< viennacl::is_any_dense_structured_matrix<StructuredMatrixT>::value >::type
+      prod_impl(StructuredMatrixT const & mat,
+                viennacl::vector_base<NumericT> const & vec,
+                viennacl::vector_base<NumericT> & result)
+      {
+        detail::structured_prod(mat, vec, result, 1);
+      }
+
+      /** @brief Carries out the product of a circulant, Toeplitz, Hankel, or Vandermonde matrix with each column of a dense matrix
+      *
+      * Implementation of the convenience expression result = prod(mat, B);
+      *
+      * @param mat    The structured matrix
+      * @param B      The dense matrix whose columns are multiplied
+      * @param result The result matrix
+      */
+      template <typename StructuredMatrixT, typename NumericT, typename F>
+      typename viennacl::enable_if< viennacl::is_any_dense_structured_matrix<StructuredMatrixT>::value >::type
+      prod_impl(StructuredMatrixT const & mat,
+                viennacl::matrix_base<NumericT, F> const & B,
+                viennacl::matrix_base<NumericT, F> & result)
+      {
+        detail::structured_prod(mat, B, result, viennacl::traits::size2(B));
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
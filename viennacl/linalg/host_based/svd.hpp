@@ -0,0 +1,837 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_SVD_HPP_
+#define VIENNACL_LINALG_HOST_BASED_SVD_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/svd.hpp
+    @brief Implementation of the singular value decomposition on the CPU using a single thread or OpenMP.
+
+    The matrix is first reduced to upper bidiagonal form by blocked Householder reflections (the trailing submatrix is updated by two
+    matrix-matrix products per panel, cf. LAPACK's xGEBRD). The orthogonal factors are then formed from the reflectors in blocked (compact WY) form,
+    and the bidiagonal matrix is diagonalized by implicitly shifted QR sweeps (Golub-Kahan), where the Givens rotations of each sweep are applied
+    to the orthogonal factors in parallel.
+*/
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Blocking parameters of the SVD */
+        struct svd_blocking
+        {
+          static const std::size_t block_size = 32;    // number of reflectors per panel of the bidiagonalization and per block when forming the orthogonal factors
+          static const std::size_t crossover  = 128;   // the trailing submatrix is bidiagonalized without blocking once it has at most this many columns
+          static const std::size_t row_chunk  = 256;   // number of rows handled by a thread in matrix-vector products
+          static const std::size_t rotation_rows  = 64;     // minimum number of rows handled by a thread when applying rotations
+          static const std::size_t rotation_batch = 8192;   // rotations are collected over several QR sweeps and applied once this many are pending
+          static const std::size_t max_sweeps = 75;    // maximum number of QR sweeps per singular value
+        };
+
+        // The dense kernels below operate on column-major arrays: Entry (i, j) of A is located at A[i + j * lda].
+
+        /** @brief y = alpha * A^T * x + beta * y, where A is m x n. The entries of y are not read if beta is zero. */
+        template <typename NumericT>
+        void svd_gemv_t(std::size_t m, std::size_t n, NumericT alpha, NumericT const * A, std::size_t lda,
+                        NumericT const * x, std::size_t incx, NumericT beta, NumericT * y, std::size_t incy)
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (m * n > 8192)
+#endif
+          for (long j = 0; j < static_cast<long>(n); ++j)
+          {
+            NumericT const * A_col = A + static_cast<std::size_t>(j) * lda;
+            NumericT dot = 0;
+            for (std::size_t i = 0; i < m; ++i)
+              dot += A_col[i] * x[i * incx];
+            NumericT & y_j = y[static_cast<std::size_t>(j) * incy];
+            y_j = (beta != 0) ? beta * y_j + alpha * dot : alpha * dot;
+          }
+        }
+
+        /** @brief y = alpha * A * x + beta * y, where A is m x n. The entries of y are not read if beta is zero. */
+        template <typename NumericT>
+        void svd_gemv_n(std::size_t m, std::size_t n, NumericT alpha, NumericT const * A, std::size_t lda,
+                        NumericT const * x, std::size_t incx, NumericT beta, NumericT * y, std::size_t incy)
+        {
+          std::size_t const chunk = svd_blocking::row_chunk;
+          std::size_t chunk_num = (m + chunk - 1) / chunk;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel if (chunk_num > 1 && m * n > 8192)
+#endif
+          {
+            std::vector<NumericT> acc(chunk);
+
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for
+#endif
+            for (long c = 0; c < static_cast<long>(chunk_num); ++c)
+            {
+              std::size_t i_begin = static_cast<std::size_t>(c) * chunk;
+              std::size_t rows    = std::min(chunk, m - i_begin);
+
+              std::fill(acc.begin(), acc.begin() + static_cast<long>(rows), NumericT(0));
+              for (std::size_t j = 0; j < n; ++j)
+              {
+                NumericT x_j = x[j * incx];
+                NumericT const * A_col = A + j * lda + i_begin;
+                for (std::size_t i = 0; i < rows; ++i)
+                  acc[i] += A_col[i] * x_j;
+              }
+
+              for (std::size_t i = 0; i < rows; ++i)
+              {
+                NumericT & y_i = y[(i_begin + i) * incy];
+                y_i = (beta != 0) ? beta * y_i + alpha * acc[i] : alpha * acc[i];
+              }
+            }
+          }
+        }
+
+        /** @brief A -= alpha * x * y^T, where A is m x n */
+        template <typename NumericT>
+        void svd_ger(std::size_t m, std::size_t n, NumericT alpha, NumericT const * x, std::size_t incx,
+                     NumericT const * y, std::size_t incy, NumericT * A, std::size_t lda)
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (m * n > 8192)
+#endif
+          for (long j = 0; j < static_cast<long>(n); ++j)
+          {
+            NumericT a_y = alpha * y[static_cast<std::size_t>(j) * incy];
+            NumericT * A_col = A + static_cast<std::size_t>(j) * lda;
+            for (std::size_t i = 0; i < m; ++i)
+              A_col[i] -= x[i * incx] * a_y;
+          }
+        }
+
+        /** @brief sqrt(a^2 + b^2) without destructive underflow or overflow */
+        template <typename NumericT>
+        NumericT svd_hypot(NumericT a, NumericT b)
+        {
+          a = std::fabs(a);
+          b = std::fabs(b);
+          if (a < b)
+            std::swap(a, b);
+          if (a <= 0)
+            return NumericT(0);
+          NumericT ratio = b / a;
+          return a * std::sqrt(NumericT(1) + ratio * ratio);
+        }
+
+        /** @brief Euclidean norm of a vector with n entries, computed without destructive underflow or overflow */
+        template <typename NumericT>
+        NumericT svd_norm(std::size_t n, NumericT const * x, std::size_t incx)
+        {
+          NumericT scale = 0;
+          for (std::size_t i = 0; i < n; ++i)
+            scale = std::max(scale, std::fabs(x[i * incx]));
+          if (scale <= 0)
+            return NumericT(0);
+
+          NumericT sum = 0;
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            NumericT x_i = x[i * incx] / scale;
+            sum += x_i * x_i;
+          }
+          return scale * std::sqrt(sum);
+        }
+
+        /** @brief Generates an elementary reflector H = I - tau * v * v^T such that H * [alpha; x] = [beta; 0] with v = [1; x_new], cf. LAPACK's xLARFG.
+        *
+        * On return, alpha holds beta and x holds the trailing entries of v. The vector [alpha; x] has n entries.
+        */
+        template <typename NumericT>
+        NumericT svd_householder(std::size_t n, NumericT & alpha, NumericT * x, std::size_t incx)
+        {
+          if (n <= 1)
+            return NumericT(0);
+
+          NumericT x_norm = svd_norm(n - 1, x, incx);
+          if (x_norm <= 0)
+            return NumericT(0);
+
+          NumericT beta = svd_hypot(alpha, x_norm);
+          if (alpha >= 0)
+            beta = -beta;
+
+          // rescale if beta is tiny, as 1/(alpha - beta) may overflow otherwise (happens for numerically rank-deficient matrices):
+          NumericT const safe_min  = std::numeric_limits<NumericT>::min() / std::numeric_limits<NumericT>::epsilon();
+          NumericT const safe_scale = NumericT(1) / safe_min;
+          std::size_t rescales = 0;
+          while (std::fabs(beta) < safe_min && rescales < 20)
+          {
+            for (std::size_t i = 0; i < n - 1; ++i)
+              x[i * incx] *= safe_scale;
+            alpha *= safe_scale;
+            beta  *= safe_scale;
+            ++rescales;
+          }
+          if (rescales > 0)
+          {
+            beta = svd_hypot(alpha, svd_norm(n - 1, x, incx));
+            if (alpha >= 0)
+              beta = -beta;
+          }
+
+          NumericT tau = (beta - alpha) / beta;
+          NumericT scale = NumericT(1) / (alpha - beta);
+          for (std::size_t i = 0; i < n - 1; ++i)
+            x[i * incx] *= scale;
+          for (std::size_t i = 0; i < rescales; ++i)
+            beta *= safe_min;
+          alpha = beta;
+
+          return tau;
+        }
+
+        /** @brief Reduces the first nb rows and columns of the m x n matrix A (m >= n) to upper bidiagonal form and returns the matrices X and Y
+        *         needed for updating the trailing submatrix as A - V * Y^T - X * U^T, cf. LAPACK's xLABRD.
+        */
+        template <typename NumericT>
+        void svd_bidiag_panel(std::size_t m, std::size_t n, std::size_t nb, NumericT * A, std::size_t lda,
+                              NumericT * d, NumericT * e, NumericT * tauq, NumericT * taup,
+                              NumericT * X, std::size_t ldx, NumericT * Y, std::size_t ldy)
+        {
+          for (std::size_t i = 0; i < nb; ++i)
+          {
+            NumericT * A_ii = A + i + i * lda;
+
+            // update A(i:m, i)
+            svd_gemv_n(m - i, i, NumericT(-1), A + i, lda, Y + i, ldy, NumericT(1), A_ii, 1);
+            svd_gemv_n(m - i, i, NumericT(-1), X + i, ldx, A + i * lda, 1, NumericT(1), A_ii, 1);
+
+            // generate reflection Q(i) to annihilate A(i+1:m, i)
+            tauq[i] = svd_householder(m - i, *A_ii, A + std::min(i + 1, m - 1) + i * lda, 1);
+            d[i] = *A_ii;
+
+            if (i + 1 < n)
+            {
+              *A_ii = NumericT(1);
+
+              // compute Y(i+1:n, i)
+              NumericT * Y_i = Y + i * ldy;
+              svd_gemv_t(m - i, n - i - 1, NumericT(1),  A_ii + lda, lda, A_ii, 1, NumericT(0), Y_i + i + 1, 1);
+              svd_gemv_t(m - i, i,         NumericT(1),  A + i, lda, A_ii, 1, NumericT(0), Y_i, 1);
+              svd_gemv_n(n - i - 1, i,     NumericT(-1), Y + i + 1, ldy, Y_i, 1, NumericT(1), Y_i + i + 1, 1);
+              svd_gemv_t(m - i, i,         NumericT(1),  X + i, ldx, A_ii, 1, NumericT(0), Y_i, 1);
+              svd_gemv_t(i, n - i - 1,     NumericT(-1), A + (i + 1) * lda, lda, Y_i, 1, NumericT(1), Y_i + i + 1, 1);
+              for (std::size_t j = i + 1; j < n; ++j)
+                Y_i[j] *= tauq[i];
+
+              // update A(i, i+1:n)
+              NumericT * A_row = A_ii + lda;
+              svd_gemv_n(n - i - 1, i + 1, NumericT(-1), Y + i + 1, ldy, A + i, lda, NumericT(1), A_row, lda);
+              svd_gemv_t(i, n - i - 1,     NumericT(-1), A + (i + 1) * lda, lda, X + i, ldx, NumericT(1), A_row, lda);
+
+              // generate reflection P(i) to annihilate A(i, i+2:n)
+              taup[i] = svd_householder(n - i - 1, *A_row, A + i + std::min(i + 2, n - 1) * lda, lda);
+              e[i] = *A_row;
+              *A_row = NumericT(1);
+
+              // compute X(i+1:m, i)
+              NumericT * X_i = X + i * ldx;
+              svd_gemv_n(m - i - 1, n - i - 1, NumericT(1),  A_row + 1, lda, A_row, lda, NumericT(0), X_i + i + 1, 1);
+              svd_gemv_t(n - i - 1, i + 1,     NumericT(1),  Y + i + 1, ldy, A_row, lda, NumericT(0), X_i, 1);
+              svd_gemv_n(m - i - 1, i + 1,     NumericT(-1), A + i + 1, lda, X_i, 1, NumericT(1), X_i + i + 1, 1);
+              svd_gemv_n(i, n - i - 1,         NumericT(1),  A + (i + 1) * lda, lda, A_row, lda, NumericT(0), X_i, 1);
+              svd_gemv_n(m - i - 1, i,         NumericT(-1), X + i + 1, ldx, X_i, 1, NumericT(1), X_i + i + 1, 1);
+              for (std::size_t j = i + 1; j < m; ++j)
+                X_i[j] *= taup[i];
+            }
+            else
+              taup[i] = NumericT(0);
+          }
+        }
+
+        /** @brief Unblocked reduction of the m x n matrix A (m >= n) to upper bidiagonal form, cf. LAPACK's xGEBD2 */
+        template <typename NumericT>
+        void svd_bidiag_unblocked(std::size_t m, std::size_t n, NumericT * A, std::size_t lda,
+                                  NumericT * d, NumericT * e, NumericT * tauq, NumericT * taup)
+        {
+          std::vector<NumericT> work(std::max<std::size_t>(m, n));
+
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            NumericT * A_ii = A + i + i * lda;
+
+            // apply reflection Q(i) from the left to A(i:m, i+1:n):
+            tauq[i] = svd_householder(m - i, *A_ii, A + std::min(i + 1, m - 1) + i * lda, 1);
+            d[i] = *A_ii;
+            if (i + 1 < n && tauq[i] != 0)
+            {
+              *A_ii = NumericT(1);
+              svd_gemv_t(m - i, n - i - 1, NumericT(1), A_ii + lda, lda, A_ii, 1, NumericT(0), &(work[0]), 1);
+              svd_ger(m - i, n - i - 1, tauq[i], A_ii, 1, &(work[0]), 1, A_ii + lda, lda);
+            }
+            *A_ii = d[i];
+
+            // apply reflection P(i) from the right to A(i+1:m, i+1:n):
+            if (i + 1 < n)
+            {
+              NumericT * A_row = A_ii + lda;
+              taup[i] = svd_householder(n - i - 1, *A_row, A + i + std::min(i + 2, n - 1) * lda, lda);
+              e[i] = *A_row;
+              if (i + 1 < m && taup[i] != 0)
+              {
+                *A_row = NumericT(1);
+                svd_gemv_n(m - i - 1, n - i - 1, NumericT(1), A_row + 1, lda, A_row, lda, NumericT(0), &(work[0]), 1);
+                svd_ger(m - i - 1, n - i - 1, taup[i], &(work[0]), 1, A_row, lda, A_row + 1, lda);
+              }
+              *A_row = e[i];
+            }
+            else
+              taup[i] = NumericT(0);
+          }
+        }
+
+        /** @brief Blocked reduction of the m x n matrix A (m >= n) to upper bidiagonal form B = Q^T A P, cf. LAPACK's xGEBRD.
+        *
+        * The diagonal and the superdiagonal of B are returned in d and e, the reflectors defining Q and P are stored in A below the diagonal and right of the superdiagonal.
+        */
+        template <typename NumericT>
+        void svd_bidiag(std::size_t m, std::size_t n, NumericT * A, std::size_t lda,
+                        std::vector<NumericT> & d, std::vector<NumericT> & e, std::vector<NumericT> & tauq, std::vector<NumericT> & taup)
+        {
+          std::size_t const nb = svd_blocking::block_size;
+
+          std::vector<NumericT> X(m * nb);
+          std::vector<NumericT> Y(n * nb);
+
+          std::size_t i = 0;
+          for (; i + svd_blocking::crossover < n; i += nb)
+          {
+            svd_bidiag_panel(m - i, n - i, nb, A + i + i * lda, lda, &(d[i]), &(e[i]), &(tauq[i]), &(taup[i]), &(X[0]), m, &(Y[0]), n);
+
+            // update the trailing submatrix: A = A - V * Y^T - X * U^T
+            std::size_t rows = m - i - nb;
+            std::size_t cols = n - i - nb;
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_V(A, i + nb, i, 1, 1, lda, n);
+            matrix_array_wrapper<NumericT const, column_major_tag, true>  wrapper_Yt(&(Y[0]), nb, 0, 1, 1, n, nb);
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_X(&(X[0]), nb, 0, 1, 1, m, nb);
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_U(A, i, i + nb, 1, 1, lda, n);
+            matrix_array_wrapper<NumericT,       column_major_tag, false> wrapper_A(A, i + nb, i + nb, 1, 1, lda, n);
+
+            detail::prod(wrapper_V, wrapper_Yt, wrapper_A, rows, cols, nb, NumericT(-1), NumericT(1));
+            detail::prod(wrapper_X, wrapper_U,  wrapper_A, rows, cols, nb, NumericT(-1), NumericT(1));
+
+            // restore the bidiagonal entries overwritten by the unit entries of the reflectors:
+            for (std::size_t j = i; j < i + nb; ++j)
+            {
+              A[j + j * lda] = d[j];
+              A[j + (j + 1) * lda] = e[j];
+            }
+          }
+
+          svd_bidiag_unblocked(m - i, n - i, A + i + i * lda, lda, &(d[i]), &(e[i]), &(tauq[i]), &(taup[i]));
+        }
+
+        /** @brief Computes Q(offset:, offset:) = H_0 H_1 ... H_{k-1} Q(offset:, offset:) for the reflectors H_i = I - tau_i v_i v_i^T in blocked (compact WY) form.
+        *
+        * @param V       The reflectors as columns of a column-major r x k array, where v_i has a unit entry at row i and zeros above
+        * @param Q       The orthogonal matrix (column-major with leading dimension ldq), initialized to the identity on entry
+        */
+        template <typename NumericT>
+        void svd_form_orthogonal(std::vector<NumericT> const & V, std::size_t r, std::size_t k, NumericT const * tau,
+                                 NumericT * Q, std::size_t ldq, std::size_t q_cols, std::size_t offset)
+        {
+          std::size_t const nb = svd_blocking::block_size;
+
+          if (k == 0)
+            return;
+
+          std::vector<NumericT> T(nb * nb);
+          std::vector<NumericT> z(nb);
+          std::vector<NumericT> W(nb * r);
+          std::vector<NumericT> TW(nb * r);
+
+          for (std::size_t block = (k - 1) / nb + 1; block > 0; --block)
+          {
+            std::size_t start = (block - 1) * nb;
+            std::size_t width = std::min(nb, k - start);
+            std::size_t len   = r - start;
+
+            // triangular factor T of the block reflector H_start ... H_{start+width-1} = I - V_b T V_b^T, cf. LAPACK's xLARFT:
+            std::fill(T.begin(), T.end(), NumericT(0));
+            for (std::size_t i = 0; i < width; ++i)
+            {
+              NumericT const * v_i = &(V[start + (start + i) * r]);
+              for (std::size_t j = 0; j < i; ++j)
+              {
+                NumericT const * v_j = &(V[start + (start + j) * r]);
+                NumericT dot = 0;
+                for (std::size_t l = i; l < len; ++l)
+                  dot += v_j[l] * v_i[l];
+                z[j] = dot;
+              }
+              for (std::size_t j = 0; j < i; ++j)
+              {
+                NumericT sum = 0;
+                for (std::size_t l = j; l < i; ++l)
+                  sum += T[j + l * nb] * z[l];
+                T[j + i * nb] = -tau[start + i] * sum;
+              }
+              T[i + i * nb] = tau[start + i];
+            }
+
+            // Q_b = Q_b - V_b * (T * (V_b^T * Q_b)), where Q_b = Q(offset+start:offset+r, offset+start:offset+r)
+            matrix_array_wrapper<NumericT const, column_major_tag, true>  wrapper_Vt(&(V[0]), start, start, 1, 1, r, k);
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_V(&(V[0]), start, start, 1, 1, r, k);
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_T(&(T[0]), 0, 0, 1, 1, nb, nb);
+            matrix_array_wrapper<NumericT,       column_major_tag, false> wrapper_W(&(W[0]), 0, 0, 1, 1, nb, r);
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_W_const(&(W[0]), 0, 0, 1, 1, nb, r);
+            matrix_array_wrapper<NumericT,       column_major_tag, false> wrapper_TW(&(TW[0]), 0, 0, 1, 1, nb, r);
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_TW_const(&(TW[0]), 0, 0, 1, 1, nb, r);
+            matrix_array_wrapper<NumericT const, column_major_tag, false> wrapper_Q_const(Q, offset + start, offset + start, 1, 1, ldq, q_cols);
+            matrix_array_wrapper<NumericT,       column_major_tag, false> wrapper_Q(Q, offset + start, offset + start, 1, 1, ldq, q_cols);
+
+            detail::prod(wrapper_Vt, wrapper_Q_const, wrapper_W, width, len, len, NumericT(1), NumericT(0));
+            detail::prod(wrapper_T, wrapper_W_const, wrapper_TW, width, len, width, NumericT(1), NumericT(0));
+            detail::prod(wrapper_V, wrapper_TW_const, wrapper_Q, len, len, width, NumericT(-1), NumericT(1));
+          }
+        }
+
+        /** @brief A Givens rotation acting on columns a and b: (x_a, x_b) <- (c x_a + s x_b, -s x_a + c x_b) */
+        template <typename NumericT>
+        struct svd_rotation
+        {
+          svd_rotation(std::size_t col_a, std::size_t col_b, NumericT cos_val, NumericT sin_val) : a(col_a), b(col_b), c(cos_val), s(sin_val) {}
+
+          std::size_t a, b;
+          NumericT c, s;
+        };
+
+        /** @brief Applies the rotations (in the given order) to the columns of the column-major m x n matrix Q.
+        *
+        * The rows are split into one block per thread, each thread applies all rotations to its block.
+        * Long column segments amortize the per-rotation overhead best, hence the rows are not split into more blocks than there are threads.
+        */
+        template <typename NumericT>
+        void svd_apply_rotations(std::vector< svd_rotation<NumericT> > const & rotations, NumericT * Q, std::size_t m, std::size_t ldq)
+        {
+          std::size_t thread_num = 1;
+#ifdef VIENNACL_WITH_OPENMP
+          thread_num = static_cast<std::size_t>(omp_get_max_threads());
+#endif
+          std::size_t const min_rows = svd_blocking::rotation_rows;  // std::max() takes references, which would require a definition of the static member
+          std::size_t const chunk = std::max(min_rows, (m + thread_num - 1) / thread_num);
+          std::size_t chunk_num = (m + chunk - 1) / chunk;
+
+          if (rotations.empty())
+            return;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (chunk_num > 1 && rotations.size() * m > 8192)
+#endif
+          for (long c = 0; c < static_cast<long>(chunk_num); ++c)
+          {
+            std::size_t i_begin = static_cast<std::size_t>(c) * chunk;
+            std::size_t rows    = std::min(chunk, m - i_begin);
+
+            for (std::size_t r = 0; r < rotations.size(); ++r)
+            {
+              NumericT cs = rotations[r].c;
+              NumericT sn = rotations[r].s;
+              NumericT * q_a = Q + rotations[r].a * ldq + i_begin;
+              NumericT * q_b = Q + rotations[r].b * ldq + i_begin;
+
+              if (r + 1 < rotations.size() && rotations[r + 1].a == rotations[r].b && rotations[r + 1].b != rotations[r].a)
+              {
+                // two subsequent rotations on the columns (a, b) and (b, c), as generated by a QR sweep, are applied in a single pass:
+                NumericT cs2 = rotations[r + 1].c;
+                NumericT sn2 = rotations[r + 1].s;
+                NumericT * q_c = Q + rotations[r + 1].b * ldq + i_begin;
+                for (std::size_t i = 0; i < rows; ++i)
+                {
+                  NumericT x_a = q_a[i];
+                  NumericT x_b = q_b[i];
+                  NumericT x_c = q_c[i];
+                  NumericT t = cs * x_b - sn * x_a;
+                  q_a[i] = cs * x_a + sn * x_b;
+                  q_b[i] = cs2 * t + sn2 * x_c;
+                  q_c[i] = cs2 * x_c - sn2 * t;
+                }
+                ++r;
+              }
+              else
+              {
+                for (std::size_t i = 0; i < rows; ++i)
+                {
+                  NumericT t = cs * q_a[i] + sn * q_b[i];
+                  q_b[i] = cs * q_b[i] - sn * q_a[i];
+                  q_a[i] = t;
+                }
+              }
+            }
+          }
+        }
+
+        /** @brief Diagonalizes the upper bidiagonal matrix with diagonal s and superdiagonal e by implicitly shifted QR sweeps.
+        *
+        * The left rotations are applied to the first n columns of the column-major m x m matrix U, the right rotations to the columns of the n x n matrix V.
+        * On return, s holds the singular values in descending order. The deflation criteria and the shift strategy follow the LINPACK routine xSVDC,
+        * but the rotations are collected over many sweeps before they are applied to U and V.
+        */
+        template <typename NumericT>
+        void svd_bidiag_qr(std::vector<NumericT> & s, std::vector<NumericT> & e,
+                           NumericT * U, std::size_t m, NumericT * V, std::size_t n)
+        {
+          NumericT const eps  = std::numeric_limits<NumericT>::epsilon();
+          NumericT const tiny = std::numeric_limits<NumericT>::min() / eps;
+
+          std::vector< svd_rotation<NumericT> > rotations_U;
+          std::vector< svd_rotation<NumericT> > rotations_V;
+          std::vector<bool> negate(n, false);
+
+          long p = static_cast<long>(n);
+          std::size_t iter = 0;
+
+          e[n - 1] = 0;
+
+          while (p > 0)
+          {
+            // U and V are not needed for the iteration on the bidiagonal matrix, hence rotations are only applied once enough of them are pending:
+            if (rotations_U.size() + rotations_V.size() > svd_blocking::rotation_batch)
+            {
+              svd_apply_rotations(rotations_U, U, m, m);
+              svd_apply_rotations(rotations_V, V, n, n);
+              rotations_U.clear();
+              rotations_V.clear();
+            }
+
+            long k;
+            int kase;
+
+            // find the largest k < p - 1 such that e[k] is negligible:
+            for (k = p - 2; k >= 0; --k)
+            {
+              if (std::fabs(e[k]) <= tiny + eps * (std::fabs(s[k]) + std::fabs(s[k + 1])))
+              {
+                e[k] = 0;
+                break;
+              }
+            }
+
+            if (k == p - 2)
+              kase = 4;      // s[p-1] has converged
+            else
+            {
+              long ks;
+              for (ks = p - 1; ks > k; --ks)
+              {
+                NumericT t = (ks != p ? std::fabs(e[ks]) : NumericT(0)) + (ks != k + 1 ? std::fabs(e[ks - 1]) : NumericT(0));
+                if (std::fabs(s[ks]) <= tiny + eps * t)
+                {
+                  s[ks] = 0;
+                  break;
+                }
+              }
+
+              if (ks == k)
+                kase = 3;    // QR sweep
+              else if (ks == p - 1)
+                kase = 1;    // deflate negligible s[p-1]
+              else
+              {
+                kase = 2;    // split at negligible s[ks]
+                k = ks;
+              }
+            }
+            ++k;
+
+            switch (kase)
+            {
+              case 1:
+              {
+                NumericT f = e[p - 2];
+                e[p - 2] = 0;
+                for (long j = p - 2; j >= k; --j)
+                {
+                  NumericT t  = svd_hypot(s[j], f);
+                  NumericT cs = s[j] / t;
+                  NumericT sn = f / t;
+                  s[j] = t;
+                  if (j != k)
+                  {
+                    f = -sn * e[j - 1];
+                    e[j - 1] = cs * e[j - 1];
+                  }
+                  rotations_V.push_back(svd_rotation<NumericT>(std::size_t(j), std::size_t(p - 1), cs, sn));
+                }
+              }
+              break;
+
+              case 2:
+              {
+                NumericT f = e[k - 1];
+                e[k - 1] = 0;
+                for (long j = k; j < p; ++j)
+                {
+                  NumericT t  = svd_hypot(s[j], f);
+                  NumericT cs = s[j] / t;
+                  NumericT sn = f / t;
+                  s[j] = t;
+                  f = -sn * e[j];
+                  e[j] = cs * e[j];
+                  rotations_U.push_back(svd_rotation<NumericT>(std::size_t(j), std::size_t(k - 1), cs, sn));
+                }
+              }
+              break;
+
+              case 3:
+              {
+                // shift from the trailing 2x2 block:
+                NumericT scale = std::max(std::max(std::max(std::max(std::fabs(s[p - 1]), std::fabs(s[p - 2])), std::fabs(e[p - 2])), std::fabs(s[k])), std::fabs(e[k]));
+                NumericT sp   = s[p - 1] / scale;
+                NumericT spm1 = s[p - 2] / scale;
+                NumericT epm1 = e[p - 2] / scale;
+                NumericT sk   = s[k] / scale;
+                NumericT ek   = e[k] / scale;
+                NumericT b = ((spm1 + sp) * (spm1 - sp) + epm1 * epm1) / NumericT(2);
+                NumericT c = (sp * epm1) * (sp * epm1);
+                NumericT shift = 0;
+                if (b != 0 || c != 0)
+                {
+                  shift = std::sqrt(b * b + c);
+                  if (b < 0)
+                    shift = -shift;
+                  shift = c / (b + shift);
+                }
+                NumericT f = (sk + sp) * (sk - sp) + shift;
+                NumericT g = sk * ek;
+
+                // chase the bulge:
+                for (long j = k; j < p - 1; ++j)
+                {
+                  NumericT t  = svd_hypot(f, g);
+                  NumericT cs = f / t;
+                  NumericT sn = g / t;
+                  if (j != k)
+                    e[j - 1] = t;
+                  f = cs * s[j] + sn * e[j];
+                  e[j] = cs * e[j] - sn * s[j];
+                  g = sn * s[j + 1];
+                  s[j + 1] = cs * s[j + 1];
+                  rotations_V.push_back(svd_rotation<NumericT>(std::size_t(j), std::size_t(j + 1), cs, sn));
+
+                  t  = svd_hypot(f, g);
+                  cs = f / t;
+                  sn = g / t;
+                  s[j] = t;
+                  f = cs * e[j] + sn * s[j + 1];
+                  s[j + 1] = -sn * e[j] + cs * s[j + 1];
+                  g = sn * e[j + 1];
+                  e[j + 1] = cs * e[j + 1];
+                  rotations_U.push_back(svd_rotation<NumericT>(std::size_t(j), std::size_t(j + 1), cs, sn));
+                }
+                e[p - 2] = f;
+
+                // only reached for non-finite input: accept the current iterate instead of sweeping forever
+                if (++iter > svd_blocking::max_sweeps * n)
+                  e[p - 2] = 0;
+              }
+              break;
+
+              case 4:
+              {
+                // make the singular value nonnegative. The sign change of the column of V is deferred, since converged columns are not rotated any further:
+                if (s[k] < 0)
+                {
+                  s[k] = -s[k];
+                  negate[std::size_t(k)] = true;
+                }
+                iter = 0;
+                --p;
+              }
+              break;
+            }
+          }
+
+          svd_apply_rotations(rotations_U, U, m, m);
+          svd_apply_rotations(rotations_V, V, n, n);
+
+          for (std::size_t j = 0; j < n; ++j)
+            if (negate[j])
+              for (std::size_t i = 0; i < n; ++i)
+                V[i + j * n] = -V[i + j * n];
+
+          // sort the singular values in descending order:
+          for (std::size_t j = 0; j + 1 < n; ++j)
+          {
+            std::size_t j_max = j;
+            for (std::size_t l = j + 1; l < n; ++l)
+              if (s[l] > s[j_max])
+                j_max = l;
+
+            if (j_max != j)
+            {
+              std::swap(s[j], s[j_max]);
+              std::swap_ranges(V + j * n, V + (j + 1) * n, V + j_max * n);
+              std::swap_ranges(U + j * m, U + (j + 1) * m, U + j_max * m);
+            }
+          }
+        }
+
+        /** @brief Computes the SVD A = U * diag(s) * V^T of the m x n matrix A (m >= n, column-major with leading dimension m; destroyed on return).
+        *
+        * U is m x m, V is n x n, both column-major.
+        */
+        template <typename NumericT>
+        void svd(std::size_t m, std::size_t n, std::vector<NumericT> & A,
+                 std::vector<NumericT> & s, std::vector<NumericT> & U, std::vector<NumericT> & V)
+        {
+          s.resize(n);
+          U.assign(m * m, NumericT(0));
+          V.assign(n * n, NumericT(0));
+          for (std::size_t i = 0; i < m; ++i)
+            U[i + i * m] = NumericT(1);
+          for (std::size_t i = 0; i < n; ++i)
+            V[i + i * n] = NumericT(1);
+
+          if (n == 0)
+            return;
+
+          std::vector<NumericT> e(n);
+          std::vector<NumericT> tauq(n);
+          std::vector<NumericT> taup(n);
+
+          // stage 1: A = Q * B * P^T
+          svd_bidiag(m, n, &(A[0]), m, s, e, tauq, taup);
+
+          // form Q and P from the reflectors stored in A:
+          {
+            std::vector<NumericT> reflectors(m * n);
+            for (std::size_t j = 0; j < n; ++j)
+              for (std::size_t i = 0; i < m; ++i)
+                reflectors[i + j * m] = (i < j) ? NumericT(0) : ((i == j) ? NumericT(1) : A[i + j * m]);
+            svd_form_orthogonal(reflectors, m, n, &(tauq[0]), &(U[0]), m, m, 0);
+          }
+          if (n > 1)
+          {
+            std::size_t r = n - 1;
+            std::vector<NumericT> reflectors(r * r);
+            for (std::size_t j = 0; j < r; ++j)
+              for (std::size_t i = 0; i < r; ++i)
+                reflectors[i + j * r] = (i < j) ? NumericT(0) : ((i == j) ? NumericT(1) : A[j + (i + 1) * m]);
+            svd_form_orthogonal(reflectors, r, r, &(taup[0]), &(V[0]), n, n, 1);
+          }
+
+          // stage 2: B = U_B * diag(s) * V_B^T, accumulated into U = Q * U_B and V = P * V_B
+          svd_bidiag_qr(s, e, &(U[0]), m, &(V[0]), n);
+        }
+
+      } //namespace detail
+
+
+      /** @brief Computes the singular value decomposition A = QL * Sigma * QR^T of a dense matrix.
+      *
+      * @param A     The input matrix. Will be overwritten with a diagonal matrix containing the singular values (in descending order) on return
+      * @param QL    The left orthogonal matrix
+      * @param QR    The right orthogonal matrix
+      */
+      template <typename NumericT, typename F1, typename F2, typename F3>
+      void svd(matrix_base<NumericT, F1> & A,
+               matrix_base<NumericT, F2> & QL,
+               matrix_base<NumericT, F3> & QR)
+      {
+        std::size_t row_num = viennacl::traits::size1(A);
+        std::size_t col_num = viennacl::traits::size2(A);
+
+        // work on A^T for wide matrices, so that the bidiagonal matrix is always upper bidiagonal:
+        bool transposed = row_num < col_num;
+        std::size_t m = transposed ? col_num : row_num;
+        std::size_t n = transposed ? row_num : col_num;
+
+        detail::matrix_array_wrapper<NumericT, typename F1::orientation_category, false>
+          wrapper_A(detail::extract_raw_pointer<NumericT>(A),
+                    viennacl::traits::start1(A),  viennacl::traits::start2(A),
+                    viennacl::traits::stride1(A), viennacl::traits::stride2(A),
+                    viennacl::traits::internal_size1(A), viennacl::traits::internal_size2(A));
+        detail::matrix_array_wrapper<NumericT, typename F2::orientation_category, false>
+          wrapper_QL(detail::extract_raw_pointer<NumericT>(QL),
+                     viennacl::traits::start1(QL),  viennacl::traits::start2(QL),
+                     viennacl::traits::stride1(QL), viennacl::traits::stride2(QL),
+                     viennacl::traits::internal_size1(QL), viennacl::traits::internal_size2(QL));
+        detail::matrix_array_wrapper<NumericT, typename F3::orientation_category, false>
+          wrapper_QR(detail::extract_raw_pointer<NumericT>(QR),
+                     viennacl::traits::start1(QR),  viennacl::traits::start2(QR),
+                     viennacl::traits::stride1(QR), viennacl::traits::stride2(QR),
+                     viennacl::traits::internal_size1(QR), viennacl::traits::internal_size2(QR));
+
+        std::vector<NumericT> work(m * n);
+        for (std::size_t j = 0; j < n; ++j)
+          for (std::size_t i = 0; i < m; ++i)
+            work[i + j * m] = transposed ? wrapper_A(j, i) : wrapper_A(i, j);
+
+        std::vector<NumericT> s, U, V;
+        detail::svd(m, n, work, s, U, V);
+
+        // A = U * Sigma * V^T, or A^T = U * Sigma * V^T for wide matrices:
+        std::vector<NumericT> const & left  = transposed ? V : U;
+        std::vector<NumericT> const & right = transposed ? U : V;
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long row = 0; row < static_cast<long>(row_num); ++row)
+        {
+          std::size_t i = static_cast<std::size_t>(row);
+          for (std::size_t j = 0; j < row_num; ++j)
+            wrapper_QL(i, j) = left[i + j * row_num];
+          for (std::size_t j = 0; j < col_num; ++j)
+            wrapper_A(i, j) = (i == j) ? s[i] : NumericT(0);
+        }
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long row = 0; row < static_cast<long>(col_num); ++row)
+        {
+          std::size_t i = static_cast<std::size_t>(row);
+          for (std::size_t j = 0; j < col_num; ++j)
+            wrapper_QR(i, j) = right[i + j * col_num];
+        }
+      }
+
+    } //namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
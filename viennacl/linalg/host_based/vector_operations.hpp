@@ -37,11 +37,6 @@
 #include "viennacl/traits/stride.hpp"
 
 
-// Minimum vector size for using OpenMP on vector operations:
-#ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
-  #define VIENNACL_OPENMP_VECTOR_MIN_SIZE  5000
-#endif
-
 namespace viennacl
 {
   namespace linalg
@@ -412,28 +407,53 @@ namespace viennacl
         std::size_t inc_x   = viennacl::traits::stride(x);
         std::size_t size_x  = viennacl::traits::size(x);
 
-        std::vector<value_type> temp(vec_tuple.const_size());
-        std::vector<value_type const *> data_y(vec_tuple.const_size());
-        std::vector<std::size_t> start_y(vec_tuple.const_size());
-        std::vector<std::size_t> stride_y(vec_tuple.const_size());
+        value_type * data_result = detail::extract_raw_pointer<value_type>(result);
+
+        std::size_t start_result = viennacl::traits::start(result);
+        std::size_t inc_result   = viennacl::traits::stride(result);
 
-        for (std::size_t j=0; j<vec_tuple.const_size(); ++j)
+        std::size_t num_vectors = vec_tuple.const_size();
+        std::vector<value_type const *> data_y(num_vectors);
+        std::vector<std::size_t> start_y(num_vectors);
+        std::vector<std::size_t> stride_y(num_vectors);
+
+        for (std::size_t j=0; j<num_vectors; ++j)
         {
           data_y[j] = detail::extract_raw_pointer<value_type>(vec_tuple.const_at(j));
           start_y[j] = viennacl::traits::start(vec_tuple.const_at(j));
           stride_y[j] = viennacl::traits::stride(vec_tuple.const_at(j));
         }
 
-        // Note: No OpenMP here because it cannot perform a reduction on temp-array. Savings in memory bandwidth are expected to still justify this approach...
-        for (std::size_t i = 0; i < size_x; ++i)
+        // x is traversed in blocks small enough to stay in cache while the block is multiplied with all y_j.
+        // Each block writes its own partial results, which are summed up in a fixed order, so the result does not depend on the number of threads.
+        std::size_t const block_size = 4096;
+        long num_blocks = static_cast<long>((size_x + block_size - 1) / block_size);
+        std::vector<value_type> temp(num_blocks * num_vectors);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (size_x > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        for (long block = 0; block < num_blocks; ++block)
         {
-          value_type entry_x = data_x[i*inc_x+start_x];
-          for (std::size_t j=0; j < vec_tuple.const_size(); ++j)
-            temp[j] += entry_x * data_y[j][i*stride_y[j]+start_y[j]];
+          std::size_t block_start = static_cast<std::size_t>(block) * block_size;
+          std::size_t block_end   = std::min(block_start + block_size, size_x);
+          for (std::size_t j=0; j < num_vectors; ++j)
+          {
+            value_type const * y = data_y[j];
+            value_type partial = 0;
+            for (std::size_t i = block_start; i < block_end; ++i)
+              partial += data_x[i*inc_x+start_x] * y[i*stride_y[j]+start_y[j]];
+            temp[static_cast<std::size_t>(block) * num_vectors + j] = partial;
+          }
         }
 
-        for (std::size_t j=0; j < vec_tuple.const_size(); ++j)
-          result[j] = temp[j];  //Note: Assignment to result might be expensive, thus 'temp' is used for accumulation
+        for (std::size_t j=0; j < num_vectors; ++j)
+        {
+          value_type sum = 0;
+          for (long block = 0; block < num_blocks; ++block)
+            sum += temp[static_cast<std::size_t>(block) * num_vectors + j];
+          data_result[j*inc_result+start_result] = sum;
+        }
       }
 
 
@@ -0,0 +1,371 @@
+#ifndef VIENNACL_LINALG_ITERATIVE_OPERATIONS_HPP_
+#define VIENNACL_LINALG_ITERATIVE_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/iterative_operations.hpp
+    @brief Implementations of the fused operations used by the pipelined iterative solvers.
+
+    All vectors are required to be contiguous (start 0, stride 1), which is the case for the vectors created by the solvers.
+    The inner product buffer consists of chunks of equal size, which receive the partial results of the respective inner products.
+    The CG operations use three chunks, the BiCGStab operations address the chunks explicitly.
+    The operations of the CG method for multiple right hand sides work on densely packed row-major matrices and use one chunk per column.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/iterative_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/iterative_operations.hpp"
+#endif
+
+namespace viennacl
+{
+  namespace linalg
+  {
+
+    /** @brief Performs the fused vector update of the pipelined CG method in a single pass:
+    *
+    *   result += alpha * p;
+    *   r      -= alpha * Ap;
+    *   p       = r + beta * p;
+    *
+    * The partial results of the inner product <r, r> of the updated residual are written to the first chunk of 'inner_prod_buffer'.
+    */
+    template <typename T>
+    void pipelined_cg_vector_update(vector_base<T> & result,
+                                    T alpha,
+                                    vector_base<T> & p,
+                                    vector_base<T> & r,
+                                    vector_base<T> const & Ap,
+                                    T beta,
+                                    vector_base<T> & inner_prod_buffer)
+    {
+      assert( (viennacl::traits::size(result) == viennacl::traits::size(p)) && bool("Incompatible vector sizes in pipelined_cg_vector_update()!"));
+      assert( (viennacl::traits::size(result) == viennacl::traits::size(r)) && bool("Incompatible vector sizes in pipelined_cg_vector_update()!"));
+      assert( (viennacl::traits::size(result) == viennacl::traits::size(Ap)) && bool("Incompatible vector sizes in pipelined_cg_vector_update()!"));
+      assert( (viennacl::traits::start(result) == 0 && viennacl::traits::stride(result) == 1) && bool("Vectors of the pipelined solvers must be contiguous!"));
+
+      switch (viennacl::traits::handle(result).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::pipelined_cg_vector_update(result, alpha, p, r, Ap, beta, inner_prod_buffer);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::pipelined_cg_vector_update(result, alpha, p, r, Ap, beta, inner_prod_buffer);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
+    /** @brief Writes the partial results of the inner products <Ap, Ap> and <p, Ap> to the second and third chunk of 'inner_prod_buffer' using a single pass over p and Ap */
+    template <typename T>
+    void pipelined_cg_inner_prods(vector_base<T> const & p,
+                                  vector_base<T> const & Ap,
+                                  vector_base<T> & inner_prod_buffer)
+    {
+      assert( (viennacl::traits::size(p) == viennacl::traits::size(Ap)) && bool("Incompatible vector sizes in pipelined_cg_inner_prods()!"));
+
+      switch (viennacl::traits::handle(p).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::pipelined_cg_inner_prods(p, Ap, inner_prod_buffer);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::pipelined_cg_inner_prods(p, Ap, inner_prod_buffer);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
+    /** @brief Computes Ap = prod(A, p) and writes the partial results of <Ap, Ap> and <p, Ap> to the second and third chunk of 'inner_prod_buffer'.
+    *
+    * Generic version for all matrix types without a fused kernel: The inner products are computed in a single pass after the matrix-vector product.
+    */
+    template <typename MatrixType, typename T>
+    void pipelined_cg_prod(MatrixType const & A,
+                           vector_base<T> const & p,
+                           vector_base<T> & Ap,
+                           vector_base<T> & inner_prod_buffer)
+    {
+      Ap = viennacl::linalg::prod(A, p);
+      pipelined_cg_inner_prods(p, Ap, inner_prod_buffer);
+    }
+
+    /** @brief Computes Ap = prod(A, p) for a compressed_matrix and writes the partial results of <Ap, Ap> and <p, Ap> to the second and third chunk of 'inner_prod_buffer'.
+    *
+    * The inner products are accumulated within the matrix-vector product, so that no additional pass over p and Ap is required.
+    */
+    template <typename T, unsigned int ALIGNMENT>
+    void pipelined_cg_prod(compressed_matrix<T, ALIGNMENT> const & A,
+                           vector_base<T> const & p,
+                           vector_base<T> & Ap,
+                           vector_base<T> & inner_prod_buffer)
+    {
+      assert( (A.size1() == viennacl::traits::size(Ap)) && bool("Size check failed in pipelined_cg_prod(): size1(A) != size(Ap)"));
+      assert( (A.size2() == viennacl::traits::size(p))  && bool("Size check failed in pipelined_cg_prod(): size2(A) != size(p)"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::pipelined_cg_prod(A, p, Ap, inner_prod_buffer);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::pipelined_cg_prod(A, p, Ap, inner_prod_buffer);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
+    /** @brief Performs the fused vector update of the pipelined BiCGStab method in a single pass:
+    *
+    *   result  += alpha * p + omega * s;
+    *   residual = s - omega * As;
+    *   p        = residual + beta * (p - omega * Ap);
+    *
+    * The partial results of the inner products <residual, residual> and <residual, r0star> are written to the first and the second chunk of 'inner_prod_buffer'.
+    */
+    template <typename T>
+    void pipelined_bicgstab_vector_update(vector_base<T> & result, T alpha, vector_base<T> & p, T omega, vector_base<T> const & s,
+                                          vector_base<T> & residual, vector_base<T> const & As,
+                                          T beta, vector_base<T> const & Ap,
+                                          vector_base<T> const & r0star,
+                                          vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size)
+    {
+      assert( (viennacl::traits::size(result) == viennacl::traits::size(p)) && bool("Incompatible vector sizes in pipelined_bicgstab_vector_update()!"));
+      assert( (viennacl::traits::size(result) == viennacl::traits::size(s)) && bool("Incompatible vector sizes in pipelined_bicgstab_vector_update()!"));
+      assert( (viennacl::traits::size(result) == viennacl::traits::size(residual)) && bool("Incompatible vector sizes in pipelined_bicgstab_vector_update()!"));
+      assert( (viennacl::traits::start(result) == 0 && viennacl::traits::stride(result) == 1) && bool("Vectors of the pipelined solvers must be contiguous!"));
+
+      switch (viennacl::traits::handle(result).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::pipelined_bicgstab_vector_update(result, alpha, p, omega, s, residual, As, beta, Ap, r0star, inner_prod_buffer, buffer_chunk_size);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::pipelined_bicgstab_vector_update(result, alpha, p, omega, s, residual, As, beta, Ap, r0star, inner_prod_buffer, buffer_chunk_size);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
+    /** @brief Writes the partial results of the inner products <y, y>, <x, y>, <r0star, y>, and <x, x> to the chunks 'buffer_chunk_offset', ..., 'buffer_chunk_offset' + 3 of 'inner_prod_buffer' using a single pass over x, y, and r0star */
+    template <typename T>
+    void pipelined_bicgstab_inner_prods(vector_base<T> const & x,
+                                        vector_base<T> const & y,
+                                        vector_base<T> const & r0star,
+                                        vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size, std::size_t buffer_chunk_offset)
+    {
+      assert( (viennacl::traits::size(x) == viennacl::traits::size(y)) && bool("Incompatible vector sizes in pipelined_bicgstab_inner_prods()!"));
+
+      switch (viennacl::traits::handle(x).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::pipelined_bicgstab_inner_prods(x, y, r0star, inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::pipelined_bicgstab_inner_prods(x, y, r0star, inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
+    /** @brief Computes y = prod(A, x) and writes the partial results of <y, y>, <x, y>, <r0star, y>, and <x, x> to the chunks 'buffer_chunk_offset', ..., 'buffer_chunk_offset' + 3 of 'inner_prod_buffer'.
+    *
+    * Generic version for all matrix types without a fused kernel: The inner products are computed in a single pass after the matrix-vector product.
+    */
+    template <typename MatrixType, typename T>
+    void pipelined_bicgstab_prod(MatrixType const & A,
+                                 vector_base<T> const & x,
+                                 vector_base<T> & y,
+                                 vector_base<T> const & r0star,
+                                 vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size, std::size_t buffer_chunk_offset)
+    {
+      y = viennacl::linalg::prod(A, x);
+      pipelined_bicgstab_inner_prods(x, y, r0star, inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
+    }
+
+    /** @brief Computes y = prod(A, x) for a compressed_matrix and writes the partial results of <y, y>, <x, y>, <r0star, y>, and <x, x> to the chunks 'buffer_chunk_offset', ..., 'buffer_chunk_offset' + 3 of 'inner_prod_buffer'.
+    *
+    * The inner products are accumulated within the matrix-vector product, so that no additional pass over x and y is required.
+    */
+    template <typename T, unsigned int ALIGNMENT>
+    void pipelined_bicgstab_prod(compressed_matrix<T, ALIGNMENT> const & A,
+                                 vector_base<T> const & x,
+                                 vector_base<T> & y,
+                                 vector_base<T> const & r0star,
+                                 vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size, std::size_t buffer_chunk_offset)
+    {
+      assert( (A.size1() == viennacl::traits::size(y)) && bool("Size check failed in pipelined_bicgstab_prod(): size1(A) != size(y)"));
+      assert( (A.size2() == viennacl::traits::size(x)) && bool("Size check failed in pipelined_bicgstab_prod(): size2(A) != size(x)"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::pipelined_bicgstab_prod(A, x, y, r0star, inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::pipelined_bicgstab_prod(A, x, y, r0star, inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
+    /** @brief Writes the partial results of the inner products <A_j, B_j> of the columns of A and B to the j-th chunk of 'inner_prod_buffer' */
+    template <typename T>
+    void block_cg_inner_prods(matrix_base<T, viennacl::row_major> const & A,
+                              matrix_base<T, viennacl::row_major> const & B,
+                              vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size)
+    {
+      assert( (A.size1() == B.size1() && A.size2() == B.size2()) && bool("Incompatible matrix sizes in block_cg_inner_prods()!"));
+      assert( (A.internal_size2() == B.internal_size2()) && bool("Matrices of the block solvers must be packed in the same way!"));
+      assert( (viennacl::traits::start1(A) == 0 && viennacl::traits::start2(A) == 0 && viennacl::traits::stride1(A) == 1 && viennacl::traits::stride2(A) == 1) && bool("Matrices of the block solvers must be densely packed!"));
+      assert( (viennacl::traits::size(inner_prod_buffer) >= A.size2() * buffer_chunk_size) && bool("Inner product buffer too small in block_cg_inner_prods()!"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::block_cg_inner_prods(A, B, inner_prod_buffer, buffer_chunk_size);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::block_cg_inner_prods(A, B, inner_prod_buffer, buffer_chunk_size);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
+    /** @brief Performs the update of the CG method for multiple right hand sides with step size alpha_j for the j-th column in a single pass:
+    *
+    *   X_j += alpha_j * P_j;
+    *   R_j -= alpha_j * AP_j;
+    *
+    * The partial results of the inner products <R_j, R_j> of the updated residuals are written to the j-th chunk of 'inner_prod_buffer'.
+    */
+    template <typename T>
+    void block_cg_vector_update(matrix_base<T, viennacl::row_major> & X,
+                                vector_base<T> const & alphas,
+                                matrix_base<T, viennacl::row_major> const & P,
+                                matrix_base<T, viennacl::row_major> & R,
+                                matrix_base<T, viennacl::row_major> const & AP,
+                                vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size)
+    {
+      assert( (X.size1() == P.size1() && X.size2() == P.size2()) && bool("Incompatible matrix sizes in block_cg_vector_update()!"));
+      assert( (X.size1() == R.size1() && X.size2() == R.size2()) && bool("Incompatible matrix sizes in block_cg_vector_update()!"));
+      assert( (X.size1() == AP.size1() && X.size2() == AP.size2()) && bool("Incompatible matrix sizes in block_cg_vector_update()!"));
+      assert( (viennacl::traits::start1(X) == 0 && viennacl::traits::start2(X) == 0 && viennacl::traits::stride1(X) == 1 && viennacl::traits::stride2(X) == 1) && bool("Matrices of the block solvers must be densely packed!"));
+      assert( (viennacl::traits::size(alphas) >= X.size2()) && bool("Too few step sizes in block_cg_vector_update()!"));
+      assert( (viennacl::traits::size(inner_prod_buffer) >= X.size2() * buffer_chunk_size) && bool("Inner product buffer too small in block_cg_vector_update()!"));
+
+      switch (viennacl::traits::handle(X).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::block_cg_vector_update(X, alphas, P, R, AP, inner_prod_buffer, buffer_chunk_size);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::block_cg_vector_update(X, alphas, P, R, AP, inner_prod_buffer, buffer_chunk_size);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
+    /** @brief Performs the update of the search directions P_j = R_j + beta_j * P_j of the CG method for multiple right hand sides */
+    template <typename T>
+    void block_cg_direction_update(matrix_base<T, viennacl::row_major> & P,
+                                   matrix_base<T, viennacl::row_major> const & R,
+                                   vector_base<T> const & betas)
+    {
+      assert( (P.size1() == R.size1() && P.size2() == R.size2()) && bool("Incompatible matrix sizes in block_cg_direction_update()!"));
+      assert( (viennacl::traits::start1(P) == 0 && viennacl::traits::start2(P) == 0 && viennacl::traits::stride1(P) == 1 && viennacl::traits::stride2(P) == 1) && bool("Matrices of the block solvers must be densely packed!"));
+      assert( (viennacl::traits::size(betas) >= P.size2()) && bool("Too few step sizes in block_cg_direction_update()!"));
+
+      switch (viennacl::traits::handle(P).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::block_cg_direction_update(P, R, betas);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::block_cg_direction_update(P, R, betas);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
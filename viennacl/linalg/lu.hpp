@@ -19,16 +19,18 @@
 ============================================================================= */
 
 /** @file viennacl/linalg/lu.hpp
-    @brief Implementations of LU factorization for row-major and column-major dense matrices.
+    @brief Implementations of LU factorization (with or without partial pivoting) for row-major and column-major dense matrices.
 */
 
 #include <algorithm>    //for std::min
+#include <vector>
 
 #include "viennacl/matrix.hpp"
 #include "viennacl/matrix_proxy.hpp"
 
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/host_based/lu.hpp"
 
 namespace viennacl
 {
@@ -43,6 +45,13 @@ namespace viennacl
     {
       typedef matrix<SCALARTYPE, viennacl::row_major>  MatrixType;
 
+      if (viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY)
+      {
+        std::vector<vcl_size_t> permutation;
+        viennacl::linalg::host_based::lu_factorize(A, permutation, false);
+        return;
+      }
+
       std::size_t max_block_size = 32;
       std::size_t num_blocks = (A.size2() - 1) / max_block_size + 1;
       std::vector<SCALARTYPE> temp_buffer(A.internal_size2() * max_block_size);
@@ -119,6 +128,13 @@ namespace viennacl
     {
       typedef matrix<SCALARTYPE, viennacl::column_major>  MatrixType;
 
+      if (viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY)
+      {
+        std::vector<vcl_size_t> permutation;
+        viennacl::linalg::host_based::lu_factorize(A, permutation, false);
+        return;
+      }
+
       std::size_t max_block_size = 32;
       std::size_t num_blocks = (A.size1() - 1) / max_block_size + 1;
       std::vector<SCALARTYPE> temp_buffer(A.internal_size1() * max_block_size);
@@ -188,6 +204,86 @@ namespace viennacl
     }
 
 
+    /** @brief LU factorization with partial (row) pivoting of a dense matrix, i.e. P A = L U.
+    *
+    * Unlike lu_factorize(A), this is also suitable for matrices which are not diagonally dominant.
+    * For matrices not located in main memory, the factorization is computed on a host copy of the matrix.
+    *
+    * @param A            The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+    * @param permutation  On return, row i of L U is row permutation[i] of the original matrix A. Pass to lu_substitute() for solving systems.
+    */
+    template<typename SCALARTYPE, typename F>
+    void lu_factorize(matrix_base<SCALARTYPE, F> & A, std::vector<vcl_size_t> & permutation)
+    {
+      assert(A.size1() == A.size2() && bool("Matrix must be square"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::lu_factorize(A, permutation);
+          break;
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+        {
+          std::vector<SCALARTYPE> buffer(A.internal_size());
+          viennacl::backend::memory_read(A.handle(), 0, sizeof(SCALARTYPE) * buffer.size(), &(buffer[0]));
+
+          viennacl::linalg::host_based::detail::lu_matrix_view<SCALARTYPE, F> view(&(buffer[0]),
+                                                                                  viennacl::traits::start1(A),  viennacl::traits::start2(A),
+                                                                                  viennacl::traits::stride1(A), viennacl::traits::stride2(A),
+                                                                                  A.internal_size1(), A.internal_size2());
+          viennacl::linalg::host_based::detail::lu_factorize(view, A.size1(), permutation, true);
+
+          viennacl::backend::memory_write(A.handle(), 0, sizeof(SCALARTYPE) * buffer.size(), &(buffer[0]));
+        }
+      }
+    }
+
+
+    namespace detail
+    {
+      /** @brief Replaces B by P B, where row i of P B is row permutation[i] of B */
+      template<typename SCALARTYPE, typename F>
+      void lu_permute_rows(matrix_base<SCALARTYPE, F> & B, std::vector<vcl_size_t> const & permutation)
+      {
+        assert(B.size1() == permutation.size() && bool("Size mismatch"));
+
+        std::vector<SCALARTYPE> buffer(B.internal_size());
+        std::vector<SCALARTYPE> permuted(B.internal_size());
+        viennacl::backend::memory_read(B.handle(), 0, sizeof(SCALARTYPE) * buffer.size(), &(buffer[0]));
+        permuted = buffer;
+
+        for (std::size_t i = 0; i < B.size1(); ++i)
+          for (std::size_t j = 0; j < B.size2(); ++j)
+            permuted[F::mem_index(viennacl::traits::start1(B) + i * viennacl::traits::stride1(B),
+                                  viennacl::traits::start2(B) + j * viennacl::traits::stride2(B),
+                                  B.internal_size1(), B.internal_size2())]
+              = buffer[F::mem_index(viennacl::traits::start1(B) + permutation[i] * viennacl::traits::stride1(B),
+                                    viennacl::traits::start2(B) + j              * viennacl::traits::stride2(B),
+                                    B.internal_size1(), B.internal_size2())];
+
+        viennacl::backend::memory_write(B.handle(), 0, sizeof(SCALARTYPE) * permuted.size(), &(permuted[0]));
+      }
+
+      /** @brief Replaces vec by P vec, where entry i of P vec is entry permutation[i] of vec */
+      template<typename SCALARTYPE>
+      void lu_permute_rows(vector_base<SCALARTYPE> & vec, std::vector<vcl_size_t> const & permutation)
+      {
+        assert(vec.size() == permutation.size() && bool("Size mismatch"));
+
+        std::vector<SCALARTYPE> buffer(vec.size());
+        std::vector<SCALARTYPE> permuted(vec.size());
+        viennacl::copy(vec.begin(), vec.end(), buffer.begin());
+
+        for (std::size_t i = 0; i < buffer.size(); ++i)
+          permuted[i] = buffer[permutation[i]];
+
+        viennacl::copy(permuted.begin(), permuted.end(), vec.begin());
+      }
+    }
+
+
     //
     // Convenience layer:
     //
@@ -221,6 +317,41 @@ namespace viennacl
       inplace_solve(A, vec, upper_tag());
     }
 
+    /** @brief LU substitution for the system P^{-1} LU = rhs, where the permutation P was computed by lu_factorize(A, permutation).
+    *
+    * @param A            The LU factors as computed by lu_factorize(A, permutation).
+    * @param permutation  The row permutation as computed by lu_factorize(A, permutation).
+    * @param B            The matrix of load vectors, where the solution is directly written to
+    */
+    template<typename SCALARTYPE, typename F1, typename F2, unsigned int ALIGNMENT_A, unsigned int ALIGNMENT_B>
+    void lu_substitute(matrix<SCALARTYPE, F1, ALIGNMENT_A> const & A,
+                       std::vector<vcl_size_t> const & permutation,
+                       matrix<SCALARTYPE, F2, ALIGNMENT_B> & B)
+    {
+      assert(A.size1() == A.size2() && bool("Matrix must be square"));
+      assert(A.size1() == B.size1() && bool("Matrix must be square"));
+      detail::lu_permute_rows(B, permutation);
+      inplace_solve(A, B, unit_lower_tag());
+      inplace_solve(A, B, upper_tag());
+    }
+
+    /** @brief LU substitution for the system P^{-1} LU = rhs, where the permutation P was computed by lu_factorize(A, permutation).
+    *
+    * @param A            The LU factors as computed by lu_factorize(A, permutation).
+    * @param permutation  The row permutation as computed by lu_factorize(A, permutation).
+    * @param vec          The load vector, where the solution is directly written to
+    */
+    template<typename SCALARTYPE, typename F, unsigned int ALIGNMENT, unsigned int VEC_ALIGNMENT>
+    void lu_substitute(matrix<SCALARTYPE, F, ALIGNMENT> const & A,
+                       std::vector<vcl_size_t> const & permutation,
+                       vector<SCALARTYPE, VEC_ALIGNMENT> & vec)
+    {
+      assert(A.size1() == A.size2() && bool("Matrix must be square"));
+      detail::lu_permute_rows(vec, permutation);
+      inplace_solve(A, vec, unit_lower_tag());
+      inplace_solve(A, vec, upper_tag());
+    }
+
   }
 }
 
@@ -33,9 +33,14 @@
 #include "viennacl/traits/clear.hpp"
 #include "viennacl/traits/size.hpp"
 #include "viennacl/meta/result_of.hpp"
-#include "viennacl/ocl/backend.hpp"
-#include "viennacl/ocl/kernel.hpp"
 #include "viennacl/backend/memory.hpp"
+#include "viennacl/backend/util.hpp"
+#include "viennacl/linalg/host_based/mixed_precision_cg.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/ocl/backend.hpp"
+  #include "viennacl/ocl/kernel.hpp"
+#endif
 
 #include "viennacl/vector_proxy.hpp"
 
@@ -55,7 +60,8 @@ namespace viennacl
         * @param max_iterations   The maximum number of iterations
         * @param inner_tol        Inner tolerance for the low-precision iterations
         */
-        mixed_precision_cg_tag(double tol = 1e-8, unsigned int max_iterations = 300, float inner_tol = 1e-2f) : tol_(tol), iterations_(max_iterations), inner_tol_(inner_tol) {};
+        mixed_precision_cg_tag(double tol = 1e-8, unsigned int max_iterations = 300, float inner_tol = 1e-2f)
+          : tol_(tol), iterations_(max_iterations), inner_tol_(inner_tol), iters_taken_(0), outer_iters_taken_(0), last_error_(0) {};
 
         /** @brief Returns the relative tolerance */
         double tolerance() const { return tol_; }
@@ -64,10 +70,18 @@ namespace viennacl
         /** @brief Returns the maximum number of iterations */
         unsigned int max_iterations() const { return iterations_; }
 
-        /** @brief Return the number of solver iterations: */
+        /** @brief Return the number of solver iterations, i.e. the total number of low-precision inner iterations: */
         unsigned int iters() const { return iters_taken_; }
         void iters(unsigned int i) const { iters_taken_ = i; }
 
+        /** @brief Returns the total number of low-precision inner iterations. Same as iters() */
+        unsigned int inner_iters() const { return iters_taken_; }
+
+        /** @brief Returns the number of outer iterations, i.e. the number of high-precision defect corrections */
+        unsigned int outer_iters() const { return outer_iters_taken_; }
+        /** @brief Sets the number of outer iterations */
+        void outer_iters(unsigned int i) const { outer_iters_taken_ = i; }
+
         /** @brief Returns the estimated relative error at the end of the solver run */
         double error() const { return last_error_; }
         /** @brief Sets the estimated relative error at the end of the solver run */
@@ -81,28 +95,87 @@ namespace viennacl
 
         //return values from solver
         mutable unsigned int iters_taken_;
+        mutable unsigned int outer_iters_taken_;
         mutable double last_error_;
     };
 
 
-    const char * double_float_conversion_program =
-    "#pragma OPENCL EXTENSION cl_khr_fp64 : enable \n"
-    "__kernel void assign_double_to_float(\n"
-    "          __global float * vec1,\n"
-    "          __global const double * vec2, \n"
-    "          unsigned int size) \n"
-    "{ \n"
-    "  for (unsigned int i = get_global_id(0); i < size; i += get_global_size(0))\n"
-    "    vec1[i] = (float)(vec2[i]);\n"
-    "};\n\n"
-    "__kernel void inplace_add_float_to_double(\n"
-    "          __global double * vec1,\n"
-    "          __global const float * vec2, \n"
-    "          unsigned int size) \n"
-    "{ \n"
-    "  for (unsigned int i = get_global_id(0); i < size; i += get_global_size(0))\n"
-    "    vec1[i] += (double)(vec2[i]);\n"
-    "};\n";
+    namespace detail
+    {
+#ifdef VIENNACL_WITH_OPENCL
+      static const char * double_float_conversion_program =
+      "#pragma OPENCL EXTENSION cl_khr_fp64 : enable \n"
+      "__kernel void assign_double_to_float(\n"
+      "          __global float * vec1,\n"
+      "          __global const double * vec2, \n"
+      "          unsigned int size) \n"
+      "{ \n"
+      "  for (unsigned int i = get_global_id(0); i < size; i += get_global_size(0))\n"
+      "    vec1[i] = (float)(vec2[i]);\n"
+      "};\n\n"
+      "__kernel void inplace_add_float_to_double(\n"
+      "          __global double * vec1,\n"
+      "          __global const float * vec2, \n"
+      "          unsigned int size) \n"
+      "{ \n"
+      "  for (unsigned int i = get_global_id(0); i < size; i += get_global_size(0))\n"
+      "    vec1[i] += (double)(vec2[i]);\n"
+      "};\n";
+
+      inline viennacl::ocl::kernel & double_float_conversion_kernel(viennacl::ocl::context & ctx, std::string const & name)
+      {
+        if (!ctx.has_program("double_float_conversion_program"))
+          ctx.add_program(double_float_conversion_program, "double_float_conversion_program");
+        return ctx.get_kernel("double_float_conversion_program", name);
+      }
+#endif
+
+      /** @brief Writes the first 'size' entries of the double precision buffer 'src' to the single precision buffer 'dst' */
+      inline void assign_double_to_float(viennacl::backend::mem_handle & dst, viennacl::backend::mem_handle const & src, std::size_t size)
+      {
+        switch (src.get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            viennacl::linalg::host_based::assign_double_to_float(dst, src, size);
+            break;
+#ifdef VIENNACL_WITH_OPENCL
+          case viennacl::OPENCL_MEMORY:
+          {
+            viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(src.opencl_handle().context());
+            viennacl::ocl::enqueue( double_float_conversion_kernel(ctx, "assign_double_to_float")(dst.opencl_handle(), src.opencl_handle(), cl_uint(size)) );
+            break;
+          }
+#endif
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            throw memory_exception("not implemented");
+        }
+      }
+
+      /** @brief Adds the first 'size' entries of the single precision buffer 'src' to the double precision buffer 'dst' */
+      inline void inplace_add_float_to_double(viennacl::backend::mem_handle & dst, viennacl::backend::mem_handle const & src, std::size_t size)
+      {
+        switch (src.get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            viennacl::linalg::host_based::inplace_add_float_to_double(dst, src, size);
+            break;
+#ifdef VIENNACL_WITH_OPENCL
+          case viennacl::OPENCL_MEMORY:
+          {
+            viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(src.opencl_handle().context());
+            viennacl::ocl::enqueue( double_float_conversion_kernel(ctx, "inplace_add_float_to_double")(dst.opencl_handle(), src.opencl_handle(), cl_uint(size)) );
+            break;
+          }
+#endif
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            throw memory_exception("not implemented");
+        }
+      }
+    }
 
 
     /** @brief Implementation of the conjugate gradient solver without preconditioner
@@ -134,17 +207,12 @@ namespace viennacl
       CPU_ScalarType new_ip_rr = 0;
       CPU_ScalarType norm_rhs_squared = ip_rr;
 
+      tag.iters(0);
+      tag.outer_iters(0);
+      tag.error(0);
       if (norm_rhs_squared == 0) //solution is zero if RHS norm is zero
         return result;
 
-      static bool first = true;
-
-      viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(matrix).context());
-      if (first)
-      {
-        ctx.add_program(double_float_conversion_program, "double_float_conversion_program");
-      }
-
       viennacl::vector<float> residual_low_precision(problem_size, viennacl::traits::context(rhs));
       viennacl::vector<float> result_low_precision(problem_size, viennacl::traits::context(rhs));
       viennacl::vector<float> p_low_precision(problem_size, viennacl::traits::context(rhs));
@@ -155,32 +223,17 @@ namespace viennacl
       float alpha;
       float beta;
 
-      viennacl::ocl::kernel & assign_double_to_float      = ctx.get_kernel("double_float_conversion_program", "assign_double_to_float");
-      viennacl::ocl::kernel & inplace_add_float_to_double = ctx.get_kernel("double_float_conversion_program", "inplace_add_float_to_double");
-
       // transfer rhs to single precision:
-      viennacl::ocl::enqueue( assign_double_to_float(p_low_precision.handle().opencl_handle(),
-                                                     rhs.handle().opencl_handle(),
-                                                     cl_uint(rhs.size())
-                                                    ) );
-      //std::cout << "copying p_low_precision..." << std::endl;
-      //assign_double_to_float(p_low_precision.handle(), residual.handle(), residual.size());
+      detail::assign_double_to_float(p_low_precision.handle(), rhs.handle(), rhs.size());
       residual_low_precision = p_low_precision;
 
-      // transfer matrix to single precision:
+      // transfer matrix to single precision. The index arrays are copied as-is, only the values are converted:
       viennacl::compressed_matrix<float> matrix_low_precision(matrix.size1(), matrix.size2(), matrix.nnz(), viennacl::traits::context(rhs));
-      viennacl::backend::memory_copy(matrix.handle1(), const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle1()), 0, 0, sizeof(cl_uint) * (matrix.size1() + 1) );
-      viennacl::backend::memory_copy(matrix.handle2(), const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle2()), 0, 0, sizeof(cl_uint) * (matrix.nnz()) );
-
-      viennacl::ocl::enqueue( assign_double_to_float(matrix_low_precision.handle().opencl_handle(),
-                                                     matrix.handle().opencl_handle(),
-                                                     cl_uint(matrix.nnz())
-                                                    ) );
-      //std::cout << "copying matrix_low_precision..." << std::endl;
-      //assign_double_to_float(const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle()), matrix.handle(), matrix.nnz());
-
-      //std::cout << "Starting CG solver iterations... " << std::endl;
+      std::size_t index_size = viennacl::backend::typesafe_host_array<unsigned int>(matrix.handle1()).element_size();
+      viennacl::backend::memory_copy(matrix.handle1(), const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle1()), 0, 0, index_size * (matrix.size1() + 1) );
+      viennacl::backend::memory_copy(matrix.handle2(), const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle2()), 0, 0, index_size * (matrix.nnz()) );
 
+      detail::assign_double_to_float(const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle()), matrix.handle(), matrix.nnz());
 
       for (unsigned int i = 0; i < tag.max_iterations(); ++i)
       {
@@ -204,12 +257,10 @@ namespace viennacl
 
         if (new_inner_ip_rr < tag.inner_tolerance() * initial_inner_rhs_norm_squared || i == tag.max_iterations()-1)
         {
-          //std::cout << "outer correction at i=" << i << std::endl;
-          //result += result_low_precision;
-          viennacl::ocl::enqueue( inplace_add_float_to_double(result.handle().opencl_handle(),
-                                                              result_low_precision.handle().opencl_handle(),
-                                                              cl_uint(result.size())
-                                                             ) );
+          tag.outer_iters(tag.outer_iters() + 1);
+
+          // result += result_low_precision;
+          detail::inplace_add_float_to_double(result.handle(), result_low_precision.handle(), result.size());
 
           // residual = b - Ax  (without introducing a temporary)
           residual = viennacl::linalg::prod(matrix, result);
@@ -220,10 +271,7 @@ namespace viennacl
             break;
 
           // p_low_precision = residual;
-          viennacl::ocl::enqueue( assign_double_to_float(p_low_precision.handle().opencl_handle(),
-                                                         residual.handle().opencl_handle(),
-                                                         cl_uint(residual.size())
-                                                        ) );
+          detail::assign_double_to_float(p_low_precision.handle(), residual.handle(), residual.size());
           result_low_precision.clear();
           residual_low_precision = p_low_precision;
           initial_inner_rhs_norm_squared = static_cast<float>(new_ip_rr);
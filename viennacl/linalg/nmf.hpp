@@ -30,7 +30,14 @@
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/norm_frobenius.hpp"
-#include "viennacl/linalg/opencl/kernels/nmf.hpp"
+#include "viennacl/linalg/host_based/nmf_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/kernels/nmf.hpp"
+#endif
+
+#include <vector>
+#include <iostream>
 
 namespace viennacl
 {
@@ -47,6 +54,7 @@ namespace viennacl
          : eps_(val_epsilon), stagnation_eps_(val_epsilon_stagnation),
            max_iters_(num_max_iters),
            check_after_steps_( (num_check_iters > 0) ? num_check_iters : 1),
+           print_relative_error_(false),
            iters_(0) {}
 
         /** @brief Returns the relative tolerance for convergence */
@@ -78,6 +86,21 @@ namespace viennacl
         void check_after_steps(std::size_t c) { if (c > 0) check_after_steps_ = c; }
 
 
+        /** @brief Returns the relative residuals norm(V - W * H) / norm(V - W_1 * H_1) of the last NMF run, where W_1 and H_1 are the factors after the first iteration.
+        *
+        * One entry is recorded for each convergence check, i.e. entry i refers to iteration i * check_after_steps() + 1.
+        * Use check_after_steps(1) to obtain the residuals of all iterations.
+        */
+        std::vector<double> const & residuals() const { return residuals_; }
+
+
+        /** @brief Returns whether the relative residual is printed to std::cout at each convergence check */
+        bool print_relative_error() const { return print_relative_error_; }
+
+        /** @brief Sets whether the relative residual is printed to std::cout at each convergence check */
+        void print_relative_error(bool b) { print_relative_error_ = b; }
+
+
         template <typename ScalarType>
         friend void nmf(viennacl::matrix<ScalarType> const & V,
                         viennacl::matrix<ScalarType> & W,
@@ -89,10 +112,99 @@ namespace viennacl
         double stagnation_eps_;
         std::size_t max_iters_;
         std::size_t check_after_steps_;
+        bool print_relative_error_;
         mutable std::size_t iters_;
+        mutable std::vector<double> residuals_;
     };
 
 
+    namespace detail
+    {
+      /** @brief Update step H = H .* numerator ./ (gram * H) of the multiplicative update rule */
+      template <typename ScalarType>
+      void nmf_update_left(viennacl::matrix<ScalarType> & H,
+                           viennacl::matrix<ScalarType> const & numerator,
+                           viennacl::matrix<ScalarType> const & gram)
+      {
+        switch (viennacl::traits::handle(H).get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            viennacl::linalg::host_based::nmf_update_left(H, numerator, gram);
+            break;
+#ifdef VIENNACL_WITH_OPENCL
+          case viennacl::OPENCL_MEMORY:
+          {
+            viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(H).context());
+            viennacl::linalg::opencl::kernels::nmf<ScalarType>::init(ctx);
+
+            viennacl::matrix<ScalarType> denominator = viennacl::linalg::prod(gram, H);
+
+            viennacl::ocl::kernel & mul_div_kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::nmf<ScalarType>::program_name(), "el_wise_mul_div");
+            viennacl::ocl::enqueue(mul_div_kernel(H, numerator, denominator, cl_uint(H.internal_size1() * H.internal_size2())));
+          }
+            break;
+#endif
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            throw memory_exception("not implemented");
+        }
+      }
+
+      /** @brief Update step W = W .* numerator ./ (W * gram) of the multiplicative update rule */
+      template <typename ScalarType>
+      void nmf_update_right(viennacl::matrix<ScalarType> & W,
+                            viennacl::matrix<ScalarType> const & numerator,
+                            viennacl::matrix<ScalarType> const & gram)
+      {
+        switch (viennacl::traits::handle(W).get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            viennacl::linalg::host_based::nmf_update_right(W, numerator, gram);
+            break;
+#ifdef VIENNACL_WITH_OPENCL
+          case viennacl::OPENCL_MEMORY:
+          {
+            viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(W).context());
+            viennacl::linalg::opencl::kernels::nmf<ScalarType>::init(ctx);
+
+            viennacl::matrix<ScalarType> denominator = viennacl::linalg::prod(W, gram);
+
+            viennacl::ocl::kernel & mul_div_kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::nmf<ScalarType>::program_name(), "el_wise_mul_div");
+            viennacl::ocl::enqueue(mul_div_kernel(W, numerator, denominator, cl_uint(W.internal_size1() * W.internal_size2())));
+          }
+            break;
+#endif
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            throw memory_exception("not implemented");
+        }
+      }
+
+      /** @brief Returns the residual norm ||V - W * H||_F */
+      template <typename ScalarType>
+      ScalarType nmf_residual(viennacl::matrix<ScalarType> const & V,
+                              viennacl::matrix<ScalarType> const & W,
+                              viennacl::matrix<ScalarType> const & H)
+      {
+        switch (viennacl::traits::handle(V).get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            return viennacl::linalg::host_based::nmf_residual(V, W, H);
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+          {
+            viennacl::matrix<ScalarType> appr = viennacl::linalg::prod(W, H);
+            appr -= V;
+            return viennacl::linalg::norm_frobenius(appr);
+          }
+        }
+      }
+    }
+
+
     /** @brief The nonnegative matrix factorization (approximation) algorithm as suggested by Lee and Seung. Factorizes a matrix V with nonnegative entries into matrices W and H such that ||V - W*H|| is minimized.
      *
      * @param V     Input matrix
@@ -106,28 +218,16 @@ namespace viennacl
              viennacl::matrix<ScalarType> & H,
              nmf_config const & conf)
     {
-      viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(V).context());
-
-      const std::string NMF_MUL_DIV_KERNEL = "el_wise_mul_div";
-
-      viennacl::linalg::opencl::kernels::nmf<ScalarType>::init(ctx);
-
       assert(V.size1() == W.size1() && V.size2() == H.size2() && bool("Dimensions of W and H don't allow for V = W * H"));
       assert(W.size2() == H.size1() && bool("Dimensions of W and H don't match, prod(W, H) impossible"));
 
       std::size_t k = W.size2();
       conf.iters_ = 0;
+      conf.residuals_.clear();
 
       viennacl::matrix<ScalarType> wn(V.size1(), k);
-      viennacl::matrix<ScalarType> wd(V.size1(), k);
-      viennacl::matrix<ScalarType> wtmp(V.size1(), V.size2());
-
       viennacl::matrix<ScalarType> hn(k, V.size2());
-      viennacl::matrix<ScalarType> hd(k, V.size2());
-      viennacl::matrix<ScalarType> htmp(k, k);
-
-      viennacl::matrix<ScalarType> appr(V.size1(), V.size2());
-      viennacl::vector<ScalarType> diff(V.size1() * V.size2());
+      viennacl::matrix<ScalarType> gram(k, k);
 
       ScalarType last_diff = 0;
       ScalarType diff_init = 0;
@@ -139,36 +239,29 @@ namespace viennacl
         conf.iters_ = i + 1;
         {
           hn   = viennacl::linalg::prod(trans(W), V);
-          htmp = viennacl::linalg::prod(trans(W), W);
-          hd   = viennacl::linalg::prod(htmp, H);
-
-          viennacl::ocl::kernel & mul_div_kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::nmf<ScalarType>::program_name(), NMF_MUL_DIV_KERNEL);
-          viennacl::ocl::enqueue(mul_div_kernel(H, hn, hd, cl_uint(H.internal_size1() * H.internal_size2())));
+          gram = viennacl::linalg::prod(trans(W), W);
+          detail::nmf_update_left(H, hn, gram);      // H = H .* hn ./ (W^T W H)
         }
         {
           wn   = viennacl::linalg::prod(V, trans(H));
-          wtmp = viennacl::linalg::prod(W, H);
-          wd   = viennacl::linalg::prod(wtmp, trans(H));
-
-          viennacl::ocl::kernel & mul_div_kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::nmf<ScalarType>::program_name(), NMF_MUL_DIV_KERNEL);
-
-          viennacl::ocl::enqueue(mul_div_kernel(W, wn, wd, cl_uint(W.internal_size1() * W.internal_size2())));
+          gram = viennacl::linalg::prod(H, trans(H));
+          detail::nmf_update_right(W, wn, gram);     // W = W .* wn ./ (W H H^T), avoids the product W * H
         }
 
         if (i % conf.check_after_steps() == 0)  //check for convergence
         {
-          appr = viennacl::linalg::prod(W, H);
-
-          appr -= V;
-          ScalarType diff_val = viennacl::linalg::norm_frobenius(appr);
+          ScalarType diff_val = detail::nmf_residual(V, W, H);
 
           if (i == 0)
             diff_init = diff_val;
 
-          std::cout << diff_val / diff_init << std::endl;
+          double relative_diff = (diff_init > 0) ? diff_val / diff_init : 0;
+          conf.residuals_.push_back(relative_diff);
+          if (conf.print_relative_error())
+            std::cout << relative_diff << std::endl;
 
           // Approximation check
-          if (diff_val / diff_init < conf.tolerance())
+          if (relative_diff < conf.tolerance())
             break;
 
           // Stagnation check
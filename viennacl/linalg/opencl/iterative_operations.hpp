@@ -0,0 +1,290 @@
+#ifndef VIENNACL_LINALG_OPENCL_ITERATIVE_OPERATIONS_HPP_
+#define VIENNACL_LINALG_OPENCL_ITERATIVE_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/opencl/iterative_operations.hpp
+    @brief Implementations of the fused operations of the pipelined iterative solvers using OpenCL
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/handle.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/linalg/opencl/common.hpp"
+#include "viennacl/linalg/opencl/kernels/iterative.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/handle.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace opencl
+    {
+      namespace detail
+      {
+        /** @brief Configures a kernel such that each of the work groups writes exactly one partial result to each of the chunks of 'inner_prod_buffer' */
+        template <typename T>
+        void setup_pipelined_kernel(viennacl::ocl::kernel & k, vector_base<T> const & inner_prod_buffer)
+        {
+          std::size_t chunk_size = viennacl::traits::size(inner_prod_buffer) / 3;
+          k.local_work_size(0, 128);
+          k.global_work_size(0, chunk_size * k.local_work_size());
+        }
+      }
+
+      /** @brief Performs the fused vector update of the pipelined CG method: x += alpha * p, r -= alpha * Ap, p = r + beta * p.
+      *
+      * The partial results of <r, r> for the updated r are written by each work group to the first chunk of 'inner_prod_buffer'.
+      */
+      template <typename T>
+      void pipelined_cg_vector_update(vector_base<T> & result,
+                                      T alpha,
+                                      vector_base<T> & p,
+                                      vector_base<T> & r,
+                                      vector_base<T> const & Ap,
+                                      T beta,
+                                      vector_base<T> & inner_prod_buffer)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(result).context());
+        viennacl::linalg::opencl::kernels::iterative<T>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::iterative<T>::program_name(), "cg_vector_update");
+        detail::setup_pipelined_kernel(k, inner_prod_buffer);
+
+        viennacl::ocl::enqueue(k(result.handle().opencl_handle(),
+                                 alpha,
+                                 p.handle().opencl_handle(),
+                                 r.handle().opencl_handle(),
+                                 Ap.handle().opencl_handle(),
+                                 beta,
+                                 inner_prod_buffer.handle().opencl_handle(),
+                                 cl_uint(viennacl::traits::size(result)),
+                                 viennacl::ocl::local_mem(sizeof(typename viennacl::result_of::cl_type<T>::type) * k.local_work_size())
+                                ));
+      }
+
+      /** @brief Computes Ap = prod(A, p) for a compressed_matrix and writes the partial results of <Ap, Ap> and <p, Ap> to the second and third chunk of 'inner_prod_buffer' */
+      template <typename T, unsigned int ALIGNMENT>
+      void pipelined_cg_prod(compressed_matrix<T, ALIGNMENT> const & A,
+                             vector_base<T> const & p,
+                             vector_base<T> & Ap,
+                             vector_base<T> & inner_prod_buffer)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+        viennacl::linalg::opencl::kernels::iterative<T>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::iterative<T>::program_name(), "cg_csr_prod");
+        detail::setup_pipelined_kernel(k, inner_prod_buffer);
+
+        viennacl::ocl::enqueue(k(A.handle1().opencl_handle(), A.handle2().opencl_handle(), A.handle().opencl_handle(),
+                                 p.handle().opencl_handle(),
+                                 Ap.handle().opencl_handle(),
+                                 cl_uint(A.size1()),
+                                 inner_prod_buffer.handle().opencl_handle(),
+                                 cl_uint(viennacl::traits::size(inner_prod_buffer) / 3),
+                                 viennacl::ocl::local_mem(sizeof(typename viennacl::result_of::cl_type<T>::type) * k.local_work_size()),
+                                 viennacl::ocl::local_mem(sizeof(typename viennacl::result_of::cl_type<T>::type) * k.local_work_size())
+                                ));
+      }
+
+      /** @brief Writes the partial results of <Ap, Ap> and <p, Ap> to the second and third chunk of 'inner_prod_buffer' using a single pass over p and Ap */
+      template <typename T>
+      void pipelined_cg_inner_prods(vector_base<T> const & p,
+                                    vector_base<T> const & Ap,
+                                    vector_base<T> & inner_prod_buffer)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(p).context());
+        viennacl::linalg::opencl::kernels::iterative<T>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::iterative<T>::program_name(), "cg_inner_prods");
+        detail::setup_pipelined_kernel(k, inner_prod_buffer);
+
+        viennacl::ocl::enqueue(k(p.handle().opencl_handle(),
+                                 Ap.handle().opencl_handle(),
+                                 cl_uint(viennacl::traits::size(p)),
+                                 inner_prod_buffer.handle().opencl_handle(),
+                                 cl_uint(viennacl::traits::size(inner_prod_buffer) / 3),
+                                 viennacl::ocl::local_mem(sizeof(typename viennacl::result_of::cl_type<T>::type) * k.local_work_size()),
+                                 viennacl::ocl::local_mem(sizeof(typename viennacl::result_of::cl_type<T>::type) * k.local_work_size())
+                                ));
+      }
+
+      /** @brief Performs the fused vector update of the pipelined BiCGStab method: result += alpha * p + omega * s, residual = s - omega * As, p = residual + beta * (p - omega * Ap).
+      *
+      * The partial results of <residual, residual> and <residual, r0star> are written by each work group to the first and the second chunk of 'inner_prod_buffer'.
+      */
+      template <typename T>
+      void pipelined_bicgstab_vector_update(vector_base<T> & result, T alpha, vector_base<T> & p, T omega, vector_base<T> const & s,
+                                            vector_base<T> & residual, vector_base<T> const & As,
+                                            T beta, vector_base<T> const & Ap,
+                                            vector_base<T> const & r0star,
+                                            vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(result).context());
+        viennacl::linalg::opencl::kernels::iterative<T>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::iterative<T>::program_name(), "bicgstab_vector_update");
+        k.local_work_size(0, 128);
+        k.global_work_size(0, buffer_chunk_size * k.local_work_size());
+
+        viennacl::ocl::enqueue(k(result.handle().opencl_handle(), alpha, p.handle().opencl_handle(), omega, s.handle().opencl_handle(),
+                                 residual.handle().opencl_handle(), As.handle().opencl_handle(),
+                                 beta, Ap.handle().opencl_handle(),
+                                 r0star.handle().opencl_handle(),
+                                 cl_uint(viennacl::traits::size(result)),
+                                 inner_prod_buffer.handle().opencl_handle(),
+                                 cl_uint(buffer_chunk_size),
+                                 viennacl::ocl::local_mem(sizeof(typename viennacl::result_of::cl_type<T>::type) * k.local_work_size()),
+                                 viennacl::ocl::local_mem(sizeof(typename viennacl::result_of::cl_type<T>::type) * k.local_work_size())
+                                ));
+      }
+
+      namespace detail
+      {
+        /** @brief Enqueues one of the kernels computing the inner products <y, y>, <x, y>, <r0star, y>, <x, x> for the pipelined BiCGStab method. 'k' must be set up with the leading arguments already. */
+        template <typename T>
+        void enqueue_pipelined_bicgstab_inner_prods(viennacl::ocl::kernel & k, unsigned int leading_args, vector_base<T> const & r0star, std::size_t size,
+                                                    vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size, std::size_t buffer_chunk_offset)
+        {
+          k.local_work_size(0, 128);
+          k.global_work_size(0, buffer_chunk_size * k.local_work_size());
+
+          k.arg(leading_args,     r0star.handle().opencl_handle());
+          k.arg(leading_args + 1, cl_uint(size));
+          k.arg(leading_args + 2, inner_prod_buffer.handle().opencl_handle());
+          k.arg(leading_args + 3, cl_uint(buffer_chunk_size));
+          k.arg(leading_args + 4, cl_uint(buffer_chunk_offset));
+          for (unsigned int i = 0; i < 4; ++i)
+            k.arg(leading_args + 5 + i, viennacl::ocl::local_mem(sizeof(typename viennacl::result_of::cl_type<T>::type) * k.local_work_size()));
+          viennacl::ocl::enqueue(k);
+        }
+      }
+
+      /** @brief Computes y = prod(A, x) for a compressed_matrix and writes the partial results of <y, y>, <x, y>, <r0star, y>, and <x, x> to the chunks 'buffer_chunk_offset', ..., 'buffer_chunk_offset' + 3 of 'inner_prod_buffer' */
+      template <typename T, unsigned int ALIGNMENT>
+      void pipelined_bicgstab_prod(compressed_matrix<T, ALIGNMENT> const & A,
+                                   vector_base<T> const & x,
+                                   vector_base<T> & y,
+                                   vector_base<T> const & r0star,
+                                   vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size, std::size_t buffer_chunk_offset)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+        viennacl::linalg::opencl::kernels::iterative<T>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::iterative<T>::program_name(), "bicgstab_csr_prod");
+        k.arg(0, A.handle1().opencl_handle());
+        k.arg(1, A.handle2().opencl_handle());
+        k.arg(2, A.handle().opencl_handle());
+        k.arg(3, x.handle().opencl_handle());
+        k.arg(4, y.handle().opencl_handle());
+        detail::enqueue_pipelined_bicgstab_inner_prods(k, 5, r0star, A.size1(), inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
+      }
+
+      /** @brief Writes the partial results of <y, y>, <x, y>, <r0star, y>, and <x, x> to the chunks 'buffer_chunk_offset', ..., 'buffer_chunk_offset' + 3 of 'inner_prod_buffer' using a single pass over x, y, and r0star */
+      template <typename T>
+      void pipelined_bicgstab_inner_prods(vector_base<T> const & x,
+                                          vector_base<T> const & y,
+                                          vector_base<T> const & r0star,
+                                          vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size, std::size_t buffer_chunk_offset)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(x).context());
+        viennacl::linalg::opencl::kernels::iterative<T>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::iterative<T>::program_name(), "bicgstab_inner_prods");
+        k.arg(0, x.handle().opencl_handle());
+        k.arg(1, y.handle().opencl_handle());
+        detail::enqueue_pipelined_bicgstab_inner_prods(k, 2, r0star, viennacl::traits::size(x), inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
+      }
+
+      /** @brief Writes the partial results of the inner products <A_j, B_j> of the columns of A and B to the j-th chunk of 'inner_prod_buffer' */
+      template <typename T>
+      void block_cg_inner_prods(matrix_base<T, viennacl::row_major> const & A,
+                                matrix_base<T, viennacl::row_major> const & B,
+                                vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+        viennacl::linalg::opencl::kernels::iterative<T>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::iterative<T>::program_name(), "block_cg_inner_prods");
+        k.local_work_size(0, 128);
+        k.global_work_size(0, buffer_chunk_size * k.local_work_size());
+
+        viennacl::ocl::enqueue(k(A.handle().opencl_handle(),
+                                 B.handle().opencl_handle(),
+                                 cl_uint(A.size1()), cl_uint(A.size2()), cl_uint(A.internal_size2()),
+                                 inner_prod_buffer.handle().opencl_handle(),
+                                 cl_uint(buffer_chunk_size),
+                                 viennacl::ocl::local_mem(sizeof(typename viennacl::result_of::cl_type<T>::type) * k.local_work_size())
+                                ));
+      }
+
+      /** @brief Performs the update X_j += alpha_j * P_j, R_j -= alpha_j * AP_j for all columns j and writes the partial results of <R_j, R_j> to the j-th chunk of 'inner_prod_buffer' */
+      template <typename T>
+      void block_cg_vector_update(matrix_base<T, viennacl::row_major> & X,
+                                  vector_base<T> const & alphas,
+                                  matrix_base<T, viennacl::row_major> const & P,
+                                  matrix_base<T, viennacl::row_major> & R,
+                                  matrix_base<T, viennacl::row_major> const & AP,
+                                  vector_base<T> & inner_prod_buffer, std::size_t buffer_chunk_size)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(X).context());
+        viennacl::linalg::opencl::kernels::iterative<T>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::iterative<T>::program_name(), "block_cg_vector_update");
+        k.local_work_size(0, 128);
+        k.global_work_size(0, buffer_chunk_size * k.local_work_size());
+
+        viennacl::ocl::enqueue(k(X.handle().opencl_handle(),
+                                 alphas.handle().opencl_handle(),
+                                 P.handle().opencl_handle(),
+                                 R.handle().opencl_handle(),
+                                 AP.handle().opencl_handle(),
+                                 cl_uint(X.size1()), cl_uint(X.size2()), cl_uint(X.internal_size2()),
+                                 inner_prod_buffer.handle().opencl_handle(),
+                                 cl_uint(buffer_chunk_size),
+                                 viennacl::ocl::local_mem(sizeof(typename viennacl::result_of::cl_type<T>::type) * k.local_work_size())
+                                ));
+      }
+
+      /** @brief Performs the update P_j = R_j + beta_j * P_j for all columns j */
+      template <typename T>
+      void block_cg_direction_update(matrix_base<T, viennacl::row_major> & P,
+                                     matrix_base<T, viennacl::row_major> const & R,
+                                     vector_base<T> const & betas)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(P).context());
+        viennacl::linalg::opencl::kernels::iterative<T>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::iterative<T>::program_name(), "block_cg_direction_update");
+
+        viennacl::ocl::enqueue(k(P.handle().opencl_handle(),
+                                 R.handle().opencl_handle(),
+                                 betas.handle().opencl_handle(),
+                                 cl_uint(P.size1()), cl_uint(P.size2()), cl_uint(P.internal_size2())
+                                ));
+      }
+
+    } //namespace opencl
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
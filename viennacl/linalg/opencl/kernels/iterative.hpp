@@ -0,0 +1,373 @@
+#ifndef VIENNACL_LINALG_OPENCL_KERNELS_ITERATIVE_HPP
+#define VIENNACL_LINALG_OPENCL_KERNELS_ITERATIVE_HPP
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/ocl/utils.hpp"
+
+/** @file viennacl/linalg/opencl/kernels/iterative.hpp
+ *  @brief OpenCL kernel file for the fused operations of the pipelined iterative solvers */
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace opencl
+    {
+      namespace kernels
+      {
+
+        //////////////////////////// Part 1: Kernel generation routines ////////////////////////////////////
+
+        /** @brief Appends the reduction of the work group's values in 'shared_array' to 'source'. The result is written to inner_prod_buffer[offset + get_group_id(0)] */
+        template <typename StringType>
+        void generate_pipelined_group_reduction(StringType & source, std::string const & shared_array, std::string const & offset)
+        {
+          source.append("  for (unsigned int stride = get_local_size(0)/2; stride > 0; stride /= 2) \n");
+          source.append("  { \n");
+          source.append("    barrier(CLK_LOCAL_MEM_FENCE); \n");
+          source.append("    if (get_local_id(0) < stride) \n");
+          source.append("      "); source.append(shared_array); source.append("[get_local_id(0)] += "); source.append(shared_array); source.append("[get_local_id(0) + stride]; \n");
+          source.append("  } \n");
+          source.append("  if (get_local_id(0) == 0) \n");
+          source.append("    inner_prod_buffer["); source.append(offset); source.append(" + get_group_id(0)] = "); source.append(shared_array); source.append("[0]; \n");
+        }
+
+        template <typename StringType>
+        void generate_pipelined_cg_vector_update(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void cg_vector_update( \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * result, \n");
+          source.append("          "); source.append(numeric_string); source.append(" alpha, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * p, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * r, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * Ap, \n");
+          source.append("          "); source.append(numeric_string); source.append(" beta, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * inner_prod_buffer, \n");
+          source.append("          unsigned int size, \n");
+          source.append("          __local "); source.append(numeric_string); source.append(" * shared_array) \n");
+          source.append("{ \n");
+          source.append("  "); source.append(numeric_string); source.append(" inner_prod_contrib = 0; \n");
+          source.append("  for (unsigned int i = get_global_id(0); i < size; i += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    "); source.append(numeric_string); source.append(" value_p = p[i]; \n");
+          source.append("    "); source.append(numeric_string); source.append(" value_r = r[i]; \n");
+          source.append("    result[i] += alpha * value_p; \n");
+          source.append("    value_r   -= alpha * Ap[i]; \n");
+          source.append("    value_p    = value_r + beta * value_p; \n");
+          source.append("    p[i] = value_p; \n");
+          source.append("    r[i] = value_r; \n");
+          source.append("    inner_prod_contrib += value_r * value_r; \n");
+          source.append("  } \n");
+          source.append("  shared_array[get_local_id(0)] = inner_prod_contrib; \n");
+          generate_pipelined_group_reduction(source, "shared_array", "0");
+          source.append("} \n");
+        }
+
+        template <typename StringType>
+        void generate_pipelined_cg_csr_prod(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void cg_csr_prod( \n");
+          source.append("          __global const unsigned int * row_indices, \n");
+          source.append("          __global const unsigned int * column_indices, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * elements, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * p, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * Ap, \n");
+          source.append("          unsigned int size, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * inner_prod_buffer, \n");
+          source.append("          unsigned int buffer_size, \n");
+          source.append("          __local "); source.append(numeric_string); source.append(" * shared_array_ApAp, \n");
+          source.append("          __local "); source.append(numeric_string); source.append(" * shared_array_pAp) \n");
+          source.append("{ \n");
+          source.append("  "); source.append(numeric_string); source.append(" inner_prod_ApAp = 0; \n");
+          source.append("  "); source.append(numeric_string); source.append(" inner_prod_pAp = 0; \n");
+          source.append("  for (unsigned int row = get_global_id(0); row < size; row += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    "); source.append(numeric_string); source.append(" dot_prod = 0; \n");
+          source.append("    unsigned int row_end = row_indices[row+1]; \n");
+          source.append("    for (unsigned int i = row_indices[row]; i < row_end; ++i) \n");
+          source.append("      dot_prod += elements[i] * p[column_indices[i]]; \n");
+          source.append("    Ap[row] = dot_prod; \n");
+          source.append("    inner_prod_ApAp += dot_prod * dot_prod; \n");
+          source.append("    inner_prod_pAp  += p[row] * dot_prod; \n");
+          source.append("  } \n");
+          source.append("  shared_array_ApAp[get_local_id(0)] = inner_prod_ApAp; \n");
+          source.append("  shared_array_pAp[get_local_id(0)]  = inner_prod_pAp; \n");
+          generate_pipelined_group_reduction(source, "shared_array_ApAp", "buffer_size");
+          generate_pipelined_group_reduction(source, "shared_array_pAp",  "2 * buffer_size");
+          source.append("} \n");
+        }
+
+        template <typename StringType>
+        void generate_pipelined_cg_inner_prods(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void cg_inner_prods( \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * p, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * Ap, \n");
+          source.append("          unsigned int size, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * inner_prod_buffer, \n");
+          source.append("          unsigned int buffer_size, \n");
+          source.append("          __local "); source.append(numeric_string); source.append(" * shared_array_ApAp, \n");
+          source.append("          __local "); source.append(numeric_string); source.append(" * shared_array_pAp) \n");
+          source.append("{ \n");
+          source.append("  "); source.append(numeric_string); source.append(" inner_prod_ApAp = 0; \n");
+          source.append("  "); source.append(numeric_string); source.append(" inner_prod_pAp = 0; \n");
+          source.append("  for (unsigned int i = get_global_id(0); i < size; i += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    "); source.append(numeric_string); source.append(" value_Ap = Ap[i]; \n");
+          source.append("    inner_prod_ApAp += value_Ap * value_Ap; \n");
+          source.append("    inner_prod_pAp  += p[i] * value_Ap; \n");
+          source.append("  } \n");
+          source.append("  shared_array_ApAp[get_local_id(0)] = inner_prod_ApAp; \n");
+          source.append("  shared_array_pAp[get_local_id(0)]  = inner_prod_pAp; \n");
+          generate_pipelined_group_reduction(source, "shared_array_ApAp", "buffer_size");
+          generate_pipelined_group_reduction(source, "shared_array_pAp",  "2 * buffer_size");
+          source.append("} \n");
+        }
+
+        template <typename StringType>
+        void generate_pipelined_bicgstab_vector_update(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void bicgstab_vector_update( \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * result, \n");
+          source.append("          "); source.append(numeric_string); source.append(" alpha, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * p, \n");
+          source.append("          "); source.append(numeric_string); source.append(" omega, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * s, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * residual, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * As, \n");
+          source.append("          "); source.append(numeric_string); source.append(" beta, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * Ap, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * r0star, \n");
+          source.append("          unsigned int size, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * inner_prod_buffer, \n");
+          source.append("          unsigned int buffer_size, \n");
+          source.append("          __local "); source.append(numeric_string); source.append(" * shared_array_rr, \n");
+          source.append("          __local "); source.append(numeric_string); source.append(" * shared_array_rr0star) \n");
+          source.append("{ \n");
+          source.append("  "); source.append(numeric_string); source.append(" inner_prod_rr = 0; \n");
+          source.append("  "); source.append(numeric_string); source.append(" inner_prod_rr0star = 0; \n");
+          source.append("  for (unsigned int i = get_global_id(0); i < size; i += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    "); source.append(numeric_string); source.append(" value_p = p[i]; \n");
+          source.append("    "); source.append(numeric_string); source.append(" value_s = s[i]; \n");
+          source.append("    "); source.append(numeric_string); source.append(" value_r = value_s - omega * As[i]; \n");
+          source.append("    result[i]  += alpha * value_p + omega * value_s; \n");
+          source.append("    residual[i] = value_r; \n");
+          source.append("    p[i]        = value_r + beta * (value_p - omega * Ap[i]); \n");
+          source.append("    inner_prod_rr      += value_r * value_r; \n");
+          source.append("    inner_prod_rr0star += value_r * r0star[i]; \n");
+          source.append("  } \n");
+          source.append("  shared_array_rr[get_local_id(0)]      = inner_prod_rr; \n");
+          source.append("  shared_array_rr0star[get_local_id(0)] = inner_prod_rr0star; \n");
+          generate_pipelined_group_reduction(source, "shared_array_rr",      "0");
+          generate_pipelined_group_reduction(source, "shared_array_rr0star", "buffer_size");
+          source.append("} \n");
+        }
+
+        /** @brief Appends the accumulation of <y, y>, <x, y>, <r0star, y> and <x, x> for the row (or entry) 'row', the end of the loop, and the work group reductions */
+        template <typename StringType>
+        void generate_pipelined_bicgstab_inner_prods_body(StringType & source)
+        {
+          source.append("    inner_prod_yy      += value_y * value_y; \n");
+          source.append("    inner_prod_xy      += value_x * value_y; \n");
+          source.append("    inner_prod_r0stary += r0star[row] * value_y; \n");
+          source.append("    inner_prod_xx      += value_x * value_x; \n");
+          source.append("  } \n");
+          source.append("  shared_array_yy[get_local_id(0)]      = inner_prod_yy; \n");
+          source.append("  shared_array_xy[get_local_id(0)]      = inner_prod_xy; \n");
+          source.append("  shared_array_r0stary[get_local_id(0)] = inner_prod_r0stary; \n");
+          source.append("  shared_array_xx[get_local_id(0)]      = inner_prod_xx; \n");
+          generate_pipelined_group_reduction(source, "shared_array_yy",      "buffer_offset * buffer_size");
+          generate_pipelined_group_reduction(source, "shared_array_xy",      "(buffer_offset + 1) * buffer_size");
+          generate_pipelined_group_reduction(source, "shared_array_r0stary", "(buffer_offset + 2) * buffer_size");
+          generate_pipelined_group_reduction(source, "shared_array_xx",      "(buffer_offset + 3) * buffer_size");
+          source.append("} \n");
+        }
+
+        /** @brief Appends the trailing arguments and the head of the loop over all rows (or entries) shared by the kernels computing y = A * x along with the inner products */
+        template <typename StringType>
+        void generate_pipelined_bicgstab_inner_prods_arguments(StringType & source, std::string const & numeric_string)
+        {
+          source.append("          __global const "); source.append(numeric_string); source.append(" * r0star, \n");
+          source.append("          unsigned int size, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * inner_prod_buffer, \n");
+          source.append("          unsigned int buffer_size, \n");
+          source.append("          unsigned int buffer_offset, \n");
+          source.append("          __local "); source.append(numeric_string); source.append(" * shared_array_yy, \n");
+          source.append("          __local "); source.append(numeric_string); source.append(" * shared_array_xy, \n");
+          source.append("          __local "); source.append(numeric_string); source.append(" * shared_array_r0stary, \n");
+          source.append("          __local "); source.append(numeric_string); source.append(" * shared_array_xx) \n");
+          source.append("{ \n");
+          source.append("  "); source.append(numeric_string); source.append(" inner_prod_yy = 0; \n");
+          source.append("  "); source.append(numeric_string); source.append(" inner_prod_xy = 0; \n");
+          source.append("  "); source.append(numeric_string); source.append(" inner_prod_r0stary = 0; \n");
+          source.append("  "); source.append(numeric_string); source.append(" inner_prod_xx = 0; \n");
+          source.append("  for (unsigned int row = get_global_id(0); row < size; row += get_global_size(0)) \n");
+          source.append("  { \n");
+        }
+
+        template <typename StringType>
+        void generate_pipelined_bicgstab_csr_prod(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void bicgstab_csr_prod( \n");
+          source.append("          __global const unsigned int * row_indices, \n");
+          source.append("          __global const unsigned int * column_indices, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * elements, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * x, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * y, \n");
+          generate_pipelined_bicgstab_inner_prods_arguments(source, numeric_string);
+          source.append("    "); source.append(numeric_string); source.append(" value_y = 0; \n");
+          source.append("    unsigned int row_end = row_indices[row+1]; \n");
+          source.append("    for (unsigned int i = row_indices[row]; i < row_end; ++i) \n");
+          source.append("      value_y += elements[i] * x[column_indices[i]]; \n");
+          source.append("    y[row] = value_y; \n");
+          source.append("    "); source.append(numeric_string); source.append(" value_x = x[row]; \n");
+          generate_pipelined_bicgstab_inner_prods_body(source);
+        }
+
+        template <typename StringType>
+        void generate_pipelined_bicgstab_inner_prods(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void bicgstab_inner_prods( \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * x, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * y, \n");
+          generate_pipelined_bicgstab_inner_prods_arguments(source, numeric_string);
+          source.append("    "); source.append(numeric_string); source.append(" value_y = y[row]; \n");
+          source.append("    "); source.append(numeric_string); source.append(" value_x = x[row]; \n");
+          generate_pipelined_bicgstab_inner_prods_body(source);
+        }
+
+        template <typename StringType>
+        void generate_block_cg_inner_prods(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void block_cg_inner_prods( \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * A, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * B, \n");
+          source.append("          unsigned int size1, \n");
+          source.append("          unsigned int size2, \n");
+          source.append("          unsigned int internal_size2, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * inner_prod_buffer, \n");
+          source.append("          unsigned int buffer_size, \n");
+          source.append("          __local "); source.append(numeric_string); source.append(" * shared_array) \n");
+          source.append("{ \n");
+          source.append("  for (unsigned int col = 0; col < size2; ++col) \n");
+          source.append("  { \n");
+          source.append("    "); source.append(numeric_string); source.append(" inner_prod = 0; \n");
+          source.append("    for (unsigned int row = get_global_id(0); row < size1; row += get_global_size(0)) \n");
+          source.append("      inner_prod += A[row * internal_size2 + col] * B[row * internal_size2 + col]; \n");
+          source.append("    shared_array[get_local_id(0)] = inner_prod; \n");
+          generate_pipelined_group_reduction(source, "shared_array", "col * buffer_size");
+          source.append("    barrier(CLK_LOCAL_MEM_FENCE); \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        template <typename StringType>
+        void generate_block_cg_vector_update(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void block_cg_vector_update( \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * X, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * alphas, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * P, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * R, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * AP, \n");
+          source.append("          unsigned int size1, \n");
+          source.append("          unsigned int size2, \n");
+          source.append("          unsigned int internal_size2, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * inner_prod_buffer, \n");
+          source.append("          unsigned int buffer_size, \n");
+          source.append("          __local "); source.append(numeric_string); source.append(" * shared_array) \n");
+          source.append("{ \n");
+          source.append("  for (unsigned int col = 0; col < size2; ++col) \n");
+          source.append("  { \n");
+          source.append("    "); source.append(numeric_string); source.append(" alpha = alphas[col]; \n");
+          source.append("    "); source.append(numeric_string); source.append(" inner_prod = 0; \n");
+          source.append("    for (unsigned int row = get_global_id(0); row < size1; row += get_global_size(0)) \n");
+          source.append("    { \n");
+          source.append("      unsigned int index = row * internal_size2 + col; \n");
+          source.append("      "); source.append(numeric_string); source.append(" value_R = R[index] - alpha * AP[index]; \n");
+          source.append("      X[index] += alpha * P[index]; \n");
+          source.append("      R[index]  = value_R; \n");
+          source.append("      inner_prod += value_R * value_R; \n");
+          source.append("    } \n");
+          source.append("    shared_array[get_local_id(0)] = inner_prod; \n");
+          generate_pipelined_group_reduction(source, "shared_array", "col * buffer_size");
+          source.append("    barrier(CLK_LOCAL_MEM_FENCE); \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        template <typename StringType>
+        void generate_block_cg_direction_update(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void block_cg_direction_update( \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * P, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * R, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * betas, \n");
+          source.append("          unsigned int size1, \n");
+          source.append("          unsigned int size2, \n");
+          source.append("          unsigned int internal_size2) \n");
+          source.append("{ \n");
+          source.append("  for (unsigned int i = get_global_id(0); i < size1 * size2; i += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    unsigned int col   = i % size2; \n");
+          source.append("    unsigned int index = (i / size2) * internal_size2 + col; \n");
+          source.append("    P[index] = R[index] + betas[col] * P[index]; \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        //////////////////////////// Part 2: Main kernel class ////////////////////////////////////
+
+        // main kernel class
+        template <class NumericT>
+        struct iterative
+        {
+          static std::string program_name()
+          {
+            return viennacl::ocl::type_to_string<NumericT>::apply() + "_iterative";
+          }
+
+          static void init(viennacl::ocl::context & ctx)
+          {
+            viennacl::ocl::DOUBLE_PRECISION_CHECKER<NumericT>::apply(ctx);
+            std::string numeric_string = viennacl::ocl::type_to_string<NumericT>::apply();
+
+            static std::map<cl_context, bool> init_done;
+            if (!init_done[ctx.handle().get()])
+            {
+              std::string source;
+              source.reserve(8192);
+
+              viennacl::ocl::append_double_precision_pragma<NumericT>(ctx, source);
+
+              // only generate for floating points (forces error for integers)
+              if (numeric_string == "float" || numeric_string == "double")
+              {
+                generate_pipelined_cg_vector_update(source, numeric_string);
+                generate_pipelined_cg_csr_prod(source, numeric_string);
+                generate_pipelined_cg_inner_prods(source, numeric_string);
+                generate_pipelined_bicgstab_vector_update(source, numeric_string);
+                generate_pipelined_bicgstab_csr_prod(source, numeric_string);
+                generate_pipelined_bicgstab_inner_prods(source, numeric_string);
+                generate_block_cg_inner_prods(source, numeric_string);
+                generate_block_cg_vector_update(source, numeric_string);
+                generate_block_cg_direction_update(source, numeric_string);
+              }
+
+              std::string prog_name = program_name();
+              #ifdef VIENNACL_BUILD_INFO
+              std::cout << "Creating program " << prog_name << std::endl;
+              #endif
+              ctx.add_program(source, prog_name);
+              init_done[ctx.handle().get()] = true;
+            } //if
+          } //init
+        };
+
+      }  // namespace kernels
+    }  // namespace opencl
+  }  // namespace linalg
+}  // namespace viennacl
+#endif
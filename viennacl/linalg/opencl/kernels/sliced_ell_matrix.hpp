@@ -0,0 +1,165 @@
+#ifndef VIENNACL_LINALG_OPENCL_KERNELS_SLICED_ELL_MATRIX_HPP
+#define VIENNACL_LINALG_OPENCL_KERNELS_SLICED_ELL_MATRIX_HPP
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/ocl/utils.hpp"
+
+/** @file viennacl/linalg/opencl/kernels/sliced_ell_matrix.hpp
+ *  @brief OpenCL kernel file for sliced_ell_matrix operations */
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace opencl
+    {
+      namespace kernels
+      {
+
+        //////////////////////////// Part 1: Kernel generation routines ////////////////////////////////////
+
+        template <typename StringType>
+        void generate_sliced_ell_vec_mul(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void vec_mul( \n");
+          source.append("  __global const unsigned int * chunk_start, \n");
+          source.append("  __global const unsigned int * column_indices, \n");
+          source.append("  __global const unsigned int * row_indices, \n");
+          source.append("  __global const "); source.append(numeric_string); source.append(" * elements, \n");
+          source.append("  __global const "); source.append(numeric_string); source.append(" * x, \n");
+          source.append("  uint4 layout_x, \n");
+          source.append("  __global "); source.append(numeric_string); source.append(" * result, \n");
+          source.append("  uint4 layout_result, \n");
+          source.append("  unsigned int chunk_size) \n");
+          source.append("{ \n");
+          source.append("  for (uint slot = get_global_id(0); slot < layout_result.z; slot += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    uint chunk = slot / chunk_size; \n");
+          source.append("    uint end   = chunk_start[chunk + 1]; \n");
+          source.append("    "); source.append(numeric_string); source.append(" sum = 0; \n");
+
+          source.append("    for (uint offset = chunk_start[chunk] + slot % chunk_size; offset < end; offset += chunk_size) \n");
+          source.append("    { \n");
+          source.append("      "); source.append(numeric_string); source.append(" val = elements[offset]; \n");
+          source.append("      if (val != ("); source.append(numeric_string); source.append(")0) \n");
+          source.append("        sum += val * x[column_indices[offset] * layout_x.y + layout_x.x]; \n");
+          source.append("    } \n");
+
+          source.append("    result[row_indices[slot] * layout_result.y + layout_result.x] = sum; \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        template <typename StringType>
+        void generate_sliced_ell_mat_mul(StringType & source, std::string const & numeric_string, bool transposed_d_mat)
+        {
+          if (transposed_d_mat)
+            source.append("__kernel void d_tr_mat_mul( \n");
+          else
+            source.append("__kernel void d_mat_mul( \n");
+          source.append("  __global const unsigned int * chunk_start, \n");
+          source.append("  __global const unsigned int * column_indices, \n");
+          source.append("  __global const unsigned int * row_indices, \n");
+          source.append("  __global const "); source.append(numeric_string); source.append(" * elements, \n");
+          source.append("  unsigned int sp_mat_row_num, \n");
+          source.append("  unsigned int chunk_size, \n");
+          source.append("  __global const "); source.append(numeric_string); source.append(" * d_mat, \n");
+          source.append("  unsigned int d_mat_row_start, \n");
+          source.append("  unsigned int d_mat_col_start, \n");
+          source.append("  unsigned int d_mat_row_inc, \n");
+          source.append("  unsigned int d_mat_col_inc, \n");
+          source.append("  unsigned int d_mat_internal_rows, \n");
+          source.append("  unsigned int d_mat_internal_cols, \n");
+          source.append("  unsigned int d_mat_row_major, \n");
+          source.append("  __global "); source.append(numeric_string); source.append(" * result, \n");
+          source.append("  unsigned int result_row_start, \n");
+          source.append("  unsigned int result_col_start, \n");
+          source.append("  unsigned int result_row_inc, \n");
+          source.append("  unsigned int result_col_inc, \n");
+          source.append("  unsigned int result_col_size, \n");
+          source.append("  unsigned int result_internal_rows, \n");
+          source.append("  unsigned int result_internal_cols, \n");
+          source.append("  unsigned int result_row_major) \n");
+          source.append("{ \n");
+          source.append("  for (uint rc = get_global_id(0); rc < sp_mat_row_num * result_col_size; rc += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    uint slot  = rc % sp_mat_row_num; \n");
+          source.append("    uint col   = rc / sp_mat_row_num; \n");
+          source.append("    uint chunk = slot / chunk_size; \n");
+          source.append("    uint end   = chunk_start[chunk + 1]; \n");
+          source.append("    "); source.append(numeric_string); source.append(" r = 0; \n");
+
+          source.append("    for (uint offset = chunk_start[chunk] + slot % chunk_size; offset < end; offset += chunk_size) \n");
+          source.append("    { \n");
+          source.append("      "); source.append(numeric_string); source.append(" val = elements[offset]; \n");
+          source.append("      if (val != ("); source.append(numeric_string); source.append(")0) \n");
+          source.append("      { \n");
+          if (transposed_d_mat)
+          {
+            source.append("        uint i = d_mat_row_start + col * d_mat_row_inc; \n");
+            source.append("        uint j = d_mat_col_start + column_indices[offset] * d_mat_col_inc; \n");
+          }
+          else
+          {
+            source.append("        uint i = d_mat_row_start + column_indices[offset] * d_mat_row_inc; \n");
+            source.append("        uint j = d_mat_col_start + col * d_mat_col_inc; \n");
+          }
+          source.append("        r += val * (d_mat_row_major ? d_mat[i * d_mat_internal_cols + j] : d_mat[i + j * d_mat_internal_rows]); \n");
+          source.append("      } \n");
+          source.append("    } \n");
+
+          source.append("    uint i = result_row_start + row_indices[slot] * result_row_inc; \n");
+          source.append("    uint j = result_col_start + col * result_col_inc; \n");
+          source.append("    if (result_row_major) \n");
+          source.append("      result[i * result_internal_cols + j] = r; \n");
+          source.append("    else \n");
+          source.append("      result[i + j * result_internal_rows] = r; \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        //////////////////////////// Part 2: Main kernel class ////////////////////////////////////
+
+        // main kernel class
+        template <typename NumericT>
+        struct sliced_ell_matrix
+        {
+          static std::string program_name()
+          {
+            return viennacl::ocl::type_to_string<NumericT>::apply() + "_sliced_ell_matrix";
+          }
+
+          static void init(viennacl::ocl::context & ctx)
+          {
+            viennacl::ocl::DOUBLE_PRECISION_CHECKER<NumericT>::apply(ctx);
+            std::string numeric_string = viennacl::ocl::type_to_string<NumericT>::apply();
+
+            static std::map<cl_context, bool> init_done;
+            if (!init_done[ctx.handle().get()])
+            {
+              std::string source;
+              source.reserve(4096);
+
+              viennacl::ocl::append_double_precision_pragma<NumericT>(ctx, source);
+
+              // fully parametrized kernels:
+              generate_sliced_ell_vec_mul(source, numeric_string);
+              generate_sliced_ell_mat_mul(source, numeric_string, false);
+              generate_sliced_ell_mat_mul(source, numeric_string, true);
+
+              std::string prog_name = program_name();
+              #ifdef VIENNACL_BUILD_INFO
+              std::cout << "Creating program " << prog_name << std::endl;
+              #endif
+              ctx.add_program(source, prog_name);
+              init_done[ctx.handle().get()] = true;
+            } //if
+          } //init
+        };
+
+      }  // namespace kernels
+    }  // namespace opencl
+  }  // namespace linalg
+}  // namespace viennacl
+#endif
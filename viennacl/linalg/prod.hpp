@@ -315,6 +315,20 @@ namespace viennacl
                                op_prod >(mat, vec);
     }
 
+    template<typename StructuredMatrixType, typename SCALARTYPE, typename F1>
+    typename viennacl::enable_if< viennacl::is_any_dense_structured_matrix<StructuredMatrixType>::value,
+                                  viennacl::matrix_expression<const StructuredMatrixType,
+                                                              const matrix_base < SCALARTYPE, F1 >,
+                                                              op_prod >
+                                 >::type
+    prod(const StructuredMatrixType & mat,
+         const viennacl::matrix_base<SCALARTYPE, F1> & d_mat)
+    {
+      return viennacl::matrix_expression<const StructuredMatrixType,
+                                         const viennacl::matrix_base < SCALARTYPE, F1 >,
+                                         op_prod >(mat, d_mat);
+    }
+
   } // end namespace linalg
 } // end namespace viennacl
 #endif
@@ -20,7 +20,9 @@
 
 #include <cmath>
 
+#ifdef VIENNACL_WITH_OPENCL
 #include "viennacl/linalg/opencl/kernels/svd.hpp"
+#endif
 #include "viennacl/meta/result_of.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
@@ -100,6 +102,7 @@ namespace viennacl
         normalize(v, v.size());
       }
 
+#ifdef VIENNACL_WITH_OPENCL
       template <typename MatrixType>
       void transpose(MatrixType & A)
       {
@@ -115,31 +118,6 @@ namespace viennacl
                               );
       }
 
-
-
-      template <typename T>
-      void cdiv(T xr, T xi, T yr, T yi, T& cdivr, T& cdivi)
-      {
-          // Complex scalar division.
-          T r;
-          T d;
-          if (std::fabs(yr) > std::fabs(yi))
-          {
-              r = yi / yr;
-              d = yr + r * yi;
-              cdivr = (xr + r * xi) / d;
-              cdivi = (xi - r * xr) / d;
-          }
-          else
-          {
-              r = yr / yi;
-              d = yi + r * yr;
-              cdivr = (r * xr + xi) / d;
-              cdivi = (r * xi - xr) / d;
-          }
-      }
-
-
       template <typename SCALARTYPE, unsigned int ALIGNMENT>
       void copy_vec(viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT>& A,
                     viennacl::vector<SCALARTYPE, ALIGNMENT>& V,
@@ -189,6 +167,7 @@ namespace viennacl
 
         //std::cout << "2: "  << D << "\n";
       }
+#endif
 
       template <typename SCALARTYPE, unsigned int ALIGNMENT>
       void eye(viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT>& A)
@@ -203,6 +182,7 @@ namespace viennacl
         viennacl::fast_copy(&foo[0], &foo[0] + foo.size(), A);
       }
 
+#ifdef VIENNACL_WITH_OPENCL
       template <typename SCALARTYPE, unsigned int ALIGNMENT, typename VectorType>
       void bidiag_pack(viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT>& A,
                        VectorType & dh,
@@ -227,6 +207,7 @@ namespace viennacl
         fast_copy(D, dh);
         fast_copy(S, sh);
       }
+#endif
 
     }
   }
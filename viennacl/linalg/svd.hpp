@@ -33,14 +33,19 @@
 #include <cmath>
 
 #include "viennacl/matrix.hpp"
-#include "viennacl/linalg/opencl/kernels/svd.hpp"
 #include "viennacl/linalg/qr-method-common.hpp"
+#include "viennacl/linalg/host_based/svd.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/kernels/svd.hpp"
+#endif
 
 namespace viennacl
 {
   namespace linalg
   {
 
+#ifdef VIENNACL_WITH_OPENCL
     namespace detail
     {
 
@@ -477,53 +482,100 @@ namespace viennacl
         }
       }
 
-    } // namespace detail
+      /** @brief OpenCL implementation of the singular value decomposition (row-major matrices only) */
+      template <typename SCALARTYPE, unsigned int ALIGNMENT>
+      void svd_opencl(viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & A,
+                      viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QL,
+                      viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QR)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+        viennacl::linalg::opencl::kernels::svd<SCALARTYPE>::init(ctx);
 
+        std::size_t row_num = A.size1();
+        std::size_t col_num = A.size2();
 
-    /** @brief Computes the singular value decomposition of a matrix A. Experimental in 1.3.x
-     *
-     * @param A     The input matrix. Will be overwritten with a diagonal matrix containing the singular values on return
-     * @param QL    The left orthogonal matrix
-     * @param QR    The right orthogonal matrix
-     */
-    template <typename SCALARTYPE, unsigned int ALIGNMENT>
-    void svd(viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & A,
-              viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QL,
-              viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QR)
-    {
-      viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
-      viennacl::linalg::opencl::kernels::svd<SCALARTYPE>::init(ctx);
+        std::size_t to = std::min(row_num, col_num);
 
-      std::size_t row_num = A.size1();
-      std::size_t col_num = A.size2();
 
-      std::size_t to = std::min(row_num, col_num);
+        //viennacl::vector<SCALARTYPE, ALIGNMENT> d(to);
+        //viennacl::vector<SCALARTYPE, ALIGNMENT> s(to + 1);
 
+        // first stage
+        detail::bidiag(A, QL, QR);
 
-      //viennacl::vector<SCALARTYPE, ALIGNMENT> d(to);
-      //viennacl::vector<SCALARTYPE, ALIGNMENT> s(to + 1);
+        // second stage
+        //std::vector<SCALARTYPE> dh(to, 0);
+        //std::vector<SCALARTYPE> sh(to + 1, 0);
+        boost::numeric::ublas::vector<SCALARTYPE> dh(to, 0);
+        boost::numeric::ublas::vector<SCALARTYPE> sh(to + 1, 0);
 
-      // first stage
-      detail::bidiag(A, QL, QR);
+        detail::bidiag_pack(A, dh, sh);
 
-      // second stage
-      //std::vector<SCALARTYPE> dh(to, 0);
-      //std::vector<SCALARTYPE> sh(to + 1, 0);
-      boost::numeric::ublas::vector<SCALARTYPE> dh(to, 0);
-      boost::numeric::ublas::vector<SCALARTYPE> sh(to + 1, 0);
+        detail::svd_qr_shift( QL, QR, dh, sh);
 
-      detail::bidiag_pack(A, dh, sh);
+        // Write resulting diagonal matrix with singular values to A:
+        boost::numeric::ublas::matrix<SCALARTYPE> h_Sigma(row_num, col_num);
+        h_Sigma.clear();
 
-      detail::svd_qr_shift( QL, QR, dh, sh);
+        for (std::size_t i = 0; i < to; i++)
+          h_Sigma(i, i) = dh[i];
+
+        copy(h_Sigma, A);
+      }
+
+    } // namespace detail
+#endif
 
-      // Write resulting diagonal matrix with singular values to A:
-      boost::numeric::ublas::matrix<SCALARTYPE> h_Sigma(row_num, col_num);
-      h_Sigma.clear();
 
-      for (std::size_t i = 0; i < to; i++)
-        h_Sigma(i, i) = dh[i];
+    /** @brief Computes the singular value decomposition A = QL * Sigma * QR^T of a matrix A. Experimental in 1.3.x
+     *
+     * @param A     The input matrix. Will be overwritten with a diagonal matrix containing the singular values on return
+     * @param QL    The left orthogonal matrix
+     * @param QR    The right orthogonal matrix
+     */
+    template <typename SCALARTYPE, unsigned int ALIGNMENT>
+    void svd(viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & A,
+             viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QL,
+             viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QR)
+    {
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::svd(A, QL, QR);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          detail::svd_opencl(A, QL, QR);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
 
-      copy(h_Sigma, A);
+    /** @brief Computes the singular value decomposition A = QL * Sigma * QR^T of a matrix A. Only available for matrices in host memory.
+     *
+     * @param A     The input matrix. Will be overwritten with a diagonal matrix containing the singular values on return
+     * @param QL    The left orthogonal matrix
+     * @param QR    The right orthogonal matrix
+     */
+    template <typename NumericT, typename F1, typename F2, typename F3>
+    void svd(matrix_base<NumericT, F1> & A,
+             matrix_base<NumericT, F2> & QL,
+             matrix_base<NumericT, F3> & QR)
+    {
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::svd(A, QL, QR);
+          break;
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
     }
   }
 }
@@ -23,13 +23,11 @@
 */
 
 #include "viennacl/forwards.h"
-#include "viennacl/ocl/device.hpp"
-#include "viennacl/ocl/handle.hpp"
-#include "viennacl/ocl/kernel.hpp"
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/fft.hpp"
+#include "viennacl/linalg/host_based/structured_matrix_operations.hpp"
 
 namespace viennacl
 {
@@ -55,19 +53,62 @@ namespace viennacl
       assert(mat.size1() == result.size());
       assert(mat.size2() == vec.size());
 
-      viennacl::vector<SCALARTYPE> tmp(vec.size() * 4); tmp.clear();
-      viennacl::vector<SCALARTYPE> tmp2(vec.size() * 4);
-
-      viennacl::vector<SCALARTYPE> tep(mat.elements().size() * 2);
-      viennacl::detail::fft::real_to_complex(mat.elements(), tep, mat.elements().size());
-
-
+      switch (viennacl::traits::handle(mat).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(mat, vec, result);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+        {
+          viennacl::vector<SCALARTYPE> tmp(vec.size() * 4); tmp.clear();
+          viennacl::vector<SCALARTYPE> tmp2(vec.size() * 4);
+
+          viennacl::vector<SCALARTYPE> tep(mat.elements().size() * 2);
+          viennacl::detail::fft::real_to_complex(mat.elements(), tep, mat.elements().size());
+
+          copy(vec, tmp);
+          viennacl::detail::fft::real_to_complex(tmp, tmp2, vec.size() * 2);
+          viennacl::linalg::convolve(tep, tmp2, tmp);
+          viennacl::detail::fft::complex_to_real(tmp, tmp2, vec.size() * 2);
+          copy(tmp2.begin(), tmp2.begin() + vec.size(), result.begin());
+          break;
+        }
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
 
-      copy(vec, tmp);
-      viennacl::detail::fft::real_to_complex(tmp, tmp2, vec.size() * 2);
-      viennacl::linalg::convolve(tep, tmp2, tmp);
-      viennacl::detail::fft::complex_to_real(tmp, tmp2, vec.size() * 2);
-      copy(tmp2.begin(), tmp2.begin() + vec.size(), result.begin());
+    /** @brief Carries out the product of a toeplitz_matrix with each column of a dense matrix
+    *
+    * Implementation of the convenience expression result = prod(mat, B);
+    *
+    * @param mat    The matrix
+    * @param B      The dense matrix
+    * @param result The result matrix
+    */
+    template<class SCALARTYPE, unsigned int ALIGNMENT, typename F>
+    void prod_impl(const viennacl::toeplitz_matrix<SCALARTYPE, ALIGNMENT> & mat,
+                   const viennacl::matrix_base<SCALARTYPE, F> & B,
+                         viennacl::matrix_base<SCALARTYPE, F> & result)
+    {
+      assert(mat.size1() == result.size1());
+      assert(mat.size2() == B.size1());
+      assert(B.size2() == result.size2());
+
+      switch (viennacl::traits::handle(mat).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(mat, B, result);
+          break;
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
     }
 
   } //namespace linalg
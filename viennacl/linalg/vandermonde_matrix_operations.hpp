@@ -27,7 +27,11 @@
 #include "viennacl/vector.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/fft.hpp"
-#include "viennacl/linalg/opencl/vandermonde_matrix_operations.hpp"
+#include "viennacl/linalg/host_based/structured_matrix_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/vandermonde_matrix_operations.hpp"
+#endif
 
 namespace viennacl
 {
@@ -54,11 +58,47 @@ namespace viennacl
 
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(mat, vec, result);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::prod_impl(mat, vec, result);
           break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Carries out the product of a vandermonde_matrix with each column of a dense matrix
+    *
+    * Implementation of the convenience expression result = prod(mat, B);
+    *
+    * @param mat    The matrix
+    * @param B      The dense matrix
+    * @param result The result matrix
+    */
+    template<class SCALARTYPE, unsigned int ALIGNMENT, typename F>
+    void prod_impl(const viennacl::vandermonde_matrix<SCALARTYPE, ALIGNMENT> & mat,
+                   const viennacl::matrix_base<SCALARTYPE, F> & B,
+                         viennacl::matrix_base<SCALARTYPE, F> & result)
+    {
+      assert(mat.size1() == result.size1());
+      assert(mat.size2() == B.size1());
+      assert(B.size2() == result.size2());
+
+      switch (viennacl::traits::handle(mat).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(mat, B, result);
+          break;
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
         default:
-          throw "not implemented";
+          throw memory_exception("not implemented");
       }
     }
 
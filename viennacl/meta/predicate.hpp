@@ -326,6 +326,21 @@ namespace viennacl
       enum { value = true };
     };
 
+    //
+    // is_sliced_ell_matrix
+    //
+    template <typename T>
+    struct is_sliced_ell_matrix
+    {
+      enum { value = false };
+    };
+
+    template <typename ScalarType>
+    struct is_sliced_ell_matrix<viennacl::sliced_ell_matrix<ScalarType> >
+    {
+      enum { value = true };
+    };
+
 
     //
     // is_any_sparse_matrix
@@ -366,6 +381,12 @@ namespace viennacl
       enum { value = true };
     };
 
+    template <typename ScalarType>
+    struct is_any_sparse_matrix<viennacl::sliced_ell_matrix<ScalarType> >
+    {
+      enum { value = true };
+    };
+
     template <typename T>
     struct is_any_sparse_matrix<const T>
     {
@@ -455,6 +455,12 @@ namespace viennacl
         typedef typename cpu_value_type<T>::type    type;
       };
 
+      template <typename T>
+      struct cpu_value_type<viennacl::sliced_ell_matrix<T> >
+      {
+        typedef typename cpu_value_type<T>::type    type;
+      };
+
       template <typename T, unsigned int ALIGNMENT>
       struct cpu_value_type<viennacl::circulant_matrix<T, ALIGNMENT> >
       {
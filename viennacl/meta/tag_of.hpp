@@ -241,6 +241,12 @@ namespace viennacl
       typedef viennacl::tag_viennacl  type;
     };
 
+    template< typename T>
+    struct tag_of< viennacl::sliced_ell_matrix<T> >
+    {
+      typedef viennacl::tag_viennacl  type;
+    };
+
     template< typename T, unsigned int I>
     struct tag_of< viennacl::circulant_matrix<T,I> >
     {
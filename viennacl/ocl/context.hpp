@@ -29,6 +29,7 @@
 #endif
 
 #include <algorithm>
+#include <cstdlib>
 #include <vector>
 #include <map>
 #include "viennacl/ocl/forwards.h"
@@ -38,6 +39,7 @@
 #include "viennacl/ocl/device.hpp"
 #include "viennacl/ocl/platform.hpp"
 #include "viennacl/ocl/command_queue.hpp"
+#include "viennacl/ocl/program_cache.hpp"
 
 namespace viennacl
 {
@@ -53,7 +55,11 @@ namespace viennacl
                     current_device_id_(0),
                     default_device_num_(1),
                     pf_index_(0),
-                    current_queue_id_(0) {}
+                    current_queue_id_(0)
+        {
+          if (std::getenv("VIENNACL_CACHE_PATH"))
+            cache_path_ = std::getenv("VIENNACL_CACHE_PATH");
+        }
 
         //////// Get and set default number of devices per context */
         /** @brief Returns the maximum number of devices to be set up for the context */
@@ -338,7 +344,10 @@ namespace viennacl
           return programs_.back();
         }
 
-        /** @brief Adds a new program with the provided source to the context. Compiles the program and extracts all kernels from it
+        /** @brief Adds a new program with the provided source to the context.
+        *
+        * If a cache path is set (see cache_path()), the program is created from the binaries cached for the same source, build options, and devices.
+        * Otherwise, the program is compiled from source and the resulting binaries are added to the cache. Kernels are extracted from the program on first use.
         */
         viennacl::ocl::program & add_program(std::string const & source, std::string const & prog_name)
         {
@@ -350,46 +359,45 @@ namespace viennacl
           std::cout << "ViennaCL: Adding program '" << prog_name << "' to context " << h_ << std::endl;
           #endif
 
-          //
-          // Build program
-          //
-          cl_program temp = clCreateProgramWithSource(h_.get(), 1, (const char **)&source_text, &source_size, &err);
-          VIENNACL_ERR_CHECK(err);
-
-          const char * options = build_options_.c_str();
-          err = clBuildProgram(temp, 0, NULL, options, NULL, NULL);
-          if (err != CL_SUCCESS)
+          cl_program temp = NULL;
+          std::string cache_key;
+          std::string cache_file;
+          if (cache_path_.size() > 0)
           {
-            char buffer[8192];
-            cl_build_status status;
-            clGetProgramBuildInfo(temp, devices_[0].id(), CL_PROGRAM_BUILD_STATUS, sizeof(cl_build_status), &status, NULL);
-            clGetProgramBuildInfo(temp, devices_[0].id(), CL_PROGRAM_BUILD_LOG, sizeof(char)*8192, &buffer, NULL);
-            std::cout << "Build Scalar: Err = " << err << " Status = " << status << std::endl;
-            std::cout << "Log: " << buffer << std::endl;
-            std::cout << "Sources: " << source << std::endl;
+            cache_key  = viennacl::ocl::detail::program_cache_key(devices_, build_options_, source);
+            cache_file = viennacl::ocl::detail::program_cache_file(cache_path_, cache_key);
+            temp = viennacl::ocl::detail::load_program_binaries(h_.get(), devices_, build_options_, cache_file, cache_key);
           }
-          VIENNACL_ERR_CHECK(err);
 
-          programs_.push_back(viennacl::ocl::program(temp, *this, prog_name));
-
-          viennacl::ocl::program & prog = programs_.back();
+          if (!temp)
+          {
+            //
+            // Build program
+            //
+            temp = clCreateProgramWithSource(h_.get(), 1, (const char **)&source_text, &source_size, &err);
+            VIENNACL_ERR_CHECK(err);
 
-          //
-          // Extract kernels
-          //
-          cl_kernel kernels[1024];
-          cl_uint   num_kernels_in_prog;
-          err = clCreateKernelsInProgram(prog.handle().get(), 1024, kernels, &num_kernels_in_prog);
-          VIENNACL_ERR_CHECK(err);
+            const char * options = build_options_.c_str();
+            err = clBuildProgram(temp, 0, NULL, options, NULL, NULL);
+            if (err != CL_SUCCESS)
+            {
+              char buffer[8192];
+              cl_build_status status;
+              clGetProgramBuildInfo(temp, devices_[0].id(), CL_PROGRAM_BUILD_STATUS, sizeof(cl_build_status), &status, NULL);
+              clGetProgramBuildInfo(temp, devices_[0].id(), CL_PROGRAM_BUILD_LOG, sizeof(char)*8192, &buffer, NULL);
+              std::cout << "Build Scalar: Err = " << err << " Status = " << status << std::endl;
+              std::cout << "Log: " << buffer << std::endl;
+              std::cout << "Sources: " << source << std::endl;
+            }
+            VIENNACL_ERR_CHECK(err);
 
-          for (cl_uint i=0; i<num_kernels_in_prog; ++i)
-          {
-            char kernel_name[128];
-            err = clGetKernelInfo(kernels[i], CL_KERNEL_FUNCTION_NAME, 128, kernel_name, NULL);
-            prog.add_kernel(kernels[i], std::string(kernel_name));
+            if (cache_path_.size() > 0)
+              viennacl::ocl::detail::store_program_binaries(temp, devices_, cache_file, cache_key);
           }
 
-          return prog;
+          programs_.push_back(viennacl::ocl::program(temp, *this, prog_name));
+
+          return programs_.back();
         }
 
         /** @brief Delete the program with the provided name */
@@ -476,6 +484,12 @@ namespace viennacl
         /** @brief Sets the build option string, which is passed to the OpenCL compiler in subsequent compilations. Does not effect programs already compiled previously. */
         void build_options(std::string op) { build_options_ = op; }
 
+        /** @brief Returns the directory in which compiled program binaries are cached. An empty string means that caching is disabled. Initialized from the environment variable VIENNACL_CACHE_PATH. */
+        std::string cache_path() const { return cache_path_; }
+
+        /** @brief Sets the directory in which compiled program binaries are cached. The directory must exist. Pass an empty string to disable caching. Does not effect programs already compiled previously. */
+        void cache_path(std::string new_path) { cache_path_ = new_path; }
+
         /** @brief Returns the platform ID of the platform to be used for the context */
         std::size_t platform_index() const  { return pf_index_; }
 
@@ -614,6 +628,7 @@ namespace viennacl
         ProgramContainer programs_;
         std::map< cl_device_id, std::vector< viennacl::ocl::command_queue> > queues_;
         std::string build_options_;
+        std::string cache_path_;
         std::size_t pf_index_;
         unsigned int current_queue_id_;
     }; //context
@@ -629,7 +644,7 @@ namespace viennacl
       return kernels_.back();
     }
 
-    /** @brief Returns the kernel with the provided name */
+    /** @brief Returns the kernel with the provided name. Creates the kernel if it has not been used before. */
     inline viennacl::ocl::kernel & viennacl::ocl::program::get_kernel(std::string const & name)
     {
       //std::cout << "Requiring kernel " << name << " from program " << name_ << std::endl;
@@ -640,10 +655,16 @@ namespace viennacl
         if (it->name() == name)
           return *it;
       }
-      std::cerr << "ViennaCL: FATAL ERROR: Could not find kernel '" << name << "'" << std::endl;
-      std::cout << "Number of kernels in program: " << kernels_.size() << std::endl;
-      throw "Kernel not found";
-      //return kernels_[0];  //return a defined object
+
+      cl_int err;
+      cl_kernel kernel_handle = clCreateKernel(handle_.get(), name.c_str(), &err);
+      if (err != CL_SUCCESS)
+      {
+        std::cerr << "ViennaCL: FATAL ERROR: Could not find kernel '" << name << "'" << std::endl;
+        std::cout << "Number of kernels used from program: " << kernels_.size() << std::endl;
+        throw "Kernel not found";
+      }
+      return add_kernel(kernel_handle, name);
     }
 
 
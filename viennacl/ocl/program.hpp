@@ -23,7 +23,7 @@
 */
 
 #include <string>
-#include <vector>
+#include <deque>
 #include "viennacl/ocl/forwards.h"
 #include "viennacl/ocl/handle.hpp"
 #include "viennacl/ocl/kernel.hpp"
@@ -34,7 +34,7 @@ namespace viennacl
   {
     class program
     {
-      typedef std::vector<viennacl::ocl::kernel>    KernelContainer;
+      typedef std::deque<viennacl::ocl::kernel>     KernelContainer;   // kernels are added on first use, hence references to kernels must remain valid
 
     public:
       program() : p_context_(NULL) {}
@@ -57,7 +57,7 @@ namespace viennacl
       /** @brief Adds a kernel to the program */
       inline viennacl::ocl::kernel & add_kernel(cl_kernel kernel_handle, std::string const & kernel_name);   //see context.hpp for implementation
 
-      /** @brief Returns the kernel with the provided name */
+      /** @brief Returns the kernel with the provided name. Kernels are created on first use. */
       inline viennacl::ocl::kernel & get_kernel(std::string const & name);    //see context.hpp for implementation
 
       const viennacl::ocl::handle<cl_program> & handle() const { return handle_; }
@@ -0,0 +1,241 @@
+#ifndef VIENNACL_OCL_PROGRAM_CACHE_HPP_
+#define VIENNACL_OCL_PROGRAM_CACHE_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/ocl/program_cache.hpp
+    @brief Implements an on-disk cache of compiled OpenCL program binaries.
+
+    Each cache file holds the binaries of one program for all devices of a context.
+    The file name is derived from a hash of the program source, the build options, and the name, vendor, and driver version of the devices.
+    The full key is stored at the beginning of the file and compared when loading, so that a hash collision or a stale file results in a rebuild from source rather than in a wrong program.
+*/
+
+#ifdef __APPLE__
+#include <OpenCL/cl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include "viennacl/ocl/device.hpp"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace viennacl
+{
+  namespace ocl
+  {
+    namespace detail
+    {
+      /** @brief 64-bit FNV-1a hash of a string */
+      inline cl_ulong program_cache_hash(std::string const & str, cl_ulong hash = (cl_ulong(0xcbf29ce4) << 32) | cl_ulong(0x84222325))
+      {
+        cl_ulong const prime = (cl_ulong(1) << 40) | cl_ulong(0x1b3);
+        for (std::size_t i=0; i<str.size(); ++i)
+        {
+          hash ^= static_cast<unsigned char>(str[i]);
+          hash *= prime;
+        }
+        return hash;
+      }
+
+      /** @brief Returns the key identifying the binaries of a program: Build options, devices (name, vendor, driver version), and two independent hashes of the source */
+      inline std::string program_cache_key(std::vector<viennacl::ocl::device> const & devices, std::string const & build_options, std::string const & source)
+      {
+        cl_ulong source_hash_1 = program_cache_hash(source);
+        cl_ulong source_hash_2 = program_cache_hash(source, source_hash_1 ^ cl_ulong(source.size()));
+
+        std::ostringstream key;
+        key << "ViennaCL program binaries" << std::endl;
+        key << "Build options: " << build_options << std::endl;
+        for (std::size_t i=0; i<devices.size(); ++i)
+          key << "Device: " << devices[i].name() << "; " << devices[i].vendor() << "; " << devices[i].driver_version() << std::endl;
+        key << "Source: " << source.size() << " " << std::hex << source_hash_1 << " " << source_hash_2 << std::endl;
+        return key.str();
+      }
+
+      /** @brief Returns the path of the cache file for the provided key */
+      inline std::string program_cache_file(std::string const & cache_path, std::string const & key)
+      {
+        std::ostringstream filename;
+        filename << cache_path;
+        if (cache_path.size() > 0 && cache_path[cache_path.size() - 1] != '/' && cache_path[cache_path.size() - 1] != '\\')
+          filename << "/";
+        filename << "viennacl_" << std::hex << program_cache_hash(key) << ".clbin";
+        return filename.str();
+      }
+
+      /** @brief Creates a program from the binaries stored in the cache file. Returns NULL if there is no valid cache file for the key or if the binaries are rejected by the OpenCL implementation. */
+      inline cl_program load_program_binaries(cl_context context,
+                                              std::vector<viennacl::ocl::device> const & devices,
+                                              std::string const & build_options,
+                                              std::string const & filename,
+                                              std::string const & key)
+      {
+        if (devices.size() == 0)
+          return NULL;
+
+        std::ifstream file(filename.c_str(), std::ios::binary);
+        if (!file)
+          return NULL;
+
+        std::string stored_key(key.size(), ' ');
+        file.read(&(stored_key[0]), static_cast<std::streamsize>(key.size()));
+        if (!file || stored_key != key)
+          return NULL;
+
+        std::vector<std::vector<unsigned char> > binaries(devices.size());
+        std::vector<std::size_t>                 binary_sizes(devices.size());
+        std::vector<const unsigned char *>       binary_ptrs(devices.size());
+        std::vector<cl_device_id>                device_ids(devices.size());
+        for (std::size_t i=0; i<devices.size(); ++i)
+        {
+          cl_ulong binary_size = 0;
+          file.read(reinterpret_cast<char *>(&binary_size), sizeof(cl_ulong));
+          if (!file || binary_size == 0)
+            return NULL;
+
+          binaries[i].resize(static_cast<std::size_t>(binary_size));
+          file.read(reinterpret_cast<char *>(&(binaries[i][0])), static_cast<std::streamsize>(binary_size));
+          if (!file)
+            return NULL;
+
+          binary_sizes[i] = binaries[i].size();
+          binary_ptrs[i]  = &(binaries[i][0]);
+          device_ids[i]   = devices[i].id();
+        }
+
+        std::vector<cl_int> binary_status(devices.size());
+        cl_int err;
+        cl_program program = clCreateProgramWithBinary(context, static_cast<cl_uint>(devices.size()), &(device_ids[0]),
+                                                       &(binary_sizes[0]), &(binary_ptrs[0]), &(binary_status[0]), &err);
+        if (err != CL_SUCCESS)
+          return NULL;
+
+        err = clBuildProgram(program, 0, NULL, build_options.c_str(), NULL, NULL);
+        if (err != CL_SUCCESS)
+        {
+          clReleaseProgram(program);
+          return NULL;
+        }
+
+        #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_CONTEXT)
+        std::cout << "ViennaCL: Loaded program binaries from " << filename << std::endl;
+        #endif
+        return program;
+      }
+
+      /** @brief Writes the binaries of a program built for the provided devices to the cache file.
+      *
+      * The data is written to a temporary file first, which is then renamed. Thus, processes populating the cache concurrently never read a partially written file.
+      * Failures are ignored, as the program is simply rebuilt from source the next time.
+      */
+      inline void store_program_binaries(cl_program program,
+                                         std::vector<viennacl::ocl::device> const & devices,
+                                         std::string const & filename,
+                                         std::string const & key)
+      {
+        cl_uint num_program_devices = 0;
+        if (devices.size() == 0)
+          return;
+        if (clGetProgramInfo(program, CL_PROGRAM_NUM_DEVICES, sizeof(cl_uint), &num_program_devices, NULL) != CL_SUCCESS || num_program_devices == 0)
+          return;
+
+        std::vector<cl_device_id> program_devices(num_program_devices);
+        std::vector<std::size_t>  binary_sizes(num_program_devices);
+        if (   clGetProgramInfo(program, CL_PROGRAM_DEVICES, sizeof(cl_device_id) * num_program_devices, &(program_devices[0]), NULL) != CL_SUCCESS
+            || clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(std::size_t) * num_program_devices, &(binary_sizes[0]), NULL) != CL_SUCCESS)
+          return;
+
+        std::vector<std::vector<unsigned char> > binaries(num_program_devices);
+        std::vector<unsigned char *>             binary_ptrs(num_program_devices);
+        for (std::size_t i=0; i<num_program_devices; ++i)
+        {
+          if (binary_sizes[i] == 0)
+            return;
+          binaries[i].resize(binary_sizes[i]);
+          binary_ptrs[i] = &(binaries[i][0]);
+        }
+        if (clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(unsigned char *) * num_program_devices, &(binary_ptrs[0]), NULL) != CL_SUCCESS)
+          return;
+
+#ifdef _WIN32
+        int process_id = _getpid();
+#else
+        int process_id = static_cast<int>(getpid());
+#endif
+        std::ostringstream temp_filename;
+        temp_filename << filename << ".tmp" << process_id << "_" << static_cast<const void *>(program);  // unique among processes and among threads within a process
+
+        {
+          std::ofstream file(temp_filename.str().c_str(), std::ios::binary);
+          if (!file)
+            return;
+
+          file.write(key.c_str(), static_cast<std::streamsize>(key.size()));
+
+          // binaries in the order of the devices in the context:
+          for (std::size_t i=0; i<devices.size(); ++i)
+          {
+            std::size_t j = 0;
+            while (j < num_program_devices && program_devices[j] != devices[i].id())
+              ++j;
+            if (j == num_program_devices)
+            {
+              file.close();
+              std::remove(temp_filename.str().c_str());
+              return;
+            }
+
+            cl_ulong binary_size = binaries[j].size();
+            file.write(reinterpret_cast<const char *>(&binary_size), sizeof(cl_ulong));
+            file.write(reinterpret_cast<const char *>(&(binaries[j][0])), static_cast<std::streamsize>(binaries[j].size()));
+          }
+
+          if (!file)
+          {
+            file.close();
+            std::remove(temp_filename.str().c_str());
+            return;
+          }
+        }
+
+        // atomic on POSIX systems. Fails on Windows if another process has created the file in the meantime, in which case the temporary file is discarded:
+        if (std::rename(temp_filename.str().c_str(), filename.c_str()) != 0)
+          std::remove(temp_filename.str().c_str());
+        #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_CONTEXT)
+        else
+          std::cout << "ViennaCL: Stored program binaries in " << filename << std::endl;
+        #endif
+      }
+
+    } //namespace detail
+  } //namespace ocl
+} //namespace viennacl
+
+#endif
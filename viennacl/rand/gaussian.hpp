@@ -1,26 +1,48 @@
 #ifndef VIENNACL_RAND_GAUSSIAN_HPP_
 #define VIENNACL_RAND_GAUSSIAN_HPP_
 
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/rand/gaussian.hpp
+    @brief Normally distributed random numbers, generated by the Box-Muller transform.
+*/
+
 #include "viennacl/backend/mem_handle.hpp"
 #include "viennacl/rand/utils.hpp"
-#include "viennacl/linalg/kernels/rand_kernels.h"
 
 namespace viennacl{
 
 namespace rand{
 
+/** @brief Tag for normally distributed random numbers with mean mu and standard deviation sigma. The seed determines the generated values. */
 struct gaussian_tag{
-    gaussian_tag(float _mu = 0, float _sigma = 1) : mu(_mu), sigma(_sigma){ }
+    gaussian_tag(float _mu = 0, float _sigma = 1, unsigned int _seed = 0) : mu(_mu), sigma(_sigma), seed(_seed){ }
     float mu;
     float sigma;
+    unsigned int seed;
 };
 
 template<class ScalarType>
 struct buffer_dumper<ScalarType, gaussian_tag>{
-    static void dump(viennacl::backend::mem_handle const & buff, gaussian_tag tag, cl_uint start, cl_uint size){
-      viennacl::ocl::kernel & k = viennacl::ocl::get_kernel(viennacl::linalg::kernels::rand<ScalarType,1>::program_name(),"dump_gaussian");
-      k.global_work_size(0, viennacl::tools::align_to_multiple<unsigned int>(size/2,k.local_work_size(0)));
-      viennacl::ocl::enqueue(k(buff.opencl_handle(), start, size, cl_float(tag.mu), cl_float(tag.sigma) , cl_uint(time(0))));
+    typedef viennacl::linalg::host_based::detail::random_gaussian_generator<ScalarType>   generator_type;
+
+    static generator_type generator(gaussian_tag const & tag){
+      return generator_type(static_cast<ScalarType>(tag.mu), static_cast<ScalarType>(tag.sigma));
     }
 };
 
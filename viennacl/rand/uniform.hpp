@@ -1,27 +1,49 @@
 #ifndef VIENNACL_RAND_UNIFORM_HPP_
 #define VIENNACL_RAND_UNIFORM_HPP_
 
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/rand/uniform.hpp
+    @brief Uniformly distributed random numbers.
+*/
+
 #include "viennacl/backend/mem_handle.hpp"
 #include "viennacl/rand/utils.hpp"
-#include "viennacl/linalg/kernels/rand_kernels.h"
 
 
 namespace viennacl{
 
 namespace rand{
 
+/** @brief Tag for uniformly distributed random numbers in [a, b). The seed determines the generated values. */
 struct uniform_tag{
-    uniform_tag(unsigned int _a = 0, unsigned int _b = 1) : a(_a), b(_b){ }
+    uniform_tag(float _a = 0, float _b = 1, unsigned int _seed = 0) : a(_a), b(_b), seed(_seed){ }
     float a;
     float b;
+    unsigned int seed;
 };
 
 template<class ScalarType>
 struct buffer_dumper<ScalarType, uniform_tag>{
-  static void dump(viennacl::backend::mem_handle const & buff, uniform_tag tag, cl_uint start, cl_uint size){
-    viennacl::ocl::kernel & k = viennacl::ocl::get_kernel(viennacl::linalg::kernels::rand<ScalarType,1>::program_name(),"dump_uniform");
-    k.global_work_size(0, viennacl::tools::align_to_multiple<unsigned int>(size,k.local_work_size(0)));
-    viennacl::ocl::enqueue(k(buff.opencl_handle(), start, size, cl_float(tag.a), cl_float(tag.b) , cl_uint(time(0))));
+  typedef viennacl::linalg::host_based::detail::random_uniform_generator<ScalarType>   generator_type;
+
+  static generator_type generator(uniform_tag const & tag){
+    return generator_type(static_cast<ScalarType>(tag.a), static_cast<ScalarType>(tag.b));
   }
 };
 
@@ -1,49 +1,146 @@
 #ifndef VIENNACL_RAND_UTILS_HPP_
 #define VIENNACL_RAND_UTILS_HPP_
 
-#ifdef VIENNACL_WITH_OPENCL
-#include "viennacl/linalg/kernels/rand_kernels.h"
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/rand/utils.hpp
+    @brief Proxies for random vectors and matrices and the dispatch of the random number generation to the memory domains.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/context.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/linalg/host_based/random.hpp"
 
 namespace viennacl{
 
 namespace rand{
 
-
+/** @brief Represents a matrix of size size1 x size2 with entries drawn from the distribution 'distribution'. Used for the initialization of viennacl::matrix */
 template<class SCALARTYPE, class DISTRIBUTION>
 struct random_matrix_t{
-    typedef size_t size_type;
-    random_matrix_t(size_type _size1, unsigned int _size2, DISTRIBUTION const & _distribution) : size1(_size1), size2(_size2), distribution(_distribution){
-        #ifdef VIENNACL_WITH_OPENCL
-        viennacl::linalg::kernels::rand<SCALARTYPE,1>::init();
-        #endif
-    }
+    typedef vcl_size_t size_type;
+    random_matrix_t(size_type _size1, size_type _size2, DISTRIBUTION const & _distribution, viennacl::context _ctx = viennacl::context())
+      : size1(_size1), size2(_size2), distribution(_distribution), ctx(_ctx) {}
     size_type size1;
     size_type size2;
     DISTRIBUTION distribution;
+    viennacl::context ctx;
 };
 
 
+/** @brief Represents a vector of size 'size' with entries drawn from the distribution 'distribution'. Used for the initialization of viennacl::vector */
 template<class SCALARTYPE, class DISTRIBUTION>
 struct random_vector_t{
-    typedef size_t size_type;
-    random_vector_t(size_type _size, DISTRIBUTION const & _distribution) : size(_size), distribution(_distribution){
-        #ifdef VIENNACL_WITH_OPENCL
-        viennacl::linalg::kernels::rand<SCALARTYPE,1>::init();
-        #endif
-    }
+    typedef vcl_size_t size_type;
+    random_vector_t(size_type _size, DISTRIBUTION const & _distribution, viennacl::context _ctx = viennacl::context())
+      : size(_size), distribution(_distribution), ctx(_ctx) {}
     size_type size;
     DISTRIBUTION distribution;
+    viennacl::context ctx;
 };
 
+/** @brief Provides the functor which computes the values of a distribution from the random words of the counter-based generator. Specialized for each distribution tag. */
 template<class ScalarType, class Distribution>
 struct buffer_dumper;
 
 
+/** @brief Fills a vector, vector_range, or vector_slice with random values drawn from 'distribution'.
+*
+* The values are generated by a counter-based generator seeded with distribution.seed.
+* The value of each entry only depends on the seed and on the index of the entry, hence it is reproducible and independent of the number of threads.
+* For memory domains other than MAIN_MEMORY, the values are generated on the host and transferred, so they are the same for all memory domains.
+*
+* @param vec            The vector to be filled
+* @param distribution   A distribution tag such as uniform_tag or gaussian_tag
+*/
+template<class ScalarType, class Distribution>
+void fill(vector_base<ScalarType> & vec, Distribution const & distribution)
+{
+  switch (viennacl::traits::handle(vec).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      viennacl::linalg::host_based::random_fill(vec, buffer_dumper<ScalarType, Distribution>::generator(distribution), distribution.seed);
+      break;
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+  #ifdef VIENNACL_WITH_OPENCL
+    case viennacl::OPENCL_MEMORY:
+  #endif
+  #ifdef VIENNACL_WITH_CUDA
+    case viennacl::CUDA_MEMORY:
+  #endif
+    {
+      viennacl::vector<ScalarType> temp(viennacl::traits::size(vec), viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::linalg::host_based::random_fill(temp, buffer_dumper<ScalarType, Distribution>::generator(distribution), distribution.seed);
+      temp.switch_memory_context(viennacl::traits::context(vec));
+      vec = temp;
+      break;
+    }
+#endif
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
 }
 
+/** @brief Fills a matrix, matrix_range, or matrix_slice with random values drawn from 'distribution'.
+*
+* Entries are numbered row by row for row-major matrices and column by column for column-major matrices.
+* Otherwise, the same reproducibility guarantees as for vectors apply.
+*
+* @param mat            The matrix to be filled
+* @param distribution   A distribution tag such as uniform_tag or gaussian_tag
+*/
+template<class ScalarType, class F, class Distribution>
+void fill(matrix_base<ScalarType, F> & mat, Distribution const & distribution)
+{
+  switch (viennacl::traits::handle(mat).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      viennacl::linalg::host_based::random_fill(mat, buffer_dumper<ScalarType, Distribution>::generator(distribution), distribution.seed);
+      break;
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+  #ifdef VIENNACL_WITH_OPENCL
+    case viennacl::OPENCL_MEMORY:
+  #endif
+  #ifdef VIENNACL_WITH_CUDA
+    case viennacl::CUDA_MEMORY:
+  #endif
+    {
+      viennacl::matrix<ScalarType, F> temp(viennacl::traits::size1(mat), viennacl::traits::size2(mat), viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::linalg::host_based::random_fill(temp, buffer_dumper<ScalarType, Distribution>::generator(distribution), distribution.seed);
+      viennacl::backend::switch_memory_context<ScalarType>(temp.handle(), viennacl::traits::context(mat));
+      mat = temp;
+      break;
+    }
+#endif
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
 }
 
-#endif
+}
 
+}
 
 #endif
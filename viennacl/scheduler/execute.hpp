@@ -30,6 +30,7 @@
 #include "viennacl/scheduler/execute_axbx.hpp"
 #include "viennacl/scheduler/execute_elementwise.hpp"
 #include "viennacl/scheduler/execute_matrix_prod.hpp"
+#include "viennacl/scheduler/execute_fused.hpp"
 
 namespace viennacl
 {
@@ -40,6 +41,10 @@ namespace viennacl
       /** @brief Deals with x = RHS where RHS is an expression and x is either a scalar, a vector, or a matrix */
       void execute_composite(statement const & s, statement_node const & root_node)
       {
+        // element-wise vector expressions in main memory are evaluated in a single pass without temporaries:
+        if (detail::execute_fused(s, root_node))
+          return;
+
         statement::container_type const & expr = s.array();
 
         statement_node const & leaf = expr[root_node.rhs.node_index];
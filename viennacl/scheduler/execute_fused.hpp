@@ -0,0 +1,861 @@
+#ifndef VIENNACL_SCHEDULER_EXECUTE_FUSED_HPP
+#define VIENNACL_SCHEDULER_EXECUTE_FUSED_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/scheduler/execute_fused.hpp
+    @brief Executes element-wise vector expressions and inner products in main memory in a single pass without temporaries.
+
+    The expression tree is flattened into a list of instructions, which are then applied to blocks of the operands.
+    Intermediate results of a block stay in a small per-thread buffer, so each operand is read once and the result is written once.
+    Several statements over vectors of the same size can be executed together in the same pass.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "viennacl/forwards.h"
+#include "viennacl/scheduler/forwards.h"
+#include "viennacl/scheduler/execute_util.hpp"
+#include "viennacl/linalg/detail/op_applier.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+
+// Number of entries processed at once by fused programs:
+#ifndef VIENNACL_SCHEDULER_FUSED_BLOCK_SIZE
+  #define VIENNACL_SCHEDULER_FUSED_BLOCK_SIZE  128
+#endif
+
+namespace viennacl
+{
+  namespace scheduler
+  {
+    namespace detail
+    {
+      /** @brief Operand of an instruction of a fused program: A vector, a scalar, or the result of a previous instruction */
+      struct fused_operand
+      {
+        enum operand_type { VECTOR_OPERAND, SCALAR_OPERAND, RESULT_OPERAND };
+
+        fused_operand() : type(SCALAR_OPERAND), index(0) {}
+        fused_operand(operand_type t, std::size_t i) : type(t), index(i) {}
+
+        operand_type type;
+        std::size_t  index;   // index of the vector, of the scalar, or of the instruction computing the value
+      };
+
+      /** @brief A single element-wise operation of a fused program */
+      struct fused_instruction
+      {
+        operation_node_type  op;
+        fused_operand        lhs;
+        fused_operand        rhs;   // unused for unary operations
+      };
+
+      /** @brief Element-wise expressions flattened into a list of instructions.
+      *
+      * The operands are processed row by row, where a vector forms a single row.
+      */
+      template <typename NumericT>
+      struct fused_program
+      {
+        std::vector<viennacl::vector_base<NumericT> const *>  vectors;
+        std::vector<NumericT>                                  scalars;
+        std::vector<lhs_rhs_element>                           scalar_operands;  // the scalars the values were taken from
+        std::vector<fused_instruction>                         instructions;
+
+        // raw data of the vectors, set up by bind_fused_program():
+        std::vector<NumericT const *>                          data;
+        std::vector<long>                                      start;
+        std::vector<long>                                      inc;
+        std::vector<long>                                      row_inc;   // distance between two rows, zero for vectors
+      };
+
+
+      inline viennacl::vector_base<float>  const * fused_vector(lhs_rhs_element const & elem, float)  { return elem.vector_float; }
+      inline viennacl::vector_base<double> const * fused_vector(lhs_rhs_element const & elem, double) { return elem.vector_double; }
+
+      /** @brief Extracts the value of a host scalar or of a device scalar in main memory. Returns false for all other operands. */
+      template <typename NumericT>
+      bool fused_scalar_value(lhs_rhs_element const & elem, NumericT & value)
+      {
+        if (elem.subtype == HOST_SCALAR_TYPE)
+        {
+          switch (elem.numeric_type)
+          {
+            case FLOAT_TYPE:  value = static_cast<NumericT>(elem.host_float);  return true;
+            case DOUBLE_TYPE: value = static_cast<NumericT>(elem.host_double); return true;
+            default:          return false;
+          }
+        }
+        else if (elem.subtype == DEVICE_SCALAR_TYPE)
+        {
+          switch (elem.numeric_type)
+          {
+            case FLOAT_TYPE:
+              if (elem.scalar_float->handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
+                return false;
+              value = static_cast<NumericT>(float(*elem.scalar_float));
+              return true;
+            case DOUBLE_TYPE:
+              if (elem.scalar_double->handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
+                return false;
+              value = static_cast<NumericT>(double(*elem.scalar_double));
+              return true;
+            default:
+              return false;
+          }
+        }
+        return false;
+      }
+
+      /** @brief Returns true if the operation is an element-wise unary function */
+      inline bool is_fusable_unary_operation(operation_node_type op)
+      {
+        switch (op)
+        {
+          case OPERATION_UNARY_ABS_TYPE:   case OPERATION_UNARY_ACOS_TYPE:  case OPERATION_UNARY_ASIN_TYPE:
+          case OPERATION_UNARY_ATAN_TYPE:  case OPERATION_UNARY_CEIL_TYPE:  case OPERATION_UNARY_COS_TYPE:
+          case OPERATION_UNARY_COSH_TYPE:  case OPERATION_UNARY_EXP_TYPE:   case OPERATION_UNARY_FABS_TYPE:
+          case OPERATION_UNARY_FLOOR_TYPE: case OPERATION_UNARY_LOG_TYPE:   case OPERATION_UNARY_LOG10_TYPE:
+          case OPERATION_UNARY_SIN_TYPE:   case OPERATION_UNARY_SINH_TYPE:  case OPERATION_UNARY_SQRT_TYPE:
+          case OPERATION_UNARY_TAN_TYPE:   case OPERATION_UNARY_TANH_TYPE:
+            return true;
+          default:
+            return false;
+        }
+      }
+
+      /** @brief Returns true if the binary operation can be applied element-wise to operands of the given kinds (scalar or not) */
+      inline bool is_fusable_binary_operation(operation_node_type op, bool lhs_is_scalar, bool rhs_is_scalar)
+      {
+        switch (op)
+        {
+          case OPERATION_BINARY_ADD_TYPE:
+          case OPERATION_BINARY_SUB_TYPE:
+          case OPERATION_BINARY_ELEMENT_PROD_TYPE:
+          case OPERATION_BINARY_ELEMENT_DIV_TYPE:
+            return !lhs_is_scalar && !rhs_is_scalar;
+          case OPERATION_BINARY_MULT_TYPE:
+            return lhs_is_scalar != rhs_is_scalar;
+          case OPERATION_BINARY_DIV_TYPE:
+            return !lhs_is_scalar && rhs_is_scalar;
+          default:
+            return false;
+        }
+      }
+
+      /** @brief Appends the instructions for the subexpression 'elem' to the program.
+      *
+      * Returns false if the subexpression contains anything but dense vectors of the provided size in main memory, scalars,
+      * and element-wise operations (+, -, scaling by a scalar, element_prod(), element_div(), element-wise unary functions).
+      */
+      template <typename NumericT>
+      bool compile_fused(statement const & s, lhs_rhs_element const & elem, vcl_size_t size, fused_program<NumericT> & program, fused_operand & result)
+      {
+        switch (elem.type_family)
+        {
+          case VECTOR_TYPE_FAMILY:
+          {
+            if (elem.subtype != DENSE_VECTOR_TYPE || elem.numeric_type != statement_node_numeric_type(result_of::numeric_type_id<NumericT>::value))
+              return false;
+
+            viennacl::vector_base<NumericT> const * vec = fused_vector(elem, NumericT());
+            if (viennacl::traits::handle(*vec).get_active_handle_id() != viennacl::MAIN_MEMORY || vec->size() != size)
+              return false;
+
+            std::size_t index = static_cast<std::size_t>(std::find(program.vectors.begin(), program.vectors.end(), vec) - program.vectors.begin());
+            if (index == program.vectors.size())
+              program.vectors.push_back(vec);
+            result = fused_operand(fused_operand::VECTOR_OPERAND, index);
+            return true;
+          }
+
+          case SCALAR_TYPE_FAMILY:
+          {
+            NumericT value;
+            if (!fused_scalar_value(elem, value))
+              return false;
+            program.scalars.push_back(value);
+            program.scalar_operands.push_back(elem);
+            result = fused_operand(fused_operand::SCALAR_OPERAND, program.scalars.size() - 1);
+            return true;
+          }
+
+          case COMPOSITE_OPERATION_FAMILY:
+          {
+            statement_node const & node = s.array()[elem.node_index];
+
+            fused_instruction instruction;
+            instruction.op = node.op.type;
+            if (!compile_fused(s, node.lhs, size, program, instruction.lhs))
+              return false;
+
+            bool lhs_is_scalar = (instruction.lhs.type == fused_operand::SCALAR_OPERAND);
+            if (node.op.type_family == OPERATION_UNARY_TYPE_FAMILY)
+            {
+              if (!is_fusable_unary_operation(node.op.type) || lhs_is_scalar)
+                return false;
+            }
+            else
+            {
+              if (!compile_fused(s, node.rhs, size, program, instruction.rhs))
+                return false;
+
+              if (!is_fusable_binary_operation(node.op.type, lhs_is_scalar, instruction.rhs.type == fused_operand::SCALAR_OPERAND))
+                return false;
+            }
+
+            program.instructions.push_back(instruction);
+            result = fused_operand(fused_operand::RESULT_OPERAND, program.instructions.size() - 1);
+            return true;
+          }
+
+          default:
+            return false;
+        }
+      }
+
+      /** @brief Applies an element-wise unary function to a block */
+      template <typename OpT, typename NumericT>
+      void fused_unary_block(NumericT * result, NumericT const * x, long block_size)
+      {
+        for (long i = 0; i < block_size; ++i)
+          viennacl::linalg::detail::op_applier<op_element_unary<OpT> >::apply(result[i], x[i]);
+      }
+
+      /** @brief Returns the block of values of a vector or result operand, NULL for scalar operands. 'blocks' holds the blocks of all vectors of the program, followed by the blocks of all instruction results. */
+      template <typename NumericT>
+      NumericT const * fused_operand_block(fused_operand const & operand, std::size_t num_vectors, NumericT const * const * blocks)
+      {
+        switch (operand.type)
+        {
+          case fused_operand::VECTOR_OPERAND: return blocks[operand.index];
+          case fused_operand::RESULT_OPERAND: return blocks[num_vectors + operand.index];
+          default:                            return NULL;
+        }
+      }
+
+      /** @brief Applies a single instruction to a block of 'block_size' entries. The values of vector and result operands are given by 'blocks', scalar operands are taken from the program. */
+      template <typename NumericT>
+      void fused_apply_instruction(fused_program<NumericT> const & program,
+                                   fused_instruction const & instruction,
+                                   NumericT const * const * blocks,
+                                   NumericT * result,
+                                   long block_size)
+      {
+        NumericT const * x = fused_operand_block(instruction.lhs, program.data.size(), blocks);
+        NumericT const * y = fused_operand_block(instruction.rhs, program.data.size(), blocks);
+
+        switch (instruction.op)
+        {
+          case OPERATION_BINARY_ADD_TYPE:
+            for (long i = 0; i < block_size; ++i)
+              result[i] = x[i] + y[i];
+            break;
+          case OPERATION_BINARY_SUB_TYPE:
+            for (long i = 0; i < block_size; ++i)
+              result[i] = x[i] - y[i];
+            break;
+          case OPERATION_BINARY_ELEMENT_PROD_TYPE:
+            for (long i = 0; i < block_size; ++i)
+              result[i] = x[i] * y[i];
+            break;
+          case OPERATION_BINARY_ELEMENT_DIV_TYPE:
+            for (long i = 0; i < block_size; ++i)
+              result[i] = x[i] / y[i];
+            break;
+          case OPERATION_BINARY_MULT_TYPE:
+          {
+            NumericT const * v = x ? x : y;
+            NumericT alpha = x ? program.scalars[instruction.rhs.index] : program.scalars[instruction.lhs.index];
+            for (long i = 0; i < block_size; ++i)
+              result[i] = v[i] * alpha;
+            break;
+          }
+          case OPERATION_BINARY_DIV_TYPE:
+          {
+            NumericT alpha = program.scalars[instruction.rhs.index];
+            for (long i = 0; i < block_size; ++i)
+              result[i] = x[i] / alpha;
+            break;
+          }
+
+#define VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPNAME, OPTAG) \
+          case OPNAME: fused_unary_block<OPTAG>(result, x, block_size); break;
+
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_ABS_TYPE,   op_abs)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_ACOS_TYPE,  op_acos)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_ASIN_TYPE,  op_asin)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_ATAN_TYPE,  op_atan)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_CEIL_TYPE,  op_ceil)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_COS_TYPE,   op_cos)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_COSH_TYPE,  op_cosh)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_EXP_TYPE,   op_exp)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_FABS_TYPE,  op_fabs)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_FLOOR_TYPE, op_floor)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_LOG_TYPE,   op_log)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_LOG10_TYPE, op_log10)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_SIN_TYPE,   op_sin)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_SINH_TYPE,  op_sinh)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_SQRT_TYPE,  op_sqrt)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_TAN_TYPE,   op_tan)
+          VIENNACL_SCHEDULER_FUSED_UNARY_OP(OPERATION_UNARY_TANH_TYPE,  op_tanh)
+
+#undef VIENNACL_SCHEDULER_FUSED_UNARY_OP
+
+          default:
+            throw statement_not_supported_exception("Invalid operation in fused element-wise program");
+        }
+      }
+
+      /** @brief Sets up the raw data of the vectors of the program */
+      template <typename NumericT>
+      void bind_fused_program(fused_program<NumericT> & program)
+      {
+        std::size_t num_vectors = program.vectors.size();
+        program.data.resize(num_vectors);
+        program.start.resize(num_vectors);
+        program.inc.resize(num_vectors);
+        program.row_inc.assign(num_vectors, 0);
+        for (std::size_t j = 0; j < num_vectors; ++j)
+        {
+          program.data[j]  = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(*program.vectors[j]);
+          program.start[j] = static_cast<long>(viennacl::traits::start(*program.vectors[j]));
+          program.inc[j]   = static_cast<long>(viennacl::traits::stride(*program.vectors[j]));
+        }
+      }
+
+      /** @brief Returns true if the vectors of the program still have the provided size and the raw data set up by bind_fused_program(), and if all scalars still reside in main memory */
+      template <typename NumericT>
+      bool is_bound_fused_program(fused_program<NumericT> const & program, vcl_size_t size)
+      {
+        for (std::size_t j = 0; j < program.vectors.size(); ++j)
+        {
+          viennacl::vector_base<NumericT> const & vec = *program.vectors[j];
+          if (   viennacl::traits::handle(vec).get_active_handle_id() != viennacl::MAIN_MEMORY
+              || vec.size() != size
+              || viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec) != program.data[j]
+              || static_cast<long>(viennacl::traits::start(vec)) != program.start[j]
+              || static_cast<long>(viennacl::traits::stride(vec)) != program.inc[j])
+            return false;
+        }
+
+        NumericT value;
+        for (std::size_t i = 0; i < program.scalar_operands.size(); ++i)
+          if (!fused_scalar_value(program.scalar_operands[i], value))
+            return false;
+
+        return true;
+      }
+
+      /** @brief Reloads the values of the device scalars of the program */
+      template <typename NumericT>
+      void load_fused_scalars(fused_program<NumericT> & program)
+      {
+        for (std::size_t i = 0; i < program.scalar_operands.size(); ++i)
+          if (program.scalar_operands[i].subtype == DEVICE_SCALAR_TYPE)
+            fused_scalar_value(program.scalar_operands[i], program.scalars[i]);
+      }
+
+      /** @brief Returns the address of a device scalar, NULL for host scalars */
+      inline void const * fused_scalar_object(lhs_rhs_element const & elem)
+      {
+        if (elem.subtype != DEVICE_SCALAR_TYPE)
+          return NULL;
+        return (elem.numeric_type == FLOAT_TYPE) ? static_cast<void const *>(elem.scalar_float) : static_cast<void const *>(elem.scalar_double);
+      }
+
+      /** @brief Evaluates all instructions of the program for the entries [offset, offset + current_size) of the provided row of the operands.
+      *
+      * 'buffer' provides block_size entries for each instruction result and for each vector, into which strided vectors are gathered.
+      * On return, 'blocks' holds the blocks of all vectors followed by the blocks of all instruction results.
+      */
+      template <typename NumericT>
+      void evaluate_fused_block(fused_program<NumericT> const & program, long row, long offset, long current_size, long block_size,
+                                NumericT * buffer, NumericT const ** blocks)
+      {
+        std::size_t num_vectors      = program.data.size();
+        std::size_t num_instructions = program.instructions.size();
+
+        for (std::size_t j = 0; j < num_vectors; ++j)
+        {
+          NumericT const * row_data = program.data[j] + program.start[j] + row * program.row_inc[j];
+          if (program.inc[j] == 1)
+            blocks[j] = row_data + offset;
+          else
+          {
+            NumericT * gathered = buffer + static_cast<long>(num_instructions + j) * block_size;
+            for (long i = 0; i < current_size; ++i)
+              gathered[i] = row_data[(offset + i) * program.inc[j]];
+            blocks[j] = gathered;
+          }
+        }
+
+        for (std::size_t k = 0; k < num_instructions; ++k)
+        {
+          NumericT * result = buffer + static_cast<long>(k) * block_size;
+          fused_apply_instruction(program, program.instructions[k], blocks, result, current_size);
+          blocks[num_vectors + k] = result;
+        }
+      }
+
+
+      /** @brief A statement x = RHS (also +=, -=) with a vector or matrix x, or alpha = inner_prod(RHS1, RHS2) (also +=, -=) with a scalar alpha, compiled for fused execution */
+      template <typename NumericT>
+      struct fused_statement
+      {
+        fused_statement() : assign_op(OPERATION_BINARY_ASSIGN_TYPE), x(NULL), alpha(NULL), x_data(NULL), x_start(0), x_inc(1), x_row_inc(0) {}
+
+        fused_program<NumericT>             program;
+        operation_node_type                 assign_op;
+        viennacl::vector_base<NumericT>   * x;       // NULL for inner products and matrices
+        viennacl::scalar<NumericT>        * alpha;   // NULL for vector statements
+        fused_operand                       lhs;     // value assigned to x, or first operand of the inner product
+        fused_operand                       rhs;     // second operand of the inner product
+
+        // raw data of x:
+        NumericT                          * x_data;
+        long                                x_start;
+        long                                x_inc;
+        long                                x_row_inc;
+      };
+
+      /** @brief Executes the statements in a single pass over operands consisting of 'num_rows' rows of 'row_size' entries each.
+      *
+      * The statements are applied one after another to each block, thus the result is the same as if they were executed one after another,
+      * provided that all operands sharing memory refer to the same entries, and that no scalar operand is the result of one of the inner products.
+      * The raw data of the operands must have been set up, e.g. by bind_fused_program().
+      */
+      template <typename NumericT>
+      void execute_fused_statements(std::vector<fused_statement<NumericT> > const & statements, vcl_size_t num_rows, vcl_size_t row_size)
+      {
+        long const block_size = VIENNACL_SCHEDULER_FUSED_BLOCK_SIZE;
+        long rows           = static_cast<long>(num_rows);
+        long size           = static_cast<long>(row_size);
+        long blocks_per_row = (size + block_size - 1) / block_size;
+        long num_blocks     = rows * blocks_per_row;
+        long num_statements = static_cast<long>(statements.size());
+
+        std::size_t max_operands = 1;
+        std::size_t num_inner_products = 0;
+        for (std::size_t k = 0; k < statements.size(); ++k)
+        {
+          max_operands = std::max(max_operands, statements[k].program.data.size() + statements[k].program.instructions.size());
+          if (statements[k].alpha)
+            ++num_inner_products;
+        }
+
+        // partial results of the inner products for each block, summed up in a fixed order afterwards so that the result does not depend on the number of threads:
+        std::vector<NumericT> partial_results(static_cast<std::size_t>(num_blocks) * num_inner_products);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel if (rows * size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+        {
+          std::vector<NumericT>         buffer(max_operands * static_cast<std::size_t>(block_size));
+          std::vector<NumericT const *> blocks(max_operands);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp for
+#endif
+          for (long block = 0; block < num_blocks; ++block)
+          {
+            long row          = block / blocks_per_row;
+            long offset       = (block % blocks_per_row) * block_size;
+            long current_size = std::min(block_size, size - offset);
+            std::size_t inner_product_index = 0;
+
+            for (long k = 0; k < num_statements; ++k)
+            {
+              fused_statement<NumericT> const & fs = statements[static_cast<std::size_t>(k)];
+              std::size_t num_vectors = fs.program.data.size();
+              evaluate_fused_block(fs.program, row, offset, current_size, block_size, &(buffer[0]), &(blocks[0]));
+
+              if (fs.alpha)
+              {
+                NumericT const * a = fused_operand_block(fs.lhs, num_vectors, &(blocks[0]));
+                NumericT const * b = fused_operand_block(fs.rhs, num_vectors, &(blocks[0]));
+                NumericT temp = 0;
+                for (long i = 0; i < current_size; ++i)
+                  temp += a[i] * b[i];
+                partial_results[static_cast<std::size_t>(block) * num_inner_products + inner_product_index++] = temp;
+                continue;
+              }
+
+              NumericT const * result = fused_operand_block(fs.lhs, num_vectors, &(blocks[0]));
+              long       inc_x   = fs.x_inc;
+              NumericT * x_block = fs.x_data + fs.x_start + row * fs.x_row_inc + offset * inc_x;
+              if (inc_x == 1)
+              {
+                switch (fs.assign_op)
+                {
+                  case OPERATION_BINARY_ASSIGN_TYPE:
+                    for (long i = 0; i < current_size; ++i)
+                      x_block[i] = result[i];
+                    break;
+                  case OPERATION_BINARY_INPLACE_ADD_TYPE:
+                    for (long i = 0; i < current_size; ++i)
+                      x_block[i] += result[i];
+                    break;
+                  case OPERATION_BINARY_INPLACE_SUB_TYPE:
+                    for (long i = 0; i < current_size; ++i)
+                      x_block[i] -= result[i];
+                    break;
+                  default:
+                    break;
+                }
+              }
+              else
+              {
+                switch (fs.assign_op)
+                {
+                  case OPERATION_BINARY_ASSIGN_TYPE:
+                    for (long i = 0; i < current_size; ++i)
+                      x_block[i * inc_x] = result[i];
+                    break;
+                  case OPERATION_BINARY_INPLACE_ADD_TYPE:
+                    for (long i = 0; i < current_size; ++i)
+                      x_block[i * inc_x] += result[i];
+                    break;
+                  case OPERATION_BINARY_INPLACE_SUB_TYPE:
+                    for (long i = 0; i < current_size; ++i)
+                      x_block[i * inc_x] -= result[i];
+                    break;
+                  default:
+                    break;
+                }
+              }
+            }
+          }
+        }
+
+        // write the inner products in the order of the statements:
+        std::size_t inner_product_index = 0;
+        for (std::size_t k = 0; k < statements.size(); ++k)
+        {
+          if (!statements[k].alpha)
+            continue;
+
+          NumericT sum = 0;
+          for (long block = 0; block < num_blocks; ++block)
+            sum += partial_results[static_cast<std::size_t>(block) * num_inner_products + inner_product_index];
+          ++inner_product_index;
+
+          NumericT * alpha = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(*statements[k].alpha);
+          switch (statements[k].assign_op)
+          {
+            case OPERATION_BINARY_ASSIGN_TYPE:      *alpha  = sum; break;
+            case OPERATION_BINARY_INPLACE_ADD_TYPE: *alpha += sum; break;
+            case OPERATION_BINARY_INPLACE_SUB_TYPE: *alpha -= sum; break;
+            default: break;
+          }
+        }
+      }
+
+
+      inline viennacl::vector_base<float>  * fused_result_vector(lhs_rhs_element const & elem, float)  { return elem.vector_float; }
+      inline viennacl::vector_base<double> * fused_result_vector(lhs_rhs_element const & elem, double) { return elem.vector_double; }
+
+      inline viennacl::scalar<float>  * fused_result_scalar(lhs_rhs_element const & elem, float)  { return elem.scalar_float; }
+      inline viennacl::scalar<double> * fused_result_scalar(lhs_rhs_element const & elem, double) { return elem.scalar_double; }
+
+      /** @brief Returns the size of the first vector in the subexpression, zero if there is none */
+      inline vcl_size_t fused_vector_size(statement const & s, lhs_rhs_element const & elem)
+      {
+        if (elem.type_family == VECTOR_TYPE_FAMILY && elem.subtype == DENSE_VECTOR_TYPE)
+          return (elem.numeric_type == FLOAT_TYPE) ? elem.vector_float->size() : elem.vector_double->size();
+        if (elem.type_family != COMPOSITE_OPERATION_FAMILY)
+          return 0;
+
+        statement_node const & node = s.array()[elem.node_index];
+        vcl_size_t lhs_size = fused_vector_size(s, node.lhs);
+        if (lhs_size > 0 || node.op.type_family == OPERATION_UNARY_TYPE_FAMILY)
+          return lhs_size;
+        return fused_vector_size(s, node.rhs);
+      }
+
+      /** @brief Statements in main memory which are executed together in a single pass over their operands */
+      template <typename NumericT>
+      class fused_segment
+      {
+          struct array_view
+          {
+            array_view(void const * b, long s, long i, long r, bool w) : buffer(b), start(s), inc(i), row_inc(r), written(w) {}
+
+            void const * buffer;
+            long         start;
+            long         inc;
+            long         row_inc;
+            bool         written;
+          };
+
+        public:
+          fused_segment() : num_rows_(0), size_(0) {}
+
+          bool empty() const { return statements_.empty(); }
+          std::size_t size() const { return statements_.size(); }
+
+          /** @brief Appends the statement given by its root node if it can be executed together with the statements in the segment.
+          *
+          * Returns false without any changes to the segment if the statement cannot be fused at all, or not with the statements already in the segment.
+          */
+          bool add(statement const & s, statement_node const & root_node)
+          {
+            if (   root_node.op.type != OPERATION_BINARY_ASSIGN_TYPE
+                && root_node.op.type != OPERATION_BINARY_INPLACE_ADD_TYPE
+                && root_node.op.type != OPERATION_BINARY_INPLACE_SUB_TYPE)
+              return false;
+
+            if (root_node.lhs.numeric_type != statement_node_numeric_type(result_of::numeric_type_id<NumericT>::value))
+              return false;
+
+            fused_statement<NumericT> fs;
+            fs.assign_op = root_node.op.type;
+
+            vcl_size_t size = 0;
+            if (root_node.lhs.type_family == VECTOR_TYPE_FAMILY && root_node.lhs.subtype == DENSE_VECTOR_TYPE)
+            {
+              fs.x = fused_result_vector(root_node.lhs, NumericT());
+              if (viennacl::traits::handle(*fs.x).get_active_handle_id() != viennacl::MAIN_MEMORY)
+                return false;
+
+              size = fs.x->size();
+              if (   (!statements_.empty() && size != size_)
+                  || !compile_fused(s, root_node.rhs, size, fs.program, fs.lhs)
+                  || fs.lhs.type == fused_operand::SCALAR_OPERAND)
+                return false;
+            }
+            else if (root_node.lhs.type_family == SCALAR_TYPE_FAMILY && root_node.lhs.subtype == DEVICE_SCALAR_TYPE && root_node.rhs.type_family == COMPOSITE_OPERATION_FAMILY)
+            {
+              fs.alpha = fused_result_scalar(root_node.lhs, NumericT());
+              if (viennacl::traits::handle(*fs.alpha).get_active_handle_id() != viennacl::MAIN_MEMORY)
+                return false;
+
+              statement_node const & node = s.array()[root_node.rhs.node_index];
+              if (node.op.type != OPERATION_BINARY_INNER_PROD_TYPE)
+                return false;
+
+              size = fused_vector_size(s, node.lhs);
+              if (   size == 0
+                  || (!statements_.empty() && size != size_)
+                  || !compile_fused(s, node.lhs, size, fs.program, fs.lhs)
+                  || !compile_fused(s, node.rhs, size, fs.program, fs.rhs)
+                  || fs.lhs.type == fused_operand::SCALAR_OPERAND
+                  || fs.rhs.type == fused_operand::SCALAR_OPERAND)
+                return false;
+            }
+            else
+              return false;
+
+            bind_fused_program(fs.program);
+            if (fs.x)
+            {
+              fs.x_data  = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(*fs.x);
+              fs.x_start = static_cast<long>(viennacl::traits::start(*fs.x));
+              fs.x_inc   = static_cast<long>(viennacl::traits::stride(*fs.x));
+            }
+
+            return append(fs, 1, size);
+          }
+
+          /** @brief Appends a compiled statement, for which the raw data of all operands has been set up, if it can be executed together with the statements in the segment.
+          *
+          * All operands of the statement consist of 'num_rows' rows with 'row_size' entries each. Returns false without any changes to the segment if the statement cannot be appended.
+          */
+          bool append(fused_statement<NumericT> const & fs, vcl_size_t num_rows, vcl_size_t row_size)
+          {
+            if (!statements_.empty() && (num_rows != num_rows_ || row_size != size_))
+              return false;
+
+            // scalar operands are evaluated when the statement is added, hence they must not be computed by the segment:
+            for (std::size_t i=0; i<fs.program.scalar_operands.size(); ++i)
+            {
+              void const * scalar_object = fused_scalar_object(fs.program.scalar_operands[i]);
+              if (scalar_object && std::find(written_scalars_.begin(), written_scalars_.end(), scalar_object) != written_scalars_.end())
+                return false;
+            }
+
+            // a written operand must not share memory with operands referring to other entries, otherwise blocks are overwritten while they are still needed:
+            std::vector<array_view> views(views_);
+            for (std::size_t j=0; j<fs.program.data.size(); ++j)
+              if (!add_view(views, array_view(fs.program.data[j], fs.program.start[j], fs.program.inc[j], fs.program.row_inc[j], false)))
+                return false;
+            if (!fs.alpha && !add_view(views, array_view(fs.x_data, fs.x_start, fs.x_inc, fs.x_row_inc, true)))
+              return false;
+
+            views_.swap(views);
+            if (fs.alpha)
+              written_scalars_.push_back(fs.alpha);
+            num_rows_ = num_rows;
+            size_ = row_size;
+            statements_.push_back(fs);
+            return true;
+          }
+
+          /** @brief Executes all statements of the segment */
+          void execute() const
+          {
+            if (!statements_.empty())
+              execute_fused_statements(statements_, num_rows_, size_);
+          }
+
+          /** @brief Returns true if all objects of the statements added via add() still reside in main memory at the same location and have the same size, so that the segment can be executed again */
+          bool valid() const
+          {
+            for (std::size_t k=0; k<statements_.size(); ++k)
+            {
+              fused_statement<NumericT> const & fs = statements_[k];
+              if (!is_bound_fused_program(fs.program, size_))
+                return false;
+
+              if (fs.x && (   viennacl::traits::handle(*fs.x).get_active_handle_id() != viennacl::MAIN_MEMORY
+                           || fs.x->size() != size_
+                           || viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(*fs.x) != fs.x_data
+                           || static_cast<long>(viennacl::traits::start(*fs.x)) != fs.x_start
+                           || static_cast<long>(viennacl::traits::stride(*fs.x)) != fs.x_inc))
+                return false;
+
+              if (fs.alpha && viennacl::traits::handle(*fs.alpha).get_active_handle_id() != viennacl::MAIN_MEMORY)
+                return false;
+            }
+            return true;
+          }
+
+          /** @brief Reloads the values of the device scalars used by the statements, which are otherwise taken when a statement is added. Required before executing a valid segment again. */
+          void load_scalars()
+          {
+            for (std::size_t k=0; k<statements_.size(); ++k)
+              load_fused_scalars(statements_[k].program);
+          }
+
+          void clear()
+          {
+            statements_.clear();
+            views_.clear();
+            written_scalars_.clear();
+            num_rows_ = 0;
+            size_ = 0;
+          }
+
+        private:
+          static bool add_view(std::vector<array_view> & views, array_view const & v)
+          {
+            std::size_t same_view = views.size();
+            for (std::size_t i=0; i<views.size(); ++i)
+            {
+              if (views[i].buffer != v.buffer)
+                continue;
+
+              if (views[i].start == v.start && views[i].inc == v.inc && views[i].row_inc == v.row_inc)
+                same_view = i;
+              else if (views[i].written || v.written)
+                return false;
+            }
+
+            if (same_view < views.size())
+              views[same_view].written = views[same_view].written || v.written;
+            else
+              views.push_back(v);
+            return true;
+          }
+
+          std::vector<fused_statement<NumericT> >  statements_;
+          std::vector<array_view>                  views_;
+          std::vector<void const *>                written_scalars_;
+          vcl_size_t                               num_rows_;
+          vcl_size_t                               size_;
+      };
+
+
+      /** @brief Returns true if the subexpression is a vector scaled by a scalar (or a plain operand) */
+      inline bool is_scaled_operand(statement const & s, lhs_rhs_element const & elem)
+      {
+        if (elem.type_family != COMPOSITE_OPERATION_FAMILY)
+          return true;
+
+        statement_node const & node = s.array()[elem.node_index];
+        return    (node.op.type == OPERATION_BINARY_MULT_TYPE || node.op.type == OPERATION_BINARY_DIV_TYPE)
+               && node.lhs.type_family != COMPOSITE_OPERATION_FAMILY
+               && node.rhs.type_family != COMPOSITE_OPERATION_FAMILY;
+      }
+
+      /** @brief Returns true if the decomposition of the statement into backend operations requires temporaries.
+      *
+      * x = op(y), x = op(y, z), x = a*y +- b*z, and alpha = inner_prod(y, z) are computed by a single backend kernel anyway, which is faster than a fused program for small vectors.
+      */
+      inline bool requires_temporaries(statement const & s, statement_node const & root_node)
+      {
+        if (root_node.rhs.type_family != COMPOSITE_OPERATION_FAMILY)
+          return false;
+
+        statement_node const & node = s.array()[root_node.rhs.node_index];
+
+        if (node.op.type == OPERATION_BINARY_ADD_TYPE || node.op.type == OPERATION_BINARY_SUB_TYPE)
+          return !is_scaled_operand(s, node.lhs) || !is_scaled_operand(s, node.rhs);
+
+        return    node.lhs.type_family == COMPOSITE_OPERATION_FAMILY
+               || (node.op.type_family != OPERATION_UNARY_TYPE_FAMILY && node.rhs.type_family == COMPOSITE_OPERATION_FAMILY);
+      }
+
+      /** @brief Executes x = RHS (also +=, -=) or alpha = inner_prod(RHS1, RHS2) (also +=, -=) in a single pass if all operands reside in main memory and the RHS consist of element-wise operations only.
+      *
+      * Returns false without any computation if the statement cannot be fused, or if fusion offers no benefit.
+      */
+      inline bool execute_fused(statement const & s, statement_node const & root_node)
+      {
+        if (root_node.lhs.type_family != VECTOR_TYPE_FAMILY && root_node.lhs.type_family != SCALAR_TYPE_FAMILY)
+          return false;
+
+        if (!requires_temporaries(s, root_node))
+          return false;
+
+        switch (root_node.lhs.numeric_type)
+        {
+          case FLOAT_TYPE:
+          {
+            fused_segment<float> segment;
+            if (!segment.add(s, root_node))
+              return false;
+            segment.execute();
+            return true;
+          }
+          case DOUBLE_TYPE:
+          {
+            fused_segment<double> segment;
+            if (!segment.add(s, root_node))
+              return false;
+            segment.execute();
+            return true;
+          }
+          default:
+            return false;
+        }
+      }
+
+    } // namespace detail
+  } // namespace scheduler
+} // namespace viennacl
+
+#endif
+
@@ -34,6 +34,7 @@
 #include "viennacl/coordinate_matrix.hpp"
 #include "viennacl/ell_matrix.hpp"
 #include "viennacl/hyb_matrix.hpp"
+#include "viennacl/sliced_ell_matrix.hpp"
 
 namespace viennacl
 {
@@ -381,6 +382,20 @@ namespace viennacl
             throw statement_not_supported_exception("Invalid numeric type in matrix-{matrix,vector} multiplication");
           }
         }
+        else if (A.subtype == SLICED_ELL_MATRIX_TYPE)
+        {
+          switch (A.numeric_type)
+          {
+          case FLOAT_TYPE:
+            viennacl::linalg::prod_impl(*A.sliced_ell_matrix_float, *x.vector_float, *result.vector_float);
+            break;
+          case DOUBLE_TYPE:
+            viennacl::linalg::prod_impl(*A.sliced_ell_matrix_double, *x.vector_double, *result.vector_double);
+            break;
+          default:
+            throw statement_not_supported_exception("Invalid numeric type in matrix-{matrix,vector} multiplication");
+          }
+        }
         else
         {
           std::cout << "A.subtype: " << A.subtype << std::endl;
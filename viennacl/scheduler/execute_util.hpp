@@ -24,13 +24,21 @@
 */
 
 #include <assert.h>
+#include <vector>
 
 #include "viennacl/forwards.h"
+#include "viennacl/context.hpp"
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
+#include "viennacl/traits/handle.hpp"
 #include "viennacl/scheduler/forwards.h"
 
+/** @brief Maximum number of vector and scalar temporaries per numeric type kept for reuse by the scheduler */
+#ifndef VIENNACL_SCHEDULER_TEMPORARY_POOL_SIZE
+  #define VIENNACL_SCHEDULER_TEMPORARY_POOL_SIZE  16
+#endif
+
 namespace viennacl
 {
   namespace scheduler
@@ -97,6 +105,126 @@ namespace viennacl
         throw statement_not_supported_exception("Cannot convert to double");
       }
 
+      /////////////////// Pool of temporaries ///////////////////////
+
+      /** @brief Returns true if the two contexts refer to the same memory domain (and the same OpenCL context, if applicable) */
+      inline bool same_context(viennacl::context const & ctx1, viennacl::context const & ctx2)
+      {
+        if (ctx1.memory_type() != ctx2.memory_type())
+          return false;
+#ifdef VIENNACL_WITH_OPENCL
+        if (ctx1.memory_type() == viennacl::OPENCL_MEMORY)
+          return &(ctx1.opencl_context()) == &(ctx2.opencl_context());
+#endif
+        return true;
+      }
+
+      /** @brief Keeps the vector and scalar temporaries of executed statements for reuse, so that repeated execution of a statement does not allocate (and, for OpenCL, create buffers) over and over again.
+      *
+      * Temporaries are always fully overwritten by the statement they are created for, hence their content is irrelevant.
+      * At most VIENNACL_SCHEDULER_TEMPORARY_POOL_SIZE objects of each kind are kept, all others are destroyed when released.
+      */
+      template <typename NumericT>
+      class temporary_pool
+      {
+        public:
+          ~temporary_pool()
+          {
+            for (std::size_t i=0; i<vectors_.size(); ++i)
+              delete vectors_[i];
+            for (std::size_t i=0; i<scalars_.size(); ++i)
+              delete scalars_[i];
+          }
+
+          /** @brief Returns a vector of the given size in the given context. Ownership is passed to the caller until the vector is returned via release(). */
+          viennacl::vector<NumericT> * acquire_vector(vcl_size_t size, viennacl::context const & ctx)
+          {
+            viennacl::vector<NumericT> * result = NULL;
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical (viennacl_scheduler_temporary_pool)
+#endif
+            {
+              for (std::size_t i=0; i<vectors_.size(); ++i)
+              {
+                if (vectors_[i]->size() == size && same_context(viennacl::traits::context(*vectors_[i]), ctx))
+                {
+                  result = vectors_[i];
+                  vectors_.erase(vectors_.begin() + static_cast<long>(i));
+                  break;
+                }
+              }
+            }
+
+            return result ? result : new viennacl::vector<NumericT>(size, ctx);
+          }
+
+          /** @brief Returns a scalar in the current default context. Ownership is passed to the caller until the scalar is returned via release(). */
+          viennacl::scalar<NumericT> * acquire_scalar()
+          {
+            viennacl::scalar<NumericT> * result = NULL;
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical (viennacl_scheduler_temporary_pool)
+#endif
+            {
+              viennacl::context ctx;
+              for (std::size_t i=0; i<scalars_.size(); ++i)
+              {
+                if (same_context(viennacl::traits::context(*scalars_[i]), ctx))
+                {
+                  result = scalars_[i];
+                  scalars_.erase(scalars_.begin() + static_cast<long>(i));
+                  break;
+                }
+              }
+            }
+
+            return result ? result : new viennacl::scalar<NumericT>(0);
+          }
+
+          void release(viennacl::vector_base<NumericT> * vec)
+          {
+            viennacl::vector<NumericT> * v = static_cast<viennacl::vector<NumericT> *>(vec);
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical (viennacl_scheduler_temporary_pool)
+#endif
+            {
+              if (vectors_.size() < VIENNACL_SCHEDULER_TEMPORARY_POOL_SIZE)
+              {
+                vectors_.push_back(v);
+                v = NULL;
+              }
+            }
+            delete v;
+          }
+
+          void release(viennacl::scalar<NumericT> * s)
+          {
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical (viennacl_scheduler_temporary_pool)
+#endif
+            {
+              if (scalars_.size() < VIENNACL_SCHEDULER_TEMPORARY_POOL_SIZE)
+              {
+                scalars_.push_back(s);
+                s = NULL;
+              }
+            }
+            delete s;
+          }
+
+        private:
+          std::vector<viennacl::vector<NumericT> *> vectors_;
+          std::vector<viennacl::scalar<NumericT> *> scalars_;
+      };
+
+      /** @brief Returns the pool of temporaries for the numeric type. Created on first use, hence destroyed before the memory backends. */
+      template <typename NumericT>
+      temporary_pool<NumericT> & get_temporary_pool()
+      {
+        static temporary_pool<NumericT> pool;
+        return pool;
+      }
+
       /////////////////// Create/Destory temporary vector ///////////////////////
 
       inline void new_element(lhs_rhs_element & new_elem, lhs_rhs_element const & old_element)
@@ -111,10 +239,10 @@ namespace viennacl
           switch (new_elem.numeric_type)
           {
             case FLOAT_TYPE:
-              new_elem.scalar_float = new viennacl::scalar<float>();
+              new_elem.scalar_float = get_temporary_pool<float>().acquire_scalar();
               return;
             case DOUBLE_TYPE:
-              new_elem.scalar_double = new viennacl::scalar<double>();
+              new_elem.scalar_double = get_temporary_pool<double>().acquire_scalar();
               return;
             default:
               throw statement_not_supported_exception("Invalid vector type for vector construction");
@@ -127,10 +255,10 @@ namespace viennacl
           switch (new_elem.numeric_type)
           {
             case FLOAT_TYPE:
-              new_elem.vector_float = new viennacl::vector<float>((old_element.vector_float)->size());
+              new_elem.vector_float = get_temporary_pool<float>().acquire_vector((old_element.vector_float)->size(), viennacl::traits::context(*old_element.vector_float));
               return;
             case DOUBLE_TYPE:
-              new_elem.vector_double = new viennacl::vector<double>((old_element.vector_float)->size());
+              new_elem.vector_double = get_temporary_pool<double>().acquire_vector((old_element.vector_double)->size(), viennacl::traits::context(*old_element.vector_double));
               return;
             default:
               throw statement_not_supported_exception("Invalid vector type for vector construction");
@@ -183,10 +311,10 @@ namespace viennacl
           switch (elem.numeric_type)
           {
             case FLOAT_TYPE:
-              delete elem.scalar_float;
+              get_temporary_pool<float>().release(elem.scalar_float);
               return;
             case DOUBLE_TYPE:
-              delete elem.scalar_double;
+              get_temporary_pool<double>().release(elem.scalar_double);
               return;
             default:
               throw statement_not_supported_exception("Invalid vector type for vector destruction");
@@ -197,10 +325,10 @@ namespace viennacl
           switch (elem.numeric_type)
           {
             case FLOAT_TYPE:
-              delete elem.vector_float;
+              get_temporary_pool<float>().release(elem.vector_float);
               return;
             case DOUBLE_TYPE:
-              delete elem.vector_double;
+              get_temporary_pool<double>().release(elem.vector_double);
               return;
             default:
               throw statement_not_supported_exception("Invalid vector type for vector destruction");
@@ -188,7 +188,8 @@ namespace viennacl
       COMPRESSED_MATRIX_TYPE,
       COORDINATE_MATRIX_TYPE,
       ELL_MATRIX_TYPE,
-      HYB_MATRIX_TYPE
+      HYB_MATRIX_TYPE,
+      SLICED_ELL_MATRIX_TYPE
 
       // other matrix types to be added here
     };
@@ -389,6 +390,9 @@ namespace viennacl
         //viennacl::hyb_matrix<double>   *hyb_matrix_ulong;
         viennacl::hyb_matrix<float>    *hyb_matrix_float;
         viennacl::hyb_matrix<double>   *hyb_matrix_double;
+
+        viennacl::sliced_ell_matrix<float>    *sliced_ell_matrix_float;
+        viennacl::sliced_ell_matrix<double>   *sliced_ell_matrix_double;
       };
     };
 
@@ -479,6 +483,9 @@ namespace viennacl
         void assign_element(lhs_rhs_element & elem, viennacl::hyb_matrix<float>  const & m) { elem.hyb_matrix_float  = const_cast<viennacl::hyb_matrix<float>  *>(&m); }
         void assign_element(lhs_rhs_element & elem, viennacl::hyb_matrix<double> const & m) { elem.hyb_matrix_double = const_cast<viennacl::hyb_matrix<double> *>(&m); }
 
+        void assign_element(lhs_rhs_element & elem, viennacl::sliced_ell_matrix<float>  const & m) { elem.sliced_ell_matrix_float  = const_cast<viennacl::sliced_ell_matrix<float>  *>(&m); }
+        void assign_element(lhs_rhs_element & elem, viennacl::sliced_ell_matrix<double> const & m) { elem.sliced_ell_matrix_double = const_cast<viennacl::sliced_ell_matrix<double> *>(&m); }
+
         //////////// Tree leaves (terminals) ////////////////////
 
         std::size_t add_element(std::size_t       next_free,
@@ -588,6 +595,18 @@ namespace viennacl
           return next_free;
         }
 
+        template <typename T>
+        std::size_t add_element(std::size_t next_free,
+                                lhs_rhs_element            & elem,
+                                viennacl::sliced_ell_matrix<T> const & t)
+        {
+          elem.type_family  = MATRIX_TYPE_FAMILY;
+          elem.subtype      = SLICED_ELL_MATRIX_TYPE;
+          elem.numeric_type = statement_node_numeric_type(result_of::numeric_type_id<T>::value);
+          assign_element(elem, t);
+          return next_free;
+        }
+
 
         //////////// Tree nodes (non-terminals) ////////////////////
 
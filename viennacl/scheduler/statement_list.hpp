@@ -0,0 +1,791 @@
+#ifndef VIENNACL_SCHEDULER_STATEMENT_LIST_HPP
+#define VIENNACL_SCHEDULER_STATEMENT_LIST_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/scheduler/statement_list.hpp
+    @brief Provides a list of statements which are executed together, such as the BLAS level 1 operations of one iteration of an iterative solver.
+
+    The statements are sorted into levels by their read/write dependencies.
+    In main memory, element-wise vector operations and inner products of consecutive levels are executed together in a single pass over the vectors.
+    For all other statements, inner products sharing a common vector within a level are computed in a single pass,
+    and small independent statements in main memory are executed concurrently.
+*/
+
+#include <vector>
+#include <string>
+#include <new>
+#include <stdexcept>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/vector_operations.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/scheduler/forwards.h"
+#include "viennacl/scheduler/execute.hpp"
+#include "viennacl/scheduler/execute_util.hpp"
+#include "viennacl/scheduler/execute_fused.hpp"
+
+namespace viennacl
+{
+  namespace scheduler
+  {
+    namespace detail
+    {
+      /** @brief A set of statements executed together: Either a single statement or inner products with a common vector */
+      struct execution_unit
+      {
+        execution_unit() : merged_inner_products(false), size(0), main_memory(true) {}
+
+        std::vector<std::size_t>  statements;              // indices of the statements in the list
+        std::vector<bool>         common_is_lhs;           // for merged inner products: whether the common vector is the first operand
+        bool                      merged_inner_products;
+        vcl_size_t                size;                    // largest number of entries of an operand
+        bool                      main_memory;             // all operands reside in main memory
+      };
+
+      typedef std::vector<std::vector<execution_unit> >   execution_schedule;
+
+
+      /** @brief Returns the address of the buffer referred to by the handle, or NULL if the buffer is not allocated */
+      inline void const * buffer_key(viennacl::backend::mem_handle const & h)
+      {
+        switch (h.get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            return h.ram_handle().get();
+#ifdef VIENNACL_WITH_OPENCL
+          case viennacl::OPENCL_MEMORY:
+            return h.opencl_handle().get();
+#endif
+#ifdef VIENNACL_WITH_CUDA
+          case viennacl::CUDA_MEMORY:
+            return h.cuda_handle().get();
+#endif
+          default:
+            return NULL;
+        }
+      }
+
+      /** @brief Returns the memory handle of a scalar, a dense vector, or a dense matrix in the statement, or NULL for all other elements */
+      inline viennacl::backend::mem_handle const * element_handle(lhs_rhs_element const & elem)
+      {
+        if (elem.type_family == SCALAR_TYPE_FAMILY && elem.subtype == DEVICE_SCALAR_TYPE)
+        {
+          switch (elem.numeric_type)
+          {
+            case FLOAT_TYPE:  return &(elem.scalar_float->handle());
+            case DOUBLE_TYPE: return &(elem.scalar_double->handle());
+            default:          return NULL;
+          }
+        }
+        else if (elem.type_family == VECTOR_TYPE_FAMILY && elem.subtype == DENSE_VECTOR_TYPE)
+        {
+          switch (elem.numeric_type)
+          {
+            case FLOAT_TYPE:  return &(elem.vector_float->handle());
+            case DOUBLE_TYPE: return &(elem.vector_double->handle());
+            default:          return NULL;
+          }
+        }
+        else if (elem.type_family == MATRIX_TYPE_FAMILY && elem.subtype == DENSE_ROW_MATRIX_TYPE)
+        {
+          switch (elem.numeric_type)
+          {
+            case FLOAT_TYPE:  return &(elem.matrix_row_float->handle());
+            case DOUBLE_TYPE: return &(elem.matrix_row_double->handle());
+            default:          return NULL;
+          }
+        }
+        else if (elem.type_family == MATRIX_TYPE_FAMILY && elem.subtype == DENSE_COL_MATRIX_TYPE)
+        {
+          switch (elem.numeric_type)
+          {
+            case FLOAT_TYPE:  return &(elem.matrix_col_float->handle());
+            case DOUBLE_TYPE: return &(elem.matrix_col_double->handle());
+            default:          return NULL;
+          }
+        }
+        return NULL;
+      }
+
+      /** @brief Returns the number of entries of a dense vector or matrix in the statement, zero for all other elements */
+      inline vcl_size_t element_size(lhs_rhs_element const & elem)
+      {
+        if (elem.type_family == VECTOR_TYPE_FAMILY && elem.subtype == DENSE_VECTOR_TYPE)
+        {
+          switch (elem.numeric_type)
+          {
+            case FLOAT_TYPE:  return elem.vector_float->size();
+            case DOUBLE_TYPE: return elem.vector_double->size();
+            default:          return 0;
+          }
+        }
+        else if (elem.type_family == MATRIX_TYPE_FAMILY && elem.subtype == DENSE_ROW_MATRIX_TYPE)
+        {
+          switch (elem.numeric_type)
+          {
+            case FLOAT_TYPE:  return elem.matrix_row_float->size1() * elem.matrix_row_float->size2();
+            case DOUBLE_TYPE: return elem.matrix_row_double->size1() * elem.matrix_row_double->size2();
+            default:          return 0;
+          }
+        }
+        else if (elem.type_family == MATRIX_TYPE_FAMILY && elem.subtype == DENSE_COL_MATRIX_TYPE)
+        {
+          switch (elem.numeric_type)
+          {
+            case FLOAT_TYPE:  return elem.matrix_col_float->size1() * elem.matrix_col_float->size2();
+            case DOUBLE_TYPE: return elem.matrix_col_double->size1() * elem.matrix_col_double->size2();
+            default:          return 0;
+          }
+        }
+        return 0;
+      }
+
+      /** @brief Memory accessed by a statement */
+      struct statement_access
+      {
+        statement_access() : write(NULL), size(0), main_memory(true) {}
+
+        std::vector<void const *>  reads;
+        void const *               write;        // NULL if the written object is not known, in which case the statement depends on all others
+        vcl_size_t                 size;
+        bool                       main_memory;
+      };
+
+      /** @brief Collects the buffers read by the subexpression 'elem' */
+      inline void collect_reads(statement const & s, lhs_rhs_element const & elem, statement_access & access)
+      {
+        if (elem.type_family == COMPOSITE_OPERATION_FAMILY)
+        {
+          statement_node const & node = s.array()[elem.node_index];
+          collect_reads(s, node.lhs, access);
+          if (node.op.type_family != OPERATION_UNARY_TYPE_FAMILY)
+            collect_reads(s, node.rhs, access);
+          return;
+        }
+
+        if (elem.type_family == SCALAR_TYPE_FAMILY && elem.subtype == HOST_SCALAR_TYPE)
+          return;
+
+        access.size = std::max(access.size, element_size(elem));
+
+        viennacl::backend::mem_handle const * h = element_handle(elem);
+        if (!h)
+        {
+          access.main_memory = false;  // sparse matrices, implicit vectors, etc.: leave them to the regular execution
+          return;
+        }
+
+        if (h->get_active_handle_id() != viennacl::MAIN_MEMORY)
+          access.main_memory = false;
+        if (buffer_key(*h))
+          access.reads.push_back(buffer_key(*h));
+      }
+
+      inline statement_access get_statement_access(statement const & s)
+      {
+        statement_access access;
+        statement_node const & root_node = s.array()[s.root()];
+
+        viennacl::backend::mem_handle const * h = element_handle(root_node.lhs);
+        if (h)
+        {
+          access.write = buffer_key(*h);
+          access.main_memory = (h->get_active_handle_id() == viennacl::MAIN_MEMORY);
+        }
+        else
+          access.main_memory = false;
+        access.size = element_size(root_node.lhs);
+
+        collect_reads(s, root_node.rhs, access);
+        return access;
+      }
+
+      /** @brief Returns true if the two statements cannot be reordered or executed concurrently */
+      inline bool depends_on(statement_access const & a, statement_access const & b)
+      {
+        if (!a.write || !b.write)
+          return true;
+        if (a.write == b.write)
+          return true;
+        return    std::find(a.reads.begin(), a.reads.end(), b.write) != a.reads.end()
+               || std::find(b.reads.begin(), b.reads.end(), a.write) != b.reads.end();
+      }
+
+      /** @brief Returns true if the statement is 's = inner_prod(x, y)' with a device scalar s in the same memory domain as the dense vectors x and y */
+      inline bool is_mergeable_inner_product(statement const & s)
+      {
+        statement_node const & root_node = s.array()[s.root()];
+        if (   root_node.op.type != OPERATION_BINARY_ASSIGN_TYPE
+            || root_node.lhs.type_family != SCALAR_TYPE_FAMILY
+            || root_node.lhs.subtype != DEVICE_SCALAR_TYPE
+            || root_node.rhs.type_family != COMPOSITE_OPERATION_FAMILY)
+          return false;
+
+        statement_node const & node = s.array()[root_node.rhs.node_index];
+        if (   node.op.type != OPERATION_BINARY_INNER_PROD_TYPE
+            || node.lhs.type_family != VECTOR_TYPE_FAMILY || node.lhs.subtype != DENSE_VECTOR_TYPE
+            || node.rhs.type_family != VECTOR_TYPE_FAMILY || node.rhs.subtype != DENSE_VECTOR_TYPE
+            || node.lhs.numeric_type != root_node.lhs.numeric_type
+            || node.rhs.numeric_type != root_node.lhs.numeric_type)
+          return false;
+
+        viennacl::backend::mem_handle const * h = element_handle(root_node.lhs);
+        return h && buffer_key(*h) && h->get_active_handle_id() == element_handle(node.lhs)->get_active_handle_id();
+      }
+
+      /** @brief Returns the address of the vector object, used for identifying a common vector of inner products */
+      inline void const * vector_object(lhs_rhs_element const & elem)
+      {
+        return (elem.numeric_type == FLOAT_TYPE) ? static_cast<void const *>(elem.vector_float) : static_cast<void const *>(elem.vector_double);
+      }
+
+      /** @brief Sorts the statements into levels such that each statement only depends on statements of previous levels, then groups inner products with a common vector within each level */
+      inline void build_schedule(std::vector<statement> const & statements, execution_schedule & schedule)
+      {
+        std::size_t num_statements = statements.size();
+
+        std::vector<statement_access> accesses(num_statements);
+        std::vector<std::size_t>      levels(num_statements);
+        std::size_t num_levels = 0;
+        for (std::size_t i=0; i<num_statements; ++i)
+        {
+          accesses[i] = get_statement_access(statements[i]);
+
+          levels[i] = 0;
+          for (std::size_t j=0; j<i; ++j)
+            if (levels[j] + 1 > levels[i] && depends_on(accesses[i], accesses[j]))
+              levels[i] = levels[j] + 1;
+          num_levels = std::max(num_levels, levels[i] + 1);
+        }
+
+        schedule.clear();
+        schedule.resize(num_levels);
+
+        std::vector<bool> assigned(num_statements, false);
+        for (std::size_t i=0; i<num_statements; ++i)
+        {
+          if (assigned[i])
+            continue;
+
+          execution_unit unit;
+          unit.statements.push_back(i);
+          unit.size        = accesses[i].size;
+          unit.main_memory = accesses[i].main_memory;
+          assigned[i] = true;
+
+          if (is_mergeable_inner_product(statements[i]))
+          {
+            statement_node const & node = statements[i].array()[statements[i].array()[statements[i].root()].rhs.node_index];
+
+            // try both operands of the first inner product as the common vector, keep the one shared by more inner products of the level:
+            for (std::size_t side = 0; side < 2; ++side)
+            {
+              lhs_rhs_element const & common = (side == 0) ? node.lhs : node.rhs;
+
+              std::vector<std::size_t> members(1, i);
+              std::vector<bool>        common_is_lhs(1, side == 0);
+              for (std::size_t j=i+1; j<num_statements; ++j)
+              {
+                if (assigned[j] || levels[j] != levels[i] || !is_mergeable_inner_product(statements[j]))
+                  continue;
+
+                statement_node const & other = statements[j].array()[statements[j].array()[statements[j].root()].rhs.node_index];
+                if (other.lhs.numeric_type != common.numeric_type)
+                  continue;
+                if (vector_object(other.lhs) == vector_object(common))
+                {
+                  members.push_back(j);
+                  common_is_lhs.push_back(true);
+                }
+                else if (vector_object(other.rhs) == vector_object(common))
+                {
+                  members.push_back(j);
+                  common_is_lhs.push_back(false);
+                }
+              }
+
+              if (members.size() > std::max<std::size_t>(unit.statements.size(), 1))
+              {
+                unit.statements    = members;
+                unit.common_is_lhs = common_is_lhs;
+              }
+            }
+
+            if (unit.statements.size() > 1)
+            {
+              unit.merged_inner_products = true;
+              for (std::size_t k=0; k<unit.statements.size(); ++k)
+              {
+                assigned[unit.statements[k]] = true;
+                unit.main_memory = unit.main_memory && accesses[unit.statements[k]].main_memory;
+              }
+            }
+          }
+
+          schedule[levels[i]].push_back(unit);
+        }
+      }
+
+
+      inline viennacl::vector_base<float>  const * inner_product_operand(lhs_rhs_element const & elem, float)  { return elem.vector_float; }
+      inline viennacl::vector_base<double> const * inner_product_operand(lhs_rhs_element const & elem, double) { return elem.vector_double; }
+
+      inline viennacl::scalar<float>  * inner_product_result(lhs_rhs_element const & elem, float)  { return elem.scalar_float; }
+      inline viennacl::scalar<double> * inner_product_result(lhs_rhs_element const & elem, double) { return elem.scalar_double; }
+
+      /** @brief Computes the inner products of a common vector with all other vectors of the unit in a single pass and writes them to the respective scalars */
+      template <typename NumericT>
+      void execute_merged_inner_products(std::vector<statement> const & statements, execution_unit const & unit)
+      {
+        viennacl::vector_base<NumericT> const * x = NULL;
+        std::vector<viennacl::vector_base<NumericT> const *> y(unit.statements.size());
+        for (std::size_t k=0; k<unit.statements.size(); ++k)
+        {
+          statement const & s = statements[unit.statements[k]];
+          statement_node const & node = s.array()[s.array()[s.root()].rhs.node_index];
+          x    = inner_product_operand(unit.common_is_lhs[k] ? node.lhs : node.rhs, NumericT());
+          y[k] = inner_product_operand(unit.common_is_lhs[k] ? node.rhs : node.lhs, NumericT());
+        }
+
+        viennacl::vector<NumericT> * result = get_temporary_pool<NumericT>().acquire_vector(y.size(), viennacl::traits::context(*x));
+        try
+        {
+          viennacl::linalg::inner_prod_impl(*x, viennacl::vector_tuple<NumericT>(y), *result);
+
+          for (std::size_t k=0; k<unit.statements.size(); ++k)
+          {
+            statement const & s = statements[unit.statements[k]];
+            viennacl::scalar<NumericT> * alpha = inner_product_result(s.array()[s.root()].lhs, NumericT());
+            viennacl::backend::memory_copy(result->handle(), alpha->handle(), sizeof(NumericT) * k, 0, sizeof(NumericT));
+          }
+        }
+        catch (...)
+        {
+          get_temporary_pool<NumericT>().release(result);
+          throw;
+        }
+        get_temporary_pool<NumericT>().release(result);
+      }
+
+      inline void execute_unit(std::vector<statement> const & statements, execution_unit const & unit)
+      {
+        if (unit.merged_inner_products)
+        {
+          statement const & s = statements[unit.statements[0]];
+          switch (s.array()[s.root()].lhs.numeric_type)
+          {
+            case FLOAT_TYPE:
+              execute_merged_inner_products<float>(statements, unit);
+              return;
+            case DOUBLE_TYPE:
+              execute_merged_inner_products<double>(statements, unit);
+              return;
+            default:
+              throw statement_not_supported_exception("Invalid numeric type in inner products");
+          }
+        }
+
+        viennacl::scheduler::execute(statements[unit.statements[0]]);
+      }
+
+      /** @brief Returns true if the units of the level should be executed concurrently: They reside in main memory and are too small for being parallelized individually, but large enough in total to outweigh the cost of a parallel region. */
+      inline bool execute_concurrently(std::vector<execution_unit> const & level)
+      {
+#ifdef VIENNACL_WITH_OPENMP
+        if (level.size() < 2)
+          return false;
+
+        vcl_size_t total_size = 0;
+        for (std::size_t i=0; i<level.size(); ++i)
+        {
+          if (!level[i].main_memory || level[i].size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+            return false;
+          total_size += level[i].size;
+        }
+        return total_size > VIENNACL_OPENMP_VECTOR_MIN_SIZE;
+#else
+        (void)level;
+        return false;
+#endif
+      }
+
+      /** @brief Keeps a copy of the exception thrown by the first failing unit of a level executed in a parallel region, which exceptions must not leave, for rethrowing it after the region */
+      class unit_exception
+      {
+          enum exception_type
+          {
+            NO_EXCEPTION,
+            STATEMENT_NOT_SUPPORTED_EXCEPTION,
+            MEMORY_EXCEPTION,
+            BAD_ALLOC_EXCEPTION,
+            STD_EXCEPTION,
+            UNKNOWN_EXCEPTION
+          };
+
+        public:
+          unit_exception() : type_(NO_EXCEPTION), unit_(0) {}
+
+          void record(long unit, statement_not_supported_exception const & e) { if (replaces(unit)) { type_ = STATEMENT_NOT_SUPPORTED_EXCEPTION; statement_exception_ = e; } }
+          void record(long unit, viennacl::memory_exception const & e)        { if (replaces(unit)) { type_ = MEMORY_EXCEPTION; memory_exception_ = e; } }
+          void record(long unit, std::bad_alloc const &)                      { if (replaces(unit)) { type_ = BAD_ALLOC_EXCEPTION; } }
+          void record(long unit, std::exception const & e)                    { if (replaces(unit)) { type_ = STD_EXCEPTION; message_ = e.what(); } }
+          void record(long unit)                                              { if (replaces(unit)) { type_ = UNKNOWN_EXCEPTION; } }
+
+          /** @brief Throws the recorded exception, if any. Exceptions other than the ones thrown by ViennaCL and std::bad_alloc are rethrown as std::runtime_error. */
+          void rethrow() const
+          {
+            switch (type_)
+            {
+              case NO_EXCEPTION:                      return;
+              case STATEMENT_NOT_SUPPORTED_EXCEPTION: throw statement_exception_;
+              case MEMORY_EXCEPTION:                  throw memory_exception_;
+              case BAD_ALLOC_EXCEPTION:               throw std::bad_alloc();
+              case STD_EXCEPTION:                     throw std::runtime_error(message_);
+              default:                                throw std::runtime_error("ViennaCL: Unknown exception while executing a statement list");
+            }
+          }
+
+        private:
+          /** @brief Returns true if no exception of a unit preceding 'unit' has been recorded, in which case the exception of 'unit' is kept */
+          bool replaces(long unit)
+          {
+            if (type_ != NO_EXCEPTION && unit_ < unit)
+              return false;
+            unit_ = unit;
+            return true;
+          }
+
+          exception_type                     type_;
+          long                               unit_;
+          statement_not_supported_exception  statement_exception_;
+          viennacl::memory_exception         memory_exception_;
+          std::string                        message_;
+      };
+
+      /** @brief Executes independent units, concurrently if beneficial. If units fail in a concurrent execution, the others are still carried out and the exception of the first failing unit is thrown afterwards. */
+      inline void execute_level(std::vector<statement> const & statements, std::vector<execution_unit> const & level)
+      {
+#ifdef VIENNACL_WITH_OPENMP
+        if (execute_concurrently(level))
+        {
+          long num_units = static_cast<long>(level.size());
+          unit_exception failure;
+
+          #pragma omp parallel for schedule(dynamic, 1)
+          for (long j = 0; j < num_units; ++j)
+          {
+            try
+            {
+              execute_unit(statements, level[static_cast<std::size_t>(j)]);
+            }
+            catch (statement_not_supported_exception const & e)
+            {
+              #pragma omp critical (viennacl_scheduler_statement_list)
+              failure.record(j, e);
+            }
+            catch (viennacl::memory_exception const & e)
+            {
+              #pragma omp critical (viennacl_scheduler_statement_list)
+              failure.record(j, e);
+            }
+            catch (std::bad_alloc const & e)
+            {
+              #pragma omp critical (viennacl_scheduler_statement_list)
+              failure.record(j, e);
+            }
+            catch (std::exception const & e)
+            {
+              #pragma omp critical (viennacl_scheduler_statement_list)
+              failure.record(j, e);
+            }
+            catch (...)
+            {
+              #pragma omp critical (viennacl_scheduler_statement_list)
+              failure.record(j);
+            }
+          }
+
+          failure.rethrow();
+          return;
+        }
+#endif
+
+        for (std::size_t j=0; j<level.size(); ++j)
+          execute_unit(statements, level[j]);
+      }
+
+      /** @brief A step in the execution of a statement list: Statements executed in a single pass over their vectors, a single statement, or a level of independent units */
+      struct execution_step
+      {
+        enum step_type
+        {
+          FLOAT_SEGMENT_STEP,
+          DOUBLE_SEGMENT_STEP,
+          STATEMENT_STEP,
+          LEVEL_STEP
+        };
+
+        execution_step() : type(LEVEL_STEP), statement_index(0) {}
+
+        step_type                     type;
+        fused_segment<float>          float_segment;
+        fused_segment<double>         double_segment;
+        std::size_t                   statement_index;
+        std::vector<execution_unit>   units;
+      };
+
+      typedef std::vector<execution_step>   execution_plan;
+
+      inline void assign_segment(execution_step & step, fused_segment<float> const & segment)
+      {
+        step.type = execution_step::FLOAT_SEGMENT_STEP;
+        step.float_segment = segment;
+      }
+
+      inline void assign_segment(execution_step & step, fused_segment<double> const & segment)
+      {
+        step.type = execution_step::DOUBLE_SEGMENT_STEP;
+        step.double_segment = segment;
+      }
+
+      /** @brief Collects consecutive statements of one numeric type in main memory for execution in a single pass */
+      template <typename NumericT>
+      class list_segment
+      {
+        public:
+          list_segment() : first_(0) {}
+
+          /** @brief Adds the i-th statement. If it cannot be fused with the statements collected so far, these are appended to the plan first. Returns false if the statement cannot be fused at all. */
+          bool add(std::vector<statement> const & statements, std::size_t i, execution_plan & plan)
+          {
+            statement const & s = statements[i];
+            if (segment_.empty())
+              first_ = i;
+            if (segment_.add(s, s.array()[s.root()]))
+              return true;
+            if (segment_.empty())
+              return false;
+
+            flush(statements, plan);
+            first_ = i;
+            return segment_.add(s, s.array()[s.root()]);
+          }
+
+          /** @brief Appends the statements collected so far to the plan. A single statement not requiring temporaries is left to the regular backend kernels. */
+          void flush(std::vector<statement> const & statements, execution_plan & plan)
+          {
+            if (segment_.empty())
+              return;
+
+            execution_step step;
+            if (segment_.size() == 1 && !requires_temporaries(statements[first_], statements[first_].array()[statements[first_].root()]))
+            {
+              step.type = execution_step::STATEMENT_STEP;
+              step.statement_index = first_;
+            }
+            else
+              assign_segment(step, segment_);
+            plan.push_back(step);
+            segment_.clear();
+          }
+
+        private:
+          fused_segment<NumericT>  segment_;
+          std::size_t              first_;
+      };
+
+      /** @brief Sets up the steps for executing the statements according to the schedule.
+      *
+      * In main memory, element-wise vector statements and inner products are collected into segments executed in a single pass over their vectors as far as their dependencies permit.
+      * All other statements are executed level by level.
+      */
+      inline void build_plan(std::vector<statement> const & statements, execution_schedule const & schedule, execution_plan & plan)
+      {
+        list_segment<float>  float_segment;
+        list_segment<double> double_segment;
+
+        for (std::size_t i=0; i<schedule.size(); ++i)
+        {
+          execution_step level;
+
+          for (std::size_t j=0; j<schedule[i].size(); ++j)
+          {
+            execution_unit const & unit = schedule[i][j];
+            if (!unit.main_memory)
+            {
+              level.units.push_back(unit);
+              continue;
+            }
+
+            for (std::size_t k=0; k<unit.statements.size(); ++k)
+            {
+              std::size_t index = unit.statements[k];
+              bool fused = false;
+
+              // statements may use scalars of the other numeric type, hence pending statements of the other type are appended to the plan first:
+              switch (statements[index].array()[statements[index].root()].lhs.numeric_type)
+              {
+                case FLOAT_TYPE:
+                  double_segment.flush(statements, plan);
+                  fused = float_segment.add(statements, index, plan);
+                  break;
+                case DOUBLE_TYPE:
+                  float_segment.flush(statements, plan);
+                  fused = double_segment.add(statements, index, plan);
+                  break;
+                default: break;
+              }
+
+              if (!fused)
+              {
+                execution_unit single;
+                single.statements.push_back(index);
+                single.size = unit.size;
+                level.units.push_back(single);
+              }
+            }
+          }
+
+          if (!level.units.empty())
+          {
+            float_segment.flush(statements, plan);
+            double_segment.flush(statements, plan);
+            plan.push_back(level);
+          }
+        }
+
+        float_segment.flush(statements, plan);
+        double_segment.flush(statements, plan);
+      }
+
+      /** @brief Returns true if the segments of the plan can be executed again */
+      inline bool is_valid_plan(execution_plan const & plan)
+      {
+        for (std::size_t i=0; i<plan.size(); ++i)
+        {
+          if (   (plan[i].type == execution_step::FLOAT_SEGMENT_STEP  && !plan[i].float_segment.valid())
+              || (plan[i].type == execution_step::DOUBLE_SEGMENT_STEP && !plan[i].double_segment.valid()))
+            return false;
+        }
+        return true;
+      }
+
+    } // namespace detail
+
+
+    /** @brief A list of statements which are executed together by execute(statement_list const &).
+    *
+    * The result is the same as if the statements were executed one after another in the order they were added.
+    * The analysis of the dependencies between the statements is carried out once and reused when the list is executed repeatedly.
+    * It is repeated if vectors in main memory have been resized or reallocated in the meantime.
+    */
+    class statement_list
+    {
+      public:
+        typedef std::vector<statement>   container_type;
+
+        /** @brief Appends a copy of the statement to the list */
+        void add(statement const & s)
+        {
+          statements_.push_back(s);
+          schedule_.clear();
+          plan_.clear();
+        }
+
+        std::size_t size() const { return statements_.size(); }
+
+        statement const & operator[](std::size_t i) const { return statements_[i]; }
+
+        void clear()
+        {
+          statements_.clear();
+          schedule_.clear();
+          plan_.clear();
+        }
+
+        container_type const & statements() const { return statements_; }
+
+        /** @brief Returns the statements grouped into levels of independent execution units. Computed on first use. */
+        detail::execution_schedule const & schedule() const
+        {
+          if (schedule_.empty() && !statements_.empty())
+            detail::build_schedule(statements_, schedule_);
+          return schedule_;
+        }
+
+        /** @brief Returns the steps for executing the list. Computed on first use and whenever the objects in main memory have changed. */
+        detail::execution_plan & plan() const
+        {
+          if (!plan_.empty() && !detail::is_valid_plan(plan_))
+          {
+            schedule_.clear();
+            plan_.clear();
+          }
+          if (plan_.empty() && !statements_.empty())
+            detail::build_plan(statements_, schedule(), plan_);
+          return plan_;
+        }
+
+      private:
+        container_type                       statements_;
+        mutable detail::execution_schedule   schedule_;
+        mutable detail::execution_plan       plan_;
+    };
+
+
+    /** @brief Executes all statements of the list.
+    *
+    * In main memory, element-wise vector statements and inner products are executed together in a single pass over their vectors as far as their dependencies permit.
+    * All other statements are executed level by level, where independent inner products with a common vector are computed in a single pass and small independent statements in main memory are executed concurrently.
+    */
+    inline void execute(statement_list const & list)
+    {
+      detail::execution_plan & plan = list.plan();
+      std::vector<statement> const & statements = list.statements();
+
+      for (std::size_t i=0; i<plan.size(); ++i)
+      {
+        detail::execution_step & step = plan[i];
+        switch (step.type)
+        {
+          case detail::execution_step::FLOAT_SEGMENT_STEP:
+            step.float_segment.load_scalars();
+            step.float_segment.execute();
+            break;
+          case detail::execution_step::DOUBLE_SEGMENT_STEP:
+            step.double_segment.load_scalars();
+            step.double_segment.execute();
+            break;
+          case detail::execution_step::STATEMENT_STEP:
+            execute(statements[step.statement_index]);
+            break;
+          default:
+            detail::execute_level(statements, step.units);
+        }
+      }
+    }
+
+  }
+
+} //namespace viennacl
+
+#endif
@@ -0,0 +1,413 @@
+#ifndef VIENNACL_SLICED_ELL_MATRIX_HPP_
+#define VIENNACL_SLICED_ELL_MATRIX_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/sliced_ell_matrix.hpp
+    @brief Implementation of the sliced_ell_matrix class (SELL-C-sigma format)
+*/
+
+#include <map>
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+
+#include "viennacl/tools/tools.hpp"
+
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+
+namespace viennacl
+{
+    namespace detail
+    {
+      /** @brief Orders rows by decreasing number of nonzeros. Used with std::stable_sort for sorting the rows within a window of a sliced_ell_matrix. */
+      struct sliced_ell_row_length_greater
+      {
+        sliced_ell_row_length_greater(std::vector<std::size_t> const & row_lengths) : row_lengths_(row_lengths) {}
+
+        bool operator()(std::size_t i, std::size_t j) const { return row_lengths_[i] > row_lengths_[j]; }
+
+        std::vector<std::size_t> const & row_lengths_;
+      };
+    }
+
+    //////////////////////// sliced_ell_matrix //////////////////////////
+    /** @brief A sparse matrix in the sliced ELL format (SELL-C-sigma).
+    *
+    * The rows are grouped into chunks of chunk_size() consecutive rows, each chunk is stored in ELL format with a width given by the longest row in the chunk.
+    * Entries with the same item index are thus contiguous for all rows of a chunk, which allows for vectorized processing of a whole chunk.
+    * In order to reduce the padding for matrices with irregular numbers of nonzeros per row, rows are sorted by their number of nonzeros
+    * within windows of sorting_window() consecutive rows prior to the grouping into chunks.
+    *
+    * Memory layout:
+    * - handle1(): Start of each chunk in the arrays of entries (size num_chunks() + 1)
+    * - handle2(): Column indices of the entries
+    * - handle3(): Original row index for each row slot (size size1())
+    * - handle():  Entries. The item_id-th entry of the i-th row of chunk c is located at handle1()[c] + item_id * chunk_size() + i. Padding entries are zero.
+    *
+    * @tparam SCALARTYPE    The floating point type (either float or double, checked at compile time)
+    */
+    template<typename SCALARTYPE>
+    class sliced_ell_matrix
+    {
+      public:
+        typedef viennacl::backend::mem_handle                                                              handle_type;
+        typedef scalar<typename viennacl::tools::CHECK_SCALAR_TEMPLATE_ARGUMENT<SCALARTYPE>::ResultType>   value_type;
+        typedef vcl_size_t                                                                                 size_type;
+
+        /** @brief Creates an empty matrix. No memory is allocated.
+        *
+        * @param chunk_size      Number of rows per chunk. Multiples of eight allow for full SIMD lanes on the host.
+        * @param sorting_window  Number of rows within which the rows are sorted by their number of nonzeros. Rounded up to a multiple of chunk_size. A value of one disables the sorting.
+        */
+        explicit sliced_ell_matrix(size_type chunk_size = 8, size_type sorting_window = 16384)
+          : rows_(0), cols_(0), nnz_(0), internal_nnz_(0), chunk_size_(0), sorting_window_(0)
+        {
+          init_parameters(chunk_size, sorting_window);
+        }
+
+        /** @brief Creates an empty matrix in the memory domain provided by the context. No memory is allocated. */
+        explicit sliced_ell_matrix(viennacl::context ctx, size_type chunk_size = 8, size_type sorting_window = 16384)
+          : rows_(0), cols_(0), nnz_(0), internal_nnz_(0), chunk_size_(0), sorting_window_(0)
+        {
+          init_parameters(chunk_size, sorting_window);
+
+            chunk_start_.switch_active_handle_id(ctx.memory_type());
+          column_indices_.switch_active_handle_id(ctx.memory_type());
+             row_indices_.switch_active_handle_id(ctx.memory_type());
+                elements_.switch_active_handle_id(ctx.memory_type());
+
+#ifdef VIENNACL_WITH_OPENCL
+          if (ctx.memory_type() == OPENCL_MEMORY)
+          {
+               chunk_start_.opencl_handle().context(ctx.opencl_context());
+            column_indices_.opencl_handle().context(ctx.opencl_context());
+               row_indices_.opencl_handle().context(ctx.opencl_context());
+                  elements_.opencl_handle().context(ctx.opencl_context());
+          }
+#endif
+        }
+
+        std::size_t size1() const { return rows_; }
+        std::size_t size2() const { return cols_; }
+
+        /** @brief Returns the number of nonzero entries */
+        std::size_t nnz() const { return nnz_; }
+        /** @brief Returns the number of stored entries including padding */
+        std::size_t internal_nnz() const { return internal_nnz_; }
+
+        std::size_t chunk_size() const { return chunk_size_; }
+        std::size_t sorting_window() const { return sorting_window_; }
+        std::size_t num_chunks() const { return (rows_ + chunk_size_ - 1) / chunk_size_; }
+
+              handle_type & handle()       { return elements_; }
+        const handle_type & handle() const { return elements_; }
+
+              handle_type & handle1()       { return chunk_start_; }
+        const handle_type & handle1() const { return chunk_start_; }
+
+              handle_type & handle2()       { return column_indices_; }
+        const handle_type & handle2() const { return column_indices_; }
+
+              handle_type & handle3()       { return row_indices_; }
+        const handle_type & handle3() const { return row_indices_; }
+
+      #if defined(_MSC_VER) && _MSC_VER < 1500          //Visual Studio 2005 needs special treatment
+        template <typename CPU_MATRIX>
+        friend void copy(const CPU_MATRIX & cpu_matrix, sliced_ell_matrix & gpu_matrix );
+      #else
+        template <typename CPU_MATRIX, typename T>
+        friend void copy(const CPU_MATRIX & cpu_matrix, sliced_ell_matrix<T> & gpu_matrix );
+      #endif
+
+      private:
+        void init_parameters(size_type chunk_size, size_type sorting_window)
+        {
+          chunk_size_     = std::max<size_type>(chunk_size, 1);
+          sorting_window_ = (sorting_window > 1) ? viennacl::tools::align_to_multiple<size_type>(sorting_window, chunk_size_) : 1;
+        }
+
+        std::size_t rows_;
+        std::size_t cols_;
+        std::size_t nnz_;
+        std::size_t internal_nnz_;
+        std::size_t chunk_size_;
+        std::size_t sorting_window_;
+
+        handle_type chunk_start_;
+        handle_type column_indices_;
+        handle_type row_indices_;
+        handle_type elements_;
+    };
+
+
+    //provide copy-operation:
+    /** @brief Copies a sparse matrix from the host to a sliced_ell_matrix.
+    *
+    * For the requirements on the CPU_MATRIX type, see the documentation of the function copy(CPU_MATRIX, compressed_matrix<>).
+    * The chunk size and the sorting window of gpu_matrix are preserved.
+    *
+    * @param cpu_matrix   A sparse matrix on the host.
+    * @param gpu_matrix   A sliced_ell_matrix from ViennaCL
+    */
+    template <typename CPU_MATRIX, typename SCALARTYPE>
+    void copy(const CPU_MATRIX & cpu_matrix, sliced_ell_matrix<SCALARTYPE> & gpu_matrix )
+    {
+      if (cpu_matrix.size1() > 0 && cpu_matrix.size2() > 0)
+      {
+        std::size_t rows        = cpu_matrix.size1();
+        std::size_t chunk_size  = gpu_matrix.chunk_size();
+        std::size_t window      = gpu_matrix.sorting_window();
+
+        // Step 1: Determine the number of nonzeros per row:
+        std::vector<std::size_t> row_lengths(rows);
+        std::size_t num_entries = 0;
+        for (typename CPU_MATRIX::const_iterator1 row_it = cpu_matrix.begin1(); row_it != cpu_matrix.end1(); ++row_it)
+        {
+          for (typename CPU_MATRIX::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
+          {
+            ++row_lengths[col_it.index1()];
+            ++num_entries;
+          }
+        }
+
+        // Step 2: Sort rows by decreasing length within each window and assign the rows to slots:
+        std::vector<std::size_t> slot_rows(rows);    // original row for each slot
+        for (std::size_t i = 0; i < rows; ++i)
+          slot_rows[i] = i;
+        if (window > 1)
+        {
+          for (std::size_t window_begin = 0; window_begin < rows; window_begin += window)
+            std::stable_sort(slot_rows.begin() + window_begin, slot_rows.begin() + std::min(window_begin + window, rows),
+                             viennacl::detail::sliced_ell_row_length_greater(row_lengths));
+        }
+
+        std::vector<std::size_t> row_slots(rows);    // slot for each original row
+        for (std::size_t i = 0; i < rows; ++i)
+          row_slots[slot_rows[i]] = i;
+
+        // Step 3: Chunk widths and offsets:
+        std::size_t num_chunks = (rows + chunk_size - 1) / chunk_size;
+        viennacl::backend::typesafe_host_array<unsigned int> chunk_start(gpu_matrix.handle1(), num_chunks + 1);
+        std::size_t offset = 0;
+        for (std::size_t chunk = 0; chunk < num_chunks; ++chunk)
+        {
+          chunk_start.set(chunk, offset);
+          std::size_t width = 0;
+          for (std::size_t slot = chunk * chunk_size; slot < std::min((chunk + 1) * chunk_size, rows); ++slot)
+            width = std::max(width, row_lengths[slot_rows[slot]]);
+          offset += width * chunk_size;
+        }
+        chunk_start.set(num_chunks, offset);
+
+        gpu_matrix.rows_         = rows;
+        gpu_matrix.cols_         = cpu_matrix.size2();
+        gpu_matrix.nnz_          = num_entries;
+        gpu_matrix.internal_nnz_ = offset;
+
+        // Step 4: Fill entries:
+        viennacl::backend::typesafe_host_array<unsigned int> column_indices(gpu_matrix.handle2(), std::max<std::size_t>(offset, 1));
+        viennacl::backend::typesafe_host_array<unsigned int> row_indices(gpu_matrix.handle3(), rows);
+        std::vector<SCALARTYPE> elements(std::max<std::size_t>(offset, 1), 0);
+
+        for (std::size_t slot = 0; slot < rows; ++slot)
+          row_indices.set(slot, slot_rows[slot]);
+
+        std::vector<std::size_t> items_written(rows);
+        for (typename CPU_MATRIX::const_iterator1 row_it = cpu_matrix.begin1(); row_it != cpu_matrix.end1(); ++row_it)
+        {
+          for (typename CPU_MATRIX::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
+          {
+            std::size_t row   = col_it.index1();
+            std::size_t slot  = row_slots[row];
+            std::size_t index = chunk_start[slot / chunk_size] + items_written[row] * chunk_size + slot % chunk_size;
+            column_indices.set(index, col_it.index2());
+            elements[index] = *col_it;
+            ++items_written[row];
+          }
+        }
+
+        viennacl::backend::memory_create(gpu_matrix.chunk_start_,       chunk_start.raw_size(), traits::context(gpu_matrix.chunk_start_),    chunk_start.get());
+        viennacl::backend::memory_create(gpu_matrix.column_indices_, column_indices.raw_size(), traits::context(gpu_matrix.column_indices_), column_indices.get());
+        viennacl::backend::memory_create(gpu_matrix.row_indices_,       row_indices.raw_size(), traits::context(gpu_matrix.row_indices_),    row_indices.get());
+        viennacl::backend::memory_create(gpu_matrix.elements_,  sizeof(SCALARTYPE) * elements.size(), traits::context(gpu_matrix.elements_),   &(elements[0]));
+      }
+    }
+
+    /** @brief Copies a sparse square matrix in the std::vector< std::map < > > format to a sliced_ell_matrix.
+    *
+    * @param cpu_matrix   A sparse square matrix on the host.
+    * @param gpu_matrix   A sliced_ell_matrix from ViennaCL
+    */
+    template <typename SCALARTYPE>
+    void copy(const std::vector< std::map<unsigned int, SCALARTYPE> > & cpu_matrix,
+                     sliced_ell_matrix<SCALARTYPE> & gpu_matrix )
+    {
+      copy(tools::const_sparse_matrix_adapter<SCALARTYPE>(cpu_matrix, cpu_matrix.size(), cpu_matrix.size()), gpu_matrix);
+    }
+
+    //gpu to cpu:
+    /** @brief Copies a sliced_ell_matrix to the host.
+    *
+    * There are two type requirements on the CPU_MATRIX type (fulfilled by e.g. boost::numeric::ublas):
+    * - resize(rows, cols)  A resize function to bring the matrix into the correct size
+    * - operator(i,j)       Write new entries via the parenthesis operator
+    *
+    * @param gpu_matrix   A sliced_ell_matrix from ViennaCL
+    * @param cpu_matrix   A sparse matrix on the host.
+    */
+    template <typename CPU_MATRIX, typename SCALARTYPE>
+    void copy(const sliced_ell_matrix<SCALARTYPE> & gpu_matrix, CPU_MATRIX & cpu_matrix )
+    {
+      if (gpu_matrix.size1() > 0 && gpu_matrix.size2() > 0)
+      {
+        cpu_matrix.resize(gpu_matrix.size1(), gpu_matrix.size2(), false);
+
+        std::size_t chunk_size = gpu_matrix.chunk_size();
+        std::size_t num_chunks = gpu_matrix.num_chunks();
+
+        viennacl::backend::typesafe_host_array<unsigned int> chunk_start(gpu_matrix.handle1(), num_chunks + 1);
+        viennacl::backend::typesafe_host_array<unsigned int> column_indices(gpu_matrix.handle2(), std::max<std::size_t>(gpu_matrix.internal_nnz(), 1));
+        viennacl::backend::typesafe_host_array<unsigned int> row_indices(gpu_matrix.handle3(), gpu_matrix.size1());
+        std::vector<SCALARTYPE> elements(std::max<std::size_t>(gpu_matrix.internal_nnz(), 1));
+
+        viennacl::backend::memory_read(gpu_matrix.handle1(), 0, chunk_start.raw_size(),    chunk_start.get());
+        viennacl::backend::memory_read(gpu_matrix.handle2(), 0, column_indices.raw_size(), column_indices.get());
+        viennacl::backend::memory_read(gpu_matrix.handle3(), 0, row_indices.raw_size(),    row_indices.get());
+        viennacl::backend::memory_read(gpu_matrix.handle(),  0, sizeof(SCALARTYPE) * elements.size(), &(elements[0]));
+
+        for (std::size_t chunk = 0; chunk < num_chunks; ++chunk)
+        {
+          std::size_t width = (chunk_start[chunk + 1] - chunk_start[chunk]) / chunk_size;
+          for (std::size_t slot = chunk * chunk_size; slot < std::min((chunk + 1) * chunk_size, gpu_matrix.size1()); ++slot)
+          {
+            for (std::size_t item_id = 0; item_id < width; ++item_id)
+            {
+              std::size_t index = chunk_start[chunk] + item_id * chunk_size + slot % chunk_size;
+              if (elements[index] != SCALARTYPE(0))
+                cpu_matrix(row_indices[slot], column_indices[index]) = elements[index];
+            }
+          }
+        }
+      }
+    }
+
+    /** @brief Copies a sliced_ell_matrix to the host. The host type is the std::vector< std::map < > > format .
+    *
+    * @param gpu_matrix   A sliced_ell_matrix from ViennaCL
+    * @param cpu_matrix   A sparse matrix on the host.
+    */
+    template <typename SCALARTYPE>
+    void copy(const sliced_ell_matrix<SCALARTYPE> & gpu_matrix,
+              std::vector< std::map<unsigned int, SCALARTYPE> > & cpu_matrix)
+    {
+      tools::sparse_matrix_adapter<SCALARTYPE> temp(cpu_matrix, gpu_matrix.size1(), gpu_matrix.size2());
+      copy(gpu_matrix, temp);
+    }
+
+
+    namespace linalg
+    {
+      namespace detail
+      {
+        // x = A * y
+        template <typename T>
+        struct op_executor<vector_base<T>, op_assign, vector_expression<const sliced_ell_matrix<T>, const vector_base<T>, op_prod> >
+        {
+            static void apply(vector_base<T> & lhs, vector_expression<const sliced_ell_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+            {
+              // check for the special case x = A * x
+              if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+              {
+                viennacl::vector<T> temp(rhs.lhs().size1(), viennacl::traits::context(rhs));
+                viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+                lhs = temp;
+              }
+              else
+                viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), lhs);
+            }
+        };
+
+        template <typename T>
+        struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const sliced_ell_matrix<T>, const vector_base<T>, op_prod> >
+        {
+            static void apply(vector_base<T> & lhs, vector_expression<const sliced_ell_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+            {
+              viennacl::vector<T> temp(rhs.lhs().size1(), viennacl::traits::context(rhs));
+              viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+              lhs += temp;
+            }
+        };
+
+        template <typename T>
+        struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const sliced_ell_matrix<T>, const vector_base<T>, op_prod> >
+        {
+            static void apply(vector_base<T> & lhs, vector_expression<const sliced_ell_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+            {
+              viennacl::vector<T> temp(rhs.lhs().size1(), viennacl::traits::context(rhs));
+              viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+              lhs -= temp;
+            }
+        };
+
+
+        // x = A * vec_op
+        template <typename T, typename LHS, typename RHS, typename OP>
+        struct op_executor<vector_base<T>, op_assign, vector_expression<const sliced_ell_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+        {
+            static void apply(vector_base<T> & lhs, vector_expression<const sliced_ell_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+            {
+              viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+              viennacl::linalg::prod_impl(rhs.lhs(), temp, lhs);
+            }
+        };
+
+        // x += A * vec_op
+        template <typename T, typename LHS, typename RHS, typename OP>
+        struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const sliced_ell_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+        {
+            static void apply(vector_base<T> & lhs, vector_expression<const sliced_ell_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+            {
+              viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+              viennacl::vector<T> temp_result(lhs.size(), viennacl::traits::context(rhs));
+              viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
+              lhs += temp_result;
+            }
+        };
+
+        // x -= A * vec_op
+        template <typename T, typename LHS, typename RHS, typename OP>
+        struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const sliced_ell_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+        {
+            static void apply(vector_base<T> & lhs, vector_expression<const sliced_ell_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+            {
+              viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+              viennacl::vector<T> temp_result(lhs.size(), viennacl::traits::context(rhs));
+              viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
+              lhs -= temp_result;
+            }
+        };
+
+     } // namespace detail
+   } // namespace linalg
+
+}
+
+#endif
@@ -24,7 +24,9 @@
 
 #include "viennacl/forwards.h"
 #include "viennacl/vector.hpp"
-#include "viennacl/ocl/context.hpp"
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/ocl/context.hpp"
+#endif
 
 #include "viennacl/fft.hpp"
 
@@ -362,6 +364,17 @@ namespace viennacl {
         };
 
 
+        // X = A * B, applied to each column of B
+        template <typename T, unsigned int A, typename F>
+        struct op_executor<matrix_base<T, F>, op_assign, matrix_expression<const toeplitz_matrix<T, A>, const matrix_base<T, F>, op_prod> >
+        {
+            static void apply(matrix_base<T, F> & lhs, matrix_expression<const toeplitz_matrix<T, A>, const matrix_base<T, F>, op_prod> const & rhs)
+            {
+              viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), lhs);
+            }
+        };
+
+
 
      } // namespace detail
    } // namespace linalg
@@ -32,7 +32,7 @@
 #include "viennacl/linalg/detail/op_executor.hpp"
 #include "viennacl/linalg/vector_operations.hpp"
 #include "viennacl/meta/result_of.hpp"
-//#include "viennacl/rand/utils.hpp"
+#include "viennacl/rand/utils.hpp"
 #include "viennacl/context.hpp"
 #include "viennacl/traits/handle.hpp"
 
@@ -133,12 +133,11 @@ namespace viennacl
   };
 
 
-//#ifdef VIENNACL_WITH_OPENCL
-//  template<class SCALARTYPE, class DISTRIBUTION>
-//  rand::random_vector_t<SCALARTYPE, DISTRIBUTION> random_vector(unsigned int size, DISTRIBUTION const & distribution){
-//      return rand::random_vector_t<SCALARTYPE,DISTRIBUTION>(size,distribution);
-//  }
-//#endif
+  /** @brief Returns a proxy for a vector of the given size with random entries drawn from 'distribution' (see viennacl/rand/uniform.hpp and viennacl/rand/gaussian.hpp) */
+  template<class SCALARTYPE, class DISTRIBUTION>
+  rand::random_vector_t<SCALARTYPE, DISTRIBUTION> random_vector(vcl_size_t size, DISTRIBUTION const & distribution, viennacl::context ctx = viennacl::context()){
+      return rand::random_vector_t<SCALARTYPE,DISTRIBUTION>(size,distribution,ctx);
+  }
 
 
   //
@@ -444,17 +443,6 @@ namespace viennacl
       }
 #endif
 
-      /** @brief Creates the vector from the supplied random vector. */
-      /*template<class DISTRIBUTION>
-      vector(rand::random_vector_t<SCALARTYPE, DISTRIBUTION> v) : size_(v.size)
-      {
-        if(size_ > 0)
-        {
-          viennacl::backend::memory_create(elements_, sizeof(SCALARTYPE)*internal_size());
-          rand::buffer_dumper<SCALARTYPE, DISTRIBUTION>::dump(elements_,v.distribution,0,size_);
-        }
-      } */
-
       template <typename LHS, typename RHS, typename OP>
       explicit vector_base(vector_expression<const LHS, const RHS, OP> const & proxy)
         : size_(viennacl::traits::size(proxy)), start_(0), stride_(1), internal_size_(viennacl::tools::align_to_multiple<size_type>(size_, alignment))
@@ -1072,6 +1060,14 @@ namespace viennacl
         viennacl::linalg::vector_assign(*this, v[0]);
     }
 
+    /** @brief Creates the vector from the supplied random vector. */
+    template<class DISTRIBUTION>
+    vector(rand::random_vector_t<SCALARTYPE, DISTRIBUTION> const & v) : base_type(v.size, v.ctx)
+    {
+      if (v.size > 0)
+        rand::fill(*this, v.distribution);
+    }
+
     // the following is used to circumvent an issue with Clang 3.0 when 'using base_type::operator=;' directly
     template <typename T>
     self_type & operator=(T const & other)